@@ -29,7 +29,7 @@
 //  SOFTWARE.
 //
 
-@import Cocoa;
+@import Foundation;
 
 
 @interface NSMutableArray (GNESectionedTableView)
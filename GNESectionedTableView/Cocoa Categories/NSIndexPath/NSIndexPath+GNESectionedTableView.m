@@ -30,6 +30,7 @@
 //
 
 #import "NSIndexPath+GNESectionedTableView.h"
+#import "GNESectionedTableViewStatistics.h"
 
 @implementation NSIndexPath (GNESectionedTableView)
 
@@ -41,6 +42,8 @@
 {
     NSUInteger indexes[] = {row, section};
     
+    GNEStatisticsRecordIndexPathAllocation();
+    
     return [NSIndexPath indexPathWithIndexes:indexes length:2];
 }
 
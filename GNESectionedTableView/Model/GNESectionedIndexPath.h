@@ -0,0 +1,220 @@
+//
+//  GNESectionedIndexPath.h
+//  GNESectionedTableView
+//
+//  Copyright (c) 2014 Gone East LLC. All rights reserved.
+//
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2014 Gone East LLC
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+@import Foundation;
+
+// ------------------------------------------------------------------------------------------
+
+/// Kinds of items an index path can point to. Within a section, rows come first, followed by the
+/// footer and the header, which matches the order of -[NSIndexPath gne_compare:].
+typedef NS_ENUM(NSUInteger, GNESectionedIndexPathKind)
+{
+    GNESectionedIndexPathKindRow = 0,
+    GNESectionedIndexPathKindFooter,
+    GNESectionedIndexPathKindHeader
+};
+
+
+/**
+ Index path of a row, section header, or section footer passed by value, so that it can be created,
+ compared, and read without allocating an NSIndexPath or validating its length.
+ 
+ @discussion The row of section headers and footers is NSNotFound. Index paths that don't point to
+ anything have a section of NSNotFound (see GNESectionedIndexPathNotFound()).
+ */
+typedef struct GNESectionedIndexPath
+{
+    NSUInteger section;
+    NSUInteger row;
+    GNESectionedIndexPathKind kind;
+} GNESectionedIndexPath;
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Creating Index Paths
+// ------------------------------------------------------------------------------------------
+NS_INLINE GNESectionedIndexPath GNESectionedIndexPathMake(NSUInteger row, NSUInteger section)
+{
+    GNESectionedIndexPath indexPath = {section, row, GNESectionedIndexPathKindRow};
+    return indexPath;
+}
+
+
+NS_INLINE GNESectionedIndexPath GNESectionedIndexPathMakeHeader(NSUInteger section)
+{
+    GNESectionedIndexPath indexPath = {section, NSNotFound, GNESectionedIndexPathKindHeader};
+    return indexPath;
+}
+
+
+NS_INLINE GNESectionedIndexPath GNESectionedIndexPathMakeFooter(NSUInteger section)
+{
+    GNESectionedIndexPath indexPath = {section, NSNotFound, GNESectionedIndexPathKindFooter};
+    return indexPath;
+}
+
+
+NS_INLINE GNESectionedIndexPath GNESectionedIndexPathNotFound(void)
+{
+    GNESectionedIndexPath indexPath = {NSNotFound, NSNotFound, GNESectionedIndexPathKindRow};
+    return indexPath;
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Querying Index Paths
+// ------------------------------------------------------------------------------------------
+NS_INLINE BOOL GNESectionedIndexPathIsValid(GNESectionedIndexPath indexPath)
+{
+    return (indexPath.section != NSNotFound);
+}
+
+
+NS_INLINE BOOL GNESectionedIndexPathIsRow(GNESectionedIndexPath indexPath)
+{
+    return (indexPath.section != NSNotFound && indexPath.kind == GNESectionedIndexPathKindRow);
+}
+
+
+NS_INLINE BOOL GNESectionedIndexPathIsHeader(GNESectionedIndexPath indexPath)
+{
+    return (indexPath.section != NSNotFound && indexPath.kind == GNESectionedIndexPathKindHeader);
+}
+
+
+NS_INLINE BOOL GNESectionedIndexPathIsFooter(GNESectionedIndexPath indexPath)
+{
+    return (indexPath.section != NSNotFound && indexPath.kind == GNESectionedIndexPathKindFooter);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Comparing Index Paths
+// ------------------------------------------------------------------------------------------
+NS_INLINE BOOL GNESectionedIndexPathEqualToIndexPath(GNESectionedIndexPath indexPath1,
+                                                     GNESectionedIndexPath indexPath2)
+{
+    return (indexPath1.section == indexPath2.section &&
+            indexPath1.kind == indexPath2.kind &&
+            indexPath1.row == indexPath2.row);
+}
+
+
+/// Compares two index paths first by their sections and then, if the sections are the same, by their
+/// kinds and rows, in the same order as -[NSIndexPath gne_compare:].
+NS_INLINE NSComparisonResult GNESectionedIndexPathCompare(GNESectionedIndexPath indexPath1,
+                                                          GNESectionedIndexPath indexPath2)
+{
+    if (indexPath1.section != indexPath2.section)
+    {
+        return (indexPath1.section < indexPath2.section) ? NSOrderedAscending : NSOrderedDescending;
+    }
+    
+    if (indexPath1.kind != indexPath2.kind)
+    {
+        return (indexPath1.kind < indexPath2.kind) ? NSOrderedAscending : NSOrderedDescending;
+    }
+    
+    if (indexPath1.row != indexPath2.row)
+    {
+        return (indexPath1.row < indexPath2.row) ? NSOrderedAscending : NSOrderedDescending;
+    }
+    
+    return NSOrderedSame;
+}
+
+
+/// Compares two index paths in the reverse order of GNESectionedIndexPathCompare(), like
+/// -[NSIndexPath gne_reverseCompare:].
+NS_INLINE NSComparisonResult GNESectionedIndexPathReverseCompare(GNESectionedIndexPath indexPath1,
+                                                                 GNESectionedIndexPath indexPath2)
+{
+    return GNESectionedIndexPathCompare(indexPath2, indexPath1);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Converting Index Paths
+// ------------------------------------------------------------------------------------------
+/// Returns the index path corresponding to the specified NSIndexPath, whose section headers and footers
+/// are represented by GNESectionedTableViewModelHeaderRow and GNESectionedTableViewModelFooterRow, or
+/// GNESectionedIndexPathNotFound() if it doesn't have two indexes.
+FOUNDATION_EXPORT GNESectionedIndexPath GNESectionedIndexPathFromNSIndexPath(NSIndexPath * __nullable indexPath);
+
+/// Returns a new NSIndexPath corresponding to the specified index path, or nil if it isn't valid.
+FOUNDATION_EXPORT NSIndexPath * __nullable GNESectionedIndexPathToNSIndexPath(GNESectionedIndexPath indexPath);
+
+/// Returns a description of the specified index path, e.g., "{row 2, section 1}" or "{header, section 1}".
+FOUNDATION_EXPORT NSString * __nonnull NSStringFromGNESectionedIndexPath(GNESectionedIndexPath indexPath);
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Collection Helpers
+// ------------------------------------------------------------------------------------------
+/**
+ Fills the specified buffer with the row index paths corresponding to the specified indexes in the
+ specified section, like +[NSIndexPath gne_indexPathsForIndexes:inSection:], without allocating any
+ objects.
+ 
+ @param indexSet Index set containing the rows.
+ @param section Section of the rows.
+ @param indexPaths Buffer with room for at least count index paths.
+ @param count Capacity of the buffer.
+ @return Number of index paths stored in the buffer, which is the smaller of count and the number of
+ indexes in the index set.
+ */
+FOUNDATION_EXPORT NSUInteger GNESectionedIndexPathGetRows(NSIndexSet * __nonnull indexSet,
+                                                          NSUInteger section,
+                                                          GNESectionedIndexPath * __nonnull indexPaths,
+                                                          NSUInteger count);
+
+/// Sorts the specified index paths in place in ascending order (see GNESectionedIndexPathCompare()) with a
+/// radix sort. O(n)
+FOUNDATION_EXPORT void GNESectionedIndexPathSort(GNESectionedIndexPath * __nonnull indexPaths, NSUInteger count);
+
+/// Sorts the specified index paths in place in descending order (see GNESectionedIndexPathReverseCompare()).
+/// O(n)
+FOUNDATION_EXPORT void GNESectionedIndexPathReverseSort(GNESectionedIndexPath * __nonnull indexPaths,
+                                                        NSUInteger count);
+
+/**
+ Calls the specified block once for every section of the specified index paths, which must be sorted
+ (see GNESectionedIndexPathSort() and GNESectionedIndexPathReverseSort()), with the range of the
+ buffer holding the section's index paths. O(n)
+ 
+ @param indexPaths Sorted index paths.
+ @param count Number of index paths.
+ @param block Block called with each section and the range of its index paths in the buffer.
+ */
+FOUNDATION_EXPORT void GNESectionedIndexPathEnumerateSections(const GNESectionedIndexPath * __nonnull indexPaths,
+                                                              NSUInteger count,
+                                                              void (^ __nonnull block)(NSUInteger section,
+                                                                                       NSRange range,
+                                                                                       BOOL * __nonnull stop));
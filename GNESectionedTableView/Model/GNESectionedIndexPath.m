@@ -0,0 +1,325 @@
+//
+//  GNESectionedIndexPath.m
+//  GNESectionedTableView
+//
+//  Copyright (c) 2014 Gone East LLC. All rights reserved.
+//
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2014 Gone East LLC
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import "GNESectionedIndexPath.h"
+#import "GNESectionedTableViewModel.h"
+#import "NSIndexPath+GNESectionedTableView.h"
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Converting Index Paths
+// ------------------------------------------------------------------------------------------
+GNESectionedIndexPath GNESectionedIndexPathFromNSIndexPath(NSIndexPath *indexPath)
+{
+    if (indexPath == nil || indexPath.length != 2)
+    {
+        return GNESectionedIndexPathNotFound();
+    }
+    
+    NSUInteger row = [indexPath indexAtPosition:0];
+    NSUInteger section = [indexPath indexAtPosition:1];
+    
+    if (row == GNESectionedTableViewModelHeaderRow)
+    {
+        return GNESectionedIndexPathMakeHeader(section);
+    }
+    
+    if (row == GNESectionedTableViewModelFooterRow)
+    {
+        return GNESectionedIndexPathMakeFooter(section);
+    }
+    
+    return GNESectionedIndexPathMake(row, section);
+}
+
+
+NSIndexPath *GNESectionedIndexPathToNSIndexPath(GNESectionedIndexPath indexPath)
+{
+    if (GNESectionedIndexPathIsValid(indexPath) == NO)
+    {
+        return nil;
+    }
+    
+    switch (indexPath.kind)
+    {
+        case GNESectionedIndexPathKindHeader:
+            return [NSIndexPath gne_indexPathForRow:GNESectionedTableViewModelHeaderRow inSection:indexPath.section];
+        case GNESectionedIndexPathKindFooter:
+            return [NSIndexPath gne_indexPathForRow:GNESectionedTableViewModelFooterRow inSection:indexPath.section];
+        case GNESectionedIndexPathKindRow:
+            return [NSIndexPath gne_indexPathForRow:indexPath.row inSection:indexPath.section];
+    }
+    
+    return nil;
+}
+
+
+NSString *NSStringFromGNESectionedIndexPath(GNESectionedIndexPath indexPath)
+{
+    if (GNESectionedIndexPathIsValid(indexPath) == NO)
+    {
+        return @"{not found}";
+    }
+    
+    switch (indexPath.kind)
+    {
+        case GNESectionedIndexPathKindHeader:
+            return [NSString stringWithFormat:@"{header, section %lu}", (unsigned long)indexPath.section];
+        case GNESectionedIndexPathKindFooter:
+            return [NSString stringWithFormat:@"{footer, section %lu}", (unsigned long)indexPath.section];
+        case GNESectionedIndexPathKindRow:
+            break;
+    }
+    
+    return [NSString stringWithFormat:@"{row %lu, section %lu}",
+            (unsigned long)indexPath.row, (unsigned long)indexPath.section];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Collection Helpers
+// ------------------------------------------------------------------------------------------
+NSUInteger GNESectionedIndexPathGetRows(NSIndexSet *indexSet,
+                                        NSUInteger section,
+                                        GNESectionedIndexPath *indexPaths,
+                                        NSUInteger count)
+{
+    NSCParameterAssert(indexSet);
+    NSCParameterAssert(indexPaths || count == 0);
+    
+    __block NSUInteger position = 0;
+    [indexSet enumerateRangesUsingBlock:^(NSRange range, BOOL *stop)
+    {
+        for (NSUInteger row = range.location; row < NSMaxRange(range) && position < count; row++)
+        {
+            indexPaths[position++] = GNESectionedIndexPathMake(row, section);
+        }
+        
+        *stop = (position == count);
+    }];
+    
+    return position;
+}
+
+
+/// Buffers shorter than this are sorted with qsort() because the radix sort's histograms would cost more
+/// than the comparisons they save.
+static const NSUInteger kRadixSortMinimumCount = 64;
+
+
+typedef NS_ENUM(NSUInteger, GNESectionedIndexPathField)
+{
+    GNESectionedIndexPathFieldRow,
+    GNESectionedIndexPathFieldKind,
+    GNESectionedIndexPathFieldSection,
+};
+
+
+static int GNESectionedIndexPathCompareFunction(const void *indexPath1, const void *indexPath2)
+{
+    return (int)GNESectionedIndexPathCompare(*(const GNESectionedIndexPath *)indexPath1,
+                                             *(const GNESectionedIndexPath *)indexPath2);
+}
+
+
+static BOOL GNESectionedIndexPathIsSorted(const GNESectionedIndexPath *indexPaths, NSUInteger count)
+{
+    for (NSUInteger i = 1; i < count; i++)
+    {
+        if (GNESectionedIndexPathCompare(indexPaths[i - 1], indexPaths[i]) == NSOrderedDescending)
+        {
+            return NO;
+        }
+    }
+    
+    return YES;
+}
+
+
+static inline NSUInteger GNESectionedIndexPathDigit(GNESectionedIndexPath indexPath,
+                                                    GNESectionedIndexPathField field,
+                                                    NSUInteger shift)
+{
+    NSUInteger key = 0;
+    switch (field)
+    {
+        case GNESectionedIndexPathFieldRow:
+            key = indexPath.row;
+            break;
+        case GNESectionedIndexPathFieldKind:
+            key = (NSUInteger)indexPath.kind;
+            break;
+        case GNESectionedIndexPathFieldSection:
+            key = indexPath.section;
+            break;
+    }
+    
+    return (key >> shift) & 0xFF;
+}
+
+
+/**
+ Stably copies the index paths in the source buffer to the destination buffer, ordered by the 8-bit digit
+ of the specified field starting at the specified bit. O(n)
+ 
+ @return NO, without touching the destination buffer, if every index path has the same digit.
+ */
+static BOOL GNESectionedIndexPathRadixPass(const GNESectionedIndexPath *source,
+                                           GNESectionedIndexPath *destination,
+                                           NSUInteger count,
+                                           GNESectionedIndexPathField field,
+                                           NSUInteger shift)
+{
+    NSUInteger offsets[256] = { 0 };
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        offsets[GNESectionedIndexPathDigit(source[i], field, shift)]++;
+    }
+    
+    if (offsets[GNESectionedIndexPathDigit(source[0], field, shift)] == count)
+    {
+        return NO;
+    }
+    
+    NSUInteger offset = 0;
+    for (NSUInteger digit = 0; digit < 256; digit++)
+    {
+        NSUInteger digitCount = offsets[digit];
+        offsets[digit] = offset;
+        offset += digitCount;
+    }
+    
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        destination[offsets[GNESectionedIndexPathDigit(source[i], field, shift)]++] = source[i];
+    }
+    
+    return YES;
+}
+
+
+/**
+ Sorts the index paths with a least significant digit radix sort on their rows, kinds, and sections, in
+ that order, so that the result is in the order of GNESectionedIndexPathCompare(). Digits shared by every
+ index path, like the high bytes of small rows and sections, are skipped. Already sorted buffers are
+ detected in a single pass and small ones are sorted with qsort(). O(n)
+ */
+void GNESectionedIndexPathSort(GNESectionedIndexPath *indexPaths, NSUInteger count)
+{
+    NSCParameterAssert(indexPaths || count == 0);
+    
+    if (count < 2 || GNESectionedIndexPathIsSorted(indexPaths, count))
+    {
+        return;
+    }
+    
+    GNESectionedIndexPath *buffer = NULL;
+    if (count >= kRadixSortMinimumCount && count <= SIZE_MAX / sizeof(GNESectionedIndexPath))
+    {
+        buffer = malloc(count * sizeof(GNESectionedIndexPath));
+    }
+    
+    if (buffer == NULL)
+    {
+        qsort(indexPaths, count, sizeof(GNESectionedIndexPath), GNESectionedIndexPathCompareFunction);
+        
+        return;
+    }
+    
+    GNESectionedIndexPath *source = indexPaths;
+    GNESectionedIndexPath *destination = buffer;
+    GNESectionedIndexPathField fields[] =
+    {
+        GNESectionedIndexPathFieldRow,
+        GNESectionedIndexPathFieldKind,
+        GNESectionedIndexPathFieldSection,
+    };
+    
+    for (NSUInteger i = 0; i < sizeof(fields) / sizeof(fields[0]); i++)
+    {
+        NSUInteger bitCount = (fields[i] == GNESectionedIndexPathFieldKind) ? 8 : sizeof(NSUInteger) * 8;
+        for (NSUInteger shift = 0; shift < bitCount; shift += 8)
+        {
+            if (GNESectionedIndexPathRadixPass(source, destination, count, fields[i], shift))
+            {
+                GNESectionedIndexPath *sorted = destination;
+                destination = source;
+                source = sorted;
+            }
+        }
+    }
+    
+    if (source != indexPaths)
+    {
+        memcpy(indexPaths, source, count * sizeof(GNESectionedIndexPath));
+    }
+    
+    free(buffer);
+}
+
+
+void GNESectionedIndexPathReverseSort(GNESectionedIndexPath *indexPaths, NSUInteger count)
+{
+    NSCParameterAssert(indexPaths || count == 0);
+    
+    GNESectionedIndexPathSort(indexPaths, count);
+    
+    for (NSUInteger i = 0; i < count / 2; i++)
+    {
+        GNESectionedIndexPath indexPath = indexPaths[i];
+        indexPaths[i] = indexPaths[count - i - 1];
+        indexPaths[count - i - 1] = indexPath;
+    }
+}
+
+
+void GNESectionedIndexPathEnumerateSections(const GNESectionedIndexPath *indexPaths,
+                                            NSUInteger count,
+                                            void (^block)(NSUInteger section, NSRange range, BOOL *stop))
+{
+    NSCParameterAssert(indexPaths || count == 0);
+    NSCParameterAssert(block);
+    
+    NSUInteger start = 0;
+    BOOL stop = NO;
+    
+    while (start < count && stop == NO)
+    {
+        NSUInteger section = indexPaths[start].section;
+        NSUInteger end = start + 1;
+        while (end < count && indexPaths[end].section == section)
+        {
+            end++;
+        }
+        
+        block(section, NSMakeRange(start, end - start), &stop);
+        start = end;
+    }
+}
@@ -0,0 +1,191 @@
+//
+//  GNESectionedTableViewModel.h
+//  GNESectionedTableView
+//
+//  Copyright (c) 2014 Gone East LLC. All rights reserved.
+//
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2014 Gone East LLC
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+@import Foundation;
+#import "GNESectionedTableViewStatistics.h"
+#import "GNESectionedIndexPath.h"
+
+@class GNEOutlineViewItem;
+@class GNEOutlineViewParentItem;
+@class GNEOutlineViewItemArray;
+
+// ------------------------------------------------------------------------------------------
+
+/// Row of the index paths that represent section headers.
+extern const NSUInteger GNESectionedTableViewModelHeaderRow;
+
+/// Row of the index paths that represent section footers.
+extern const NSUInteger GNESectionedTableViewModelFooterRow;
+
+// ------------------------------------------------------------------------------------------
+
+/**
+ GNESectionedTableViewModel keeps track of the sections, rows, and footers of a sectioned table view
+ using outline view parent items (one per section) and outline view item arrays (one per section, with
+ the footer, if any, stored after the rows).
+ 
+ @discussion The model only depends on Foundation, so that its bookkeeping can be built, tested, and
+ measured without AppKit. GNESectionedTableView forwards all of its index path and item lookups to its
+ model and mirrors the model's mutations in NSOutlineView.
+ 
+ Section headers are represented by index paths whose row is GNESectionedTableViewModelHeaderRow and
+ section footers by index paths whose row is GNESectionedTableViewModelFooterRow.
+ */
+@interface GNESectionedTableViewModel : NSObject
+
+/// Number of sections in the receiver. O(1)
+@property (nonatomic, assign, readonly) NSUInteger numberOfSections;
+
+/// Total number of section headers, rows, and section footers in the receiver. O(sections)
+@property (nonatomic, assign, readonly) NSUInteger numberOfItems;
+
+#if GNE_STATISTICS_ENABLED
+/// Records the receiver's index path resolutions, if set.
+@property (nonatomic, strong, nullable) GNESectionedTableViewStatisticsRecorder *statisticsRecorder;
+#endif
+
+#pragma mark - Initializers
++ (nonnull instancetype)model;
+- (nonnull instancetype)init NS_DESIGNATED_INITIALIZER;
+
+#pragma mark - Index Paths
+/// Returns YES if the specified index path points to a section header, row, or section footer in the
+/// receiver, otherwise NO.
+- (BOOL)isIndexPathValid:(nullable NSIndexPath *)indexPath;
+/// Returns YES if the specified index path points to the header of a section in the receiver, otherwise NO.
+- (BOOL)isIndexPathHeader:(nullable NSIndexPath *)indexPath;
+/// Returns YES if the specified index path points to the footer of a section in the receiver, otherwise NO.
+/// The section doesn't need to have a footer.
+- (BOOL)isIndexPathFooter:(nullable NSIndexPath *)indexPath;
+/// Returns the index path of the header in the specified section, or nil if the section is invalid.
+- (nullable NSIndexPath *)indexPathForHeaderInSection:(NSUInteger)section;
+/// Returns the index path of the footer in the specified section, or nil if the section is invalid.
+- (nullable NSIndexPath *)indexPathForFooterInSection:(NSUInteger)section;
+
+#pragma mark - Counts
+/// Returns the number of rows, including the footer, in the specified section or NSNotFound if the
+/// section is invalid. O(1)
+- (NSUInteger)numberOfItemsInSection:(NSUInteger)section;
+/// Returns the number of rows, including the footer, in the section of the specified outline view parent
+/// item or 0 if the parent item isn't in the receiver. O(1)
+- (NSUInteger)numberOfItemsInParentItem:(nullable GNEOutlineViewParentItem *)parentItem;
+
+#pragma mark - Retrieving Outline View Items
+/// Returns the outline view parent item of the specified section or nil if the section is invalid. O(1)
+- (nullable GNEOutlineViewParentItem *)parentItemForSection:(NSUInteger)section;
+/// Returns the section of the specified outline view parent item or NSNotFound if it has been removed
+/// from the receiver or isn't an outline view parent item. O(1)
+- (NSUInteger)sectionForParentItem:(nullable GNEOutlineViewItem *)parentItem;
+/// Returns the outline view item array containing the rows and footer of the specified section or nil
+/// if the section is invalid. O(1)
+- (nullable GNEOutlineViewItemArray *)itemsInSection:(NSUInteger)section;
+/// Returns the outline view item at the specified index of the specified outline view parent item or,
+/// if the parent item is nil, the outline view parent item at the specified index. O(lg n)
+- (nullable GNEOutlineViewItem *)itemAtIndex:(NSUInteger)index ofParentItem:(nullable GNEOutlineViewParentItem *)parentItem;
+/// Returns the outline view parent item, outline view item, or footer outline view item at the specified
+/// index path, or nil if the index path is invalid. O(lg n)
+- (nullable GNEOutlineViewItem *)itemAtIndexPath:(nonnull NSIndexPath *)indexPath;
+/// Returns the outline view item representing the footer of the specified section, or nil if the section
+/// is invalid or doesn't have a footer. O(lg n)
+- (nullable GNEOutlineViewItem *)footerItemInSection:(NSUInteger)section;
+/// Returns the index of the specified outline view item in its section or NSNotFound if it isn't in the
+/// receiver. O(lg n)
+- (NSUInteger)indexOfItem:(nullable GNEOutlineViewItem *)item;
+/// Returns the index path of the specified outline view item or outline view parent item or nil if it
+/// isn't in the receiver. O(lg n)
+- (nullable NSIndexPath *)indexPathOfItem:(nullable GNEOutlineViewItem *)item;
+/// Returns the index path of the specified outline view item or outline view parent item by value, or
+/// GNESectionedIndexPathNotFound() if it isn't in the receiver. Unlike -indexPathOfItem:, no objects
+/// are allocated. O(lg n)
+- (GNESectionedIndexPath)sectionedIndexPathOfItem:(nullable GNEOutlineViewItem *)item;
+/// Returns YES if the specified outline view item represents the footer of its section, otherwise NO. O(lg n)
+- (BOOL)isItemFooter:(nullable GNEOutlineViewItem *)item;
+
+#pragma mark - Inserting and Removing Sections
+/**
+ Inserts new sections at the specified indexes.
+ 
+ @discussion The sections are inserted in ascending order. Indexes beyond the end of the receiver are
+ clamped to its end. The specified block is called for every new section right before it is inserted,
+ with the new outline view parent item and the section it will have, and returns the number of rows
+ in the section. The block can also configure the parent item, e.g., set hasFooter to add a footer.
+ @param sections Indexes at which to insert the new sections.
+ @param block Block returning the number of rows (excluding the footer) of each new section.
+ @return Indexes the new sections were inserted at.
+ */
+- (nonnull NSIndexSet *)insertSections:(nonnull NSIndexSet *)sections
+                            usingBlock:(nonnull NSUInteger (^)(GNEOutlineViewParentItem * __nonnull parentItem,
+                                                               NSUInteger section))block;
+/// Removes the sections at the specified indexes and returns the indexes of the removed sections.
+/// Invalid indexes are ignored.
+- (nonnull NSIndexSet *)deleteSections:(nonnull NSIndexSet *)sections;
+/// Removes all of the sections from the receiver.
+- (void)removeAllSections;
+
+#pragma mark - Inserting and Removing Rows
+/// Inserts new outline view items at the rows of the specified index paths, which must all be in the
+/// specified section and sorted in ascending order, and returns the indexes they were inserted at. Rows
+/// beyond the end of the section are clamped to its end.
+- (nonnull NSIndexSet *)insertRowsAtIndexPaths:(nonnull NSArray *)indexPaths inSection:(NSUInteger)section;
+/// Removes the outline view items at the rows of the specified index paths, which must all be in the
+/// specified section and sorted in descending order, and returns the indexes they were removed from.
+/// Invalid index paths are ignored.
+- (nonnull NSIndexSet *)deleteRowsAtIndexPaths:(nonnull NSArray *)indexPaths inSection:(NSUInteger)section;
+
+#pragma mark - Selection
+/// Index paths of the selected section headers, rows, and section footers, sorted in ascending order
+/// (see -[NSIndexPath gne_compare:]). The selection is kept in sync with the receiver's insertions
+/// and deletions, so it never has to be sorted. O(n) for n selected index paths
+@property (nonatomic, copy, readonly, nonnull) NSArray *selectedIndexPaths;
+
+/// Returns YES if the specified index path is selected, otherwise NO. O(1) for section headers and
+/// O(lg r) for rows and section footers, where r is the number of ranges of selected rows in the section
+- (BOOL)isIndexPathSelected:(nullable NSIndexPath *)indexPath;
+/// Returns the sorted index paths of the selected section header, rows, and section footer of the
+/// specified section.
+- (nonnull NSArray *)selectedIndexPathsInSection:(NSUInteger)section;
+/// Adds the specified outline view item or outline view parent item to the selection. Items that
+/// aren't in the receiver are ignored. O(lg n)
+- (void)selectItem:(nullable GNEOutlineViewItem *)item;
+/// Adds the headers of the specified sections to the selection. Invalid sections are ignored.
+- (void)selectHeadersInSections:(nonnull NSIndexSet *)sections;
+/// Removes the headers of the specified sections from the selection.
+- (void)deselectHeadersInSections:(nonnull NSIndexSet *)sections;
+/// Adds the outline view items at the specified indexes of the specified section to the selection. The
+/// indexes are those of the section's outline view item array, so its footer is the last index.
+/// O(r) for r ranges of indexes
+- (void)selectItemsAtIndexes:(nonnull NSIndexSet *)indexes inSection:(NSUInteger)section;
+/// Removes the outline view items at the specified indexes of the specified section from the selection.
+/// O(r) for r ranges of indexes
+- (void)deselectItemsAtIndexes:(nonnull NSIndexSet *)indexes inSection:(NSUInteger)section;
+/// Removes all of the section headers, rows, and section footers from the selection.
+- (void)deselectAllItems;
+
+@end
@@ -0,0 +1,797 @@
+//
+//  GNESectionedTableViewModel.m
+//  GNESectionedTableView
+//
+//  Copyright (c) 2014 Gone East LLC. All rights reserved.
+//
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2014 Gone East LLC
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import "GNESectionedTableViewModel.h"
+#import "GNEOutlineViewItem.h"
+#import "GNEOutlineViewParentItem.h"
+#import "GNEOutlineViewItemArray.h"
+#import "GNESectionedTableViewSelection.h"
+#import "NSIndexPath+GNESectionedTableView.h"
+
+
+// ------------------------------------------------------------------------------------------
+
+
+const NSUInteger GNESectionedTableViewModelHeaderRow = (NSUInteger)(NSNotFound - 1);
+const NSUInteger GNESectionedTableViewModelFooterRow = (NSUInteger)(NSNotFound - 2);
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@interface GNESectionedTableViewModel ()
+
+/// Array of outline view parent items that map to the sections.
+@property (nonatomic, strong) NSMutableArray *parentItems;
+
+/// Array of outline view item arrays that map to the rows and footers of the sections.
+@property (nonatomic, strong) NSMutableArray *items;
+
+/// Selected section headers and items, kept in sync with the parent items and item arrays.
+@property (nonatomic, strong) GNESectionedTableViewSelection *selection;
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@implementation GNESectionedTableViewModel
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Initialization
+// ------------------------------------------------------------------------------------------
++ (instancetype)model
+{
+    return [[[self class] alloc] init];
+}
+
+
+- (instancetype)init
+{
+    if ((self = [super init]))
+    {
+        _parentItems = [NSMutableArray array];
+        _items = [NSMutableArray array];
+        _selection = [GNESectionedTableViewSelection selection];
+    }
+    
+    return self;
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Index Paths
+// ------------------------------------------------------------------------------------------
+- (BOOL)isIndexPathValid:(NSIndexPath *)indexPath
+{
+    if (indexPath == nil)
+    {
+        return NO;
+    }
+    
+    NSUInteger section = indexPath.gne_section;
+    if (section < self.items.count)
+    {
+        BOOL isSectionHeader = [self isIndexPathHeader:indexPath];
+        BOOL isSectionFooter = [self isIndexPathFooter:indexPath];
+        NSUInteger rowCount = ((GNEOutlineViewItemArray *)self.items[section]).count;
+        
+        return (isSectionHeader || isSectionFooter || indexPath.gne_row < rowCount);
+    }
+    
+    return NO;
+}
+
+
+- (BOOL)isIndexPathHeader:(NSIndexPath *)indexPath
+{
+    if (indexPath == nil)
+    {
+        return NO;
+    }
+    
+    return (indexPath.gne_section < self.parentItems.count &&
+            indexPath.gne_row == GNESectionedTableViewModelHeaderRow);
+}
+
+
+- (BOOL)isIndexPathFooter:(NSIndexPath *)indexPath
+{
+    if (indexPath == nil)
+    {
+        return NO;
+    }
+    
+    return (indexPath.gne_section < self.parentItems.count &&
+            indexPath.gne_row == GNESectionedTableViewModelFooterRow);
+}
+
+
+- (NSIndexPath *)indexPathForHeaderInSection:(NSUInteger)section
+{
+    if (section < self.parentItems.count)
+    {
+        return [NSIndexPath gne_indexPathForRow:GNESectionedTableViewModelHeaderRow inSection:section];
+    }
+    
+    return nil;
+}
+
+
+- (NSIndexPath *)indexPathForFooterInSection:(NSUInteger)section
+{
+    if (section < self.parentItems.count)
+    {
+        return [NSIndexPath gne_indexPathForRow:GNESectionedTableViewModelFooterRow inSection:section];
+    }
+    
+    return nil;
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Counts
+// ------------------------------------------------------------------------------------------
+- (NSUInteger)numberOfSections
+{
+    NSParameterAssert(self.parentItems.count == self.items.count);
+    
+    return self.parentItems.count;
+}
+
+
+- (NSUInteger)numberOfItems
+{
+    NSUInteger sectionCount = self.items.count;
+    NSUInteger rowAndFooterCount = 0;
+    
+    for (GNEOutlineViewItemArray *rows in self.items)
+    {
+        rowAndFooterCount += rows.count;
+    }
+    
+    return (sectionCount + rowAndFooterCount); // Section headers count as rows even if they are not "visible"
+}
+
+
+- (NSUInteger)numberOfItemsInSection:(NSUInteger)section
+{
+    if (section < self.items.count)
+    {
+        return ((GNEOutlineViewItemArray *)self.items[section]).count;
+    }
+    
+    return NSNotFound;
+}
+
+
+- (NSUInteger)numberOfItemsInParentItem:(GNEOutlineViewParentItem *)parentItem
+{
+    NSUInteger section = [self sectionForParentItem:parentItem];
+    if (section < self.items.count)
+    {
+        return ((GNEOutlineViewItemArray *)self.items[section]).count;
+    }
+    
+    return 0;
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Retrieving Outline View Items
+// ------------------------------------------------------------------------------------------
+- (GNEOutlineViewParentItem *)parentItemForSection:(NSUInteger)section
+{
+    if (section < self.parentItems.count)
+    {
+        return self.parentItems[section];
+    }
+    
+    return nil;
+}
+
+
+/**
+ The section stored in the parent item is validated against the outline view parent items array, so
+ parent items that have been removed from the receiver are never reported as belonging to a section.
+ */
+- (NSUInteger)sectionForParentItem:(GNEOutlineViewItem *)parentItem
+{
+    if ([parentItem isKindOfClass:[GNEOutlineViewParentItem class]] == NO)
+    {
+        return NSNotFound;
+    }
+    
+    NSUInteger section = ((GNEOutlineViewParentItem *)parentItem).section;
+    
+    if (section < self.parentItems.count && self.parentItems[section] == parentItem)
+    {
+        return section;
+    }
+    
+    return NSNotFound;
+}
+
+
+- (GNEOutlineViewItemArray *)itemsInSection:(NSUInteger)section
+{
+    if (section < self.items.count)
+    {
+        return self.items[section];
+    }
+    
+    return nil;
+}
+
+
+- (GNEOutlineViewItem *)itemAtIndex:(NSUInteger)index ofParentItem:(GNEOutlineViewParentItem *)parentItem
+{
+    NSParameterAssert(parentItem == nil || [parentItem isKindOfClass:[GNEOutlineViewParentItem class]]);
+    
+    if (parentItem)
+    {
+        GNEOutlineViewItemArray *rows = [self itemsInSection:[self sectionForParentItem:parentItem]];
+        
+        if (index < rows.count)
+        {
+            return rows[index];
+        }
+    }
+    else if (index < self.parentItems.count)
+    {
+        return self.parentItems[index];
+    }
+    
+    return nil;
+}
+
+
+- (GNEOutlineViewItem *)itemAtIndexPath:(NSIndexPath *)indexPath
+{
+    NSParameterAssert(indexPath);
+    
+    NSUInteger section = indexPath.gne_section;
+    
+    if ([self isIndexPathHeader:indexPath])
+    {
+        return [self parentItemForSection:section];
+    }
+    else if ([self isIndexPathFooter:indexPath])
+    {
+        return [self footerItemInSection:section];
+    }
+    
+    GNEOutlineViewItemArray *rows = [self itemsInSection:section];
+    
+    if (indexPath.gne_row < rows.count)
+    {
+        return rows[indexPath.gne_row];
+    }
+    
+    return nil;
+}
+
+
+- (GNEOutlineViewItem *)footerItemInSection:(NSUInteger)section
+{
+    GNEOutlineViewParentItem *parentItem = [self parentItemForSection:section];
+    
+    if (parentItem.hasFooter == NO)
+    {
+        return nil;
+    }
+    
+    return ((GNEOutlineViewItemArray *)self.items[section]).lastObject;
+}
+
+
+- (NSUInteger)indexOfItem:(GNEOutlineViewItem *)item
+{
+    GNEOutlineViewItemArray *rows = [self itemsInSection:[self sectionForParentItem:item.parentItem]];
+    
+    return (rows) ? [rows indexOfObject:item] : NSNotFound;
+}
+
+
+- (NSIndexPath *)indexPathOfItem:(GNEOutlineViewItem *)item
+{
+    if (item == nil)
+    {
+        return nil;
+    }
+    
+    // If it's an outline view parent item, make a section header index path for it.
+    GNEOutlineViewParentItem *parentItem = item.parentItem;
+    if (parentItem == nil)
+    {
+        GNEStatisticsRecordIndexPathResolution(self.statisticsRecorder, 0);
+        return [self indexPathForHeaderInSection:[self sectionForParentItem:item]];
+    }
+    
+    NSUInteger section = [self sectionForParentItem:parentItem];
+    if (section == NSNotFound)
+    {
+        GNEStatisticsRecordIndexPathResolution(self.statisticsRecorder, 0);
+        return nil;
+    }
+    
+    GNEOutlineViewItemArray *rows = self.items[section];
+#if GNE_STATISTICS_ENABLED
+    NSUInteger scanLength = 0;
+    NSUInteger index = [rows indexOfObject:item scanLength:&scanLength];
+    GNEStatisticsRecordIndexPathResolution(self.statisticsRecorder, scanLength);
+#else
+    NSUInteger index = [rows indexOfObject:item];
+#endif
+    if (index == NSNotFound)
+    {
+        return nil;
+    }
+    
+    // If it represents a section footer, make a section footer index path for it.
+    if (parentItem.hasFooter && index == rows.count - 1)
+    {
+        return [self indexPathForFooterInSection:section];
+    }
+    
+    return [NSIndexPath gne_indexPathForRow:index inSection:section];
+}
+
+
+- (GNESectionedIndexPath)sectionedIndexPathOfItem:(GNEOutlineViewItem *)item
+{
+    if (item == nil)
+    {
+        return GNESectionedIndexPathNotFound();
+    }
+    
+    GNEOutlineViewParentItem *parentItem = item.parentItem;
+    if (parentItem == nil)
+    {
+        NSUInteger section = [self sectionForParentItem:item];
+        
+        return ((section == NSNotFound) ? GNESectionedIndexPathNotFound() :
+                GNESectionedIndexPathMakeHeader(section));
+    }
+    
+    NSUInteger section = [self sectionForParentItem:parentItem];
+    if (section == NSNotFound)
+    {
+        return GNESectionedIndexPathNotFound();
+    }
+    
+    GNEOutlineViewItemArray *rows = self.items[section];
+    NSUInteger index = [rows indexOfObject:item];
+    if (index == NSNotFound)
+    {
+        return GNESectionedIndexPathNotFound();
+    }
+    
+    if (parentItem.hasFooter && index == rows.count - 1)
+    {
+        return GNESectionedIndexPathMakeFooter(section);
+    }
+    
+    return GNESectionedIndexPathMake(index, section);
+}
+
+
+- (BOOL)isItemFooter:(GNEOutlineViewItem *)item
+{
+    GNEOutlineViewParentItem *parentItem = item.parentItem;
+    
+    if (parentItem == nil || parentItem.hasFooter == NO)
+    {
+        return NO;
+    }
+    
+    GNEOutlineViewItemArray *rows = [self itemsInSection:[self sectionForParentItem:parentItem]];
+    
+    return (rows && rows.lastObject == item);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Inserting and Removing Sections
+// ------------------------------------------------------------------------------------------
+- (NSIndexSet *)insertSections:(NSIndexSet *)sections
+                    usingBlock:(NSUInteger (^)(GNEOutlineViewParentItem *parentItem, NSUInteger section))block
+{
+    NSParameterAssert(block);
+    
+    NSMutableIndexSet *insertedSections = [NSMutableIndexSet indexSet];
+    
+    [sections enumerateIndexesUsingBlock:^(NSUInteger proposedSection, BOOL *stop __unused)
+    {
+        @autoreleasepool
+        {
+            NSUInteger sectionCount = self.parentItems.count;
+            NSUInteger section = (proposedSection > sectionCount) ? sectionCount : proposedSection;
+            
+            GNEOutlineViewParentItem *parentItem = [[GNEOutlineViewParentItem alloc] init];
+            NSUInteger rowCount = block(parentItem, section);
+            rowCount += (parentItem.hasFooter) ? 1 : 0; // Add a footer item, if needed.
+            
+            GNEOutlineViewItemArray *rows = [self p_itemArrayWithCount:rowCount parentItem:parentItem];
+            [self.parentItems insertObject:parentItem atIndex:section];
+            [self.items insertObject:rows atIndex:section];
+            [self.selection insertSectionsAtIndexes:[NSIndexSet indexSetWithIndex:section]];
+            
+            [insertedSections addIndex:section];
+        }
+    }];
+    
+    [self p_updateSectionsOfParentItemsStartingAtSection:insertedSections.firstIndex];
+    
+    return [insertedSections copy];
+}
+
+
+- (NSIndexSet *)deleteSections:(NSIndexSet *)sections
+{
+    NSMutableIndexSet *deletedSections = [NSMutableIndexSet indexSet];
+    NSUInteger sectionCount = self.parentItems.count;
+    
+    [sections enumerateIndexesWithOptions:NSEnumerationReverse usingBlock:^(NSUInteger section,
+                                                                            BOOL *stop __unused)
+    {
+        if (section < sectionCount)
+        {
+            ((GNEOutlineViewParentItem *)self.parentItems[section]).section = NSNotFound;
+            [self.parentItems removeObjectAtIndex:section];
+            [self.items removeObjectAtIndex:section];
+            [deletedSections addIndex:section];
+        }
+    }];
+    
+    [self.selection removeSectionsAtIndexes:deletedSections];
+    [self p_updateSectionsOfParentItemsStartingAtSection:deletedSections.firstIndex];
+    
+    return [deletedSections copy];
+}
+
+
+- (void)removeAllSections
+{
+    for (GNEOutlineViewParentItem *parentItem in self.parentItems)
+    {
+        parentItem.section = NSNotFound;
+    }
+    [self.parentItems removeAllObjects];
+    [self.items removeAllObjects];
+    [self.selection removeAllSections];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Inserting and Removing Rows
+// ------------------------------------------------------------------------------------------
+- (NSIndexSet *)insertRowsAtIndexPaths:(NSArray *)indexPaths inSection:(NSUInteger)section
+{
+    NSMutableIndexSet *insertedIndexes = [NSMutableIndexSet indexSet];
+    
+    GNEOutlineViewParentItem *parentItem = [self parentItemForSection:section];
+    GNEOutlineViewItemArray *rows = [self itemsInSection:section];
+    NSAssert1(parentItem, @"No outline view parent item exists for section %lu", (unsigned long)section);
+    
+    if (parentItem == nil)
+    {
+        return insertedIndexes;
+    }
+    
+    // The rows are the indexes the new items end up at. As if the items were inserted one at a time,
+    // repeated rows move to the following index and rows beyond the end of the section are clamped to it.
+    NSUInteger rowCount = rows.count;
+    NSUInteger previousRow = NSNotFound;
+    for (NSIndexPath *indexPath in indexPaths)
+    {
+        NSParameterAssert(indexPath.gne_section == section);
+        
+        NSUInteger row = indexPath.gne_row;
+        if (previousRow != NSNotFound && row <= previousRow)
+        {
+            row = previousRow + 1;
+        }
+        row = MIN(row, rowCount + insertedIndexes.count);
+        [insertedIndexes addIndex:row];
+        previousRow = row;
+    }
+    
+    // The items are created by the item provider when the outline view first asks for them.
+    [rows insertEntriesAtIndexes:insertedIndexes];
+    
+    [self.selection insertItemsAtIndexes:insertedIndexes inSection:section];
+    
+    return [insertedIndexes copy];
+}
+
+
+- (NSIndexSet *)deleteRowsAtIndexPaths:(NSArray *)indexPaths inSection:(NSUInteger)section
+{
+    NSMutableIndexSet *deletedIndexes = [NSMutableIndexSet indexSet];
+    GNEOutlineViewItemArray *rows = [self itemsInSection:section];
+    
+    NSUInteger rowCount = rows.count;
+    
+    // Reversing the descending index paths appends every row to the end of the index set.
+    for (NSIndexPath *indexPath in [indexPaths reverseObjectEnumerator])
+    {
+        NSParameterAssert(indexPath.gne_section == section);
+        
+        NSUInteger row = indexPath.gne_row;
+        if (row < rowCount)
+        {
+            [deletedIndexes addIndex:row];
+        }
+    }
+    
+    [rows removeObjectsAtIndexes:deletedIndexes];
+    
+    [self.selection removeItemsAtIndexes:deletedIndexes inSection:section];
+    
+    return [deletedIndexes copy];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Selection
+// ------------------------------------------------------------------------------------------
+- (NSArray *)selectedIndexPaths
+{
+    NSMutableArray *indexPaths = [NSMutableArray array];
+    
+    [self.selection.sections enumerateIndexesUsingBlock:^(NSUInteger section, BOOL *stop __unused)
+    {
+        [self p_addSelectedIndexPathsInSection:section toArray:indexPaths];
+    }];
+    
+    return [indexPaths copy];
+}
+
+
+- (BOOL)isIndexPathSelected:(NSIndexPath *)indexPath
+{
+    if (indexPath == nil || indexPath.length != 2)
+    {
+        return NO;
+    }
+    
+    NSUInteger section = indexPath.gne_section;
+    NSUInteger row = indexPath.gne_row;
+    
+    if (row == GNESectionedTableViewModelHeaderRow)
+    {
+        return [self.selection isHeaderSelectedInSection:section];
+    }
+    
+    GNEOutlineViewParentItem *parentItem = [self parentItemForSection:section];
+    if (parentItem == nil)
+    {
+        return NO;
+    }
+    
+    NSUInteger itemCount = ((GNEOutlineViewItemArray *)self.items[section]).count;
+    NSUInteger footerIndex = (parentItem.hasFooter) ? itemCount - 1 : NSNotFound;
+    
+    if (row == GNESectionedTableViewModelFooterRow)
+    {
+        return (footerIndex != NSNotFound &&
+                [self.selection isItemSelectedAtIndex:footerIndex inSection:section]);
+    }
+    
+    // The footer is only selected through its footer index path.
+    return (row < itemCount && row != footerIndex &&
+            [self.selection isItemSelectedAtIndex:row inSection:section]);
+}
+
+
+- (NSArray *)selectedIndexPathsInSection:(NSUInteger)section
+{
+    NSMutableArray *indexPaths = [NSMutableArray array];
+    [self p_addSelectedIndexPathsInSection:section toArray:indexPaths];
+    
+    return [indexPaths copy];
+}
+
+
+- (void)selectItem:(GNEOutlineViewItem *)item
+{
+    if (item == nil)
+    {
+        return;
+    }
+    
+    GNEOutlineViewParentItem *parentItem = item.parentItem;
+    if (parentItem == nil)
+    {
+        NSUInteger section = [self sectionForParentItem:item];
+        if (section != NSNotFound)
+        {
+            [self.selection selectHeaderInSection:section];
+        }
+        
+        return;
+    }
+    
+    NSUInteger section = [self sectionForParentItem:parentItem];
+    if (section == NSNotFound)
+    {
+        return;
+    }
+    
+    NSUInteger index = [(GNEOutlineViewItemArray *)self.items[section] indexOfObject:item];
+    if (index != NSNotFound)
+    {
+        [self.selection selectItemsAtIndexes:[NSIndexSet indexSetWithIndex:index] inSection:section];
+    }
+}
+
+
+- (void)selectHeadersInSections:(NSIndexSet *)sections
+{
+    [sections enumerateIndexesUsingBlock:^(NSUInteger section, BOOL *stop __unused)
+    {
+        [self.selection selectHeaderInSection:section];
+    }];
+}
+
+
+- (void)deselectHeadersInSections:(NSIndexSet *)sections
+{
+    [sections enumerateIndexesUsingBlock:^(NSUInteger section, BOOL *stop __unused)
+    {
+        [self.selection deselectHeaderInSection:section];
+    }];
+}
+
+
+- (void)selectItemsAtIndexes:(NSIndexSet *)indexes inSection:(NSUInteger)section
+{
+    if (section >= self.items.count)
+    {
+        return;
+    }
+    
+    NSUInteger itemCount = ((GNEOutlineViewItemArray *)self.items[section]).count;
+    if (indexes.count > 0 && indexes.lastIndex >= itemCount)
+    {
+        NSMutableIndexSet *validIndexes = [indexes mutableCopy];
+        [validIndexes removeIndexesInRange:NSMakeRange(itemCount, NSNotFound - itemCount)];
+        indexes = validIndexes;
+    }
+    
+    [self.selection selectItemsAtIndexes:indexes inSection:section];
+}
+
+
+- (void)deselectItemsAtIndexes:(NSIndexSet *)indexes inSection:(NSUInteger)section
+{
+    [self.selection deselectItemsAtIndexes:indexes inSection:section];
+}
+
+
+- (void)deselectAllItems
+{
+    [self.selection deselectAll];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Internal
+// ------------------------------------------------------------------------------------------
+/**
+ Appends the index paths of the selected rows, section footer, and section header of the specified
+ section to the specified array, in that order, which is the order of -[NSIndexPath gne_compare:].
+ */
+- (void)p_addSelectedIndexPathsInSection:(NSUInteger)section toArray:(NSMutableArray *)indexPaths
+{
+    GNEOutlineViewParentItem *parentItem = [self parentItemForSection:section];
+    if (parentItem == nil)
+    {
+        return;
+    }
+    
+    NSIndexSet *selectedIndexes = [self.selection selectedItemIndexesInSection:section];
+    NSUInteger footerIndex = (parentItem.hasFooter) ?
+        ((GNEOutlineViewItemArray *)self.items[section]).count - 1 : NSNotFound;
+    
+    [selectedIndexes enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop __unused)
+    {
+        if (index != footerIndex)
+        {
+            [indexPaths addObject:[NSIndexPath gne_indexPathForRow:index inSection:section]];
+        }
+    }];
+    
+    if (footerIndex != NSNotFound && [selectedIndexes containsIndex:footerIndex])
+    {
+        [indexPaths addObject:[self indexPathForFooterInSection:section]];
+    }
+    
+    if ([self.selection isHeaderSelectedInSection:section])
+    {
+        [indexPaths addObject:[self indexPathForHeaderInSection:section]];
+    }
+}
+
+
+/**
+ Returns a new outline view item array containing the specified number of outline view items
+ belonging to the specified outline view parent item.
+ 
+ @discussion The outline view items aren't created until they are accessed, which for most rows is
+ when NSOutlineView asks for them in -outlineView:child:ofItem:. The table view recycles the items of
+ rows that are far from the visible rows.
+ */
+- (GNEOutlineViewItemArray *)p_itemArrayWithCount:(NSUInteger)count
+                                       parentItem:(GNEOutlineViewParentItem *)parentItem
+{
+    // Parent items don't reference their rows, so capturing the parent item strongly can't create a
+    // retain cycle. The outline view items' pasteboard writing delegate comes from the parent item.
+    GNEOutlineViewItemProvider itemProvider = ^GNEOutlineViewItem *()
+    {
+        return [[GNEOutlineViewItem alloc] initWithParentItem:parentItem];
+    };
+    
+    return [[GNEOutlineViewItemArray alloc] initWithCount:count itemProvider:itemProvider];
+}
+
+
+/**
+ Updates the sections stored in the outline view parent items to match their locations in the outline
+ view parent items array.
+ 
+ @discussion Only the parent items located at or after the specified section are updated because the
+ sections of the parent items before it are unaffected by insertions or deletions at that section.
+ */
+- (void)p_updateSectionsOfParentItemsStartingAtSection:(NSUInteger)section
+{
+    NSUInteger sectionCount = self.parentItems.count;
+    
+    for (NSUInteger index = section; index < sectionCount; index++)
+    {
+        ((GNEOutlineViewParentItem *)self.parentItems[index]).section = index;
+    }
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Description
+// ------------------------------------------------------------------------------------------
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p> Sections: %lu Items: %lu",
+            NSStringFromClass([self class]), self, (unsigned long)self.numberOfSections, (unsigned long)self.numberOfItems];
+}
+
+
+@end
@@ -0,0 +1,88 @@
+//
+//  GNESectionedTableViewSelection.h
+//  GNESectionedTableView
+//
+//  Copyright (c) 2014 Gone East LLC. All rights reserved.
+//
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2014 Gone East LLC
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+@import Foundation;
+
+// ------------------------------------------------------------------------------------------
+
+/**
+ GNESectionedTableViewSelection keeps track of the selected section headers and items (rows and
+ footers) of each section, so that the selection can be queried without resolving table view rows.
+ 
+ @discussion Items are identified by their indexes in their section's outline view item array,
+ which includes the footer. The selection doesn't know about the sections and items themselves, so
+ its owner must report every insertion and removal of sections and items to keep it in sync.
+ */
+@interface GNESectionedTableViewSelection : NSObject
+
+/// Sections containing a selected header or item. O(1)
+@property (nonatomic, copy, readonly, nonnull) NSIndexSet *sections;
+
+/// Number of selected headers and items. O(s) for s sections containing a selection
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+#pragma mark - Initializers
++ (nonnull instancetype)selection;
+- (nonnull instancetype)init NS_DESIGNATED_INITIALIZER;
+
+#pragma mark - Inserting and Removing Sections and Items
+/// Inserts unselected sections at the specified indexes, in ascending order. O(n)
+- (void)insertSectionsAtIndexes:(nonnull NSIndexSet *)sections;
+/// Removes the specified sections and their selection. O(n)
+- (void)removeSectionsAtIndexes:(nonnull NSIndexSet *)sections;
+/// Removes all of the sections and their selection.
+- (void)removeAllSections;
+/// Inserts unselected items at the specified indexes of the specified section, in ascending order.
+- (void)insertItemsAtIndexes:(nonnull NSIndexSet *)indexes inSection:(NSUInteger)section;
+/// Removes the items at the specified indexes of the specified section and their selection.
+- (void)removeItemsAtIndexes:(nonnull NSIndexSet *)indexes inSection:(NSUInteger)section;
+
+#pragma mark - Selecting
+/// Selects the header of the specified section. Invalid sections are ignored. O(lg s)
+- (void)selectHeaderInSection:(NSUInteger)section;
+/// Selects the items at the specified indexes of the specified section. Invalid sections are ignored.
+- (void)selectItemsAtIndexes:(nonnull NSIndexSet *)indexes inSection:(NSUInteger)section;
+/// Deselects the header of the specified section. O(lg s)
+- (void)deselectHeaderInSection:(NSUInteger)section;
+/// Deselects the items at the specified indexes of the specified section.
+- (void)deselectItemsAtIndexes:(nonnull NSIndexSet *)indexes inSection:(NSUInteger)section;
+/// Deselects all of the headers and items. O(s) for s sections containing a selection
+- (void)deselectAll;
+
+#pragma mark - Querying
+/// Returns YES if the header of the specified section is selected, otherwise NO. O(lg s)
+- (BOOL)isHeaderSelectedInSection:(NSUInteger)section;
+/// Returns YES if the item at the specified index of the specified section is selected, otherwise NO.
+/// O(1) to find the section and O(lg r) for r ranges of selected items in it
+- (BOOL)isItemSelectedAtIndex:(NSUInteger)index inSection:(NSUInteger)section;
+/// Returns the indexes of the selected items of the specified section. O(1)
+- (nonnull NSIndexSet *)selectedItemIndexesInSection:(NSUInteger)section;
+
+@end
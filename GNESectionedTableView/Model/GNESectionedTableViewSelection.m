@@ -0,0 +1,307 @@
+//
+//  GNESectionedTableViewSelection.m
+//  GNESectionedTableView
+//
+//  Copyright (c) 2014 Gone East LLC. All rights reserved.
+//
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2014 Gone East LLC
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import "GNESectionedTableViewSelection.h"
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@interface GNESectionedTableViewSelection ()
+
+/// Sections whose headers are selected.
+@property (nonatomic, strong) NSMutableIndexSet *selectedHeaders;
+
+/// Sections containing selected items.
+@property (nonatomic, strong) NSMutableIndexSet *sectionsWithSelectedItems;
+
+/// Array containing the mutable index set of the selected items of each section, or NSNull if no
+/// items have been selected in the section yet.
+@property (nonatomic, strong) NSMutableArray *selectedItems;
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@implementation GNESectionedTableViewSelection
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Initialization
+// ------------------------------------------------------------------------------------------
++ (instancetype)selection
+{
+    return [[[self class] alloc] init];
+}
+
+
+- (instancetype)init
+{
+    if ((self = [super init]))
+    {
+        _selectedHeaders = [NSMutableIndexSet indexSet];
+        _sectionsWithSelectedItems = [NSMutableIndexSet indexSet];
+        _selectedItems = [NSMutableArray array];
+    }
+    
+    return self;
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Properties
+// ------------------------------------------------------------------------------------------
+- (NSIndexSet *)sections
+{
+    NSMutableIndexSet *sections = [self.sectionsWithSelectedItems mutableCopy];
+    [sections addIndexes:self.selectedHeaders];
+    
+    return [sections copy];
+}
+
+
+- (NSUInteger)count
+{
+    __block NSUInteger count = self.selectedHeaders.count;
+    [self.sectionsWithSelectedItems enumerateIndexesUsingBlock:^(NSUInteger section, BOOL *stop __unused)
+    {
+        count += ((NSIndexSet *)self.selectedItems[section]).count;
+    }];
+    
+    return count;
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Inserting and Removing Sections and Items
+// ------------------------------------------------------------------------------------------
+- (void)insertSectionsAtIndexes:(NSIndexSet *)sections
+{
+    NSParameterAssert(sections);
+    
+    [sections enumerateIndexesUsingBlock:^(NSUInteger section, BOOL *stop __unused)
+    {
+        NSUInteger clampedSection = MIN(section, self.selectedItems.count);
+        [self.selectedItems insertObject:[NSNull null] atIndex:clampedSection];
+        [self.selectedHeaders shiftIndexesStartingAtIndex:clampedSection by:1];
+        [self.sectionsWithSelectedItems shiftIndexesStartingAtIndex:clampedSection by:1];
+    }];
+}
+
+
+- (void)removeSectionsAtIndexes:(NSIndexSet *)sections
+{
+    NSParameterAssert(sections);
+    
+    [sections enumerateIndexesWithOptions:NSEnumerationReverse usingBlock:^(NSUInteger section,
+                                                                            BOOL *stop __unused)
+    {
+        if (section < self.selectedItems.count)
+        {
+            [self.selectedItems removeObjectAtIndex:section];
+            [self.selectedHeaders shiftIndexesStartingAtIndex:(section + 1) by:-1];
+            [self.sectionsWithSelectedItems shiftIndexesStartingAtIndex:(section + 1) by:-1];
+        }
+    }];
+}
+
+
+- (void)removeAllSections
+{
+    [self.selectedItems removeAllObjects];
+    [self.selectedHeaders removeAllIndexes];
+    [self.sectionsWithSelectedItems removeAllIndexes];
+}
+
+
+- (void)insertItemsAtIndexes:(NSIndexSet *)indexes inSection:(NSUInteger)section
+{
+    NSParameterAssert(indexes);
+    
+    NSMutableIndexSet *selectedItems = [self p_selectedItemsInSection:section];
+    if (selectedItems.count == 0)
+    {
+        return;
+    }
+    
+    [indexes enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop __unused)
+    {
+        [selectedItems shiftIndexesStartingAtIndex:index by:1];
+    }];
+}
+
+
+- (void)removeItemsAtIndexes:(NSIndexSet *)indexes inSection:(NSUInteger)section
+{
+    NSParameterAssert(indexes);
+    
+    NSMutableIndexSet *selectedItems = [self p_selectedItemsInSection:section];
+    if (selectedItems.count == 0)
+    {
+        return;
+    }
+    
+    // Shifting the indexes after an index down by one removes the index itself.
+    [indexes enumerateIndexesWithOptions:NSEnumerationReverse usingBlock:^(NSUInteger index,
+                                                                           BOOL *stop __unused)
+    {
+        [selectedItems shiftIndexesStartingAtIndex:(index + 1) by:-1];
+    }];
+    
+    if (selectedItems.count == 0)
+    {
+        [self.sectionsWithSelectedItems removeIndex:section];
+    }
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Selecting
+// ------------------------------------------------------------------------------------------
+- (void)selectHeaderInSection:(NSUInteger)section
+{
+    if (section < self.selectedItems.count)
+    {
+        [self.selectedHeaders addIndex:section];
+    }
+}
+
+
+- (void)selectItemsAtIndexes:(NSIndexSet *)indexes inSection:(NSUInteger)section
+{
+    NSParameterAssert(indexes);
+    
+    if (section >= self.selectedItems.count || indexes.count == 0)
+    {
+        return;
+    }
+    
+    NSMutableIndexSet *selectedItems = [self p_selectedItemsInSection:section];
+    if (selectedItems == nil)
+    {
+        selectedItems = [NSMutableIndexSet indexSet];
+        self.selectedItems[section] = selectedItems;
+    }
+    
+    [selectedItems addIndexes:indexes];
+    [self.sectionsWithSelectedItems addIndex:section];
+}
+
+
+- (void)deselectHeaderInSection:(NSUInteger)section
+{
+    [self.selectedHeaders removeIndex:section];
+}
+
+
+- (void)deselectItemsAtIndexes:(NSIndexSet *)indexes inSection:(NSUInteger)section
+{
+    NSParameterAssert(indexes);
+    
+    NSMutableIndexSet *selectedItems = [self p_selectedItemsInSection:section];
+    if (selectedItems.count == 0)
+    {
+        return;
+    }
+    
+    [selectedItems removeIndexes:indexes];
+    
+    if (selectedItems.count == 0)
+    {
+        [self.sectionsWithSelectedItems removeIndex:section];
+    }
+}
+
+
+- (void)deselectAll
+{
+    [self.sectionsWithSelectedItems enumerateIndexesUsingBlock:^(NSUInteger section, BOOL *stop __unused)
+    {
+        [(NSMutableIndexSet *)self.selectedItems[section] removeAllIndexes];
+    }];
+    [self.sectionsWithSelectedItems removeAllIndexes];
+    [self.selectedHeaders removeAllIndexes];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Querying
+// ------------------------------------------------------------------------------------------
+- (BOOL)isHeaderSelectedInSection:(NSUInteger)section
+{
+    return [self.selectedHeaders containsIndex:section];
+}
+
+
+- (BOOL)isItemSelectedAtIndex:(NSUInteger)index inSection:(NSUInteger)section
+{
+    return [[self p_selectedItemsInSection:section] containsIndex:index];
+}
+
+
+- (NSIndexSet *)selectedItemIndexesInSection:(NSUInteger)section
+{
+    NSIndexSet *selectedItems = [self p_selectedItemsInSection:section];
+    
+    return (selectedItems) ? [selectedItems copy] : [NSIndexSet indexSet];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Internal
+// ------------------------------------------------------------------------------------------
+/// Returns the mutable index set of the selected items of the specified section, or nil if the
+/// section is invalid or none of its items have been selected yet.
+- (NSMutableIndexSet *)p_selectedItemsInSection:(NSUInteger)section
+{
+    if (section >= self.selectedItems.count)
+    {
+        return nil;
+    }
+    
+    id selectedItems = self.selectedItems[section];
+    
+    return (selectedItems == [NSNull null]) ? nil : selectedItems;
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Description
+// ------------------------------------------------------------------------------------------
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p> Headers: %@ Sections with selected items: %@",
+            NSStringFromClass([self class]), self, self.selectedHeaders, self.sectionsWithSelectedItems];
+}
+
+
+@end
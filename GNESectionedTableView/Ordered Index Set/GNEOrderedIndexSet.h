@@ -29,7 +29,7 @@
 //  SOFTWARE.
 //
 
-@import Cocoa;
+@import Foundation;
 
 
 @interface GNEOrderedIndexSet : NSObject <NSCopying>
@@ -46,42 +46,85 @@
 /// Returns an unordered index set (NSIndexSet) representation of the receiver.
 @property (nonatomic, assign, readonly) NSIndexSet *ns_indexSet;
 
+/// Returns the number of runs of indexes that are consecutive both in value and in the order of the
+/// receiver, e.g., { 5, 6, 7, 1, 2 } contains two runs. O(1)
+@property (nonatomic, assign, readonly) NSUInteger numberOfRanges;
+
+/// Returns YES if the receiver currently stores its indexes as runs instead of individually. Index sets
+/// switch between the two automatically, based on the average length of their runs, so that sets of
+/// large contiguous blocks of indexes need memory and time proportional to their number of runs.
+@property (nonatomic, assign, readonly, getter=isRangeCompressed) BOOL rangeCompressed;
+
 #pragma mark - Class initializers
 + (instancetype)indexSet;
 + (instancetype)indexSetWithIndex:(NSUInteger)index;
 + (instancetype)indexSetWithNSIndexSet:(NSIndexSet *)indexSet;
 + (instancetype)indexSetWithIndexes:(NSUInteger *)indexes count:(NSUInteger)count;
++ (instancetype)indexSetWithSortedIndexes:(const NSUInteger *)indexes count:(NSUInteger)count;
 
 #pragma mark - Initializers
 - (instancetype)init;
 - (instancetype)initWithIndex:(NSUInteger)index;
+/// Initializes the receiver with the indexes of the specified index set in ascending order. The
+/// indexes are copied range by range, without any temporary buffers. O(n), or O(r) for r ranges if
+/// the receiver ends up range compressed
 - (instancetype)initWithNSIndexSet:(NSIndexSet *)indexSet;
 - (instancetype)initWithIndexes:(NSUInteger *)indexes count:(NSUInteger)count NS_DESIGNATED_INITIALIZER;
+/// Initializes the receiver with the specified indexes, which must be strictly increasing, in a
+/// single pass. O(n)
+- (instancetype)initWithSortedIndexes:(const NSUInteger *)indexes count:(NSUInteger)count;
+/// Initializes the receiver with the specified indexes, which must be strictly increasing, without
+/// copying them into a temporary buffer. If freeWhenDone is YES, the receiver takes ownership of the
+/// buffer, which must have been allocated with malloc, and may use it as its own storage. Otherwise,
+/// the buffer is only read during initialization. O(n)
+- (instancetype)initWithSortedIndexesNoCopy:(NSUInteger *)indexes
+                                      count:(NSUInteger)count
+                               freeWhenDone:(BOOL)freeWhenDone;
 
 #pragma mark - Add/Remove Indexes
 /// Adds the specified index to the receiver if the receiver does not already
-/// contain it. O(lg n)
+/// contain it. O(lg n) if the index is larger than every index in the receiver, otherwise O(n)
 - (void)addIndex:(NSUInteger)index;
 /// Adds the specified indexes to the receiver if the receiver does not already
-/// contain them. O(lg n)
+/// contain them. O(m lg n) if the indexes are increasing and larger than every index in the receiver
 - (void)addIndexes:(NSUInteger *)indexes count:(NSUInteger)count;
 /// Adds the specified index to the receiver at the specified position if the receiver
 /// does not already contain it. Throws an exception if position is greater than
 /// the receiver's count. O(n)
 - (void)addIndex:(NSUInteger)index atPosition:(NSUInteger)position;
 /// Removes the specified index from the receiver, if the receiver contains it. Throws an
-/// exception if the specified index is greater than or equal to NSNotFound. O(n)
+/// exception if the specified index is greater than or equal to NSNotFound. O(n), but O(lg n)
+/// for the last index if it is also the largest index
 - (void)removeIndex:(NSUInteger)index;
 /// Removes the index located at the specified position. Throws an exception if the specified
-/// position is greater than the receiver's count - 1. O(lg n)
+/// position is greater than the receiver's count - 1. O(n), but O(lg n) for the last index
+/// if it is also the largest index
 - (void)removeIndexAtPosition:(NSUInteger)position;
 
+#pragma mark - Set Algebra
+/// Appends the indexes in the specified range that the receiver does not already contain, in
+/// ascending order. O(n + r lg r) for r resulting ranges
+- (void)addIndexesInRange:(NSRange)range;
+/// Appends the indexes of the specified index set that the receiver does not already contain, in
+/// the order of the specified index set. O(n + m + r lg r) for r resulting ranges
+- (void)unionIndexSet:(GNEOrderedIndexSet *)indexSet;
+/// Removes the indexes that the specified index set does not contain. The remaining indexes keep
+/// their order. O(n + m + r lg r) for r resulting ranges
+- (void)intersectIndexSet:(GNEOrderedIndexSet *)indexSet;
+/// Removes the indexes that the specified index set contains. The remaining indexes keep their
+/// order. O(n + m + r lg r) for r resulting ranges
+- (void)minusIndexSet:(GNEOrderedIndexSet *)indexSet;
+/// Shifts the indexes greater than or equal to the specified index by the specified delta, keeping
+/// their positions. Like -[NSMutableIndexSet shiftIndexesStartingAtIndex:by:], a negative delta
+/// removes the indexes in [index + delta, index). O(n + r lg r) for r resulting ranges
+- (void)shiftIndexesStartingAtIndex:(NSUInteger)index by:(NSInteger)delta;
+
 #pragma mark - Finding Indexes
 /// Returns the index at the specified position or NSNotFound if the position is beyond the
-/// bounds of the receiver. O(1)
+/// bounds of the receiver. O(1), or O(lg r) for r ranges if the receiver is range compressed
 - (NSUInteger)indexAtPosition:(NSUInteger)position;
 /// Returns the position of the specified index or NSNotFound if the receiver doesn't
-/// contain the specified index. O(n)
+/// contain the specified index. O(lg n)
 - (NSUInteger)positionOfIndex:(NSUInteger)index;
 /// Returns YES if the receiver contains the specified index, otherwise NO. O(lg n)
 - (BOOL)containsIndex:(NSUInteger)index;
@@ -94,6 +137,16 @@
 - (void)enumerateIndexesWithOptions:(NSEnumerationOptions)options
                          usingBlock:(void (^)(NSUInteger index, NSUInteger position, BOOL *stop))block;
 
+#pragma mark - Enumerating Ranges
+/// Executes a given block using each run of indexes that are consecutive both in value and in the
+/// order of the receiver. The position is the position of the first index of the range. O(r) if
+/// the receiver is range compressed, otherwise O(n)
+- (void)enumerateRangesUsingBlock:(void (^)(NSRange range, NSUInteger position, BOOL *stop))block;
+/// Executes a given block using each range in the receiver using the specified options (currently,
+/// NSEnumerationReverse is the only option supported).
+- (void)enumerateRangesWithOptions:(NSEnumerationOptions)options
+                        usingBlock:(void (^)(NSRange range, NSUInteger position, BOOL *stop))block;
+
 #pragma mark - Equality
 /// Returns YES if the receiver is equal to the specified index set, otherwise NO.
 /// Equality is determined by the count of the index sets and the
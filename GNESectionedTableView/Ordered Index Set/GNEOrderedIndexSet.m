@@ -36,16 +36,598 @@
 
 
 static const NSUInteger kMinimumCount = 100;
-static const NSUInteger kCountIncrementLength = 50;
+
+/// Smallest number of indexes an index set must contain before it stores its indexes as runs.
+static const NSUInteger kMinimumRangeCompressionCount = 128;
+/// An index set stores its indexes as runs once its runs are, on average, at least this long.
+static const NSUInteger kRangeCompressionRatio = 8;
+/// An index set stores its indexes individually again once its runs are, on average, shorter than this.
+static const NSUInteger kRangeDecompressionRatio = 2;
 
 static NSString * const kMemoryAllocationAssertionName = @"Memory Allocation Failure";
-static NSString * const kMemoryAllocationAssertionReason = @"Calloc failed";
+static NSString * const kMemoryAllocationAssertionReason = @"Realloc failed";
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Runs
+// ------------------------------------------------------------------------------------------
+/// Range of consecutive indexes that are also consecutive in the order of an ordered index set.
+typedef struct GNEIndexRun GNEIndexRun;
+
+struct GNEIndexRun
+{
+    NSUInteger location;
+    NSUInteger length;
+};
+
+
+/**
+ Run-length representation of an ordered index set. Runs are stored in the order of the index set and
+ are always maximal, i.e., no run ends right before the index that starts the next run.
+ */
+typedef struct GNEIndexRunStorage GNEIndexRunStorage;
+
+struct GNEIndexRunStorage
+{
+    /// Runs in the order of the index set.
+    GNEIndexRun *runs;
+    /// Position in the index set of the first index of each run.
+    NSUInteger *positions;
+    /// Numbers of the runs sorted by their locations.
+    NSUInteger *sortedRuns;
+    /// Number of runs.
+    NSUInteger count;
+    /// Number of runs that fit in the buffers.
+    NSUInteger memoryCount;
+};
+
+
+static inline NSUInteger GNEIndexRunEnd(GNEIndexRun run)
+{
+    return run.location + run.length;
+}
+
+
+static void GNEIndexRunStorageFree(GNEIndexRunStorage *storage)
+{
+    free(storage->runs);
+    free(storage->positions);
+    free(storage->sortedRuns);
+    memset(storage, 0, sizeof(GNEIndexRunStorage));
+}
+
+
+/// Makes room for the specified number of runs. Returns NO if the memory couldn't be allocated.
+static BOOL GNEIndexRunStorageReserve(GNEIndexRunStorage *storage, NSUInteger count)
+{
+    if (count <= storage->memoryCount)
+    {
+        return YES;
+    }
+    
+    NSUInteger memoryCount = MAX(storage->memoryCount, (NSUInteger)16);
+    while (memoryCount < count)
+    {
+        memoryCount = (memoryCount > NSUIntegerMax / 2) ? count : memoryCount * 2;
+    }
+    if (memoryCount > SIZE_MAX / sizeof(GNEIndexRun))
+    {
+        return NO;
+    }
+    
+    GNEIndexRun *runs = realloc(storage->runs, memoryCount * sizeof(GNEIndexRun));
+    if (runs == NULL)
+    {
+        return NO;
+    }
+    storage->runs = runs;
+    
+    NSUInteger *positions = realloc(storage->positions, memoryCount * sizeof(NSUInteger));
+    if (positions == NULL)
+    {
+        return NO;
+    }
+    storage->positions = positions;
+    
+    NSUInteger *sortedRuns = realloc(storage->sortedRuns, memoryCount * sizeof(NSUInteger));
+    if (sortedRuns == NULL)
+    {
+        return NO;
+    }
+    storage->sortedRuns = sortedRuns;
+    
+    storage->memoryCount = memoryCount;
+    
+    return YES;
+}
+
+
+/// Returns the first position in sortedRuns whose run starts after the specified index. O(lg n)
+static NSUInteger GNEIndexRunStorageUpperBound(const GNEIndexRunStorage *storage, NSUInteger index)
+{
+    NSUInteger bottom = 0;
+    NSUInteger top = storage->count;
+    
+    while (bottom < top)
+    {
+        NSUInteger middle = bottom + ((top - bottom) / 2);
+        
+        if (storage->runs[storage->sortedRuns[middle]].location <= index)
+        {
+            bottom = middle + 1;
+        }
+        else
+        {
+            top = middle;
+        }
+    }
+    
+    return bottom;
+}
+
+
+/// Returns the number of the run containing the specified index or NSNotFound. O(lg n)
+static NSUInteger GNEIndexRunStorageRunContainingIndex(const GNEIndexRunStorage *storage, NSUInteger index)
+{
+    NSUInteger sortedPosition = GNEIndexRunStorageUpperBound(storage, index);
+    
+    if (sortedPosition == 0)
+    {
+        return NSNotFound;
+    }
+    
+    NSUInteger run = storage->sortedRuns[sortedPosition - 1];
+    
+    return (index < GNEIndexRunEnd(storage->runs[run])) ? run : NSNotFound;
+}
+
+
+/// Returns the number of the run containing the specified position, which must be valid. O(lg n)
+static NSUInteger GNEIndexRunStorageRunContainingPosition(const GNEIndexRunStorage *storage, NSUInteger position)
+{
+    NSUInteger bottom = 0;
+    NSUInteger top = storage->count;
+    
+    while (bottom < top)
+    {
+        NSUInteger middle = bottom + ((top - bottom) / 2);
+        
+        if (storage->positions[middle] <= position)
+        {
+            bottom = middle + 1;
+        }
+        else
+        {
+            top = middle;
+        }
+    }
+    
+    return bottom - 1;
+}
+
+
+/// Recalculates the positions of the runs starting at the specified run. O(n)
+static void GNEIndexRunStorageUpdatePositions(GNEIndexRunStorage *storage, NSUInteger run)
+{
+    NSUInteger position = (run > 0) ? storage->positions[run - 1] + storage->runs[run - 1].length : 0;
+    
+    for (NSUInteger i = run; i < storage->count; i++)
+    {
+        storage->positions[i] = position;
+        position += storage->runs[i].length;
+    }
+}
+
+
+/// Inserts the specified run before the specified run number. The positions of the runs at and after
+/// the run number must be updated afterwards. Returns NO if the memory couldn't be allocated. O(n)
+static BOOL GNEIndexRunStorageInsertRun(GNEIndexRunStorage *storage, GNEIndexRun run, NSUInteger number)
+{
+    if (GNEIndexRunStorageReserve(storage, storage->count + 1) == NO)
+    {
+        return NO;
+    }
+    
+    NSUInteger count = storage->count;
+    
+    if (number < count)
+    {
+        memmove(&storage->runs[number + 1], &storage->runs[number], (count - number) * sizeof(GNEIndexRun));
+        memmove(&storage->positions[number + 1], &storage->positions[number], (count - number) * sizeof(NSUInteger));
+    }
+    storage->runs[number] = run;
+    
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        storage->sortedRuns[i] += (storage->sortedRuns[i] >= number) ? 1 : 0;
+    }
+    
+    NSUInteger sortedPosition = GNEIndexRunStorageUpperBound(storage, run.location);
+    if (sortedPosition < count)
+    {
+        memmove(&storage->sortedRuns[sortedPosition + 1], &storage->sortedRuns[sortedPosition],
+                (count - sortedPosition) * sizeof(NSUInteger));
+    }
+    storage->sortedRuns[sortedPosition] = number;
+    storage->count = count + 1;
+    
+    return YES;
+}
+
+
+/// Removes the run with the specified number. The positions of the runs at and after the run number
+/// must be updated afterwards. O(n)
+static void GNEIndexRunStorageRemoveRun(GNEIndexRunStorage *storage, NSUInteger number)
+{
+    NSUInteger count = storage->count;
+    NSUInteger sortedPosition = GNEIndexRunStorageUpperBound(storage, storage->runs[number].location) - 1;
+    
+    if (sortedPosition + 1 < count)
+    {
+        memmove(&storage->sortedRuns[sortedPosition], &storage->sortedRuns[sortedPosition + 1],
+                (count - sortedPosition - 1) * sizeof(NSUInteger));
+    }
+    if (number + 1 < count)
+    {
+        memmove(&storage->runs[number], &storage->runs[number + 1], (count - number - 1) * sizeof(GNEIndexRun));
+        memmove(&storage->positions[number], &storage->positions[number + 1], (count - number - 1) * sizeof(NSUInteger));
+    }
+    storage->count = count - 1;
+    
+    for (NSUInteger i = 0; i < count - 1; i++)
+    {
+        storage->sortedRuns[i] -= (storage->sortedRuns[i] > number) ? 1 : 0;
+    }
+}
+
+
+/// Adds the specified index, which must not be in the storage, at the specified position, which must
+/// not be greater than the number of indexes in the storage. Returns NO if the memory couldn't be allocated.
+static BOOL GNEIndexRunStorageAddIndex(GNEIndexRunStorage *storage, NSUInteger index,
+                                       NSUInteger position, NSUInteger indexCount)
+{
+    NSUInteger run = storage->count;
+    NSUInteger offset = 0;
+    
+    if (position < indexCount)
+    {
+        run = GNEIndexRunStorageRunContainingPosition(storage, position);
+        offset = position - storage->positions[run];
+    }
+    
+    if (offset > 0)
+    {
+        // Split the run around the new index.
+        GNEIndexRun *theRun = &storage->runs[run];
+        GNEIndexRun tail = {theRun->location + offset, theRun->length - offset};
+        theRun->length = offset;
+        
+        if (GNEIndexRunStorageInsertRun(storage, (GNEIndexRun){index, 1}, run + 1) == NO ||
+            GNEIndexRunStorageInsertRun(storage, tail, run + 2) == NO)
+        {
+            return NO;
+        }
+        GNEIndexRunStorageUpdatePositions(storage, run + 1);
+        
+        return YES;
+    }
+    
+    BOOL extendsPrevious = (run > 0 && GNEIndexRunEnd(storage->runs[run - 1]) == index);
+    BOOL extendsNext = (run < storage->count && index + 1 == storage->runs[run].location);
+    
+    if (extendsPrevious && extendsNext)
+    {
+        storage->runs[run - 1].length += 1 + storage->runs[run].length;
+        GNEIndexRunStorageRemoveRun(storage, run);
+    }
+    else if (extendsPrevious)
+    {
+        storage->runs[run - 1].length++;
+    }
+    else if (extendsNext)
+    {
+        storage->runs[run].location--;
+        storage->runs[run].length++;
+        run++;
+    }
+    else if (GNEIndexRunStorageInsertRun(storage, (GNEIndexRun){index, 1}, run) == NO)
+    {
+        return NO;
+    }
+    GNEIndexRunStorageUpdatePositions(storage, run);
+    
+    return YES;
+}
+
+
+/// Removes the index at the specified position, which must be valid. Returns NO if the memory
+/// couldn't be allocated.
+static BOOL GNEIndexRunStorageRemoveIndexAtPosition(GNEIndexRunStorage *storage, NSUInteger position)
+{
+    NSUInteger run = GNEIndexRunStorageRunContainingPosition(storage, position);
+    NSUInteger offset = position - storage->positions[run];
+    GNEIndexRun *theRun = &storage->runs[run];
+    
+    if (theRun->length == 1)
+    {
+        GNEIndexRunStorageRemoveRun(storage, run);
+        
+        // The runs around the removed run may now form a single run.
+        if (run > 0 && run < storage->count &&
+            GNEIndexRunEnd(storage->runs[run - 1]) == storage->runs[run].location)
+        {
+            storage->runs[run - 1].length += storage->runs[run].length;
+            GNEIndexRunStorageRemoveRun(storage, run);
+        }
+        GNEIndexRunStorageUpdatePositions(storage, run);
+    }
+    else if (offset == 0 || offset == theRun->length - 1)
+    {
+        theRun->location += (offset == 0) ? 1 : 0;
+        theRun->length--;
+        GNEIndexRunStorageUpdatePositions(storage, run + 1);
+    }
+    else
+    {
+        GNEIndexRun tail = {theRun->location + offset + 1, theRun->length - offset - 1};
+        theRun->length = offset;
+        
+        if (GNEIndexRunStorageInsertRun(storage, tail, run + 1) == NO)
+        {
+            return NO;
+        }
+        GNEIndexRunStorageUpdatePositions(storage, run + 1);
+    }
+    
+    return YES;
+}
+
+
+/// Run number paired with the location of the run, used to sort runs by their locations.
+typedef struct GNEIndexRunSortEntry GNEIndexRunSortEntry;
+
+struct GNEIndexRunSortEntry
+{
+    NSUInteger location;
+    NSUInteger run;
+};
+
+
+static int GNEIndexRunSortEntryCompare(const void *first, const void *second)
+{
+    NSUInteger firstLocation = ((const GNEIndexRunSortEntry *)first)->location;
+    NSUInteger secondLocation = ((const GNEIndexRunSortEntry *)second)->location;
+    
+    return (firstLocation < secondLocation) ? -1 : ((firstLocation > secondLocation) ? 1 : 0);
+}
+
+
+/// Copies the specified runs into the storage, replacing its runs, and builds their positions and
+/// location-sorted run table. Returns NO if the memory couldn't be allocated. O(n) if the runs are
+/// already sorted by location, otherwise O(n lg n)
+static BOOL GNEIndexRunStorageSetRuns(GNEIndexRunStorage *storage, const GNEIndexRun *runs, NSUInteger count)
+{
+    if (GNEIndexRunStorageReserve(storage, count) == NO)
+    {
+        return NO;
+    }
+    
+    BOOL isSorted = YES;
+    NSUInteger position = 0;
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        storage->runs[i] = runs[i];
+        storage->positions[i] = position;
+        position += runs[i].length;
+        isSorted = isSorted && (i == 0 || runs[i - 1].location < runs[i].location);
+    }
+    storage->count = count;
+    
+    if (isSorted)
+    {
+        for (NSUInteger i = 0; i < count; i++)
+        {
+            storage->sortedRuns[i] = i;
+        }
+        
+        return YES;
+    }
+    
+    GNEIndexRunSortEntry *entries = malloc(count * sizeof(GNEIndexRunSortEntry));
+    if (entries == NULL)
+    {
+        return NO;
+    }
+    
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        entries[i] = (GNEIndexRunSortEntry){runs[i].location, i};
+    }
+    
+    qsort(entries, count, sizeof(GNEIndexRunSortEntry), GNEIndexRunSortEntryCompare);
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        storage->sortedRuns[i] = entries[i].run;
+    }
+    free(entries);
+    
+    return YES;
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Run Buffers
+// ------------------------------------------------------------------------------------------
+/// Growable list of runs used to build the results of bulk operations.
+typedef struct GNEIndexRunBuffer GNEIndexRunBuffer;
+
+struct GNEIndexRunBuffer
+{
+    GNEIndexRun *runs;
+    NSUInteger count;
+    NSUInteger memoryCount;
+    /// Total length of the runs.
+    NSUInteger length;
+    /// Set if memory couldn't be allocated, in which case the buffer must not be used.
+    BOOL failed;
+};
+
+
+static void GNEIndexRunBufferFree(GNEIndexRunBuffer *buffer)
+{
+    free(buffer->runs);
+    memset(buffer, 0, sizeof(GNEIndexRunBuffer));
+}
+
+
+/// Appends the specified run, merging it into the last run if it continues it. Empty runs are ignored.
+static void GNEIndexRunBufferAppend(GNEIndexRunBuffer *buffer, GNEIndexRun run)
+{
+    if (run.length == 0 || buffer->failed)
+    {
+        return;
+    }
+    
+    buffer->length += run.length;
+    
+    if (buffer->count > 0 && GNEIndexRunEnd(buffer->runs[buffer->count - 1]) == run.location)
+    {
+        buffer->runs[buffer->count - 1].length += run.length;
+        
+        return;
+    }
+    
+    if (buffer->count == buffer->memoryCount)
+    {
+        NSUInteger memoryCount = MAX(buffer->memoryCount * 2, (NSUInteger)16);
+        GNEIndexRun *runs = NULL;
+        if (memoryCount > buffer->memoryCount && memoryCount <= SIZE_MAX / sizeof(GNEIndexRun))
+        {
+            runs = realloc(buffer->runs, memoryCount * sizeof(GNEIndexRun));
+        }
+        if (runs == NULL)
+        {
+            buffer->failed = YES;
+            
+            return;
+        }
+        buffer->runs = runs;
+        buffer->memoryCount = memoryCount;
+    }
+    
+    buffer->runs[buffer->count++] = run;
+}
+
+
+/**
+ Appends the parts of the specified run that are inside (if intersect is YES) or outside (if intersect is
+ NO) of the specified sorted, disjoint ranges. The parts are appended in ascending order.
+ O(lg m + k) for m ranges and k ranges overlapping the run.
+ */
+static void GNEIndexRunBufferAppendFilteredRun(GNEIndexRunBuffer *buffer, GNEIndexRun run,
+                                               const GNEIndexRun *ranges, NSUInteger rangeCount,
+                                               BOOL intersect)
+{
+    // Find the first range that ends after the start of the run.
+    NSUInteger bottom = 0;
+    NSUInteger top = rangeCount;
+    while (bottom < top)
+    {
+        NSUInteger middle = bottom + ((top - bottom) / 2);
+        if (GNEIndexRunEnd(ranges[middle]) <= run.location)
+        {
+            bottom = middle + 1;
+        }
+        else
+        {
+            top = middle;
+        }
+    }
+    
+    NSUInteger location = run.location;
+    NSUInteger end = GNEIndexRunEnd(run);
+    for (NSUInteger i = bottom; i < rangeCount && ranges[i].location < end && location < end; i++)
+    {
+        NSUInteger overlapLocation = MAX(location, ranges[i].location);
+        NSUInteger overlapEnd = MIN(end, GNEIndexRunEnd(ranges[i]));
+        
+        if (intersect)
+        {
+            GNEIndexRunBufferAppend(buffer, (GNEIndexRun){overlapLocation, overlapEnd - overlapLocation});
+        }
+        else
+        {
+            GNEIndexRunBufferAppend(buffer, (GNEIndexRun){location, overlapLocation - location});
+        }
+        location = overlapEnd;
+    }
+    
+    if (intersect == NO && location < end)
+    {
+        GNEIndexRunBufferAppend(buffer, (GNEIndexRun){location, end - location});
+    }
+}
+
+
+/**
+ Appends the specified run after shifting its indexes at or above the specified index by the specified
+ delta. If delta is negative, indexes in [index + delta, index) that aren't shifted are dropped, and so
+ are indexes that would be shifted to or past NSNotFound.
+ */
+static void GNEIndexRunBufferAppendShiftedRun(GNEIndexRunBuffer *buffer, GNEIndexRun run,
+                                              NSUInteger index, NSInteger delta)
+{
+    NSUInteger end = GNEIndexRunEnd(run);
+    NSUInteger magnitude = (delta < 0) ? (NSUInteger)(-(delta + 1)) + 1 : (NSUInteger)delta;
+    
+    // Indexes below the index aren't shifted.
+    NSUInteger lowerEnd = MIN(end, index);
+    if (delta < 0)
+    {
+        lowerEnd = MIN(lowerEnd, (index > magnitude) ? index - magnitude : 0);
+    }
+    if (run.location < lowerEnd)
+    {
+        GNEIndexRunBufferAppend(buffer, (GNEIndexRun){run.location, lowerEnd - run.location});
+    }
+    
+    NSUInteger upperLocation = MAX(run.location, index);
+    if (upperLocation >= end)
+    {
+        return;
+    }
+    
+    if (delta < 0)
+    {
+        // Drop the indexes that would become negative.
+        upperLocation = MAX(upperLocation, magnitude);
+        if (upperLocation < end)
+        {
+            GNEIndexRunBufferAppend(buffer, (GNEIndexRun){upperLocation - magnitude, end - upperLocation});
+        }
+    }
+    else if (upperLocation < NSNotFound - MIN(magnitude, NSNotFound))
+    {
+        NSUInteger shiftedEnd = (end < NSNotFound - magnitude) ? end + magnitude : NSNotFound;
+        GNEIndexRunBufferAppend(buffer, (GNEIndexRun){upperLocation + magnitude, shiftedEnd - upperLocation - magnitude});
+    }
+}
 
 
 // ------------------------------------------------------------------------------------------
 
 
 @interface GNEOrderedIndexSet ()
+{
+    /// Runs of consecutive indexes, which are only used while the receiver is range compressed.
+    GNEIndexRunStorage _runStorage;
+}
+
+/// YES if the receiver stores its indexes as runs instead of in indexes and sortedIndexes.
+@property (nonatomic, assign, readwrite, getter=isRangeCompressed) BOOL rangeCompressed;
+/// Number of adjacent positions in indexes whose indexes are consecutive. Only used while the
+/// receiver isn't range compressed, where the number of runs is indexesCount - linkCount.
+@property (nonatomic, assign) NSUInteger linkCount;
 
 /// Contains the number of actual indexes stored in indexes and orderedIndexes.
 @property (nonatomic, assign) NSUInteger indexesCount;
@@ -54,6 +636,9 @@ static NSString * const kMemoryAllocationAssertionReason = @"Calloc failed";
 
 @property (nonatomic, assign) NSUInteger *indexes;
 @property (nonatomic, assign) NSUInteger *sortedIndexes;
+/// Contains the position in indexes of each index in sortedIndexes, so that the position of an
+/// index can be found without scanning indexes.
+@property (nonatomic, assign) NSUInteger *positions;
 
 @end
 
@@ -94,6 +679,12 @@ static NSString * const kMemoryAllocationAssertionReason = @"Calloc failed";
 }
 
 
++ (instancetype)indexSetWithSortedIndexes:(const NSUInteger *)indexes count:(NSUInteger)count
+{
+    return [[[self class] alloc] initWithSortedIndexes:indexes count:count];
+}
+
+
 // ------------------------------------------------------------------------------------------
 #pragma mark - Initialization
 // ------------------------------------------------------------------------------------------
@@ -115,12 +706,64 @@ static NSString * const kMemoryAllocationAssertionReason = @"Calloc failed";
 {
     NSParameterAssert(indexSet == nil || [indexSet isKindOfClass:[NSIndexSet class]]);
     
-    NSUInteger count = indexSet.count;
+    if ((self = [self initWithIndexes:NULL count:0]))
+    {
+        NSUInteger count = indexSet.count;
+        
+        __block NSUInteger rangeCount = 0;
+        [indexSet enumerateRangesUsingBlock:^(NSRange range __unused, BOOL *stop __unused)
+        {
+            rangeCount++;
+        }];
+        
+        if ([self p_shouldRangeCompressIndexesCount:count runCount:rangeCount])
+        {
+            GNEIndexRunBuffer runs = {NULL, 0, 0, 0, NO};
+            GNEIndexRunBuffer *runsPointer = &runs;
+            [indexSet enumerateRangesUsingBlock:^(NSRange range, BOOL *stop __unused)
+            {
+                GNEIndexRunBufferAppend(runsPointer, (GNEIndexRun){range.location, range.length});
+            }];
+            [self p_replaceIndexesWithRunBuffer:&runs];
+        }
+        else
+        {
+            // NSIndexSet's ranges are sorted and maximal, so its indexes can be copied straight into the backing store.
+            [self p_increaseBackingStoreMemoryIfNeededForCount:count];
+            [indexSet getIndexes:self.indexes maxCount:count inIndexRange:NULL];
+            [self p_buildSortedIndexesWithCount:count runCount:rangeCount];
+        }
+    }
     
-    NSUInteger indexes[count];
-    [indexSet getIndexes:indexes maxCount:count inIndexRange:NULL];
+    return self;
+}
+
+
+- (instancetype)initWithSortedIndexes:(const NSUInteger *)indexes count:(NSUInteger)count
+{
+    if ((self = [self initWithIndexes:NULL count:0]))
+    {
+        [self p_setSortedIndexes:(NSUInteger *)indexes count:count takingOwnership:NO];
+    }
     
-    return [self initWithIndexes:indexes count:count];
+    return self;
+}
+
+
+- (instancetype)initWithSortedIndexesNoCopy:(NSUInteger *)indexes
+                                      count:(NSUInteger)count
+                               freeWhenDone:(BOOL)freeWhenDone
+{
+    if ((self = [self initWithIndexes:NULL count:0]))
+    {
+        [self p_setSortedIndexes:indexes count:count takingOwnership:freeWhenDone];
+    }
+    else if (freeWhenDone)
+    {
+        free(indexes);
+    }
+    
+    return self;
 }
 
 
@@ -129,10 +772,14 @@ static NSString * const kMemoryAllocationAssertionReason = @"Calloc failed";
     if ((self = [super init]))
     {
         _indexesCount = 0;
-        _memoryCount = (kMinimumCount > count) ? kMinimumCount : count + kCountIncrementLength;
-        _indexes = calloc(_memoryCount, sizeof(NSUInteger));
-        _sortedIndexes = calloc(_memoryCount, sizeof(NSUInteger));
+        _memoryCount = 0;
+        _indexes = NULL;
+        _sortedIndexes = NULL;
+        _positions = NULL;
+        _rangeCompressed = NO;
+        _linkCount = 0;
         
+        [self p_increaseBackingStoreMemoryToCount:MAX(kMinimumCount, count)];
         [self addIndexes:indexes count:count];
     }
     
@@ -156,6 +803,14 @@ static NSString * const kMemoryAllocationAssertionReason = @"Calloc failed";
         free(_sortedIndexes);
     }
     _sortedIndexes = NULL;
+    
+    if (_positions)
+    {
+        free(_positions);
+    }
+    _positions = NULL;
+    
+    GNEIndexRunStorageFree(&_runStorage);
 }
 
 
@@ -177,6 +832,20 @@ static NSString * const kMemoryAllocationAssertionReason = @"Calloc failed";
 {
     NSUInteger hash = 0;
     
+    if (self.isRangeCompressed)
+    {
+        // Sum of location, location + 1, ..., location + length - 1, allowed to overflow like the loop below.
+        for (NSUInteger i = 0; i < _runStorage.count; i++)
+        {
+            GNEIndexRun run = _runStorage.runs[i];
+            NSUInteger triangle = (run.length % 2 == 0) ? (run.length / 2) * (run.length - 1) :
+                                                          run.length * ((run.length - 1) / 2);
+            hash += run.length * run.location + triangle;
+        }
+        
+        return hash;
+    }
+    
     for (NSUInteger i = 0; i < self.indexesCount; i++)
     {
         hash += self.indexes[i];
@@ -193,10 +862,10 @@ static NSString * const kMemoryAllocationAssertionReason = @"Calloc failed";
     NSString *commaSpace = @", ";
     
     NSMutableString *mutableIndexesString = [NSMutableString stringWithString:@"{ "];
-    for (NSUInteger i = 0; i < count; i++)
+    [self enumerateIndexesUsingBlock:^(NSUInteger index, NSUInteger position __unused, BOOL *stop __unused)
     {
-        [mutableIndexesString appendFormat:@"%llu%@", (unsigned long long)self.indexes[i], commaSpace];
-    }
+        [mutableIndexesString appendFormat:@"%llu%@", (unsigned long long)index, commaSpace];
+    }];
     if ([mutableIndexesString hasSuffix:commaSpace])
     {
         [mutableIndexesString deleteCharactersInRange:NSMakeRange(mutableIndexesString.length - commaSpace.length,
@@ -214,6 +883,14 @@ static NSString * const kMemoryAllocationAssertionReason = @"Calloc failed";
 // ------------------------------------------------------------------------------------------
 - (instancetype)copyWithZone:(NSZone * __unused)zone
 {
+    if (self.isRangeCompressed)
+    {
+        GNEOrderedIndexSet *copy = [GNEOrderedIndexSet indexSet];
+        [copy p_copyRunStorage:&_runStorage indexesCount:self.indexesCount];
+        
+        return copy;
+    }
+    
     NSUInteger *indexes = self.indexes;
     NSUInteger indexesCount = self.indexesCount;
     
@@ -231,18 +908,17 @@ static NSString * const kMemoryAllocationAssertionReason = @"Calloc failed";
 {
     NSParameterAssert(index < NSNotFound);
     
-    if ([self containsIndex:index] == NO)
-    {
-        [self p_addIndexToIndexes:index];
-        [self p_addIndexToSortedIndexes:index];
-        self.indexesCount++;
-        [self p_increaseBackingStoreMemoryIfNeeded];
-    }
+    [self addIndex:index atPosition:self.indexesCount];
 }
 
 
 - (void)addIndexes:(NSUInteger *)indexes count:(NSUInteger)count
 {
+    if (self.isRangeCompressed == NO)
+    {
+        [self p_increaseBackingStoreMemoryIfNeededForCount:(self.indexesCount + count)];
+    }
+    
     for (NSUInteger i = 0; i < count; i++)
     {
         [self addIndex:indexes[i]];
@@ -255,14 +931,36 @@ static NSString * const kMemoryAllocationAssertionReason = @"Calloc failed";
     NSParameterAssert(index < NSNotFound);
     NSParameterAssert(position <= self.indexesCount);
     
-    if (index < NSNotFound && position <= self.indexesCount &&
-        [self containsIndex:index] == NO)
+    if (index >= NSNotFound || position > self.indexesCount)
+    {
+        return;
+    }
+    
+    if (self.isRangeCompressed)
+    {
+        if (GNEIndexRunStorageRunContainingIndex(&_runStorage, index) == NSNotFound)
+        {
+            if (GNEIndexRunStorageAddIndex(&_runStorage, index, position, self.indexesCount) == NO)
+            {
+                [self p_raiseMemoryAllocationException];
+            }
+            self.indexesCount++;
+            [self p_updateStorageIfNeeded];
+        }
+        
+        return;
+    }
+    
+    NSUInteger sortedPosition = [self p_lowerBoundInSortedIndexesOfIndex:index];
+    if (sortedPosition < self.indexesCount && self.sortedIndexes[sortedPosition] == index)
     {
-        [self p_addIndexToIndexes:index atPosition:position];
-        [self p_addIndexToSortedIndexes:index];
-        self.indexesCount++;
-        [self p_increaseBackingStoreMemoryIfNeeded];
+        return;
     }
+    
+    [self p_increaseBackingStoreMemoryIfNeededForCount:(self.indexesCount + 1)];
+    [self p_addIndex:index atPosition:position sortedPosition:sortedPosition];
+    self.indexesCount++;
+    [self p_updateStorageIfNeeded];
 }
 
 
@@ -270,11 +968,24 @@ static NSString * const kMemoryAllocationAssertionReason = @"Calloc failed";
 {
     NSParameterAssert(index < NSNotFound);
     
-    if (index < NSNotFound && [self containsIndex:index])
+    if (self.isRangeCompressed)
     {
-        [self p_removeIndexFromIndexes:index];
-        [self p_removeIndexFromSortedIndexes:index];
-        self.indexesCount--;
+        NSUInteger position = [self positionOfIndex:index];
+        
+        if (position != NSNotFound)
+        {
+            [self removeIndexAtPosition:position];
+        }
+        
+        return;
+    }
+    
+    NSUInteger sortedPosition = [self p_positionInSortedIndexesOfIndex:index];
+    
+    if (sortedPosition != NSNotFound)
+    {
+        [self p_removeIndexAtSortedPosition:sortedPosition];
+        [self p_updateStorageIfNeeded];
     }
 }
 
@@ -288,10 +999,101 @@ static NSString * const kMemoryAllocationAssertionReason = @"Calloc failed";
         return;
     }
     
-    NSUInteger index = self.indexes[position];
-    [self p_decrementPositionsAbovePosition:position inIndexes:self.indexes];
-    [self p_removeIndexFromSortedIndexes:index];
-    self.indexesCount--;
+    if (self.isRangeCompressed)
+    {
+        if (GNEIndexRunStorageRemoveIndexAtPosition(&_runStorage, position) == NO)
+        {
+            [self p_raiseMemoryAllocationException];
+        }
+        self.indexesCount--;
+    }
+    else
+    {
+        NSUInteger sortedPosition = [self p_positionInSortedIndexesOfIndex:self.indexes[position]];
+        NSAssert(sortedPosition != NSNotFound && self.positions[sortedPosition] == position,
+                 @"Index at position %lu is missing from the sorted indexes", (unsigned long)position);
+        
+        [self p_removeIndexAtSortedPosition:sortedPosition];
+    }
+    [self p_updateStorageIfNeeded];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Public - Set Algebra
+// ------------------------------------------------------------------------------------------
+- (void)addIndexesInRange:(NSRange)range
+{
+    NSParameterAssert(range.length == 0 || (range.location < NSNotFound && range.length <= NSNotFound - range.location));
+    
+    if (range.length == 0 || range.location >= NSNotFound || range.length > NSNotFound - range.location)
+    {
+        return;
+    }
+    
+    GNEIndexRunBuffer otherRuns = {NULL, 0, 0, 0, NO};
+    GNEIndexRunBufferAppend(&otherRuns, (GNEIndexRun){range.location, range.length});
+    [self p_unionOrderedRuns:&otherRuns];
+}
+
+
+- (void)unionIndexSet:(GNEOrderedIndexSet *)indexSet
+{
+    NSParameterAssert(indexSet == nil || [indexSet isKindOfClass:[GNEOrderedIndexSet class]]);
+    
+    if (indexSet.count == 0)
+    {
+        return;
+    }
+    
+    GNEIndexRunBuffer otherRuns = {NULL, 0, 0, 0, NO};
+    [indexSet p_getOrderedRuns:&otherRuns];
+    [self p_unionOrderedRuns:&otherRuns];
+}
+
+
+- (void)intersectIndexSet:(GNEOrderedIndexSet *)indexSet
+{
+    NSParameterAssert(indexSet == nil || [indexSet isKindOfClass:[GNEOrderedIndexSet class]]);
+    
+    [self p_filterWithIndexSet:indexSet intersect:YES];
+}
+
+
+- (void)minusIndexSet:(GNEOrderedIndexSet *)indexSet
+{
+    NSParameterAssert(indexSet == nil || [indexSet isKindOfClass:[GNEOrderedIndexSet class]]);
+    
+    if (indexSet.count == 0)
+    {
+        return;
+    }
+    
+    [self p_filterWithIndexSet:indexSet intersect:NO];
+}
+
+
+- (void)shiftIndexesStartingAtIndex:(NSUInteger)index by:(NSInteger)delta
+{
+    NSParameterAssert(index < NSNotFound);
+    
+    if (delta == 0 || self.indexesCount == 0 || index > [self p_largestIndex])
+    {
+        return;
+    }
+    
+    GNEIndexRunBuffer runs = {NULL, 0, 0, 0, NO};
+    [self p_getOrderedRuns:&runs];
+    
+    GNEIndexRunBuffer shiftedRuns = {NULL, 0, 0, 0, NO};
+    for (NSUInteger i = 0; i < runs.count; i++)
+    {
+        GNEIndexRunBufferAppendShiftedRun(&shiftedRuns, runs.runs[i], index, delta);
+    }
+    shiftedRuns.failed = (shiftedRuns.failed || runs.failed);
+    GNEIndexRunBufferFree(&runs);
+    
+    [self p_replaceIndexesWithRunBuffer:&shiftedRuns];
 }
 
 
@@ -300,168 +1102,457 @@ static NSString * const kMemoryAllocationAssertionReason = @"Calloc failed";
 // ------------------------------------------------------------------------------------------
 - (NSUInteger)indexAtPosition:(NSUInteger)position
 {
-    if (position < self.indexesCount)
+    if (position >= self.indexesCount)
+    {
+        return NSNotFound;
+    }
+    
+    if (self.isRangeCompressed)
+    {
+        NSUInteger run = GNEIndexRunStorageRunContainingPosition(&_runStorage, position);
+        
+        return _runStorage.runs[run].location + (position - _runStorage.positions[run]);
+    }
+    
+    return self.indexes[position];
+}
+
+
+- (NSUInteger)positionOfIndex:(NSUInteger)index
+{
+    if (self.isRangeCompressed)
+    {
+        NSUInteger run = (index < NSNotFound) ? GNEIndexRunStorageRunContainingIndex(&_runStorage, index) : NSNotFound;
+        
+        return (run == NSNotFound) ? NSNotFound : _runStorage.positions[run] + (index - _runStorage.runs[run].location);
+    }
+    
+    NSUInteger sortedPosition = [self p_positionInSortedIndexesOfIndex:index];
+    
+    return (sortedPosition == NSNotFound) ? NSNotFound : self.positions[sortedPosition];
+}
+
+
+- (BOOL)containsIndex:(NSUInteger)index
+{
+    if (self.isRangeCompressed)
+    {
+        return (index < NSNotFound && GNEIndexRunStorageRunContainingIndex(&_runStorage, index) != NSNotFound);
+    }
+    
+    return ([self p_positionInSortedIndexesOfIndex:index] != NSNotFound);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Public - Enumeration
+// ------------------------------------------------------------------------------------------
+- (void)enumerateIndexesUsingBlock:(void (^)(NSUInteger index, NSUInteger position, BOOL *stop))block
+{
+    [self enumerateIndexesWithOptions:0 usingBlock:block];
+}
+
+
+- (void)enumerateIndexesWithOptions:(NSEnumerationOptions)options
+                         usingBlock:(void (^)(NSUInteger, NSUInteger, BOOL *))block
+{
+    BOOL isReversed = options & NSEnumerationReverse;
+    
+    if (self.isRangeCompressed)
+    {
+        [self p_enumerateRunsWithOptions:options usingBlock:block];
+        
+        return;
+    }
+    
+    NSUInteger count = self.indexesCount;
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        BOOL stop = NO;
+        
+        NSUInteger index = (isReversed) ? (count - 1 - i) : i;
+        block(self.indexes[index], i, &stop);
+        
+        if (stop)
+        {
+            break;
+        }
+    }
+}
+
+
+- (void)enumerateRangesUsingBlock:(void (^)(NSRange range, NSUInteger position, BOOL *stop))block
+{
+    [self enumerateRangesWithOptions:0 usingBlock:block];
+}
+
+
+- (void)enumerateRangesWithOptions:(NSEnumerationOptions)options
+                        usingBlock:(void (^)(NSRange, NSUInteger, BOOL *))block
+{
+    BOOL isReversed = options & NSEnumerationReverse;
+    
+    if (self.isRangeCompressed)
+    {
+        NSUInteger runCount = _runStorage.count;
+        for (NSUInteger i = 0; i < runCount; i++)
+        {
+            BOOL stop = NO;
+            
+            NSUInteger run = (isReversed) ? (runCount - 1 - i) : i;
+            block(NSMakeRange(_runStorage.runs[run].location, _runStorage.runs[run].length),
+                  _runStorage.positions[run], &stop);
+            
+            if (stop)
+            {
+                break;
+            }
+        }
+        
+        return;
+    }
+    
+    NSUInteger *indexes = self.indexes;
+    NSUInteger count = self.indexesCount;
+    NSUInteger start = 0;
+    NSUInteger end = count;
+    for (NSUInteger i = 1; i <= count; i++)
+    {
+        BOOL stop = NO;
+        
+        if (isReversed)
+        {
+            // Walk backwards from the end, reporting a range whenever its first index is found.
+            NSUInteger position = count - i;
+            if (position > 0 && indexes[position - 1] + 1 == indexes[position])
+            {
+                continue;
+            }
+            block(NSMakeRange(indexes[position], end - position), position, &stop);
+            end = position;
+        }
+        else
+        {
+            if (i < count && indexes[i - 1] + 1 == indexes[i])
+            {
+                continue;
+            }
+            block(NSMakeRange(indexes[start], i - start), start, &stop);
+            start = i;
+        }
+        
+        if (stop)
+        {
+            break;
+        }
+    }
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Public - Equality
+// ------------------------------------------------------------------------------------------
+- (BOOL)isEqualToIndexSet:(GNEOrderedIndexSet *)indexSet
+{
+    if (self.isRangeCompressed && indexSet.isRangeCompressed)
+    {
+        // Runs are always maximal, so equal index sets have equal runs.
+        const GNEIndexRunStorage *otherRunStorage = [indexSet p_runStorage];
+        
+        return (self.indexesCount == indexSet.indexesCount && _runStorage.count == otherRunStorage->count &&
+                memcmp(_runStorage.runs, otherRunStorage->runs, _runStorage.count * sizeof(GNEIndexRun)) == 0);
+    }
+    
+    if (self.count == indexSet.count)
+    {
+        NSUInteger count = self.count;
+        for (NSUInteger i = 0; i < count; i++)
+        {
+            NSUInteger selfIndex = [self indexAtPosition:i];
+            NSUInteger otherIndex = [indexSet indexAtPosition:i];
+            
+            if (selfIndex != otherIndex)
+            {
+                return NO;
+            }
+        }
+        
+        return YES;
+    }
+    
+    return NO;
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Private - Add/Remove
+// ------------------------------------------------------------------------------------------
+/**
+ Inserts the specified index at the specified position of indexes and at the specified position of
+ sortedIndexes. The backing store must have room for one more index and the caller is responsible for
+ incrementing indexesCount.
+ */
+- (void)p_addIndex:(NSUInteger)index atPosition:(NSUInteger)position sortedPosition:(NSUInteger)sortedPosition
+{
+    NSUInteger count = self.indexesCount;
+    NSUInteger *indexes = self.indexes;
+    NSUInteger *sortedIndexes = self.sortedIndexes;
+    NSUInteger *positions = self.positions;
+    
+    [self p_updateLinkCountForIndex:index atPosition:position isRemoval:NO];
+    
+    if (position < count)
+    {
+        memmove(&indexes[position + 1], &indexes[position], (count - position) * sizeof(NSUInteger));
+        
+        // Every index at or after the insertion position moves up by one.
+        for (NSUInteger i = 0; i < count; i++)
+        {
+            positions[i] += (positions[i] >= position) ? 1 : 0;
+        }
+    }
+    indexes[position] = index;
+    
+    if (sortedPosition < count)
     {
-        return self.indexes[position];
+        size_t length = (count - sortedPosition) * sizeof(NSUInteger);
+        memmove(&sortedIndexes[sortedPosition + 1], &sortedIndexes[sortedPosition], length);
+        memmove(&positions[sortedPosition + 1], &positions[sortedPosition], length);
     }
-    
-    return NSNotFound;
+    sortedIndexes[sortedPosition] = index;
+    positions[sortedPosition] = position;
 }
 
 
-- (NSUInteger)positionOfIndex:(NSUInteger)index
+/// Removes the index located at the specified position of sortedIndexes from the receiver.
+- (void)p_removeIndexAtSortedPosition:(NSUInteger)sortedPosition
 {
-    if ([self containsIndex:index] == NO)
+    NSUInteger count = self.indexesCount;
+    NSUInteger *indexes = self.indexes;
+    NSUInteger *sortedIndexes = self.sortedIndexes;
+    NSUInteger *positions = self.positions;
+    
+    NSParameterAssert(sortedPosition < count);
+    
+    NSUInteger position = positions[sortedPosition];
+    NSUInteger lastPosition = count - 1;
+    
+    [self p_updateLinkCountForIndex:indexes[position] atPosition:position isRemoval:YES];
+    
+    if (sortedPosition < lastPosition)
     {
-        return NSNotFound;
+        size_t length = (lastPosition - sortedPosition) * sizeof(NSUInteger);
+        memmove(&sortedIndexes[sortedPosition], &sortedIndexes[sortedPosition + 1], length);
+        memmove(&positions[sortedPosition], &positions[sortedPosition + 1], length);
     }
     
-    for (NSUInteger i = 0; i < self.indexesCount; i++)
+    if (position < lastPosition)
     {
-        NSUInteger anIndex = [self indexAtPosition:i];
+        memmove(&indexes[position], &indexes[position + 1], (lastPosition - position) * sizeof(NSUInteger));
         
-        if (index == anIndex)
+        // Every index after the removed position moves down by one.
+        for (NSUInteger i = 0; i < lastPosition; i++)
         {
-            return i;
+            positions[i] -= (positions[i] > position) ? 1 : 0;
         }
     }
     
-    return NSNotFound;
-}
-
-
-- (BOOL)containsIndex:(NSUInteger)index
-{
-    NSUInteger position = [self p_positionInSortedIndexesOfIndex:index
-                                                   startPosition:0
-                                                     endPosition:self.indexesCount];
-    
-    return (position != NSNotFound);
+    self.indexesCount = lastPosition;
 }
 
 
 // ------------------------------------------------------------------------------------------
-#pragma mark - Public - Enumeration
+#pragma mark - Private - Set Algebra
 // ------------------------------------------------------------------------------------------
-- (void)enumerateIndexesUsingBlock:(void (^)(NSUInteger index, NSUInteger position, BOOL *stop))block
-{
-    [self enumerateIndexesWithOptions:0 usingBlock:block];
-}
-
-
-- (void)enumerateIndexesWithOptions:(NSEnumerationOptions)options
-                         usingBlock:(void (^)(NSUInteger, NSUInteger, BOOL *))block
+/// Appends the receiver's runs to the specified buffer in the order of the receiver. O(n) or O(r)
+- (void)p_getOrderedRuns:(GNEIndexRunBuffer *)buffer
 {
-    BOOL isReversed = options & NSEnumerationReverse;
-    
-    NSUInteger count = self.indexesCount;
-    for (NSUInteger i = 0; i < count; i++)
+    if (self.isRangeCompressed)
     {
-        BOOL stop = NO;
-        
-        NSUInteger index = (isReversed) ? (count - 1 - i) : i;
-        block(self.indexes[index], i, &stop);
-        
-        if (stop)
+        for (NSUInteger i = 0; i < _runStorage.count; i++)
         {
-            break;
+            GNEIndexRunBufferAppend(buffer, _runStorage.runs[i]);
         }
+        
+        return;
+    }
+    
+    NSUInteger *indexes = self.indexes;
+    for (NSUInteger i = 0; i < self.indexesCount; i++)
+    {
+        GNEIndexRunBufferAppend(buffer, (GNEIndexRun){indexes[i], 1});
     }
 }
 
 
-// ------------------------------------------------------------------------------------------
-#pragma mark - Public - Equality
-// ------------------------------------------------------------------------------------------
-- (BOOL)isEqualToIndexSet:(GNEOrderedIndexSet *)indexSet
+/// Appends the receiver's indexes to the specified buffer as sorted, disjoint ranges. O(n) or O(r)
+- (void)p_getSortedRanges:(GNEIndexRunBuffer *)buffer
 {
-    if (self.count == indexSet.count)
+    if (self.isRangeCompressed)
     {
-        NSUInteger count = self.count;
-        for (NSUInteger i = 0; i < count; i++)
+        for (NSUInteger i = 0; i < _runStorage.count; i++)
         {
-            NSUInteger selfIndex = [self indexAtPosition:i];
-            NSUInteger otherIndex = [indexSet indexAtPosition:i];
-            
-            if (selfIndex != otherIndex)
-            {
-                return NO;
-            }
+            GNEIndexRunBufferAppend(buffer, _runStorage.runs[_runStorage.sortedRuns[i]]);
         }
         
-        return YES;
+        return;
     }
     
-    return NO;
+    NSUInteger *sortedIndexes = self.sortedIndexes;
+    for (NSUInteger i = 0; i < self.indexesCount; i++)
+    {
+        GNEIndexRunBufferAppend(buffer, (GNEIndexRun){sortedIndexes[i], 1});
+    }
 }
 
 
-// ------------------------------------------------------------------------------------------
-#pragma mark - Private - Add/Remove
-// ------------------------------------------------------------------------------------------
-- (void)p_addIndexToIndexes:(NSUInteger)index
+/// Appends the parts of the specified runs that the receiver doesn't contain to the end of the
+/// receiver. Frees the buffer.
+- (void)p_unionOrderedRuns:(GNEIndexRunBuffer *)otherRuns
 {
-    [self p_addIndexToIndexes:index atPosition:self.indexesCount];
+    GNEIndexRunBuffer sortedRanges = {NULL, 0, 0, 0, NO};
+    [self p_getSortedRanges:&sortedRanges];
+    
+    GNEIndexRunBuffer runs = {NULL, 0, 0, 0, NO};
+    [self p_getOrderedRuns:&runs];
+    for (NSUInteger i = 0; i < otherRuns->count; i++)
+    {
+        GNEIndexRunBufferAppendFilteredRun(&runs, otherRuns->runs[i], sortedRanges.runs, sortedRanges.count, NO);
+    }
+    runs.failed = (runs.failed || sortedRanges.failed || otherRuns->failed);
+    GNEIndexRunBufferFree(&sortedRanges);
+    GNEIndexRunBufferFree(otherRuns);
+    
+    [self p_replaceIndexesWithRunBuffer:&runs];
 }
 
 
-- (void)p_addIndexToIndexes:(NSUInteger)index atPosition:(NSUInteger)position
+/// Keeps the receiver's indexes that are (if intersect is YES) or aren't (if intersect is NO)
+/// contained in the specified index set, in their current order.
+- (void)p_filterWithIndexSet:(GNEOrderedIndexSet *)indexSet intersect:(BOOL)intersect
 {
-    position = (position <= self.indexesCount) ? position : self.indexesCount;
-    [self p_incrementPositionsAtAndAbovePosition:position inIndexes:self.indexes];
-    self.indexes[position] = index;
+    GNEIndexRunBuffer sortedRanges = {NULL, 0, 0, 0, NO};
+    [indexSet p_getSortedRanges:&sortedRanges];
+    
+    GNEIndexRunBuffer runs = {NULL, 0, 0, 0, NO};
+    [self p_getOrderedRuns:&runs];
+    
+    GNEIndexRunBuffer filteredRuns = {NULL, 0, 0, 0, NO};
+    for (NSUInteger i = 0; i < runs.count; i++)
+    {
+        GNEIndexRunBufferAppendFilteredRun(&filteredRuns, runs.runs[i], sortedRanges.runs, sortedRanges.count, intersect);
+    }
+    filteredRuns.failed = (filteredRuns.failed || runs.failed || sortedRanges.failed);
+    GNEIndexRunBufferFree(&sortedRanges);
+    GNEIndexRunBufferFree(&runs);
+    
+    [self p_replaceIndexesWithRunBuffer:&filteredRuns];
 }
 
 
-- (void)p_addIndexToSortedIndexes:(NSUInteger)index
+/**
+ Replaces the receiver's indexes with the specified runs, which must be disjoint, and frees the buffer.
+ 
+ @discussion The result is stored as runs first and then expanded into individual indexes if its runs
+ are too short to be worth keeping, so that every bulk operation costs O(n + r lg r).
+ */
+- (void)p_replaceIndexesWithRunBuffer:(GNEIndexRunBuffer *)buffer
 {
-    NSUInteger insertionPosition = [self p_insertionPositionInSortedIndexesForIndex:index];
+    GNEIndexRunStorage storage = {NULL, NULL, NULL, 0, 0};
     
-    if (insertionPosition == NSNotFound)
+    if (buffer->failed || GNEIndexRunStorageSetRuns(&storage, buffer->runs, buffer->count) == NO)
     {
+        GNEIndexRunStorageFree(&storage);
+        GNEIndexRunBufferFree(buffer);
+        [self p_raiseMemoryAllocationException];
+        
         return;
     }
-
-    [self p_incrementPositionsAtAndAbovePosition:insertionPosition
-                                       inIndexes:self.sortedIndexes];
-    self.sortedIndexes[insertionPosition] = index;
+    
+    NSUInteger indexesCount = buffer->length;
+    GNEIndexRunBufferFree(buffer);
+    [self p_replaceRunStorage:storage indexesCount:indexesCount];
+    
+    if ([self p_shouldRangeCompressIndexesCount:indexesCount runCount:_runStorage.count] == NO)
+    {
+        [self p_decompressRuns];
+    }
 }
 
 
-- (void)p_removeIndexFromIndexes:(NSUInteger)index
+// ------------------------------------------------------------------------------------------
+#pragma mark - Private - Sorted Construction
+// ------------------------------------------------------------------------------------------
+/**
+ Replaces the indexes of the receiver, which must be empty, with the specified strictly increasing
+ indexes in a single pass. If takeOwnership is YES, the receiver frees the buffer, which must have been
+ allocated with malloc, and adopts it as its backing store when it doesn't store the indexes as runs.
+ 
+ @discussion Indexes that aren't strictly increasing fail an assertion and are added one by one instead.
+ */
+- (void)p_setSortedIndexes:(NSUInteger *)indexes count:(NSUInteger)count takingOwnership:(BOOL)takeOwnership
 {
-    NSUInteger position = NSNotFound;
+    NSParameterAssert(self.indexesCount == 0 && self.isRangeCompressed == NO);
     
-    for (NSUInteger i = 0; i < self.indexesCount; i++)
+    BOOL isSorted = YES;
+    NSUInteger runCount = 0;
+    for (NSUInteger i = 0; i < count && isSorted; i++)
+    {
+        isSorted = (indexes[i] < NSNotFound && (i == 0 || indexes[i - 1] < indexes[i]));
+        runCount += (i == 0 || indexes[i - 1] + 1 != indexes[i]) ? 1 : 0;
+    }
+    NSParameterAssert(isSorted);
+    
+    if (isSorted == NO)
+    {
+        [self addIndexes:indexes count:count];
+    }
+    else if ([self p_shouldRangeCompressIndexesCount:count runCount:runCount])
     {
-        NSUInteger anIndex = self.indexes[i];
-        if (anIndex == index)
+        GNEIndexRunBuffer runs = {NULL, 0, 0, 0, NO};
+        for (NSUInteger i = 0; i < count; i++)
         {
-            position = i;
-            break;
+            GNEIndexRunBufferAppend(&runs, (GNEIndexRun){indexes[i], 1});
         }
+        [self p_replaceIndexesWithRunBuffer:&runs];
+    }
+    else if (takeOwnership && count > 0)
+    {
+        free(self.indexes);
+        self.indexes = indexes;
+        takeOwnership = NO;
+        
+        [self p_increaseBackingStoreMemoryToCount:MAX(kMinimumCount, count)];
+        [self p_buildSortedIndexesWithCount:count runCount:runCount];
+    }
+    else
+    {
+        [self p_increaseBackingStoreMemoryIfNeededForCount:count];
+        memcpy(self.indexes, indexes, count * sizeof(NSUInteger));
+        [self p_buildSortedIndexesWithCount:count runCount:runCount];
     }
     
-    if (position != NSNotFound)
+    if (takeOwnership)
     {
-        [self p_decrementPositionsAbovePosition:position inIndexes:self.indexes];
+        free(indexes);
     }
 }
 
 
-- (void)p_removeIndexFromSortedIndexes:(NSUInteger)index
+/// Fills sortedIndexes and positions from the first count indexes of indexes, which must be strictly
+/// increasing and form the specified number of runs, and makes them the receiver's indexes. O(n)
+- (void)p_buildSortedIndexesWithCount:(NSUInteger)count runCount:(NSUInteger)runCount
 {
-    NSUInteger position = [self p_positionInSortedIndexesOfIndex:index
-                                                   startPosition:0
-                                                     endPosition:(self.indexesCount - 1)];
+    NSUInteger *positions = self.positions;
     
-    if (position == NSNotFound)
+    memcpy(self.sortedIndexes, self.indexes, count * sizeof(NSUInteger));
+    for (NSUInteger i = 0; i < count; i++)
     {
-        return;
+        positions[i] = i;
     }
     
-    [self p_decrementPositionsAbovePosition:position
-                                  inIndexes:self.sortedIndexes];
+    self.indexesCount = count;
+    self.linkCount = count - runCount;
 }
 
 
@@ -470,6 +1561,11 @@ static NSString * const kMemoryAllocationAssertionReason = @"Calloc failed";
 // ------------------------------------------------------------------------------------------
 - (NSUInteger)p_smallestIndex
 {
+    if (self.isRangeCompressed)
+    {
+        return (_runStorage.count > 0) ? _runStorage.runs[_runStorage.sortedRuns[0]].location : NSNotFound;
+    }
+    
     if (self.indexesCount > 0)
     {
         return self.sortedIndexes[0];
@@ -481,6 +1577,16 @@ static NSString * const kMemoryAllocationAssertionReason = @"Calloc failed";
 
 - (NSUInteger)p_largestIndex
 {
+    if (self.isRangeCompressed)
+    {
+        if (_runStorage.count == 0)
+        {
+            return NSNotFound;
+        }
+        
+        return GNEIndexRunEnd(_runStorage.runs[_runStorage.sortedRuns[_runStorage.count - 1]]) - 1;
+    }
+    
     if (self.indexesCount > 0)
     {
         return self.sortedIndexes[self.indexesCount - 1];
@@ -490,83 +1596,56 @@ static NSString * const kMemoryAllocationAssertionReason = @"Calloc failed";
 }
 
 
-
-/// Returns the position of the specified index within the specified range or NSNotFound if the
-/// specified index could not be found.
+/// Returns the position of the specified index in sortedIndexes or NSNotFound if the receiver
+/// doesn't contain the specified index. O(lg n)
 - (NSUInteger)p_positionInSortedIndexesOfIndex:(NSUInteger)index
-                                 startPosition:(NSUInteger)startPosition
-                                   endPosition:(NSUInteger)endPosition
 {
-    NSInteger bottom = (NSInteger)startPosition;
-    NSInteger top = (NSInteger)endPosition;
-    
-    if (self.indexesCount == 0 || index >= NSNotFound || top < bottom)
+    if (index >= NSNotFound)
     {
         return NSNotFound;
     }
     
-    NSInteger middle = ((bottom + top) / 2);
+    NSUInteger position = [self p_lowerBoundInSortedIndexesOfIndex:index];
     
-    NSUInteger midIndex = self.sortedIndexes[middle];
-    if (index < midIndex)
-    {
-        return [self p_positionInSortedIndexesOfIndex:index
-                                        startPosition:(NSUInteger)bottom
-                                          endPosition:((NSUInteger)middle - 1)];
-    }
-    else if (index > midIndex)
+    if (position < self.indexesCount && self.sortedIndexes[position] == index)
     {
-        return [self p_positionInSortedIndexesOfIndex:index
-                                        startPosition:((NSUInteger)middle + 1)
-                                          endPosition:(NSUInteger)top];
+        return position;
     }
     
-    return (NSUInteger)middle;
+    return NSNotFound;
 }
 
 
-- (NSUInteger)p_insertionPositionInSortedIndexesForIndex:(NSUInteger)index
+/// Returns the position of the first index in sortedIndexes that is not less than the specified
+/// index, which is indexesCount if every index in the receiver is less than it. O(lg n)
+- (NSUInteger)p_lowerBoundInSortedIndexesOfIndex:(NSUInteger)index
 {
-    if (self.indexesCount == 0)
-    {
-        return 0;
-    }
-    
-    NSUInteger smallestIndex = [self p_smallestIndex];
-    NSUInteger largestIndex = [self p_largestIndex];
+    NSUInteger *sortedIndexes = self.sortedIndexes;
+    NSUInteger count = self.indexesCount;
     
-    if (index < smallestIndex)
-    {
-        return 0;
-    }
-    else if (index > largestIndex)
+    // Appending increasing indexes is by far the most common case, so check the end first.
+    if (count == 0 || sortedIndexes[count - 1] < index)
     {
-        return self.indexesCount;
+        return count;
     }
     
     NSUInteger bottom = 0;
-    NSUInteger top = self.indexesCount - 1;
+    NSUInteger top = count;
     
-    while (top > bottom)
+    while (bottom < top)
     {
-        NSUInteger middle = ((bottom + top) / 2);
-        NSUInteger midIndex = self.sortedIndexes[middle];
+        NSUInteger middle = bottom + ((top - bottom) / 2);
         
-        if (index > midIndex)
+        if (sortedIndexes[middle] < index)
         {
             bottom = middle + 1;
         }
         else
         {
-            top = middle - 1;
+            top = middle;
         }
     }
     
-    while (self.sortedIndexes[bottom] < index)
-    {
-        bottom++;
-    }
-    
     return bottom;
 }
 
@@ -574,90 +1653,298 @@ static NSString * const kMemoryAllocationAssertionReason = @"Calloc failed";
 // ------------------------------------------------------------------------------------------
 #pragma mark - Private - Memory
 // ------------------------------------------------------------------------------------------
-- (void)p_increaseBackingStoreMemoryIfNeeded
+/// Grows the backing store geometrically if it can't hold the specified number of indexes.
+- (void)p_increaseBackingStoreMemoryIfNeededForCount:(NSUInteger)count
 {
-    // If the number of indexes is within 10 of the allocated memory, extend the indexes.
-    if ((self.indexesCount + 10) > self.memoryCount)
+    if (count <= self.memoryCount)
     {
-        self.memoryCount += kCountIncrementLength;
-        
-        self.indexes = [self p_reallocIndexes:self.indexes count:self.memoryCount];
-        self.sortedIndexes = [self p_reallocIndexes:self.sortedIndexes count:self.memoryCount];
+        return;
     }
+    
+    NSUInteger memoryCount = MAX(self.memoryCount, kMinimumCount);
+    while (memoryCount < count)
+    {
+        memoryCount = (memoryCount > NSUIntegerMax / 2) ? count : memoryCount * 2;
+    }
+    
+    [self p_increaseBackingStoreMemoryToCount:memoryCount];
+}
+
+
+- (void)p_increaseBackingStoreMemoryToCount:(NSUInteger)count
+{
+    NSParameterAssert(count >= self.indexesCount);
+    
+    self.indexes = [self p_reallocIndexes:self.indexes count:count];
+    self.sortedIndexes = [self p_reallocIndexes:self.sortedIndexes count:count];
+    self.positions = [self p_reallocIndexes:self.positions count:count];
+    self.memoryCount = count;
 }
 
 
 - (NSUInteger *)p_reallocIndexes:(NSUInteger *)indexes count:(NSUInteger)count
 {
-    NSUInteger *newIndexes = calloc(count, sizeof(NSUInteger));
-    if (newIndexes)
+    NSUInteger *newIndexes = NULL;
+    
+    if (count <= SIZE_MAX / sizeof(NSUInteger))
     {
-        for (NSUInteger i = 0; i < self.indexesCount && i < count; i++)
-        {
-            newIndexes[i] = indexes[i];
-        }
-        
-        free(indexes);
-        indexes = NULL;
-        
-        return newIndexes;
+        newIndexes = realloc(indexes, count * sizeof(NSUInteger));
     }
-    else
+    
+    if (newIndexes == NULL)
     {
-        NSException *exception = [NSException exceptionWithName:kMemoryAllocationAssertionName
-                                                         reason:kMemoryAllocationAssertionReason
-                                                       userInfo:nil];
-        [exception raise];
+        [self p_raiseMemoryAllocationException];
         
         return indexes;
     }
+    
+    return newIndexes;
+}
+
+
+- (void)p_raiseMemoryAllocationException
+{
+    NSException *exception = [NSException exceptionWithName:kMemoryAllocationAssertionName
+                                                     reason:kMemoryAllocationAssertionReason
+                                                   userInfo:nil];
+    [exception raise];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Private - Range Compression
+// ------------------------------------------------------------------------------------------
+/**
+ Switches between storing the indexes individually and storing them as runs of consecutive indexes,
+ based on the average length of the receiver's runs.
+ 
+ @discussion The thresholds for switching back and forth are far apart, so that the O(n) conversions
+ are amortized over many additions and removals.
+ */
+- (void)p_updateStorageIfNeeded
+{
+    NSUInteger count = self.indexesCount;
+    
+    if (self.isRangeCompressed)
+    {
+        if (_runStorage.count * kRangeDecompressionRatio > count)
+        {
+            [self p_decompressRuns];
+        }
+    }
+    else if ([self p_shouldRangeCompressIndexesCount:count runCount:(count - self.linkCount)])
+    {
+        [self p_compressIntoRuns];
+    }
+}
+
+
+/// Returns YES if the specified number of indexes in the specified number of runs should be stored as runs.
+- (BOOL)p_shouldRangeCompressIndexesCount:(NSUInteger)count runCount:(NSUInteger)runCount
+{
+    return (count >= kMinimumRangeCompressionCount && runCount * kRangeCompressionRatio <= count);
 }
 
 
-- (void)p_decrementPositionsAbovePosition:(NSUInteger)position inIndexes:(NSUInteger *)indexes
+/// Moves the indexes from indexes and sortedIndexes into runs. O(n)
+- (void)p_compressIntoRuns
 {
-    NSUInteger moveTo = position;
-    NSUInteger moveFrom = position + 1;
+    NSUInteger count = self.indexesCount;
+    NSUInteger *indexes = self.indexes;
+    NSUInteger *sortedIndexes = self.sortedIndexes;
+    NSUInteger *positions = self.positions;
     
-    while (moveFrom <= self.indexesCount)
+    GNEIndexRunStorage storage = {NULL, NULL, NULL, 0, 0};
+    if (GNEIndexRunStorageReserve(&storage, count - self.linkCount) == NO)
     {
-        NSUInteger index = (moveFrom == self.indexesCount) ? 0 : indexes[moveFrom];
-        indexes[moveTo] = index;
+        GNEIndexRunStorageFree(&storage);
+        [self p_raiseMemoryAllocationException];
         
-        moveTo++;
-        moveFrom++;
+        return;
+    }
+    
+    for (NSUInteger position = 0; position < count; position++)
+    {
+        if (position > 0 && indexes[position - 1] + 1 == indexes[position])
+        {
+            storage.runs[storage.count - 1].length++;
+        }
+        else
+        {
+            storage.runs[storage.count] = (GNEIndexRun){indexes[position], 1};
+            storage.positions[storage.count] = position;
+            storage.count++;
+        }
+    }
+    
+    // The first indexes of the runs appear in sortedIndexes in the order of the runs' locations.
+    NSUInteger sortedRunCount = 0;
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        NSUInteger position = positions[i];
+        if (position == 0 || indexes[position - 1] + 1 != sortedIndexes[i])
+        {
+            storage.sortedRuns[sortedRunCount++] = GNEIndexRunStorageRunContainingPosition(&storage, position);
+        }
+    }
+    NSAssert(sortedRunCount == storage.count, @"Expected %lu runs, found %lu",
+             (unsigned long)storage.count, (unsigned long)sortedRunCount);
+    
+    GNEIndexRunStorageFree(&_runStorage);
+    _runStorage = storage;
+    
+    free(self.indexes);
+    free(self.sortedIndexes);
+    free(self.positions);
+    self.indexes = NULL;
+    self.sortedIndexes = NULL;
+    self.positions = NULL;
+    self.memoryCount = 0;
+    self.linkCount = 0;
+    self.rangeCompressed = YES;
+}
+
+
+/// Moves the indexes from the runs back into indexes and sortedIndexes. O(n)
+- (void)p_decompressRuns
+{
+    NSUInteger count = self.indexesCount;
+    
+    [self p_increaseBackingStoreMemoryToCount:MAX(kMinimumCount, count)];
+    
+    NSUInteger *indexes = self.indexes;
+    NSUInteger *sortedIndexes = self.sortedIndexes;
+    NSUInteger *positions = self.positions;
+    
+    for (NSUInteger i = 0; i < _runStorage.count; i++)
+    {
+        GNEIndexRun run = _runStorage.runs[i];
+        NSUInteger position = _runStorage.positions[i];
+        for (NSUInteger j = 0; j < run.length; j++)
+        {
+            indexes[position + j] = run.location + j;
+        }
     }
     
-    // After decrementing the indexes, zero out the remaining memory.
-    for (NSUInteger i = self.indexesCount; i < self.memoryCount; i++)
+    NSUInteger sortedPosition = 0;
+    for (NSUInteger i = 0; i < _runStorage.count; i++)
     {
-        indexes[i] = 0;
+        NSUInteger runNumber = _runStorage.sortedRuns[i];
+        GNEIndexRun run = _runStorage.runs[runNumber];
+        NSUInteger position = _runStorage.positions[runNumber];
+        for (NSUInteger j = 0; j < run.length; j++)
+        {
+            sortedIndexes[sortedPosition] = run.location + j;
+            positions[sortedPosition] = position + j;
+            sortedPosition++;
+        }
     }
+    
+    self.linkCount = count - _runStorage.count;
+    self.rangeCompressed = NO;
+    GNEIndexRunStorageFree(&_runStorage);
 }
 
 
-- (void)p_incrementPositionsAtAndAbovePosition:(NSUInteger)position inIndexes:(NSUInteger *)indexes
+/// Replaces the receiver's indexes with a copy of the specified runs.
+- (void)p_copyRunStorage:(const GNEIndexRunStorage *)storage indexesCount:(NSUInteger)indexesCount
 {
-    if (self.indexesCount == 0)
+    GNEIndexRunStorage copy = {NULL, NULL, NULL, 0, 0};
+    if (GNEIndexRunStorageReserve(&copy, storage->count) == NO)
     {
+        GNEIndexRunStorageFree(&copy);
+        [self p_raiseMemoryAllocationException];
+        
         return;
     }
     
-    NSUInteger moveTo = self.indexesCount;
-    NSUInteger moveFrom = self.indexesCount - 1;
+    memcpy(copy.runs, storage->runs, storage->count * sizeof(GNEIndexRun));
+    memcpy(copy.positions, storage->positions, storage->count * sizeof(NSUInteger));
+    memcpy(copy.sortedRuns, storage->sortedRuns, storage->count * sizeof(NSUInteger));
+    copy.count = storage->count;
+    
+    [self p_replaceRunStorage:copy indexesCount:indexesCount];
+}
+
+
+/// Replaces the receiver's indexes with the specified runs, taking ownership of their memory.
+- (void)p_replaceRunStorage:(GNEIndexRunStorage)storage indexesCount:(NSUInteger)indexesCount
+{
+    GNEIndexRunStorageFree(&_runStorage);
+    _runStorage = storage;
+    
+    free(self.indexes);
+    free(self.sortedIndexes);
+    free(self.positions);
+    self.indexes = NULL;
+    self.sortedIndexes = NULL;
+    self.positions = NULL;
+    self.memoryCount = 0;
+    self.linkCount = 0;
+    self.indexesCount = indexesCount;
+    self.rangeCompressed = YES;
+}
+
+
+- (const GNEIndexRunStorage *)p_runStorage
+{
+    return &_runStorage;
+}
+
+
+- (void)p_enumerateRunsWithOptions:(NSEnumerationOptions)options
+                        usingBlock:(void (^)(NSUInteger, NSUInteger, BOOL *))block
+{
+    BOOL isReversed = options & NSEnumerationReverse;
+    NSUInteger runCount = _runStorage.count;
+    NSUInteger iteration = 0;
     
-    while (moveFrom >= position)
+    for (NSUInteger i = 0; i < runCount; i++)
     {
-        NSUInteger index = indexes[moveFrom];
-        indexes[moveTo] = index;
+        GNEIndexRun run = _runStorage.runs[(isReversed) ? (runCount - 1 - i) : i];
         
-        if (moveFrom == 0)
+        for (NSUInteger j = 0; j < run.length; j++)
         {
-            break;
+            BOOL stop = NO;
+            
+            NSUInteger index = (isReversed) ? (GNEIndexRunEnd(run) - 1 - j) : (run.location + j);
+            block(index, iteration++, &stop);
+            
+            if (stop)
+            {
+                return;
+            }
         }
-        
-        moveTo--;
-        moveFrom--;
+    }
+}
+
+
+/**
+ Updates linkCount for adding the specified index at, or removing it from, the specified position of
+ indexes. Must be called before indexes is modified.
+ */
+- (void)p_updateLinkCountForIndex:(NSUInteger)index atPosition:(NSUInteger)position isRemoval:(BOOL)isRemoval
+{
+    NSUInteger *indexes = self.indexes;
+    NSUInteger count = self.indexesCount;
+    NSUInteger nextPosition = (isRemoval) ? position + 1 : position;
+    
+    BOOL hasPrevious = (position > 0);
+    BOOL hasNext = (nextPosition < count);
+    NSUInteger previous = (hasPrevious) ? indexes[position - 1] : 0;
+    NSUInteger next = (hasNext) ? indexes[nextPosition] : 0;
+    
+    // Links between the index and its neighbors and the link between the neighbors themselves.
+    NSUInteger indexLinks = ((hasPrevious && previous + 1 == index) ? 1 : 0) + ((hasNext && index + 1 == next) ? 1 : 0);
+    NSUInteger neighborLink = (hasPrevious && hasNext && previous + 1 == next) ? 1 : 0;
+    
+    if (isRemoval)
+    {
+        self.linkCount = self.linkCount - indexLinks + neighborLink;
+    }
+    else
+    {
+        self.linkCount = self.linkCount + indexLinks - neighborLink;
     }
 }
 
@@ -671,6 +1958,12 @@ static NSString * const kMemoryAllocationAssertionReason = @"Calloc failed";
 }
 
 
+- (NSUInteger)numberOfRanges
+{
+    return (self.isRangeCompressed) ? _runStorage.count : self.indexesCount - self.linkCount;
+}
+
+
 - (NSUInteger)smallestIndex
 {
     return [self p_smallestIndex];
@@ -686,10 +1979,31 @@ static NSString * const kMemoryAllocationAssertionReason = @"Calloc failed";
 - (NSIndexSet *)ns_indexSet
 {
     NSMutableIndexSet *mutableIndexSet = [NSMutableIndexSet indexSet];
-    [self enumerateIndexesUsingBlock:^(NSUInteger index, NSUInteger position __unused, BOOL *stop __unused)
+    
+    if (self.isRangeCompressed)
     {
-        [mutableIndexSet addIndex:index];
-    }];
+        for (NSUInteger i = 0; i < _runStorage.count; i++)
+        {
+            GNEIndexRun run = _runStorage.runs[_runStorage.sortedRuns[i]];
+            [mutableIndexSet addIndexesInRange:NSMakeRange(run.location, run.length)];
+        }
+        
+        return [mutableIndexSet copy];
+    }
+    
+    // Add the sorted indexes range by range instead of one at a time.
+    NSUInteger *sortedIndexes = self.sortedIndexes;
+    NSUInteger count = self.indexesCount;
+    NSUInteger start = 0;
+    for (NSUInteger i = 1; i <= count; i++)
+    {
+        if (i == count || sortedIndexes[i - 1] + 1 != sortedIndexes[i])
+        {
+            NSUInteger length = i - start;
+            [mutableIndexSet addIndexesInRange:NSMakeRange(sortedIndexes[start], length)];
+            start = i;
+        }
+    }
     
     return [mutableIndexSet copy];
 }
@@ -0,0 +1,91 @@
+//
+//  GNEOutlineViewItem+Pasteboard.m
+//  GNESectionedTableView
+//
+//  Copyright (c) 2014 Gone East LLC. All rights reserved.
+//
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2014 Gone East LLC
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import "GNEOutlineViewItem+Pasteboard.h"
+
+
+// ------------------------------------------------------------------------------------------
+
+
+NSString * const GNEOutlineViewItemPasteboardType = @"com.goneeast.GNEOutlineViewItemPasteboardType";
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@implementation GNEOutlineViewItem (Pasteboard)
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - NSPasteboardReader
+// ------------------------------------------------------------------------------------------
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wobjc-designated-initializers"
+- (instancetype)initWithPasteboardPropertyList:(id)propertyList ofType:(NSString *)type
+{
+    if ([type isEqualToString:GNEOutlineViewItemPasteboardType])
+    {
+        return [NSKeyedUnarchiver unarchiveObjectWithData:propertyList];
+    }
+    
+    return nil;
+}
+#pragma clang diagnostic pop
+
+
++ (NSArray *)readableTypesForPasteboard:(NSPasteboard * __unused)pasteboard
+{
+    return @[GNEOutlineViewItemPasteboardType];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - NSPasteboardWriter
+// ------------------------------------------------------------------------------------------
+- (NSArray *)writableTypesForPasteboard:(NSPasteboard * __unused)pasteboard
+{
+    return @[GNEOutlineViewItemPasteboardType];
+}
+
+
+- (id)pasteboardPropertyListForType:(NSString *)type
+{
+    if ([type isEqualToString:GNEOutlineViewItemPasteboardType])
+    {
+        NSData *plistData = [NSKeyedArchiver archivedDataWithRootObject:self];
+        
+        return plistData;
+    }
+    
+    return nil;
+}
+
+
+@end
@@ -29,14 +29,13 @@
 //  SOFTWARE.
 //
 
-@import Cocoa;
+@import Foundation;
 
 @class GNEOutlineViewItem;
 @class GNEOutlineViewParentItem;
 
 // ------------------------------------------------------------------------------------------
 
-extern NSString  * _Nonnull  const GNEOutlineViewItemPasteboardType;
 extern NSString  * _Nonnull  const GNEOutlineViewItemParentItemKey;
 
 // ------------------------------------------------------------------------------------------
@@ -49,16 +48,23 @@ extern NSString  * _Nonnull  const GNEOutlineViewItemParentItemKey;
 
 // ------------------------------------------------------------------------------------------
 
-@interface GNEOutlineViewItem : NSObject <NSSecureCoding, NSPasteboardReading, NSPasteboardWriting>
+@interface GNEOutlineViewItem : NSObject <NSSecureCoding>
 
-@property (nonatomic, weak) id <GNEOutlineViewItemPasteboardWritingDelegate> _Nullable pasteboardWritingDelegate;
+/// Delegate asked for the index path of the receiver when it is written to a pasteboard. Outline view
+/// items don't store their own delegate, they use the one of their parent item.
+@property (nonatomic, weak, readonly) id <GNEOutlineViewItemPasteboardWritingDelegate> _Nullable pasteboardWritingDelegate;
 
-/// Parent item of this object.
-@property (nonatomic, weak) GNEOutlineViewParentItem * _Nullable parentItem;
+/// Parent item of this object. Parent items never reference their children, so this is a strong
+/// reference instead of a (much more expensive) weak one.
+@property (nonatomic, strong) GNEOutlineViewParentItem * _Nullable parentItem;
 
 /// Index path of the receiver if it is being dragged, otherwise nil.
 @property (nullable, nonatomic, strong, readonly) NSIndexPath *draggedIndexPath;
 
+/// Node of the outline view item array containing the receiver, or NULL if the receiver isn't
+/// contained in one. This is managed by GNEOutlineViewItemArray and must not be set directly.
+@property (nullable, nonatomic, assign) void *arrayNode;
+
 - (nonnull instancetype)initWithParentItem:(GNEOutlineViewParentItem * _Nullable)parentItem NS_DESIGNATED_INITIALIZER;
 - (nullable instancetype)initWithCoder:(nonnull NSCoder *)aDecoder NS_DESIGNATED_INITIALIZER;
 
@@ -37,8 +37,6 @@
 // ------------------------------------------------------------------------------------------
 
 
-NSString * const GNEOutlineViewItemPasteboardType = @"com.goneeast.GNEOutlineViewItemPasteboardType";
-
 NSString * const GNEOutlineViewItemParentItemKey = @"GNEOutlineViewItemParentItem";
 static NSString * const GNEOutlineViewItemDraggedIndexPathKey = @"GNEOutlineViewItemDraggedIndexPathKey";
 
@@ -75,11 +73,20 @@ static NSString * const GNEOutlineViewItemDraggedIndexPathKey = @"GNEOutlineView
 // ------------------------------------------------------------------------------------------
 - (void)dealloc
 {
-    _pasteboardWritingDelegate = nil;
+    _parentItem = nil;
     _draggedIndexPath = nil;
 }
 
 
+// ------------------------------------------------------------------------------------------
+#pragma mark - Accessors
+// ------------------------------------------------------------------------------------------
+- (id <GNEOutlineViewItemPasteboardWritingDelegate>)pasteboardWritingDelegate
+{
+    return self.parentItem.pasteboardWritingDelegate;
+}
+
+
 // ------------------------------------------------------------------------------------------
 #pragma mark - NSSecureCoding
 // ------------------------------------------------------------------------------------------
@@ -115,51 +122,6 @@ static NSString * const GNEOutlineViewItemDraggedIndexPathKey = @"GNEOutlineView
 }
 
 
-// ------------------------------------------------------------------------------------------
-#pragma mark - NSPasteboardReader
-// ------------------------------------------------------------------------------------------
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wobjc-designated-initializers"
-- (instancetype)initWithPasteboardPropertyList:(id)propertyList ofType:(NSString *)type
-{
-    if ([type isEqualToString:GNEOutlineViewItemPasteboardType])
-    {
-        return [NSKeyedUnarchiver unarchiveObjectWithData:propertyList];
-    }
-    
-    return nil;
-}
-#pragma clang diagnostic pop
-
-
-+ (NSArray *)readableTypesForPasteboard:(NSPasteboard * __unused)pasteboard
-{
-    return @[GNEOutlineViewItemPasteboardType];
-}
-
-
-// ------------------------------------------------------------------------------------------
-#pragma mark - NSPasteboardWriter
-// ------------------------------------------------------------------------------------------
-- (NSArray *)writableTypesForPasteboard:(NSPasteboard * __unused)pasteboard
-{
-    return @[GNEOutlineViewItemPasteboardType];
-}
-
-
-- (id)pasteboardPropertyListForType:(NSString *)type
-{
-    if ([type isEqualToString:GNEOutlineViewItemPasteboardType])
-    {
-        NSData *plistData = [NSKeyedArchiver archivedDataWithRootObject:self];
-        
-        return plistData;
-    }
-    
-    return nil;
-}
-
-
 // ------------------------------------------------------------------------------------------
 #pragma mark - Description
 // ------------------------------------------------------------------------------------------
@@ -177,7 +139,7 @@ static NSString * const GNEOutlineViewItemDraggedIndexPathKey = @"GNEOutlineView
     }
     
     return [NSString stringWithFormat:@"<%@: %p>%@ Parent: %@",
-            [self className], self, indexPathString, self.parentItem];
+            NSStringFromClass([self class]), self, indexPathString, self.parentItem];
 }
 
 
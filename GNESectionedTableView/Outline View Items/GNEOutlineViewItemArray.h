@@ -0,0 +1,179 @@
+//
+//  GNEOutlineViewItemArray.h
+//  GNESectionedTableView
+//
+//  Copyright (c) 2014 Gone East LLC. All rights reserved.
+//
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2014 Gone East LLC
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+@import Foundation;
+
+@class GNEOutlineViewItem;
+
+/// Block that returns a new outline view item for an entry of an outline view item array that was
+/// created without one.
+typedef GNEOutlineViewItem * __nonnull (^GNEOutlineViewItemProvider)(void);
+
+// ------------------------------------------------------------------------------------------
+
+/**
+ GNEOutlineViewItemArray is an ordered collection of outline view items backed by an order-statistic
+ tree (a treap whose nodes know the size of their subtrees).
+ 
+ @discussion Accessing the item at an index, finding the index of an item, and inserting or removing an
+ item anywhere in the array all take O(lg n) time. Inserting or removing many items at once takes at
+ most linear time because the tree is rebuilt in a single pass when that is cheaper than changing it one
+ run of indexes at a time. An outline view item can only be contained in one outline view item array
+ at a time.
+ 
+ Every item is stored with the height of the row it represents and every node knows the sum of the heights
+ in its subtree, so converting between an index and a vertical offset also takes O(lg n) time.
+ 
+ An outline view item array created with an item provider starts out without any outline view items.
+ The item of an entry is only created, using the item provider, the first time it is accessed. Items
+ can later be released again with -recycleObjectsInRange:, after which they are recreated on demand.
+ Heights are kept whether or not an entry's item exists.
+ 
+ The nodes of the tree are allocated in slabs owned by the array. Creating an array of n entries makes
+ a single allocation, and the nodes of removed entries are reused by later insertions.
+ */
+@interface GNEOutlineViewItemArray : NSObject <NSFastEnumeration>
+
+/// Returns the number of outline view items contained in the receiver. O(1)
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+/// Returns the first outline view item in the receiver or nil if the receiver is empty. O(lg n)
+@property (nullable, nonatomic, strong, readonly) GNEOutlineViewItem *firstObject;
+
+/// Returns the last outline view item in the receiver or nil if the receiver is empty. O(lg n)
+@property (nullable, nonatomic, strong, readonly) GNEOutlineViewItem *lastObject;
+
+/// Returns the sum of the heights of all of the outline view items in the receiver. O(1)
+@property (nonatomic, assign, readonly) CGFloat totalHeight;
+
+/// Returns the number of entries in the receiver whose outline view items currently exist. O(1)
+@property (nonatomic, assign, readonly) NSUInteger materializedCount;
+
+/// Block used to create the outline view items of entries that don't have one.
+@property (nullable, nonatomic, copy, readonly) GNEOutlineViewItemProvider itemProvider;
+
+#pragma mark - Initializers
++ (nonnull instancetype)array;
+- (nonnull instancetype)init;
+/// Returns an outline view item array containing the specified outline view items. O(n)
+- (nonnull instancetype)initWithItems:(nonnull NSArray *)items NS_DESIGNATED_INITIALIZER;
+/// Returns an outline view item array containing the specified number of entries, whose outline view
+/// items are created by the specified item provider when they are first accessed. O(n)
+- (nonnull instancetype)initWithCount:(NSUInteger)count
+                         itemProvider:(nonnull GNEOutlineViewItemProvider)itemProvider NS_DESIGNATED_INITIALIZER;
+
+#pragma mark - Querying
+/// Returns the outline view item at the specified index. Throws an exception if the index is beyond
+/// the bounds of the receiver. O(lg n)
+- (nonnull GNEOutlineViewItem *)objectAtIndex:(NSUInteger)index;
+- (nonnull GNEOutlineViewItem *)objectAtIndexedSubscript:(NSUInteger)index;
+/// Returns the index of the specified outline view item or NSNotFound if the receiver doesn't
+/// contain it. O(lg n)
+- (NSUInteger)indexOfObject:(nullable GNEOutlineViewItem *)item;
+/// Returns the index of the specified outline view item, like -indexOfObject:, and sets scanLength
+/// to the number of nodes that were visited to find it. O(lg n)
+- (NSUInteger)indexOfObject:(nullable GNEOutlineViewItem *)item scanLength:(nullable NSUInteger *)scanLength;
+/// Returns the outline view item containing the specified offset and sets index to its index, or returns nil
+/// and sets index to NSNotFound if the offset is outside of the receiver. The specified spacing is added
+/// after the height of every item. O(lg n)
+- (nullable GNEOutlineViewItem *)objectAtOffset:(CGFloat)offset
+                                        spacing:(CGFloat)spacing
+                                          index:(nullable NSUInteger *)index;
+/// Returns YES if the receiver contains the specified outline view item, otherwise NO. O(lg n)
+- (BOOL)containsObject:(nullable GNEOutlineViewItem *)item;
+/// Returns an array containing all of the outline view items in the receiver. O(n)
+- (nonnull NSArray *)allObjects;
+/// Returns YES if the outline view item at the specified index currently exists, otherwise NO. Throws
+/// an exception if the index is beyond the bounds of the receiver. O(lg n)
+- (BOOL)isObjectMaterializedAtIndex:(NSUInteger)index;
+/// Returns the number of entries in the specified range whose outline view items currently exist. Throws
+/// an exception if the range is beyond the bounds of the receiver. O(lg n)
+- (NSUInteger)materializedCountInRange:(NSRange)range;
+
+#pragma mark - Heights
+/// Returns the height of the outline view item at the specified index. Throws an exception if the index
+/// is beyond the bounds of the receiver. O(lg n)
+- (CGFloat)heightOfObjectAtIndex:(NSUInteger)index;
+/// Returns the sum of the heights of the outline view items before the specified index. Throws an
+/// exception if the index is greater than the receiver's count. O(lg n)
+- (CGFloat)offsetOfObjectAtIndex:(NSUInteger)index;
+/// Sets the height of the outline view item at the specified index. Throws an exception if the index
+/// is beyond the bounds of the receiver. O(lg n)
+- (void)setHeight:(CGFloat)height forObjectAtIndex:(NSUInteger)index;
+/// Sets the height of every outline view item in the receiver to the value returned by the specified
+/// block, which is called in order starting with the first item. Items that don't currently exist are
+/// passed to the block as nil and aren't created. O(n)
+- (void)setHeightsUsingBlock:(nonnull CGFloat (^)(GNEOutlineViewItem * __nullable item,
+                                                  NSUInteger index))block;
+
+#pragma mark - Adding/Removing
+/// Adds the specified outline view item with a height of 0.0 to the end of the receiver. O(lg n)
+- (void)addObject:(nonnull GNEOutlineViewItem *)item;
+/// Inserts the specified outline view item with a height of 0.0 at the specified index. Throws an
+/// exception if the index is greater than the receiver's count. O(lg n)
+- (void)insertObject:(nonnull GNEOutlineViewItem *)item atIndex:(NSUInteger)index;
+/// Inserts the specified outline view item with the specified height at the specified index. Throws an
+/// exception if the index is greater than the receiver's count. O(lg n)
+- (void)insertObject:(nonnull GNEOutlineViewItem *)item height:(CGFloat)height atIndex:(NSUInteger)index;
+/// Removes the outline view item at the specified index. Throws an exception if the index is beyond
+/// the bounds of the receiver. O(lg n)
+- (void)removeObjectAtIndex:(NSUInteger)index;
+/// Inserts the specified outline view items with heights of 0.0 at the specified indexes, like
+/// -[NSMutableArray insertObjects:atIndexes:]. Throws an exception if an index is beyond the bounds of
+/// the resulting array. O(min(k lg n, n + k))
+- (void)insertObjects:(nonnull NSArray *)items atIndexes:(nonnull NSIndexSet *)indexes;
+/// Inserts entries without outline view items, which are created by the item provider when they are
+/// first accessed, with heights of 0.0 at the specified indexes, like -insertObjects:atIndexes:. The
+/// receiver must have an item provider. O(min(k lg n, n + k))
+- (void)insertEntriesAtIndexes:(nonnull NSIndexSet *)indexes;
+/// Removes the outline view items at the specified indexes. Throws an exception if an index is beyond
+/// the bounds of the receiver. O(min(r lg n + k, n)), where r is the number of ranges in the index set.
+- (void)removeObjectsAtIndexes:(nonnull NSIndexSet *)indexes;
+/// Removes all of the outline view items from the receiver. O(n)
+- (void)removeAllObjects;
+/// Releases the outline view items in the specified range, keeping their entries and heights, so that
+/// they are recreated by the item provider the next time they are accessed. Does nothing if the receiver
+/// doesn't have an item provider. Throws an exception if the range is beyond the bounds of the receiver.
+/// O((k + 1) lg n), where k is the number of items that are released.
+- (void)recycleObjectsInRange:(NSRange)range;
+
+#pragma mark - Enumerating
+/// Executes the specified block using each outline view item in the receiver, starting with the first
+/// item and continuing to the last one. O(n)
+- (void)enumerateObjectsUsingBlock:(nonnull void (^)(GNEOutlineViewItem * __nonnull item,
+                                                     NSUInteger index,
+                                                     BOOL * __nonnull stop))block;
+/// Executes the specified block using each outline view item in the receiver that currently exists,
+/// without creating the ones that don't. O(n)
+- (void)enumerateMaterializedObjectsUsingBlock:(nonnull void (^)(GNEOutlineViewItem * __nonnull item,
+                                                                 NSUInteger index,
+                                                                 BOOL * __nonnull stop))block;
+
+@end
@@ -0,0 +1,1374 @@
+//
+//  GNEOutlineViewItemArray.m
+//  GNESectionedTableView
+//
+//  Copyright (c) 2014 Gone East LLC. All rights reserved.
+//
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2014 Gone East LLC
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import "GNEOutlineViewItemArray.h"
+#import "GNEOutlineViewItem.h"
+
+
+// ------------------------------------------------------------------------------------------
+
+
+static NSString * const kMemoryAllocationAssertionName = @"Memory Allocation Failure";
+static NSString * const kMemoryAllocationAssertionReason = @"Malloc failed";
+
+/// Smallest number of nodes allocated at once when an array runs out of free nodes.
+static const NSUInteger kMinimumNodeSlabCount = 64;
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Tree Nodes
+// ------------------------------------------------------------------------------------------
+typedef struct GNEItemNode GNEItemNode;
+
+struct GNEItemNode
+{
+    GNEItemNode *left;
+    GNEItemNode *right;
+    GNEItemNode *parent;
+    /// Number of nodes in the subtree rooted at this node (including this node).
+    NSUInteger size;
+    /// Heap priority of the node. Parents always have priorities greater than or equal to their children.
+    uint32_t priority;
+    /// Height of the row represented by the node's item.
+    CGFloat height;
+    /// Sum of the heights of the nodes in the subtree rooted at this node (including this node).
+    CGFloat heightSum;
+    /// Number of nodes with items in the subtree rooted at this node (including this node).
+    NSUInteger itemCount;
+    /// Retained outline view item stored in the node or NULL if it hasn't been created yet.
+    void *item;
+};
+
+
+/**
+ Nodes are allocated in slabs, which are only freed when their outline view item array removes all
+ of its items or is deallocated. Removed nodes are kept in a free list and reused.
+ */
+typedef struct GNEItemNodeSlab GNEItemNodeSlab;
+
+struct GNEItemNodeSlab
+{
+    GNEItemNodeSlab *next;
+    GNEItemNode nodes[];
+};
+
+
+static inline NSUInteger GNEItemNodeSize(GNEItemNode *node)
+{
+    return (node) ? node->size : 0;
+}
+
+
+static inline CGFloat GNEItemNodeHeightSum(GNEItemNode *node)
+{
+    return (node) ? node->heightSum : 0.0;
+}
+
+
+static inline NSUInteger GNEItemNodeItemCount(GNEItemNode *node)
+{
+    return (node) ? node->itemCount : 0;
+}
+
+
+/// Recalculates the number of nodes with items in the subtree rooted at the specified node from its children.
+static inline void GNEItemNodeUpdateItemCount(GNEItemNode *node)
+{
+    node->itemCount = ((node->item) ? 1 : 0) + GNEItemNodeItemCount(node->left) + GNEItemNodeItemCount(node->right);
+}
+
+
+/// Recalculates the size, height sum, and item count of the specified node and points its children back
+/// at it.
+static inline void GNEItemNodeUpdate(GNEItemNode *node)
+{
+    node->size = 1 + GNEItemNodeSize(node->left) + GNEItemNodeSize(node->right);
+    node->heightSum = node->height + GNEItemNodeHeightSum(node->left) + GNEItemNodeHeightSum(node->right);
+    GNEItemNodeUpdateItemCount(node);
+    if (node->left)
+    {
+        node->left->parent = node;
+    }
+    if (node->right)
+    {
+        node->right->parent = node;
+    }
+}
+
+
+/// Joins two treaps. Every node in the first treap must come before every node in the second one.
+static GNEItemNode *GNEItemNodeMerge(GNEItemNode *first, GNEItemNode *second)
+{
+    if (first == NULL)
+    {
+        return second;
+    }
+    if (second == NULL)
+    {
+        return first;
+    }
+    
+    if (first->priority >= second->priority)
+    {
+        first->right = GNEItemNodeMerge(first->right, second);
+        GNEItemNodeUpdate(first);
+        
+        return first;
+    }
+    
+    second->left = GNEItemNodeMerge(first, second->left);
+    GNEItemNodeUpdate(second);
+    
+    return second;
+}
+
+
+/// Splits the specified treap into one containing its first count nodes and one containing the rest.
+static void GNEItemNodeSplit(GNEItemNode *node, NSUInteger count, GNEItemNode **first, GNEItemNode **second)
+{
+    if (node == NULL)
+    {
+        *first = NULL;
+        *second = NULL;
+        
+        return;
+    }
+    
+    NSUInteger leftSize = GNEItemNodeSize(node->left);
+    if (count <= leftSize)
+    {
+        GNEItemNodeSplit(node->left, count, first, &node->left);
+        GNEItemNodeUpdate(node);
+        *second = node;
+    }
+    else
+    {
+        GNEItemNodeSplit(node->right, count - leftSize - 1, &node->right, second);
+        GNEItemNodeUpdate(node);
+        *first = node;
+    }
+}
+
+
+static GNEItemNode *GNEItemNodeAtIndex(GNEItemNode *node, NSUInteger index)
+{
+    while (node)
+    {
+        NSUInteger leftSize = GNEItemNodeSize(node->left);
+        if (index < leftSize)
+        {
+            node = node->left;
+        }
+        else if (index == leftSize)
+        {
+            return node;
+        }
+        else
+        {
+            index -= leftSize + 1;
+            node = node->right;
+        }
+    }
+    
+    return NULL;
+}
+
+
+/// Returns the in-order index of the specified node and sets root to the root of its treap and depth,
+/// if it isn't NULL, to the number of nodes on the path from the node to the root.
+static NSUInteger GNEItemNodeIndex(GNEItemNode *node, GNEItemNode **root, NSUInteger *depth)
+{
+    NSUInteger index = GNEItemNodeSize(node->left);
+    NSUInteger visitedNodes = 1;
+    while (node->parent)
+    {
+        if (node == node->parent->right)
+        {
+            index += GNEItemNodeSize(node->parent->left) + 1;
+        }
+        node = node->parent;
+        visitedNodes++;
+    }
+    *root = node;
+    if (depth)
+    {
+        *depth = visitedNodes;
+    }
+    
+    return index;
+}
+
+
+/// Returns the sum of the heights of the nodes that come before the specified node in its treap.
+static CGFloat GNEItemNodeOffset(GNEItemNode *node)
+{
+    CGFloat offset = GNEItemNodeHeightSum(node->left);
+    while (node->parent)
+    {
+        if (node == node->parent->right)
+        {
+            offset += GNEItemNodeHeightSum(node->parent->left) + node->parent->height;
+        }
+        node = node->parent;
+    }
+    
+    return offset;
+}
+
+
+/**
+ Returns the node containing the specified offset and sets index to its in-order index, or returns NULL
+ if the offset is outside of the treap. The specified spacing is added after every node.
+ */
+static GNEItemNode *GNEItemNodeAtOffset(GNEItemNode *node, CGFloat offset, CGFloat spacing, NSUInteger *index)
+{
+    if (offset < 0.0)
+    {
+        return NULL;
+    }
+    
+    NSUInteger nodeIndex = 0;
+    while (node)
+    {
+        NSUInteger leftSize = GNEItemNodeSize(node->left);
+        CGFloat leftHeight = GNEItemNodeHeightSum(node->left) + (CGFloat)leftSize * spacing;
+        CGFloat height = node->height + spacing;
+        if (offset < leftHeight)
+        {
+            node = node->left;
+        }
+        else if (offset < leftHeight + height)
+        {
+            *index = nodeIndex + leftSize;
+            
+            return node;
+        }
+        else
+        {
+            offset -= leftHeight + height;
+            nodeIndex += leftSize + 1;
+            node = node->right;
+        }
+    }
+    
+    return NULL;
+}
+
+
+/// Sets the height of the specified node and updates the height sums of its ancestors.
+static void GNEItemNodeSetHeight(GNEItemNode *node, CGFloat height)
+{
+    node->height = height;
+    while (node)
+    {
+        node->heightSum = node->height + GNEItemNodeHeightSum(node->left) + GNEItemNodeHeightSum(node->right);
+        node = node->parent;
+    }
+}
+
+
+/// Updates the item counts of the specified node and its ancestors after its item was created or released.
+static void GNEItemNodeItemDidChange(GNEItemNode *node)
+{
+    while (node)
+    {
+        GNEItemNodeUpdateItemCount(node);
+        node = node->parent;
+    }
+}
+
+
+/// Returns the number of nodes with items among the first index nodes of the specified treap.
+static NSUInteger GNEItemNodeItemCountBeforeIndex(GNEItemNode *node, NSUInteger index)
+{
+    NSUInteger itemCount = 0;
+    while (node)
+    {
+        NSUInteger leftSize = GNEItemNodeSize(node->left);
+        if (index <= leftSize)
+        {
+            node = node->left;
+        }
+        else
+        {
+            itemCount += GNEItemNodeItemCount(node->left) + ((node->item) ? 1 : 0);
+            index -= leftSize + 1;
+            node = node->right;
+        }
+    }
+    
+    return itemCount;
+}
+
+
+/// Recalculates the height sums of every node in the subtree rooted at the specified node.
+static CGFloat GNEItemNodeUpdateHeightSums(GNEItemNode *node)
+{
+    if (node == NULL)
+    {
+        return 0.0;
+    }
+    
+    node->heightSum = (node->height +
+                       GNEItemNodeUpdateHeightSums(node->left) +
+                       GNEItemNodeUpdateHeightSums(node->right));
+    
+    return node->heightSum;
+}
+
+
+static GNEItemNode *GNEItemNodeFirst(GNEItemNode *node)
+{
+    while (node && node->left)
+    {
+        node = node->left;
+    }
+    
+    return node;
+}
+
+
+static GNEItemNode *GNEItemNodeLast(GNEItemNode *node)
+{
+    while (node && node->right)
+    {
+        node = node->right;
+    }
+    
+    return node;
+}
+
+
+static GNEItemNode *GNEItemNodeNext(GNEItemNode *node)
+{
+    if (node->right)
+    {
+        return GNEItemNodeFirst(node->right);
+    }
+    
+    while (node->parent && node == node->parent->right)
+    {
+        node = node->parent;
+    }
+    
+    return node->parent;
+}
+
+
+/// Returns the depth of a balanced treap containing the specified number of nodes.
+static NSUInteger GNEItemNodeBalancedDepth(NSUInteger count)
+{
+    NSUInteger depth = 1;
+    for (NSUInteger remaining = count; remaining > 1; remaining >>= 1)
+    {
+        depth++;
+    }
+    
+    return depth;
+}
+
+
+/// Returns YES if changing the specified number of runs of nodes in a treap containing the specified
+/// number of nodes is faster done by rebuilding the treap in O(n) than by splitting and merging it once
+/// per run in O(lg n).
+static inline BOOL GNEItemNodeShouldRebuild(NSUInteger runCount, NSUInteger count)
+{
+    return (runCount > count / GNEItemNodeBalancedDepth(count));
+}
+
+
+/// Returns the priority of a node built at the specified depth of a balanced treap.
+static inline uint32_t GNEItemNodeBuildPriority(NSUInteger depth, uint32_t bandSize, NSUInteger bandCount,
+                                                uint32_t *seed)
+{
+    *seed ^= *seed << 13;
+    *seed ^= *seed >> 17;
+    *seed ^= *seed << 5;
+    uint32_t band = (uint32_t)((depth < bandCount) ? (bandCount - depth) : 0);
+    
+    return band * bandSize + (*seed % bandSize);
+}
+
+
+/**
+ Builds a balanced treap out of the specified contiguous nodes in O(n).
+ 
+ @discussion The priorities of the nodes are drawn from bands that decrease with the depth of the nodes
+ so that the result is a valid treap that new, randomly prioritized nodes can be merged into.
+ */
+static GNEItemNode *GNEItemNodeBuild(GNEItemNode *nodes, NSUInteger count, NSUInteger depth,
+                                     uint32_t bandSize, NSUInteger bandCount, uint32_t *seed)
+{
+    if (count == 0)
+    {
+        return NULL;
+    }
+    
+    NSUInteger middle = count / 2;
+    GNEItemNode *node = &nodes[middle];
+    node->priority = GNEItemNodeBuildPriority(depth, bandSize, bandCount, seed);
+    
+    node->left = GNEItemNodeBuild(nodes, middle, depth + 1, bandSize, bandCount, seed);
+    node->right = GNEItemNodeBuild(nodes + middle + 1, count - middle - 1, depth + 1, bandSize, bandCount, seed);
+    node->parent = NULL;
+    GNEItemNodeUpdate(node);
+    
+    return node;
+}
+
+
+/// Builds a balanced treap out of the nodes in the specified list, in order, like GNEItemNodeBuild().
+/// Used to rebuild treaps whose nodes are scattered across slabs. O(n)
+static GNEItemNode *GNEItemNodeBuildFromList(GNEItemNode **nodes, NSUInteger count, NSUInteger depth,
+                                             uint32_t bandSize, NSUInteger bandCount, uint32_t *seed)
+{
+    if (count == 0)
+    {
+        return NULL;
+    }
+    
+    NSUInteger middle = count / 2;
+    GNEItemNode *node = nodes[middle];
+    node->priority = GNEItemNodeBuildPriority(depth, bandSize, bandCount, seed);
+    
+    node->left = GNEItemNodeBuildFromList(nodes, middle, depth + 1, bandSize, bandCount, seed);
+    node->right = GNEItemNodeBuildFromList(nodes + middle + 1, count - middle - 1, depth + 1,
+                                           bandSize, bandCount, seed);
+    node->parent = NULL;
+    GNEItemNodeUpdate(node);
+    
+    return node;
+}
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@interface GNEOutlineViewItemArray ()
+
+/// Root of the treap containing the receiver's outline view items.
+@property (nonatomic, assign) GNEItemNode *root;
+
+/// State of the xorshift generator used to pick the priorities of new nodes.
+@property (nonatomic, assign) uint32_t seed;
+
+/// Linked list of the slabs the receiver's nodes are allocated from.
+@property (nonatomic, assign) GNEItemNodeSlab *slabs;
+
+/// Linked list (through their right pointers) of allocated nodes that aren't in the treap.
+@property (nonatomic, assign) GNEItemNode *freeNodes;
+
+/// Incremented every time the receiver is mutated. Used to detect mutations during fast enumeration.
+@property (nonatomic, assign) unsigned long mutationCount;
+
+@property (nonatomic, assign, readwrite) NSUInteger materializedCount;
+@property (nonatomic, copy, readwrite) GNEOutlineViewItemProvider itemProvider;
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@implementation GNEOutlineViewItemArray
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Class Initialization
+// ------------------------------------------------------------------------------------------
++ (instancetype)array
+{
+    return [[[self class] alloc] init];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Initialization
+// ------------------------------------------------------------------------------------------
+- (instancetype)init
+{
+    return [self initWithItems:@[]];
+}
+
+
+- (instancetype)initWithItems:(NSArray *)items
+{
+    NSParameterAssert(items);
+    
+    if ((self = [super init]))
+    {
+        _root = NULL;
+        _seed = 2463534242;
+        _mutationCount = 0;
+        _materializedCount = 0;
+        
+        [self p_buildTreeWithItems:items count:items.count];
+    }
+    
+    return self;
+}
+
+
+- (instancetype)initWithCount:(NSUInteger)count itemProvider:(GNEOutlineViewItemProvider)itemProvider
+{
+    NSParameterAssert(itemProvider);
+    
+    if ((self = [super init]))
+    {
+        _root = NULL;
+        _seed = 2463534242;
+        _mutationCount = 0;
+        _materializedCount = 0;
+        _itemProvider = [itemProvider copy];
+        
+        [self p_buildTreeWithItems:nil count:count];
+    }
+    
+    return self;
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Dealloc
+// ------------------------------------------------------------------------------------------
+- (void)dealloc
+{
+    [self p_freeAllNodes];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - NSObject
+// ------------------------------------------------------------------------------------------
+- (NSString *)description
+{
+    // Doesn't create any items, so describing the receiver never changes it.
+    NSMutableArray *items = [NSMutableArray arrayWithCapacity:self.materializedCount];
+    [self enumerateMaterializedObjectsUsingBlock:^(GNEOutlineViewItem *item,
+                                                   NSUInteger index __unused,
+                                                   BOOL *stop __unused)
+    {
+        [items addObject:item];
+    }];
+    
+    return [NSString stringWithFormat:@"<%@: %p> Count: %llu, materialized items: %@",
+            NSStringFromClass([self class]), self, (unsigned long long)self.count, items];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - NSFastEnumeration
+// ------------------------------------------------------------------------------------------
+- (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state
+                                  objects:(id __unsafe_unretained [])buffer
+                                    count:(NSUInteger)length
+{
+    GNEItemNode *node = NULL;
+    
+    if (state->state == 0)
+    {
+        state->state = 1;
+        state->mutationsPtr = &_mutationCount;
+        node = GNEItemNodeFirst(self.root);
+    }
+    else
+    {
+        node = (GNEItemNode *)state->extra[0];
+    }
+    
+    NSUInteger count = 0;
+    while (node && count < length)
+    {
+        buffer[count] = [self p_itemOfNode:node];
+        count++;
+        node = GNEItemNodeNext(node);
+    }
+    
+    state->extra[0] = (unsigned long)node;
+    state->itemsPtr = buffer;
+    
+    return count;
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Public - Querying
+// ------------------------------------------------------------------------------------------
+- (NSUInteger)count
+{
+    return GNEItemNodeSize(self.root);
+}
+
+
+- (CGFloat)totalHeight
+{
+    return GNEItemNodeHeightSum(self.root);
+}
+
+
+- (GNEOutlineViewItem *)firstObject
+{
+    GNEItemNode *node = GNEItemNodeFirst(self.root);
+    
+    return (node) ? [self p_itemOfNode:node] : nil;
+}
+
+
+- (GNEOutlineViewItem *)lastObject
+{
+    GNEItemNode *node = GNEItemNodeLast(self.root);
+    
+    return (node) ? [self p_itemOfNode:node] : nil;
+}
+
+
+- (GNEOutlineViewItem *)objectAtIndex:(NSUInteger)index
+{
+    GNEItemNode *node = [self p_nodeAtIndex:index];
+    
+    return [self p_itemOfNode:node];
+}
+
+
+- (GNEOutlineViewItem *)objectAtIndexedSubscript:(NSUInteger)index
+{
+    return [self objectAtIndex:index];
+}
+
+
+- (NSUInteger)indexOfObject:(GNEOutlineViewItem *)item
+{
+    return [self indexOfObject:item scanLength:NULL];
+}
+
+
+- (NSUInteger)indexOfObject:(GNEOutlineViewItem *)item scanLength:(NSUInteger *)scanLength
+{
+    GNEItemNode *node = (GNEItemNode *)item.arrayNode;
+    
+    if (scanLength)
+    {
+        *scanLength = 0;
+    }
+    
+    if (item == nil || node == NULL || node->item != (__bridge void *)item)
+    {
+        return NSNotFound;
+    }
+    
+    GNEItemNode *root = NULL;
+    NSUInteger index = GNEItemNodeIndex(node, &root, scanLength);
+    
+    return (root == self.root) ? index : NSNotFound;
+}
+
+
+- (GNEOutlineViewItem *)objectAtOffset:(CGFloat)offset spacing:(CGFloat)spacing index:(NSUInteger *)index
+{
+    NSUInteger nodeIndex = NSNotFound;
+    GNEItemNode *node = GNEItemNodeAtOffset(self.root, offset, spacing, &nodeIndex);
+    
+    if (index)
+    {
+        *index = nodeIndex;
+    }
+    
+    return (node) ? [self p_itemOfNode:node] : nil;
+}
+
+
+- (BOOL)containsObject:(GNEOutlineViewItem *)item
+{
+    return ([self indexOfObject:item] != NSNotFound);
+}
+
+
+- (NSArray *)allObjects
+{
+    NSMutableArray *items = [NSMutableArray arrayWithCapacity:self.count];
+    for (GNEItemNode *node = GNEItemNodeFirst(self.root); node; node = GNEItemNodeNext(node))
+    {
+        [items addObject:[self p_itemOfNode:node]];
+    }
+    
+    return [items copy];
+}
+
+
+- (BOOL)isObjectMaterializedAtIndex:(NSUInteger)index
+{
+    return ([self p_nodeAtIndex:index]->item != NULL);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Public - Heights
+// ------------------------------------------------------------------------------------------
+- (CGFloat)heightOfObjectAtIndex:(NSUInteger)index
+{
+    return [self p_nodeAtIndex:index]->height;
+}
+
+
+- (CGFloat)offsetOfObjectAtIndex:(NSUInteger)index
+{
+    if (index == self.count)
+    {
+        return self.totalHeight;
+    }
+    
+    return GNEItemNodeOffset([self p_nodeAtIndex:index]);
+}
+
+
+- (void)setHeight:(CGFloat)height forObjectAtIndex:(NSUInteger)index
+{
+    GNEItemNodeSetHeight([self p_nodeAtIndex:index], height);
+}
+
+
+- (void)setHeightsUsingBlock:(CGFloat (^)(GNEOutlineViewItem *item, NSUInteger index))block
+{
+    NSParameterAssert(block);
+    
+    NSUInteger index = 0;
+    for (GNEItemNode *node = GNEItemNodeFirst(self.root); node; node = GNEItemNodeNext(node))
+    {
+        node->height = block((__bridge GNEOutlineViewItem *)node->item, index);
+        index++;
+    }
+    GNEItemNodeUpdateHeightSums(self.root);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Public - Adding/Removing
+// ------------------------------------------------------------------------------------------
+- (void)addObject:(GNEOutlineViewItem *)item
+{
+    [self insertObject:item height:0.0 atIndex:self.count];
+}
+
+
+- (void)insertObject:(GNEOutlineViewItem *)item atIndex:(NSUInteger)index
+{
+    [self insertObject:item height:0.0 atIndex:index];
+}
+
+
+- (void)insertObject:(GNEOutlineViewItem *)item height:(CGFloat)height atIndex:(NSUInteger)index
+{
+    NSParameterAssert(item);
+    NSParameterAssert(item.arrayNode == NULL);
+    
+    if (index > self.count)
+    {
+        [NSException raise:NSRangeException
+                    format:@"Index %llu is beyond bounds [0 .. %llu]",
+                           (unsigned long long)index, (unsigned long long)self.count];
+    }
+    
+    GNEItemNode *node = [self p_newNodeWithItem:item];
+    node->height = height;
+    node->heightSum = height;
+    
+    [self p_insertNode:node atIndex:index];
+}
+
+
+- (void)removeObjectAtIndex:(NSUInteger)index
+{
+    [self p_nodeAtIndex:index]; // Throws if the index is out of bounds.
+    
+    GNEItemNode *first = NULL;
+    GNEItemNode *middle = NULL;
+    GNEItemNode *last = NULL;
+    GNEItemNodeSplit(self.root, index, &first, &middle);
+    GNEItemNodeSplit(middle, 1, &middle, &last);
+    self.root = GNEItemNodeMerge(first, last);
+    if (self.root)
+    {
+        self.root->parent = NULL;
+    }
+    self.mutationCount++;
+    
+    [self p_freeNode:middle];
+}
+
+
+- (void)insertObjects:(NSArray *)items atIndexes:(NSIndexSet *)indexes
+{
+    NSParameterAssert(items);
+    NSParameterAssert(indexes);
+    NSParameterAssert(items.count == indexes.count);
+    
+    [self p_insertItems:items atIndexes:indexes];
+}
+
+
+- (void)insertEntriesAtIndexes:(NSIndexSet *)indexes
+{
+    NSParameterAssert(indexes);
+    NSAssert(self.itemProvider, @"Outline view item array entries without items require an item provider");
+    
+    [self p_insertItems:nil atIndexes:indexes];
+}
+
+
+/**
+ Removes the items with the semantics of -[NSMutableArray removeObjectsAtIndexes:].
+ 
+ @discussion Each run of removed indexes is split off of the treap and freed in O(lg n + k). If there
+ are too many runs for that to be worthwhile, the remaining nodes are compacted in a single pass and
+ the treap is rebuilt in O(n) instead.
+ */
+- (void)removeObjectsAtIndexes:(NSIndexSet *)indexes
+{
+    NSParameterAssert(indexes);
+    
+    NSUInteger count = self.count;
+    
+    if (indexes.count == 0)
+    {
+        return;
+    }
+    
+    if (indexes.lastIndex >= count)
+    {
+        [NSException raise:NSRangeException
+                    format:@"Index %llu is beyond bounds [0 .. %llu)",
+                           (unsigned long long)indexes.lastIndex, (unsigned long long)count];
+    }
+    
+    __block NSUInteger rangeCount = 0;
+    [indexes enumerateRangesUsingBlock:^(NSRange range __unused, BOOL *stop __unused)
+    {
+        rangeCount++;
+    }];
+    
+    if (GNEItemNodeShouldRebuild(rangeCount, count) == NO)
+    {
+        [indexes enumerateRangesWithOptions:NSEnumerationReverse usingBlock:^(NSRange range, BOOL *stop __unused)
+        {
+            GNEItemNode *first = NULL;
+            GNEItemNode *middle = NULL;
+            GNEItemNode *last = NULL;
+            GNEItemNodeSplit(self.root, range.location, &first, &middle);
+            GNEItemNodeSplit(middle, range.length, &middle, &last);
+            self.root = GNEItemNodeMerge(first, last);
+            if (self.root)
+            {
+                self.root->parent = NULL;
+            }
+            middle->parent = NULL;
+            [self p_freeTree:middle];
+        }];
+        self.mutationCount++;
+        
+        return;
+    }
+    
+    GNEItemNode **nodes = [self p_copyNodesWithCapacity:count];
+    
+    __block NSUInteger keptCount = 0;
+    __block NSUInteger index = 0;
+    [indexes enumerateRangesUsingBlock:^(NSRange range, BOOL *stop __unused)
+    {
+        for (; index < range.location; index++)
+        {
+            nodes[keptCount++] = nodes[index];
+        }
+        for (; index < NSMaxRange(range); index++)
+        {
+            [self p_freeNode:nodes[index]];
+        }
+    }];
+    for (; index < count; index++)
+    {
+        nodes[keptCount++] = nodes[index];
+    }
+    
+    [self p_rebuildTreeWithNodes:nodes count:keptCount];
+    free(nodes);
+}
+
+
+- (void)removeAllObjects
+{
+    [self p_freeAllNodes];
+    self.mutationCount++;
+}
+
+
+- (void)recycleObjectsInRange:(NSRange)range
+{
+    if (range.location > self.count || range.length > self.count - range.location)
+    {
+        [NSException raise:NSRangeException
+                    format:@"Range %@ is beyond bounds [0 .. %llu)",
+                           NSStringFromRange(range), (unsigned long long)self.count];
+    }
+    
+    if (self.itemProvider == nil || range.length == 0)
+    {
+        return;
+    }
+    
+    [self p_releaseItemsOfTree:self.root inRange:range];
+    self.mutationCount++;
+}
+
+
+- (NSUInteger)materializedCountInRange:(NSRange)range
+{
+    if (range.location > self.count || range.length > self.count - range.location)
+    {
+        [NSException raise:NSRangeException
+                    format:@"Range %@ is beyond bounds [0 .. %llu)",
+                           NSStringFromRange(range), (unsigned long long)self.count];
+    }
+    
+    return (GNEItemNodeItemCountBeforeIndex(self.root, NSMaxRange(range)) -
+            GNEItemNodeItemCountBeforeIndex(self.root, range.location));
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Public - Enumerating
+// ------------------------------------------------------------------------------------------
+- (void)enumerateObjectsUsingBlock:(void (^)(GNEOutlineViewItem *, NSUInteger, BOOL *))block
+{
+    NSUInteger index = 0;
+    for (GNEItemNode *node = GNEItemNodeFirst(self.root); node; node = GNEItemNodeNext(node))
+    {
+        BOOL stop = NO;
+        block([self p_itemOfNode:node], index, &stop);
+        if (stop)
+        {
+            break;
+        }
+        index++;
+    }
+}
+
+
+- (void)enumerateMaterializedObjectsUsingBlock:(void (^)(GNEOutlineViewItem *, NSUInteger, BOOL *))block
+{
+    NSUInteger index = 0;
+    for (GNEItemNode *node = GNEItemNodeFirst(self.root); node; node = GNEItemNodeNext(node))
+    {
+        if (node->item)
+        {
+            BOOL stop = NO;
+            block((__bridge GNEOutlineViewItem *)node->item, index, &stop);
+            if (stop)
+            {
+                break;
+            }
+        }
+        index++;
+    }
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Private - Nodes
+// ------------------------------------------------------------------------------------------
+/// Gives the specified new node a random priority and inserts it into the treap at the specified
+/// index. O(lg n)
+- (void)p_insertNode:(GNEItemNode *)node atIndex:(NSUInteger)index
+{
+    node->priority = [self p_nextPriority];
+    
+    GNEItemNode *first = NULL;
+    GNEItemNode *second = NULL;
+    GNEItemNodeSplit(self.root, index, &first, &second);
+    self.root = GNEItemNodeMerge(GNEItemNodeMerge(first, node), second);
+    self.root->parent = NULL;
+    self.mutationCount++;
+}
+
+
+/**
+ Inserts the items, or new entries without items if items is nil, with the semantics of
+ -[NSMutableArray insertObjects:atIndexes:].
+ 
+ @discussion A few insertions are made one at a time in O(k lg n). Larger ones interleave the new nodes
+ with the existing ones in a single pass and rebuild the treap in O(n + k).
+ */
+- (void)p_insertItems:(NSArray *)items atIndexes:(NSIndexSet *)indexes
+{
+    NSUInteger insertedCount = indexes.count;
+    NSUInteger count = self.count + insertedCount;
+    
+    if (insertedCount == 0)
+    {
+        return;
+    }
+    
+    if (indexes.lastIndex >= count)
+    {
+        [NSException raise:NSRangeException
+                    format:@"Index %llu is beyond bounds [0 .. %llu)",
+                           (unsigned long long)indexes.lastIndex, (unsigned long long)count];
+    }
+    
+    __block NSUInteger position = 0;
+    
+    if (GNEItemNodeShouldRebuild(insertedCount, count) == NO)
+    {
+        [indexes enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop __unused)
+        {
+            GNEOutlineViewItem *item = (items) ? items[position] : nil;
+            NSParameterAssert(item == nil || item.arrayNode == NULL);
+            [self p_insertNode:[self p_newNodeWithItem:item] atIndex:index];
+            position++;
+        }];
+        
+        return;
+    }
+    
+    GNEItemNode **nodes = [self p_copyNodesWithCapacity:count];
+    
+    // Moves the existing nodes back to make room for the new ones, starting from the end of the
+    // buffer so that no node is overwritten before it has been moved.
+    __block NSUInteger existingCount = self.count;
+    __block NSUInteger filledCount = count;
+    [indexes enumerateRangesWithOptions:NSEnumerationReverse usingBlock:^(NSRange range, BOOL *stop __unused)
+    {
+        while (filledCount > NSMaxRange(range))
+        {
+            nodes[--filledCount] = nodes[--existingCount];
+        }
+        filledCount = range.location;
+    }];
+    
+    [indexes enumerateRangesUsingBlock:^(NSRange range, BOOL *stop __unused)
+    {
+        for (NSUInteger index = range.location; index < NSMaxRange(range); index++)
+        {
+            GNEOutlineViewItem *item = (items) ? items[position] : nil;
+            NSParameterAssert(item == nil || item.arrayNode == NULL);
+            nodes[index] = [self p_newNodeWithItem:item];
+            position++;
+        }
+    }];
+    
+    [self p_rebuildTreeWithNodes:nodes count:count];
+    free(nodes);
+}
+
+
+- (GNEItemNode *)p_nodeAtIndex:(NSUInteger)index
+{
+    GNEItemNode *node = GNEItemNodeAtIndex(self.root, index);
+    
+    if (node == NULL)
+    {
+        [NSException raise:NSRangeException
+                    format:@"Index %llu is beyond bounds [0 .. %llu)",
+                           (unsigned long long)index, (unsigned long long)self.count];
+    }
+    
+    return node;
+}
+
+
+/// Returns a new node containing the specified item. If the item is nil, it is created by the item
+/// provider when it is first accessed.
+- (GNEItemNode *)p_newNodeWithItem:(GNEOutlineViewItem *)item
+{
+    if (self.freeNodes == NULL)
+    {
+        NSUInteger count = MAX(kMinimumNodeSlabCount, self.count / 4);
+        GNEItemNode *nodes = [self p_allocateSlabWithCount:count];
+        for (NSUInteger i = 0; i < count; i++)
+        {
+            nodes[i].right = (i + 1 < count) ? &nodes[i + 1] : NULL;
+        }
+        self.freeNodes = nodes;
+    }
+    
+    GNEItemNode *node = self.freeNodes;
+    self.freeNodes = node->right;
+    memset(node, 0, sizeof(GNEItemNode));
+    
+    node->size = 1;
+    if (item)
+    {
+        [self p_setItem:item ofNode:node];
+    }
+    
+    return node;
+}
+
+
+- (void)p_freeNode:(GNEItemNode *)node
+{
+    if (node == NULL)
+    {
+        return;
+    }
+    
+    [self p_releaseItemOfNode:node];
+    memset(node, 0, sizeof(GNEItemNode));
+    node->right = self.freeNodes;
+    self.freeNodes = node;
+}
+
+
+/// Frees every node of the treap rooted at the specified node, which must already have been split off
+/// of the receiver's treap. Left children are rotated up as the tree is walked, so it needs neither
+/// recursion nor parent pointers. O(n)
+- (void)p_freeTree:(GNEItemNode *)node
+{
+    while (node)
+    {
+        GNEItemNode *left = node->left;
+        if (left)
+        {
+            node->left = left->right;
+            left->right = node;
+            node = left;
+        }
+        else
+        {
+            GNEItemNode *right = node->right;
+            [self p_freeNode:node];
+            node = right;
+        }
+    }
+}
+
+
+/// Returns the item of the specified node, creating it with the item provider if it doesn't exist yet.
+- (GNEOutlineViewItem *)p_itemOfNode:(GNEItemNode *)node
+{
+    if (node->item == NULL)
+    {
+        GNEOutlineViewItemProvider itemProvider = self.itemProvider;
+        NSAssert(itemProvider, @"Outline view item array entries without items require an item provider");
+        
+        GNEOutlineViewItem *item = itemProvider();
+        NSParameterAssert(item.arrayNode == NULL);
+        [self p_setItem:item ofNode:node];
+        GNEItemNodeItemDidChange(node);
+    }
+    
+    return (__bridge GNEOutlineViewItem *)node->item;
+}
+
+
+- (void)p_setItem:(GNEOutlineViewItem *)item ofNode:(GNEItemNode *)node
+{
+    node->item = (void *)CFBridgingRetain(item);
+    item.arrayNode = node;
+    self.materializedCount++;
+}
+
+
+- (void)p_releaseItemOfNode:(GNEItemNode *)node
+{
+    if (node->item == NULL)
+    {
+        return;
+    }
+    
+    GNEOutlineViewItem *item = (GNEOutlineViewItem *)CFBridgingRelease(node->item);
+    node->item = NULL;
+    if (item.arrayNode == node)
+    {
+        item.arrayNode = NULL;
+    }
+    self.materializedCount--;
+}
+
+
+/**
+ Releases the items of the nodes of the treap rooted at the specified node whose indexes, relative to
+ that treap, are in the specified range and updates the item counts of the treap. Subtrees without items
+ are skipped, so this takes O((k + 1) lg n) time for k released items.
+ */
+- (void)p_releaseItemsOfTree:(GNEItemNode *)node inRange:(NSRange)range
+{
+    if (node == NULL || node->itemCount == 0 || range.length == 0)
+    {
+        return;
+    }
+    
+    NSUInteger leftSize = GNEItemNodeSize(node->left);
+    NSUInteger end = NSMaxRange(range);
+    if (range.location < leftSize)
+    {
+        [self p_releaseItemsOfTree:node->left
+                           inRange:NSMakeRange(range.location, MIN(end, leftSize) - range.location)];
+    }
+    if (range.location <= leftSize && leftSize < end)
+    {
+        [self p_releaseItemOfNode:node];
+    }
+    if (end > leftSize + 1)
+    {
+        NSUInteger start = MAX(range.location, leftSize + 1);
+        [self p_releaseItemsOfTree:node->right inRange:NSMakeRange(start - (leftSize + 1), end - start)];
+    }
+    
+    GNEItemNodeUpdateItemCount(node);
+}
+
+
+/// Returns the nodes of a new slab containing the specified number of zeroed nodes.
+- (GNEItemNode *)p_allocateSlabWithCount:(NSUInteger)count
+{
+    GNEItemNodeSlab *slab = NULL;
+    if (count <= (SIZE_MAX - sizeof(GNEItemNodeSlab)) / sizeof(GNEItemNode))
+    {
+        slab = calloc(1, sizeof(GNEItemNodeSlab) + count * sizeof(GNEItemNode));
+    }
+    
+    if (slab == NULL)
+    {
+        [NSException raise:kMemoryAllocationAssertionName format:@"%@", kMemoryAllocationAssertionReason];
+    }
+    
+    slab->next = self.slabs;
+    self.slabs = slab;
+    
+    return slab->nodes;
+}
+
+
+/// Releases the items of every node in the treap and frees all of the receiver's slabs.
+- (void)p_freeAllNodes
+{
+    for (GNEItemNode *node = GNEItemNodeFirst(self.root); node; node = GNEItemNodeNext(node))
+    {
+        [self p_releaseItemOfNode:node];
+    }
+    self.root = NULL;
+    self.freeNodes = NULL;
+    
+    GNEItemNodeSlab *slab = self.slabs;
+    while (slab)
+    {
+        GNEItemNodeSlab *next = slab->next;
+        free(slab);
+        slab = next;
+    }
+    self.slabs = NULL;
+}
+
+
+- (uint32_t)p_nextPriority
+{
+    uint32_t seed = self.seed;
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    self.seed = seed;
+    
+    return seed;
+}
+
+
+/// Builds the receiver's treap out of the specified items or, if items is nil, out of the specified
+/// number of entries without items.
+- (void)p_buildTreeWithItems:(NSArray *)items count:(NSUInteger)count
+{
+    if (count == 0)
+    {
+        return;
+    }
+    
+    // All of the nodes come from a single slab.
+    GNEItemNode *nodes = [self p_allocateSlabWithCount:count];
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        nodes[i].size = 1;
+        
+        GNEOutlineViewItem *item = (items) ? items[i] : nil;
+        NSParameterAssert(item == nil || item.arrayNode == NULL);
+        if (item)
+        {
+            [self p_setItem:item ofNode:&nodes[i]];
+        }
+    }
+    
+    NSUInteger bandCount = GNEItemNodeBalancedDepth(count);
+    uint32_t bandSize = (uint32_t)(UINT32_MAX / (bandCount + 1));
+    
+    uint32_t seed = self.seed;
+    self.root = GNEItemNodeBuild(nodes, count, 0, bandSize, bandCount, &seed);
+    self.seed = seed;
+    self.mutationCount++;
+}
+
+
+/// Rebuilds the receiver's treap out of the specified list of nodes, which replace the ones it
+/// currently contains. O(n)
+- (void)p_rebuildTreeWithNodes:(GNEItemNode **)nodes count:(NSUInteger)count
+{
+    NSUInteger bandCount = GNEItemNodeBalancedDepth(count);
+    uint32_t bandSize = (uint32_t)(UINT32_MAX / (bandCount + 1));
+    
+    uint32_t seed = self.seed;
+    self.root = GNEItemNodeBuildFromList(nodes, count, 0, bandSize, bandCount, &seed);
+    self.seed = seed;
+    self.mutationCount++;
+}
+
+
+/// Returns a buffer containing the receiver's nodes in order, which the caller must free, followed by
+/// enough free space for the specified number of additional nodes. O(n)
+- (GNEItemNode **)p_copyNodesWithCapacity:(NSUInteger)capacity
+{
+    NSUInteger count = self.count;
+    GNEItemNode **nodes = NULL;
+    if (capacity >= count && capacity <= SIZE_MAX / sizeof(GNEItemNode *))
+    {
+        nodes = malloc(MAX(capacity, (NSUInteger)1) * sizeof(GNEItemNode *));
+    }
+    
+    if (nodes == NULL)
+    {
+        [NSException raise:kMemoryAllocationAssertionName format:@"%@", kMemoryAllocationAssertionReason];
+    }
+    
+    NSUInteger index = 0;
+    for (GNEItemNode *node = GNEItemNodeFirst(self.root); node; node = GNEItemNodeNext(node))
+    {
+        nodes[index++] = node;
+    }
+    
+    return nodes;
+}
+
+
+@end
@@ -29,16 +29,54 @@
 //  SOFTWARE.
 //
 
-@import Cocoa;
+@import Foundation;
 #import "GNEOutlineViewItem.h"
 
 // ------------------------------------------------------------------------------------------
 
+/// Rows of a section whose heights are being measured on a background queue.
+@interface GNEOutlineViewRowHeightMeasurement : NSObject
+
+/// Indexes of the measured rows whose heights can still be committed, in terms of the section's current
+/// rows. Rows are removed when they are deleted or scheduled to be measured again.
+@property (nonatomic, strong, readonly, nonnull) NSMutableIndexSet *rows;
+
+/// Positions of the rows in rows among the rows the measurement started with, in the same order.
+@property (nonatomic, strong, readonly, nonnull) NSMutableIndexSet *positions;
+
+- (nonnull instancetype)initWithRows:(nonnull NSIndexSet *)rows NS_DESIGNATED_INITIALIZER;
+
+@end
+
+// ------------------------------------------------------------------------------------------
+
 @interface GNEOutlineViewParentItem : GNEOutlineViewItem
 
 /// YES if the parent item's section has a footer, otherwise NO.
 @property (nonatomic, assign) BOOL hasFooter;
 
+/// Section the parent item currently represents in its table view, or NSNotFound if it isn't in one.
+@property (nonatomic, assign) NSUInteger section;
+
+/// Height of the section header row represented by the parent item.
+@property (nonatomic, assign) CGFloat height;
+
+/// Indexes of the rows of the parent item's section whose heights are estimated until they have been
+/// measured on a background queue, or nil.
+@property (nonatomic, strong, nullable) NSMutableIndexSet *unmeasuredRows;
+
+/// Indexes of the rows of the parent item's section whose heights are estimated until they come near
+/// the visible rows, or nil.
+@property (nonatomic, strong, nullable) NSMutableIndexSet *estimatedRows;
+
+/// Measurements of the rows of the parent item's section that are in progress, or nil. Measurements that
+/// are removed are discarded when they finish.
+@property (nonatomic, strong, nullable) NSMutableArray *rowHeightMeasurements;
+
+/// Delegate asked for the index path of the parent item or of its children when they are written
+/// to a pasteboard.
+@property (nonatomic, weak) id <GNEOutlineViewItemPasteboardWritingDelegate> _Nullable pasteboardWritingDelegate;
+
 - (nonnull instancetype)init NS_DESIGNATED_INITIALIZER;
 - (nullable instancetype)initWithCoder:(nonnull NSCoder *)aDecoder NS_DESIGNATED_INITIALIZER;
 
@@ -42,9 +42,40 @@ static NSString * const kOutlineViewParentItemHasFooterKey = @"hasFooter";
 // ------------------------------------------------------------------------------------------
 
 
+@implementation GNEOutlineViewRowHeightMeasurement
+
+
+- (instancetype)initWithRows:(NSIndexSet *)rows
+{
+    if ((self = [super init]))
+    {
+        _rows = [rows mutableCopy];
+        _positions = [NSMutableIndexSet indexSetWithIndexesInRange:NSMakeRange(0, rows.count)];
+    }
+    
+    return self;
+}
+
+
+- (instancetype)init
+{
+    return [self initWithRows:[NSIndexSet indexSet]];
+}
+
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
 @implementation GNEOutlineViewParentItem
 
 
+// Outline view items get their pasteboard writing delegate from their parent item.
+@synthesize pasteboardWritingDelegate = _pasteboardWritingDelegate;
+
+
 // ------------------------------------------------------------------------------------------
 #pragma mark - Initialization
 // ------------------------------------------------------------------------------------------
@@ -53,6 +84,8 @@ static NSString * const kOutlineViewParentItemHasFooterKey = @"hasFooter";
     if (self = [super initWithParentItem:nil])
     {
         _hasFooter = NO;
+        _section = NSNotFound;
+        _height = 0.0;
     }
     
     return self;
@@ -83,6 +116,8 @@ static NSString * const kOutlineViewParentItemHasFooterKey = @"hasFooter";
     if ((self = [super initWithCoder:aDecoder]))
     {
         _hasFooter = hasFooterNumber.boolValue;
+        _section = NSNotFound;
+        _height = 0.0;
     }
     
     return self;
@@ -112,7 +147,7 @@ static NSString * const kOutlineViewParentItemHasFooterKey = @"hasFooter";
     }
     
     return [NSString stringWithFormat:@"<%@: %p>%@",
-            [self className], self, sectionString];
+            NSStringFromClass([self class]), self, sectionString];
 }
 
 
@@ -0,0 +1,85 @@
+//
+//  GNEPrefixSumArray.h
+//  GNESectionedTableView
+//
+//  Copyright (c) 2014 Gone East LLC. All rights reserved.
+//
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2014 Gone East LLC
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+@import Foundation;
+
+// ------------------------------------------------------------------------------------------
+
+/**
+ GNEPrefixSumArray is an array of floating point values backed by a Fenwick tree (binary indexed tree),
+ which makes it possible to update values and query the sums of prefixes of the array in O(lg n) time.
+ Inserting or removing values only rebuilds the part of the tree after the first affected index.
+ */
+@interface GNEPrefixSumArray : NSObject <NSCopying>
+
+/// Returns the number of values contained in the receiver. O(1)
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+/// Returns the sum of all of the values contained in the receiver. O(lg n)
+@property (nonatomic, assign, readonly) CGFloat totalSum;
+
+#pragma mark - Class initializers
++ (nonnull instancetype)array;
++ (nonnull instancetype)arrayWithValues:(nullable const CGFloat *)values count:(NSUInteger)count;
+
+#pragma mark - Initializers
+- (nonnull instancetype)init;
+/// Returns a prefix sum array containing the specified values. O(n)
+- (nonnull instancetype)initWithValues:(nullable const CGFloat *)values
+                                 count:(NSUInteger)count NS_DESIGNATED_INITIALIZER;
+
+#pragma mark - Values
+/// Returns the value at the specified index. Throws an exception if the index is beyond the bounds
+/// of the receiver. O(1)
+- (CGFloat)valueAtIndex:(NSUInteger)index;
+/// Sets the value at the specified index. Throws an exception if the index is beyond the bounds
+/// of the receiver. O(lg n)
+- (void)setValue:(CGFloat)value atIndex:(NSUInteger)index;
+
+#pragma mark - Adding/Removing Values
+/// Inserts the specified values, in order, at the specified indexes, which are the indexes of the values
+/// after the insertion. Throws an exception if an index is greater than the final count of the receiver.
+/// O(n - i + lg^2 n) for the smallest index i
+- (void)insertValues:(nonnull const CGFloat *)values atIndexes:(nonnull NSIndexSet *)indexes;
+/// Removes the values at the specified indexes. Throws an exception if an index is beyond the bounds of
+/// the receiver. O(n - i + lg^2 n) for the smallest index i
+- (void)removeValuesAtIndexes:(nonnull NSIndexSet *)indexes;
+
+#pragma mark - Sums
+/// Returns the sum of the values before the specified index. Throws an exception if the index is
+/// greater than the receiver's count. O(lg n)
+- (CGFloat)sumOfValuesBeforeIndex:(NSUInteger)index;
+/// Returns the index of the value containing the specified sum, which is the index whose prefix sum is
+/// less than or equal to the specified sum and whose prefix sum plus its value is greater than it, or
+/// NSNotFound if the sum is negative or greater than or equal to the receiver's total sum. All of
+/// the receiver's values must be greater than or equal to 0.0. O(lg n)
+- (NSUInteger)indexOfValueContainingSum:(CGFloat)sum;
+
+@end
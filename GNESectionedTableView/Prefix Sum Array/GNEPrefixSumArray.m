@@ -0,0 +1,418 @@
+//
+//  GNEPrefixSumArray.m
+//  GNESectionedTableView
+//
+//  Copyright (c) 2014 Gone East LLC. All rights reserved.
+//
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2014 Gone East LLC
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import "GNEPrefixSumArray.h"
+
+
+// ------------------------------------------------------------------------------------------
+
+
+static NSString * const kMemoryAllocationAssertionName = @"Memory Allocation Failure";
+static NSString * const kMemoryAllocationAssertionReason = @"Calloc failed";
+static NSString * const kMemoryReallocationAssertionReason = @"Realloc failed";
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@interface GNEPrefixSumArray ()
+
+@property (nonatomic, assign) NSUInteger valuesCount;
+
+/// Values contained in the receiver.
+@property (nonatomic, assign) CGFloat *values;
+
+/// One-based Fenwick tree of the values. The element at index i contains the sum of the values in
+/// the range (i - lowbit(i), i].
+@property (nonatomic, assign) CGFloat *tree;
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@implementation GNEPrefixSumArray
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Class Initialization
+// ------------------------------------------------------------------------------------------
++ (instancetype)array
+{
+    return [[[self class] alloc] initWithValues:NULL count:0];
+}
+
+
++ (instancetype)arrayWithValues:(const CGFloat *)values count:(NSUInteger)count
+{
+    return [[[self class] alloc] initWithValues:values count:count];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Initialization
+// ------------------------------------------------------------------------------------------
+- (instancetype)init
+{
+    return [self initWithValues:NULL count:0];
+}
+
+
+- (instancetype)initWithValues:(const CGFloat *)values count:(NSUInteger)count
+{
+    NSParameterAssert(values || count == 0);
+    
+    if ((self = [super init]))
+    {
+        _valuesCount = count;
+        _values = calloc(count + 1, sizeof(CGFloat));
+        _tree = calloc(count + 1, sizeof(CGFloat));
+        
+        if (_values == NULL || _tree == NULL)
+        {
+            free(_values);
+            free(_tree);
+            [NSException raise:kMemoryAllocationAssertionName format:@"%@", kMemoryAllocationAssertionReason];
+        }
+        
+        if (count > 0)
+        {
+            memcpy(_values, values, count * sizeof(CGFloat));
+            [self p_buildTree];
+        }
+    }
+    
+    return self;
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Dealloc
+// ------------------------------------------------------------------------------------------
+- (void)dealloc
+{
+    free(_values);
+    _values = NULL;
+    
+    free(_tree);
+    _tree = NULL;
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - NSCopying
+// ------------------------------------------------------------------------------------------
+- (instancetype)copyWithZone:(NSZone * __unused)zone
+{
+    return [[[self class] alloc] initWithValues:self.values count:self.valuesCount];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - NSObject
+// ------------------------------------------------------------------------------------------
+- (NSString *)description
+{
+    NSMutableArray *values = [NSMutableArray arrayWithCapacity:self.valuesCount];
+    for (NSUInteger i = 0; i < self.valuesCount; i++)
+    {
+        [values addObject:@(self.values[i])];
+    }
+    
+    return [NSString stringWithFormat:@"<%@: %p> Count: %llu, values: %@",
+            NSStringFromClass([self class]), self, (unsigned long long)self.valuesCount, values];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Public - Values
+// ------------------------------------------------------------------------------------------
+- (NSUInteger)count
+{
+    return self.valuesCount;
+}
+
+
+- (CGFloat)totalSum
+{
+    return [self sumOfValuesBeforeIndex:self.valuesCount];
+}
+
+
+- (CGFloat)valueAtIndex:(NSUInteger)index
+{
+    [self p_assertIndexIsInBounds:index];
+    
+    return self.values[index];
+}
+
+
+- (void)setValue:(CGFloat)value atIndex:(NSUInteger)index
+{
+    [self p_assertIndexIsInBounds:index];
+    
+    CGFloat delta = value - self.values[index];
+    self.values[index] = value;
+    
+    NSUInteger count = self.valuesCount;
+    CGFloat *tree = self.tree;
+    for (NSUInteger i = index + 1; i <= count; i += (i & -i))
+    {
+        tree[i] += delta;
+    }
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Public - Adding/Removing Values
+// ------------------------------------------------------------------------------------------
+- (void)insertValues:(const CGFloat *)values atIndexes:(NSIndexSet *)indexes
+{
+    NSParameterAssert(values || indexes.count == 0);
+    
+    NSUInteger insertedCount = indexes.count;
+    if (insertedCount == 0)
+    {
+        return;
+    }
+    
+    NSUInteger count = self.valuesCount;
+    NSUInteger finalCount = count + insertedCount;
+    if (indexes.lastIndex >= finalCount)
+    {
+        [NSException raise:NSRangeException
+                    format:@"Index %llu is beyond bounds [0 .. %llu)",
+                           (unsigned long long)indexes.lastIndex, (unsigned long long)finalCount];
+    }
+    
+    [self p_reallocateForCount:finalCount];
+    
+    // Moves the existing values back to make room for the inserted values, starting with the last one.
+    CGFloat *receiverValues = self.values;
+    __block NSUInteger source = count;
+    __block NSUInteger destination = finalCount;
+    __block NSUInteger position = insertedCount;
+    [indexes enumerateIndexesWithOptions:NSEnumerationReverse usingBlock:^(NSUInteger index, BOOL *stop __unused)
+    {
+        NSUInteger movedCount = destination - index - 1;
+        source -= movedCount;
+        destination -= movedCount;
+        memmove(&receiverValues[destination], &receiverValues[source], movedCount * sizeof(CGFloat));
+        
+        destination -= 1;
+        position -= 1;
+        receiverValues[destination] = values[position];
+    }];
+    
+    self.valuesCount = finalCount;
+    [self p_rebuildTreeFromIndex:indexes.firstIndex];
+}
+
+
+- (void)removeValuesAtIndexes:(NSIndexSet *)indexes
+{
+    if (indexes.count == 0)
+    {
+        return;
+    }
+    
+    NSUInteger count = self.valuesCount;
+    [self p_assertIndexIsInBounds:indexes.lastIndex];
+    
+    // Moves the values between the removed ranges forward, starting with the first one.
+    CGFloat *values = self.values;
+    __block NSUInteger source = indexes.firstIndex;
+    __block NSUInteger destination = indexes.firstIndex;
+    [indexes enumerateRangesUsingBlock:^(NSRange range, BOOL *stop __unused)
+    {
+        NSUInteger movedCount = range.location - source;
+        memmove(&values[destination], &values[source], movedCount * sizeof(CGFloat));
+        destination += movedCount;
+        source = NSMaxRange(range);
+    }];
+    memmove(&values[destination], &values[source], (count - source) * sizeof(CGFloat));
+    
+    self.valuesCount = count - indexes.count;
+    [self p_rebuildTreeFromIndex:indexes.firstIndex];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Public - Sums
+// ------------------------------------------------------------------------------------------
+- (CGFloat)sumOfValuesBeforeIndex:(NSUInteger)index
+{
+    if (index > self.valuesCount)
+    {
+        [NSException raise:NSRangeException
+                    format:@"Index %llu is beyond bounds [0 .. %llu]",
+                           (unsigned long long)index, (unsigned long long)self.valuesCount];
+    }
+    
+    CGFloat sum = 0.0;
+    CGFloat *tree = self.tree;
+    for (NSUInteger i = index; i > 0; i -= (i & -i))
+    {
+        sum += tree[i];
+    }
+    
+    return sum;
+}
+
+
+- (NSUInteger)indexOfValueContainingSum:(CGFloat)sum
+{
+    NSUInteger count = self.valuesCount;
+    
+    if (sum < 0.0 || count == 0)
+    {
+        return NSNotFound;
+    }
+    
+    NSUInteger step = 1;
+    while ((step << 1) <= count)
+    {
+        step <<= 1;
+    }
+    
+    // Finds the largest number of values whose sum is less than or equal to the specified sum. The value
+    // after them is the one containing the sum.
+    CGFloat *tree = self.tree;
+    NSUInteger position = 0;
+    for (; step > 0; step >>= 1)
+    {
+        NSUInteger next = position + step;
+        if (next <= count && tree[next] <= sum)
+        {
+            position = next;
+            sum -= tree[next];
+        }
+    }
+    
+    return (position < count) ? position : NSNotFound;
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Private
+// ------------------------------------------------------------------------------------------
+- (void)p_assertIndexIsInBounds:(NSUInteger)index
+{
+    if (index >= self.valuesCount)
+    {
+        [NSException raise:NSRangeException
+                    format:@"Index %llu is beyond bounds [0 .. %llu)",
+                           (unsigned long long)index, (unsigned long long)self.valuesCount];
+    }
+}
+
+
+/// Grows the receiver's buffers so that they can hold the specified number of values.
+- (void)p_reallocateForCount:(NSUInteger)count
+{
+    CGFloat *values = realloc(self.values, (count + 1) * sizeof(CGFloat));
+    if (values == NULL)
+    {
+        [NSException raise:kMemoryAllocationAssertionName format:@"%@", kMemoryReallocationAssertionReason];
+    }
+    self.values = values;
+    
+    CGFloat *tree = realloc(self.tree, (count + 1) * sizeof(CGFloat));
+    if (tree == NULL)
+    {
+        [NSException raise:kMemoryAllocationAssertionName format:@"%@", kMemoryReallocationAssertionReason];
+    }
+    self.tree = tree;
+}
+
+
+/**
+ Rebuilds the elements of the Fenwick tree that contain values at or after the specified index in
+ O(n - index + lg^2 n).
+ 
+ @discussion The elements up to the index only contain values before it, so they are still valid. The
+ others are first set to the prefix sums of the values and then, from the last one back, reduced to the
+ sums of their ranges by subtracting the prefix sums before their ranges. Only the O(lg n) elements whose
+ ranges start before the index need to query the valid part of the tree for those.
+ */
+- (void)p_rebuildTreeFromIndex:(NSUInteger)index
+{
+    NSUInteger count = self.valuesCount;
+    CGFloat *values = self.values;
+    CGFloat *tree = self.tree;
+    
+    CGFloat sumBeforeIndex = [self sumOfValuesBeforeIndex:index];
+    CGFloat sum = sumBeforeIndex;
+    for (NSUInteger i = index + 1; i <= count; i++)
+    {
+        sum += values[i - 1];
+        tree[i] = sum;
+    }
+    
+    for (NSUInteger i = count; i > index; i--)
+    {
+        NSUInteger start = i - (i & -i);
+        if (start > index)
+        {
+            tree[i] -= tree[start];
+        }
+        else if (start == index)
+        {
+            tree[i] -= sumBeforeIndex;
+        }
+        else
+        {
+            tree[i] -= [self sumOfValuesBeforeIndex:start];
+        }
+    }
+}
+
+
+/// Builds the Fenwick tree out of the receiver's values in O(n).
+- (void)p_buildTree
+{
+    NSUInteger count = self.valuesCount;
+    CGFloat *values = self.values;
+    CGFloat *tree = self.tree;
+    
+    for (NSUInteger i = 1; i <= count; i++)
+    {
+        tree[i] += values[i - 1];
+        NSUInteger parent = i + (i & -i);
+        if (parent <= count)
+        {
+            tree[parent] += tree[i];
+        }
+    }
+}
+
+
+@end
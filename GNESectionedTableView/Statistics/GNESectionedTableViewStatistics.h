@@ -0,0 +1,134 @@
+//
+//  GNESectionedTableViewStatistics.h
+//  GNESectionedTableView
+//
+//  Copyright (c) 2014 Gone East LLC. All rights reserved.
+//
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2014 Gone East LLC
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+@import Foundation;
+
+
+// ------------------------------------------------------------------------------------------
+
+
+// Statistics are compiled out by default. Define GNE_STATISTICS_ENABLED as 1 to record them.
+#ifndef GNE_STATISTICS_ENABLED
+    #define GNE_STATISTICS_ENABLED 0
+#endif
+
+
+// ------------------------------------------------------------------------------------------
+
+
+/**
+ GNESectionedTableViewStatistics is an immutable snapshot of the hot-path performance counters of a
+ sectioned table view. Snapshots are returned by -[GNESectionedTableView statistics] if
+ GNE_STATISTICS_ENABLED is 1.
+ 
+ @discussion The counters are meant to tell which delegate and data source methods a table view
+ depends on most, how expensive its item lookups are, and how long its updates take, so that they
+ can be compared before and after a change.
+ */
+@interface GNESectionedTableViewStatistics : NSObject <NSCopying>
+
+/// Number of times each delegate and data source method was called, keyed by selector name.
+@property (nonatomic, copy, readonly, nonnull) NSDictionary *numberOfCalloutsBySelector;
+
+/// Total number of delegate and data source method calls.
+@property (nonatomic, assign, readonly) NSUInteger numberOfCallouts;
+
+/// Number of outline view items that were resolved to their index paths.
+@property (nonatomic, assign, readonly) NSUInteger numberOfIndexPathResolutions;
+
+/// Average number of outline view items that were compared to find an item's index path.
+@property (nonatomic, assign, readonly) double averageIndexPathScanLength;
+
+/// Number of index paths created by GNESectionedTableView. Index paths are counted across all
+/// table views, because they are created by the NSIndexPath (GNESectionedTableView) category.
+@property (nonatomic, assign, readonly) NSUInteger numberOfIndexPathAllocations;
+
+/// Number of times the map of row views to their index paths was rebuilt after an update.
+@property (nonatomic, assign, readonly) NSUInteger numberOfRowViewMapRebuilds;
+
+/// Number of outermost -beginUpdates/-endUpdates transactions.
+@property (nonatomic, assign, readonly) NSUInteger numberOfUpdateTransactions;
+
+/// Total duration of the update transactions, in seconds.
+@property (nonatomic, assign, readonly) NSTimeInterval totalUpdateTime;
+
+/// Duration of the longest update transaction, in seconds.
+@property (nonatomic, assign, readonly) NSTimeInterval longestUpdateTime;
+
+/// Returns the number of times the method with the specified selector was called.
+- (NSUInteger)numberOfCalloutsForSelector:(nonnull SEL)selector;
+
+/// Returns the property list representation of the receiver, e.g., for logging or writing it to disk.
+- (nonnull NSDictionary *)dictionaryRepresentation;
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+#if GNE_STATISTICS_ENABLED
+
+/**
+ GNESectionedTableViewStatisticsRecorder accumulates the counters of a table view. It isn't thread
+ safe and must only be used on the thread its table view is used on.
+ */
+@interface GNESectionedTableViewStatisticsRecorder : NSObject
+
+/// Returns a snapshot of the counters recorded since the receiver was created or last reset.
+@property (nonatomic, strong, readonly, nonnull) GNESectionedTableViewStatistics *statistics;
+
+- (void)recordCalloutWithSelector:(nonnull SEL)selector;
+- (void)recordIndexPathResolutionWithScanLength:(NSUInteger)scanLength;
+- (void)recordRowViewMapRebuild;
+/// Only the outermost transaction is timed, so calls must be balanced.
+- (void)beginUpdateTransaction;
+- (void)endUpdateTransaction;
+- (void)reset;
+
+@end
+
+/// Counts an index path allocation. Safe to call from any thread.
+extern void GNESectionedTableViewStatisticsRecordIndexPathAllocation(void);
+
+    #define GNEStatisticsRecordCallout(recorder, selector) [(recorder) recordCalloutWithSelector:(selector)]
+    #define GNEStatisticsRecordIndexPathResolution(recorder, scanLength) [(recorder) recordIndexPathResolutionWithScanLength:(scanLength)]
+    #define GNEStatisticsRecordIndexPathAllocation() GNESectionedTableViewStatisticsRecordIndexPathAllocation()
+    #define GNEStatisticsRecordRowViewMapRebuild(recorder) [(recorder) recordRowViewMapRebuild]
+    #define GNEStatisticsBeginUpdateTransaction(recorder) [(recorder) beginUpdateTransaction]
+    #define GNEStatisticsEndUpdateTransaction(recorder) [(recorder) endUpdateTransaction]
+#else
+    #define GNEStatisticsRecordCallout(recorder, selector) do { } while (0)
+    #define GNEStatisticsRecordIndexPathResolution(recorder, scanLength) do { } while (0)
+    #define GNEStatisticsRecordIndexPathAllocation() do { } while (0)
+    #define GNEStatisticsRecordRowViewMapRebuild(recorder) do { } while (0)
+    #define GNEStatisticsBeginUpdateTransaction(recorder) do { } while (0)
+    #define GNEStatisticsEndUpdateTransaction(recorder) do { } while (0)
+#endif
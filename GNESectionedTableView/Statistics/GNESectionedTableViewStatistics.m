@@ -0,0 +1,317 @@
+//
+//  GNESectionedTableViewStatistics.m
+//  GNESectionedTableView
+//
+//  Copyright (c) 2014 Gone East LLC. All rights reserved.
+//
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2014 Gone East LLC
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import "GNESectionedTableViewStatistics.h"
+
+#if GNE_STATISTICS_ENABLED
+#import <stdatomic.h>
+#endif
+
+
+// ------------------------------------------------------------------------------------------
+
+
+static NSString * const kCalloutsKey = @"callouts";
+static NSString * const kNumberOfCalloutsKey = @"numberOfCallouts";
+static NSString * const kNumberOfIndexPathResolutionsKey = @"numberOfIndexPathResolutions";
+static NSString * const kAverageIndexPathScanLengthKey = @"averageIndexPathScanLength";
+static NSString * const kNumberOfIndexPathAllocationsKey = @"numberOfIndexPathAllocations";
+static NSString * const kNumberOfRowViewMapRebuildsKey = @"numberOfRowViewMapRebuilds";
+static NSString * const kNumberOfUpdateTransactionsKey = @"numberOfUpdateTransactions";
+static NSString * const kTotalUpdateTimeKey = @"totalUpdateTime";
+static NSString * const kLongestUpdateTimeKey = @"longestUpdateTime";
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@interface GNESectionedTableViewStatistics ()
+
+@property (nonatomic, copy, readwrite, nonnull) NSDictionary *numberOfCalloutsBySelector;
+@property (nonatomic, assign, readwrite) NSUInteger numberOfCallouts;
+@property (nonatomic, assign, readwrite) NSUInteger numberOfIndexPathResolutions;
+@property (nonatomic, assign, readwrite) double averageIndexPathScanLength;
+@property (nonatomic, assign, readwrite) NSUInteger numberOfIndexPathAllocations;
+@property (nonatomic, assign, readwrite) NSUInteger numberOfRowViewMapRebuilds;
+@property (nonatomic, assign, readwrite) NSUInteger numberOfUpdateTransactions;
+@property (nonatomic, assign, readwrite) NSTimeInterval totalUpdateTime;
+@property (nonatomic, assign, readwrite) NSTimeInterval longestUpdateTime;
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@implementation GNESectionedTableViewStatistics
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Initialization
+// ------------------------------------------------------------------------------------------
+- (instancetype)init
+{
+    if ((self = [super init]))
+    {
+        _numberOfCalloutsBySelector = @{};
+    }
+    
+    return self;
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Callouts
+// ------------------------------------------------------------------------------------------
+- (NSUInteger)numberOfCalloutsForSelector:(SEL)selector
+{
+    NSParameterAssert(selector);
+    
+    return [self.numberOfCalloutsBySelector[NSStringFromSelector(selector)] unsignedIntegerValue];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Dictionary Representation
+// ------------------------------------------------------------------------------------------
+- (NSDictionary *)dictionaryRepresentation
+{
+    return @{kCalloutsKey : self.numberOfCalloutsBySelector,
+             kNumberOfCalloutsKey : @(self.numberOfCallouts),
+             kNumberOfIndexPathResolutionsKey : @(self.numberOfIndexPathResolutions),
+             kAverageIndexPathScanLengthKey : @(self.averageIndexPathScanLength),
+             kNumberOfIndexPathAllocationsKey : @(self.numberOfIndexPathAllocations),
+             kNumberOfRowViewMapRebuildsKey : @(self.numberOfRowViewMapRebuilds),
+             kNumberOfUpdateTransactionsKey : @(self.numberOfUpdateTransactions),
+             kTotalUpdateTimeKey : @(self.totalUpdateTime),
+             kLongestUpdateTimeKey : @(self.longestUpdateTime)};
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - NSCopying
+// ------------------------------------------------------------------------------------------
+- (id)copyWithZone:(NSZone * __unused)zone
+{
+    return self;
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Description
+// ------------------------------------------------------------------------------------------
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p> %@", [self class], self, [self dictionaryRepresentation]];
+}
+
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+#if GNE_STATISTICS_ENABLED
+
+static atomic_uint_fast64_t GNEIndexPathAllocationCount = 0;
+
+
+void GNESectionedTableViewStatisticsRecordIndexPathAllocation(void)
+{
+    atomic_fetch_add_explicit(&GNEIndexPathAllocationCount, 1, memory_order_relaxed);
+}
+
+
+static void GNEStatisticsAddCallout(const void *selector, const void *count, void *callouts)
+{
+    NSMutableDictionary *dictionary = (__bridge NSMutableDictionary *)callouts;
+    dictionary[NSStringFromSelector((SEL)selector)] = @((NSUInteger)count);
+}
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@interface GNESectionedTableViewStatisticsRecorder ()
+{
+    /// Maps selectors to the number of times they were called. Neither are retained.
+    CFMutableDictionaryRef _callouts;
+}
+
+@property (nonatomic, assign) NSUInteger numberOfIndexPathResolutions;
+@property (nonatomic, assign) NSUInteger totalIndexPathScanLength;
+/// Value of GNEIndexPathAllocationCount when the receiver was last reset.
+@property (nonatomic, assign) uint64_t initialIndexPathAllocationCount;
+@property (nonatomic, assign) NSUInteger numberOfRowViewMapRebuilds;
+@property (nonatomic, assign) NSUInteger updateTransactionDepth;
+@property (nonatomic, assign) NSTimeInterval updateTransactionStartTime;
+@property (nonatomic, assign) NSUInteger numberOfUpdateTransactions;
+@property (nonatomic, assign) NSTimeInterval totalUpdateTime;
+@property (nonatomic, assign) NSTimeInterval longestUpdateTime;
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@implementation GNESectionedTableViewStatisticsRecorder
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Initialization
+// ------------------------------------------------------------------------------------------
+- (instancetype)init
+{
+    if ((self = [super init]))
+    {
+        _callouts = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, NULL);
+        _initialIndexPathAllocationCount = atomic_load_explicit(&GNEIndexPathAllocationCount,
+                                                                memory_order_relaxed);
+    }
+    
+    return self;
+}
+
+
+- (void)dealloc
+{
+    if (_callouts)
+    {
+        CFRelease(_callouts);
+        _callouts = NULL;
+    }
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Recording
+// ------------------------------------------------------------------------------------------
+- (void)recordCalloutWithSelector:(SEL)selector
+{
+    uintptr_t count = (uintptr_t)CFDictionaryGetValue(_callouts, (const void *)selector);
+    CFDictionarySetValue(_callouts, (const void *)selector, (const void *)(count + 1));
+}
+
+
+- (void)recordIndexPathResolutionWithScanLength:(NSUInteger)scanLength
+{
+    self.numberOfIndexPathResolutions += 1;
+    self.totalIndexPathScanLength += scanLength;
+}
+
+
+- (void)recordRowViewMapRebuild
+{
+    self.numberOfRowViewMapRebuilds += 1;
+}
+
+
+- (void)beginUpdateTransaction
+{
+    if (self.updateTransactionDepth == 0)
+    {
+        self.updateTransactionStartTime = [NSProcessInfo processInfo].systemUptime;
+    }
+    
+    self.updateTransactionDepth += 1;
+}
+
+
+- (void)endUpdateTransaction
+{
+    NSParameterAssert(self.updateTransactionDepth > 0);
+    
+    self.updateTransactionDepth -= 1;
+    if (self.updateTransactionDepth > 0)
+    {
+        return;
+    }
+    
+    NSTimeInterval duration = [NSProcessInfo processInfo].systemUptime - self.updateTransactionStartTime;
+    self.numberOfUpdateTransactions += 1;
+    self.totalUpdateTime += duration;
+    self.longestUpdateTime = MAX(self.longestUpdateTime, duration);
+}
+
+
+/// Clears the counters. A transaction that is in progress is still timed when it ends.
+- (void)reset
+{
+    CFDictionaryRemoveAllValues(_callouts);
+    self.numberOfIndexPathResolutions = 0;
+    self.totalIndexPathScanLength = 0;
+    self.initialIndexPathAllocationCount = atomic_load_explicit(&GNEIndexPathAllocationCount,
+                                                                memory_order_relaxed);
+    self.numberOfRowViewMapRebuilds = 0;
+    self.numberOfUpdateTransactions = 0;
+    self.totalUpdateTime = 0.0;
+    self.longestUpdateTime = 0.0;
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Snapshot
+// ------------------------------------------------------------------------------------------
+- (GNESectionedTableViewStatistics *)statistics
+{
+    NSMutableDictionary *callouts = [NSMutableDictionary dictionaryWithCapacity:
+                                     (NSUInteger)CFDictionaryGetCount(_callouts)];
+    CFDictionaryApplyFunction(_callouts, GNEStatisticsAddCallout, (__bridge void *)callouts);
+    
+    NSUInteger numberOfCallouts = 0;
+    for (NSNumber *count in callouts.objectEnumerator)
+    {
+        numberOfCallouts += count.unsignedIntegerValue;
+    }
+    
+    uint64_t allocationCount = atomic_load_explicit(&GNEIndexPathAllocationCount, memory_order_relaxed);
+    
+    GNESectionedTableViewStatistics *statistics = [[GNESectionedTableViewStatistics alloc] init];
+    statistics.numberOfCalloutsBySelector = callouts;
+    statistics.numberOfCallouts = numberOfCallouts;
+    statistics.numberOfIndexPathResolutions = self.numberOfIndexPathResolutions;
+    statistics.averageIndexPathScanLength = (self.numberOfIndexPathResolutions > 0) ?
+        (double)self.totalIndexPathScanLength / self.numberOfIndexPathResolutions : 0.0;
+    statistics.numberOfIndexPathAllocations = (NSUInteger)(allocationCount -
+                                                           self.initialIndexPathAllocationCount);
+    statistics.numberOfRowViewMapRebuilds = self.numberOfRowViewMapRebuilds;
+    statistics.numberOfUpdateTransactions = self.numberOfUpdateTransactions;
+    statistics.totalUpdateTime = self.totalUpdateTime;
+    statistics.longestUpdateTime = self.longestUpdateTime;
+    
+    return statistics;
+}
+
+
+@end
+
+#endif
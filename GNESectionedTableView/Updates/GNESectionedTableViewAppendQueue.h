@@ -0,0 +1,88 @@
+//
+//  GNESectionedTableViewAppendQueue.h
+//  GNESectionedTableView
+//
+//  Copyright (c) 2014 Gone East LLC. All rights reserved.
+//
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2014 Gone East LLC
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+@import Foundation;
+
+// ------------------------------------------------------------------------------------------
+
+/// Block called on the main thread with the number of rows (NSNumber) appended to each section
+/// (NSNumber) since the previous flush.
+typedef void (^GNESectionedTableViewAppendQueueFlushHandler)(NSDictionary * __nonnull rowCountsBySection);
+
+
+// ------------------------------------------------------------------------------------------
+
+
+/**
+ GNESectionedTableViewAppendQueue collects the rows appended to the sections of a table view from any
+ thread and hands them to the table view on the main thread at most once per display refresh.
+ 
+ @discussion Appending rows only adds to a per-section count under a lock, so producers never wait for
+ the table view, and any number of appends made between two refreshes of the display reach the table
+ view as a single flush. The refreshes are observed with a display link, which runs only while rows are
+ being appended and stops after about a second without any. If no display link can be created, flushes
+ are scheduled on the main queue instead, which coalesces the appends made during a run loop iteration.
+ */
+@interface GNESectionedTableViewAppendQueue : NSObject
+
+/// Returns YES if no rows are waiting to be flushed, otherwise NO. Thread-safe.
+@property (nonatomic, assign, readonly, getter=isEmpty) BOOL empty;
+
+- (nonnull instancetype)initWithFlushHandler:(nonnull GNESectionedTableViewAppendQueueFlushHandler)flushHandler NS_DESIGNATED_INITIALIZER;
+- (nonnull instancetype)init NS_UNAVAILABLE;
+
+/// Adds the specified number of rows to the end of the specified section. Thread-safe.
+- (void)appendRows:(NSUInteger)count toSection:(NSUInteger)section;
+
+/// Removes and returns the number of rows (NSNumber) appended to each section (NSNumber) since the
+/// previous call. Thread-safe.
+- (nonnull NSDictionary *)dequeueRowCountsBySection;
+
+/// Calls the flush handler with the pending rows right away, if there are any. Must be called on the
+/// main thread.
+- (void)flush;
+
+/// Discards the pending rows without calling the flush handler, e.g., because the table view is
+/// reloading all of its rows. Thread-safe.
+- (void)removeAllRows;
+
+/// Moves the pending rows of the sections at or after each of the specified sections, in ascending
+/// order, to the following section, so that they stay with their sections when new sections are
+/// inserted. Thread-safe.
+- (void)insertSections:(nonnull NSIndexSet *)sections;
+/// Discards the pending rows of the specified sections and moves the pending rows of the sections after
+/// them to the preceding sections, so that they stay with their sections when the specified sections are
+/// deleted. Thread-safe.
+- (void)removeSections:(nonnull NSIndexSet *)sections;
+/// Removes and returns the number of pending rows (NSNumber) of each of the specified sections
+/// (NSNumber) that has any, without moving the pending rows of other sections. Thread-safe.
+- (nonnull NSDictionary *)removeRowsInSections:(nonnull NSIndexSet *)sections;
+
+@end
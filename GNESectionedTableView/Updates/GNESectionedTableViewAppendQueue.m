@@ -0,0 +1,445 @@
+//
+//  GNESectionedTableViewAppendQueue.m
+//  GNESectionedTableView
+//
+//  Copyright (c) 2014 Gone East LLC. All rights reserved.
+//
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2014 Gone East LLC
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import "GNESectionedTableViewAppendQueue.h"
+#import <pthread.h>
+
+@import CoreVideo;
+
+
+// ------------------------------------------------------------------------------------------
+
+
+/// Number of consecutive display refreshes without appended rows after which the display link is stopped.
+static const NSUInteger kMaximumNumberOfIdleFrames = 60;
+
+
+static CVReturn GNESectionedTableViewAppendQueueDisplayLinkCallback(CVDisplayLinkRef displayLink,
+                                                                    const CVTimeStamp *now,
+                                                                    const CVTimeStamp *outputTime,
+                                                                    CVOptionFlags flagsIn,
+                                                                    CVOptionFlags *flagsOut,
+                                                                    void *context);
+
+
+// ------------------------------------------------------------------------------------------
+
+
+/**
+ Context of the append queue's display link. The display link's callback runs on its own thread and
+ can fire while the append queue is being deallocated, so it reaches the append queue through this
+ object's weak reference instead of through an unretained pointer to the append queue itself.
+ */
+@interface GNESectionedTableViewAppendQueueDisplayLinkTarget : NSObject
+
+@property (nonatomic, weak, readonly) GNESectionedTableViewAppendQueue *appendQueue;
+
+- (instancetype)initWithAppendQueue:(GNESectionedTableViewAppendQueue *)appendQueue;
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@implementation GNESectionedTableViewAppendQueueDisplayLinkTarget
+
+
+- (instancetype)initWithAppendQueue:(GNESectionedTableViewAppendQueue *)appendQueue
+{
+    if ((self = [super init]))
+    {
+        _appendQueue = appendQueue;
+    }
+    
+    return self;
+}
+
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@interface GNESectionedTableViewAppendQueue ()
+{
+    pthread_mutex_t _lock;
+    
+    // The following are protected by the lock.
+    
+    /// Maps sections to the number of rows appended to them since the previous flush.
+    NSMutableDictionary *_rowCountsBySection;
+    /// YES while the display link runs or is about to be started, or, without a display link, while
+    /// a flush is scheduled on the main queue.
+    BOOL _active;
+    /// YES if the display link scheduled a flush that hasn't run yet.
+    BOOL _flushScheduled;
+    /// YES if the display link scheduled stopping itself and that hasn't run yet.
+    BOOL _stopScheduled;
+    NSUInteger _numberOfIdleFrames;
+}
+
+@property (nonatomic, copy) GNESectionedTableViewAppendQueueFlushHandler flushHandler;
+@property (nonatomic, assign) CVDisplayLinkRef displayLink;
+/// Context passed to the display link's callback. Kept alive until the display link is stopped.
+@property (nonatomic, strong) GNESectionedTableViewAppendQueueDisplayLinkTarget *displayLinkTarget;
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@implementation GNESectionedTableViewAppendQueue
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Initialization
+// ------------------------------------------------------------------------------------------
+- (instancetype)initWithFlushHandler:(GNESectionedTableViewAppendQueueFlushHandler)flushHandler
+{
+    NSParameterAssert(flushHandler);
+    
+    if ((self = [super init]))
+    {
+        pthread_mutex_init(&_lock, NULL);
+        _rowCountsBySection = [NSMutableDictionary dictionary];
+        _flushHandler = [flushHandler copy];
+        
+        CVDisplayLinkRef displayLink = NULL;
+        if (CVDisplayLinkCreateWithActiveCGDisplays(&displayLink) == kCVReturnSuccess)
+        {
+            _displayLinkTarget = [[GNESectionedTableViewAppendQueueDisplayLinkTarget alloc] initWithAppendQueue:self];
+            CVDisplayLinkSetOutputCallback(displayLink,
+                                           &GNESectionedTableViewAppendQueueDisplayLinkCallback,
+                                           (__bridge void *)_displayLinkTarget);
+            _displayLink = displayLink;
+        }
+    }
+    
+    return self;
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Dealloc
+// ------------------------------------------------------------------------------------------
+- (void)dealloc
+{
+    if (_displayLink)
+    {
+        // The last reference to the receiver may be released by the display link's callback, on the
+        // display link's thread, so the display link is stopped on the main queue instead. Until then,
+        // its callback finds that the target's append queue is nil. The block keeps the target alive.
+        CVDisplayLinkRef displayLink = _displayLink;
+        GNESectionedTableViewAppendQueueDisplayLinkTarget *displayLinkTarget = _displayLinkTarget;
+        dispatch_async(dispatch_get_main_queue(), ^()
+        {
+            CVDisplayLinkStop(displayLink);
+            CVDisplayLinkRelease(displayLink);
+            (void)displayLinkTarget;
+        });
+        _displayLink = NULL;
+    }
+    
+    pthread_mutex_destroy(&_lock);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Appending Rows
+// ------------------------------------------------------------------------------------------
+- (BOOL)isEmpty
+{
+    pthread_mutex_lock(&_lock);
+    BOOL isEmpty = (_rowCountsBySection.count == 0);
+    pthread_mutex_unlock(&_lock);
+    
+    return isEmpty;
+}
+
+
+- (void)appendRows:(NSUInteger)count toSection:(NSUInteger)section
+{
+    if (count == 0)
+    {
+        return;
+    }
+    
+    BOOL shouldActivate = NO;
+    
+    pthread_mutex_lock(&_lock);
+    NSNumber *sectionNumber = @(section);
+    NSUInteger pendingCount = [_rowCountsBySection[sectionNumber] unsignedIntegerValue];
+    _rowCountsBySection[sectionNumber] = @(pendingCount + count);
+    _numberOfIdleFrames = 0;
+    if (_active == NO)
+    {
+        _active = YES;
+        shouldActivate = YES;
+    }
+    pthread_mutex_unlock(&_lock);
+    
+    if (shouldActivate)
+    {
+        __weak typeof(self) weakSelf = self;
+        dispatch_async(dispatch_get_main_queue(), ^()
+        {
+            [weakSelf p_activate];
+        });
+    }
+}
+
+
+- (NSDictionary *)dequeueRowCountsBySection
+{
+    pthread_mutex_lock(&_lock);
+    NSDictionary *rowCountsBySection = [_rowCountsBySection copy];
+    [_rowCountsBySection removeAllObjects];
+    pthread_mutex_unlock(&_lock);
+    
+    return rowCountsBySection;
+}
+
+
+- (void)flush
+{
+    NSAssert([NSThread isMainThread], @"%@ must be called on the main thread", NSStringFromSelector(_cmd));
+    
+    NSDictionary *rowCountsBySection = [self dequeueRowCountsBySection];
+    if (rowCountsBySection.count > 0)
+    {
+        self.flushHandler(rowCountsBySection);
+    }
+}
+
+
+- (void)removeAllRows
+{
+    pthread_mutex_lock(&_lock);
+    [_rowCountsBySection removeAllObjects];
+    pthread_mutex_unlock(&_lock);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Inserting and Removing Sections
+// ------------------------------------------------------------------------------------------
+- (void)insertSections:(NSIndexSet *)sections
+{
+    NSParameterAssert(sections);
+    
+    pthread_mutex_lock(&_lock);
+    if (_rowCountsBySection.count > 0 && sections.count > 0)
+    {
+        NSMutableDictionary *rowCountsBySection = [NSMutableDictionary dictionary];
+        [_rowCountsBySection enumerateKeysAndObjectsUsingBlock:^(NSNumber *sectionNumber,
+                                                                 NSNumber *rowCount,
+                                                                 BOOL *stop __unused)
+        {
+            // Each inserted section at or before the section's shifted index moves it by one.
+            __block NSUInteger section = sectionNumber.unsignedIntegerValue;
+            [sections enumerateIndexesUsingBlock:^(NSUInteger insertedSection, BOOL *innerStop)
+            {
+                if (insertedSection > section)
+                {
+                    *innerStop = YES;
+                    return;
+                }
+                
+                section += 1;
+            }];
+            rowCountsBySection[@(section)] = rowCount;
+        }];
+        _rowCountsBySection = rowCountsBySection;
+    }
+    pthread_mutex_unlock(&_lock);
+}
+
+
+- (void)removeSections:(NSIndexSet *)sections
+{
+    NSParameterAssert(sections);
+    
+    pthread_mutex_lock(&_lock);
+    if (_rowCountsBySection.count > 0 && sections.count > 0)
+    {
+        NSMutableDictionary *rowCountsBySection = [NSMutableDictionary dictionary];
+        [_rowCountsBySection enumerateKeysAndObjectsUsingBlock:^(NSNumber *sectionNumber,
+                                                                 NSNumber *rowCount,
+                                                                 BOOL *stop __unused)
+        {
+            NSUInteger section = sectionNumber.unsignedIntegerValue;
+            if ([sections containsIndex:section] == NO)
+            {
+                NSUInteger removedCount = [sections countOfIndexesInRange:NSMakeRange(0, section)];
+                rowCountsBySection[@(section - removedCount)] = rowCount;
+            }
+        }];
+        _rowCountsBySection = rowCountsBySection;
+    }
+    pthread_mutex_unlock(&_lock);
+}
+
+
+- (NSDictionary *)removeRowsInSections:(NSIndexSet *)sections
+{
+    NSParameterAssert(sections);
+    
+    NSMutableDictionary *removedRowCounts = [NSMutableDictionary dictionary];
+    
+    pthread_mutex_lock(&_lock);
+    for (NSNumber *sectionNumber in _rowCountsBySection.allKeys)
+    {
+        if ([sections containsIndex:sectionNumber.unsignedIntegerValue])
+        {
+            removedRowCounts[sectionNumber] = _rowCountsBySection[sectionNumber];
+            [_rowCountsBySection removeObjectForKey:sectionNumber];
+        }
+    }
+    pthread_mutex_unlock(&_lock);
+    
+    return [removedRowCounts copy];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Scheduling Flushes
+// ------------------------------------------------------------------------------------------
+/// Starts the display link or, without one, flushes the pending rows. Called on the main queue, like
+/// -p_stopIfIdle, so that starting and stopping the display link can't race.
+- (void)p_activate
+{
+    if (self.displayLink)
+    {
+        CVDisplayLinkStart(self.displayLink);
+        
+        return;
+    }
+    
+    pthread_mutex_lock(&_lock);
+    _active = NO;
+    pthread_mutex_unlock(&_lock);
+    
+    [self flush];
+}
+
+
+/// Called on the display link's thread once per display refresh.
+- (void)p_displayLinkDidFire
+{
+    BOOL shouldFlush = NO;
+    BOOL shouldStop = NO;
+    
+    pthread_mutex_lock(&_lock);
+    if (_rowCountsBySection.count > 0)
+    {
+        _numberOfIdleFrames = 0;
+        shouldFlush = (_flushScheduled == NO);
+        _flushScheduled = YES;
+    }
+    else if (++_numberOfIdleFrames >= kMaximumNumberOfIdleFrames)
+    {
+        shouldStop = (_stopScheduled == NO);
+        _stopScheduled = YES;
+    }
+    pthread_mutex_unlock(&_lock);
+    
+    __weak typeof(self) weakSelf = self;
+    if (shouldFlush)
+    {
+        dispatch_async(dispatch_get_main_queue(), ^()
+        {
+            [weakSelf p_flushScheduledRows];
+        });
+    }
+    else if (shouldStop)
+    {
+        dispatch_async(dispatch_get_main_queue(), ^()
+        {
+            [weakSelf p_stopIfIdle];
+        });
+    }
+}
+
+
+- (void)p_flushScheduledRows
+{
+    pthread_mutex_lock(&_lock);
+    _flushScheduled = NO;
+    pthread_mutex_unlock(&_lock);
+    
+    [self flush];
+}
+
+
+- (void)p_stopIfIdle
+{
+    BOOL shouldStop = NO;
+    
+    pthread_mutex_lock(&_lock);
+    _stopScheduled = NO;
+    if (_rowCountsBySection.count == 0 && _numberOfIdleFrames >= kMaximumNumberOfIdleFrames)
+    {
+        _active = NO;
+        shouldStop = YES;
+    }
+    pthread_mutex_unlock(&_lock);
+    
+    if (shouldStop)
+    {
+        CVDisplayLinkStop(self.displayLink);
+    }
+}
+
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+static CVReturn GNESectionedTableViewAppendQueueDisplayLinkCallback(CVDisplayLinkRef __unused displayLink,
+                                                                    const CVTimeStamp * __unused now,
+                                                                    const CVTimeStamp * __unused outputTime,
+                                                                    CVOptionFlags __unused flagsIn,
+                                                                    CVOptionFlags * __unused flagsOut,
+                                                                    void *context)
+{
+    @autoreleasepool
+    {
+        GNESectionedTableViewAppendQueueDisplayLinkTarget *target =
+            (__bridge GNESectionedTableViewAppendQueueDisplayLinkTarget *)context;
+        [target.appendQueue p_displayLinkDidFire];
+    }
+    
+    return kCVReturnSuccess;
+}
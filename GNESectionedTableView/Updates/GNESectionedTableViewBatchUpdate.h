@@ -0,0 +1,95 @@
+//
+//  GNESectionedTableViewBatchUpdate.h
+//  GNESectionedTableView
+//
+//  Copyright (c) 2014 Gone East LLC. All rights reserved.
+//
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2014 Gone East LLC
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+@import Foundation;
+
+// ------------------------------------------------------------------------------------------
+
+/**
+ GNESectionedTableViewBatchUpdate collects the insertions, deletions, and reloads requested during
+ -[GNESectionedTableView performBatchUpdates:completion:] and normalizes them, so that the table
+ view can apply all of them in a single pass.
+ 
+ @discussion Like the changes of GNESectionedTableViewChangeSet, deleted and reloaded sections and rows
+ are expressed in terms of the sections and rows before the batch, and inserted sections and rows in
+ terms of the sections and rows after it. Moves are recorded as a deletion and an insertion.
+ 
+ Normalizing removes duplicates, the deletions and reloads of rows in deleted sections, the reloads
+ of deleted rows and sections, and the insertions of rows in inserted sections, whose rows are
+ loaded along with them. Each kind of update is applied with the animation it was last requested with.
+ */
+@interface GNESectionedTableViewBatchUpdate : NSObject
+
+/// Returns YES if no updates were recorded, otherwise NO.
+@property (nonatomic, assign, readonly, getter=isEmpty) BOOL empty;
+
+/// Sections deleted from the table view, in terms of the sections before the batch.
+@property (nonatomic, copy, readonly, nonnull) NSIndexSet *deletedSections;
+
+/// Sections inserted into the table view, in terms of the sections after the batch.
+@property (nonatomic, copy, readonly, nonnull) NSIndexSet *insertedSections;
+
+/// Inserted sections that should be collapsed instead of expanded.
+@property (nonatomic, copy, readonly, nonnull) NSIndexSet *collapsedInsertedSections;
+
+/// Sections reloaded in the table view, in terms of the sections before the batch.
+@property (nonatomic, copy, readonly, nonnull) NSIndexSet *reloadedSections;
+
+/// Arrays of the index paths of the deleted rows of each section, in terms of the index paths before
+/// the batch. The sections and the index paths in each of them are sorted in descending order.
+@property (nonatomic, copy, readonly, nonnull) NSArray *deletedRowIndexPathsGroupedBySection;
+
+/// Arrays of the index paths of the inserted rows of each section, in terms of the index paths after
+/// the batch. The sections and the index paths in each of them are sorted in ascending order.
+@property (nonatomic, copy, readonly, nonnull) NSArray *insertedRowIndexPathsGroupedBySection;
+
+/// Index paths of the reloaded rows, in terms of the index paths before the batch, sorted in
+/// ascending order.
+@property (nonatomic, copy, readonly, nonnull) NSArray *reloadedRowIndexPaths;
+
+/// Animations (NSTableViewAnimationOptions) the last deletion or insertion of each kind was requested with.
+@property (nonatomic, assign, readonly) NSUInteger sectionDeletionAnimationOptions;
+@property (nonatomic, assign, readonly) NSUInteger sectionInsertionAnimationOptions;
+@property (nonatomic, assign, readonly) NSUInteger rowDeletionAnimationOptions;
+@property (nonatomic, assign, readonly) NSUInteger rowInsertionAnimationOptions;
+
+#pragma mark - Recording Section Updates
+- (void)deleteSections:(nonnull NSIndexSet *)sections withAnimation:(NSUInteger)animationOptions;
+- (void)insertSections:(nonnull NSIndexSet *)sections
+         withAnimation:(NSUInteger)animationOptions
+              expanded:(BOOL)expanded;
+- (void)reloadSections:(nonnull NSIndexSet *)sections;
+
+#pragma mark - Recording Row Updates
+- (void)deleteRowsAtIndexPaths:(nonnull NSArray *)indexPaths withAnimation:(NSUInteger)animationOptions;
+- (void)insertRowsAtIndexPaths:(nonnull NSArray *)indexPaths withAnimation:(NSUInteger)animationOptions;
+- (void)reloadRowsAtIndexPaths:(nonnull NSArray *)indexPaths;
+
+@end
@@ -0,0 +1,298 @@
+//
+//  GNESectionedTableViewBatchUpdate.m
+//  GNESectionedTableView
+//
+//  Copyright (c) 2014 Gone East LLC. All rights reserved.
+//
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2014 Gone East LLC
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import "GNESectionedTableViewBatchUpdate.h"
+#import "NSIndexPath+GNESectionedTableView.h"
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@interface GNESectionedTableViewBatchUpdate ()
+
+@property (nonatomic, strong) NSMutableIndexSet *mutableDeletedSections;
+@property (nonatomic, strong) NSMutableIndexSet *mutableInsertedSections;
+@property (nonatomic, strong) NSMutableIndexSet *mutableCollapsedInsertedSections;
+@property (nonatomic, strong) NSMutableIndexSet *mutableReloadedSections;
+
+/// Map sections to the indexes of their deleted, inserted, or reloaded rows.
+@property (nonatomic, strong) NSMutableDictionary *deletedRowsBySection;
+@property (nonatomic, strong) NSMutableDictionary *insertedRowsBySection;
+@property (nonatomic, strong) NSMutableDictionary *reloadedRowsBySection;
+
+@property (nonatomic, assign, readwrite) NSUInteger sectionDeletionAnimationOptions;
+@property (nonatomic, assign, readwrite) NSUInteger sectionInsertionAnimationOptions;
+@property (nonatomic, assign, readwrite) NSUInteger rowDeletionAnimationOptions;
+@property (nonatomic, assign, readwrite) NSUInteger rowInsertionAnimationOptions;
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@implementation GNESectionedTableViewBatchUpdate
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Initialization
+// ------------------------------------------------------------------------------------------
+- (instancetype)init
+{
+    if ((self = [super init]))
+    {
+        _mutableDeletedSections = [NSMutableIndexSet indexSet];
+        _mutableInsertedSections = [NSMutableIndexSet indexSet];
+        _mutableCollapsedInsertedSections = [NSMutableIndexSet indexSet];
+        _mutableReloadedSections = [NSMutableIndexSet indexSet];
+        _deletedRowsBySection = [NSMutableDictionary dictionary];
+        _insertedRowsBySection = [NSMutableDictionary dictionary];
+        _reloadedRowsBySection = [NSMutableDictionary dictionary];
+    }
+    
+    return self;
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Recording Section Updates
+// ------------------------------------------------------------------------------------------
+- (void)deleteSections:(NSIndexSet *)sections withAnimation:(NSUInteger)animationOptions
+{
+    NSParameterAssert(sections);
+    
+    [self.mutableDeletedSections addIndexes:sections];
+    self.sectionDeletionAnimationOptions = animationOptions;
+}
+
+
+- (void)insertSections:(NSIndexSet *)sections
+         withAnimation:(NSUInteger)animationOptions
+              expanded:(BOOL)expanded
+{
+    NSParameterAssert(sections);
+    
+    [self.mutableInsertedSections addIndexes:sections];
+    if (expanded)
+    {
+        [self.mutableCollapsedInsertedSections removeIndexes:sections];
+    }
+    else
+    {
+        [self.mutableCollapsedInsertedSections addIndexes:sections];
+    }
+    self.sectionInsertionAnimationOptions = animationOptions;
+}
+
+
+- (void)reloadSections:(NSIndexSet *)sections
+{
+    NSParameterAssert(sections);
+    
+    [self.mutableReloadedSections addIndexes:sections];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Recording Row Updates
+// ------------------------------------------------------------------------------------------
+- (void)deleteRowsAtIndexPaths:(NSArray *)indexPaths withAnimation:(NSUInteger)animationOptions
+{
+    [self p_addRowsAtIndexPaths:indexPaths toDictionary:self.deletedRowsBySection];
+    self.rowDeletionAnimationOptions = animationOptions;
+}
+
+
+- (void)insertRowsAtIndexPaths:(NSArray *)indexPaths withAnimation:(NSUInteger)animationOptions
+{
+    [self p_addRowsAtIndexPaths:indexPaths toDictionary:self.insertedRowsBySection];
+    self.rowInsertionAnimationOptions = animationOptions;
+}
+
+
+- (void)reloadRowsAtIndexPaths:(NSArray *)indexPaths
+{
+    [self p_addRowsAtIndexPaths:indexPaths toDictionary:self.reloadedRowsBySection];
+}
+
+
+- (void)p_addRowsAtIndexPaths:(NSArray *)indexPaths toDictionary:(NSMutableDictionary *)rowsBySection
+{
+    NSParameterAssert(indexPaths);
+    
+    for (NSIndexPath *indexPath in indexPaths)
+    {
+        NSNumber *section = @(indexPath.gne_section);
+        NSMutableIndexSet *rows = rowsBySection[section];
+        if (rows == nil)
+        {
+            rows = [NSMutableIndexSet indexSet];
+            rowsBySection[section] = rows;
+        }
+        [rows addIndex:indexPath.gne_row];
+    }
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Normalized Updates
+// ------------------------------------------------------------------------------------------
+- (BOOL)isEmpty
+{
+    return (self.mutableDeletedSections.count == 0 &&
+            self.mutableInsertedSections.count == 0 &&
+            self.mutableReloadedSections.count == 0 &&
+            self.deletedRowsBySection.count == 0 &&
+            self.insertedRowsBySection.count == 0 &&
+            self.reloadedRowsBySection.count == 0);
+}
+
+
+- (NSIndexSet *)deletedSections
+{
+    return [self.mutableDeletedSections copy];
+}
+
+
+- (NSIndexSet *)insertedSections
+{
+    return [self.mutableInsertedSections copy];
+}
+
+
+- (NSIndexSet *)collapsedInsertedSections
+{
+    return [self.mutableCollapsedInsertedSections copy];
+}
+
+
+- (NSIndexSet *)reloadedSections
+{
+    NSMutableIndexSet *sections = [self.mutableReloadedSections mutableCopy];
+    [sections removeIndexes:self.mutableDeletedSections];
+    
+    return [sections copy];
+}
+
+
+- (NSArray *)deletedRowIndexPathsGroupedBySection
+{
+    NSArray *groups = [self p_indexPathsGroupedBySectionInDictionary:self.deletedRowsBySection
+                                                    excludingSections:self.mutableDeletedSections
+                                                        excludingRows:nil];
+    NSMutableArray *reversedGroups = [NSMutableArray arrayWithCapacity:groups.count];
+    for (NSArray *group in groups.reverseObjectEnumerator)
+    {
+        [reversedGroups addObject:group.reverseObjectEnumerator.allObjects];
+    }
+    
+    return [reversedGroups copy];
+}
+
+
+- (NSArray *)insertedRowIndexPathsGroupedBySection
+{
+    return [self p_indexPathsGroupedBySectionInDictionary:self.insertedRowsBySection
+                                        excludingSections:self.mutableInsertedSections
+                                            excludingRows:nil];
+}
+
+
+- (NSArray *)reloadedRowIndexPaths
+{
+    NSArray *groups = [self p_indexPathsGroupedBySectionInDictionary:self.reloadedRowsBySection
+                                                    excludingSections:self.mutableDeletedSections
+                                                        excludingRows:self.deletedRowsBySection];
+    NSMutableArray *indexPaths = [NSMutableArray array];
+    for (NSArray *group in groups)
+    {
+        [indexPaths addObjectsFromArray:group];
+    }
+    
+    return [indexPaths copy];
+}
+
+
+/**
+ Returns arrays of the index paths of the rows in the specified dictionary grouped by section. The
+ sections and the index paths in each of them are sorted in ascending order.
+ 
+ @param rowsBySection Dictionary mapping sections to the indexes of their rows.
+ @param excludedSections Sections whose rows are left out.
+ @param excludedRowsBySection Dictionary mapping sections to the indexes of the rows that are left
+ out, or nil.
+ @return Arrays of the index paths of each section, leaving out sections without index paths.
+ */
+- (NSArray *)p_indexPathsGroupedBySectionInDictionary:(NSDictionary *)rowsBySection
+                                    excludingSections:(NSIndexSet *)excludedSections
+                                        excludingRows:(NSDictionary *)excludedRowsBySection
+{
+    NSArray *sections = [rowsBySection.allKeys sortedArrayUsingSelector:@selector(compare:)];
+    NSMutableArray *groups = [NSMutableArray arrayWithCapacity:sections.count];
+    for (NSNumber *section in sections)
+    {
+        if ([excludedSections containsIndex:section.unsignedIntegerValue])
+        {
+            continue;
+        }
+        
+        NSIndexSet *rows = rowsBySection[section];
+        NSIndexSet *excludedRows = excludedRowsBySection[section];
+        if (excludedRows.count > 0)
+        {
+            NSMutableIndexSet *remainingRows = [rows mutableCopy];
+            [remainingRows removeIndexes:excludedRows];
+            rows = remainingRows;
+        }
+        
+        if (rows.count > 0)
+        {
+            [groups addObject:[NSIndexPath gne_indexPathsForIndexes:rows inSection:section.unsignedIntegerValue]];
+        }
+    }
+    
+    return [groups copy];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Description
+// ------------------------------------------------------------------------------------------
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p> Deleted sections: %@ Inserted sections: %@ "
+                                      @"Deleted rows: %@ Inserted rows: %@ Reloaded rows: %@",
+            [self class], self, self.deletedSections, self.insertedSections,
+            self.deletedRowIndexPathsGroupedBySection, self.insertedRowIndexPathsGroupedBySection,
+            self.reloadedRowIndexPaths];
+}
+
+
+@end
@@ -0,0 +1,120 @@
+//
+//  GNESectionedTableViewChangeSet.h
+//  GNESectionedTableView
+//
+//  Copyright (c) 2014 Gone East LLC. All rights reserved.
+//
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2014 Gone East LLC
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+@import Foundation;
+
+@class GNEOrderedIndexSet, GNESectionedTableViewSnapshot;
+
+// ------------------------------------------------------------------------------------------
+
+/**
+ GNESectionedTableViewChangeSet contains the minimal set of section and row insertions, deletions,
+ and moves needed to transform one snapshot into another.
+ 
+ @discussion Matching sections and rows are found by their identifiers using Heckel's algorithm,
+ which takes linear time. The moves are the matched sections (or the matched rows of a section) that
+ aren't part of the longest increasing subsequence of their new positions, which is the smallest
+ number of moves needed to put them in order. Finding that subsequence takes O(m lg m) time, where
+ m is the number of matched sections or rows.
+ 
+ Deleted sections and the sources of moved sections are expressed in terms of the old snapshot.
+ Inserted sections and the destinations of moved sections are expressed in terms of the new
+ snapshot. The rows of inserted and moved sections are not included in the row changes. Likewise,
+ rows removed from sections that are deleted or moved are not included. The row changes apply to
+ the remaining sections, which keep their relative order. Deleted rows and the sources of moved rows
+ use the old snapshot's index paths. Inserted rows and the destinations of moved rows use the new
+ snapshot's index paths.
+ */
+@interface GNESectionedTableViewChangeSet : NSObject
+
+/// Snapshot the changes are applied to.
+@property (nonatomic, strong, readonly, nonnull) GNESectionedTableViewSnapshot *fromSnapshot;
+
+/// Snapshot that results from applying the changes.
+@property (nonatomic, strong, readonly, nonnull) GNESectionedTableViewSnapshot *toSnapshot;
+
+/// Returns YES if the change set contains no insertions, deletions, or moves, otherwise NO.
+@property (nonatomic, assign, readonly, getter=isEmpty) BOOL empty;
+
+/// Sections in the old snapshot that were deleted.
+@property (nonatomic, copy, readonly, nonnull) NSIndexSet *deletedSections;
+
+/// Sections in the new snapshot that were inserted.
+@property (nonatomic, copy, readonly, nonnull) NSIndexSet *insertedSections;
+
+/// Sections in the old snapshot that were moved. Each position corresponds to the same position
+/// in movedToSections.
+@property (nonatomic, copy, readonly, nonnull) GNEOrderedIndexSet *movedFromSections;
+
+/// Sections in the new snapshot that were moved. Each position corresponds to the same position
+/// in movedFromSections.
+@property (nonatomic, copy, readonly, nonnull) GNEOrderedIndexSet *movedToSections;
+
+/// Index paths in the old snapshot of the rows that were deleted, sorted in ascending order.
+@property (nonatomic, copy, readonly, nonnull) NSArray *deletedRowIndexPaths;
+
+/// Index paths in the new snapshot of the rows that were inserted, sorted in ascending order.
+@property (nonatomic, copy, readonly, nonnull) NSArray *insertedRowIndexPaths;
+
+/// Index paths in the old snapshot of the rows that were moved. Each index path corresponds to the
+/// index path at the same index of movedToRowIndexPaths.
+@property (nonatomic, copy, readonly, nonnull) NSArray *movedFromRowIndexPaths;
+
+/// Index paths in the new snapshot of the rows that were moved. Each index path corresponds to the
+/// index path at the same index of movedFromRowIndexPaths.
+@property (nonatomic, copy, readonly, nonnull) NSArray *movedToRowIndexPaths;
+
+#pragma mark - Class initializers
++ (nonnull instancetype)changeSetFromSnapshot:(nonnull GNESectionedTableViewSnapshot *)fromSnapshot
+                                   toSnapshot:(nonnull GNESectionedTableViewSnapshot *)toSnapshot;
+
+#pragma mark - Initializers
+- (nonnull instancetype)init;
+/// Returns the changes needed to transform the specified old snapshot into the specified new snapshot.
+/// O(n + m lg m)
+- (nonnull instancetype)initWithSnapshot:(nonnull GNESectionedTableViewSnapshot *)fromSnapshot
+                              toSnapshot:(nonnull GNESectionedTableViewSnapshot *)toSnapshot NS_DESIGNATED_INITIALIZER;
+
+#pragma mark - Converting Index Paths
+/// Returns the section in the new snapshot corresponding to the specified section in the old
+/// snapshot or NSNotFound if the section was deleted. O(1)
+- (NSUInteger)sectionAfterChangesForSection:(NSUInteger)section;
+/**
+ Returns the index path in the new snapshot corresponding to the specified index path in the old
+ snapshot or nil if the row or section was deleted. O(1)
+ 
+ @discussion Index paths whose rows are beyond the bounds of their sections, like the index paths
+ of section headers and footers, keep their rows and only have their sections converted.
+ @param indexPath Index path in the old snapshot.
+ @return The index path in the new snapshot or nil.
+ */
+- (nullable NSIndexPath *)indexPathAfterChangesForIndexPath:(nullable NSIndexPath *)indexPath;
+
+@end
@@ -0,0 +1,495 @@
+//
+//  GNESectionedTableViewChangeSet.m
+//  GNESectionedTableView
+//
+//  Copyright (c) 2014 Gone East LLC. All rights reserved.
+//
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2014 Gone East LLC
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import "GNESectionedTableViewChangeSet.h"
+#import "GNESectionedTableViewSnapshot.h"
+#import "GNEOrderedIndexSet.h"
+#import "NSIndexPath+GNESectionedTableView.h"
+
+
+// ------------------------------------------------------------------------------------------
+
+
+static NSString * const kMemoryAllocationAssertionName = @"Memory Allocation Failure";
+static NSString * const kMemoryAllocationAssertionReason = @"Calloc failed";
+
+
+// ------------------------------------------------------------------------------------------
+
+
+/**
+ Sets isMember[i] to YES for each index i of the values that are part of a longest strictly
+ increasing subsequence of the specified values. O(n lg n)
+ */
+static void GNEMarkLongestIncreasingSubsequence(const NSUInteger *values, NSUInteger count, BOOL *isMember)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    
+    // tails[k] is the index of the smallest value that ends an increasing subsequence of length k + 1.
+    NSUInteger *tails = calloc(count, sizeof(NSUInteger));
+    NSUInteger *previous = calloc(count, sizeof(NSUInteger));
+    
+    if (tails == NULL || previous == NULL)
+    {
+        free(tails);
+        free(previous);
+        [NSException raise:kMemoryAllocationAssertionName format:@"%@", kMemoryAllocationAssertionReason];
+    }
+    
+    NSUInteger length = 0;
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        NSUInteger low = 0;
+        NSUInteger high = length;
+        while (low < high)
+        {
+            NSUInteger middle = low + ((high - low) / 2);
+            if (values[tails[middle]] < values[i])
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+        
+        previous[i] = (low > 0) ? tails[low - 1] : NSNotFound;
+        tails[low] = i;
+        length = MAX(length, low + 1);
+    }
+    
+    NSUInteger index = tails[length - 1];
+    while (index != NSNotFound)
+    {
+        isMember[index] = YES;
+        index = previous[index];
+    }
+    
+    free(tails);
+    free(previous);
+}
+
+
+static inline BOOL GNEIndexPathEqualsRowInSection(NSIndexPath *indexPath, NSUInteger row, NSUInteger section)
+{
+    return (indexPath && indexPath.gne_section == section && indexPath.gne_row == row);
+}
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@interface GNESectionedTableViewChangeSet ()
+
+@property (nonatomic, strong, readwrite) GNESectionedTableViewSnapshot *fromSnapshot;
+@property (nonatomic, strong, readwrite) GNESectionedTableViewSnapshot *toSnapshot;
+
+@property (nonatomic, copy, readwrite) NSIndexSet *deletedSections;
+@property (nonatomic, copy, readwrite) NSIndexSet *insertedSections;
+@property (nonatomic, copy, readwrite) GNEOrderedIndexSet *movedFromSections;
+@property (nonatomic, copy, readwrite) GNEOrderedIndexSet *movedToSections;
+
+@property (nonatomic, copy, readwrite) NSArray *deletedRowIndexPaths;
+@property (nonatomic, copy, readwrite) NSArray *insertedRowIndexPaths;
+@property (nonatomic, copy, readwrite) NSArray *movedFromRowIndexPaths;
+@property (nonatomic, copy, readwrite) NSArray *movedToRowIndexPaths;
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@implementation GNESectionedTableViewChangeSet
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Class Initialization
+// ------------------------------------------------------------------------------------------
++ (instancetype)changeSetFromSnapshot:(GNESectionedTableViewSnapshot *)fromSnapshot
+                           toSnapshot:(GNESectionedTableViewSnapshot *)toSnapshot
+{
+    return [[[self class] alloc] initWithSnapshot:fromSnapshot toSnapshot:toSnapshot];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Initialization
+// ------------------------------------------------------------------------------------------
+- (instancetype)init
+{
+    return [self initWithSnapshot:[GNESectionedTableViewSnapshot snapshot]
+                       toSnapshot:[GNESectionedTableViewSnapshot snapshot]];
+}
+
+
+- (instancetype)initWithSnapshot:(GNESectionedTableViewSnapshot *)fromSnapshot
+                      toSnapshot:(GNESectionedTableViewSnapshot *)toSnapshot
+{
+    NSParameterAssert(fromSnapshot);
+    NSParameterAssert(toSnapshot);
+    
+    if ((self = [super init]))
+    {
+        _fromSnapshot = (fromSnapshot) ?: [GNESectionedTableViewSnapshot snapshot];
+        _toSnapshot = (toSnapshot) ?: [GNESectionedTableViewSnapshot snapshot];
+        
+        [self p_computeChanges];
+    }
+    
+    return self;
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - NSObject
+// ------------------------------------------------------------------------------------------
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p>\nDeleted sections: %@\nInserted sections: %@\n"
+            "Moved sections: %@ -> %@\nDeleted rows: %@\nInserted rows: %@\nMoved rows: %@ -> %@",
+            NSStringFromClass([self class]), self, self.deletedSections, self.insertedSections,
+            self.movedFromSections, self.movedToSections, self.deletedRowIndexPaths,
+            self.insertedRowIndexPaths, self.movedFromRowIndexPaths, self.movedToRowIndexPaths];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Public - Accessors
+// ------------------------------------------------------------------------------------------
+- (BOOL)isEmpty
+{
+    return (self.deletedSections.count == 0 &&
+            self.insertedSections.count == 0 &&
+            self.movedFromSections.count == 0 &&
+            self.deletedRowIndexPaths.count == 0 &&
+            self.insertedRowIndexPaths.count == 0 &&
+            self.movedFromRowIndexPaths.count == 0);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Public - Converting Index Paths
+// ------------------------------------------------------------------------------------------
+- (NSUInteger)sectionAfterChangesForSection:(NSUInteger)section
+{
+    GNESectionedTableViewSnapshot *fromSnapshot = self.fromSnapshot;
+    
+    if (section >= fromSnapshot.numberOfSections)
+    {
+        return NSNotFound;
+    }
+    
+    id identifier = fromSnapshot.sectionIdentifiers[section];
+    if ([fromSnapshot sectionForSectionIdentifier:identifier] != section)
+    {
+        return NSNotFound; // Duplicate identifiers are never matched.
+    }
+    
+    return [self.toSnapshot sectionForSectionIdentifier:identifier];
+}
+
+
+- (NSIndexPath *)indexPathAfterChangesForIndexPath:(NSIndexPath *)indexPath
+{
+    if (indexPath == nil || indexPath.length != 2)
+    {
+        return nil;
+    }
+    
+    GNESectionedTableViewSnapshot *fromSnapshot = self.fromSnapshot;
+    NSUInteger section = indexPath.gne_section;
+    NSUInteger row = indexPath.gne_row;
+    
+    if (section >= fromSnapshot.numberOfSections)
+    {
+        return nil;
+    }
+    
+    if (row >= [fromSnapshot numberOfRowsInSection:section])
+    {
+        NSUInteger toSection = [self sectionAfterChangesForSection:section];
+        
+        return (toSection == NSNotFound) ? nil : [NSIndexPath gne_indexPathForRow:row inSection:toSection];
+    }
+    
+    id identifier = [fromSnapshot rowIdentifierAtIndexPath:indexPath];
+    NSIndexPath *fromIndexPath = [fromSnapshot indexPathForRowIdentifier:identifier];
+    if (GNEIndexPathEqualsRowInSection(fromIndexPath, row, section) == NO)
+    {
+        return nil; // Duplicate identifiers are never matched.
+    }
+    
+    return [self.toSnapshot indexPathForRowIdentifier:identifier];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Private - Diffing
+// ------------------------------------------------------------------------------------------
+- (void)p_computeChanges
+{
+    GNESectionedTableViewSnapshot *fromSnapshot = self.fromSnapshot;
+    GNESectionedTableViewSnapshot *toSnapshot = self.toSnapshot;
+    
+    NSUInteger fromCount = fromSnapshot.numberOfSections;
+    NSUInteger toCount = toSnapshot.numberOfSections;
+    
+    // Sections that are neither deleted, inserted, nor moved map to each other in these arrays.
+    NSUInteger *stableFromToSections = calloc(fromCount + 1, sizeof(NSUInteger));
+    NSUInteger *stableToFromSections = calloc(toCount + 1, sizeof(NSUInteger));
+    
+    if (stableFromToSections == NULL || stableToFromSections == NULL)
+    {
+        free(stableFromToSections);
+        free(stableToFromSections);
+        [NSException raise:kMemoryAllocationAssertionName format:@"%@", kMemoryAllocationAssertionReason];
+    }
+    
+    [self p_computeSectionChangesWithStableFromToSections:stableFromToSections
+                                     stableToFromSections:stableToFromSections];
+    [self p_computeRowChangesWithStableFromToSections:stableFromToSections
+                                 stableToFromSections:stableToFromSections];
+    
+    free(stableFromToSections);
+    free(stableToFromSections);
+}
+
+
+- (void)p_computeSectionChangesWithStableFromToSections:(NSUInteger *)stableFromToSections
+                                   stableToFromSections:(NSUInteger *)stableToFromSections
+{
+    GNESectionedTableViewSnapshot *fromSnapshot = self.fromSnapshot;
+    GNESectionedTableViewSnapshot *toSnapshot = self.toSnapshot;
+    
+    NSUInteger fromCount = fromSnapshot.numberOfSections;
+    NSUInteger toCount = toSnapshot.numberOfSections;
+    
+    NSUInteger *matchedFromSections = calloc(fromCount + 1, sizeof(NSUInteger));
+    NSUInteger *matchedToSections = calloc(fromCount + 1, sizeof(NSUInteger));
+    BOOL *isStable = calloc(fromCount + 1, sizeof(BOOL));
+    
+    if (matchedFromSections == NULL || matchedToSections == NULL || isStable == NULL)
+    {
+        free(matchedFromSections);
+        free(matchedToSections);
+        free(isStable);
+        [NSException raise:kMemoryAllocationAssertionName format:@"%@", kMemoryAllocationAssertionReason];
+    }
+    
+    for (NSUInteger section = 0; section < toCount; section++)
+    {
+        stableToFromSections[section] = NSNotFound;
+    }
+    
+    NSMutableIndexSet *deletedSections = [NSMutableIndexSet indexSet];
+    NSMutableIndexSet *insertedSections = [NSMutableIndexSet indexSet];
+    GNEOrderedIndexSet *movedFromSections = [GNEOrderedIndexSet indexSet];
+    GNEOrderedIndexSet *movedToSections = [GNEOrderedIndexSet indexSet];
+    
+    NSUInteger matchedCount = 0;
+    for (NSUInteger section = 0; section < fromCount; section++)
+    {
+        stableFromToSections[section] = NSNotFound;
+        
+        NSUInteger toSection = [self sectionAfterChangesForSection:section];
+        if (toSection == NSNotFound)
+        {
+            [deletedSections addIndex:section];
+        }
+        else
+        {
+            matchedFromSections[matchedCount] = section;
+            matchedToSections[matchedCount] = toSection;
+            matchedCount++;
+        }
+    }
+    
+    GNEMarkLongestIncreasingSubsequence(matchedToSections, matchedCount, isStable);
+    
+    for (NSUInteger i = 0; i < matchedCount; i++)
+    {
+        NSUInteger fromSection = matchedFromSections[i];
+        NSUInteger toSection = matchedToSections[i];
+        if (isStable[i])
+        {
+            stableFromToSections[fromSection] = toSection;
+            stableToFromSections[toSection] = fromSection;
+        }
+        else
+        {
+            [movedFromSections addIndex:fromSection];
+            [movedToSections addIndex:toSection];
+        }
+    }
+    
+    NSArray *toSectionIdentifiers = toSnapshot.sectionIdentifiers;
+    for (NSUInteger section = 0; section < toCount; section++)
+    {
+        id identifier = toSectionIdentifiers[section];
+        NSUInteger fromSection = [fromSnapshot sectionForSectionIdentifier:identifier];
+        BOOL isMatched = ([toSnapshot sectionForSectionIdentifier:identifier] == section &&
+                          [self sectionAfterChangesForSection:fromSection] == section);
+        if (isMatched == NO)
+        {
+            [insertedSections addIndex:section];
+        }
+    }
+    
+    free(matchedFromSections);
+    free(matchedToSections);
+    free(isStable);
+    
+    self.deletedSections = deletedSections;
+    self.insertedSections = insertedSections;
+    self.movedFromSections = movedFromSections;
+    self.movedToSections = movedToSections;
+}
+
+
+- (void)p_computeRowChangesWithStableFromToSections:(const NSUInteger *)stableFromToSections
+                               stableToFromSections:(const NSUInteger *)stableToFromSections
+{
+    GNESectionedTableViewSnapshot *fromSnapshot = self.fromSnapshot;
+    GNESectionedTableViewSnapshot *toSnapshot = self.toSnapshot;
+    
+    NSUInteger fromCount = fromSnapshot.numberOfSections;
+    
+    NSMutableArray *deletedRowIndexPaths = [NSMutableArray array];
+    NSMutableArray *insertedRowIndexPaths = [NSMutableArray array];
+    NSMutableArray *movedFromRowIndexPaths = [NSMutableArray array];
+    NSMutableArray *movedToRowIndexPaths = [NSMutableArray array];
+    
+    // Stable sections keep their relative order, so the index paths are collected in ascending order.
+    for (NSUInteger fromSection = 0; fromSection < fromCount; fromSection++)
+    {
+        NSUInteger toSection = stableFromToSections[fromSection];
+        if (toSection == NSNotFound)
+        {
+            continue;
+        }
+        
+        @autoreleasepool
+        {
+            NSArray *fromRows = [fromSnapshot rowIdentifiersInSection:fromSection];
+            NSArray *toRows = [toSnapshot rowIdentifiersInSection:toSection];
+            NSUInteger fromRowCount = fromRows.count;
+            NSUInteger toRowCount = toRows.count;
+            
+            // Rows that stay in the same section are only moved if they're out of order.
+            NSUInteger *matchedFromRows = calloc(fromRowCount + 1, sizeof(NSUInteger));
+            NSUInteger *matchedToRows = calloc(fromRowCount + 1, sizeof(NSUInteger));
+            BOOL *isStable = calloc(fromRowCount + 1, sizeof(BOOL));
+            
+            if (matchedFromRows == NULL || matchedToRows == NULL || isStable == NULL)
+            {
+                free(matchedFromRows);
+                free(matchedToRows);
+                free(isStable);
+                [NSException raise:kMemoryAllocationAssertionName format:@"%@", kMemoryAllocationAssertionReason];
+            }
+            
+            NSUInteger matchedCount = 0;
+            for (NSUInteger row = 0; row < fromRowCount; row++)
+            {
+                id identifier = fromRows[row];
+                NSIndexPath *fromIndexPath = [fromSnapshot indexPathForRowIdentifier:identifier];
+                NSIndexPath *toIndexPath = [toSnapshot indexPathForRowIdentifier:identifier];
+                
+                BOOL isMatched = (GNEIndexPathEqualsRowInSection(fromIndexPath, row, fromSection) &&
+                                  toIndexPath &&
+                                  stableToFromSections[toIndexPath.gne_section] != NSNotFound);
+                
+                if (isMatched == NO)
+                {
+                    [deletedRowIndexPaths addObject:[NSIndexPath gne_indexPathForRow:row
+                                                                           inSection:fromSection]];
+                }
+                else if (toIndexPath.gne_section == toSection)
+                {
+                    matchedFromRows[matchedCount] = row;
+                    matchedToRows[matchedCount] = toIndexPath.gne_row;
+                    matchedCount++;
+                }
+                else
+                {
+                    [movedFromRowIndexPaths addObject:fromIndexPath];
+                    [movedToRowIndexPaths addObject:toIndexPath];
+                }
+            }
+            
+            GNEMarkLongestIncreasingSubsequence(matchedToRows, matchedCount, isStable);
+            
+            for (NSUInteger i = 0; i < matchedCount; i++)
+            {
+                if (isStable[i] == NO)
+                {
+                    [movedFromRowIndexPaths addObject:[NSIndexPath gne_indexPathForRow:matchedFromRows[i]
+                                                                             inSection:fromSection]];
+                    [movedToRowIndexPaths addObject:[NSIndexPath gne_indexPathForRow:matchedToRows[i]
+                                                                           inSection:toSection]];
+                }
+            }
+            
+            free(matchedFromRows);
+            free(matchedToRows);
+            free(isStable);
+            
+            for (NSUInteger row = 0; row < toRowCount; row++)
+            {
+                id identifier = toRows[row];
+                NSIndexPath *fromIndexPath = [fromSnapshot indexPathForRowIdentifier:identifier];
+                NSIndexPath *toIndexPath = [toSnapshot indexPathForRowIdentifier:identifier];
+                
+                BOOL isMatched = (GNEIndexPathEqualsRowInSection(toIndexPath, row, toSection) &&
+                                  fromIndexPath &&
+                                  stableFromToSections[fromIndexPath.gne_section] != NSNotFound);
+                
+                if (isMatched == NO)
+                {
+                    [insertedRowIndexPaths addObject:[NSIndexPath gne_indexPathForRow:row
+                                                                            inSection:toSection]];
+                }
+            }
+        }
+    }
+    
+    self.deletedRowIndexPaths = deletedRowIndexPaths;
+    self.insertedRowIndexPaths = insertedRowIndexPaths;
+    self.movedFromRowIndexPaths = movedFromRowIndexPaths;
+    self.movedToRowIndexPaths = movedToRowIndexPaths;
+}
+
+
+@end
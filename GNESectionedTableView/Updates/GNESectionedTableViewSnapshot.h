@@ -0,0 +1,87 @@
+//
+//  GNESectionedTableViewSnapshot.h
+//  GNESectionedTableView
+//
+//  Copyright (c) 2014 Gone East LLC. All rights reserved.
+//
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2014 Gone East LLC
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+@import Foundation;
+
+// ------------------------------------------------------------------------------------------
+
+/**
+ GNESectionedTableViewSnapshot is an immutable description of the contents of a sectioned table view
+ in terms of section and row identifiers. Two snapshots can be compared using
+ GNESectionedTableViewChangeSet to compute the updates needed to go from one to the other.
+ 
+ @discussion Identifiers can be any objects that implement -isEqual: and -hash. Section identifiers
+ must be unique among the sections of a snapshot and row identifiers must be unique among all of
+ the rows of a snapshot (not just the rows in the same section). If an identifier appears more than
+ once, only its first occurrence is matched against other snapshots.
+ */
+@interface GNESectionedTableViewSnapshot : NSObject <NSCopying>
+
+/// Returns the number of sections contained in the receiver. O(1)
+@property (nonatomic, assign, readonly) NSUInteger numberOfSections;
+
+/// Returns the identifiers of the receiver's sections.
+@property (nonatomic, copy, readonly, nonnull) NSArray *sectionIdentifiers;
+
+#pragma mark - Class initializers
++ (nonnull instancetype)snapshot;
++ (nonnull instancetype)snapshotWithSectionIdentifiers:(nonnull NSArray *)sectionIdentifiers
+                                        rowIdentifiers:(nonnull NSArray *)rowIdentifiers;
+
+#pragma mark - Initializers
+- (nonnull instancetype)init;
+/**
+ Returns a snapshot containing the specified sections and rows. O(n)
+ 
+ @param sectionIdentifiers Identifiers of the snapshot's sections.
+ @param rowIdentifiers Array containing one array of row identifiers for each section identifier.
+ @return A snapshot containing the specified sections and rows.
+ */
+- (nonnull instancetype)initWithSectionIdentifiers:(nonnull NSArray *)sectionIdentifiers
+                                    rowIdentifiers:(nonnull NSArray *)rowIdentifiers NS_DESIGNATED_INITIALIZER;
+
+#pragma mark - Sections
+/// Returns the number of rows in the specified section. Throws an exception if the section is
+/// beyond the bounds of the receiver. O(1)
+- (NSUInteger)numberOfRowsInSection:(NSUInteger)section;
+/// Returns the identifiers of the rows in the specified section. Throws an exception if the section
+/// is beyond the bounds of the receiver. O(1)
+- (nonnull NSArray *)rowIdentifiersInSection:(NSUInteger)section;
+/// Returns the section with the specified identifier or NSNotFound. O(1)
+- (NSUInteger)sectionForSectionIdentifier:(nullable id)identifier;
+
+#pragma mark - Rows
+/// Returns the identifier of the row at the specified index path or nil if the index path is
+/// beyond the bounds of the receiver. O(1)
+- (nullable id)rowIdentifierAtIndexPath:(nullable NSIndexPath *)indexPath;
+/// Returns the index path of the row with the specified identifier or nil. O(1)
+- (nullable NSIndexPath *)indexPathForRowIdentifier:(nullable id)identifier;
+
+@end
@@ -0,0 +1,242 @@
+//
+//  GNESectionedTableViewSnapshot.m
+//  GNESectionedTableView
+//
+//  Copyright (c) 2014 Gone East LLC. All rights reserved.
+//
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2014 Gone East LLC
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import "GNESectionedTableViewSnapshot.h"
+#import "NSIndexPath+GNESectionedTableView.h"
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@interface GNESectionedTableViewSnapshot ()
+
+/// Array containing one array of row identifiers for each section.
+@property (nonatomic, copy) NSArray *rowIdentifiers;
+
+/// Maps the section identifiers to their first sections.
+@property (nonatomic, copy) NSDictionary *sectionIdentifierToSectionMap;
+
+/// Maps the row identifiers to the index paths of their first rows.
+@property (nonatomic, copy) NSDictionary *rowIdentifierToIndexPathMap;
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@implementation GNESectionedTableViewSnapshot
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Class Initialization
+// ------------------------------------------------------------------------------------------
++ (instancetype)snapshot
+{
+    return [[[self class] alloc] initWithSectionIdentifiers:@[] rowIdentifiers:@[]];
+}
+
+
++ (instancetype)snapshotWithSectionIdentifiers:(NSArray *)sectionIdentifiers
+                                rowIdentifiers:(NSArray *)rowIdentifiers
+{
+    return [[[self class] alloc] initWithSectionIdentifiers:sectionIdentifiers
+                                             rowIdentifiers:rowIdentifiers];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Initialization
+// ------------------------------------------------------------------------------------------
+- (instancetype)init
+{
+    return [self initWithSectionIdentifiers:@[] rowIdentifiers:@[]];
+}
+
+
+- (instancetype)initWithSectionIdentifiers:(NSArray *)sectionIdentifiers
+                            rowIdentifiers:(NSArray *)rowIdentifiers
+{
+    NSParameterAssert(sectionIdentifiers);
+    NSParameterAssert(rowIdentifiers);
+    NSParameterAssert(sectionIdentifiers.count == rowIdentifiers.count);
+    
+    if ((self = [super init]))
+    {
+        NSUInteger sectionCount = MIN(sectionIdentifiers.count, rowIdentifiers.count);
+        _sectionIdentifiers = [[sectionIdentifiers subarrayWithRange:NSMakeRange(0, sectionCount)] copy];
+        
+        NSMutableArray *rowIdentifiersCopy = [NSMutableArray arrayWithCapacity:sectionCount];
+        NSMutableDictionary *sectionMap = [NSMutableDictionary dictionaryWithCapacity:sectionCount];
+        NSMutableDictionary *rowMap = [NSMutableDictionary dictionary];
+        
+        for (NSUInteger section = 0; section < sectionCount; section++)
+        {
+            id sectionIdentifier = _sectionIdentifiers[section];
+            if (sectionMap[sectionIdentifier] == nil)
+            {
+                sectionMap[sectionIdentifier] = @(section);
+            }
+            
+            NSArray *rows = [rowIdentifiers[section] copy];
+            NSParameterAssert([rows isKindOfClass:[NSArray class]]);
+            [rowIdentifiersCopy addObject:rows];
+            
+            NSUInteger rowCount = rows.count;
+            for (NSUInteger row = 0; row < rowCount; row++)
+            {
+                id rowIdentifier = rows[row];
+                if (rowMap[rowIdentifier] == nil)
+                {
+                    rowMap[rowIdentifier] = [NSIndexPath gne_indexPathForRow:row inSection:section];
+                }
+            }
+        }
+        
+        _rowIdentifiers = [rowIdentifiersCopy copy];
+        _sectionIdentifierToSectionMap = [sectionMap copy];
+        _rowIdentifierToIndexPathMap = [rowMap copy];
+    }
+    
+    return self;
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - NSObject
+// ------------------------------------------------------------------------------------------
+- (BOOL)isEqual:(id)object
+{
+    if (self == object)
+    {
+        return YES;
+    }
+    
+    if ([object isKindOfClass:[GNESectionedTableViewSnapshot class]] == NO)
+    {
+        return NO;
+    }
+    
+    GNESectionedTableViewSnapshot *snapshot = (GNESectionedTableViewSnapshot *)object;
+    
+    return ([self.sectionIdentifiers isEqualToArray:snapshot.sectionIdentifiers] &&
+            [self.rowIdentifiers isEqualToArray:snapshot.rowIdentifiers]);
+}
+
+
+- (NSUInteger)hash
+{
+    return self.sectionIdentifiers.hash ^ self.rowIdentifiers.hash;
+}
+
+
+- (NSString *)description
+{
+    NSMutableString *description = [NSMutableString stringWithFormat:@"<%@: %p>",
+                                    NSStringFromClass([self class]), self];
+    
+    NSUInteger sectionCount = self.numberOfSections;
+    for (NSUInteger section = 0; section < sectionCount; section++)
+    {
+        [description appendFormat:@"\n%@: %@", self.sectionIdentifiers[section],
+         [self.rowIdentifiers[section] componentsJoinedByString:@", "]];
+    }
+    
+    return [description copy];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - NSCopying
+// ------------------------------------------------------------------------------------------
+- (instancetype)copyWithZone:(NSZone * __unused)zone
+{
+    // Snapshots are immutable.
+    return self;
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Sections
+// ------------------------------------------------------------------------------------------
+- (NSUInteger)numberOfSections
+{
+    return self.sectionIdentifiers.count;
+}
+
+
+- (NSUInteger)numberOfRowsInSection:(NSUInteger)section
+{
+    return ((NSArray *)self.rowIdentifiers[section]).count;
+}
+
+
+- (NSArray *)rowIdentifiersInSection:(NSUInteger)section
+{
+    return self.rowIdentifiers[section];
+}
+
+
+- (NSUInteger)sectionForSectionIdentifier:(id)identifier
+{
+    NSNumber *section = (identifier) ? self.sectionIdentifierToSectionMap[identifier] : nil;
+    
+    return (section) ? section.unsignedIntegerValue : NSNotFound;
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Rows
+// ------------------------------------------------------------------------------------------
+- (id)rowIdentifierAtIndexPath:(NSIndexPath *)indexPath
+{
+    if (indexPath == nil || indexPath.length != 2)
+    {
+        return nil;
+    }
+    
+    NSUInteger section = indexPath.gne_section;
+    NSUInteger row = indexPath.gne_row;
+    if (section >= self.numberOfSections || row >= [self numberOfRowsInSection:section])
+    {
+        return nil;
+    }
+    
+    return self.rowIdentifiers[section][row];
+}
+
+
+- (NSIndexPath *)indexPathForRowIdentifier:(id)identifier
+{
+    return (identifier) ? self.rowIdentifierToIndexPathMap[identifier] : nil;
+}
+
+
+@end
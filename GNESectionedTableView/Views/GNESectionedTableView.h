@@ -31,8 +31,14 @@
 
 @import Cocoa;
 #import "GNEOutlineViewItem.h"
+#import "GNEOutlineViewItem+Pasteboard.h"
 #import "GNEOutlineViewParentItem.h"
 #import "GNEOrderedIndexSet.h"
+#import "GNESectionedTableViewSnapshot.h"
+#import "GNESectionedTableViewChangeSet.h"
+#import "GNESectionedTableViewModel.h"
+#import "GNESectionedIndexPath.h"
+#import "GNESectionedTableViewStatistics.h"
 #import "NSMutableArray+GNESectionedTableView.h"
 #import "NSIndexPath+GNESectionedTableView.h"
 #import "NSOutlineView+GNE_Additions.h"
@@ -95,6 +101,14 @@ static const CGFloat GNESectionedTableViewInvisibleRowHeight = 0.00001f;
 static const CGFloat GNESectionedTableViewInvisibleRowHeight = 1.0f;
 #endif
 
+/// Returned from -tableView:uniformHeightForRowsInSection: when the rows in a section have different heights.
+static const CGFloat GNESectionedTableViewNonUniformRowHeight = -1.0f;
+
+/// Block that returns the height of the row at the specified index path when the row is as wide as the
+/// specified width. Called concurrently on background queues, so it must be thread-safe and must not
+/// access the table view or any other views.
+typedef CGFloat (^GNESectionedTableViewRowHeightMeasuringBlock)(GNESectionedIndexPath indexPath, CGFloat width);
+
 
 // ------------------------------------------------------------------------------------------
 
@@ -162,6 +176,53 @@ didDragRowsAtIndexPaths:(NSArray * __nonnull)fromIndexPaths
 @optional
 - (void)tableViewDraggingSessionDidEnd:(GNESectionedTableView * __nonnull)tableView;
 
+/* Prefetching */
+/**
+ Asks the data source to start loading the data of the rows at the specified index paths, which are
+ about to be scrolled into view.
+ 
+ @discussion While the table view is scrolled, the rows ahead of the visible rows, in the direction of
+ the scroll, are prefetched. The faster the table view is scrolled, the further ahead rows are
+ prefetched, up to a few screens. The rows that come into range while the table view is scrolled are
+ collected and passed in a single call at most once per run loop iteration, nearest row first. Each
+ row is only passed again after it was scrolled into view or its prefetching was cancelled.
+ @param tableView Table view requesting the rows.
+ @param indexPaths Index paths of the rows to prefetch, sorted by their distance from the visible rows.
+ */
+@optional
+- (void)tableView:(GNESectionedTableView * __nonnull)tableView prefetchRowsAtIndexPaths:(NSArray * __nonnull)indexPaths;
+/**
+ Tells the data source that the rows at the specified index paths, which were passed to
+ -tableView:prefetchRowsAtIndexPaths:, are no longer needed, because the scroll direction was reversed
+ or they fell out of the prefetched range before they were scrolled into view.
+ */
+@optional
+-                    (void)tableView:(GNESectionedTableView * __nonnull)tableView
+cancelPrefetchingForRowsAtIndexPaths:(NSArray * __nonnull)indexPaths;
+
+/* Streaming */
+/**
+ Called on the main thread right before the rows appended with -appendRows:toSection: are inserted.
+ 
+ @discussion When this method returns, the number of rows the data source reports for the section must
+ have grown by the specified number of rows and, if rows are evicted, the specified number of rows must
+ have been removed from the front of the section. Data sources that are fed from other threads can
+ collect new rows in a buffer and move the specified number of them into the rows they report here.
+ This method isn't called for rows that are discarded while they are queued (see
+ -[GNESectionedTableView appendRows:toSection:]). This method is required if the table view's
+ maximumNumberOfRowsPerSection is set.
+ @param tableView Table view the rows are appended to.
+ @param count Number of rows appended to the end of the section.
+ @param section Section the rows are appended to.
+ @param evictedCount Number of rows removed from the front of the section, counted after the new rows
+ were appended, so that the section doesn't exceed the table view's maximumNumberOfRowsPerSection.
+ */
+@optional
+- (void)tableView:(GNESectionedTableView * __nonnull)tableView
+   willAppendRows:(NSUInteger)count
+        toSection:(NSUInteger)section
+     evictingRows:(NSUInteger)evictedCount;
+
 @end
 
 
@@ -171,24 +232,107 @@ didDragRowsAtIndexPaths:(NSArray * __nonnull)fromIndexPaths
 @protocol GNESectionedTableViewDelegate <NSObject>
 
 /* Sizing */
-@required
+@optional
+/// Required unless -tableView:heightForRowAtSectionedIndexPath: is implemented.
 -       (CGFloat)tableView:(GNESectionedTableView * __nonnull)tableView
    heightForRowAtIndexPath:(NSIndexPath * __nonnull)indexPath;
 @optional
+/// Called instead of -tableView:heightForRowAtIndexPath: if implemented, without allocating an index path.
+-                (CGFloat)tableView:(GNESectionedTableView * __nonnull)tableView
+   heightForRowAtSectionedIndexPath:(GNESectionedIndexPath)indexPath;
+@optional
 /// Required if the table view includes headers.
 - (CGFloat)tableView:(GNESectionedTableView * __nonnull)tableView heightForHeaderInSection:(NSUInteger)section;
 @optional
 /// Required if the table view includes footers.
 - (CGFloat)tableView:(GNESectionedTableView * __nonnull)tableView heightForFooterInSection:(NSUInteger)section;
+@optional
+/**
+ Returns the height shared by every row in the specified section, or GNESectionedTableViewNonUniformRowHeight
+ if the rows in the section have different heights.
+ 
+ @discussion If a uniform height is returned, the table view doesn't ask for the heights of the section's
+ rows individually. The heights of section headers and footers are unaffected.
+ */
+-             (CGFloat)tableView:(GNESectionedTableView * __nonnull)tableView
+  uniformHeightForRowsInSection:(NSUInteger)section;
+@optional
+/**
+ Fills the specified buffer with the heights of the rows in the specified range of the specified section.
+ 
+ @discussion If implemented, the table view calls this method instead of -tableView:heightForRowAtIndexPath:
+ whenever it needs the heights of rows, such as when it reloads its data or inserts rows. The height of
+ the row at index range.location + i must be stored in heights[i].
+ @param heights Buffer with room for range.length heights.
+ @param range Range of the rows to measure.
+ @param section Section containing the rows.
+ */
+- (void)tableView:(GNESectionedTableView * __nonnull)tableView
+       getHeights:(CGFloat * __nonnull)heights
+   forRowsInRange:(NSRange)range
+        inSection:(NSUInteger)section;
+@optional
+/**
+ Returns a block that measures the heights of rows on background queues, or nil to measure them on the
+ main thread with the methods above.
+ 
+ @discussion If a block is returned, the rows of sections without a uniform height are measured
+ concurrently on background queues instead of with -tableView:heightForRowAtIndexPath: and
+ -tableView:getHeights:forRowsInRange:inSection:. Each measurement works on a snapshot of the index
+ paths of the rows to measure and the width of the table view taken on the main thread. Until their
+ heights have been measured, rows are as tall as their estimated heights (see
+ -tableView:estimatedHeightForRowAtIndexPath:) or the table view's estimatedRowHeight. The measured
+ heights are committed on the main thread, one section at a time, and passed to
+ -noteHeightOfRowsWithIndexesChanged:. If rows are inserted into or deleted from a section while its
+ rows are being measured, the heights of the measured rows that still exist are committed at their new
+ rows and only the inserted rows are measured separately. Heights of rows that are reloaded while they
+ are being measured are discarded and the rows are measured again. Section headers and footers are
+ always measured on the main thread.
+ */
+- (GNESectionedTableViewRowHeightMeasuringBlock __nullable)rowHeightMeasuringBlockForTableView:(GNESectionedTableView * __nonnull)tableView;
+@optional
+/**
+ Returns an estimate of the height of the specified row.
+ 
+ @discussion If this method or -tableView:estimatedHeightForRowsInSection: is implemented, the rows of
+ sections without a uniform height start out with their estimated heights, and the table view only asks
+ for their actual heights once they come within one visible height of the visible rows or are scrolled
+ to with -scrollRowAtIndexPathToVisible:. When estimates are replaced with actual heights, the table
+ view scrolls so that the topmost visible row keeps its position on screen. Rows that are measured on
+ background queues (see -rowHeightMeasuringBlockForTableView:) also start out with their estimated heights.
+ */
+-                (CGFloat)tableView:(GNESectionedTableView * __nonnull)tableView
+   estimatedHeightForRowAtIndexPath:(NSIndexPath * __nonnull)indexPath;
+@optional
+/// Called instead of -tableView:estimatedHeightForRowAtIndexPath: if implemented, without allocating an
+/// index path.
+-                         (CGFloat)tableView:(GNESectionedTableView * __nonnull)tableView
+   estimatedHeightForRowAtSectionedIndexPath:(GNESectionedIndexPath)indexPath;
+@optional
+/// Returns an estimate of the height of every row in the specified section. Called instead of
+/// -tableView:estimatedHeightForRowAtIndexPath: and -tableView:estimatedHeightForRowAtSectionedIndexPath:
+/// if implemented.
+-              (CGFloat)tableView:(GNESectionedTableView * __nonnull)tableView
+  estimatedHeightForRowsInSection:(NSUInteger)section;
 
 /* Views */
-@required
+@optional
+/// Required unless -tableView:rowViewForRowAtSectionedIndexPath: is implemented.
 - (NSTableRowView * __nonnull)tableView:(GNESectionedTableView * __nonnull)tableView
                rowViewForRowAtIndexPath:(NSIndexPath * __nonnull)indexPath;
-@required
+@optional
+/// Called instead of -tableView:rowViewForRowAtIndexPath: if implemented.
+- (NSTableRowView * __nonnull)tableView:(GNESectionedTableView * __nonnull)tableView
+      rowViewForRowAtSectionedIndexPath:(GNESectionedIndexPath)indexPath;
+@optional
+/// Required unless -tableView:cellViewForRowAtSectionedIndexPath: is implemented.
 - (NSTableCellView * __nonnull)tableView:(GNESectionedTableView * __nonnull)tableView
                cellViewForRowAtIndexPath:(NSIndexPath * __nonnull)indexPath;
 @optional
+/// Called instead of -tableView:cellViewForRowAtIndexPath: if implemented, without allocating an index path.
+- (NSTableCellView * __nonnull)tableView:(GNESectionedTableView * __nonnull)tableView
+      cellViewForRowAtSectionedIndexPath:(GNESectionedIndexPath)indexPath;
+@optional
 /// Required if the table view includes headers.
 - (NSTableRowView * __nonnull)tableView:(GNESectionedTableView * __nonnull)tableView
               rowViewForHeaderInSection:(NSUInteger)section;
@@ -217,6 +361,11 @@ didDragRowsAtIndexPaths:(NSArray * __nonnull)fromIndexPaths
 didDisplayRowView:(NSTableRowView * __nonnull)rowView
 forRowAtIndexPath:(NSIndexPath * __nonnull)indexPath;
 @optional
+/// Called instead of -tableView:didDisplayRowView:forRowAtIndexPath: if implemented.
+-            (void)tableView:(GNESectionedTableView * __nonnull)tableView
+           didDisplayRowView:(NSTableRowView * __nonnull)rowView
+  forRowAtSectionedIndexPath:(GNESectionedIndexPath)indexPath;
+@optional
 -       (void)tableView:(GNESectionedTableView * __nonnull)tableView
 didEndDisplayingRowView:(NSTableRowView * __nonnull)rowView
      forHeaderInSection:(NSUInteger)section;
@@ -228,6 +377,11 @@ didEndDisplayingRowView:(NSTableRowView * __nonnull)rowView
 -       (void)tableView:(GNESectionedTableView * __nonnull)tableView
 didEndDisplayingRowView:(NSTableRowView * __nonnull)rowView
       forRowAtIndexPath:(NSIndexPath * __nonnull)indexPath;
+@optional
+/// Called instead of -tableView:didEndDisplayingRowView:forRowAtIndexPath: if implemented.
+-          (void)tableView:(GNESectionedTableView * __nonnull)tableView
+   didEndDisplayingRowView:(NSTableRowView * __nonnull)rowView
+forRowAtSectionedIndexPath:(GNESectionedIndexPath)indexPath;
 
 /* Expand/Collapse */
 @optional
@@ -253,6 +407,23 @@ didEndDisplayingRowView:(NSTableRowView * __nonnull)rowView
 -                   (void)tableView:(GNESectionedTableView * __nonnull)tableView
   proposedSelectedHeadersInSections:(NSIndexSet * __nonnull * __nonnull)sectionIndexes
       proposedSelectedRowIndexPaths:(NSArray * __nonnull * __nonnull)indexPaths;
+/**
+ Returns the rows of the specified section that may be selected, out of the specified proposed rows.
+ 
+ @discussion The proposed selection is passed to this method once per section, as ranges of rows,
+ so that selecting all of the rows of large sections doesn't require a call per row. If this method
+ is implemented, tableView:shouldSelectRowAtIndexPath: and
+ tableView:proposedSelectedHeadersInSections:proposedSelectedRowIndexPaths: aren't called.
+ tableView:shouldSelectHeaderInSection: is still called for every proposed section header.
+ @param tableView Table view whose selection is changing.
+ @param rows Proposed rows of the section. Section footers are never proposed.
+ @param section Section containing the proposed rows.
+ @return Rows that may be selected, which should be a subset of the proposed rows.
+ */
+@optional
+- (NSIndexSet * __nonnull)tableView:(GNESectionedTableView * __nonnull)tableView
+      selectableRowsForProposedRows:(NSIndexSet * __nonnull)rows
+                          inSection:(NSUInteger)section;
 @optional
 - (void)tableView:(GNESectionedTableView * __nonnull)tableView didClickHeaderInSection:(NSUInteger)section;
 @optional
@@ -311,9 +482,23 @@ didSelectRowAtIndexPath:(NSIndexPath * __nonnull)indexPath;
  */
 @property (nonatomic, strong, readonly, nonnull) NSArray *selectedIndexPaths;
 
-/// Returns YES if the table view is in an -beginUpdate/-endUpdates block, otherwise NO.
+/// Returns YES if the table view is in an -beginUpdate/-endUpdates block or in the updates block of
+/// -performBatchUpdates:completion:, otherwise NO.
 @property (nonatomic, assign, readonly) BOOL isUpdating;
 
+/// Height of rows whose heights are being measured on background queues (see
+/// -rowHeightMeasuringBlockForTableView:), unless the delegate estimates their heights. Default: 32.0.
+@property (nonatomic, assign) CGFloat estimatedRowHeight;
+
+/// Maximum number of rows a section can contain after rows are appended with -appendRows:toSection:.
+/// Once a section is full, appending rows evicts the same number of rows from its front. 0 means no
+/// maximum. Default: 0.
+@property (nonatomic, assign) NSUInteger maximumNumberOfRowsPerSection;
+
+/// YES if the table view keeps its last row visible while rows are appended with -appendRows:toSection:,
+/// as long as it was scrolled to the end before they were appended, otherwise NO. Default: NO.
+@property (nonatomic, assign) BOOL pinsToTail;
+
 
 #pragma mark - Initialization
 /**
@@ -434,6 +619,21 @@ didSelectRowAtIndexPath:(NSIndexPath * __nonnull)indexPath;
 
 
 #pragma mark - Insertion, Deletion, Move, and Update
+/**
+ Performs the insertions, deletions, moves, and reloads requested in the specified block as a single
+ update.
+ 
+ @discussion Instead of being applied one by one, the updates requested in the block are collected and
+ normalized, then applied to the model and the outline view in one pass inside a single
+ -beginUpdates/-endUpdates transaction. Inserted sections are expanded, row views are remapped, and the
+ data source is checked once, at the end. As with UITableView, deletions, reloads, and the sources of
+ moves use the index paths from before the batch, while insertions and the destinations of moves use
+ the index paths from after it. Moved rows and sections are deleted and reinserted without the
+ animation of their cell views. Batches can be nested, in which case they are part of the outermost batch.
+ @param updates Block requesting the updates. The data source must reflect all of them by the end of the block.
+ @param completion Block called after the updates have been applied and the outermost batch has ended.
+ */
+- (void)performBatchUpdates:(void (^ __nullable)(void))updates completion:(void (^ __nullable)(void))completion;
 - (void)insertRowsAtIndexPaths:(NSArray * __nonnull)indexPaths
                  withAnimation:(NSTableViewAnimationOptions)animationOptions;
 - (void)deleteRowsAtIndexPaths:(NSArray * __nonnull)indexPaths
@@ -447,6 +647,14 @@ didSelectRowAtIndexPath:(NSIndexPath * __nonnull)indexPath;
  order of the rows.
  */
 - (void)moveRowsAtIndexPaths:(NSArray * __nonnull)fromIndexPaths toIndexPath:(NSIndexPath * __nonnull)toIndexPath;
+/**
+ Reloads the row and cell views of the rows at the specified index paths.
+ 
+ @discussion The index paths are converted to table view rows in a single pass and the visible ones are
+ reloaded with a single call to -reloadDataForRowIndexes:columnIndexes:. Rows that aren't visible aren't
+ reloaded right away. Their views are requested again when they are scrolled into view, so reloading many
+ rows that are mostly off screen is cheap.
+ */
 - (void)reloadRowsAtIndexPaths:(NSArray * __nonnull)indexPaths;
 
 /// Inserts the specified sections with the specified animation and expands them.
@@ -473,6 +681,40 @@ didSelectRowAtIndexPath:(NSIndexPath * __nonnull)indexPath;
 - (void)moveSections:(GNEOrderedIndexSet * __nonnull)fromSections toSection:(NSUInteger)toSection;
 
 - (void)reloadSections:(NSIndexSet * __nonnull)sections;
+/**
+ Applies the insertions, deletions, and moves contained in the specified change set in a single
+ update while keeping the selection and the expanded or collapsed state of the sections.
+ 
+ @discussion The data source must already reflect the change set's new snapshot when this method is
+ called. Moved sections and rows are deleted and reinserted (like -moveSections:toSections: and
+ -moveRowsAtIndexPaths:toIndexPaths: do), but without the animation of their cell views.
+ @param changeSet Change set computed from the snapshots of the table view's old and new contents.
+ @param animationOptions Animation used for the insertions and deletions.
+ */
+- (void)applyChangeSet:(GNESectionedTableViewChangeSet * __nonnull)changeSet
+         withAnimation:(NSTableViewAnimationOptions)animationOptions;
+
+
+#pragma mark - Streaming
+/**
+ Appends the specified number of rows to the end of the specified section without waiting for the
+ table view. Can be called from any thread.
+ 
+ @discussion Appended rows are queued and inserted on the main thread at most once per display refresh,
+ so that any number of rows appended between two refreshes are inserted as a single batch update. Right
+ before they are inserted, the data source's -tableView:willAppendRows:toSection:evictingRows: is called.
+ Sections that are full evict rows from their front (see maximumNumberOfRowsPerSection). The rows that
+ stay visible keep their position on screen, unless the table view is pinned to its end (see pinsToTail).
+ Queued rows follow their sections when sections are inserted, deleted, or moved. Rows that are still
+ queued when their section is deleted or the table view's data is reloaded are discarded, and the data
+ source must discard the rows it buffered for them as well.
+ @param count Number of rows to append.
+ @param section Section to append the rows to.
+ */
+- (void)appendRows:(NSUInteger)count toSection:(NSUInteger)section;
+/// Inserts the rows queued with -appendRows:toSection: right away instead of at the next display refresh.
+/// Must be called on the main thread.
+- (void)flushAppendedRows;
 
 
 #pragma mark - Expand/Collapse Sections
@@ -489,6 +731,20 @@ didSelectRowAtIndexPath:(NSIndexPath * __nonnull)indexPath;
 - (BOOL)isIndexPathSelected:(NSIndexPath * __nonnull)indexPath;
 - (void)selectRowAtIndexPath:(NSIndexPath * __nullable)indexPath byExtendingSelection:(BOOL)extend;
 - (void)selectRowsAtIndexPaths:(NSArray * __nullable)indexPaths byExtendingSelection:(BOOL)extend;
+/// Selects the headers of the specified sections. O(s) for s sections
+- (void)selectHeadersInSections:(NSIndexSet * __nonnull)sections byExtendingSelection:(BOOL)extend;
+/**
+ Selects the rows in the specified range of each section in the specified range of sections, e.g.,
+ rows 0..<N of sections A..<B.
+ 
+ @discussion Rows beyond the end of a section are ignored, as are the rows of collapsed sections,
+ which aren't displayed. Section footers are never selected. The selection is built from one range
+ of table view rows per section, so it takes O(s) time for s sections regardless of the number of rows.
+ @param rows Range of rows to select in each section.
+ @param sections Range of sections whose rows should be selected.
+ @param extend YES to add the rows to the current selection, NO to replace it.
+ */
+- (void)selectRowsInRange:(NSRange)rows ofSectionsInRange:(NSRange)sections byExtendingSelection:(BOOL)extend;
 
 
 #pragma mark - Layout Support
@@ -507,7 +763,7 @@ didSelectRowAtIndexPath:(NSIndexPath * __nonnull)indexPath;
  
  @discussion As with the rest of this project, this method assumes that the table view only has one
  column. If the table view has more than one column, this method returns the frame for the last
- column in the row.
+ column in the row. The frame is calculated from the row heights cached by the table view in O(lg n).
  @param indexPath Index path for the section header or row.
  @return Frame of the view at the specified index path in the coordinate space of the table view.
  */
@@ -523,9 +779,36 @@ didSelectRowAtIndexPath:(NSIndexPath * __nonnull)indexPath;
 - (CGRect)frameOfSection:(NSUInteger)section;
 
 
+/**
+ Informs the table view that the heights of the section headers, rows, or section footers at the
+ specified index paths have changed.
+ 
+ @discussion The table view caches the heights returned by its delegate and only asks for them again
+ when the rows are reloaded, inserted, or passed to this method or to
+ -noteHeightOfRowsWithIndexesChanged:. Unlike -noteHeightOfRowsWithIndexesChanged:, this method also
+ updates the heights of rows in collapsed sections.
+ @param indexPaths Index paths of the section headers, rows, or section footers whose heights have changed.
+ */
+- (void)noteHeightOfRowsAtIndexPathsChanged:(NSArray * __nonnull)indexPaths;
+
+
 #pragma mark - Scrolling
 - (void)scrollRowAtIndexPathToVisible:(NSIndexPath * __nonnull)indexPath;
 
+#pragma mark - Statistics
+/**
+ Returns a snapshot of the table view's hot-path performance counters, which count delegate and data
+ source callouts, index path resolutions and allocations, and row view map rebuilds, and time
+ update transactions.
+ 
+ @discussion The counters are only recorded if GNE_STATISTICS_ENABLED is defined as 1 when the
+ library is compiled. Otherwise, they aren't compiled in at all and this method returns nil.
+ @return Counters recorded since the table view was created or -resetStatistics was last called.
+ */
+- (GNESectionedTableViewStatistics * __nullable)statistics;
+/// Resets the table view's performance counters. Does nothing if GNE_STATISTICS_ENABLED is 0.
+- (void)resetStatistics;
+
 #pragma mark - Unavailable
 @property (nullable, weak) id <NSOutlineViewDelegate> delegate NS_UNAVAILABLE;
 @property (nullable, weak) id <NSOutlineViewDataSource> dataSource NS_UNAVAILABLE;
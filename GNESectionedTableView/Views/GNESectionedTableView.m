@@ -33,7 +33,14 @@
 #import "NSOutlineView+GNE_Additions.h"
 
 #import "GNEOutlineViewItem.h"
+#import "GNEOutlineViewItem+Pasteboard.h"
 #import "GNEOutlineViewParentItem.h"
+#import "GNEOutlineViewItemArray.h"
+#import "GNESectionedTableViewModel.h"
+#import "GNESectionedTableViewBatchUpdate.h"
+#import "GNESectionedTableViewAppendQueue.h"
+
+#import "GNEPrefixSumArray.h"
 
 #import "GNESectionedTableViewMove.h"
 #import "GNESectionedTableViewMovingItem.h"
@@ -50,10 +57,37 @@ static NSString * const kOutlineViewStandardHeaderRowViewIdentifier =
 static NSString * const kOutlineViewStandardHeaderCellViewIdentifier =
                                                         @"com.goneeast.OutlineViewStandardHeaderCellViewIdentifier";
 
+static NSString * const kMemoryAllocationAssertionName = @"Memory Allocation Failure";
+static NSString * const kMemoryAllocationAssertionReason = @"Calloc failed";
+
 static const CGFloat kDefaultRowHeight = 32.0f;
 
-static const NSUInteger kSectionHeaderRowModifier = 1;
-static const NSUInteger kSectionFooterRowModifier = 2;
+/// Rows that will be scrolled into view within this interval at the current scroll speed are prefetched.
+static const CFTimeInterval kPrefetchLookaheadInterval = 0.5;
+/// Minimum and maximum distance ahead of the visible rows, in multiples of the visible height, in
+/// which rows are prefetched.
+static const CGFloat kMinimumPrefetchDistance = 1.0f;
+static const CGFloat kMaximumPrefetchDistance = 4.0f;
+/// Scrolls that are further apart than this interval don't contribute to the scroll speed.
+static const CFTimeInterval kMaximumScrollSpeedInterval = 0.25;
+
+/// Number of rows measured in a row on a background queue by a single iteration of dispatch_apply().
+static const NSUInteger kRowHeightMeasurementBatchSize = 64;
+
+/// Rows with estimated heights within this distance of the visible rows, in multiples of the visible height,
+/// are measured.
+static const CGFloat kEstimatedRowMeasurementDistance = 1.0f;
+/// Maximum number of times the rows near the visible rows are measured in a row. Replacing estimates can
+/// bring more rows with estimated heights near the visible rows.
+static const NSUInteger kMaximumEstimatedRowMeasurementPasses = 8;
+
+/// Rows within this distance of the visible rows, in multiples of the visible height, keep their outline view
+/// items. This is the largest distance in which rows are prefetched.
+static const CGFloat kOutlineViewItemRetentionDistance = 4.0f;
+/// Recycling the outline view items of a section reloads its visible rows, so the items of a section near
+/// the visible rows are only recycled once at least this many of them, and at least as many as are kept,
+/// are further away.
+static const NSUInteger kMinimumRecycledOutlineViewItemCount = 256;
 
 typedef NS_ENUM(NSUInteger, GNEDragType)
 {
@@ -70,32 +104,137 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 };
 
 
+/// How the heights of the rows of a section are measured.
+typedef NS_ENUM(NSUInteger, GNERowHeightMeasurement)
+{
+    /// The table view delegate is asked for the heights of the rows right away.
+    GNERowHeightMeasurementImmediate = 0,
+    /// The rows are estimated and measured on background queues with the delegate's measuring block.
+    GNERowHeightMeasurementAsynchronous,
+    /// The rows are estimated and measured when they come near the visible rows.
+    GNERowHeightMeasurementEstimated
+};
+
+
+/// Delegate methods taking GNESectionedIndexPath that the table view delegate implements. They are
+/// checked once in -setTableViewDelegate: instead of on every call.
+typedef struct
+{
+    unsigned int heightForRow : 1;
+    unsigned int estimatedHeightForRow : 1;
+    unsigned int rowViewForRow : 1;
+    unsigned int cellViewForRow : 1;
+    unsigned int didDisplayRowView : 1;
+    unsigned int didEndDisplayingRowView : 1;
+} GNEDelegateSectionedIndexPathMethods;
+
+
 // ------------------------------------------------------------------------------------------
 
 
 @interface GNESectionedTableView () <NSOutlineViewDataSource, NSOutlineViewDelegate, GNEOutlineViewItemPasteboardWritingDelegate>
 
 
-/// Array of outline view parent items that map to the table view's sections.
-@property (nonatomic, strong) NSMutableArray *outlineViewParentItems;
+/// Sections, rows, and footers of the table view represented by outline view items.
+@property (nonatomic, strong) GNESectionedTableViewModel *model;
 
-/// Array of arrays of outline view items that map to the table view's rows.
-@property (nonatomic, strong) NSMutableArray *outlineViewItems;
+/// Heights of the table view's sections indexed by section. The height of a section includes its header
+/// and, if the section is expanded, its rows and footer, as well as the intercell spacing of all of them.
+@property (nonatomic, strong) GNEPrefixSumArray *sectionHeights;
 
 @property (nonatomic, strong) NSMutableArray *selectedAutoCollapsedIndexPaths;
 @property (nonatomic, strong) NSMutableIndexSet *autoCollapsedSections;
 
 @property (nonatomic, strong) NSMutableIndexSet *insertedSectionsToExpand;
 
-@property (nonatomic, strong) NSMutableDictionary *rowViewToIndexPathMap;
+/// Maps row views (weak, compared by pointer) to their current index paths.
+@property (nonatomic, strong) NSMapTable *rowViewToIndexPathMap;
+
+/// The first section whose header, rows, and footer were shifted by an update that hasn't yet
+/// been applied to rowViewToIndexPathMap, or NSNotFound.
+@property (nonatomic, assign) NSUInteger firstShiftedSection;
+
+/// Maps sections (before firstShiftedSection) to the first row that was shifted by an update
+/// that hasn't yet been applied to rowViewToIndexPathMap.
+@property (nonatomic, strong) NSMutableDictionary *firstShiftedRowsBySection;
 
 /// Move that is initialized in -outlineView:draggingSession:willBeginAtPoint:forItems:
 /// and cleared in -outlineView:draggingSession:endedAtPoint:operation:.
 @property (nonatomic, strong) GNESectionedTableViewMove *currentMove;
 
+/// Row numbers whose click actions were delayed with -performSelector:withObject:afterDelay: to wait
+/// for a double click and haven't been performed or cancelled yet.
+@property (nonatomic, strong) NSMutableArray *delayedClickRowNumbers;
+
 /// Incremented in -beginUpdates and decremented in -endUpdates.
 @property (atomic, assign) NSUInteger updateCount;
 
+/// Fast-path delegate methods implemented by the table view delegate.
+@property (nonatomic, assign) GNEDelegateSectionedIndexPathMethods delegateMethods;
+
+/// Set when NSOutlineView's selection changes without going through the selection methods overridden
+/// below, and cleared when the model's selection is rebuilt from it in -p_updateSelectionIfNeeded.
+/// The model keeps its selection in sync with insertions and deletions by itself.
+@property (nonatomic, assign) BOOL selectionNeedsUpdate;
+
+/// Incremented in -p_beginSelectionChange and decremented in -p_endSelectionChange.
+@property (nonatomic, assign) NSUInteger selectionChangeCount;
+
+/// NSOutlineView's selected rows that the model's selection was last brought in sync with while one of
+/// the overridden selection methods changes them, otherwise nil.
+@property (nonatomic, copy) NSIndexSet *previouslySelectedRows;
+
+/// Collects the updates requested in the block passed to -performBatchUpdates:completion:, or nil
+/// outside of that block.
+@property (nonatomic, strong) GNESectionedTableViewBatchUpdate *batchUpdate;
+
+/// Completion blocks of the outermost batch update and the batch updates nested in it.
+@property (nonatomic, strong) NSMutableArray *batchUpdateCompletions;
+
+/// Outline view items (weak) that were reloaded while their row views were prepared but not visible.
+/// Their row views are reloaded when they are scrolled into view, unless AppKit replaces them first.
+@property (nonatomic, strong) NSHashTable *staleItems;
+
+/// Row items (weak) that the data source was asked to prefetch and that haven't been scrolled into view
+/// or cancelled yet.
+@property (nonatomic, strong) NSHashTable *prefetchedItems;
+
+/// Origin of the visible rect and time when the prefetched rows were last updated.
+@property (nonatomic, assign) CGFloat prefetchOriginY;
+@property (nonatomic, assign) CFTimeInterval prefetchTimestamp;
+
+/// 1 if the table view was last scrolled down, -1 if it was scrolled up, or 0.
+@property (nonatomic, assign) NSInteger prefetchDirection;
+
+/// YES if the prefetched rows are updated at the end of the current run loop iteration.
+@property (nonatomic, assign) BOOL prefetchUpdateScheduled;
+
+/// Rows appended with -appendRows:toSection: that haven't been inserted yet.
+@property (nonatomic, strong) GNESectionedTableViewAppendQueue *appendQueue;
+
+/// Outline view parent items (weak) whose unmeasured rows are measured on a background queue once the
+/// current run loop iteration ends.
+@property (nonatomic, strong) NSHashTable *parentItemsNeedingRowHeightMeasurement;
+
+/// YES if -p_measureUnmeasuredRows is scheduled on the main queue.
+@property (nonatomic, assign) BOOL rowHeightMeasurementScheduled;
+
+/// YES if the estimated rows near the visible rows are measured at the end of the current run loop iteration.
+@property (nonatomic, assign) BOOL estimatedRowMeasurementScheduled;
+
+/// Outline view parent items (weak) of the sections NSOutlineView asked for rows of, whose outline view items
+/// are recycled once they are far from the visible rows.
+@property (nonatomic, strong) NSHashTable *parentItemsWithOutlineViewItems;
+
+/// YES if the outline view items far from the visible rows are recycled at the end of the current run loop
+/// iteration.
+@property (nonatomic, assign) BOOL outlineViewItemRecyclingScheduled;
+
+#if GNE_STATISTICS_ENABLED
+/// Performance counters returned by -statistics. Shared with the model.
+@property (nonatomic, strong) GNESectionedTableViewStatisticsRecorder *statisticsRecorder;
+#endif
+
 @end
 
 
@@ -148,17 +287,38 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 
 - (void)p_commonInitialization
 {
-    _outlineViewParentItems = [NSMutableArray array];
-    _outlineViewItems = [NSMutableArray array];
+    _model = [GNESectionedTableViewModel model];
+#if GNE_STATISTICS_ENABLED
+    _statisticsRecorder = [[GNESectionedTableViewStatisticsRecorder alloc] init];
+    _model.statisticsRecorder = _statisticsRecorder;
+#endif
+    _sectionHeights = [GNEPrefixSumArray array];
 
     _autoExpandSections = YES;
+    _estimatedRowHeight = kDefaultRowHeight;
 
     _selectedAutoCollapsedIndexPaths = [NSMutableArray array];
     _autoCollapsedSections = [NSMutableIndexSet indexSet];
     
     _insertedSectionsToExpand = [NSMutableIndexSet indexSet];
+    _delayedClickRowNumbers = [NSMutableArray array];
+    
+    NSPointerFunctionsOptions keyOptions = (NSPointerFunctionsWeakMemory |
+                                            NSPointerFunctionsObjectPointerPersonality);
+    _rowViewToIndexPathMap = [NSMapTable mapTableWithKeyOptions:keyOptions
+                                                   valueOptions:NSPointerFunctionsStrongMemory];
+    _firstShiftedSection = NSNotFound;
+    _firstShiftedRowsBySection = [NSMutableDictionary dictionary];
+    _staleItems = [NSHashTable weakObjectsHashTable];
+    _prefetchedItems = [NSHashTable weakObjectsHashTable];
+    _parentItemsNeedingRowHeightMeasurement = [NSHashTable weakObjectsHashTable];
+    _parentItemsWithOutlineViewItems = [NSHashTable weakObjectsHashTable];
     
-    _rowViewToIndexPathMap = [NSMutableDictionary dictionary];
+    __weak typeof(self) weakSelf = self;
+    _appendQueue = [[GNESectionedTableViewAppendQueue alloc] initWithFlushHandler:^(NSDictionary *rowCountsBySection)
+    {
+        [weakSelf p_insertAppendedRows:rowCountsBySection];
+    }];
     
     super.dataSource = self;
     super.delegate = self;
@@ -198,6 +358,8 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 // ------------------------------------------------------------------------------------------
 - (void)dealloc
 {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+    
     [_rowViewToIndexPathMap removeAllObjects];
     _rowViewToIndexPathMap = nil;
     
@@ -222,6 +384,36 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 }
 
 
+- (void)viewWillMoveToSuperview:(NSView *)newSuperview
+{
+    [super viewWillMoveToSuperview:newSuperview];
+    
+    NSView *superview = self.superview;
+    if ([superview isKindOfClass:[NSClipView class]])
+    {
+        [[NSNotificationCenter defaultCenter] removeObserver:self
+                                                        name:NSViewBoundsDidChangeNotification
+                                                      object:superview];
+    }
+}
+
+
+- (void)viewDidMoveToSuperview
+{
+    [super viewDidMoveToSuperview];
+    
+    NSView *superview = self.superview;
+    if ([superview isKindOfClass:[NSClipView class]])
+    {
+        superview.postsBoundsChangedNotifications = YES;
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(p_clipViewBoundsDidChange:)
+                                                     name:NSViewBoundsDidChangeNotification
+                                                   object:superview];
+    }
+}
+
+
 - (void)setFrameSize:(NSSize)newSize
 {
     [super setFrameSize:newSize];
@@ -229,6 +421,15 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 }
 
 
+- (void)p_clipViewBoundsDidChange:(NSNotification * __unused)notification
+{
+    [self p_reloadStaleVisibleRows];
+    [self p_schedulePrefetchUpdate];
+    [self p_scheduleEstimatedRowMeasurement];
+    [self p_scheduleOutlineViewItemRecycling];
+}
+
+
 // ------------------------------------------------------------------------------------------
 #pragma mark - NSOutlineView
 // ------------------------------------------------------------------------------------------
@@ -241,11 +442,18 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     [strongSelf selectRowIndexes:[NSIndexSet indexSet]
             byExtendingSelection:NO];
     
-    [strongSelf.outlineViewParentItems removeAllObjects];
-    [strongSelf.outlineViewItems removeAllObjects];
+    // Rows that are still queued are discarded without telling the data source, which drops the rows
+    // it buffered for them itself (see -appendRows:toSection:).
+    [strongSelf.appendQueue removeAllRows];
+    [strongSelf.prefetchedItems removeAllObjects];
+    strongSelf.prefetchDirection = 0;
+    [strongSelf.parentItemsNeedingRowHeightMeasurement removeAllObjects];
+    [strongSelf.parentItemsWithOutlineViewItems removeAllObjects];
+    [strongSelf.model removeAllSections];
     [strongSelf p_buildOutlineViewItemArrays];
     
     [super reloadData];
+    [strongSelf p_rebuildSectionHeights];
 
     if (strongSelf.autoExpandSections)
     {
@@ -265,20 +473,64 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     
     if (tableViewRow >= 0)
     {
-        NSIndexSet *rowIndexes = [NSIndexSet indexSetWithIndex:(NSUInteger)tableViewRow];
-        
-        NSUInteger columnCount = (NSUInteger)self.numberOfColumns;
-        NSRange columnRange = NSMakeRange(0, columnCount);
-        NSIndexSet *columnIndexes = [NSIndexSet indexSetWithIndexesInRange:columnRange];
-        
-        [self reloadDataForRowIndexes:rowIndexes
-                        columnIndexes:columnIndexes];
+        [self p_reloadDataForTableViewRows:[NSIndexSet indexSetWithIndex:(NSUInteger)tableViewRow]];
     }
 }
 
 
+/// Re-measures the rows at the specified indexes before NSOutlineView asks for their new heights.
+- (void)noteHeightOfRowsWithIndexesChanged:(NSIndexSet *)indexSet
+{
+    NSMutableArray *items = [NSMutableArray array];
+    [indexSet enumerateIndexesUsingBlock:^(NSUInteger tableViewRow, BOOL *stop __unused)
+    {
+        GNEOutlineViewItem *item = [self itemAtRow:(NSInteger)tableViewRow];
+        if (item)
+        {
+            [items addObject:item];
+        }
+    }];
+    
+    [self p_updateHeightsOfOutlineViewItems:items];
+    
+    [super noteHeightOfRowsWithIndexesChanged:indexSet];
+}
+
+
+- (void)setIntercellSpacing:(NSSize)intercellSpacing
+{
+    [super setIntercellSpacing:intercellSpacing];
+    [self p_rebuildSectionHeights];
+}
+
+
+- (void)selectRowIndexes:(NSIndexSet *)indexes byExtendingSelection:(BOOL)extend
+{
+    [self p_beginSelectionChange];
+    [super selectRowIndexes:indexes byExtendingSelection:extend];
+    [self p_endSelectionChange];
+}
+
+
+- (void)deselectRow:(NSInteger)row
+{
+    [self p_beginSelectionChange];
+    [super deselectRow:row];
+    [self p_endSelectionChange];
+}
+
+
+- (void)deselectAll:(id)sender
+{
+    [self p_beginSelectionChange];
+    [super deselectAll:sender];
+    [self p_endSelectionChange];
+}
+
+
 - (void)beginUpdates
 {
+    GNEStatisticsBeginUpdateTransaction(self.statisticsRecorder);
     self.updateCount++;
     [super beginUpdates];
 }
@@ -293,8 +545,9 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     {
         [self expandSections:self.insertedSectionsToExpand animated:NO];
         [self.insertedSectionsToExpand removeAllIndexes];
-        [self p_updateMapForAvailableRowViews];
+        [self p_updateMapForShiftedRowViews];
     }
+    GNEStatisticsEndUpdateTransaction(self.statisticsRecorder);
 }
 
 
@@ -303,6 +556,19 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 // ------------------------------------------------------------------------------------------
 - (NSIndexPath * __nullable)indexPathForView:(NSView * __nullable)view
 {
+    NSView *rowView = view;
+    while (rowView && [rowView isKindOfClass:[NSTableRowView class]] == NO)
+    {
+        rowView = rowView.superview;
+    }
+    
+    // Mapped index paths are only stale in the middle of an update that shifted them.
+    NSIndexPath *indexPath = [self p_indexPathForRowView:(NSTableRowView *)rowView];
+    if (indexPath && [self p_isIndexPathShifted:indexPath] == NO)
+    {
+        return indexPath;
+    }
+    
     NSInteger tableViewRow = [self rowForView:view];
     
     return [self indexPathForTableViewRow:tableViewRow];
@@ -329,22 +595,15 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 // ------------------------------------------------------------------------------------------
 - (NSUInteger)numberOfSections
 {
-    GNEParameterAssert(self.outlineViewParentItems.count == self.outlineViewItems.count);
-    
-    return self.outlineViewParentItems.count;
+    return self.model.numberOfSections;
 }
 
 
 - (NSUInteger)numberOfRowsInSection:(NSUInteger)section
 {
-    GNEParameterAssert(section < self.outlineViewItems.count);
-    
-    if (section < self.outlineViewItems.count)
-    {
-        return ((NSArray *)self.outlineViewItems[section]).count;
-    }
+    GNEParameterAssert(section < self.model.numberOfSections);
     
-    return NSNotFound;
+    return [self.model numberOfItemsInSection:section];
 }
 
 
@@ -353,84 +612,31 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 // ------------------------------------------------------------------------------------------
 - (BOOL)isIndexPathValid:(NSIndexPath * __nullable)indexPath
 {
-    if (indexPath == nil)
-    {
-        return NO;
-    }
-    
-    NSUInteger sectionCount = self.outlineViewItems.count;
-    if (indexPath.gne_section < sectionCount)
-    {
-        BOOL isSectionHeader = [self isIndexPathHeader:indexPath];
-        BOOL isSectionFooter = [self isIndexPathFooter:indexPath];
-        NSUInteger rowCount = ((NSArray *)self.outlineViewItems[indexPath.gne_section]).count;
-        
-        return (isSectionHeader || isSectionFooter || indexPath.gne_row < rowCount);
-    }
-    
-    return NO;
+    return [self.model isIndexPathValid:indexPath];
 }
 
 
 - (BOOL)isIndexPathHeader:(NSIndexPath * __nullable)indexPath
 {
-    if (indexPath == nil)
-    {
-        return NO;
-    }
-    
-    NSUInteger sectionCount = self.numberOfSections;
-    
-    NSUInteger section = indexPath.gne_section;
-    NSUInteger row = indexPath.gne_row;
-    NSUInteger headerRow = (NSUInteger)(NSNotFound - kSectionHeaderRowModifier);
-    
-    return (section < sectionCount && row == headerRow);
+    return [self.model isIndexPathHeader:indexPath];
 }
 
 
 - (BOOL)isIndexPathFooter:(NSIndexPath * __nullable)indexPath
 {
-    if (indexPath == nil)
-    {
-        return NO;
-    }
-    
-    NSUInteger sectionCount = self.numberOfSections;
-    
-    NSUInteger section = indexPath.gne_section;
-    NSUInteger row = indexPath.gne_row;
-    NSUInteger footerRow = (NSUInteger)(NSNotFound - kSectionFooterRowModifier);
-    
-    return (section < sectionCount && row == footerRow);
+    return [self.model isIndexPathFooter:indexPath];
 }
 
 
 - (NSIndexPath * __nullable)indexPathForHeaderInSection:(NSUInteger)section
 {
-    NSUInteger sectionCount = self.numberOfSections;
-    if (section < sectionCount)
-    {
-        NSUInteger headerRow = (NSUInteger)(NSNotFound - kSectionHeaderRowModifier);
-        
-        return [NSIndexPath gne_indexPathForRow:headerRow inSection:section];
-    }
-    
-    return nil;
+    return [self.model indexPathForHeaderInSection:section];
 }
 
 
 - (NSIndexPath * __nullable)indexPathForFooterInSection:(NSUInteger)section
 {
-    NSUInteger sectionCount = self.numberOfSections;
-    if (section < sectionCount)
-    {
-        NSUInteger footerRow = (NSUInteger)(NSNotFound - kSectionFooterRowModifier);
-        
-        return [NSIndexPath gne_indexPathForRow:footerRow inSection:section];
-    }
-    
-    return nil;
+    return [self.model indexPathForFooterInSection:section];
 }
 
 
@@ -440,7 +646,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     {
         GNEOutlineViewItem *item = [self itemAtRow:row];
 
-        return [self p_indexPathOfOutlineViewItem:item];
+        return [self.model indexPathOfItem:item];
     }
 
     return nil;
@@ -454,7 +660,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
         return -1;
     }
     
-    GNEOutlineViewItem *item = [self p_outlineViewItemAtIndexPath:indexPath];
+    GNEOutlineViewItem *item = [self.model itemAtIndexPath:indexPath];
     
     return [self rowForItem:item];
 }
@@ -463,48 +669,77 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 // ------------------------------------------------------------------------------------------
 #pragma mark - GNESectionedTableView - Public - Insertion, Deletion, Move, and Update
 // ------------------------------------------------------------------------------------------
+- (void)performBatchUpdates:(void (^ __nullable)(void))updates completion:(void (^ __nullable)(void))completion
+{
+    GNEParameterAssert([NSThread isMainThread]);
+    
+    // Nested batches are part of the outermost batch, so their completions wait for it.
+    if (self.batchUpdate)
+    {
+        if (updates)
+        {
+            updates();
+        }
+        if (completion)
+        {
+            [self.batchUpdateCompletions addObject:[completion copy]];
+        }
+        
+        return;
+    }
+    
+    GNESectionedTableViewBatchUpdate *batchUpdate = [[GNESectionedTableViewBatchUpdate alloc] init];
+    self.batchUpdate = batchUpdate;
+    self.batchUpdateCompletions = [NSMutableArray array];
+    
+    if (updates)
+    {
+        updates();
+    }
+    
+    if (completion)
+    {
+        [self.batchUpdateCompletions addObject:[completion copy]];
+    }
+    NSArray *completions = self.batchUpdateCompletions;
+    self.batchUpdate = nil;
+    self.batchUpdateCompletions = nil;
+    
+#if GNE_CRUD_LOGGING_ENABLED
+    NSLog(@"%@\n%@", NSStringFromSelector(_cmd), batchUpdate);
+#endif
+    
+    if (batchUpdate.isEmpty == NO)
+    {
+        [self p_applyBatchUpdate:batchUpdate];
+    }
+    
+    for (void (^aCompletion)(void) in completions)
+    {
+        aCompletion();
+    }
+}
+
+
 - (void)insertRowsAtIndexPaths:(NSArray * __nonnull)indexPaths
                  withAnimation:(NSTableViewAnimationOptions)animationOptions
 {
+    [self p_checkIndexPathsArray:indexPaths];
+    
+    if (self.batchUpdate)
+    {
+        [self.batchUpdate insertRowsAtIndexPaths:indexPaths withAnimation:animationOptions];
+        return;
+    }
+    
 #if GNE_CRUD_LOGGING_ENABLED
     NSLog(@"%@\n%@", NSStringFromSelector(_cmd), indexPaths);
 #endif
     
-    [self p_checkIndexPathsArray:indexPaths];
-    
     NSArray *groupedIndexPaths = [self p_sortedIndexPathsGroupedBySectionInIndexPaths:indexPaths];
     
     [self beginUpdates];
-    for (NSArray *indexPathsInSection in groupedIndexPaths)
-    {
-        @autoreleasepool
-        {
-            NSMutableIndexSet *insertedIndexes = [NSMutableIndexSet indexSet];
-            NSUInteger section = ((NSIndexPath *)indexPathsInSection.firstObject).gne_section;
-            
-            GNEOutlineViewParentItem *parentItem = [self p_outlineViewParentItemForSection:section];
-            GNEAssert1(parentItem, @"No outline view parent item exists for section %lu", (long unsigned)section);
-            
-            if (parentItem == nil)
-            {
-                return;
-            }
-            
-            NSUInteger parentItemIndex = [self.outlineViewParentItems indexOfObject:parentItem];
-            GNEParameterAssert(parentItemIndex < self.outlineViewItems.count);
-            
-            NSMutableArray *rows = self.outlineViewItems[parentItemIndex];
-            
-            for (NSIndexPath *indexPath in indexPathsInSection)
-            {
-                GNEOutlineViewItem *outlineViewItem = [[GNEOutlineViewItem alloc] initWithParentItem:parentItem];
-                outlineViewItem.pasteboardWritingDelegate = self;
-                [insertedIndexes addIndex:[rows gne_insertObject:outlineViewItem atIndex:indexPath.gne_row]];
-            }
-            
-            [self insertItemsAtIndexes:insertedIndexes inParent:parentItem withAnimation:animationOptions];
-        }
-    }
+    [self p_insertRowsAtIndexPathsGroupedBySection:groupedIndexPaths withAnimation:animationOptions];
     [self endUpdates];
     
     [self p_checkDataSourceIntegrity];
@@ -514,67 +749,22 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 - (void)deleteRowsAtIndexPaths:(NSArray * __nonnull)indexPaths
                  withAnimation:(NSTableViewAnimationOptions)animationOptions
 {
+    [self p_checkIndexPathsArray:indexPaths];
+    
+    if (self.batchUpdate)
+    {
+        [self.batchUpdate deleteRowsAtIndexPaths:indexPaths withAnimation:animationOptions];
+        return;
+    }
+    
 #if GNE_CRUD_LOGGING_ENABLED
     NSLog(@"%@\n%@", NSStringFromSelector(_cmd), indexPaths);
 #endif
     
-    [self p_checkIndexPathsArray:indexPaths];
-    
     NSArray *groupedIndexPaths = [self p_reverseSortedIndexPathsGroupedBySectionInIndexPaths:indexPaths];
     
-    NSIndexPath *firstIndexPath = nil;
-    
     [self beginUpdates];
-    for (NSArray *indexPathsInSection in groupedIndexPaths)
-    {
-        firstIndexPath = indexPathsInSection.firstObject;
-        
-        if (firstIndexPath == nil)
-        {
-            continue;
-        }
-        
-        GNEOutlineViewItem *firstItem = [self p_outlineViewItemAtIndexPath:firstIndexPath];
-        
-        if (firstItem == nil)
-        {
-            continue;
-        }
-        
-        GNEOutlineViewParentItem *parentItem = firstItem.parentItem;
-        
-        GNEParameterAssert(parentItem);
-        
-        NSMutableIndexSet *deletedIndexes = [NSMutableIndexSet indexSet];
-        for (NSIndexPath *indexPath in indexPathsInSection)
-        {
-            GNEOutlineViewItem *item = [self p_outlineViewItemAtIndexPath:indexPath];
-            
-            if (item == nil)
-            {
-                continue;
-            }
-
-#if GNE_ASSERT_ENABLED
-            GNEOutlineViewParentItem *actualParentItem = item.parentItem;
-            GNEParameterAssert([actualParentItem isEqual:parentItem]);
-#endif
-            
-#if GNE_CRUD_LOGGING_ENABLED
-            NSIndexPath *actualIndexPath = [self p_indexPathOfOutlineViewItem:item];
-            GNEParameterAssert([actualIndexPath compare:indexPath] == NSOrderedSame);
-#endif
-            
-            // Add the item's index path row to the index set that will be passed to the NSOutlineView.
-            [deletedIndexes addIndex:indexPath.gne_row];
-            
-            // Delete the actual item from the outline view items array.
-            [self.outlineViewItems[indexPath.gne_section] removeObjectAtIndex:indexPath.gne_row];
-        }
-        
-        // Delete the outline view rows with the supplied animation.
-        [self removeItemsAtIndexes:deletedIndexes inParent:parentItem withAnimation:animationOptions];
-    }
+    [self p_deleteRowsAtIndexPathsGroupedBySection:groupedIndexPaths withAnimation:animationOptions];
     [self endUpdates];
     
     [self p_checkDataSourceIntegrity];
@@ -599,7 +789,13 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     [self p_checkIndexPathsArray:fromIndexPaths];
     [self p_checkIndexPathsArray:toIndexPaths];
     
-    if (self.currentMove)
+    if (self.batchUpdate)
+    {
+        // Rows moved in a batch are deleted and reinserted without the animation of their cell views.
+        [self.batchUpdate deleteRowsAtIndexPaths:fromIndexPaths withAnimation:NSTableViewAnimationEffectNone];
+        [self.batchUpdate insertRowsAtIndexPaths:toIndexPaths withAnimation:NSTableViewAnimationEffectNone];
+    }
+    else if (self.currentMove)
     {
         [self.currentMove moveRowsAtIndexPaths:fromIndexPaths toIndexPaths:toIndexPaths];
     }
@@ -667,29 +863,22 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 
 - (void)reloadRowsAtIndexPaths:(NSArray * __nonnull)indexPaths
 {
+    [self p_checkIndexPathsArray:indexPaths];
+    
+    if (self.batchUpdate)
+    {
+        [self.batchUpdate reloadRowsAtIndexPaths:indexPaths];
+        return;
+    }
+    
 #if GNE_CRUD_LOGGING_ENABLED
     NSLog(@"%@\n%@", NSStringFromSelector(_cmd), indexPaths);
 #endif
     
-    [self p_checkIndexPathsArray:indexPaths];
-    
-    NSArray *groupedIndexPaths = [self p_sortedIndexPathsGroupedBySectionInIndexPaths:indexPaths];
+    NSIndexSet *tableViewRows = [self p_indexSetOfTableViewRowsForIndexPaths:indexPaths];
     
     [self beginUpdates];
-    for (NSArray *indexPathsInSection in groupedIndexPaths)
-    {
-        for (NSIndexPath *indexPath in indexPathsInSection)
-        {
-            GNEOutlineViewItem *item = [self p_outlineViewItemAtIndexPath:indexPath];
-            
-            if (item == nil)
-            {
-                continue;
-            }
-            
-            [self reloadItem:item];
-        }
-    }
+    [self p_reloadVisibleTableViewRows:tableViewRows];
     [self endUpdates];
     
     [self p_checkDataSourceIntegrity];
@@ -707,57 +896,23 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
          withAnimation:(NSTableViewAnimationOptions)animationOptions
               expanded:(BOOL)expanded
 {
+    GNEParameterAssert([self.tableViewDataSource respondsToSelector:@selector(tableView:numberOfRowsInSection:)]);
+    
+    if (self.batchUpdate)
+    {
+        [self.batchUpdate insertSections:sections withAnimation:animationOptions expanded:expanded];
+        return;
+    }
+    
 #if GNE_CRUD_LOGGING_ENABLED
     NSLog(@"%@\n%@", NSStringFromSelector(_cmd), sections);
 #endif
     
-    GNEParameterAssert([self.tableViewDataSource respondsToSelector:@selector(tableView:numberOfRowsInSection:)]);
-    
-    NSMutableIndexSet *insertedSections = [NSMutableIndexSet indexSet];
-    
-    NSMutableArray *outlineViewParentItemsCopy = [NSMutableArray arrayWithArray:self.outlineViewParentItems];
-    NSMutableArray *outlineViewItemsCopy = [NSMutableArray arrayWithArray:self.outlineViewItems];
-    
-    [sections enumerateIndexesUsingBlock:^(NSUInteger proposedSection, BOOL *stop __unused)
-    {
-        @autoreleasepool
-        {
-            NSUInteger sectionCount = outlineViewParentItemsCopy.count;
-            NSUInteger section = (proposedSection > sectionCount) ? sectionCount : proposedSection;
-            
-            GNEOutlineViewParentItem *parentItem = [[GNEOutlineViewParentItem alloc] init];
-            parentItem.pasteboardWritingDelegate = self;
-            parentItem.hasFooter = [self p_requestDelegateHasFooterInSection:section];
-            [outlineViewParentItemsCopy gne_insertObject:parentItem atIndex:section];
-            
-            NSMutableArray *rows = [NSMutableArray array];
-            [outlineViewItemsCopy gne_insertObject:rows atIndex:section];
-            
-            NSUInteger rowCount = [self.tableViewDataSource tableView:self numberOfRowsInSection:section];
-            rowCount += (parentItem.hasFooter) ? 1 : 0; // Add a footer item, if needed.
-            
-            for (NSUInteger row = 0; row < rowCount; row++)
-            {
-                GNEOutlineViewItem *item = [[GNEOutlineViewItem alloc] initWithParentItem:parentItem];
-                item.pasteboardWritingDelegate = self;
-                
-                [rows addObject:item];
-            }
-            
-            [insertedSections addIndex:section];
-        }
-    }];
-    
-    GNEParameterAssert(sections.count == insertedSections.count);
-    
-    self.outlineViewParentItems = outlineViewParentItemsCopy;
-    self.outlineViewItems = outlineViewItemsCopy;
+    [self p_insertSections:sections withAnimation:animationOptions expanded:expanded];
     
-    [self insertItemsAtIndexes:insertedSections inParent:nil withAnimation:animationOptions];
-    
-    if (expanded)
+    if (self.updateCount == 0)
     {
-        [self.insertedSectionsToExpand addIndexes:insertedSections];
+        [self p_updateMapForShiftedRowViews];
     }
     
     [self p_checkDataSourceIntegrity];
@@ -767,43 +922,22 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 - (void)deleteSections:(NSIndexSet * __nonnull)sections
          withAnimation:(NSTableViewAnimationOptions)animationOptions
 {
+    if (self.batchUpdate)
+    {
+        [self.batchUpdate deleteSections:sections withAnimation:animationOptions];
+        return;
+    }
+    
 #if GNE_CRUD_LOGGING_ENABLED
     NSLog(@"%@\n%@", NSStringFromSelector(_cmd), sections);
 #endif
     
-    NSMutableArray *outlineViewParentItemsCopy = [NSMutableArray arrayWithArray:self.outlineViewParentItems];
-    NSMutableArray *outlineViewItemsCopy = [NSMutableArray arrayWithArray:self.outlineViewItems];
+    [self p_deleteSections:sections withAnimation:animationOptions];
     
-    NSMutableIndexSet *deletedSections = [NSMutableIndexSet indexSet];
-    [sections enumerateIndexesWithOptions:NSEnumerationReverse usingBlock:^(NSUInteger section, BOOL *stop __unused)
+    if (self.updateCount == 0)
     {
-        GNEOutlineViewParentItem *parentItem = [self p_outlineViewParentItemForSection:section];
-        
-        if (parentItem)
-        {
-            NSUInteger index = [self p_sectionForOutlineViewParentItem:parentItem];
-            
-            if (index != NSNotFound)
-            {
-                GNEParameterAssert([deletedSections containsIndex:index] == NO);
-                
-                [deletedSections addIndex:index];
-                
-                GNEParameterAssert(index < outlineViewParentItemsCopy.count);
-                GNEParameterAssert(index < outlineViewItemsCopy.count);
-                
-                [outlineViewParentItemsCopy removeObjectAtIndex:index];
-                [outlineViewItemsCopy removeObjectAtIndex:index];
-            }
-        }
-    }];
-    
-    GNEParameterAssert(sections.count == deletedSections.count);
-    
-    self.outlineViewParentItems = outlineViewParentItemsCopy;
-    self.outlineViewItems = outlineViewItemsCopy;
-    
-    [self removeItemsAtIndexes:deletedSections inParent:nil withAnimation:animationOptions];
+        [self p_updateMapForShiftedRowViews];
+    }
     
     [self p_checkDataSourceIntegrity];
 }
@@ -823,9 +957,33 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     NSLog(@"%@\nFrom: %@ To: %@", NSStringFromSelector(_cmd), fromSections, toSections);
 #endif
     
-    GNEParameterAssert(self.outlineViewParentItems.count == self.outlineViewItems.count);
+    void (^requeueRows)(void) = [self p_requeueBlockForRowsQueuedForSectionsMovedFromSections:fromSections
+                                                                                   toSections:toSections];
     
-    if (self.currentMove)
+    if (self.batchUpdate)
+    {
+        // Sections moved in a batch are deleted and reinserted without the animation of their cell
+        // views, but they keep their expanded or collapsed state.
+        NSMutableIndexSet *expandedSections = [NSMutableIndexSet indexSet];
+        NSMutableIndexSet *collapsedSections = [NSMutableIndexSet indexSet];
+        [fromSections enumerateIndexesUsingBlock:^(NSUInteger section, NSUInteger position, BOOL *stop __unused)
+        {
+            NSUInteger toSection = [toSections indexAtPosition:position];
+            if ([self isSectionExpanded:section])
+            {
+                [expandedSections addIndex:toSection];
+            }
+            else
+            {
+                [collapsedSections addIndex:toSection];
+            }
+        }];
+        
+        [self.batchUpdate deleteSections:fromSections.ns_indexSet withAnimation:NSTableViewAnimationEffectNone];
+        [self.batchUpdate insertSections:expandedSections withAnimation:NSTableViewAnimationEffectNone expanded:YES];
+        [self.batchUpdate insertSections:collapsedSections withAnimation:NSTableViewAnimationEffectNone expanded:NO];
+    }
+    else if (self.currentMove)
     {
         [self p_updateAutoCollapsedSectionsForMoveFromSections:fromSections
                                                     toSections:toSections];
@@ -840,10 +998,10 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
         move.completion = ^()
         {
             __strong typeof(weakSelf) strongSelf = weakSelf;
-            [strongSelf p_updateMapForAvailableRowViews];
+            [strongSelf p_updateMapForShiftedRowViews];
         };
         
-        GNEOrderedIndexSet *sectionsToExpand = [GNEOrderedIndexSet indexSet];
+        NSMutableIndexSet *expandedPositions = [NSMutableIndexSet indexSet];
         [fromSections enumerateIndexesUsingBlock:^(NSUInteger section,
                                                    NSUInteger position,
                                                    BOOL *stop __unused)
@@ -863,29 +1021,33 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
                 [move addMovingItem:movingItem];
                 if (isExpanded)
                 {
-                    [sectionsToExpand addIndex:[toSections indexAtPosition:position]];
+                    [expandedPositions addIndex:position];
                 }
             }
         }];
         
-        move.sectionsToExpand = sectionsToExpand.ns_indexSet;
+        move.sectionsToExpand = [self p_sectionsInSections:toSections atPositions:expandedPositions];
         [move moveSections:fromSections toSections:toSections];
     }
     
+    // Sections moved in a batch are only moved when the batch is applied.
+    if (requeueRows && self.batchUpdate)
+    {
+        [self.batchUpdateCompletions addObject:[requeueRows copy]];
+    }
+    else if (requeueRows)
+    {
+        requeueRows();
+    }
+    
     [self p_checkDataSourceIntegrity];
 }
 
 
 - (void)moveSections:(GNEOrderedIndexSet * __nonnull)fromSections toSection:(NSUInteger)toSection
 {
-    GNEParameterAssert(self.outlineViewParentItems.count == self.outlineViewItems.count);
-    
     GNEOrderedIndexSet *toSections = [GNEOrderedIndexSet indexSet];
-    NSUInteger count = fromSections.count;
-    for (NSUInteger i = 0; i < count; i++)
-    {
-        [toSections addIndex:(toSection + i)];
-    }
+    [toSections addIndexesInRange:NSMakeRange(toSection, fromSections.count)];
     
     [self moveSections:fromSections toSections:toSections];
     
@@ -895,34 +1057,121 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 
 - (void)reloadSections:(NSIndexSet * __nonnull)sections
 {
+    if (self.batchUpdate)
+    {
+        [self.batchUpdate reloadSections:sections];
+        return;
+    }
+    
 #if GNE_CRUD_LOGGING_ENABLED
     NSLog(@"%@\n%@", NSStringFromSelector(_cmd), sections);
 #endif
     
-    GNEParameterAssert(self.outlineViewParentItems.count == self.outlineViewItems.count);
-    
-    NSUInteger sectionCount = self.outlineViewParentItems.count;
+    NSIndexSet *tableViewRows = [self p_indexSetOfTableViewRowsInSections:sections];
     
     [self beginUpdates];
-    [sections enumerateIndexesUsingBlock:^(NSUInteger section, BOOL *stop __unused)
+    [self p_reloadVisibleTableViewRows:tableViewRows];
+    [self endUpdates];
+    
+    [self p_checkDataSourceIntegrity];
+}
+
+
+- (void)applyChangeSet:(GNESectionedTableViewChangeSet * __nonnull)changeSet
+         withAnimation:(NSTableViewAnimationOptions)animationOptions
+{
+#if GNE_CRUD_LOGGING_ENABLED
+    NSLog(@"%@\n%@", NSStringFromSelector(_cmd), changeSet);
+#endif
+    
+    GNEParameterAssert(changeSet);
+    GNEParameterAssert(changeSet.fromSnapshot.numberOfSections == self.model.numberOfSections);
+    
+    if (changeSet == nil || changeSet.isEmpty)
+    {
+        return;
+    }
+    
+    // Moved rows and sections are deleted and reinserted, which loses their selection and
+    // expansion state, so remember it in terms of the new snapshot.
+    NSArray *selectedIndexPaths = self.selectedIndexPaths;
+    NSMutableArray *indexPathsToSelect = [NSMutableArray array];
+    for (NSIndexPath *indexPath in selectedIndexPaths)
     {
-        GNEOutlineViewParentItem *parentItem = nil;
-        if (section < sectionCount && (parentItem = [self p_outlineViewParentItemForSection:section]))
+        NSIndexPath *toIndexPath = [changeSet indexPathAfterChangesForIndexPath:indexPath];
+        if (toIndexPath)
         {
-            [self reloadItem:parentItem];
-            if (section < self.outlineViewItems.count)
-            {
-                NSArray *children = self.outlineViewItems[section];
-                for (id child in children)
-                {
-                    [self reloadItem:child];
-                }
-            }
+            [indexPathsToSelect addObject:toIndexPath];
+        }
+    }
+    
+    void (^requeueRows)(void) = [self p_requeueBlockForRowsQueuedForSectionsMovedFromSections:changeSet.movedFromSections
+                                                                                   toSections:changeSet.movedToSections];
+    
+    NSMutableIndexSet *collapsedSections = [NSMutableIndexSet indexSet];
+    GNEOrderedIndexSet *movedToSections = changeSet.movedToSections;
+    [changeSet.movedFromSections enumerateIndexesUsingBlock:^(NSUInteger section,
+                                                              NSUInteger position,
+                                                              BOOL *stop __unused)
+    {
+        if ([self isSectionExpanded:section] == NO)
+        {
+            [collapsedSections addIndex:[movedToSections indexAtPosition:position]];
         }
     }];
-    [self endUpdates];
     
-    [self p_checkDataSourceIntegrity];
+    // The batch normalizes the change set's index paths: deletions use the old snapshot's index paths
+    // and insertions the new snapshot's, and moved rows and sections are deleted and reinserted.
+    __weak typeof(self) weakSelf = self;
+    [self performBatchUpdates:^()
+    {
+        __strong typeof(weakSelf) strongSelf = weakSelf;
+        GNESectionedTableViewBatchUpdate *batchUpdate = strongSelf.batchUpdate;
+        
+        [batchUpdate deleteRowsAtIndexPaths:changeSet.deletedRowIndexPaths withAnimation:animationOptions];
+        [batchUpdate deleteRowsAtIndexPaths:changeSet.movedFromRowIndexPaths withAnimation:animationOptions];
+        [batchUpdate deleteSections:changeSet.deletedSections withAnimation:animationOptions];
+        [batchUpdate deleteSections:changeSet.movedFromSections.ns_indexSet withAnimation:animationOptions];
+        
+        NSMutableIndexSet *insertedSections = [changeSet.insertedSections mutableCopy];
+        [insertedSections addIndexes:movedToSections.ns_indexSet];
+        [insertedSections removeIndexes:collapsedSections];
+        [batchUpdate insertSections:insertedSections withAnimation:animationOptions expanded:YES];
+        [batchUpdate insertSections:collapsedSections withAnimation:animationOptions expanded:NO];
+        
+        [batchUpdate insertRowsAtIndexPaths:changeSet.insertedRowIndexPaths withAnimation:animationOptions];
+        [batchUpdate insertRowsAtIndexPaths:changeSet.movedToRowIndexPaths withAnimation:animationOptions];
+    }
+    completion:^()
+    {
+        __strong typeof(weakSelf) strongSelf = weakSelf;
+        if (selectedIndexPaths.count > 0)
+        {
+            [strongSelf selectRowsAtIndexPaths:indexPathsToSelect byExtendingSelection:NO];
+        }
+        
+        if (requeueRows)
+        {
+            requeueRows();
+        }
+    }];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - GNESectionedTableView - Public - Streaming
+// ------------------------------------------------------------------------------------------
+- (void)appendRows:(NSUInteger)count toSection:(NSUInteger)section
+{
+    [self.appendQueue appendRows:count toSection:section];
+}
+
+
+- (void)flushAppendedRows
+{
+    GNEParameterAssert([NSThread isMainThread]);
+    
+    [self.appendQueue flush];
 }
 
 
@@ -931,11 +1180,11 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 // ------------------------------------------------------------------------------------------
 - (BOOL)isSectionExpanded:(NSUInteger)section
 {
-    GNEParameterAssert(section < self.outlineViewParentItems.count + 1);
+    GNEParameterAssert(section < self.model.numberOfSections + 1);
     
-    if (section < self.outlineViewParentItems.count)
+    if (section < self.model.numberOfSections)
     {
-        GNEOutlineViewParentItem *parentItem = self.outlineViewParentItems[section];
+        GNEOutlineViewParentItem *parentItem = [self.model parentItemForSection:section];
         
         return [self isItemExpanded:parentItem];
     }
@@ -958,9 +1207,9 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 
 - (void)expandSection:(NSUInteger)section animated:(BOOL)animated
 {
-    GNEParameterAssert(section < self.outlineViewParentItems.count);
+    GNEParameterAssert(section < self.model.numberOfSections);
     
-    if (section < self.outlineViewParentItems.count)
+    if (section < self.model.numberOfSections)
     {
         [self expandSections:[NSIndexSet indexSetWithIndex:section]
                     animated:animated];
@@ -977,7 +1226,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
         context.timingFunction = [CAMediaTimingFunction functionWithName:name];
     }
     
-    NSUInteger count = self.outlineViewParentItems.count;
+    NSUInteger count = self.model.numberOfSections;
     __weak typeof(self) weakSelf = self;
     [sections enumerateIndexesUsingBlock:^(NSUInteger section, BOOL *stop __unused)
     {
@@ -987,6 +1236,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
         SEL selector = @selector(tableView:shouldExpandSection:);
         if ([strongSelf.tableViewDelegate respondsToSelector:selector])
         {
+            GNEStatisticsRecordCallout(strongSelf.statisticsRecorder, @selector(tableView:shouldExpandSection:));
             canExpandSection = [strongSelf.tableViewDelegate tableView:strongSelf
                                                    shouldExpandSection:section];
         }
@@ -996,7 +1246,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
             id outlineView = (animated) ? strongSelf.animator : strongSelf;
             if (section < count)
             {
-                GNEOutlineViewParentItem *parentItem = strongSelf.outlineViewParentItems[section];
+                GNEOutlineViewParentItem *parentItem = [strongSelf.model parentItemForSection:section];
                 if ([strongSelf isItemExpanded:parentItem] == NO)
                 {
                     [outlineView expandItem:parentItem];
@@ -1019,9 +1269,9 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 
 - (void)collapseSection:(NSUInteger)section animated:(BOOL)animated
 {
-    GNEParameterAssert(section < self.outlineViewParentItems.count);
+    GNEParameterAssert(section < self.model.numberOfSections);
     
-    if (section < self.outlineViewParentItems.count)
+    if (section < self.model.numberOfSections)
     {
         [self collapseSections:[NSIndexSet indexSetWithIndex:section]
                       animated:animated];
@@ -1038,7 +1288,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
         context.timingFunction = [CAMediaTimingFunction functionWithName:name];
     }
     
-    NSUInteger count = self.outlineViewParentItems.count;
+    NSUInteger count = self.model.numberOfSections;
     __weak typeof(self) weakSelf = self;
     [sections enumerateIndexesUsingBlock:^(NSUInteger section, BOOL *stop __unused)
     {
@@ -1048,6 +1298,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
         SEL selector = @selector(tableView:shouldCollapseSection:);
         if ([strongSelf.tableViewDelegate respondsToSelector:selector])
         {
+            GNEStatisticsRecordCallout(strongSelf.statisticsRecorder, @selector(tableView:shouldCollapseSection:));
             canCollapseSection = [strongSelf.tableViewDelegate tableView:strongSelf
                                                    shouldCollapseSection:section];
         }
@@ -1057,7 +1308,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
             id outlineView = (animated) ? strongSelf.animator : strongSelf;
             if (section < count)
             {
-                GNEOutlineViewParentItem *parentItem = strongSelf.outlineViewParentItems[section];
+                GNEOutlineViewParentItem *parentItem = [strongSelf.model parentItemForSection:section];
                 if ([strongSelf isItemExpanded:parentItem])
                 {
                     [outlineView collapseItem:parentItem];
@@ -1079,7 +1330,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     {
         GNEOutlineViewItem *item = [self itemAtRow:selectedRow];
         
-        return [self p_indexPathOfOutlineViewItem:item];
+        return [self.model indexPathOfItem:item];
     }
     
     return nil;
@@ -1088,32 +1339,9 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 
 - (NSArray *)selectedIndexPaths
 {
-    NSIndexSet *selectedRows = self.selectedRowIndexes;
-    if (selectedRows.count > 0)
-    {
-        NSMutableArray *indexPaths = [NSMutableArray array];
-        
-        __weak typeof(self) weakSelf = self;
-        [selectedRows enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop __unused)
-        {
-            __strong typeof(weakSelf) strongSelf = weakSelf;
-            
-            GNEOutlineViewItem *item = [strongSelf itemAtRow:(NSInteger)idx];
-            NSIndexPath *indexPath = [strongSelf p_indexPathOfOutlineViewItem:item];
-            if (indexPath)
-            {
-                [indexPaths addObject:indexPath];
-            }
-        }];
-        
-        if (indexPaths.count > 0)
-        {
-            SEL selector = NSSelectorFromString(@"gne_compare:");
-            return [indexPaths sortedArrayUsingSelector:selector];
-        }
-    }
+    [self p_updateSelectionIfNeeded];
     
-    return @[];
+    return self.model.selectedIndexPaths;
 }
 
 
@@ -1121,24 +1349,9 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 {
     GNEParameterAssert(indexPath);
     
-    NSArray *selectedIndexPaths = self.selectedIndexPaths;
-    
-    if (indexPath && selectedIndexPaths.count > 0)
-    {
-        NSRange range = NSMakeRange(0, selectedIndexPaths.count);
-        NSUInteger index = [selectedIndexPaths indexOfObject:indexPath
-                                               inSortedRange:range
-                                                     options:NSBinarySearchingFirstEqual
-                                             usingComparator:^NSComparisonResult(NSIndexPath *first,
-                                                                                 NSIndexPath *second)
-        {
-            return [first gne_compare:second];
-        }];
-        
-        return ((index == NSNotFound) ? NO : YES);
-    }
+    [self p_updateSelectionIfNeeded];
     
-    return NO;
+    return [self.model isIndexPathSelected:indexPath];
 }
 
 
@@ -1154,16 +1367,16 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     NSUInteger section = indexPath.gne_section;
     NSUInteger row = indexPath.gne_row;
     
-    GNEParameterAssert(section < self.outlineViewItems.count &&
-                       row < ((NSArray *)self.outlineViewItems[section]).count);
+    GNEParameterAssert(section < self.model.numberOfSections &&
+                       row < [self.model numberOfItemsInSection:section]);
     
-    if (section >= self.outlineViewItems.count ||
-        row >= ((NSArray *)self.outlineViewItems[section]).count)
+    if (section >= self.model.numberOfSections ||
+        row >= [self.model numberOfItemsInSection:section])
     {
         return;
     }
     
-    GNEOutlineViewItem *item = ((NSArray *)self.outlineViewItems[section])[row];
+    GNEOutlineViewItem *item = [self.model itemsInSection:section][row];
     NSInteger tableViewRow = [self rowForItem:item];
     
     if (tableViewRow >= 0 &&
@@ -1199,58 +1412,117 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 }
 
 
+- (void)selectHeadersInSections:(NSIndexSet * __nonnull)sections byExtendingSelection:(BOOL)extend
+{
+    GNEParameterAssert(sections);
+    
+    NSIndexSet *tableViewRows = [self p_indexSetOfTableViewRowsForHeadersInSections:sections];
+    
+    [self selectRowIndexes:(tableViewRows ?: [NSIndexSet indexSet]) byExtendingSelection:extend];
+}
+
+
+- (void)selectRowsInRange:(NSRange)rows ofSectionsInRange:(NSRange)sections byExtendingSelection:(BOOL)extend
+{
+    NSMutableIndexSet *tableViewRows = [NSMutableIndexSet indexSet];
+    
+    NSUInteger sectionCount = self.model.numberOfSections;
+    NSRange validSections = NSIntersectionRange(sections, NSMakeRange(0, sectionCount));
+    
+    for (NSUInteger section = validSections.location; section < NSMaxRange(validSections); section++)
+    {
+        NSRange allRows = NSMakeRange(0, [self.model numberOfItemsInSection:section]);
+        NSIndexSet *rowIndexes = [NSIndexSet indexSetWithIndexesInRange:NSIntersectionRange(rows, allRows)];
+        
+        NSIndexSet *sectionTableViewRows = [self p_indexSetOfTableViewRowsForRows:rowIndexes inSection:section];
+        if (sectionTableViewRows)
+        {
+            [tableViewRows addIndexes:sectionTableViewRows];
+        }
+    }
+    
+    [self selectRowIndexes:tableViewRows byExtendingSelection:extend];
+}
+
+
 // ------------------------------------------------------------------------------------------
 #pragma mark - GNESectionedTableView - Public - Layout Support
 // ------------------------------------------------------------------------------------------
 - (NSIndexPath * __nullable)indexPathForViewAtPoint:(CGPoint)point
 {
-    NSInteger tableViewRow = [self rowAtPoint:point];
-    
-    return [self indexPathForTableViewRow:tableViewRow];
+    return [self p_indexPathOfRowAtOffset:point.y];
 }
 
 
 - (CGRect)frameOfViewAtIndexPath:(NSIndexPath * __nonnull)indexPath
 {
-    GNEOutlineViewItem *item = [self p_outlineViewItemAtIndexPath:indexPath];
     NSInteger lastColumn = self.numberOfColumns - 1; // Assume only one column
-    if (item && lastColumn >= 0)
+    CGRect rowRect = [self p_rectOfRowAtIndexPath:indexPath];
+    
+    if (lastColumn < 0 || CGRectIsNull(rowRect))
     {
-        NSInteger row = [self rowForItem:item];
-        
-        return [super frameOfCellAtColumn:lastColumn row:row];
+        return CGRectZero;
     }
     
-    return CGRectZero;
+    CGRect columnRect = [self rectOfColumn:lastColumn];
+    CGRect frame = CGRectMake(columnRect.origin.x, rowRect.origin.y, columnRect.size.width, rowRect.size.height);
+    NSSize spacing = self.intercellSpacing;
+    
+    return CGRectInset(frame, spacing.width / 2.0, spacing.height / 2.0);
 }
 
 
 - (CGRect)frameOfSection:(NSUInteger)section
 {
-    GNEOutlineViewParentItem *parentItem = [self p_outlineViewParentItemForSection:section];
-    NSIndexPath *sectionIndexPath = [self p_indexPathOfOutlineViewItem:parentItem];
+    NSInteger lastColumn = self.numberOfColumns - 1; // Assume only one column
     
-    if (sectionIndexPath == nil)
+    if (lastColumn < 0 || section >= self.sectionHeights.count)
     {
         return CGRectZero;
     }
     
-    CGRect frame = [self frameOfViewAtIndexPath:sectionIndexPath];
-    if ([self isItemExpanded:parentItem])
+    CGRect columnRect = [self rectOfColumn:lastColumn];
+    CGRect frame = CGRectMake(columnRect.origin.x,
+                              [self.sectionHeights sumOfValuesBeforeIndex:section],
+                              columnRect.size.width,
+                              [self.sectionHeights valueAtIndex:section]);
+    NSSize spacing = self.intercellSpacing;
+    
+    return CGRectInset(frame, spacing.width / 2.0, spacing.height / 2.0);
+}
+
+
+- (void)noteHeightOfRowsAtIndexPathsChanged:(NSArray * __nonnull)indexPaths
+{
+    [self p_checkIndexPathsArray:indexPaths];
+    
+    NSMutableArray *items = [NSMutableArray array];
+    NSMutableIndexSet *tableViewRows = [NSMutableIndexSet indexSet];
+    for (NSIndexPath *indexPath in indexPaths)
     {
-        NSArray *rowsArray = self.outlineViewItems[section];
-        for (GNEOutlineViewItem *item in rowsArray)
+        GNEOutlineViewItem *item = [self.model itemAtIndexPath:indexPath];
+        if (item == nil)
         {
-            NSIndexPath *indexPath = [self p_indexPathOfOutlineViewItem:item];
-            if (indexPath == nil)
-            {
-                break;
-            }
-            frame = CGRectUnion(frame, [self frameOfViewAtIndexPath:indexPath]);
+            continue;
+        }
+        
+        [items addObject:item];
+        
+        NSInteger tableViewRow = [self rowForItem:item];
+        if (tableViewRow >= 0)
+        {
+            [tableViewRows addIndex:(NSUInteger)tableViewRow];
         }
     }
     
-    return frame;
+    // Rows in collapsed sections aren't in the outline view, so they are measured here instead of in
+    // -noteHeightOfRowsWithIndexesChanged:.
+    [self p_updateHeightsOfOutlineViewItems:items];
+    
+    if (tableViewRows.count > 0)
+    {
+        [super noteHeightOfRowsWithIndexesChanged:tableViewRows];
+    }
 }
 
 
@@ -1259,68 +1531,222 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 // ------------------------------------------------------------------------------------------
 - (void)scrollRowAtIndexPathToVisible:(NSIndexPath * __nonnull)indexPath
 {
-    NSInteger tableViewRow = [self tableViewRowForIndexPath:indexPath];
-    if (tableViewRow >= 0)
+    // The row is scrolled to using its actual height instead of its estimated height.
+    NSUInteger section = indexPath.gne_section;
+    if (section < self.model.numberOfSections &&
+        [self isIndexPathHeader:indexPath] == NO &&
+        [self isIndexPathFooter:indexPath] == NO)
+    {
+        [self p_preserveVisibleRowsDuringChanges:^()
+        {
+            [self p_measureEstimatedRowsInRange:NSMakeRange(indexPath.gne_row, 1) inSection:section];
+        }];
+    }
+    
+    CGRect rowRect = [self p_rectOfRowAtIndexPath:indexPath];
+    if (CGRectIsNull(rowRect) == NO)
     {
-        [self scrollRowToVisible:tableViewRow];
+        [self scrollRectToVisible:rowRect];
     }
 }
 
 
+// ------------------------------------------------------------------------------------------
+#pragma mark - GNESectionedTableView - Public - Statistics
+// ------------------------------------------------------------------------------------------
+- (GNESectionedTableViewStatistics * __nullable)statistics
+{
+#if GNE_STATISTICS_ENABLED
+    return self.statisticsRecorder.statistics;
+#else
+    return nil;
+#endif
+}
+
+
+- (void)resetStatistics
+{
+#if GNE_STATISTICS_ENABLED
+    [self.statisticsRecorder reset];
+#endif
+}
+
+
 // ------------------------------------------------------------------------------------------
 #pragma mark - GNESectionedTableView - Internal - Build Data Source Arrays
 // ------------------------------------------------------------------------------------------
 - (void)p_buildOutlineViewItemArrays
 {
-    NSUInteger sectionCount = [self p_numberOfSections];
-    for (NSUInteger section = 0; section < sectionCount; section++)
+    NSRange sectionRange = NSMakeRange(0, [self p_numberOfSections]);
+    [self p_insertOutlineViewParentItemsAtSections:[NSIndexSet indexSetWithIndexesInRange:sectionRange]];
+}
+
+
+/**
+ Inserts new outline view parent items and outline view item arrays into the model at the specified sections
+ and measures their headers, rows, and footers.
+ 
+ @param sections Indexes at which to insert the new sections.
+ @return Indexes the new sections were inserted at.
+ */
+- (NSIndexSet *)p_insertOutlineViewParentItemsAtSections:(NSIndexSet *)sections
+{
+    NSIndexSet *insertedSections = [self.model insertSections:sections
+                                                   usingBlock:^NSUInteger(GNEOutlineViewParentItem *parentItem,
+                                                                          NSUInteger section)
     {
-        GNEOutlineViewParentItem *parentItem = [[GNEOutlineViewParentItem alloc] init];
         parentItem.pasteboardWritingDelegate = self;
         parentItem.hasFooter = [self p_requestDelegateHasFooterInSection:section];
         
-        [self.outlineViewParentItems addObject:parentItem];
-        NSMutableArray *rowArray = [NSMutableArray array];
-        [self.outlineViewItems addObject:rowArray];
-        
-        NSUInteger rowCount = [self p_numberOfRowsInSection:section];
-        rowCount += ((parentItem.hasFooter) ? 1 : 0);
-        for (NSUInteger row = 0; row < rowCount; row++)
-        {
-            GNEOutlineViewItem *item = [[GNEOutlineViewItem alloc] initWithParentItem:parentItem];
-            item.pasteboardWritingDelegate = self;
-            [rowArray addObject:item];
-        }
-    }
+        return [self p_numberOfRowsInSection:section];
+    }];
+    
+    GNESectionedTableViewRowHeightMeasuringBlock measuringBlock = [self p_requestDelegateRowHeightMeasuringBlock];
+    [insertedSections enumerateIndexesUsingBlock:^(NSUInteger section, BOOL *stop __unused)
+    {
+        [self p_measureSection:section
+     withOutlineViewParentItem:[self.model parentItemForSection:section]
+                          rows:[self.model itemsInSection:section]
+                measuringBlock:measuringBlock];
+    }];
+    
+    return insertedSections;
 }
 
 
 /**
- Returns YES if the specified section has a header, otherwise NO.
- 
- @discussion Returns YES if the table view delegate responds to
- tableView:heightForHeaderInSection:, tableView:rowViewForHeaderInSection:, and
- tableView:cellViewForHeaderInSection: and if the returned height for the header in
- the specified section is greater than or equal to 1.0.
- @param section Section to query the delegate for.
- @return YES if the specified section has a header, otherwise NO.
+ Releases the outline view items of the rows and footer of the specified section if it is collapsed,
+ so that a collapsed section only costs as much memory as its row heights. NSOutlineView doesn't retain
+ its items, so the section is reloaded to make NSOutlineView ask for new items when it expands again.
+ The items of expanded sections are recycled by -p_recycleOutlineViewItemsFarFromVisibleRect.
  */
-- (BOOL)p_requestDelegateHasHeaderInSection:(NSUInteger)section
+- (void)p_recycleOutlineViewItemsInSection:(NSUInteger)section
 {
-    SEL heightSelector = @selector(tableView:heightForHeaderInSection:);
-    SEL rowViewSelector = @selector(tableView:rowViewForHeaderInSection:);
-    SEL cellViewSelector = @selector(tableView:cellViewForHeaderInSection:);
-    
-    id <GNESectionedTableViewDelegate> theDelegate = self.tableViewDelegate;
-    
-    if ([theDelegate respondsToSelector:heightSelector] == NO ||
-        [theDelegate respondsToSelector:rowViewSelector] == NO ||
-        [theDelegate respondsToSelector:cellViewSelector] == NO)
+    if (section >= self.model.numberOfSections || self.currentMove || self.updateCount > 0 ||
+        [self isSectionExpanded:section] || [self.autoCollapsedSections containsIndex:section])
     {
-        return NO;
+        return;
     }
     
-    CGFloat height = [theDelegate tableView:self heightForHeaderInSection:section];
+    GNEOutlineViewItemArray *rows = [self.model itemsInSection:section];
+    if (rows.materializedCount == 0)
+    {
+        return;
+    }
+    
+    [rows recycleObjectsInRange:NSMakeRange(0, rows.count)];
+    [self reloadItem:[self.model parentItemForSection:section] reloadChildren:YES];
+}
+
+
+/// Coalesces the expansions and bounds changes of the clip view during a run loop iteration into a single
+/// pass recycling the outline view items far from the visible rows.
+- (void)p_scheduleOutlineViewItemRecycling
+{
+    if (self.outlineViewItemRecyclingScheduled)
+    {
+        return;
+    }
+    
+    self.outlineViewItemRecyclingScheduled = YES;
+    [self performSelector:@selector(p_recycleOutlineViewItemsFarFromVisibleRect)
+               withObject:nil
+               afterDelay:0.0
+                  inModes:@[NSRunLoopCommonModes]];
+}
+
+
+/**
+ Releases the outline view items of the rows and footers of expanded sections that are further than
+ kOutlineViewItemRetentionDistance from the visible rows, so that the number of items depends on the
+ visible rows instead of on the number of rows. Each section whose items are released is reloaded, which
+ makes NSOutlineView drop its unretained references to them and ask for new items only when it needs them.
+ 
+ @discussion Sections that are far from the visible rows release all of their items. A section near the
+ visible rows keeps the item of its footer and only releases the items of its rows once
+ kMinimumRecycledOutlineViewItemCount of them, and at least as many as it keeps, are far away, because
+ reloading it also reloads its visible rows.
+ */
+- (void)p_recycleOutlineViewItemsFarFromVisibleRect
+{
+    // Items can't be recycled in the middle of an update, so the recycling is scheduled again.
+    if (self.isUpdating)
+    {
+        [self performSelector:@selector(p_recycleOutlineViewItemsFarFromVisibleRect)
+                   withObject:nil
+                   afterDelay:0.0
+                      inModes:@[NSRunLoopCommonModes]];
+        
+        return;
+    }
+    
+    self.outlineViewItemRecyclingScheduled = NO;
+    
+    // Dragged rows are written to the pasteboard with their items.
+    CGRect visibleRect = self.visibleRect;
+    if (self.currentMove || CGRectIsEmpty(visibleRect))
+    {
+        return;
+    }
+    
+    CGRect rect = CGRectInset(visibleRect, 0.0, -visibleRect.size.height * kOutlineViewItemRetentionDistance);
+    NSUInteger sectionCount = self.model.numberOfSections;
+    for (GNEOutlineViewParentItem *parentItem in [self.parentItemsWithOutlineViewItems allObjects])
+    {
+        NSUInteger section = parentItem.section;
+        if (section == NSNotFound || section >= sectionCount ||
+            [self.model parentItemForSection:section] != parentItem || [self isItemExpanded:parentItem] == NO)
+        {
+            // Collapsed sections recycle their items when they are collapsed.
+            [self.parentItemsWithOutlineViewItems removeObject:parentItem];
+            continue;
+        }
+        
+        GNEOutlineViewItemArray *rows = [self.model itemsInSection:section];
+        CGFloat sectionOriginY = [self.sectionHeights sumOfValuesBeforeIndex:section];
+        CGFloat sectionMaxY = sectionOriginY + [self.sectionHeights valueAtIndex:section];
+        if (sectionMaxY <= CGRectGetMinY(rect) || sectionOriginY >= CGRectGetMaxY(rect))
+        {
+            [self.parentItemsWithOutlineViewItems removeObject:parentItem];
+            if (rows.materializedCount > 0)
+            {
+                [rows recycleObjectsInRange:NSMakeRange(0, rows.count)];
+                [self reloadItem:parentItem reloadChildren:YES];
+            }
+            
+            continue;
+        }
+        
+        // The footer of a section near the visible rows keeps its item.
+        NSUInteger rowCount = rows.count - ((parentItem.hasFooter) ? 1 : 0);
+        NSRange keptRange = [self p_rangeOfRowsInSection:section intersectingRect:rect];
+        NSUInteger keptCount = [rows materializedCountInRange:keptRange];
+        NSUInteger recycledCount = [rows materializedCountInRange:NSMakeRange(0, rowCount)] - keptCount;
+        if (recycledCount < MAX(keptCount, kMinimumRecycledOutlineViewItemCount))
+        {
+            continue;
+        }
+        
+        [rows recycleObjectsInRange:NSMakeRange(0, keptRange.location)];
+        [rows recycleObjectsInRange:NSMakeRange(NSMaxRange(keptRange), rowCount - NSMaxRange(keptRange))];
+        [self reloadItem:parentItem reloadChildren:YES];
+    }
+}
+
+
+/**
+ Returns YES if the specified section has a header, otherwise NO.
+ 
+ @discussion Returns YES if the table view delegate responds to
+ tableView:heightForHeaderInSection:, tableView:rowViewForHeaderInSection:, and
+ tableView:cellViewForHeaderInSection: and if the returned height for the header in
+ the specified section is greater than or equal to 1.0.
+ @param section Section to query the delegate for.
+ @return YES if the specified section has a header, otherwise NO.
+ */
+- (BOOL)p_requestDelegateHasHeaderInSection:(NSUInteger)section
+{
+    CGFloat height = [self p_requestDelegateHeightOfHeaderInSection:section];
     
     return (height > GNESectionedTableViewInvisibleRowHeight);
 }
@@ -1351,667 +1777,2417 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
         return NO;
     }
     
+    GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:heightForFooterInSection:));
     CGFloat height = [theDelegate tableView:self heightForFooterInSection:section];
     
     return (height > GNESectionedTableViewInvisibleRowHeight);
 }
 
 
-// ------------------------------------------------------------------------------------------
-#pragma mark - GNESectionedTableView - Internal - Insert, Delete, Move Outline View Items
-// ------------------------------------------------------------------------------------------
 /**
- Returns an array of arrays. Each inner array contains all of the specified index paths belonging to the same 
- section. The sections and rows are all sorted in ascending order (from smallest to largest).
+ Returns the height of the header in the specified section.
  
- @param indexPaths Array of index paths to group and sort.
- @return Array of arrays of index paths sorted in ascending order by section and row.
+ @discussion Returns the height returned by the table view delegate if it responds to
+ tableView:heightForHeaderInSection:, tableView:rowViewForHeaderInSection:, and
+ tableView:cellViewForHeaderInSection: and if the height is greater than
+ GNESectionedTableViewInvisibleRowHeight, otherwise GNESectionedTableViewInvisibleRowHeight.
+ @param section Section to query the delegate for.
+ @return Height of the header in the specified section.
  */
-- (NSArray *)p_sortedIndexPathsGroupedBySectionInIndexPaths:(NSArray *)indexPaths
+- (CGFloat)p_requestDelegateHeightOfHeaderInSection:(NSUInteger)section
 {
-    SEL comparator = NSSelectorFromString(@"gne_compare:");
+    SEL heightSelector = @selector(tableView:heightForHeaderInSection:);
+    SEL rowViewSelector = @selector(tableView:rowViewForHeaderInSection:);
+    SEL cellViewSelector = @selector(tableView:cellViewForHeaderInSection:);
+    
+    id <GNESectionedTableViewDelegate> theDelegate = self.tableViewDelegate;
     
-    return [self p_sortedIndexPathsGroupedBySectionInIndexPaths:indexPaths usingSelector:comparator];
+    if ([theDelegate respondsToSelector:heightSelector] == NO ||
+        [theDelegate respondsToSelector:rowViewSelector] == NO ||
+        [theDelegate respondsToSelector:cellViewSelector] == NO)
+    {
+        return GNESectionedTableViewInvisibleRowHeight;
+    }
+    
+    GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:heightForHeaderInSection:));
+    CGFloat height = [theDelegate tableView:self heightForHeaderInSection:section];
+    
+    return ((height > GNESectionedTableViewInvisibleRowHeight) ? height : GNESectionedTableViewInvisibleRowHeight);
 }
 
 
-/**
- Returns an array of arrays. Each inner array contains all of the specified index paths belonging to the same
- section. The sections and rows are all sorted in descending order (from largest to smallest).
- 
- @param indexPaths Array of index paths to group and sort.
- @return Array of arrays of index paths sorted in descending order by section and row.
- */
-- (NSArray *)p_reverseSortedIndexPathsGroupedBySectionInIndexPaths:(NSArray *)indexPaths
+/// Returns the height of the footer in the specified section returned by the table view delegate.
+- (CGFloat)p_requestDelegateHeightOfFooterInSection:(NSUInteger)section
 {
-    SEL comparator = NSSelectorFromString(@"gne_reverseCompare:");
+    GNEParameterAssert([self.tableViewDelegate respondsToSelector:@selector(tableView:heightForFooterInSection:)]);
     
-    return [self p_sortedIndexPathsGroupedBySectionInIndexPaths:indexPaths usingSelector:comparator];
+    GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:heightForFooterInSection:));
+    return [self.tableViewDelegate tableView:self heightForFooterInSection:section];
 }
 
 
-- (NSArray *)p_sortedIndexPathsGroupedBySectionInIndexPaths:(NSArray *)indexPaths usingSelector:(SEL)comparator
+/// Returns the uniform height of the rows in the specified section returned by the table view delegate or
+/// GNESectionedTableViewNonUniformRowHeight if the delegate doesn't return one.
+- (CGFloat)p_requestDelegateUniformHeightOfRowsInSection:(NSUInteger)section
 {
-    NSMutableArray *groupedIndexPaths = [NSMutableArray array];
-    NSArray *sortedIndexPaths = [indexPaths sortedArrayUsingSelector:comparator];
+    id <GNESectionedTableViewDelegate> theDelegate = self.tableViewDelegate;
+    if ([theDelegate respondsToSelector:@selector(tableView:uniformHeightForRowsInSection:)] == NO)
+    {
+        return GNESectionedTableViewNonUniformRowHeight;
+    }
     
-    NSUInteger currentSection = NSNotFound;
-    NSMutableArray *indexPathsInCurrentSection = nil;
+    GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:uniformHeightForRowsInSection:));
     
-    for (NSIndexPath *indexPath in sortedIndexPaths)
+    return [theDelegate tableView:self uniformHeightForRowsInSection:section];
+}
+
+
+/**
+ Fills the specified buffer with the heights of the rows in the specified range of the specified section.
+ 
+ @discussion Asks the table view delegate for a uniform height for the section first. If the rows in the
+ section don't have a uniform height, the delegate is asked for the heights of all of the rows at once
+ and, if it doesn't support that, for the height of each row. If the delegate doesn't respond to any of
+ those methods, the default row height is used.
+ @param heights Buffer with room for range.length heights.
+ @param range Range of the rows to measure.
+ @param section Section containing the rows.
+ */
+- (void)p_requestDelegateHeights:(CGFloat *)heights ofRowsInRange:(NSRange)range inSection:(NSUInteger)section
+{
+    if (range.length == 0)
     {
-        if (currentSection != indexPath.gne_section)
-        {
-            currentSection = indexPath.gne_section;
-            indexPathsInCurrentSection = [NSMutableArray array];
-            [groupedIndexPaths addObject:indexPathsInCurrentSection];
-        }
-        
-        [indexPathsInCurrentSection addObject:indexPath];
+        return;
     }
     
-    return groupedIndexPaths;
+    [self p_requestDelegateHeights:heights
+                     ofRowsInRange:range
+                         inSection:section
+                     uniformHeight:[self p_requestDelegateUniformHeightOfRowsInSection:section]];
 }
 
 
 /**
- Returns an index set that contains all of the valid section indexes in the specified index set.
+ Fills the specified buffer with the heights of the rows in the specified range of the specified section,
+ like -p_requestDelegateHeights:ofRowsInRange:inSection:, using the specified uniform height instead of
+ asking the table view delegate for it again.
  
- @param sections Index set containing indexes corresponding to outline view parent items in the outline view parent
- items array.
- @return Index set containing all of the valid section indexes in the specified index set.
+ @param heights Buffer with room for range.length heights.
+ @param range Range of the rows to measure.
+ @param section Section containing the rows.
+ @param uniformHeight Uniform height of the rows in the section returned by
+ -p_requestDelegateUniformHeightOfRowsInSection:.
  */
-- (NSIndexSet *)p_indexSetByRemovingInvalidSectionsFromIndexSet:(NSIndexSet *)sections
+- (void)p_requestDelegateHeights:(CGFloat *)heights
+                   ofRowsInRange:(NSRange)range
+                       inSection:(NSUInteger)section
+                   uniformHeight:(CGFloat)uniformHeight
 {
-    GNEParameterAssert(self.outlineViewParentItems.count == self.outlineViewItems.count);
+    id <GNESectionedTableViewDelegate> theDelegate = self.tableViewDelegate;
     
-    if (sections.count == 0)
+    if (uniformHeight != GNESectionedTableViewNonUniformRowHeight)
     {
-        return sections;
+        for (NSUInteger i = 0; i < range.length; i++)
+        {
+            heights[i] = uniformHeight;
+        }
+        
+        return;
     }
     
-    NSMutableIndexSet *validSections = [NSMutableIndexSet indexSet];
-    [validSections addIndexes:sections];
+    if ([theDelegate respondsToSelector:@selector(tableView:getHeights:forRowsInRange:inSection:)])
+    {
+        GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:getHeights:forRowsInRange:inSection:));
+        [theDelegate tableView:self getHeights:heights forRowsInRange:range inSection:section];
+        
+        return;
+    }
     
-    NSUInteger sectionCount = self.outlineViewParentItems.count;
+    if (self.delegateMethods.heightForRow)
+    {
+        for (NSUInteger i = 0; i < range.length; i++)
+        {
+            GNESectionedIndexPath indexPath = GNESectionedIndexPathMake(range.location + i, section);
+            GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:heightForRowAtSectionedIndexPath:));
+            heights[i] = [theDelegate tableView:self heightForRowAtSectionedIndexPath:indexPath];
+        }
+        
+        return;
+    }
     
-    [sections enumerateIndexesWithOptions:NSEnumerationReverse usingBlock:^(NSUInteger section, BOOL *stop)
+    BOOL respondsToHeightForRow = [theDelegate respondsToSelector:@selector(tableView:heightForRowAtIndexPath:)];
+    for (NSUInteger i = 0; i < range.length; i++)
     {
-        if (section < sectionCount)
+        if (respondsToHeightForRow)
         {
-            *stop = YES;
+            NSIndexPath *indexPath = [NSIndexPath gne_indexPathForRow:(range.location + i) inSection:section];
+            GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:heightForRowAtIndexPath:));
+            heights[i] = [theDelegate tableView:self heightForRowAtIndexPath:indexPath];
         }
         else
         {
-            [validSections removeIndex:section];
+            heights[i] = kDefaultRowHeight;
         }
-    }];
-    
-    return validSections;
+    }
 }
 
 
-- (void)p_updateAutoCollapsedSectionsForMoveFromSections:(GNEOrderedIndexSet *)fromSections
-                                              toSections:(GNEOrderedIndexSet *)toSections
+/**
+ Fills the specified buffer with the estimated heights of the rows in the specified range of the specified
+ section returned by the table view delegate or, if the delegate doesn't estimate the heights of rows, with
+ the table view's estimatedRowHeight.
+ 
+ @param heights Buffer with room for range.length heights.
+ @param range Range of the rows to estimate.
+ @param section Section containing the rows.
+ */
+- (void)p_requestDelegateEstimatedHeights:(CGFloat *)heights
+                            ofRowsInRange:(NSRange)range
+                                inSection:(NSUInteger)section
 {
-    if (self.autoCollapsedSections.count == 0)
+    id <GNESectionedTableViewDelegate> theDelegate = self.tableViewDelegate;
+    CGFloat height = self.estimatedRowHeight;
+    
+    if ([theDelegate respondsToSelector:@selector(tableView:estimatedHeightForRowsInSection:)])
+    {
+        GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:estimatedHeightForRowsInSection:));
+        height = [theDelegate tableView:self estimatedHeightForRowsInSection:section];
+    }
+    else if (self.delegateMethods.estimatedHeightForRow)
     {
+        for (NSUInteger i = 0; i < range.length; i++)
+        {
+            GNESectionedIndexPath indexPath = GNESectionedIndexPathMake(range.location + i, section);
+            GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:estimatedHeightForRowAtSectionedIndexPath:));
+            heights[i] = [theDelegate tableView:self estimatedHeightForRowAtSectionedIndexPath:indexPath];
+        }
+        
         return;
     }
-    
-    NSMutableIndexSet *updatedIndexSet = [NSMutableIndexSet indexSet];
-    
-    __weak typeof(self) weakSelf = self;
-    [fromSections enumerateIndexesUsingBlock:^(NSUInteger section,
-                                               NSUInteger position,
-                                               BOOL *stop __unused)
+    else if ([theDelegate respondsToSelector:@selector(tableView:estimatedHeightForRowAtIndexPath:)])
     {
-        __strong typeof(weakSelf) strongSelf = weakSelf;
-        if ([strongSelf.autoCollapsedSections containsIndex:section])
+        for (NSUInteger i = 0; i < range.length; i++)
         {
-            NSUInteger toSection = [toSections indexAtPosition:position];
-            if (toSection != NSNotFound)
-            {
-                [updatedIndexSet addIndex:toSection];
-            }
+            NSIndexPath *indexPath = [NSIndexPath gne_indexPathForRow:(range.location + i) inSection:section];
+            GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:estimatedHeightForRowAtIndexPath:));
+            heights[i] = [theDelegate tableView:self estimatedHeightForRowAtIndexPath:indexPath];
         }
-    }];
+        
+        return;
+    }
     
-    [self.autoCollapsedSections removeAllIndexes];
-    [self.autoCollapsedSections addIndexes:updatedIndexSet];
+    for (NSUInteger i = 0; i < range.length; i++)
+    {
+        heights[i] = height;
+    }
 }
 
 
-// ------------------------------------------------------------------------------------------
-#pragma mark - GNESectionedTableView - Internal - Retrieving Outline View Items
-// ------------------------------------------------------------------------------------------
 /**
- Returns the index pointing to the specified outline view parent item in the outline view parent items array.
+ Returns how the heights of the rows of the specified section are measured and, by reference, the uniform
+ height of its rows, so that the table view delegate is asked for the uniform height only once.
  
- @param parentItem Outline view parent item to locate.
- @return Index matching the current location of the specified outline view parent item in table view's outline
- view parent items array, or NSNotFound if the outline view parent item could not be found.
+ @param section Section containing the rows.
+ @param measuringBlock Block returned by -p_requestDelegateRowHeightMeasuringBlock, which callers request
+ once per measurement pass instead of once per section.
+ @param uniformHeight On return, the uniform height of the rows in the section or
+ GNESectionedTableViewNonUniformRowHeight.
+ @return How the heights of the rows of the section are measured.
  */
-- (NSUInteger)p_sectionForOutlineViewParentItem:(GNEOutlineViewParentItem *)parentItem
+- (GNERowHeightMeasurement)p_rowHeightMeasurementInSection:(NSUInteger)section
+                                            measuringBlock:(GNESectionedTableViewRowHeightMeasuringBlock)measuringBlock
+                                             uniformHeight:(CGFloat *)uniformHeight
 {
-    NSUInteger index = [self.outlineViewParentItems indexOfObject:parentItem];
+    *uniformHeight = [self p_requestDelegateUniformHeightOfRowsInSection:section];
+    if (*uniformHeight != GNESectionedTableViewNonUniformRowHeight)
+    {
+        return GNERowHeightMeasurementImmediate;
+    }
+    else if (measuringBlock)
+    {
+        return GNERowHeightMeasurementAsynchronous;
+    }
+    else if ([self p_delegateEstimatesRowHeights])
+    {
+        return GNERowHeightMeasurementEstimated;
+    }
     
-    return index;
+    return GNERowHeightMeasurementImmediate;
 }
 
 
 /**
- Returns an index set of all of the section headers contained in the specified row indexes, or nil if the
- row indexes do not correspond to any section headers.
+ Asks the table view delegate for the heights of the header, rows, and footer of the specified section
+ and caches them in the specified outline view parent item and outline view item array.
  
- @param rowIndexes Table view indexes.
- @return Index set of the section headers or nil if the specified row indexes don't correspond to any
- section headers.
+ @param section Section to query the delegate for.
+ @param parentItem Outline view parent item representing the section's header.
+ @param rows Outline view item array containing the section's rows and footer.
+ @param measuringBlock Block returned by -p_requestDelegateRowHeightMeasuringBlock or nil.
  */
-- (NSIndexSet *)p_indexSetOfSectionHeadersAtTableViewRows:(NSIndexSet *)rowIndexes
+- (void)p_measureSection:(NSUInteger)section
+    withOutlineViewParentItem:(GNEOutlineViewParentItem *)parentItem
+                         rows:(GNEOutlineViewItemArray *)rows
+               measuringBlock:(GNESectionedTableViewRowHeightMeasuringBlock)measuringBlock
 {
-    NSMutableIndexSet *sectionIndexes = [NSMutableIndexSet indexSet];
+    parentItem.height = [self p_requestDelegateHeightOfHeaderInSection:section];
     
-    __weak typeof(self) weakSelf = self;
-    [rowIndexes enumerateIndexesUsingBlock:^(NSUInteger tableViewRow, BOOL *stop __unused)
+    NSUInteger rowCount = rows.count - ((parentItem.hasFooter) ? 1 : 0);
+    CGFloat *heights = calloc(rows.count + 1, sizeof(CGFloat));
+    if (heights == NULL)
     {
-        __strong typeof(weakSelf) strongSelf = weakSelf;
-        GNEOutlineViewItem *item = [strongSelf itemAtRow:(NSInteger)tableViewRow];
-        if (item && item.parentItem == nil)
+        [NSException raise:kMemoryAllocationAssertionName format:@"%@", kMemoryAllocationAssertionReason];
+    }
+    
+    GNERowHeightMeasurement measurement = GNERowHeightMeasurementImmediate;
+    if (rowCount > 0)
+    {
+        CGFloat uniformHeight = GNESectionedTableViewNonUniformRowHeight;
+        measurement = [self p_rowHeightMeasurementInSection:section
+                                             measuringBlock:measuringBlock
+                                              uniformHeight:&uniformHeight];
+        if (measurement == GNERowHeightMeasurementImmediate)
         {
-            GNEParameterAssert([item isKindOfClass:[GNEOutlineViewParentItem class]]);
-            NSUInteger section = [strongSelf p_sectionForOutlineViewParentItem:(GNEOutlineViewParentItem *)item];
-            if (section != NSNotFound)
-            {
-                [sectionIndexes addIndex:section];
-            }
+            [self p_requestDelegateHeights:heights
+                             ofRowsInRange:NSMakeRange(0, rowCount)
+                                 inSection:section
+                             uniformHeight:uniformHeight];
+        }
+        else
+        {
+            [self p_requestDelegateEstimatedHeights:heights ofRowsInRange:NSMakeRange(0, rowCount) inSection:section];
         }
+    }
+    if (parentItem.hasFooter)
+    {
+        heights[rowCount] = [self p_requestDelegateHeightOfFooterInSection:section];
+    }
+    
+    [rows setHeightsUsingBlock:^CGFloat(GNEOutlineViewItem * __unused item, NSUInteger index)
+    {
+        return heights[index];
     }];
     
-    return ((sectionIndexes.count > 0) ? [sectionIndexes copy] : nil);
+    free(heights);
+    
+    NSIndexSet *allRows = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, rowCount)];
+    if (measurement == GNERowHeightMeasurementAsynchronous)
+    {
+        [self p_setNeedsHeightsOfRows:allRows ofParentItem:parentItem];
+    }
+    else if (measurement == GNERowHeightMeasurementEstimated)
+    {
+        [self p_addEstimatedRows:allRows toParentItem:parentItem];
+    }
 }
 
 
 /**
- Returns an index set of all of the section footers contained in the specified row indexes, or nil if the
- row indexes do not correspond to any section footers.
+ Asks the table view delegate for the heights of the rows at the specified indexes of the specified section
+ and caches them in the section's outline view item array.
  
- @param rowIndexes Table view indexes.
- @return Index set of the section footers or nil if the specified row indexes don't correspond to any
- section footers.
+ @discussion The delegate is asked once for each contiguous range of rows. If the rows are measured on
+ background queues or lazily, their estimated heights are cached instead.
+ @param indexes Indexes of the rows to measure.
+ @param section Section containing the rows.
+ @param measuringBlock Block returned by -p_requestDelegateRowHeightMeasuringBlock or nil.
  */
-- (NSIndexSet *)p_indexSetOfSectionFootersAtTableViewRows:(NSIndexSet *)rowIndexes
+- (void)p_measureRowsAtIndexes:(NSIndexSet *)indexes
+                     inSection:(NSUInteger)section
+                measuringBlock:(GNESectionedTableViewRowHeightMeasuringBlock)measuringBlock
 {
-    NSMutableIndexSet *sectionIndexes = [NSMutableIndexSet indexSet];
+    if (indexes.count == 0)
+    {
+        return;
+    }
     
-    __weak typeof(self) weakSelf = self;
-    [rowIndexes enumerateIndexesUsingBlock:^(NSUInteger tableViewRow, BOOL *stop __unused)
+    GNEOutlineViewItemArray *rows = [self.model itemsInSection:section];
+    CGFloat uniformHeight = GNESectionedTableViewNonUniformRowHeight;
+    GNERowHeightMeasurement measurement = [self p_rowHeightMeasurementInSection:section
+                                                                 measuringBlock:measuringBlock
+                                                                  uniformHeight:&uniformHeight];
+    
+    [indexes enumerateRangesUsingBlock:^(NSRange range, BOOL *stop __unused)
     {
-        __strong typeof(weakSelf) strongSelf = weakSelf;
-        GNEOutlineViewItem *item = [strongSelf itemAtRow:(NSInteger)tableViewRow];
-        BOOL isFooter = [self p_isOutlineViewItemFooter:item];
-        if (isFooter)
+        CGFloat *heights = calloc(range.length, sizeof(CGFloat));
+        if (heights == NULL)
         {
-            NSUInteger section = [self p_sectionForOutlineViewParentItem:item.parentItem];
-            
-            if (section != NSNotFound)
-            {
-                [sectionIndexes addIndex:section];
-            }
+            [NSException raise:kMemoryAllocationAssertionName format:@"%@", kMemoryAllocationAssertionReason];
+        }
+        
+        if (measurement == GNERowHeightMeasurementImmediate)
+        {
+            [self p_requestDelegateHeights:heights ofRowsInRange:range inSection:section uniformHeight:uniformHeight];
+        }
+        else
+        {
+            [self p_requestDelegateEstimatedHeights:heights ofRowsInRange:range inSection:section];
         }
+        for (NSUInteger i = 0; i < range.length; i++)
+        {
+            [rows setHeight:heights[i] forObjectAtIndex:(range.location + i)];
+        }
+        
+        free(heights);
     }];
     
-    return ((sectionIndexes.count > 0) ? [sectionIndexes copy] : nil);
+    GNEOutlineViewParentItem *parentItem = [self.model parentItemForSection:section];
+    if (measurement == GNERowHeightMeasurementAsynchronous)
+    {
+        [self p_setNeedsHeightsOfRows:indexes ofParentItem:parentItem];
+    }
+    else if (measurement == GNERowHeightMeasurementEstimated)
+    {
+        [self p_addEstimatedRows:indexes toParentItem:parentItem];
+    }
 }
 
 
-- (NSIndexSet *)p_indexSetOfTableViewRowsForIndexPaths:(NSArray *)indexPaths
-{
-    if (indexPaths.count == 0)
-    {
-        return nil;
+// ------------------------------------------------------------------------------------------
+#pragma mark - GNESectionedTableView - Internal - Insert, Delete, Move Outline View Items
+// ------------------------------------------------------------------------------------------
+/**
+ Returns an array of arrays. Each inner array contains all of the specified index paths belonging to the same 
+ section. The sections and rows are all sorted in ascending order (from smallest to largest).
+ 
+ @param indexPaths Array of index paths to group and sort.
+ @return Array of arrays of index paths sorted in ascending order by section and row.
+ */
+- (NSArray *)p_sortedIndexPathsGroupedBySectionInIndexPaths:(NSArray *)indexPaths
+{
+    return [self p_sortedIndexPathsGroupedBySectionInIndexPaths:indexPaths ascending:YES];
+}
+
+
+/**
+ Returns an array of arrays. Each inner array contains all of the specified index paths belonging to the same
+ section. The sections and rows are all sorted in descending order (from largest to smallest).
+ 
+ @param indexPaths Array of index paths to group and sort.
+ @return Array of arrays of index paths sorted in descending order by section and row.
+ */
+- (NSArray *)p_reverseSortedIndexPathsGroupedBySectionInIndexPaths:(NSArray *)indexPaths
+{
+    return [self p_sortedIndexPathsGroupedBySectionInIndexPaths:indexPaths ascending:NO];
+}
+
+
+/**
+ Groups and sorts the specified index paths in linear time by copying them into a buffer of sectioned
+ index paths, radix sorting the buffer, and splitting it into runs of the same section. Index paths that
+ don't have two indexes are dropped.
+ */
+- (NSArray *)p_sortedIndexPathsGroupedBySectionInIndexPaths:(NSArray *)indexPaths ascending:(BOOL)ascending
+{
+    NSMutableArray *groupedIndexPaths = [NSMutableArray array];
+    NSUInteger count = indexPaths.count;
+    
+    GNESectionedIndexPath *sortedIndexPaths = calloc(MAX(count, (NSUInteger)1), sizeof(GNESectionedIndexPath));
+    if (sortedIndexPaths == NULL)
+    {
+        return groupedIndexPaths;
     }
     
-    NSMutableIndexSet *mutableIndexSet = [NSMutableIndexSet indexSet];
+    NSUInteger index = 0;
     for (NSIndexPath *indexPath in indexPaths)
     {
-        NSInteger tableViewRow = [self tableViewRowForIndexPath:indexPath];
-        if (tableViewRow >= 0)
+        sortedIndexPaths[index++] = GNESectionedIndexPathFromNSIndexPath(indexPath);
+    }
+    
+    if (ascending)
+    {
+        GNESectionedIndexPathSort(sortedIndexPaths, count);
+    }
+    else
+    {
+        GNESectionedIndexPathReverseSort(sortedIndexPaths, count);
+    }
+    
+    GNESectionedIndexPathEnumerateSections(sortedIndexPaths, count, ^(NSUInteger section,
+                                                                      NSRange range,
+                                                                      BOOL *stop __unused)
+    {
+        if (section == NSNotFound)
         {
-            [mutableIndexSet addIndex:(NSUInteger)tableViewRow];
+            return;
+        }
+        
+        NSMutableArray *indexPathsInSection = [NSMutableArray arrayWithCapacity:range.length];
+        for (NSUInteger i = range.location; i < NSMaxRange(range); i++)
+        {
+            [indexPathsInSection addObject:GNESectionedIndexPathToNSIndexPath(sortedIndexPaths[i])];
+        }
+        [groupedIndexPaths addObject:indexPathsInSection];
+    });
+    
+    free(sortedIndexPaths);
+    
+    return groupedIndexPaths;
+}
+
+
+/**
+ Returns an index set that contains all of the valid section indexes in the specified index set.
+ 
+ @param sections Index set containing indexes corresponding to outline view parent items in the outline view parent
+ items array.
+ @return Index set containing all of the valid section indexes in the specified index set.
+ */
+- (NSIndexSet *)p_indexSetByRemovingInvalidSectionsFromIndexSet:(NSIndexSet *)sections
+{
+    if (sections.count == 0)
+    {
+        return sections;
+    }
+    
+    NSMutableIndexSet *validSections = [NSMutableIndexSet indexSet];
+    [validSections addIndexes:sections];
+    
+    NSUInteger sectionCount = self.model.numberOfSections;
+    
+    [sections enumerateIndexesWithOptions:NSEnumerationReverse usingBlock:^(NSUInteger section, BOOL *stop)
+    {
+        if (section < sectionCount)
+        {
+            *stop = YES;
+        }
+        else
+        {
+            [validSections removeIndex:section];
         }
+    }];
+    
+    return validSections;
+}
+
+
+- (void)p_updateAutoCollapsedSectionsForMoveFromSections:(GNEOrderedIndexSet *)fromSections
+                                              toSections:(GNEOrderedIndexSet *)toSections
+{
+    if (self.autoCollapsedSections.count == 0)
+    {
+        return;
     }
     
-    return ((mutableIndexSet.count > 0) ? [mutableIndexSet copy] : nil);
+    // Find the positions of the collapsed sections range by range instead of section by section.
+    NSMutableIndexSet *collapsedPositions = [NSMutableIndexSet indexSet];
+    NSIndexSet *autoCollapsedSections = self.autoCollapsedSections;
+    [fromSections enumerateRangesUsingBlock:^(NSRange range, NSUInteger position, BOOL *stop __unused)
+    {
+        [autoCollapsedSections enumerateRangesInRange:range
+                                              options:0
+                                           usingBlock:^(NSRange collapsedRange, BOOL *innerStop __unused)
+        {
+            [collapsedPositions addIndexesInRange:NSMakeRange(position + collapsedRange.location - range.location,
+                                                              collapsedRange.length)];
+        }];
+    }];
+    
+    NSIndexSet *updatedIndexSet = [self p_sectionsInSections:toSections atPositions:collapsedPositions];
+    
+    [self.autoCollapsedSections removeAllIndexes];
+    [self.autoCollapsedSections addIndexes:updatedIndexSet];
 }
 
 
-- (NSIndexSet *)p_indexSetOfTableViewRowsForHeadersInSections:(NSIndexSet *)sectionIndexes
+/**
+ Returns the sections located at the specified positions of the specified ordered sections. Positions
+ beyond the end of the ordered sections are ignored.
+ */
+- (NSIndexSet *)p_sectionsInSections:(GNEOrderedIndexSet *)sections atPositions:(NSIndexSet *)positions
 {
-    return [self p_indexSetOfTableViewRowsForAccessoryViewsInSections:sectionIndexes
-                                                          rowModifier:kSectionHeaderRowModifier];
+    NSMutableIndexSet *sectionsAtPositions = [NSMutableIndexSet indexSet];
+    
+    [sections enumerateRangesUsingBlock:^(NSRange range, NSUInteger position, BOOL *stop __unused)
+    {
+        [positions enumerateRangesInRange:NSMakeRange(position, range.length)
+                                  options:0
+                               usingBlock:^(NSRange positionRange, BOOL *innerStop __unused)
+        {
+            [sectionsAtPositions addIndexesInRange:NSMakeRange(range.location + positionRange.location - position,
+                                                               positionRange.length)];
+        }];
+    }];
+    
+    return [sectionsAtPositions copy];
 }
 
 
-- (NSIndexSet *)p_indexSetOfTableViewRowsForFootersInSections:(NSIndexSet *)sectionIndexes
+/**
+ Inserts rows into the model and the outline view. The caller is responsible for the enclosing
+ -beginUpdates and -endUpdates.
+ 
+ @param groupedIndexPaths Index paths of the new rows grouped by section and sorted in ascending order.
+ @param animationOptions Animation used for the insertions.
+ */
+- (void)p_insertRowsAtIndexPathsGroupedBySection:(NSArray *)groupedIndexPaths
+                                   withAnimation:(NSTableViewAnimationOptions)animationOptions
 {
-    return [self p_indexSetOfTableViewRowsForAccessoryViewsInSections:sectionIndexes
-                                                          rowModifier:kSectionFooterRowModifier];
+    GNESectionedTableViewRowHeightMeasuringBlock measuringBlock = [self p_requestDelegateRowHeightMeasuringBlock];
+    
+    for (NSArray *indexPathsInSection in groupedIndexPaths)
+    {
+        @autoreleasepool
+        {
+            NSUInteger section = ((NSIndexPath *)indexPathsInSection.firstObject).gne_section;
+            
+            GNEOutlineViewParentItem *parentItem = [self.model parentItemForSection:section];
+            GNEAssert1(parentItem, @"No outline view parent item exists for section %lu", (long unsigned)section);
+            
+            if (parentItem == nil)
+            {
+                continue;
+            }
+            
+            NSIndexSet *insertedIndexes = [self.model insertRowsAtIndexPaths:indexPathsInSection
+                                                                   inSection:section];
+            
+            [self p_updateUnmeasuredRowsOfParentItem:parentItem insertedIndexes:insertedIndexes deletedIndexes:nil];
+            [self p_measureRowsAtIndexes:insertedIndexes inSection:section measuringBlock:measuringBlock];
+            [self p_noteRowViewsShiftedStartingAtRow:insertedIndexes.firstIndex inSection:section];
+            [self p_updateHeightOfSection:section];
+            
+            [self insertItemsAtIndexes:insertedIndexes inParent:parentItem withAnimation:animationOptions];
+        }
+    }
+}
+
+
+/**
+ Deletes rows from the model and the outline view. The caller is responsible for the enclosing
+ -beginUpdates and -endUpdates.
+ 
+ @param groupedIndexPaths Index paths of the rows grouped by section and sorted in descending order.
+ @param animationOptions Animation used for the deletions.
+ */
+- (void)p_deleteRowsAtIndexPathsGroupedBySection:(NSArray *)groupedIndexPaths
+                                   withAnimation:(NSTableViewAnimationOptions)animationOptions
+{
+    for (NSArray *indexPathsInSection in groupedIndexPaths)
+    {
+        NSUInteger section = ((NSIndexPath *)indexPathsInSection.firstObject).gne_section;
+        GNEOutlineViewParentItem *parentItem = [self.model parentItemForSection:section];
+        
+        if (parentItem == nil)
+        {
+            continue;
+        }
+        
+        // Delete the actual items from the model and keep their rows for the NSOutlineView.
+        NSIndexSet *deletedIndexes = [self.model deleteRowsAtIndexPaths:indexPathsInSection inSection:section];
+        
+        if (deletedIndexes.count == 0)
+        {
+            continue;
+        }
+        
+        [self p_updateUnmeasuredRowsOfParentItem:parentItem insertedIndexes:nil deletedIndexes:deletedIndexes];
+        [self p_updateHeightOfSection:section];
+        [self p_noteRowViewsShiftedStartingAtRow:deletedIndexes.firstIndex inSection:section];
+        
+        // Delete the outline view rows with the supplied animation.
+        [self removeItemsAtIndexes:deletedIndexes inParent:parentItem withAnimation:animationOptions];
+    }
+}
+
+
+/// Inserts sections into the model and the outline view and, if expanded is YES, expands them
+/// when the outermost update ends.
+- (void)p_insertSections:(NSIndexSet *)sections
+           withAnimation:(NSTableViewAnimationOptions)animationOptions
+                expanded:(BOOL)expanded
+{
+    NSIndexSet *insertedSections = [self p_insertOutlineViewParentItemsAtSections:sections];
+    
+    GNEParameterAssert(sections.count == insertedSections.count);
+    
+    [self.appendQueue insertSections:insertedSections];
+    [self p_insertHeightsOfSections:insertedSections];
+    [self p_noteRowViewsShiftedStartingAtSection:insertedSections.firstIndex];
+    
+    [self insertItemsAtIndexes:insertedSections inParent:nil withAnimation:animationOptions];
+    
+    if (expanded)
+    {
+        [self.insertedSectionsToExpand addIndexes:insertedSections];
+    }
+}
+
+
+/**
+ Removes the rows still queued with -appendRows:toSection: for the specified sections, which are about
+ to be moved, and returns a block that queues them again for the sections they are moved to, or nil if
+ none of the sections has queued rows.
+ 
+ @discussion Moved sections are deleted and inserted again, which would discard their queued rows. The
+ block must be called once the sections have been moved. The queued rows of the other sections are kept
+ in sync by the deletions and insertions themselves.
+ */
+- (void (^)(void))p_requeueBlockForRowsQueuedForSectionsMovedFromSections:(GNEOrderedIndexSet *)fromSections
+                                                               toSections:(GNEOrderedIndexSet *)toSections
+{
+    NSDictionary *queuedRowCounts = [self.appendQueue removeRowsInSections:fromSections.ns_indexSet];
+    if (queuedRowCounts.count == 0)
+    {
+        return nil;
+    }
+    
+    __weak typeof(self) weakSelf = self;
+    return [^()
+    {
+        __strong typeof(weakSelf) strongSelf = weakSelf;
+        [fromSections enumerateIndexesUsingBlock:^(NSUInteger section, NSUInteger position, BOOL *stop __unused)
+        {
+            NSNumber *rowCount = queuedRowCounts[@(section)];
+            if (rowCount)
+            {
+                [strongSelf.appendQueue appendRows:rowCount.unsignedIntegerValue
+                                         toSection:[toSections indexAtPosition:position]];
+            }
+        }];
+    } copy];
+}
+
+
+/// Deletes sections from the model and the outline view.
+- (void)p_deleteSections:(NSIndexSet *)sections withAnimation:(NSTableViewAnimationOptions)animationOptions
+{
+    NSIndexSet *deletedSections = [self.model deleteSections:sections];
+    
+    GNEParameterAssert(sections.count == deletedSections.count);
+    
+    [self.appendQueue removeSections:deletedSections];
+    
+    [self.sectionHeights removeValuesAtIndexes:deletedSections];
+    [self p_noteRowViewsShiftedStartingAtSection:deletedSections.firstIndex];
+    
+    [self removeItemsAtIndexes:deletedSections inParent:nil withAnimation:animationOptions];
+}
+
+
+/**
+ Applies the updates collected by -performBatchUpdates:completion: in a single transaction. Rows and
+ sections are deleted using the index paths from before the batch, then inserted using the index paths
+ from after it. Reloaded items are looked up before anything changes and reloaded after everything
+ else, so that their views are requested for their new index paths. The inserted sections are
+ expanded, the row view map is updated, and the data source is checked only once, at the end.
+ */
+- (void)p_applyBatchUpdate:(GNESectionedTableViewBatchUpdate *)batchUpdate
+{
+    NSMutableArray *reloadedItems = [NSMutableArray array];
+    [reloadedItems addObjectsFromArray:[self p_itemsAtIndexPaths:batchUpdate.reloadedRowIndexPaths]];
+    [reloadedItems addObjectsFromArray:[self p_itemsInSections:batchUpdate.reloadedSections]];
+    
+    [self beginUpdates];
+    
+    [self p_deleteRowsAtIndexPathsGroupedBySection:batchUpdate.deletedRowIndexPathsGroupedBySection
+                                     withAnimation:batchUpdate.rowDeletionAnimationOptions];
+    
+    NSIndexSet *deletedSections = batchUpdate.deletedSections;
+    if (deletedSections.count > 0)
+    {
+        [self p_deleteSections:deletedSections withAnimation:batchUpdate.sectionDeletionAnimationOptions];
+    }
+    
+    NSIndexSet *insertedSections = batchUpdate.insertedSections;
+    if (insertedSections.count > 0)
+    {
+        [self p_insertSections:insertedSections
+                 withAnimation:batchUpdate.sectionInsertionAnimationOptions
+                      expanded:YES];
+        [self.insertedSectionsToExpand removeIndexes:batchUpdate.collapsedInsertedSections];
+    }
+    
+    [self p_insertRowsAtIndexPathsGroupedBySection:batchUpdate.insertedRowIndexPathsGroupedBySection
+                                     withAnimation:batchUpdate.rowInsertionAnimationOptions];
+    
+    [self p_reloadVisibleTableViewRows:[self p_indexSetOfTableViewRowsForOutlineViewItems:reloadedItems]];
+    
+    [self endUpdates];
+    
+    [self p_checkDataSourceIntegrity];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - GNESectionedTableView - Internal - Retrieving Outline View Items
+// ------------------------------------------------------------------------------------------
+/// Returns the outline view items at the specified index paths, skipping invalid index paths.
+- (NSArray *)p_itemsAtIndexPaths:(NSArray *)indexPaths
+{
+    NSMutableArray *items = [NSMutableArray arrayWithCapacity:indexPaths.count];
+    for (NSIndexPath *indexPath in indexPaths)
+    {
+        GNEOutlineViewItem *item = [self.model itemAtIndexPath:indexPath];
+        if (item)
+        {
+            [items addObject:item];
+        }
+    }
+    
+    return [items copy];
+}
+
+
+/// Returns the outline view parent items of the specified sections followed by their rows and footers
+/// that have been created. Items that haven't been created yet have nothing to reload.
+- (NSArray *)p_itemsInSections:(NSIndexSet *)sections
+{
+    NSMutableArray *items = [NSMutableArray array];
+    [sections enumerateIndexesUsingBlock:^(NSUInteger section, BOOL *stop __unused)
+    {
+        GNEOutlineViewParentItem *parentItem = [self.model parentItemForSection:section];
+        if (parentItem == nil)
+        {
+            return;
+        }
+        
+        [items addObject:parentItem];
+        GNEOutlineViewItemArray *children = [self.model itemsInSection:section];
+        [children enumerateMaterializedObjectsUsingBlock:^(GNEOutlineViewItem *child,
+                                                           NSUInteger index __unused,
+                                                           BOOL *stopChildren __unused)
+        {
+            [items addObject:child];
+        }];
+    }];
+    
+    return [items copy];
+}
+
+
+/**
+ Returns an index set of all of the section headers contained in the specified row indexes, or nil if the
+ row indexes do not correspond to any section headers.
+ 
+ @param rowIndexes Table view indexes.
+ @return Index set of the section headers or nil if the specified row indexes don't correspond to any
+ section headers.
+ */
+- (NSIndexSet *)p_indexSetOfSectionHeadersAtTableViewRows:(NSIndexSet *)rowIndexes
+{
+    NSMutableIndexSet *sectionIndexes = [NSMutableIndexSet indexSet];
+    
+    __weak typeof(self) weakSelf = self;
+    [rowIndexes enumerateIndexesUsingBlock:^(NSUInteger tableViewRow, BOOL *stop __unused)
+    {
+        __strong typeof(weakSelf) strongSelf = weakSelf;
+        GNEOutlineViewItem *item = [strongSelf itemAtRow:(NSInteger)tableViewRow];
+        if (item && item.parentItem == nil)
+        {
+            GNEParameterAssert([item isKindOfClass:[GNEOutlineViewParentItem class]]);
+            NSUInteger section = [strongSelf.model sectionForParentItem:(GNEOutlineViewParentItem *)item];
+            if (section != NSNotFound)
+            {
+                [sectionIndexes addIndex:section];
+            }
+        }
+    }];
+    
+    return ((sectionIndexes.count > 0) ? [sectionIndexes copy] : nil);
+}
+
+
+/**
+ Returns an index set of all of the section footers contained in the specified row indexes, or nil if the
+ row indexes do not correspond to any section footers.
+ 
+ @param rowIndexes Table view indexes.
+ @return Index set of the section footers or nil if the specified row indexes don't correspond to any
+ section footers.
+ */
+- (NSIndexSet *)p_indexSetOfSectionFootersAtTableViewRows:(NSIndexSet *)rowIndexes
+{
+    NSMutableIndexSet *sectionIndexes = [NSMutableIndexSet indexSet];
+    
+    __weak typeof(self) weakSelf = self;
+    [rowIndexes enumerateIndexesUsingBlock:^(NSUInteger tableViewRow, BOOL *stop __unused)
+    {
+        __strong typeof(weakSelf) strongSelf = weakSelf;
+        GNEOutlineViewItem *item = [strongSelf itemAtRow:(NSInteger)tableViewRow];
+        BOOL isFooter = [self.model isItemFooter:item];
+        if (isFooter)
+        {
+            NSUInteger section = [self.model sectionForParentItem:item.parentItem];
+            
+            if (section != NSNotFound)
+            {
+                [sectionIndexes addIndex:section];
+            }
+        }
+    }];
+    
+    return ((sectionIndexes.count > 0) ? [sectionIndexes copy] : nil);
+}
+
+
+/**
+ Returns the index set of the table view rows displaying the specified index paths, or nil if none of
+ them are displayed. Invalid index paths and the rows of collapsed sections are skipped.
+ 
+ @discussion The index paths are grouped by section in a single pass, and the rows of each section are
+ converted to table view rows using the row of the section header, so neither outline view items nor
+ -rowForItem: lookups are needed for the rows themselves. O(n + r) for r ranges of rows
+ */
+- (NSIndexSet *)p_indexSetOfTableViewRowsForIndexPaths:(NSArray *)indexPaths
+{
+    NSUInteger count = indexPaths.count;
+    if (count == 0)
+    {
+        return nil;
+    }
+    
+    GNESectionedIndexPath *sortedIndexPaths = calloc(count, sizeof(GNESectionedIndexPath));
+    if (sortedIndexPaths == NULL)
+    {
+        return nil;
+    }
+    
+    NSMutableIndexSet *tableViewRows = [NSMutableIndexSet indexSet];
+    
+    NSUInteger index = 0;
+    for (NSIndexPath *indexPath in indexPaths)
+    {
+        sortedIndexPaths[index++] = GNESectionedIndexPathFromNSIndexPath(indexPath);
+    }
+    GNESectionedIndexPathSort(sortedIndexPaths, count);
+    
+    GNESectionedIndexPathEnumerateSections(sortedIndexPaths, count, ^(NSUInteger section,
+                                                                      NSRange range,
+                                                                      BOOL *stop __unused)
+    {
+        GNEOutlineViewParentItem *parentItem = [self.model parentItemForSection:section];
+        NSInteger headerRow = (parentItem) ? [self rowForItem:parentItem] : -1;
+        if (headerRow < 0)
+        {
+            return;
+        }
+        
+        NSMutableIndexSet *rows = [NSMutableIndexSet indexSet];
+        for (NSUInteger i = range.location; i < NSMaxRange(range); i++)
+        {
+            GNESectionedIndexPath indexPath = sortedIndexPaths[i];
+            if (GNESectionedIndexPathIsHeader(indexPath))
+            {
+                [tableViewRows addIndex:(NSUInteger)headerRow];
+            }
+            else if (GNESectionedIndexPathIsFooter(indexPath))
+            {
+                GNEOutlineViewItem *footer = [self.model footerItemInSection:section];
+                NSInteger footerRow = (footer) ? [self rowForItem:footer] : -1;
+                if (footerRow >= 0)
+                {
+                    [tableViewRows addIndex:(NSUInteger)footerRow];
+                }
+            }
+            else
+            {
+                [rows addIndex:indexPath.row];
+            }
+        }
+        
+        NSIndexSet *sectionTableViewRows = [self p_indexSetOfTableViewRowsForRows:rows inSection:section];
+        if (sectionTableViewRows)
+        {
+            [tableViewRows addIndexes:sectionTableViewRows];
+        }
+    });
+    
+    free(sortedIndexPaths);
+    
+    return ((tableViewRows.count > 0) ? [tableViewRows copy] : nil);
+}
+
+
+/// Returns the table view rows displaying the headers of the specified sections and, if the sections are
+/// expanded, their rows and footers. O(s)
+- (NSIndexSet *)p_indexSetOfTableViewRowsInSections:(NSIndexSet *)sections
+{
+    NSMutableIndexSet *tableViewRows = [NSMutableIndexSet indexSet];
+    [sections enumerateIndexesUsingBlock:^(NSUInteger section, BOOL *stop __unused)
+    {
+        GNEOutlineViewParentItem *parentItem = [self.model parentItemForSection:section];
+        NSInteger headerRow = (parentItem) ? [self rowForItem:parentItem] : -1;
+        if (headerRow < 0)
+        {
+            return;
+        }
+        
+        NSUInteger itemCount = ([self isItemExpanded:parentItem]) ? [self.model numberOfItemsInSection:section] : 0;
+        [tableViewRows addIndexesInRange:NSMakeRange((NSUInteger)headerRow, itemCount + 1)];
+    }];
+    
+    return [tableViewRows copy];
+}
+
+
+/// Returns the table view rows displaying the specified outline view items, skipping the items that
+/// aren't displayed.
+- (NSIndexSet *)p_indexSetOfTableViewRowsForOutlineViewItems:(NSArray *)items
+{
+    NSMutableIndexSet *tableViewRows = [NSMutableIndexSet indexSet];
+    for (GNEOutlineViewItem *item in items)
+    {
+        NSInteger tableViewRow = [self rowForItem:item];
+        if (tableViewRow >= 0)
+        {
+            [tableViewRows addIndex:(NSUInteger)tableViewRow];
+        }
+    }
+    
+    return [tableViewRows copy];
+}
+
+
+/**
+ Returns the index set of the table view rows displaying the specified rows of the specified section,
+ or nil if none of them are displayed. Section footers and rows beyond the end of the section are
+ ignored, as are the rows of collapsed sections.
+ 
+ @discussion The rows of an expanded section are displayed in consecutive table view rows following
+ its header, so each range of rows maps to a single range of table view rows. O(r) for r ranges
+ */
+- (NSIndexSet *)p_indexSetOfTableViewRowsForRows:(NSIndexSet *)rows inSection:(NSUInteger)section
+{
+    GNEOutlineViewParentItem *parentItem = [self.model parentItemForSection:section];
+    if (rows.count == 0 || parentItem == nil || [self isItemExpanded:parentItem] == NO)
+    {
+        return nil;
+    }
+    
+    NSInteger headerRow = [self rowForItem:parentItem];
+    if (headerRow < 0)
+    {
+        return nil;
+    }
+    
+    NSUInteger itemCount = [self.model numberOfItemsInSection:section];
+    NSUInteger rowCount = (parentItem.hasFooter && itemCount > 0) ? itemCount - 1 : itemCount;
+    NSUInteger firstTableViewRow = (NSUInteger)headerRow + 1;
+    
+    NSMutableIndexSet *tableViewRows = [NSMutableIndexSet indexSet];
+    [rows enumerateRangesInRange:NSMakeRange(0, rowCount)
+                         options:0
+                      usingBlock:^(NSRange range, BOOL *stop __unused)
+    {
+        [tableViewRows addIndexesInRange:NSMakeRange(firstTableViewRow + range.location, range.length)];
+    }];
+    
+    return ((tableViewRows.count > 0) ? [tableViewRows copy] : nil);
+}
+
+
+/**
+ Splits the specified table view rows into the section headers, section footers, and rows of each
+ section they display, without looking at the table view rows one by one.
+ 
+ @discussion Each range of table view rows is walked a section at a time. The section of the first
+ table view row is found from its outline view item, and the part of the range displaying the same
+ section is converted into a single range of rows. O(r + s) for r ranges spanning s sections
+ @param tableViewRows Table view rows to split.
+ @param headers On return, the sections whose headers are displayed in the table view rows.
+ @param footers On return, the sections whose footers are displayed in the table view rows.
+ @return Dictionary mapping sections (NSNumber) to the index sets of their rows displayed in the table
+ view rows.
+ */
+- (NSDictionary *)p_rowsBySectionForTableViewRows:(NSIndexSet *)tableViewRows
+                                          headers:(NSIndexSet **)headers
+                                          footers:(NSIndexSet **)footers
+{
+    NSMutableDictionary *rowsBySection = [NSMutableDictionary dictionary];
+    NSMutableIndexSet *headerSections = [NSMutableIndexSet indexSet];
+    NSMutableIndexSet *footerSections = [NSMutableIndexSet indexSet];
+    NSUInteger numberOfTableViewRows = (NSUInteger)MAX(self.numberOfRows, 0);
+    
+    [tableViewRows enumerateRangesUsingBlock:^(NSRange range, BOOL *stop __unused)
+    {
+        NSUInteger tableViewRow = range.location;
+        NSUInteger end = MIN(NSMaxRange(range), numberOfTableViewRows);
+        
+        while (tableViewRow < end)
+        {
+            GNEOutlineViewItem *item = [self itemAtRow:(NSInteger)tableViewRow];
+            GNEOutlineViewParentItem *parentItem = (item.parentItem) ?: (GNEOutlineViewParentItem *)item;
+            NSUInteger section = [self.model sectionForParentItem:parentItem];
+            NSInteger headerRow = (item.parentItem) ? [self rowForItem:parentItem] : (NSInteger)tableViewRow;
+            if (section == NSNotFound || headerRow < 0)
+            {
+                break;
+            }
+            
+            if ((NSUInteger)headerRow == tableViewRow)
+            {
+                [headerSections addIndex:section];
+            }
+            
+            BOOL isExpanded = [self isItemExpanded:parentItem];
+            NSUInteger itemCount = (isExpanded) ? [self.model numberOfItemsInSection:section] : 0;
+            NSUInteger rowCount = (parentItem.hasFooter && itemCount > 0) ? itemCount - 1 : itemCount;
+            NSUInteger firstTableViewRow = (NSUInteger)headerRow + 1;
+            
+            NSUInteger rangeStart = MAX(tableViewRow, firstTableViewRow);
+            NSUInteger rangeEnd = MIN(end, firstTableViewRow + rowCount);
+            if (rangeStart < rangeEnd)
+            {
+                NSMutableIndexSet *rows = rowsBySection[@(section)];
+                if (rows == nil)
+                {
+                    rows = [NSMutableIndexSet indexSet];
+                    rowsBySection[@(section)] = rows;
+                }
+                [rows addIndexesInRange:NSMakeRange(rangeStart - firstTableViewRow, rangeEnd - rangeStart)];
+            }
+            
+            NSUInteger footerTableViewRow = firstTableViewRow + rowCount;
+            if (rowCount < itemCount && footerTableViewRow >= tableViewRow && footerTableViewRow < end)
+            {
+                [footerSections addIndex:section];
+            }
+            
+            // Continue with the header of the next section.
+            tableViewRow = firstTableViewRow + itemCount;
+        }
+    }];
+    
+    if (headers)
+    {
+        *headers = [headerSections copy];
+    }
+    
+    if (footers)
+    {
+        *footers = [footerSections copy];
+    }
+    
+    return [rowsBySection copy];
+}
+
+
+- (NSIndexSet *)p_indexSetOfTableViewRowsForHeadersInSections:(NSIndexSet *)sectionIndexes
+{
+    return [self p_indexSetOfTableViewRowsForAccessoryViewsInSections:sectionIndexes
+                                                                  row:GNESectionedTableViewModelHeaderRow];
+}
+
+
+- (NSIndexSet *)p_indexSetOfTableViewRowsForFootersInSections:(NSIndexSet *)sectionIndexes
+{
+    return [self p_indexSetOfTableViewRowsForAccessoryViewsInSections:sectionIndexes
+                                                                  row:GNESectionedTableViewModelFooterRow];
+}
+
+
+/**
+ Returns the index set for the table view rows corresponding to the accessory views
+ (e.g., headers or footers) having the specified index path row in the specified sections. Returns
+ nil if the specified sections don't contain accessory views having the specified index path row.
+ */
+- (NSIndexSet *)p_indexSetOfTableViewRowsForAccessoryViewsInSections:(NSIndexSet *)sectionIndexes
+                                                                 row:(NSUInteger)accessoryViewRow
+{
+    if (sectionIndexes.count == 0)
+    {
+        return nil;
+    }
+    
+    NSMutableIndexSet *mutableIndexSet = [NSMutableIndexSet indexSet];
+    
+    __weak typeof(self) weakSelf = self;
+    [sectionIndexes enumerateIndexesUsingBlock:^(NSUInteger section, BOOL *stop __unused)
+    {
+        __strong typeof(weakSelf) strongSelf = weakSelf;
+        if (strongSelf == nil)
+        {
+            return;
+        }
+
+        NSIndexPath *indexPath = [NSIndexPath gne_indexPathForRow:accessoryViewRow
+                                                        inSection:section];
+        NSInteger tableViewRow = [strongSelf tableViewRowForIndexPath:indexPath];
+        if (tableViewRow >= 0)
+        {
+            [mutableIndexSet addIndex:(NSUInteger)tableViewRow];
+        }
+    }];
+    
+    return ((mutableIndexSet.count > 0) ? [mutableIndexSet copy] : nil);
+}
+
+
+- (NSArray *)p_indexPathsByRemovingHeadersAndFootersFromIndexPaths:(NSArray *)indexPaths
+{
+    NSMutableArray *mutableIndexPaths = [NSMutableArray array];
+    
+    for (NSIndexPath *indexPath in indexPaths)
+    {
+        if ([self isIndexPathHeader:indexPath] == NO &&
+            [self isIndexPathFooter:indexPath] == NO)
+        {
+            [mutableIndexPaths addObject:indexPath];
+        }
+    }
+    
+    return [mutableIndexPaths copy];
+}
+
+
+/**
+ Returns an array of the index paths of the specified rows and section footers, sorted in ascending order,
+ or nil if there are none.
+ 
+ @discussion The index paths are created from the rows' indexes, so none of their outline view items are
+ looked up.
+ @param rowsBySection Dictionary mapping sections (NSNumber) to the index sets of their rows, as returned
+ by -p_rowsBySectionForTableViewRows:headers:footers:.
+ @param footers Sections whose footers are included.
+ @return Array of the index paths of the rows and section footers or nil if there are none.
+ */
+- (NSArray *)p_indexPathsOfRowsBySection:(NSDictionary *)rowsBySection footers:(NSIndexSet *)footers
+{
+    NSMutableIndexSet *sections = [footers mutableCopy] ?: [NSMutableIndexSet indexSet];
+    for (NSNumber *sectionNumber in rowsBySection)
+    {
+        [sections addIndex:sectionNumber.unsignedIntegerValue];
+    }
+    
+    NSMutableArray *indexPaths = [NSMutableArray array];
+    
+    [sections enumerateIndexesUsingBlock:^(NSUInteger section, BOOL *stop __unused)
+    {
+        NSIndexSet *rows = rowsBySection[@(section)];
+        [rows enumerateIndexesUsingBlock:^(NSUInteger row, BOOL *innerStop __unused)
+        {
+            [indexPaths addObject:[NSIndexPath gne_indexPathForRow:row inSection:section]];
+        }];
+        
+        NSIndexPath *footerIndexPath = ([footers containsIndex:section]) ?
+                                        [self indexPathForFooterInSection:section] : nil;
+        if (footerIndexPath)
+        {
+            [indexPaths addObject:footerIndexPath];
+        }
+    }];
+    
+    return ((indexPaths.count > 0) ? [indexPaths copy] : nil);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - GNESectionedTableView - Internal - Scrolling
+// ------------------------------------------------------------------------------------------
+/**
+ Performs the specified changes to the rows of the table view and then either scrolls to the end of the
+ table view, if it pins to its tail and was scrolled to the end before, or scrolls so that the topmost
+ visible row keeps its position on screen.
+ */
+- (void)p_preserveVisibleRowsDuringChanges:(void (^)(void))changes
+{
+    CGRect visibleRect = self.visibleRect;
+    BOOL isPinnedToTail = (self.pinsToTail && CGRectGetMaxY(visibleRect) >= CGRectGetMaxY(self.bounds) - 1.0);
+    
+    id anchorItem = nil;
+    CGFloat anchorOffset = 0.0;
+    if (isPinnedToTail == NO && CGRectIsEmpty(visibleRect) == NO)
+    {
+        NSInteger anchorRow = [self rowAtPoint:visibleRect.origin];
+        if (anchorRow >= 0)
+        {
+            anchorItem = [self itemAtRow:anchorRow];
+            anchorOffset = visibleRect.origin.y - [self rectOfRow:anchorRow].origin.y;
+        }
+    }
+    
+    changes();
+    
+    if (isPinnedToTail)
+    {
+        CGRect updatedVisibleRect = self.visibleRect;
+        CGFloat tailOriginY = MAX(0.0, CGRectGetMaxY(self.bounds) - updatedVisibleRect.size.height);
+        [self scrollPoint:CGPointMake(updatedVisibleRect.origin.x, tailOriginY)];
+    }
+    else if (anchorItem)
+    {
+        NSInteger anchorRow = [self rowForItem:anchorItem];
+        if (anchorRow >= 0)
+        {
+            CGFloat anchorOriginY = [self rectOfRow:anchorRow].origin.y + anchorOffset;
+            if (anchorOriginY != self.visibleRect.origin.y)
+            {
+                [self scrollPoint:CGPointMake(self.visibleRect.origin.x, anchorOriginY)];
+            }
+        }
+    }
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - GNESectionedTableView - Internal - Streaming
+// ------------------------------------------------------------------------------------------
+/**
+ Inserts the rows appended to each section since the last flush of the append queue as a single batch
+ update, evicting rows from the front of full sections, and then either scrolls to the end of the table
+ view, if it is pinned there, or scrolls so that the topmost visible row keeps its position on screen.
+ */
+- (void)p_insertAppendedRows:(NSDictionary *)rowCountsBySection
+{
+    // Rows can't be inserted in the middle of another update, so they are queued again.
+    if (self.isUpdating)
+    {
+        for (NSNumber *sectionNumber in rowCountsBySection)
+        {
+            [self.appendQueue appendRows:[rowCountsBySection[sectionNumber] unsignedIntegerValue]
+                               toSection:sectionNumber.unsignedIntegerValue];
+        }
+        
+        return;
+    }
+    
+    NSArray *sections = [rowCountsBySection.allKeys sortedArrayUsingSelector:@selector(compare:)];
+    NSUInteger maximumNumberOfRows = self.maximumNumberOfRowsPerSection;
+    id <GNESectionedTableViewDataSource> dataSource = self.tableViewDataSource;
+    SEL willAppendSelector = @selector(tableView:willAppendRows:toSection:evictingRows:);
+    BOOL dataSourceRespondsToWillAppend = [dataSource respondsToSelector:willAppendSelector];
+    GNEAssert1(maximumNumberOfRows == 0 || dataSourceRespondsToWillAppend,
+               @"The data source must implement %@ to evict rows", NSStringFromSelector(willAppendSelector));
+    
+    [self p_preserveVisibleRowsDuringChanges:^()
+    {
+        [self performBatchUpdates:^()
+        {
+            NSUInteger numberOfSections = self.numberOfSections;
+            for (NSNumber *sectionNumber in sections)
+            {
+                NSUInteger section = sectionNumber.unsignedIntegerValue;
+                if (section >= numberOfSections)
+                {
+                    continue;
+                }
+                
+                NSUInteger numberOfRows = [self numberOfRowsInSection:section];
+                NSUInteger appendedCount = [rowCountsBySection[sectionNumber] unsignedIntegerValue];
+                NSUInteger evictedCount = 0;
+                if (maximumNumberOfRows > 0 && numberOfRows + appendedCount > maximumNumberOfRows)
+                {
+                    evictedCount = numberOfRows + appendedCount - maximumNumberOfRows;
+                }
+                
+                if (dataSourceRespondsToWillAppend)
+                {
+                    [dataSource tableView:self willAppendRows:appendedCount toSection:section evictingRows:evictedCount];
+                }
+                
+                // Evicted rows that were never inserted are simply not inserted.
+                NSUInteger deletedCount = MIN(evictedCount, numberOfRows);
+                if (deletedCount > 0)
+                {
+                    [self deleteRowsAtIndexPaths:[self p_indexPathsForRowsInRange:NSMakeRange(0, deletedCount)
+                                                                         inSection:section]
+                                   withAnimation:NSTableViewAnimationEffectNone];
+                }
+                
+                NSUInteger finalNumberOfRows = numberOfRows + appendedCount - evictedCount;
+                NSUInteger insertedCount = MIN(appendedCount, finalNumberOfRows);
+                if (insertedCount > 0)
+                {
+                    NSRange insertedRange = NSMakeRange(finalNumberOfRows - insertedCount, insertedCount);
+                    [self insertRowsAtIndexPaths:[self p_indexPathsForRowsInRange:insertedRange inSection:section]
+                                   withAnimation:NSTableViewAnimationEffectNone];
+                }
+            }
+        }
+        completion:nil];
+    }];
+}
+
+
+- (NSArray *)p_indexPathsForRowsInRange:(NSRange)range inSection:(NSUInteger)section
+{
+    NSMutableArray *indexPaths = [NSMutableArray arrayWithCapacity:range.length];
+    for (NSUInteger row = range.location; row < NSMaxRange(range); row++)
+    {
+        [indexPaths addObject:[NSIndexPath gne_indexPathForRow:row inSection:section]];
+    }
+    
+    return [indexPaths copy];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - GNESectionedTableView - Internal - Reloading Rows
+// ------------------------------------------------------------------------------------------
+/**
+ Reloads the visible rows among the specified table view rows with a single call to
+ -reloadDataForRowIndexes:columnIndexes:.
+ 
+ @discussion Rows outside of the visible rect are dropped. The ones AppKit has already prepared row views
+ for, which it does for a margin around the visible rect, are only marked stale and reloaded when they
+ are scrolled into view. The others don't have any views, so the delegate is asked for new ones when
+ they are displayed.
+ */
+- (void)p_reloadVisibleTableViewRows:(NSIndexSet *)tableViewRows
+{
+    if (tableViewRows.count == 0)
+    {
+        return;
+    }
+    
+    NSRange visibleRows = [self rowsInRect:self.visibleRect];
+    NSRange preparedRows = [self rowsInRect:self.preparedContentRect];
+    
+    [tableViewRows enumerateRangesInRange:preparedRows
+                                  options:0
+                               usingBlock:^(NSRange range, BOOL *stop __unused)
+    {
+        for (NSUInteger tableViewRow = range.location; tableViewRow < NSMaxRange(range); tableViewRow++)
+        {
+            if (NSLocationInRange(tableViewRow, visibleRows) == NO &&
+                [self rowViewAtRow:(NSInteger)tableViewRow makeIfNecessary:NO])
+            {
+                [self.staleItems addObject:[self itemAtRow:(NSInteger)tableViewRow]];
+            }
+        }
+    }];
+    
+    NSMutableIndexSet *visibleTableViewRows = [NSMutableIndexSet indexSet];
+    [tableViewRows enumerateRangesInRange:visibleRows
+                                  options:0
+                               usingBlock:^(NSRange range, BOOL *stop __unused)
+    {
+        [visibleTableViewRows addIndexesInRange:range];
+    }];
+    
+    [self p_reloadDataForTableViewRows:visibleTableViewRows];
+}
+
+
+/// Reloads the stale rows that have been scrolled into view.
+- (void)p_reloadStaleVisibleRows
+{
+    if (self.staleItems.count == 0)
+    {
+        return;
+    }
+    
+    NSRange visibleRows = [self rowsInRect:self.visibleRect];
+    NSMutableIndexSet *visibleTableViewRows = [NSMutableIndexSet indexSet];
+    for (GNEOutlineViewItem *item in [self.staleItems allObjects])
+    {
+        NSInteger tableViewRow = [self rowForItem:item];
+        if (tableViewRow < 0 || [self rowViewAtRow:tableViewRow makeIfNecessary:NO] == nil)
+        {
+            [self.staleItems removeObject:item];
+        }
+        else if (NSLocationInRange((NSUInteger)tableViewRow, visibleRows))
+        {
+            [visibleTableViewRows addIndex:(NSUInteger)tableViewRow];
+            [self.staleItems removeObject:item];
+        }
+    }
+    
+    [self p_reloadDataForTableViewRows:visibleTableViewRows];
+}
+
+
+/// Reloads every column of the specified table view rows. -[NSOutlineView reloadItem:] doesn't reload
+/// rows (see -reloadItem:), so the rows are reloaded through NSTableView.
+- (void)p_reloadDataForTableViewRows:(NSIndexSet *)tableViewRows
+{
+    if (tableViewRows.count == 0)
+    {
+        return;
+    }
+    
+    NSRange columnRange = NSMakeRange(0, (NSUInteger)self.numberOfColumns);
+    [self reloadDataForRowIndexes:tableViewRows columnIndexes:[NSIndexSet indexSetWithIndexesInRange:columnRange]];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - GNESectionedTableView - Internal - Prefetching
+// ------------------------------------------------------------------------------------------
+/// Coalesces the bounds changes of the clip view during a run loop iteration, which is at most once
+/// per frame while scrolling, into a single update of the prefetched rows.
+- (void)p_schedulePrefetchUpdate
+{
+    if (self.prefetchUpdateScheduled ||
+        [self.tableViewDataSource respondsToSelector:@selector(tableView:prefetchRowsAtIndexPaths:)] == NO)
+    {
+        return;
+    }
+    
+    self.prefetchUpdateScheduled = YES;
+    [self performSelector:@selector(p_updatePrefetchedRows)
+               withObject:nil
+               afterDelay:0.0
+                  inModes:@[NSRunLoopCommonModes]];
+}
+
+
+/**
+ Asks the data source to prefetch the rows ahead of the visible rows, in the direction of the scroll,
+ that will be scrolled into view within kPrefetchLookaheadInterval at the current scroll speed, and
+ cancels the prefetched rows that are no longer ahead of the visible rows.
+ */
+- (void)p_updatePrefetchedRows
+{
+    self.prefetchUpdateScheduled = NO;
+    
+    CGRect visibleRect = self.visibleRect;
+    CFTimeInterval timestamp = CACurrentMediaTime();
+    CGFloat distance = visibleRect.origin.y - self.prefetchOriginY;
+    CFTimeInterval interval = timestamp - self.prefetchTimestamp;
+    self.prefetchOriginY = visibleRect.origin.y;
+    self.prefetchTimestamp = timestamp;
+    
+    if (distance == 0.0 || CGRectIsEmpty(visibleRect))
+    {
+        return;
+    }
+    
+    NSInteger direction = (distance > 0.0) ? 1 : -1;
+    BOOL isReversed = (self.prefetchDirection != 0 && direction != self.prefetchDirection);
+    self.prefetchDirection = direction;
+    
+    CGFloat speed = 0.0;
+    if (interval > 0.0 && interval <= kMaximumScrollSpeedInterval)
+    {
+        speed = (CGFloat)(fabs(distance) / interval);
+    }
+    CGFloat visibleHeight = visibleRect.size.height;
+    CGFloat prefetchDistance = MIN(MAX(speed * (CGFloat)kPrefetchLookaheadInterval,
+                                       visibleHeight * kMinimumPrefetchDistance),
+                                   visibleHeight * kMaximumPrefetchDistance);
+    CGRect prefetchRect = visibleRect;
+    prefetchRect.origin.y = (direction > 0) ? CGRectGetMaxY(visibleRect) : visibleRect.origin.y - prefetchDistance;
+    prefetchRect.size.height = prefetchDistance;
+    prefetchRect = CGRectIntersection(prefetchRect, self.bounds);
+    
+    NSRange visibleRows = [self rowsInRect:visibleRect];
+    NSRange prefetchRows = (CGRectIsNull(prefetchRect)) ? NSMakeRange(0, 0) : [self rowsInRect:prefetchRect];
+    
+    // Rows that were scrolled into view or past them are done with. The rest are cancelled once they
+    // fall out of the prefetched range, e.g., because the direction of the scroll was reversed.
+    NSMutableArray *cancelledIndexPaths = [NSMutableArray array];
+    for (GNEOutlineViewItem *item in [self.prefetchedItems allObjects])
+    {
+        NSInteger tableViewRow = [self rowForItem:item];
+        BOOL isBehind = (direction > 0) ? (tableViewRow < (NSInteger)visibleRows.location) :
+                                          (tableViewRow >= (NSInteger)NSMaxRange(visibleRows));
+        if (tableViewRow < 0 ||
+            NSLocationInRange((NSUInteger)tableViewRow, visibleRows) ||
+            (isBehind && isReversed == NO))
+        {
+            [self.prefetchedItems removeObject:item];
+        }
+        else if (NSLocationInRange((NSUInteger)tableViewRow, prefetchRows) == NO)
+        {
+            [self.prefetchedItems removeObject:item];
+            NSIndexPath *indexPath = [self.model indexPathOfItem:item];
+            if (indexPath)
+            {
+                [cancelledIndexPaths addObject:indexPath];
+            }
+        }
+    }
+    
+    NSMutableArray *prefetchedIndexPaths = [NSMutableArray array];
+    for (NSUInteger i = 0; i < prefetchRows.length; i++)
+    {
+        NSUInteger tableViewRow = (direction > 0) ? prefetchRows.location + i : NSMaxRange(prefetchRows) - 1 - i;
+        if (NSLocationInRange(tableViewRow, visibleRows))
+        {
+            continue;
+        }
+        
+        GNEOutlineViewItem *item = [self itemAtRow:(NSInteger)tableViewRow];
+        if (item.parentItem == nil || [self.model isItemFooter:item] || [self.prefetchedItems containsObject:item])
+        {
+            continue;
+        }
+        
+        NSIndexPath *indexPath = [self.model indexPathOfItem:item];
+        if (indexPath)
+        {
+            [self.prefetchedItems addObject:item];
+            [prefetchedIndexPaths addObject:indexPath];
+        }
+    }
+    
+    id <GNESectionedTableViewDataSource> dataSource = self.tableViewDataSource;
+    if (cancelledIndexPaths.count > 0 &&
+        [dataSource respondsToSelector:@selector(tableView:cancelPrefetchingForRowsAtIndexPaths:)])
+    {
+        GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:cancelPrefetchingForRowsAtIndexPaths:));
+        [dataSource tableView:self cancelPrefetchingForRowsAtIndexPaths:cancelledIndexPaths];
+    }
+    if (prefetchedIndexPaths.count > 0 && [dataSource respondsToSelector:@selector(tableView:prefetchRowsAtIndexPaths:)])
+    {
+        GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:prefetchRowsAtIndexPaths:));
+        [dataSource tableView:self prefetchRowsAtIndexPaths:prefetchedIndexPaths];
+    }
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - GNESectionedTableView - Internal - Counts
+// ------------------------------------------------------------------------------------------
+- (NSUInteger)p_numberOfSections
+{
+    if ([self.tableViewDataSource respondsToSelector:@selector(numberOfSectionsInTableView:)])
+    {
+        GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(numberOfSectionsInTableView:));
+        return [self.tableViewDataSource numberOfSectionsInTableView:self];
+    }
+    
+    return 0;
+}
+
+
+- (NSUInteger)p_numberOfRowsInSection:(NSUInteger)section
+{
+    if ([self.tableViewDataSource respondsToSelector:@selector(tableView:numberOfRowsInSection:)])
+    {
+        GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:numberOfRowsInSection:));
+        return [self.tableViewDataSource tableView:self numberOfRowsInSection:section];
+    }
+    
+    return 0;
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - GNESectionedTableView - Internal - Row Heights
+// ------------------------------------------------------------------------------------------
+/**
+ Asks the table view delegate for the current heights of the specified outline view items and updates the
+ heights of the sections containing them.
+ 
+ @param items Outline view items and outline view parent items whose heights have changed.
+ */
+- (void)p_updateHeightsOfOutlineViewItems:(NSArray *)items
+{
+    NSMutableIndexSet *sections = [NSMutableIndexSet indexSet];
+    GNESectionedTableViewRowHeightMeasuringBlock measuringBlock = [self p_requestDelegateRowHeightMeasuringBlock];
+    
+    for (GNEOutlineViewItem *item in items)
+    {
+        NSUInteger section = [self p_updateHeightOfOutlineViewItem:item measuringBlock:measuringBlock];
+        if (section != NSNotFound)
+        {
+            [sections addIndex:section];
+        }
+    }
+    
+    [sections enumerateIndexesUsingBlock:^(NSUInteger section, BOOL *stop __unused)
+    {
+        [self p_updateHeightOfSection:section];
+    }];
+}
+
+
+/**
+ Asks the table view delegate for the current height of the specified outline view item and caches it.
+ 
+ @param item Outline view item or outline view parent item to measure.
+ @param measuringBlock Block returned by -p_requestDelegateRowHeightMeasuringBlock or nil.
+ @return Section containing the outline view item, or NSNotFound if it isn't in the table view.
+ */
+- (NSUInteger)p_updateHeightOfOutlineViewItem:(GNEOutlineViewItem *)item
+                               measuringBlock:(GNESectionedTableViewRowHeightMeasuringBlock)measuringBlock
+{
+    GNEOutlineViewParentItem *parentItem = item.parentItem;
+    
+    // Section header
+    if (parentItem == nil)
+    {
+        GNEOutlineViewParentItem *headerItem = (GNEOutlineViewParentItem *)item;
+        NSUInteger section = [self.model sectionForParentItem:headerItem];
+        if (section != NSNotFound)
+        {
+            headerItem.height = [self p_requestDelegateHeightOfHeaderInSection:section];
+        }
+        
+        return section;
+    }
+    
+    NSUInteger section = [self.model sectionForParentItem:parentItem];
+    if (section == NSNotFound || section >= self.model.numberOfSections)
+    {
+        return NSNotFound;
+    }
+    
+    GNEOutlineViewItemArray *rows = [self.model itemsInSection:section];
+    NSUInteger index = [rows indexOfObject:item];
+    if (index == NSNotFound)
+    {
+        return NSNotFound;
+    }
+    
+    // Section footer
+    if (parentItem.hasFooter && index == rows.count - 1)
+    {
+        [rows setHeight:[self p_requestDelegateHeightOfFooterInSection:section] forObjectAtIndex:index];
+        
+        return section;
+    }
+    
+    // Row
+    CGFloat uniformHeight = GNESectionedTableViewNonUniformRowHeight;
+    GNERowHeightMeasurement measurement = [self p_rowHeightMeasurementInSection:section
+                                                                 measuringBlock:measuringBlock
+                                                                  uniformHeight:&uniformHeight];
+    if (measurement == GNERowHeightMeasurementAsynchronous)
+    {
+        // The row keeps its current height until its new height has been measured.
+        [self p_setNeedsHeightsOfRows:[NSIndexSet indexSetWithIndex:index] ofParentItem:parentItem];
+        
+        return section;
+    }
+    else if ([parentItem.estimatedRows containsIndex:index])
+    {
+        // The row keeps its estimated height until it comes near the visible rows.
+        return section;
+    }
+    
+    CGFloat height = kDefaultRowHeight;
+    [self p_requestDelegateHeights:&height ofRowsInRange:NSMakeRange(index, 1) inSection:section uniformHeight:uniformHeight];
+    [rows setHeight:height forObjectAtIndex:index];
+    
+    return section;
+}
+
+
+/**
+ Returns the height of the specified section, which includes the header and, if the section is expanded,
+ the rows and footer of the section, as well as their intercell spacing.
+ */
+- (CGFloat)p_heightOfSection:(NSUInteger)section
+{
+    GNEOutlineViewParentItem *parentItem = [self.model parentItemForSection:section];
+    GNEOutlineViewItemArray *rows = [self.model itemsInSection:section];
+    CGFloat spacing = self.intercellSpacing.height;
+    
+    CGFloat height = parentItem.height + spacing;
+    if ([self isItemExpanded:parentItem])
+    {
+        height += rows.totalHeight + (CGFloat)rows.count * spacing;
+    }
+    
+    return height;
+}
+
+
+/// Updates the cached height of the specified section. O(lg n)
+- (void)p_updateHeightOfSection:(NSUInteger)section
+{
+    if (section < self.sectionHeights.count)
+    {
+        [self.sectionHeights setValue:[self p_heightOfSection:section] atIndex:section];
+    }
+}
+
+
+/// Rebuilds the cached heights of all of the sections. O(n)
+- (void)p_rebuildSectionHeights
+{
+    NSUInteger sectionCount = self.model.numberOfSections;
+    
+    CGFloat *heights = calloc(sectionCount + 1, sizeof(CGFloat));
+    if (heights == NULL)
+    {
+        [NSException raise:kMemoryAllocationAssertionName format:@"%@", kMemoryAllocationAssertionReason];
+    }
+    
+    for (NSUInteger section = 0; section < sectionCount; section++)
+    {
+        heights[section] = [self p_heightOfSection:section];
+    }
+    self.sectionHeights = [GNEPrefixSumArray arrayWithValues:heights count:sectionCount];
+    
+    free(heights);
+}
+
+
+/// Inserts the heights of the specified sections, which were just inserted into the model, into the cached
+/// heights. O(n - s) for the first inserted section s
+- (void)p_insertHeightsOfSections:(NSIndexSet *)sections
+{
+    CGFloat *heights = calloc(sections.count + 1, sizeof(CGFloat));
+    if (heights == NULL)
+    {
+        [NSException raise:kMemoryAllocationAssertionName format:@"%@", kMemoryAllocationAssertionReason];
+    }
+    
+    __block NSUInteger i = 0;
+    [sections enumerateIndexesUsingBlock:^(NSUInteger section, BOOL *stop __unused)
+    {
+        heights[i++] = [self p_heightOfSection:section];
+    }];
+    [self.sectionHeights insertValues:heights atIndexes:sections];
+    
+    free(heights);
 }
 
 
 /**
- Returns the index set for the table view rows corresponding to the accessory views
- (e.g., headers or footers) having the specified row modifier in the specified sections. Returns
- nil if the specified sections don't container accessory views having the specified row modifier.
+ Returns the rectangle of the row (including its intercell spacing) at the specified index path computed
+ from the cached heights, or CGRectNull if the index path is invalid or belongs to a collapsed section.
+ 
+ @discussion Like -[NSTableView rectOfRow:], the returned rectangle spans the width of the table view.
+ @param indexPath Index path of a section header, row, or section footer.
+ @return Rectangle of the row at the specified index path or CGRectNull.
  */
-- (NSIndexSet *)p_indexSetOfTableViewRowsForAccessoryViewsInSections:(NSIndexSet *)sectionIndexes
-                                                         rowModifier:(NSUInteger)rowModifier
+- (CGRect)p_rectOfRowAtIndexPath:(NSIndexPath *)indexPath
 {
-    if (sectionIndexes.count == 0)
+    NSUInteger section = indexPath.gne_section;
+    if (indexPath == nil || section >= self.sectionHeights.count)
     {
-        return nil;
+        return CGRectNull;
     }
     
-    NSMutableIndexSet *mutableIndexSet = [NSMutableIndexSet indexSet];
+    GNEOutlineViewParentItem *parentItem = [self.model parentItemForSection:section];
+    CGFloat spacing = self.intercellSpacing.height;
+    CGFloat offset = [self.sectionHeights sumOfValuesBeforeIndex:section];
+    CGFloat height = parentItem.height;
     
-    __weak typeof(self) weakSelf = self;
-    [sectionIndexes enumerateIndexesUsingBlock:^(NSUInteger section, BOOL *stop __unused)
+    if ([self isIndexPathHeader:indexPath] == NO)
     {
-        __strong typeof(weakSelf) strongSelf = weakSelf;
-        if (strongSelf == nil)
+        if ([self isItemExpanded:parentItem] == NO)
         {
-            return;
+            return CGRectNull;
         }
-
-        NSUInteger accessoryViewRow = (NSUInteger)(NSNotFound - rowModifier);
-        NSIndexPath *indexPath = [NSIndexPath gne_indexPathForRow:accessoryViewRow
-                                                        inSection:section];
-        NSInteger tableViewRow = [strongSelf tableViewRowForIndexPath:indexPath];
-        if (tableViewRow >= 0)
+        
+        GNEOutlineViewItemArray *rows = [self.model itemsInSection:section];
+        NSUInteger rowCount = rows.count - ((parentItem.hasFooter) ? 1 : 0);
+        NSUInteger index = ([self isIndexPathFooter:indexPath]) ? rowCount : indexPath.gne_row;
+        
+        if (index >= rows.count || (index == rowCount && parentItem.hasFooter == NO))
         {
-            [mutableIndexSet addIndex:(NSUInteger)tableViewRow];
+            return CGRectNull;
         }
-    }];
+        
+        offset += parentItem.height + spacing + [rows offsetOfObjectAtIndex:index] + (CGFloat)index * spacing;
+        height = [rows heightOfObjectAtIndex:index];
+    }
     
-    return ((mutableIndexSet.count > 0) ? [mutableIndexSet copy] : nil);
+    return CGRectMake(0.0, offset, NSWidth(self.bounds), height + spacing);
 }
 
 
 /**
- Returns the child index of the specified outline view item in its parent, otherwise NSNotFound.
- Throws an exception if the specified outline view parent item does not match the specified
- outline view item's parent.
+ Returns the index path of the section header, row, or section footer containing the specified vertical
+ offset computed from the cached heights, or nil if the offset is outside of the table view's rows.
  */
-- (NSUInteger)p_childIndexOfOutlineViewItem:(GNEOutlineViewItem *)item
-                               inParentItem:(GNEOutlineViewParentItem *)parentItem
+- (NSIndexPath *)p_indexPathOfRowAtOffset:(CGFloat)offset
 {
-    GNEOutlineViewParentItem *theParentItem = item.parentItem;
+    NSUInteger section = [self.sectionHeights indexOfValueContainingSum:offset];
+    if (section == NSNotFound)
+    {
+        return nil;
+    }
+    
+    GNEOutlineViewParentItem *parentItem = [self.model parentItemForSection:section];
+    CGFloat spacing = self.intercellSpacing.height;
+    CGFloat headerHeight = parentItem.height + spacing;
+    CGFloat rowsOffset = offset - [self.sectionHeights sumOfValuesBeforeIndex:section] - headerHeight;
     
-    GNEParameterAssert([theParentItem isEqual:parentItem]);
+    if (rowsOffset < 0.0)
+    {
+        return [self indexPathForHeaderInSection:section];
+    }
     
-    if ([theParentItem isEqual:parentItem])
+    GNEOutlineViewItemArray *rows = [self.model itemsInSection:section];
+    NSUInteger index = NSNotFound;
+    GNEOutlineViewItem *item = [rows objectAtOffset:rowsOffset spacing:spacing index:&index];
+    
+    if (item == nil)
     {
-        return [self p_childIndexOfOutlineViewItem:item];
+        return nil;
+    }
+    else if (parentItem.hasFooter && index == rows.count - 1)
+    {
+        return [self indexPathForFooterInSection:section];
     }
     
-    return NSNotFound;
+    return [NSIndexPath gne_indexPathForRow:index inSection:section];
 }
 
 
-/// Returns the child index of the specified outline view item in its parent, otherwise NSNotFound.
-- (NSUInteger)p_childIndexOfOutlineViewItem:(GNEOutlineViewItem *)item
+// ------------------------------------------------------------------------------------------
+#pragma mark - GNESectionedTableView - Internal - Asynchronous Row Heights
+// ------------------------------------------------------------------------------------------
+/// Returns the block the table view delegate measures rows with on background queues, or nil.
+- (GNESectionedTableViewRowHeightMeasuringBlock)p_requestDelegateRowHeightMeasuringBlock
 {
-    NSUInteger section = [self p_sectionForOutlineViewParentItem:item.parentItem];
-    NSUInteger sectionCount = self.outlineViewItems.count;
-    
-    if (section == NSNotFound || section >= sectionCount)
+    id <GNESectionedTableViewDelegate> theDelegate = self.tableViewDelegate;
+    if ([theDelegate respondsToSelector:@selector(rowHeightMeasuringBlockForTableView:)] == NO)
     {
-        return NSNotFound;
+        return nil;
     }
     
-    NSArray *items = self.outlineViewItems[section];
+    GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(rowHeightMeasuringBlockForTableView:));
     
-    return [items indexOfObject:item];
+    return [theDelegate rowHeightMeasuringBlockForTableView:self];
 }
 
 
-/**
- Returns the index path pointing to the specified outline view item in the outline view items array.
- 
- @param item Outline view item to locate.
- @return Index path matching the current location of the specified outline view item in table view's outline view
-            items array, or nil if it couldn't be found.
- */
-- (NSIndexPath *)p_indexPathOfOutlineViewItem:(GNEOutlineViewItem *)item
+/// Adds the specified rows to the unmeasured rows of the specified outline view parent item's section and
+/// schedules their measurement. Measurements of the rows that are in progress are outdated, so their
+/// heights are not committed.
+- (void)p_setNeedsHeightsOfRows:(NSIndexSet *)rows ofParentItem:(GNEOutlineViewParentItem *)parentItem
 {
-    if (item == nil)
+    if (rows.count == 0 || parentItem == nil)
     {
-        return nil;
+        return;
     }
     
-    NSUInteger sectionCount = self.outlineViewItems.count;
-    
-    // If it's a outline view parent item, make a section header index path for it.
-    GNEOutlineViewParentItem *parentItem = item.parentItem;
-    if (parentItem == nil)
+    if (parentItem.unmeasuredRows == nil)
     {
-        NSUInteger section = [self p_sectionForOutlineViewParentItem:(GNEOutlineViewParentItem *)item];
-        NSIndexPath *indexPath = [self indexPathForHeaderInSection:section];
-        
-        return ((section == NSNotFound) ? nil : indexPath);
+        parentItem.unmeasuredRows = [NSMutableIndexSet indexSet];
     }
+    [parentItem.unmeasuredRows addIndexes:rows];
     
-    NSUInteger section = [self p_sectionForOutlineViewParentItem:parentItem];
-
-    if (section != NSNotFound && section < sectionCount)
+    for (GNEOutlineViewRowHeightMeasurement *measurement in parentItem.rowHeightMeasurements)
     {
-        // If it represents a section footer, make a section footer index path for it.
-        if ([self p_isOutlineViewItemFooter:item])
-        {
-            return [self indexPathForFooterInSection:section];
-        }
-        else // Find the outline view item in its parent's section.
-        {
-            NSUInteger childIndex = [self p_childIndexOfOutlineViewItem:item];
-            
-            return ((childIndex == NSNotFound) ? nil : [NSIndexPath gne_indexPathForRow:childIndex
-                                                                              inSection:section]);
-        }
+        [self p_removeRows:rows fromRowHeightMeasurement:measurement];
     }
     
-    return nil;
+    [self p_setNeedsRowHeightMeasurementOfParentItem:parentItem];
 }
 
 
-- (NSArray *)p_indexPathsByRemovingHeadersAndFootersFromIndexPaths:(NSArray *)indexPaths
+/**
+ Schedules the measurement of the unmeasured rows of the specified outline view parent item's section
+ that are not being measured yet once the current run loop iteration ends, so that any number of changes
+ to the section during an update only start a single measurement.
+ */
+- (void)p_setNeedsRowHeightMeasurementOfParentItem:(GNEOutlineViewParentItem *)parentItem
 {
-    NSMutableArray *mutableIndexPaths = [NSMutableArray array];
+    [self.parentItemsNeedingRowHeightMeasurement addObject:parentItem];
     
-    for (NSIndexPath *indexPath in indexPaths)
+    if (self.rowHeightMeasurementScheduled)
     {
-        if ([self isIndexPathHeader:indexPath] == NO &&
-            [self isIndexPathFooter:indexPath] == NO)
-        {
-            [mutableIndexPaths addObject:indexPath];
-        }
+        return;
     }
     
-    return [mutableIndexPaths copy];
+    self.rowHeightMeasurementScheduled = YES;
+    __weak typeof(self) weakSelf = self;
+    dispatch_async(dispatch_get_main_queue(), ^()
+    {
+        [weakSelf p_measureUnmeasuredRows];
+    });
 }
 
 
-/**
- Returns an array of the index paths of the rows contained in the specified table view row indexes, or nil if
- the table view row indexes do not correspond to any rows.
- 
- @param rowIndexes Table view indexes.
- @return Array of the index paths for the rows or nil if the specified table view row indexes don't
- correspond to any rows.
- */
-- (NSArray *)p_indexPathsOfRowsAtTableViewRows:(NSIndexSet *)rowIndexes
+/// Keeps the unmeasured, estimated, and measuring rows of the specified outline view parent item's section
+/// in sync with the inserted rows (in terms of the rows after the insertion) and the deleted rows (in terms
+/// of the rows before the deletion). Measurements of the section that are in progress still commit the
+/// heights of the rows that were not deleted, at their shifted rows; the inserted rows are measured on their
+/// own (see -p_measureRowsAtIndexes:inSection:measuringBlock:).
+- (void)p_updateUnmeasuredRowsOfParentItem:(GNEOutlineViewParentItem *)parentItem
+                           insertedIndexes:(NSIndexSet *)insertedIndexes
+                            deletedIndexes:(NSIndexSet *)deletedIndexes
 {
-    NSMutableArray *indexPaths = [NSMutableArray array];
+    [self p_shiftRows:parentItem.estimatedRows insertedIndexes:insertedIndexes deletedIndexes:deletedIndexes];
+    [self p_shiftRows:parentItem.unmeasuredRows insertedIndexes:insertedIndexes deletedIndexes:deletedIndexes];
     
-    __weak typeof(self) weakSelf = self;
-    [rowIndexes enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop __unused)
+    for (GNEOutlineViewRowHeightMeasurement *measurement in parentItem.rowHeightMeasurements)
     {
-        __strong typeof(weakSelf) strongSelf = weakSelf;
-
-        GNEOutlineViewItem *item = [strongSelf itemAtRow:(NSInteger)idx];
-        if (item.parentItem)
-        {
-            NSIndexPath *indexPath = [strongSelf p_indexPathOfOutlineViewItem:item];
-            if (indexPath)
-            {
-                [indexPaths addObject:indexPath];
-            }
-        }
-    }];
-    
-    return ((indexPaths.count > 0) ? [NSArray arrayWithArray:indexPaths] : nil);
+        [self p_removeRows:deletedIndexes fromRowHeightMeasurement:measurement];
+        [self p_shiftRows:measurement.rows insertedIndexes:insertedIndexes deletedIndexes:deletedIndexes];
+    }
 }
 
 
-/**
- Returns the outline view item or outline view parent item located at the specified index in the outline
- view items array or outline view parent items array, or nil if the item couldn't be found.
- 
- @discussion Returns an outline view item if parentItem is not nil, otherwise returns an outline view
- parent item.
- @param index Index of the desired outline view item or parent item.
- @param parentItem Outline view parent item for the desired outline view item or nil if searching for
- an outline view parent item.
- @return Outline view item or outline view parent item located at the specified index of the specified parent.
- */
-- (GNEOutlineViewItem *)p_outlineViewItemAtIndex:(NSUInteger)index ofParent:(GNEOutlineViewParentItem *)parentItem
+/// Removes the specified rows from the specified measurement, together with their positions among the rows
+/// the measurement started with, so that their heights are not committed. The positions are found once per
+/// contiguous range of removed rows, not once per row.
+- (void)p_removeRows:(NSIndexSet *)rows fromRowHeightMeasurement:(GNEOutlineViewRowHeightMeasurement *)measurement
 {
-    GNEParameterAssert(parentItem == nil || [parentItem isKindOfClass:[GNEOutlineViewParentItem class]]);
+    NSMutableIndexSet *measuredRows = measurement.rows;
+    if (rows.count == 0 || measuredRows.count == 0)
+    {
+        return;
+    }
     
-    if (parentItem)
+    // The n-th measured row is at the n-th position, so the ordinals of the removed rows among the measured
+    // rows are the ordinals of their positions among the positions.
+    NSMutableIndexSet *removedOrdinals = [NSMutableIndexSet indexSet];
+    [rows enumerateRangesUsingBlock:^(NSRange range, BOOL *stop __unused)
     {
-        NSUInteger section = [self p_sectionForOutlineViewParentItem:parentItem];
-        
-        if (section < self.outlineViewItems.count && index < ((NSArray *)self.outlineViewItems[section]).count)
+        [measuredRows enumerateRangesInRange:range
+                                     options:0
+                                  usingBlock:^(NSRange measuredRange, BOOL *innerStop __unused)
         {
-            NSArray *sectionArray = self.outlineViewItems[section];
-            
-            return sectionArray[index];
-        }
-    }
-    else if (index < self.outlineViewParentItems.count)
+            NSRange removedRange = NSIntersectionRange(measuredRange, range);
+            NSUInteger ordinal = [measuredRows countOfIndexesInRange:NSMakeRange(0, removedRange.location)];
+            [removedOrdinals addIndexesInRange:NSMakeRange(ordinal, removedRange.length)];
+        }];
+    }];
+    
+    if (removedOrdinals.count == 0)
     {
-        return self.outlineViewParentItems[index];
+        return;
     }
     
-    GNEAssert2(NO, @"Could not find item at index %lu of parent %@", (unsigned long)index, parentItem);
+    NSMutableIndexSet *removedPositions = [NSMutableIndexSet indexSet];
+    __block NSUInteger ordinal = 0;
+    [measurement.positions enumerateRangesUsingBlock:^(NSRange range, BOOL *stop __unused)
+    {
+        NSRange ordinalRange = NSMakeRange(ordinal, range.length);
+        [removedOrdinals enumerateRangesInRange:ordinalRange
+                                        options:0
+                                     usingBlock:^(NSRange removedRange, BOOL *innerStop __unused)
+        {
+            NSRange removedOrdinalRange = NSIntersectionRange(removedRange, ordinalRange);
+            [removedPositions addIndexesInRange:NSMakeRange(range.location + removedOrdinalRange.location - ordinal,
+                                                            removedOrdinalRange.length)];
+        }];
+        ordinal += range.length;
+    }];
     
-    return nil;
+    [measurement.positions removeIndexes:removedPositions];
+    [measuredRows removeIndexes:rows];
 }
 
 
-/**
- Returns the outline view parent item for the specified section.
- 
- @param section Section to use to find a matching outline view parent item.
- @return Outline view parent item for the specified section, otherwise nil.
- */
-- (GNEOutlineViewParentItem *)p_outlineViewParentItemForSection:(NSUInteger)section
+/// Shifts the specified rows past the inserted rows and removes the deleted rows from them. The rows are
+/// shifted once per contiguous range of inserted or deleted rows, not once per row.
+- (void)p_shiftRows:(NSMutableIndexSet *)rows
+    insertedIndexes:(NSIndexSet *)insertedIndexes
+     deletedIndexes:(NSIndexSet *)deletedIndexes
 {
-    NSIndexPath *indexPath = [self indexPathForHeaderInSection:section];
+    if (rows.count == 0)
+    {
+        return;
+    }
     
-    return [self p_outlineViewParentItemWithIndexPath:indexPath];
+    // Shifting the rows after a deleted range down by its length also removes the rows in it. The
+    // deleted ranges are in terms of the rows before the deletion, so the last range is removed first.
+    [deletedIndexes enumerateRangesWithOptions:NSEnumerationReverse
+                                    usingBlock:^(NSRange range, BOOL *stop __unused)
+    {
+        [rows shiftIndexesStartingAtIndex:NSMaxRange(range) by:-(NSInteger)range.length];
+    }];
+    // The inserted ranges are in terms of the rows after the insertion, so the first range is inserted first.
+    [insertedIndexes enumerateRangesUsingBlock:^(NSRange range, BOOL *stop __unused)
+    {
+        [rows shiftIndexesStartingAtIndex:range.location by:(NSInteger)range.length];
+    }];
 }
 
 
-/**
- Returns the outline view parent item at the specified index path.
- 
- @param indexPath Index path to use to find a matching outline view parent item.
- @return Outline view parent item at the specified index path, otherwise nil.
- */
-- (GNEOutlineViewParentItem *)p_outlineViewParentItemWithIndexPath:(NSIndexPath *)indexPath
+/// Starts measuring the unmeasured rows of every section scheduled with
+/// -p_setNeedsRowHeightMeasurementOfParentItem:.
+- (void)p_measureUnmeasuredRows
 {
-    GNEParameterAssert(indexPath);
-    GNEParameterAssert([self isIndexPathHeader:indexPath]);
+    self.rowHeightMeasurementScheduled = NO;
     
-    NSUInteger parentItemsCount = self.outlineViewParentItems.count;
+    NSArray *parentItems = [self.parentItemsNeedingRowHeightMeasurement allObjects];
+    [self.parentItemsNeedingRowHeightMeasurement removeAllObjects];
     
-    GNEParameterAssert(indexPath.gne_section < parentItemsCount);
+    GNESectionedTableViewRowHeightMeasuringBlock measuringBlock = [self p_requestDelegateRowHeightMeasuringBlock];
+    CGFloat width = NSWidth(self.bounds);
     
-    if (indexPath.gne_section < parentItemsCount)
+    for (GNEOutlineViewParentItem *parentItem in parentItems)
     {
-        return self.outlineViewParentItems[indexPath.gne_section];
+        NSUInteger section = parentItem.section;
+        NSMutableIndexSet *rows = [parentItem.unmeasuredRows mutableCopy];
+        if (section == NSNotFound || section >= self.model.numberOfSections || rows.count == 0)
+        {
+            continue;
+        }
+        
+        if (measuringBlock)
+        {
+            // Rows that are already being measured keep their measurements.
+            for (GNEOutlineViewRowHeightMeasurement *measurement in parentItem.rowHeightMeasurements)
+            {
+                [rows removeIndexes:measurement.rows];
+            }
+            
+            if (rows.count > 0)
+            {
+                [self p_measureRows:rows inSection:section width:width usingBlock:measuringBlock];
+            }
+        }
+        else
+        {
+            // The delegate no longer measures rows on background queues.
+            parentItem.unmeasuredRows = nil;
+            parentItem.rowHeightMeasurements = nil;
+            [self p_measureRowsAtIndexes:rows inSection:section measuringBlock:nil];
+            [self p_noteHeightsOfRowsChanged:rows inSection:section];
+        }
     }
-    
-    return nil;
 }
 
 
 /**
- Returns the outline view item at the specified index path.
+ Measures the specified rows of the specified section concurrently on a background queue using the
+ specified block and commits the heights of the rows that are still valid on the main queue.
  
- @param indexPath Index path to use to find a matching outline view item.
- @return Outline view item at the specified index path, otherwise nil.
+ @param rows Indexes of the rows to measure.
+ @param section Section containing the rows.
+ @param width Width of the table view at the time the measurement started.
+ @param measuringBlock Block returned by the table view delegate's -rowHeightMeasuringBlockForTableView:.
  */
-- (GNEOutlineViewItem *)p_outlineViewItemAtIndexPath:(NSIndexPath *)indexPath
+- (void)p_measureRows:(NSIndexSet *)rows
+            inSection:(NSUInteger)section
+                width:(CGFloat)width
+           usingBlock:(GNESectionedTableViewRowHeightMeasuringBlock)measuringBlock
 {
-    GNEParameterAssert(indexPath);
-    
-    // If it's an outline view parent item, call the appropriate method.
-    if ([self isIndexPathHeader:indexPath])
+    GNEOutlineViewParentItem *parentItem = [self.model parentItemForSection:section];
+    GNEOutlineViewRowHeightMeasurement *measurement = [[GNEOutlineViewRowHeightMeasurement alloc] initWithRows:rows];
+    if (parentItem.rowHeightMeasurements == nil)
     {
-        return [self p_outlineViewParentItemForSection:indexPath.gne_section];
+        parentItem.rowHeightMeasurements = [NSMutableArray array];
     }
+    [parentItem.rowHeightMeasurements addObject:measurement];
+    NSUInteger count = rows.count;
     
-    NSUInteger sectionCount = self.outlineViewItems.count;
+    // The measurement only uses this snapshot of the rows, never the model or the views.
+    NSMutableData *indexData = [NSMutableData dataWithLength:(count * sizeof(NSUInteger))];
+    [rows getIndexes:indexData.mutableBytes maxCount:count inIndexRange:NULL];
     
-    GNEParameterAssert(indexPath.gne_section < sectionCount);
-    
-    if (indexPath.gne_section < sectionCount)
+    __weak typeof(self) weakSelf = self;
+    __weak GNEOutlineViewParentItem *weakParentItem = parentItem;
+    dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0);
+    dispatch_async(queue, ^()
     {
-        NSArray *sectionArray = self.outlineViewItems[indexPath.gne_section];
-        NSUInteger rowCount = sectionArray.count;
+        const NSUInteger *indexes = indexData.bytes;
+        NSMutableData *heightData = [NSMutableData dataWithLength:(count * sizeof(CGFloat))];
+        CGFloat *heights = heightData.mutableBytes;
         
-        GNEParameterAssert([self isIndexPathFooter:indexPath] ||
-                           indexPath.gne_row < rowCount);
-        
-        if ([self isIndexPathFooter:indexPath])
+        size_t batchCount = (count + kRowHeightMeasurementBatchSize - 1) / kRowHeightMeasurementBatchSize;
+        dispatch_apply(batchCount, queue, ^(size_t batch)
         {
-            return [self p_outlineViewItemForFooterInSection:indexPath.gne_section];
-        }
-        else if (indexPath.gne_row < rowCount)
+            @autoreleasepool
+            {
+                NSUInteger end = MIN(count, (batch + 1) * kRowHeightMeasurementBatchSize);
+                for (NSUInteger i = batch * kRowHeightMeasurementBatchSize; i < end; i++)
+                {
+                    heights[i] = measuringBlock(GNESectionedIndexPathMake(indexes[i], section), width);
+                }
+            }
+        });
+        
+        dispatch_async(dispatch_get_main_queue(), ^()
         {
-            return sectionArray[indexPath.gne_row];
-        }
-    }
-    
-    return nil;
-}
-
-
-- (GNEOutlineViewItem *)p_outlineViewItemForFooterInSection:(NSUInteger)section
-{
-    GNEOutlineViewParentItem *parentItem = [self p_outlineViewParentItemForSection:section];
-    
-    return [self p_outlineViewItemForFooterInOutlineViewParentItem:parentItem];
+            [weakSelf p_commitHeights:heightData ofRowHeightMeasurement:measurement ofParentItem:weakParentItem];
+        });
+    });
 }
 
 
 /**
- Returns the outline view item that represents the footer in the section of the specified
- outline view parent item or nil if the section for the parent item doesn't have a footer
- or can't be found.
+ Caches the specified heights of the rows of the specified measurement that are still valid and tells
+ NSOutlineView about them, keeping the visible rows in place.
+ 
+ @discussion Rows that were inserted or deleted since the measurement started shift the measured rows (see
+ -p_updateUnmeasuredRowsOfParentItem:insertedIndexes:deletedIndexes:), so each height is committed at the
+ measured row's current row. Rows that were deleted or scheduled to be measured again are skipped. The
+ measurement is discarded if it was removed from its outline view parent item or its section was deleted.
+ @param heightData Heights of the rows the measurement started with, in ascending order of their rows.
+ @param measurement Measurement whose heights to commit.
+ @param parentItem Outline view parent item of the measured section.
  */
-- (GNEOutlineViewItem *)p_outlineViewItemForFooterInOutlineViewParentItem:(GNEOutlineViewParentItem *)parentItem
+- (void)p_commitHeights:(NSData *)heightData
+ ofRowHeightMeasurement:(GNEOutlineViewRowHeightMeasurement *)measurement
+           ofParentItem:(GNEOutlineViewParentItem *)parentItem
 {
-    if (parentItem.hasFooter == NO)
+    NSUInteger index = [parentItem.rowHeightMeasurements indexOfObjectIdenticalTo:measurement];
+    if (parentItem == nil || index == NSNotFound)
     {
-        return nil;
+        return;
     }
+    [parentItem.rowHeightMeasurements removeObjectAtIndex:index];
     
-    NSUInteger section = [self p_sectionForOutlineViewParentItem:parentItem];
-    NSUInteger sectionCount = self.outlineViewItems.count;
+    NSUInteger section = parentItem.section;
+    if (section == NSNotFound || section >= self.model.numberOfSections ||
+        [self.model parentItemForSection:section] != parentItem || measurement.rows.count == 0)
+    {
+        return;
+    }
     
-    if (section == NSNotFound || section >= sectionCount)
+    // Rows that no longer exist, for example because the section was reloaded with fewer rows, are skipped.
+    GNEOutlineViewItemArray *items = [self.model itemsInSection:section];
+    NSUInteger rowCount = items.count - ((parentItem.hasFooter) ? 1 : 0);
+    NSMutableIndexSet *rows = measurement.rows;
+    [rows removeIndexesInRange:NSMakeRange(rowCount, NSNotFound - rowCount)];
+    NSUInteger count = rows.count;
+    if (count == 0)
     {
-        return nil;
+        return;
     }
     
-    NSArray *items = self.outlineViewItems[section];
-    NSUInteger rowCount = items.count;
+    NSMutableData *rowData = [NSMutableData dataWithLength:(count * sizeof(NSUInteger))];
+    NSMutableData *positionData = [NSMutableData dataWithLength:(count * sizeof(NSUInteger))];
+    [rows getIndexes:rowData.mutableBytes maxCount:count inIndexRange:NULL];
+    [measurement.positions getIndexes:positionData.mutableBytes maxCount:count inIndexRange:NULL];
     
-    if (rowCount == 0)
+    [self p_preserveVisibleRowsDuringChanges:^()
     {
-        return nil;
+        const NSUInteger *rowIndexes = rowData.bytes;
+        const NSUInteger *positions = positionData.bytes;
+        const CGFloat *heights = heightData.bytes;
+        for (NSUInteger i = 0; i < count; i++)
+        {
+            [items setHeight:heights[positions[i]] forObjectAtIndex:rowIndexes[i]];
+        }
+        [parentItem.unmeasuredRows removeIndexes:rows];
+        
+        [self p_noteHeightsOfRowsChanged:rows inSection:section];
+    }];
+}
+
+
+/// Updates the cached height of the specified section and tells NSOutlineView that the heights of the
+/// specified rows of the section changed, if they are in the outline view.
+- (void)p_noteHeightsOfRowsChanged:(NSIndexSet *)rows inSection:(NSUInteger)section
+{
+    [self p_updateHeightOfSection:section];
+    
+    GNEOutlineViewParentItem *parentItem = [self.model parentItemForSection:section];
+    NSInteger headerRow = [self rowForItem:parentItem];
+    if (headerRow < 0 || [self isItemExpanded:parentItem] == NO)
+    {
+        return;
     }
     
-    GNEOutlineViewItem *item = items[rowCount - 1];
+    NSMutableIndexSet *tableViewRows = [rows mutableCopy];
+    [tableViewRows shiftIndexesStartingAtIndex:0 by:(headerRow + 1)];
     
-    return item;
+    // The heights are already cached, so -noteHeightOfRowsWithIndexesChanged: must not measure them again.
+    [super noteHeightOfRowsWithIndexesChanged:tableViewRows];
 }
 
 
-/// Returns YES if the specified outline view item represents the footer in its section, otherwise NO.
-- (BOOL)p_isOutlineViewItemFooter:(GNEOutlineViewItem *)item
+// ------------------------------------------------------------------------------------------
+#pragma mark - GNESectionedTableView - Internal - Estimated Row Heights
+// ------------------------------------------------------------------------------------------
+/// Returns YES if the table view delegate estimates the heights of rows, otherwise NO. Sections whose rows
+/// have a uniform height are never estimated; see -p_rowHeightMeasurementInSection:measuringBlock:uniformHeight:.
+- (BOOL)p_delegateEstimatesRowHeights
 {
-    GNEOutlineViewParentItem *parentItem = item.parentItem;
+    id <GNESectionedTableViewDelegate> theDelegate = self.tableViewDelegate;
     
-    if (parentItem == nil || parentItem.hasFooter == NO)
+    return ([theDelegate respondsToSelector:@selector(tableView:estimatedHeightForRowsInSection:)] ||
+            self.delegateMethods.estimatedHeightForRow ||
+            [theDelegate respondsToSelector:@selector(tableView:estimatedHeightForRowAtIndexPath:)]);
+}
+
+
+/// Adds the specified rows to the estimated rows of the specified outline view parent item's section and
+/// schedules the measurement of the estimated rows near the visible rows.
+- (void)p_addEstimatedRows:(NSIndexSet *)rows toParentItem:(GNEOutlineViewParentItem *)parentItem
+{
+    if (rows.count == 0 || parentItem == nil)
     {
-        return NO;
+        return;
     }
     
-    NSUInteger childCount = [self p_numberOfOutlineViewItemsForOutlineViewParentItem:parentItem];
-    NSUInteger childIndex = [self p_childIndexOfOutlineViewItem:item];
+    if (parentItem.estimatedRows == nil)
+    {
+        parentItem.estimatedRows = [NSMutableIndexSet indexSet];
+    }
+    [parentItem.estimatedRows addIndexes:rows];
     
-    if (childCount == 0 || childIndex == NSNotFound)
+    [self p_scheduleEstimatedRowMeasurement];
+}
+
+
+/// Coalesces the insertions, expansions, and bounds changes of the clip view during a run loop iteration
+/// into a single measurement of the estimated rows near the visible rows.
+- (void)p_scheduleEstimatedRowMeasurement
+{
+    if (self.estimatedRowMeasurementScheduled || [self p_delegateEstimatesRowHeights] == NO)
     {
-        return NO;
+        return;
     }
     
-    return ((childCount - 1) == childIndex);
+    self.estimatedRowMeasurementScheduled = YES;
+    [self performSelector:@selector(p_measureEstimatedRowsNearVisibleRect)
+               withObject:nil
+               afterDelay:0.0
+                  inModes:@[NSRunLoopCommonModes]];
 }
 
 
-// ------------------------------------------------------------------------------------------
-#pragma mark - GNESectionedTableView - Internal - Counts
-// ------------------------------------------------------------------------------------------
-- (NSUInteger)p_numberOfSections
+/**
+ Replaces the estimated heights of the rows within kEstimatedRowMeasurementDistance of the visible rows
+ with their actual heights, keeping the topmost visible row in place.
+ 
+ @discussion Replacing estimates changes which rows are near the visible rows, so this is repeated until
+ there are no estimated rows left near them, up to kMaximumEstimatedRowMeasurementPasses times. Rows that
+ are scrolled into view later have already been measured, as long as the table view isn't scrolled by more
+ than kEstimatedRowMeasurementDistance per run loop iteration.
+ */
+- (void)p_measureEstimatedRowsNearVisibleRect
 {
-    if ([self.tableViewDataSource respondsToSelector:@selector(numberOfSectionsInTableView:)])
+    // Rows can't be measured in the middle of an update, so the measurement is scheduled again.
+    if (self.isUpdating)
     {
-        return [self.tableViewDataSource numberOfSectionsInTableView:self];
+        [self performSelector:@selector(p_measureEstimatedRowsNearVisibleRect)
+                   withObject:nil
+                   afterDelay:0.0
+                      inModes:@[NSRunLoopCommonModes]];
+        
+        return;
     }
     
-    return 0;
+    // The measurement stays scheduled until it's done, so that scrolling the visible rows back into place
+    // doesn't schedule another one.
+    for (NSUInteger pass = 0; pass < kMaximumEstimatedRowMeasurementPasses; pass++)
+    {
+        CGRect visibleRect = self.visibleRect;
+        if (CGRectIsEmpty(visibleRect))
+        {
+            break;
+        }
+        
+        CGRect rect = CGRectInset(visibleRect, 0.0, -visibleRect.size.height * kEstimatedRowMeasurementDistance);
+        __block BOOL didMeasureRows = NO;
+        [self p_preserveVisibleRowsDuringChanges:^()
+        {
+            didMeasureRows = [self p_measureEstimatedRowsInRect:rect];
+        }];
+        
+        if (didMeasureRows == NO)
+        {
+            break;
+        }
+    }
+    
+    self.estimatedRowMeasurementScheduled = NO;
 }
 
 
-- (NSUInteger)p_numberOfRowsInSection:(NSUInteger)section
+/// Replaces the estimated heights of the rows in the specified rectangle, located using the cached heights,
+/// with their actual heights. Returns YES if any estimated heights were replaced, otherwise NO.
+- (BOOL)p_measureEstimatedRowsInRect:(CGRect)rect
 {
-    if ([self.tableViewDataSource respondsToSelector:@selector(tableView:numberOfRowsInSection:)])
+    NSUInteger sectionCount = self.sectionHeights.count;
+    NSUInteger firstSection = [self.sectionHeights indexOfValueContainingSum:MAX(0.0, CGRectGetMinY(rect))];
+    if (sectionCount == 0 || firstSection == NSNotFound)
     {
-        return [self.tableViewDataSource tableView:self numberOfRowsInSection:section];
+        return NO;
     }
     
-    return 0;
+    NSUInteger lastSection = [self.sectionHeights indexOfValueContainingSum:CGRectGetMaxY(rect)];
+    if (lastSection == NSNotFound)
+    {
+        lastSection = sectionCount - 1;
+    }
+    
+    BOOL didMeasureRows = NO;
+    for (NSUInteger section = firstSection; section <= lastSection; section++)
+    {
+        GNEOutlineViewParentItem *parentItem = [self.model parentItemForSection:section];
+        if (parentItem.estimatedRows.count == 0 || [self isItemExpanded:parentItem] == NO)
+        {
+            continue;
+        }
+        
+        NSRange range = [self p_rangeOfRowsInSection:section intersectingRect:rect];
+        if ([self p_measureEstimatedRowsInRange:range inSection:section])
+        {
+            didMeasureRows = YES;
+        }
+    }
+    
+    return didMeasureRows;
 }
 
 
-/**
- Returns the total number of rows (headers, footers, and normal rows) contained in the outline
- view.
- */
-- (NSUInteger)p_numberOfRowsInOutlineView
+/// Returns the range of the rows (not including the footer) of the specified expanded section that intersect
+/// the specified rectangle, located using the cached heights.
+- (NSRange)p_rangeOfRowsInSection:(NSUInteger)section intersectingRect:(CGRect)rect
 {
-    NSUInteger sectionCount = self.outlineViewItems.count;
-    NSUInteger rowAndFooterCount = 0;
+    GNEOutlineViewParentItem *parentItem = [self.model parentItemForSection:section];
+    GNEOutlineViewItemArray *rows = [self.model itemsInSection:section];
+    NSUInteger rowCount = rows.count - ((parentItem.hasFooter) ? 1 : 0);
+    CGFloat spacing = self.intercellSpacing.height;
+    CGFloat rowsOriginY = [self.sectionHeights sumOfValuesBeforeIndex:section] + parentItem.height + spacing;
     
-    for (NSUInteger section = 0; section < sectionCount; section++)
+    if (rowCount == 0 || CGRectGetMaxY(rect) <= rowsOriginY)
+    {
+        return NSMakeRange(0, 0);
+    }
+    
+    NSUInteger firstRow = 0;
+    if (CGRectGetMinY(rect) > rowsOriginY)
+    {
+        [rows objectAtOffset:(CGRectGetMinY(rect) - rowsOriginY) spacing:spacing index:&firstRow];
+    }
+    if (firstRow >= rowCount)
     {
-        rowAndFooterCount += ((NSArray *)self.outlineViewItems[section]).count;
+        return NSMakeRange(0, 0);
     }
     
-    return (sectionCount + rowAndFooterCount); // Section headers count as rows even if they are not "visible"
+    // Offsets past the last row are in the footer or outside of the section.
+    NSUInteger lastRow = NSNotFound;
+    [rows objectAtOffset:(CGRectGetMaxY(rect) - rowsOriginY) spacing:spacing index:&lastRow];
+    if (lastRow >= rowCount)
+    {
+        lastRow = rowCount - 1;
+    }
+    
+    return NSMakeRange(firstRow, lastRow - firstRow + 1);
 }
 
 
 /**
- Returns the number of outline view items (including items that represent normal rows and footers)
- in the specified outline view parent item.
+ Replaces the estimated heights of the rows in the specified range of the specified section with the
+ heights returned by the table view delegate and tells NSOutlineView about them. Rows whose heights aren't
+ estimated are skipped.
+ 
+ @param range Range of the rows to measure.
+ @param section Section containing the rows.
+ @return YES if any estimated heights were replaced, otherwise NO.
  */
-- (NSUInteger)p_numberOfOutlineViewItemsForOutlineViewParentItem:(GNEOutlineViewParentItem *)parentItem
+- (BOOL)p_measureEstimatedRowsInRange:(NSRange)range inSection:(NSUInteger)section
 {
-    GNEParameterAssert([parentItem isKindOfClass:[GNEOutlineViewParentItem class]]);
+    GNEOutlineViewParentItem *parentItem = [self.model parentItemForSection:section];
+    if (parentItem.estimatedRows.count == 0 || range.length == 0)
+    {
+        return NO;
+    }
     
-    NSUInteger section = [self p_sectionForOutlineViewParentItem:parentItem];
-    if (section < self.outlineViewItems.count)
+    NSIndexSet *rows = [parentItem.estimatedRows indexesInRange:range
+                                                         options:0
+                                                     passingTest:^BOOL(NSUInteger index __unused, BOOL *stop __unused)
+    {
+        return YES;
+    }];
+    if (rows.count == 0)
     {
-        return ((NSArray *)self.outlineViewItems[section]).count;
+        return NO;
     }
     
-    return 0;
+    GNEOutlineViewItemArray *items = [self.model itemsInSection:section];
+    CGFloat uniformHeight = [self p_requestDelegateUniformHeightOfRowsInSection:section];
+    [rows enumerateRangesUsingBlock:^(NSRange rowRange, BOOL *stop __unused)
+    {
+        CGFloat *heights = calloc(rowRange.length, sizeof(CGFloat));
+        if (heights == NULL)
+        {
+            [NSException raise:kMemoryAllocationAssertionName format:@"%@", kMemoryAllocationAssertionReason];
+        }
+        
+        [self p_requestDelegateHeights:heights ofRowsInRange:rowRange inSection:section uniformHeight:uniformHeight];
+        for (NSUInteger i = 0; i < rowRange.length; i++)
+        {
+            [items setHeight:heights[i] forObjectAtIndex:(rowRange.location + i)];
+        }
+        
+        free(heights);
+    }];
+    [parentItem.estimatedRows removeIndexes:rows];
+    
+    [self p_noteHeightsOfRowsChanged:rows inSection:section];
+    
+    return YES;
 }
 
 
@@ -2029,7 +4205,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
         return NSNotFound;
     }
     
-    return [self p_sectionForOutlineViewParentItem:parentItem];
+    return [self.model sectionForParentItem:parentItem];
 }
 
 
@@ -2050,9 +4226,11 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
         BOOL shouldDelay = [self p_shouldDelayClickActionForOutlineViewItem:item];
         if (shouldDelay)
         {
+            NSNumber *rowNumber = @(clickedRow);
+            [self.delayedClickRowNumbers addObject:rowNumber];
             SEL selector = @selector(p_performClickActionForRowNumber:);
             [self performSelector:selector
-                       withObject:@(clickedRow)
+                       withObject:rowNumber
                        afterDelay:[NSEvent doubleClickInterval]];
         }
         else
@@ -2082,7 +4260,8 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
         if (parentItem == nil && [self.tableViewDelegate respondsToSelector:headerSelector])
         {
             [self p_cancelClickActions];
-            NSUInteger section = [self p_sectionForOutlineViewParentItem:(GNEOutlineViewParentItem *)item];
+            NSUInteger section = [self.model sectionForParentItem:(GNEOutlineViewParentItem *)item];
+            GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:didDoubleClickHeaderInSection:));
             [self.tableViewDelegate tableView:self didDoubleClickHeaderInSection:section];
         }
         
@@ -2091,18 +4270,20 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
             SEL footerSelector = @selector(tableView:didDoubleClickFooterInSection:);
             SEL rowSelector = @selector(tableView:didDoubleClickRowAtIndexPath:);
             
-            BOOL isFooter = [self p_isOutlineViewItemFooter:item];
-            NSIndexPath *indexPath = [self p_indexPathOfOutlineViewItem:item];
+            BOOL isFooter = [self.model isItemFooter:item];
+            NSIndexPath *indexPath = [self.model indexPathOfItem:item];
             
             if (isFooter && [self.tableViewDelegate respondsToSelector:footerSelector])
             {
                 [self p_cancelClickActions];
+                GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:didDoubleClickFooterInSection:));
                 [self.tableViewDelegate tableView:self
                     didDoubleClickFooterInSection:indexPath.gne_section];
             }
             else if (isFooter == NO && [self.tableViewDelegate respondsToSelector:rowSelector])
             {
                 [self p_cancelClickActions];
+                GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:didDoubleClickRowAtIndexPath:));
                 [self.tableViewDelegate tableView:self didDoubleClickRowAtIndexPath:indexPath];
             }
         }
@@ -2123,7 +4304,8 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
         SEL headerSelector = @selector(tableView:didClickHeaderInSection:);
         if (parentItem == nil && [self.tableViewDelegate respondsToSelector:headerSelector])
         {
-            NSUInteger section = [self p_sectionForOutlineViewParentItem:(GNEOutlineViewParentItem *)item];
+            NSUInteger section = [self.model sectionForParentItem:(GNEOutlineViewParentItem *)item];
+            GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:didClickHeaderInSection:));
             [self.tableViewDelegate tableView:self didClickHeaderInSection:section];
         }
         
@@ -2132,16 +4314,18 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
             SEL footerSelector = @selector(tableView:didClickFooterInSection:);
             SEL rowSelector = @selector(tableView:didClickRowAtIndexPath:);
             
-            BOOL isFooter = [self p_isOutlineViewItemFooter:item];
-            NSIndexPath *indexPath = [self p_indexPathOfOutlineViewItem:item];
+            BOOL isFooter = [self.model isItemFooter:item];
+            NSIndexPath *indexPath = [self.model indexPathOfItem:item];
             
             if (isFooter && [self.tableViewDelegate respondsToSelector:footerSelector])
             {
+                GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:didClickFooterInSection:));
                 [self.tableViewDelegate tableView:self
                           didClickFooterInSection:indexPath.gne_section];
             }
             else if (isFooter == NO && [self.tableViewDelegate respondsToSelector:rowSelector])
             {
+                GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:didClickRowAtIndexPath:));
                 [self.tableViewDelegate tableView:self didClickRowAtIndexPath:indexPath];
             }
         }
@@ -2160,7 +4344,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     SEL footerSelector = @selector(tableView:didDoubleClickFooterInSection:);
     SEL rowSelector = @selector(tableView:didDoubleClickRowAtIndexPath:);
     
-    NSIndexPath *indexPath = [self p_indexPathOfOutlineViewItem:item];
+    NSIndexPath *indexPath = [self.model indexPathOfItem:item];
     if ([self isIndexPathHeader:indexPath])
     {
         return ([self.tableViewDelegate respondsToSelector:headerSelector]);
@@ -2178,24 +4362,173 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 }
 
 
+/**
+ Cancels the delayed click actions. Only the requests to perform click actions are cancelled, because
+ the table view also schedules the updates of its prefetched rows and estimated row heights with
+ -performSelector:withObject:afterDelay:inModes:.
+ */
 - (void)p_cancelClickActions
 {
-    [NSObject cancelPreviousPerformRequestsWithTarget:self];
+    SEL selector = @selector(p_performClickActionForRowNumber:);
+    for (NSNumber *rowNumber in self.delayedClickRowNumbers)
+    {
+        [NSObject cancelPreviousPerformRequestsWithTarget:self selector:selector object:rowNumber];
+    }
+    [self.delayedClickRowNumbers removeAllObjects];
 }
 
 
 - (NSArray *)p_selectedIndexPathsInSection:(NSUInteger)section
 {
-    NSArray *selectedIndexPaths = self.selectedIndexPaths;
+    [self p_updateSelectionIfNeeded];
+    
+    return [self.model selectedIndexPathsInSection:section];
+}
+
+
+/**
+ Rebuilds the model's selection from NSOutlineView's selected rows if the selection has changed
+ without going through the selection methods overridden above.
+ 
+ @discussion Those methods apply the rows they select and deselect to the model right away. Other
+ changes, made by collapsing sections or by NSOutlineView itself, are only noticed through
+ NSOutlineViewSelectionDidChangeNotification. Between changes, the model keeps its selection in sync
+ with inserted and deleted sections and rows, so the selected index paths never have to be resolved
+ from table view rows and sorted again. O(r + s) for r ranges of selected rows spanning s sections
+ */
+- (void)p_updateSelectionIfNeeded
+{
+    if (self.selectionNeedsUpdate == NO)
+    {
+        return;
+    }
+    
+    self.selectionNeedsUpdate = NO;
+    [self.model deselectAllItems];
+    [self p_setTableViewRows:self.selectedRowIndexes selectedInModel:YES];
+}
+
+
+/// Remembers the selected rows before one of the overridden selection methods changes them. Nested
+/// changes are applied together when the outermost change ends.
+- (void)p_beginSelectionChange
+{
+    if (self.selectionChangeCount == 0)
+    {
+        self.previouslySelectedRows = self.selectedRowIndexes;
+    }
+    
+    self.selectionChangeCount += 1;
+}
+
+
+- (void)p_endSelectionChange
+{
+    GNEParameterAssert(self.selectionChangeCount > 0);
+    
+    self.selectionChangeCount -= 1;
+    
+    if (self.selectionChangeCount == 0)
+    {
+        [self p_applySelectionChange];
+        self.previouslySelectedRows = nil;
+    }
+}
+
+
+/// Applies the rows selected and deselected since the last call to the model's selection.
+- (void)p_applySelectionChange
+{
+    NSIndexSet *previousRows = self.previouslySelectedRows;
+    NSIndexSet *currentRows = self.selectedRowIndexes;
+    
+    self.previouslySelectedRows = currentRows;
+    [self p_updateSelectionFromRows:(previousRows ?: [NSIndexSet indexSet]) toRows:currentRows];
+}
+
+
+/**
+ Applies the change from the specified previously selected table view rows to the specified currently
+ selected table view rows to the model's selection.
+ 
+ @discussion Only the ranges of rows that were deselected or selected are resolved, so extending or
+ shrinking a large selection doesn't touch the rows that stay selected. O(r + s) for r changed ranges
+ spanning s sections
+ */
+- (void)p_updateSelectionFromRows:(NSIndexSet *)previousRows toRows:(NSIndexSet *)currentRows
+{
+    // The whole selection is rebuilt before it's read next anyway.
+    if (self.selectionNeedsUpdate)
+    {
+        return;
+    }
+    
+    if (currentRows.count == 0)
+    {
+        [self.model deselectAllItems];
+        
+        return;
+    }
+    
+    NSMutableIndexSet *deselectedRows = [previousRows mutableCopy];
+    [deselectedRows removeIndexes:currentRows];
+    
+    NSMutableIndexSet *selectedRows = [currentRows mutableCopy];
+    [selectedRows removeIndexes:previousRows];
+    
+    [self p_setTableViewRows:deselectedRows selectedInModel:NO];
+    [self p_setTableViewRows:selectedRows selectedInModel:YES];
+}
+
+
+/**
+ Adds the section headers, rows, and section footers displayed in the specified table view rows to the
+ model's selection or removes them from it. O(r + s) for r ranges spanning s sections
+ */
+- (void)p_setTableViewRows:(NSIndexSet *)tableViewRows selectedInModel:(BOOL)selected
+{
+    if (tableViewRows.count == 0)
+    {
+        return;
+    }
+    
+    GNESectionedTableViewModel *model = self.model;
+    NSIndexSet *headers = nil;
+    NSIndexSet *footers = nil;
+    NSMutableDictionary *itemsBySection = [[self p_rowsBySectionForTableViewRows:tableViewRows
+                                                                         headers:&headers
+                                                                         footers:&footers] mutableCopy];
     
-    NSIndexSet *matchingIndexes = [selectedIndexPaths indexesOfObjectsPassingTest:^BOOL(NSIndexPath *indexPath,
-                                                                                        NSUInteger idx __unused,
-                                                                                        BOOL *stop __unused)
+    // Footers are the last items of their sections.
+    [footers enumerateIndexesUsingBlock:^(NSUInteger section, BOOL *stop __unused)
     {
-        return (section == indexPath.gne_section);
+        NSMutableIndexSet *items = [itemsBySection[@(section)] mutableCopy] ?: [NSMutableIndexSet indexSet];
+        [items addIndex:([model numberOfItemsInSection:section] - 1)];
+        itemsBySection[@(section)] = items;
     }];
     
-    return [selectedIndexPaths objectsAtIndexes:matchingIndexes];
+    if (selected)
+    {
+        [model selectHeadersInSections:headers];
+    }
+    else
+    {
+        [model deselectHeadersInSections:headers];
+    }
+    
+    [itemsBySection enumerateKeysAndObjectsUsingBlock:^(NSNumber *sectionNumber,
+                                                        NSIndexSet *items,
+                                                        BOOL *stop __unused)
+    {
+        if (selected)
+        {
+            [model selectItemsAtIndexes:items inSection:sectionNumber.unsignedIntegerValue];
+        }
+        else
+        {
+            [model deselectItemsAtIndexes:items inSection:sectionNumber.unsignedIntegerValue];
+        }
+    }];
 }
 
 
@@ -2210,6 +4543,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     
     if ([self.tableViewDataSource respondsToSelector:@selector(draggedTypesForTableView:)])
     {
+        GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(draggedTypesForTableView:));
         NSArray *additionalTypes = [self.tableViewDataSource draggedTypesForTableView:self];
         
         if (additionalTypes.count > 0)
@@ -2229,6 +4563,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     SEL selector = @selector(tableView:didUpdateDrag:);
     if ([self.tableViewDataSource respondsToSelector:selector])
     {
+        GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:didUpdateDrag:));
         [self.tableViewDataSource tableView:self didUpdateDrag:info];
     }
 }
@@ -2238,7 +4573,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 {
     for (GNEOutlineViewItem *item in items)
     {
-        NSUInteger section = [self p_sectionForOutlineViewParentItem:(GNEOutlineViewParentItem *)item];
+        NSUInteger section = [self.model sectionForParentItem:(GNEOutlineViewParentItem *)item];
         
         if (section == NSNotFound)
         {
@@ -2289,11 +4624,12 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
         __strong typeof(weakSelf) strongSelf = weakSelf;
 
         GNEOutlineViewItem *draggedItem = [strongSelf p_draggedItemForDraggingItem:draggingItem];
-        NSIndexPath *fromIndexPath = [self p_indexPathOfOutlineViewItem:draggedItem];
+        NSIndexPath *fromIndexPath = [self.model indexPathOfItem:draggedItem];
 
         SEL selector = @selector(tableView:canDragSection:toSection:);
         if (fromIndexPath && [strongSelf.tableViewDataSource respondsToSelector:selector])
         {
+            GNEStatisticsRecordCallout(strongSelf.statisticsRecorder, @selector(tableView:canDragSection:toSection:));
             canDrag = [strongSelf.tableViewDataSource tableView:self
                                                  canDragSection:fromIndexPath.gne_section
                                                       toSection:targetSection];
@@ -2319,7 +4655,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
                           proposedParentItem:(GNEOutlineViewItem *)proposedParentItem
                           proposedChildIndex:(NSInteger)proposedChildIndex
 {
-    NSUInteger toSection = [self p_sectionForOutlineViewParentItem:(GNEOutlineViewParentItem *)proposedParentItem];
+    NSUInteger toSection = [self.model sectionForParentItem:(GNEOutlineViewParentItem *)proposedParentItem];
     SEL selector = @selector(tableView:canDragRowAtIndexPath:toIndexPath:);
     
     if (proposedChildIndex == NSOutlineViewDropOnItemIndex)
@@ -2331,7 +4667,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     else if (toSection != NSNotFound && [self.tableViewDataSource respondsToSelector:selector])
     {
         GNEParameterAssert([proposedParentItem isKindOfClass:[GNEOutlineViewParentItem class]]);
-        GNEParameterAssert(toSection < self.outlineViewItems.count);
+        GNEParameterAssert(toSection < self.model.numberOfSections);
         
         __block BOOL canDrag = NO;
         
@@ -2361,7 +4697,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
             }
             
             GNEOutlineViewItem *draggedItem = [strongSelf p_draggedItemForDraggingItem:draggingItem];
-            NSIndexPath *fromIndexPath = [strongSelf p_indexPathOfOutlineViewItem:draggedItem];
+            NSIndexPath *fromIndexPath = [strongSelf.model indexPathOfItem:draggedItem];
             
             if (fromIndexPath == nil)
             {
@@ -2370,6 +4706,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
                 return;
             }
             
+            GNEStatisticsRecordCallout(strongSelf.statisticsRecorder, @selector(tableView:canDragRowAtIndexPath:toIndexPath:));
             canDrag = [strongSelf.tableViewDataSource tableView:strongSelf
                                           canDragRowAtIndexPath:fromIndexPath
                                                     toIndexPath:toIndexPath];
@@ -2415,8 +4752,8 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
         }
         
         GNEOutlineViewItem *draggedItem = [strongSelf p_draggedItemForDraggingItem:draggingItem];
-        NSIndexPath *fromIndexPath = [strongSelf p_indexPathOfOutlineViewItem:draggedItem];
-        BOOL isFooter = [strongSelf p_isOutlineViewItemFooter:proposedParentItem];
+        NSIndexPath *fromIndexPath = [strongSelf.model indexPathOfItem:draggedItem];
+        BOOL isFooter = [strongSelf.model isItemFooter:proposedParentItem];
         
         if (fromIndexPath == nil || isFooter)
         {
@@ -2429,9 +4766,10 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
             [strongSelf.tableViewDataSource respondsToSelector:headerSelector])
         {
             GNEOutlineViewParentItem *theParentItem = (GNEOutlineViewParentItem *)proposedParentItem;
-            NSUInteger section = [strongSelf p_sectionForOutlineViewParentItem:theParentItem];
+            NSUInteger section = [strongSelf.model sectionForParentItem:theParentItem];
             if (section != NSNotFound)
             {
+                GNEStatisticsRecordCallout(strongSelf.statisticsRecorder, @selector(tableView:canDropRowAtIndexPath:onHeaderInSection:));
                 canDropOn = [strongSelf.tableViewDataSource tableView:strongSelf
                                                 canDropRowAtIndexPath:fromIndexPath
                                                     onHeaderInSection:section];
@@ -2440,9 +4778,10 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
         if (proposedParentItem && parentItem &&
             [strongSelf.tableViewDataSource respondsToSelector:rowSelector])
         {
-            NSIndexPath *toIndexPath = [strongSelf p_indexPathOfOutlineViewItem:proposedParentItem];
+            NSIndexPath *toIndexPath = [strongSelf.model indexPathOfItem:proposedParentItem];
             if (toIndexPath)
             {
+                GNEStatisticsRecordCallout(strongSelf.statisticsRecorder, @selector(tableView:canDropRowAtIndexPath:onRowAtIndexPath:));
                 canDropOn = [strongSelf.tableViewDataSource tableView:strongSelf
                                                 canDropRowAtIndexPath:fromIndexPath
                                                      onRowAtIndexPath:toIndexPath];
@@ -2463,16 +4802,17 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 - (BOOL)p_performDropOnDragOperationWithProposedParentItem:(GNEOutlineViewItem *)proposedParentItem
                                             fromIndexPaths:(NSArray *)fromIndexPaths
 {
-    GNEParameterAssert([self p_isOutlineViewItemFooter:proposedParentItem] == NO);
+    GNEParameterAssert([self.model isItemFooter:proposedParentItem] == NO);
     
     SEL headerSelector = @selector(tableView:didDropRowsAtIndexPaths:onHeaderInSection:);
     SEL rowSelector = @selector(tableView:didDropRowsAtIndexPaths:onRowAtIndexPath:);
     
     GNEOutlineViewParentItem *parentItem = proposedParentItem.parentItem;
-    NSIndexPath *toIndexPath = [self p_indexPathOfOutlineViewItem:proposedParentItem];
+    NSIndexPath *toIndexPath = [self.model indexPathOfItem:proposedParentItem];
     
     if (parentItem == nil && [self.tableViewDataSource respondsToSelector:headerSelector])
     {
+        GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:didDropRowsAtIndexPaths:onHeaderInSection:));
         [self.tableViewDataSource tableView:self
                     didDropRowsAtIndexPaths:fromIndexPaths
                           onHeaderInSection:toIndexPath.gne_section];
@@ -2482,6 +4822,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     else if (parentItem && toIndexPath && fromIndexPaths.count > 0 &&
              [self.tableViewDataSource respondsToSelector:rowSelector])
     {
+        GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:didDropRowsAtIndexPaths:onRowAtIndexPath:));
         [self.tableViewDataSource tableView:self
                     didDropRowsAtIndexPaths:fromIndexPaths
                            onRowAtIndexPath:toIndexPath];
@@ -2499,6 +4840,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     SEL sectionSelector = @selector(tableView:didDragSections:toSection:);
     if (fromSections.count > 0 && [self.tableViewDataSource respondsToSelector:sectionSelector])
     {
+        GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:didDragSections:toSection:));
         [self.tableViewDataSource tableView:self
                             didDragSections:fromSections
                                   toSection:(NSUInteger)proposedChildIndex];
@@ -2516,13 +4858,14 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 {
     GNEParameterAssert([proposedParentItem isKindOfClass:[GNEOutlineViewParentItem class]]);
     
-    NSUInteger toSection = [self p_sectionForOutlineViewParentItem:(GNEOutlineViewParentItem *)proposedParentItem];
+    NSUInteger toSection = [self.model sectionForParentItem:(GNEOutlineViewParentItem *)proposedParentItem];
     NSIndexPath *toIndexPath = [NSIndexPath gne_indexPathForRow:(NSUInteger)proposedChildIndex
                                                       inSection:toSection];
     
     SEL rowSelector = @selector(tableView:didDragRowsAtIndexPaths:toIndexPath:);
     if (toIndexPath && fromIndexPaths.count > 0 && [self.tableViewDataSource respondsToSelector:rowSelector])
     {
+        GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:didDragRowsAtIndexPaths:toIndexPath:));
         [self.tableViewDataSource tableView:self
                     didDragRowsAtIndexPaths:fromIndexPaths
                                 toIndexPath:toIndexPath];
@@ -2610,14 +4953,14 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
         GNEParameterAssert([proposedParent isKindOfClass:[GNEOutlineViewParentItem class]]);
         
         GNEOutlineViewParentItem *aParentItem = (GNEOutlineViewParentItem *)proposedParent;
-        NSUInteger toSection = [self p_sectionForOutlineViewParentItem:aParentItem];
+        NSUInteger toSection = [self.model sectionForParentItem:aParentItem];
         
         if (toSection > 0 && toSection != NSNotFound)
         {
             NSUInteger prevSection = toSection - 1;
-            GNEOutlineViewParentItem *prevParentItem = [self p_outlineViewParentItemForSection:prevSection];
+            GNEOutlineViewParentItem *prevParentItem = [self.model parentItemForSection:prevSection];
             GNEParameterAssert(prevParentItem);
-            NSUInteger rowCount = [self p_numberOfOutlineViewItemsForOutlineViewParentItem:prevParentItem];
+            NSUInteger rowCount = [self.model numberOfItemsInParentItem:prevParentItem];
             *proposedParentItemPtr = prevParentItem;
             *proposedChildIndexPtr = (NSInteger)rowCount;
             [self setDropItem:prevParentItem dropChildIndex:proposedChildIndex];
@@ -2643,10 +4986,10 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
          */
         
         BOOL hasFooter = parentItem.hasFooter;
-        NSIndexPath *indexPath = [self p_indexPathOfOutlineViewItem:proposedParent];
+        NSIndexPath *indexPath = [self.model indexPathOfItem:proposedParent];
         CGRect rowFrame = [self frameOfViewAtIndexPath:indexPath];
         NSUInteger proposedParentChildIndex = (indexPath) ? indexPath.gne_row : NSNotFound;
-        NSUInteger rowCount = [self p_numberOfOutlineViewItemsForOutlineViewParentItem:parentItem];
+        NSUInteger rowCount = [self.model numberOfItemsInParentItem:parentItem];
         
         if (CGRectEqualToRect(CGRectZero, rowFrame) == NO &&
             proposedParentChildIndex != NSNotFound &&
@@ -2656,12 +4999,12 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
             
             if (hasFooter)
             {
-                NSUInteger sectionCount = self.outlineViewParentItems.count;
-                NSUInteger section = [self p_sectionForOutlineViewParentItem:parentItem];
+                NSUInteger sectionCount = self.model.numberOfSections;
+                NSUInteger section = [self.model sectionForParentItem:parentItem];
                 NSUInteger nextSection = section + 1;
                 if (nextSection < sectionCount) // It's not the last section.
                 {
-                    GNEOutlineViewParentItem *nextSectionParentItem = self.outlineViewParentItems[nextSection];
+                    GNEOutlineViewParentItem *nextSectionParentItem = [self.model parentItemForSection:nextSection];
                     *proposedParentItemPtr = nextSectionParentItem;
                     *proposedChildIndexPtr = 0;
                     [self setDropItem:nextSectionParentItem dropChildIndex:0];
@@ -2700,25 +5043,23 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 - (NSIndexPath *)p_targetIndexPathForDragToProposedParentItem:(GNEOutlineViewItem *)proposedParentItem
                                            proposedChildIndex:(NSInteger)proposedChildIndex
 {
-    GNEParameterAssert(self.outlineViewParentItems.count == self.outlineViewItems.count);
-    
     GNEOutlineViewParentItem *parentItem = (GNEOutlineViewParentItem *)proposedParentItem;
     
-    NSUInteger sectionCount = self.outlineViewItems.count;
-    NSUInteger toSection = [self p_sectionForOutlineViewParentItem:parentItem];
+    NSUInteger sectionCount = self.model.numberOfSections;
+    NSUInteger toSection = [self.model sectionForParentItem:parentItem];
     
     if (toSection == NSNotFound || toSection >= sectionCount)
     {
         return nil;
     }
     
-    NSUInteger rowCount = ((NSArray *)self.outlineViewItems[toSection]).count;
+    NSUInteger rowCount = [self.model numberOfItemsInSection:toSection];
     if (parentItem.hasFooter && (NSUInteger)proposedChildIndex == rowCount)
     {
         NSUInteger nextSection = toSection + 1;
         if (nextSection < sectionCount)
         {
-            GNEOutlineViewParentItem *nextParentItem = self.outlineViewParentItems[nextSection];
+            GNEOutlineViewParentItem *nextParentItem = [self.model parentItemForSection:nextSection];
             [self setDropItem:nextParentItem dropChildIndex:0];
             
             return [NSIndexPath gne_indexPathForRow:0 inSection:nextSection];
@@ -2763,7 +5104,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     
     if (indexPath)
     {
-        draggedItem = [self p_outlineViewItemAtIndexPath:indexPath];
+        draggedItem = [self.model itemAtIndexPath:indexPath];
     }
     
     return draggedItem;
@@ -2838,26 +5179,108 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 }
 
 
-- (NSString *)p_mapKeyForRowView:(NSTableRowView *)rowView
+- (void)p_noteRowViewsShiftedStartingAtSection:(NSUInteger)section
 {
-    if (rowView)
+    if (section == NSNotFound || section >= self.firstShiftedSection)
+    {
+        return;
+    }
+    
+    self.firstShiftedSection = section;
+    
+    // Rows in sections at or after the first shifted section are already covered.
+    NSMutableArray *coveredSections = [NSMutableArray array];
+    for (NSNumber *sectionNumber in self.firstShiftedRowsBySection)
+    {
+        if (sectionNumber.unsignedIntegerValue >= section)
+        {
+            [coveredSections addObject:sectionNumber];
+        }
+    }
+    [self.firstShiftedRowsBySection removeObjectsForKeys:coveredSections];
+}
+
+
+- (void)p_noteRowViewsShiftedStartingAtRow:(NSUInteger)row inSection:(NSUInteger)section
+{
+    if (row == NSNotFound || section == NSNotFound || section >= self.firstShiftedSection)
     {
-        return [NSString stringWithFormat:@"%p", rowView];
+        return;
     }
     
-    return nil;
+    NSNumber *firstShiftedRow = self.firstShiftedRowsBySection[@(section)];
+    if (firstShiftedRow == nil || row < firstShiftedRow.unsignedIntegerValue)
+    {
+        self.firstShiftedRowsBySection[@(section)] = @(row);
+    }
 }
 
 
-- (void)p_updateMapForAvailableRowViews
+- (BOOL)p_isIndexPathShifted:(NSIndexPath *)indexPath
 {
-    __weak typeof(self) weakSelf = self;
-    [self enumerateAvailableRowViewsUsingBlock:^(NSTableRowView *rowView, NSInteger row)
+    NSUInteger section = indexPath.gne_section;
+    if (section >= self.firstShiftedSection)
     {
-        __strong typeof(weakSelf) strongSelf = weakSelf;
-        NSIndexPath *indexPath = [strongSelf indexPathForTableViewRow:row];
-        [strongSelf p_updateMapForRowView:rowView indexPath:indexPath];
-    }];
+        return YES;
+    }
+    
+    if ([self isIndexPathHeader:indexPath] || [self isIndexPathFooter:indexPath])
+    {
+        return NO;
+    }
+    
+    if (self.firstShiftedRowsBySection.count == 0)
+    {
+        return NO;
+    }
+    
+    NSNumber *firstShiftedRow = self.firstShiftedRowsBySection[@(section)];
+    
+    return (firstShiftedRow && indexPath.gne_row >= firstShiftedRow.unsignedIntegerValue);
+}
+
+
+/**
+ Re-resolves the index paths of the mapped row views whose index paths were shifted by the
+ insertions and deletions since the last call. Row views that aren't currently in the table
+ view keep their old index paths so that -outlineView:didRemoveRowView:forRow: can still
+ report them to the delegate.
+ */
+- (void)p_updateMapForShiftedRowViews
+{
+    GNEParameterAssert([NSThread isMainThread]);
+    
+    if (self.firstShiftedSection == NSNotFound && self.firstShiftedRowsBySection.count == 0)
+    {
+        return;
+    }
+    
+    GNEStatisticsRecordRowViewMapRebuild(self.statisticsRecorder);
+    
+    NSMutableArray *shiftedRowViews = [NSMutableArray array];
+    for (NSTableRowView *rowView in self.rowViewToIndexPathMap)
+    {
+        NSIndexPath *indexPath = [self.rowViewToIndexPathMap objectForKey:rowView];
+        if (indexPath == nil || [self p_isIndexPathShifted:indexPath])
+        {
+            [shiftedRowViews addObject:rowView];
+        }
+    }
+    
+    self.firstShiftedSection = NSNotFound;
+    [self.firstShiftedRowsBySection removeAllObjects];
+    
+    for (NSTableRowView *rowView in shiftedRowViews)
+    {
+        NSInteger tableViewRow = [self rowForView:rowView];
+        if (tableViewRow < 0)
+        {
+            continue;
+        }
+        
+        NSIndexPath *indexPath = [self indexPathForTableViewRow:tableViewRow];
+        [self p_updateMapForRowView:rowView indexPath:indexPath];
+    }
 }
 
 
@@ -2868,15 +5291,14 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     
     if (isRowViewValid)
     {
-        NSString *key = [self p_mapKeyForRowView:rowView];
         if (indexPath)
         {
             NSIndexPath *value = [indexPath copy];
-            self.rowViewToIndexPathMap[key] = value;
+            [self.rowViewToIndexPathMap setObject:value forKey:rowView];
         }
         else
         {
-            [self.rowViewToIndexPathMap removeObjectForKey:key];
+            [self.rowViewToIndexPathMap removeObjectForKey:rowView];
         }
     }
 }
@@ -2884,11 +5306,9 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 
 - (NSIndexPath *)p_indexPathForRowView:(NSTableRowView *)rowView
 {
-    if ([rowView isKindOfClass:[NSTableRowView class]])
+    if (rowView)
     {
-        NSString *key = [self p_mapKeyForRowView:rowView];
-        
-        return (NSIndexPath *)self.rowViewToIndexPathMap[key];
+        return (NSIndexPath *)[self.rowViewToIndexPathMap objectForKey:rowView];
     }
     
     return nil;
@@ -2936,7 +5356,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     NSUInteger numberOfRowsInDataSource = numberOfRows(dataSource, numberOfRowsSelector);
     NSUInteger numberOfFootersInDataSource = numberOfFooters(dataSource, numberOfFootersSelector);
     NSUInteger totalNumberOfRowsInDataSource = numberOfRowsInDataSource + numberOfFootersInDataSource;
-    NSUInteger numberOfRowsInOutlineView = [self p_numberOfRowsInOutlineView] - [self p_numberOfSections];
+    NSUInteger numberOfRowsInOutlineView = self.model.numberOfItems - [self p_numberOfSections];
     
     GNEParameterAssert(totalNumberOfRowsInDataSource == numberOfRowsInOutlineView);
 }
@@ -2969,7 +5389,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 // ------------------------------------------------------------------------------------------
 - (NSInteger)numberOfRowsInOutlineView:(NSOutlineView * __unused)outlineView
 {
-    return (NSInteger)[self p_numberOfRowsInOutlineView];
+    return (NSInteger)self.model.numberOfItems;
 }
 
 
@@ -2979,7 +5399,12 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 {
     GNEParameterAssert(parentItem == nil || [parentItem isKindOfClass:[GNEOutlineViewParentItem class]]);
     
-    return [self p_outlineViewItemAtIndex:(NSUInteger)index ofParent:parentItem];
+    if (parentItem)
+    {
+        [self.parentItemsWithOutlineViewItems addObject:parentItem];
+    }
+    
+    return [self.model itemAtIndex:(NSUInteger)index ofParentItem:parentItem];
 }
 
 
@@ -3013,7 +5438,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
         {
             GNEOutlineViewParentItem *parentItem = (GNEOutlineViewParentItem *)item;
             
-            return (NSInteger)[self p_numberOfOutlineViewItemsForOutlineViewParentItem:parentItem];
+            return (NSInteger)[self.model numberOfItemsInParentItem:parentItem];
         }
         else // Child objects cannot have children (they are too young!!!).
         {
@@ -3022,7 +5447,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     }
     
     // Root item has all of the parent items (sections) as children.
-    return (NSInteger)self.outlineViewParentItems.count;
+    return (NSInteger)self.model.numberOfSections;
 }
 
 
@@ -3048,32 +5473,23 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     // Section header
     if (parentItem == nil)
     {
-        NSUInteger section = [self p_sectionForOutlineViewParentItem:(GNEOutlineViewParentItem *)item];
-        if (section != NSNotFound &&
-            [self p_requestDelegateHasHeaderInSection:section])
-        {
-            return [self.tableViewDelegate tableView:self heightForHeaderInSection:section];
-        }
-        
-        return GNESectionedTableViewInvisibleRowHeight;
-    }
-    
-    NSUInteger section = [self p_sectionForOutlineViewParentItem:parentItem];
-    
-    // Section footer
-    if ([self p_isOutlineViewItemFooter:item])
-    {
-        GNEParameterAssert([self.tableViewDelegate
-                            respondsToSelector:@selector(tableView:heightForFooterInSection:)]);
+        GNEOutlineViewParentItem *headerItem = (GNEOutlineViewParentItem *)item;
+        NSUInteger section = [self.model sectionForParentItem:headerItem];
         
-        return [self.tableViewDelegate tableView:self heightForFooterInSection:section];
+        return ((section == NSNotFound) ? GNESectionedTableViewInvisibleRowHeight : headerItem.height);
     }
     
-    // Row
-    NSIndexPath *indexPath = [self p_indexPathOfOutlineViewItem:item];
-    if (indexPath && [self.tableViewDelegate respondsToSelector:@selector(tableView:heightForRowAtIndexPath:)])
+    // Section footer or row. Their heights are cached when they're inserted and when
+    // -noteHeightOfRowsWithIndexesChanged: is called.
+    NSUInteger section = [self.model sectionForParentItem:parentItem];
+    if (section != NSNotFound && section < self.model.numberOfSections)
     {
-        return [self.tableViewDelegate tableView:self heightForRowAtIndexPath:indexPath];
+        GNEOutlineViewItemArray *rows = [self.model itemsInSection:section];
+        NSUInteger index = [rows indexOfObject:item];
+        if (index != NSNotFound)
+        {
+            return [rows heightOfObjectAtIndex:index];
+        }
     }
     
     return kDefaultRowHeight;
@@ -3091,7 +5507,8 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 - (NSTableRowView *)outlineView:(NSOutlineView *)outlineView rowViewForItem:(GNEOutlineViewItem *)item
 {
     GNEParameterAssert(item == nil || [item isKindOfClass:[GNEOutlineViewItem class]]);
-    GNEParameterAssert([self.tableViewDelegate respondsToSelector:@selector(tableView:rowViewForRowAtIndexPath:)]);
+    GNEParameterAssert(self.delegateMethods.rowViewForRow ||
+                       [self.tableViewDelegate respondsToSelector:@selector(tableView:rowViewForRowAtIndexPath:)]);
     
     NSTableRowView *rowView = nil;
     NSIndexPath *indexPath = nil;
@@ -3101,13 +5518,14 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     // Section header
     if (parentItem == nil)
     {
-        NSUInteger section = [self p_sectionForOutlineViewParentItem:(GNEOutlineViewParentItem *)item];
+        NSUInteger section = [self.model sectionForParentItem:(GNEOutlineViewParentItem *)item];
         if (section != NSNotFound)
         {
             indexPath = [self indexPathForHeaderInSection:section];
             
             if ([self p_requestDelegateHasHeaderInSection:section])
             {
+                GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:rowViewForHeaderInSection:));
                 rowView = [self.tableViewDelegate tableView:self rowViewForHeaderInSection:section];
             }
             else
@@ -3124,17 +5542,18 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
             }
         }
     }
-    else if ([self p_isOutlineViewItemFooter:item]) // Section footer
+    else if ([self.model isItemFooter:item]) // Section footer
     {
         GNEParameterAssert([self.tableViewDelegate
                             respondsToSelector:@selector(tableView:rowViewForFooterInSection:)]);
         
-        NSUInteger section = [self p_sectionForOutlineViewParentItem:parentItem];
+        NSUInteger section = [self.model sectionForParentItem:parentItem];
         GNEParameterAssert(section != NSNotFound);
         
         if (section != NSNotFound)
         {
             indexPath = [self indexPathForFooterInSection:section];
+            GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:rowViewForFooterInSection:));
             rowView = [self.tableViewDelegate tableView:self
                               rowViewForFooterInSection:section];
             GNEParameterAssert(rowView);
@@ -3142,9 +5561,17 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     }
     else // Row
     {
-        indexPath = [self p_indexPathOfOutlineViewItem:item];
-        if (indexPath)
+        indexPath = [self.model indexPathOfItem:item];
+        if (indexPath && self.delegateMethods.rowViewForRow)
+        {
+            GNESectionedIndexPath sectionedIndexPath = GNESectionedIndexPathMake(indexPath.gne_row,
+                                                                                 indexPath.gne_section);
+            GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:rowViewForRowAtSectionedIndexPath:));
+            rowView = [self.tableViewDelegate tableView:self rowViewForRowAtSectionedIndexPath:sectionedIndexPath];
+        }
+        else if (indexPath)
         {
+            GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:rowViewForRowAtIndexPath:));
             rowView = [self.tableViewDelegate tableView:self rowViewForRowAtIndexPath:indexPath];
         }
     }
@@ -3160,16 +5587,18 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
                    item:(GNEOutlineViewItem *)item
 {
     GNEParameterAssert(item == nil || [item isKindOfClass:[GNEOutlineViewItem class]]);
-    GNEParameterAssert([self.tableViewDataSource respondsToSelector:@selector(tableView:cellViewForRowAtIndexPath:)]);
+    GNEParameterAssert(self.delegateMethods.cellViewForRow ||
+                       [self.tableViewDelegate respondsToSelector:@selector(tableView:cellViewForRowAtIndexPath:)]);
     
     GNEOutlineViewParentItem *parentItem = item.parentItem;
     
     // Section header
     if (parentItem == nil)
     {
-        NSUInteger section = [self p_sectionForOutlineViewParentItem:(GNEOutlineViewParentItem *)item];
+        NSUInteger section = [self.model sectionForParentItem:(GNEOutlineViewParentItem *)item];
         if (section != NSNotFound && [self p_requestDelegateHasHeaderInSection:section])
         {
+            GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:cellViewForHeaderInSection:));
             return [self.tableViewDelegate tableView:self cellViewForHeaderInSection:section];
         }
         
@@ -3177,16 +5606,17 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     }
     
     // Section footer
-    if ([self p_isOutlineViewItemFooter:item])
+    if ([self.model isItemFooter:item])
     {
         GNEParameterAssert([self.tableViewDelegate
                             respondsToSelector:@selector(tableView:cellViewForFooterInSection:)]);
         
-        NSUInteger section = [self p_sectionForOutlineViewParentItem:parentItem];
+        NSUInteger section = [self.model sectionForParentItem:parentItem];
         GNEParameterAssert(section != NSNotFound);
         
         if (section != NSNotFound)
         {
+            GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:cellViewForFooterInSection:));
             return [self.tableViewDelegate tableView:self cellViewForFooterInSection:section];
         }
         
@@ -3194,9 +5624,22 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     }
     
     // Row
-    NSIndexPath *indexPath = [self p_indexPathOfOutlineViewItem:item];
+    if (self.delegateMethods.cellViewForRow)
+    {
+        GNESectionedIndexPath sectionedIndexPath = [self.model sectionedIndexPathOfItem:item];
+        if (GNESectionedIndexPathIsRow(sectionedIndexPath))
+        {
+            GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:cellViewForRowAtSectionedIndexPath:));
+            return [self.tableViewDelegate tableView:self cellViewForRowAtSectionedIndexPath:sectionedIndexPath];
+        }
+        
+        return nil;
+    }
+    
+    NSIndexPath *indexPath = [self.model indexPathOfItem:item];
     if (indexPath)
     {
+        GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:cellViewForRowAtIndexPath:));
         return [self.tableViewDelegate tableView:self cellViewForRowAtIndexPath:indexPath];
     }
     
@@ -3208,7 +5651,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
       didAddRowView:(NSTableRowView *)rowView
              forRow:(NSInteger)row
 {
-    GNEParameterAssert([NSThread isMainThread]); // NSDictionary isn't threadsafe.
+    GNEParameterAssert([NSThread isMainThread]); // NSMapTable isn't threadsafe.
     
     NSIndexPath *indexPath = [self indexPathForTableViewRow:row];
     
@@ -3219,6 +5662,12 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     
     [self p_updateMapForRowView:rowView indexPath:indexPath];
     
+    // New row views are created with the current data.
+    if (self.staleItems.count > 0)
+    {
+        [self.staleItems removeObject:[self itemAtRow:row]];
+    }
+    
     SEL headerSelector = @selector(tableView:didDisplayRowView:forHeaderInSection:);
     SEL footerSelector = @selector(tableView:didDisplayRowView:forFooterInSection:);
     SEL rowSelector = @selector(tableView:didDisplayRowView:forRowAtIndexPath:);
@@ -3231,19 +5680,29 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     
     if (isHeader && [self.tableViewDelegate respondsToSelector:headerSelector])
     {
+        GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:didDisplayRowView:forHeaderInSection:));
         [self.tableViewDelegate tableView:self
                         didDisplayRowView:rowView
                        forHeaderInSection:indexPath.gne_section];
     }
     else if (isFooter && [self.tableViewDelegate respondsToSelector:footerSelector])
     {
+        GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:didDisplayRowView:forFooterInSection:));
         [self.tableViewDelegate tableView:self
                         didDisplayRowView:rowView
                        forFooterInSection:indexPath.gne_section];
     }
+    else if (isHeader == NO && isFooter == NO && self.delegateMethods.didDisplayRowView)
+    {
+        GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:didDisplayRowView:forRowAtSectionedIndexPath:));
+        [self.tableViewDelegate tableView:self
+                        didDisplayRowView:rowView
+               forRowAtSectionedIndexPath:GNESectionedIndexPathFromNSIndexPath(indexPath)];
+    }
     else if (isHeader == NO && isFooter == NO &&
              [self.tableViewDelegate respondsToSelector:rowSelector])
     {
+        GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:didDisplayRowView:forRowAtIndexPath:));
         [self.tableViewDelegate tableView:self
                         didDisplayRowView:rowView
                         forRowAtIndexPath:indexPath];
@@ -3277,19 +5736,30 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     
     if (isHeader && [self.tableViewDelegate respondsToSelector:headerSelector])
     {
+        GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:didEndDisplayingRowView:forHeaderInSection:));
         [self.tableViewDelegate tableView:self
                   didEndDisplayingRowView:rowView
                        forHeaderInSection:indexPath.gne_section];
     }
     else if (isFooter && [self.tableViewDelegate respondsToSelector:footerSelector])
     {
+        GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:didEndDisplayingRowView:forFooterInSection:));
         [self.tableViewDelegate tableView:self
                   didEndDisplayingRowView:rowView
                        forFooterInSection:indexPath.gne_section];
     }
+    else if (isHeader == NO && isFooter == NO && self.delegateMethods.didEndDisplayingRowView)
+    {
+        GNEStatisticsRecordCallout(self.statisticsRecorder,
+                                   @selector(tableView:didEndDisplayingRowView:forRowAtSectionedIndexPath:));
+        [self.tableViewDelegate tableView:self
+                  didEndDisplayingRowView:rowView
+               forRowAtSectionedIndexPath:GNESectionedIndexPathFromNSIndexPath(indexPath)];
+    }
     else if (isHeader == NO && isFooter == NO &&
              [self.tableViewDelegate respondsToSelector:rowSelector])
     {
+        GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:didEndDisplayingRowView:forRowAtIndexPath:));
         [self.tableViewDelegate tableView:self
                   didEndDisplayingRowView:rowView
                         forRowAtIndexPath:indexPath];
@@ -3310,10 +5780,11 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
         return NO;
     }
     
-    NSUInteger section = [self p_sectionForOutlineViewParentItem:(GNEOutlineViewParentItem *)item];
+    NSUInteger section = [self.model sectionForParentItem:(GNEOutlineViewParentItem *)item];
     if ([self.tableViewDelegate respondsToSelector:@selector(tableView:shouldExpandSection:)] &&
         section != NSNotFound)
     {
+        GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:shouldExpandSection:));
         return [self.tableViewDelegate tableView:self shouldExpandSection:section];
     }
     
@@ -3331,10 +5802,11 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
         return NO;
     }
     
-    NSUInteger section = [self p_sectionForOutlineViewParentItem:(GNEOutlineViewParentItem *)item];
+    NSUInteger section = [self.model sectionForParentItem:(GNEOutlineViewParentItem *)item];
     if ([self.tableViewDelegate respondsToSelector:@selector(tableView:shouldCollapseSection:)] &&
         section != NSNotFound)
     {
+        GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:shouldCollapseSection:));
         return [self.tableViewDelegate tableView:self shouldCollapseSection:section];
     }
     
@@ -3349,6 +5821,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     SEL selector = @selector(tableView:willExpandSection:);
     if (section != NSNotFound && [self.tableViewDelegate respondsToSelector:selector])
     {
+        GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:willExpandSection:));
         [self.tableViewDelegate tableView:self willExpandSection:section];
     }
 }
@@ -3361,6 +5834,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     SEL selector = @selector(tableView:willCollapseSection:);
     if (section != NSNotFound && [self.tableViewDelegate respondsToSelector:selector])
     {
+        GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:willCollapseSection:));
         [self.tableViewDelegate tableView:self willCollapseSection:section];
     }
 }
@@ -3369,10 +5843,14 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 - (void)outlineViewItemDidExpand:(NSNotification *)notification
 {
     NSUInteger section = [self p_sectionForExpandCollapseNotification:notification];
+    [self p_updateHeightOfSection:section];
+    [self p_scheduleEstimatedRowMeasurement];
+    [self p_scheduleOutlineViewItemRecycling];
     
     SEL selector = @selector(tableView:didExpandSection:);
     if (section != NSNotFound && [self.tableViewDelegate respondsToSelector:selector])
     {
+        GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:didExpandSection:));
         [self.tableViewDelegate tableView:self didExpandSection:section];
     }
 }
@@ -3381,10 +5859,16 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 - (void)outlineViewItemDidCollapse:(NSNotification *)notification
 {
     NSUInteger section = [self p_sectionForExpandCollapseNotification:notification];
+    [self p_updateHeightOfSection:section];
+    [self p_recycleOutlineViewItemsInSection:section];
+    
+    // Collapsing a section deselects its rows.
+    self.selectionNeedsUpdate = YES;
     
     SEL selector = @selector(tableView:didCollapseSection:);
     if (section != NSNotFound && [self.tableViewDelegate respondsToSelector:selector])
     {
+        GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:didCollapseSection:));
         [self.tableViewDelegate tableView:self didCollapseSection:section];
     }
 }
@@ -3403,6 +5887,12 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 -           (NSIndexSet *)outlineView:(NSOutlineView * __unused)outlineView
  selectionIndexesForProposedSelection:(NSIndexSet *)proposedSelectionIndexes
 {
+    // Only delegates that need to see every proposed row are asked about the rows one at a time.
+    if ([self p_canFilterProposedSelectionByRanges])
+    {
+        return [self p_selectionIndexesByFilteringRangesOfProposedSelection:proposedSelectionIndexes];
+    }
+    
     SEL selector = @selector(tableView:proposedSelectedHeadersInSections:proposedSelectedRowIndexPaths:);
     
     SEL headerSelector = @selector(tableView:shouldSelectHeaderInSection:);
@@ -3437,6 +5927,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
             BOOL addHeader = YES;
             if ([tableViewDelegate respondsToSelector:headerSelector])
             {
+                GNEStatisticsRecordCallout(strongSelf.statisticsRecorder, @selector(tableView:shouldSelectHeaderInSection:));
                 addHeader = [tableViewDelegate tableView:strongSelf
                              shouldSelectHeaderInSection:indexPath.gne_section];
             }
@@ -3451,6 +5942,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
             BOOL addRow = YES;
             if ([tableViewDelegate respondsToSelector:rowSelector])
             {
+                GNEStatisticsRecordCallout(strongSelf.statisticsRecorder, @selector(tableView:shouldSelectRowAtIndexPath:));
                 addRow = [tableViewDelegate tableView:strongSelf shouldSelectRowAtIndexPath:indexPath];
             }
             
@@ -3469,6 +5961,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     // use the values we calculated based on its responses to the previous queries.
     if ([self.tableViewDelegate respondsToSelector:selector])
     {
+        GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:proposedSelectedHeadersInSections:proposedSelectedRowIndexPaths:));
         [self.tableViewDelegate tableView:self
         proposedSelectedHeadersInSections:&proposedHeaderIndexes
             proposedSelectedRowIndexPaths:&proposedIndexPaths];
@@ -3497,6 +5990,94 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 }
 
 
+/**
+ Returns YES if the proposed selection can be filtered a range of rows at a time, which is the case
+ if the delegate implements tableView:selectableRowsForProposedRows:inSection: or doesn't implement
+ any of the methods that filter the proposed selection one row at a time.
+ */
+- (BOOL)p_canFilterProposedSelectionByRanges
+{
+    id <GNESectionedTableViewDelegate> tableViewDelegate = self.tableViewDelegate;
+    
+    if ([tableViewDelegate respondsToSelector:@selector(tableView:selectableRowsForProposedRows:inSection:)])
+    {
+        return YES;
+    }
+    
+    SEL selector = @selector(tableView:proposedSelectedHeadersInSections:proposedSelectedRowIndexPaths:);
+    
+    return ([tableViewDelegate respondsToSelector:@selector(tableView:shouldSelectRowAtIndexPath:)] == NO &&
+            [tableViewDelegate respondsToSelector:selector] == NO);
+}
+
+
+/**
+ Returns the table view rows of the proposed selection approved by the delegate, or nil if none are
+ approved. The proposed rows of each section are passed to the delegate in a single call to
+ tableView:selectableRowsForProposedRows:inSection:, so the selection takes O(r + s) time for r ranges
+ of table view rows spanning s sections, plus the delegate's own work.
+ */
+- (NSIndexSet *)p_selectionIndexesByFilteringRangesOfProposedSelection:(NSIndexSet *)proposedSelectionIndexes
+{
+    id <GNESectionedTableViewDelegate> tableViewDelegate = self.tableViewDelegate;
+    BOOL filtersHeaders = [tableViewDelegate respondsToSelector:@selector(tableView:shouldSelectHeaderInSection:)];
+    BOOL filtersRows = [tableViewDelegate respondsToSelector:@selector(tableView:selectableRowsForProposedRows:inSection:)];
+    
+    NSIndexSet *proposedHeaders = nil;
+    NSDictionary *proposedRowsBySection = [self p_rowsBySectionForTableViewRows:proposedSelectionIndexes
+                                                                        headers:&proposedHeaders
+                                                                        footers:NULL];
+    
+    NSMutableIndexSet *approvedSelectionIndexes = [NSMutableIndexSet indexSet];
+    
+    __weak typeof(self) weakSelf = self;
+    [proposedHeaders enumerateIndexesUsingBlock:^(NSUInteger section, BOOL *stop __unused)
+    {
+        __strong typeof(weakSelf) strongSelf = weakSelf;
+        
+        BOOL addHeader = YES;
+        if (filtersHeaders)
+        {
+            GNEStatisticsRecordCallout(strongSelf.statisticsRecorder, @selector(tableView:shouldSelectHeaderInSection:));
+            addHeader = [tableViewDelegate tableView:strongSelf shouldSelectHeaderInSection:section];
+        }
+        
+        NSInteger tableViewRow = [strongSelf rowForItem:[strongSelf.model parentItemForSection:section]];
+        if (addHeader && tableViewRow >= 0)
+        {
+            [approvedSelectionIndexes addIndex:(NSUInteger)tableViewRow];
+        }
+    }];
+    
+    [proposedRowsBySection enumerateKeysAndObjectsUsingBlock:^(NSNumber *sectionNumber,
+                                                               NSIndexSet *rows,
+                                                               BOOL *stop __unused)
+    {
+        __strong typeof(weakSelf) strongSelf = weakSelf;
+        
+        NSUInteger section = sectionNumber.unsignedIntegerValue;
+        NSIndexSet *approvedRows = rows;
+        if (filtersRows)
+        {
+            GNEStatisticsRecordCallout(strongSelf.statisticsRecorder,
+                                       @selector(tableView:selectableRowsForProposedRows:inSection:));
+            approvedRows = [tableViewDelegate tableView:strongSelf
+                          selectableRowsForProposedRows:[rows copy]
+                                              inSection:section];
+        }
+        
+        NSIndexSet *approvedTableViewRows = [strongSelf p_indexSetOfTableViewRowsForRows:approvedRows
+                                                                               inSection:section];
+        if (approvedTableViewRows)
+        {
+            [approvedSelectionIndexes addIndexes:approvedTableViewRows];
+        }
+    }];
+    
+    return ((approvedSelectionIndexes.count > 0) ? [approvedSelectionIndexes copy] : nil);
+}
+
+
 - (void)outlineViewSelectionDidChange:(NSNotification *)notification
 {
     if ([self isEqual:notification.object] == NO)
@@ -3504,6 +6085,17 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
         return;
     }
     
+    // The delegate may read the selection below, so a change made by one of the overridden selection
+    // methods is applied to the model before they return.
+    if (self.selectionChangeCount > 0)
+    {
+        [self p_applySelectionChange];
+    }
+    else
+    {
+        self.selectionNeedsUpdate = YES;
+    }
+    
     NSIndexSet *selectedRows = self.selectedRowIndexes;
     
     SEL deselectSelector = @selector(tableViewDidDeselectAllHeadersAndRows:);
@@ -3515,6 +6107,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     if (selectedRows.count == 0 &&
         [self.tableViewDelegate respondsToSelector:deselectSelector])
     {
+        GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableViewDidDeselectAllHeadersAndRows:));
         [self.tableViewDelegate tableViewDidDeselectAllHeadersAndRows:self];
     }
     else if (selectedRows.count == 1)
@@ -3524,26 +6117,38 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
         if (parentItem == nil && [self.tableViewDelegate respondsToSelector:selectHeaderSelector])
         {
             GNEParameterAssert([item isKindOfClass:[GNEOutlineViewParentItem class]]);
-            NSUInteger section = [self p_sectionForOutlineViewParentItem:(GNEOutlineViewParentItem *)item];
+            NSUInteger section = [self.model sectionForParentItem:(GNEOutlineViewParentItem *)item];
+            GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:didSelectHeaderInSection:));
             [self.tableViewDelegate tableView:self didSelectHeaderInSection:section];
         }
         else if (parentItem && [self.tableViewDelegate respondsToSelector:selectRowSelector])
         {
-            NSIndexPath *indexPath = [self p_indexPathOfOutlineViewItem:item];
+            NSIndexPath *indexPath = [self.model indexPathOfItem:item];
+            GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:didSelectRowAtIndexPath:));
             [self.tableViewDelegate tableView:self didSelectRowAtIndexPath:indexPath];
         }
     }
     else
     {
-        NSIndexSet *sectionHeaders = [self p_indexSetOfSectionHeadersAtTableViewRows:selectedRows];
+        // The selected rows are resolved a range at a time, and their index paths are only created if
+        // the delegate asks for them.
+        NSIndexSet *sectionHeaders = nil;
+        NSIndexSet *sectionFooters = nil;
+        NSDictionary *rowsBySection = [self p_rowsBySectionForTableViewRows:selectedRows
+                                                                    headers:&sectionHeaders
+                                                                    footers:&sectionFooters];
+        
         if (sectionHeaders.count > 0 && [self.tableViewDelegate respondsToSelector:selectHeadersSelector])
         {
+            GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:didSelectHeadersInSections:));
             [self.tableViewDelegate tableView:self didSelectHeadersInSections:sectionHeaders];
         }
         
-        NSArray *rowIndexPaths = [self p_indexPathsOfRowsAtTableViewRows:selectedRows];
-        if (rowIndexPaths.count > 0 && [self.tableViewDelegate respondsToSelector:selectRowsSelector])
+        if ((rowsBySection.count > 0 || sectionFooters.count > 0) &&
+            [self.tableViewDelegate respondsToSelector:selectRowsSelector])
         {
+            NSArray *rowIndexPaths = [self p_indexPathsOfRowsBySection:rowsBySection footers:sectionFooters];
+            GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:didSelectRowsAtIndexPaths:));
             [self.tableViewDelegate tableView:self didSelectRowsAtIndexPaths:rowIndexPaths];
         }
     }
@@ -3559,7 +6164,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     GNEParameterAssert([item isKindOfClass:[GNEOutlineViewItem class]]);
     
     // Footers are never draggable.
-    if ([self p_isOutlineViewItemFooter:item])
+    if ([self.model isItemFooter:item])
     {
         return nil;
     }
@@ -3572,13 +6177,15 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     {
         GNEParameterAssert([item isKindOfClass:[GNEOutlineViewParentItem class]]);
         
-        NSUInteger section = [self p_sectionForOutlineViewParentItem:(GNEOutlineViewParentItem *)item];
+        NSUInteger section = [self.model sectionForParentItem:(GNEOutlineViewParentItem *)item];
+        GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:canDragSection:));
         canDrag = [self.tableViewDataSource tableView:self canDragSection:section];
     }
     else if (parentItem &&
              [self.tableViewDataSource respondsToSelector:@selector(tableView:canDragRowAtIndexPath:)])
     {
-        NSIndexPath *indexPath = [self p_indexPathOfOutlineViewItem:item];
+        NSIndexPath *indexPath = [self.model indexPathOfItem:item];
+        GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableView:canDragRowAtIndexPath:));
         canDrag = [self.tableViewDataSource tableView:self canDragRowAtIndexPath:indexPath];
     }
     
@@ -3594,6 +6201,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     SEL selector = @selector(tableViewDraggingSessionWillBegin:);
     if ([self.tableViewDataSource respondsToSelector:selector])
     {
+        GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableViewDraggingSessionWillBegin:));
         [self.tableViewDataSource tableViewDraggingSessionWillBegin:self];
     }
     
@@ -3604,7 +6212,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     self.currentMove.completion = ^()
     {
         __strong typeof(weakSelf) strongSelf = weakSelf;
-        [strongSelf p_updateMapForAvailableRowViews];
+        [strongSelf p_updateMapForShiftedRowViews];
     };
     self.currentMove.indexPathsToSelect = self.selectedAutoCollapsedIndexPaths;
     
@@ -3632,7 +6240,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
         GNEOutlineViewItem *item = draggingItem.item;
         NSInteger column = [outlineView columnWithIdentifier:kOutlineViewStandardColumnIdentifier];
         NSIndexPath *indexPath = item.draggedIndexPath;
-        GNEOutlineViewItem *draggedItem = [strongSelf p_outlineViewItemAtIndexPath:indexPath];
+        GNEOutlineViewItem *draggedItem = [strongSelf.model itemAtIndexPath:indexPath];
         NSInteger row = [strongSelf rowForItem:draggedItem];
         
         if ([item isKindOfClass:[GNEOutlineViewItem class]] && column >= 0 && row >= 0)
@@ -3733,12 +6341,12 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
                 GNEParameterAssert([draggedItem isKindOfClass:[GNEOutlineViewParentItem class]]);
                 
                 GNEOutlineViewParentItem *aParentItem = (GNEOutlineViewParentItem *)draggedItem;
-                NSUInteger section = [strongSelf p_sectionForOutlineViewParentItem:aParentItem];
+                NSUInteger section = [strongSelf.model sectionForParentItem:aParentItem];
                 [fromSections addIndex:section];
             }
             else
             {
-                NSIndexPath *indexPath = [strongSelf p_indexPathOfOutlineViewItem:draggedItem];
+                NSIndexPath *indexPath = [strongSelf.model indexPathOfItem:draggedItem];
                 [fromIndexPaths addObject:indexPath];
             }
         }
@@ -3775,6 +6383,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     SEL selector = @selector(tableViewDraggingSessionDidEnd:);
     if ([self.tableViewDataSource respondsToSelector:selector])
     {
+        GNEStatisticsRecordCallout(self.statisticsRecorder, @selector(tableViewDraggingSessionDidEnd:));
         [self.tableViewDataSource tableViewDraggingSessionDidEnd:self];
     }
     
@@ -3812,7 +6421,7 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
 {
     if (item)
     {
-        return [self p_indexPathOfOutlineViewItem:item];
+        return [self.model indexPathOfItem:item];
     }
     
     return nil;
@@ -3855,14 +6464,37 @@ typedef NS_ENUM(NSUInteger, GNEDragLocation)
     if (_tableViewDelegate != tableViewDelegate)
     {
         _tableViewDelegate = tableViewDelegate;
+        [self p_updateDelegateMethods];
         [self p_registerForDraggedTypes];
     }
 }
 
 
+- (void)p_updateDelegateMethods
+{
+    id <GNESectionedTableViewDelegate> theDelegate = self.tableViewDelegate;
+    
+    GNEDelegateSectionedIndexPathMethods delegateMethods;
+    delegateMethods.heightForRow =
+        [theDelegate respondsToSelector:@selector(tableView:heightForRowAtSectionedIndexPath:)];
+    delegateMethods.estimatedHeightForRow =
+        [theDelegate respondsToSelector:@selector(tableView:estimatedHeightForRowAtSectionedIndexPath:)];
+    delegateMethods.rowViewForRow =
+        [theDelegate respondsToSelector:@selector(tableView:rowViewForRowAtSectionedIndexPath:)];
+    delegateMethods.cellViewForRow =
+        [theDelegate respondsToSelector:@selector(tableView:cellViewForRowAtSectionedIndexPath:)];
+    delegateMethods.didDisplayRowView =
+        [theDelegate respondsToSelector:@selector(tableView:didDisplayRowView:forRowAtSectionedIndexPath:)];
+    delegateMethods.didEndDisplayingRowView =
+        [theDelegate respondsToSelector:@selector(tableView:didEndDisplayingRowView:forRowAtSectionedIndexPath:)];
+    
+    self.delegateMethods = delegateMethods;
+}
+
+
 - (BOOL)isUpdating
 {
-    return (self.updateCount > 0);
+    return (self.updateCount > 0 || self.batchUpdate != nil);
 }
 
 
@@ -0,0 +1,88 @@
+//
+//  GNEBenchmarkRecorder.h
+//  GNESectionedTableView
+//
+//  Copyright (c) 2016 Gone East LLC. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+
+// ------------------------------------------------------------------------------------------
+
+
+/// Set to any value other than "0" to run the benchmarks. They are skipped otherwise.
+extern NSString * const GNEBenchmarkEnabledEnvironmentKey;
+/// Path of the JSON file the results are written to. The results are logged if it isn't set.
+extern NSString * const GNEBenchmarkOutputEnvironmentKey;
+/// Path of the JSON file containing the baseline results to compare against.
+extern NSString * const GNEBenchmarkBaselineEnvironmentKey;
+/// Set to any value other than "0" to write the results to the baseline file instead of comparing them.
+extern NSString * const GNEBenchmarkRecordEnvironmentKey;
+/// Allowed relative regression, e.g. "0.25" for 25%. Defaults to 0.25.
+extern NSString * const GNEBenchmarkToleranceEnvironmentKey;
+
+
+// ------------------------------------------------------------------------------------------
+
+
+/// Measurements of a single run of an operation.
+@interface GNEBenchmarkResult : NSObject
+
+/// Name of the operation and its parameters, e.g., "reloadData[rows=1000,sections=10]".
+@property (nonatomic, copy, readonly) NSString *identifier;
+/// Wall clock time of the operation, in seconds.
+@property (nonatomic, assign, readonly) NSTimeInterval wallTime;
+/// Net change in the number of live heap allocations caused by the operation.
+@property (nonatomic, assign, readonly) int64_t allocations;
+/// Net change in the number of live heap bytes caused by the operation.
+@property (nonatomic, assign, readonly) int64_t allocatedBytes;
+/// Largest number of live heap bytes above the starting point sampled during the operation.
+@property (nonatomic, assign, readonly) uint64_t peakMemory;
+
+/// Returns the JSON-compatible representation of the receiver.
+- (NSDictionary *)dictionaryRepresentation;
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+/**
+ GNEBenchmarkRecorder measures operations, collects their results, writes them as JSON, and compares
+ them with a stored baseline.
+
+ @discussion The recorder is configured using the environment variables above, so that the benchmarks
+ can be run headlessly, e.g., xcodebuild test with GNE_BENCHMARKS=1 and GNE_BENCHMARK_BASELINE set.
+ */
+@interface GNEBenchmarkRecorder : NSObject
+
+/// Returns YES if the benchmarks should be run.
++ (BOOL)isEnabled;
+
+/// Returns the recorder shared by all of the benchmarks.
++ (instancetype)sharedRecorder;
+
+/**
+ Runs the specified block once and records its wall time, allocations, and peak memory.
+
+ @param name Name of the operation.
+ @param parameters Sizes the operation was run with, which become part of the result's identifier.
+ @param block Operation to measure.
+ @return Result of the measurement.
+ */
+- (GNEBenchmarkResult *)measureOperationNamed:(NSString *)name
+                                   parameters:(NSDictionary *)parameters
+                                   usingBlock:(void (^)(void))block;
+
+/// Returns a description of every measurement of the specified result that regressed past the
+/// baseline by more than the tolerance. Returns an empty array if there is no baseline for the
+/// result or the recorder is recording a new baseline.
+- (NSArray *)regressionsOfResult:(GNEBenchmarkResult *)result;
+
+/// Writes the results recorded so far to the output file, or logs them, and to the baseline file if
+/// the recorder is recording a new baseline. Returns NO if a file couldn't be written.
+- (BOOL)writeResults;
+
+@end
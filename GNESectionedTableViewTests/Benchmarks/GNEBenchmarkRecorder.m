@@ -0,0 +1,356 @@
+//
+//  GNEBenchmarkRecorder.m
+//  GNESectionedTableView
+//
+//  Copyright (c) 2016 Gone East LLC. All rights reserved.
+//
+
+#import "GNEBenchmarkRecorder.h"
+#import <mach/mach_time.h>
+#import <malloc/malloc.h>
+
+
+// ------------------------------------------------------------------------------------------
+
+
+NSString * const GNEBenchmarkEnabledEnvironmentKey = @"GNE_BENCHMARKS";
+NSString * const GNEBenchmarkOutputEnvironmentKey = @"GNE_BENCHMARK_OUTPUT";
+NSString * const GNEBenchmarkBaselineEnvironmentKey = @"GNE_BENCHMARK_BASELINE";
+NSString * const GNEBenchmarkRecordEnvironmentKey = @"GNE_BENCHMARK_RECORD";
+NSString * const GNEBenchmarkToleranceEnvironmentKey = @"GNE_BENCHMARK_TOLERANCE";
+
+static const double kDefaultTolerance = 0.25;
+
+/// Regressions smaller than these are treated as noise, no matter how small the baseline is.
+static const NSTimeInterval kMinimumWallTimeRegression = 0.001;
+static const int64_t kMinimumAllocationsRegression = 64;
+static const int64_t kMinimumMemoryRegression = 64 * 1024;
+
+/// Interval at which the heap is sampled while an operation runs, in nanoseconds.
+static const uint64_t kPeakMemorySamplingInterval = 1000000;
+
+static NSString * const kResultsKey = @"results";
+static NSString * const kNameKey = @"name";
+static NSString * const kParametersKey = @"parameters";
+static NSString * const kWallTimeKey = @"wallTime";
+static NSString * const kAllocationsKey = @"allocations";
+static NSString * const kAllocatedBytesKey = @"allocatedBytes";
+static NSString * const kPeakMemoryKey = @"peakMemory";
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Helpers
+// ------------------------------------------------------------------------------------------
+static BOOL GNEBenchmarkEnvironmentFlag(NSString *key)
+{
+    NSString *value = [NSProcessInfo processInfo].environment[key];
+
+    return (value.length > 0 && [value isEqualToString:@"0"] == NO);
+}
+
+
+static NSTimeInterval GNEBenchmarkSecondsFromAbsoluteTime(uint64_t absoluteTime)
+{
+    static mach_timebase_info_data_t timebase;
+    if (timebase.denom == 0)
+    {
+        mach_timebase_info(&timebase);
+    }
+
+    return (NSTimeInterval)absoluteTime * timebase.numer / timebase.denom / NSEC_PER_SEC;
+}
+
+
+static malloc_statistics_t GNEBenchmarkHeapStatistics(void)
+{
+    malloc_statistics_t statistics;
+    malloc_zone_statistics(NULL, &statistics);
+
+    return statistics;
+}
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@interface GNEBenchmarkResult ()
+
+@property (nonatomic, copy, readwrite) NSString *identifier;
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic, copy) NSDictionary *parameters;
+@property (nonatomic, assign, readwrite) NSTimeInterval wallTime;
+@property (nonatomic, assign, readwrite) int64_t allocations;
+@property (nonatomic, assign, readwrite) int64_t allocatedBytes;
+@property (nonatomic, assign, readwrite) uint64_t peakMemory;
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@implementation GNEBenchmarkResult
+
+
+- (NSDictionary *)dictionaryRepresentation
+{
+    return @{kNameKey : self.name,
+             kParametersKey : self.parameters,
+             kWallTimeKey : @(self.wallTime),
+             kAllocationsKey : @(self.allocations),
+             kAllocatedBytesKey : @(self.allocatedBytes),
+             kPeakMemoryKey : @(self.peakMemory)};
+}
+
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@interface GNEBenchmarkRecorder ()
+
+/// Results keyed by their identifiers.
+@property (nonatomic, strong) NSMutableDictionary *results;
+/// Baseline results keyed by their identifiers.
+@property (nonatomic, copy) NSDictionary *baseline;
+@property (nonatomic, assign) BOOL isRecordingBaseline;
+@property (nonatomic, assign) double tolerance;
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@implementation GNEBenchmarkRecorder
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Initialization
+// ------------------------------------------------------------------------------------------
++ (BOOL)isEnabled
+{
+    return GNEBenchmarkEnvironmentFlag(GNEBenchmarkEnabledEnvironmentKey);
+}
+
+
++ (instancetype)sharedRecorder
+{
+    static GNEBenchmarkRecorder *sharedRecorder = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^()
+    {
+        sharedRecorder = [[GNEBenchmarkRecorder alloc] init];
+    });
+
+    return sharedRecorder;
+}
+
+
+- (instancetype)init
+{
+    if ((self = [super init]))
+    {
+        NSDictionary *environment = [NSProcessInfo processInfo].environment;
+
+        _results = [NSMutableDictionary dictionary];
+        _isRecordingBaseline = GNEBenchmarkEnvironmentFlag(GNEBenchmarkRecordEnvironmentKey);
+        _tolerance = kDefaultTolerance;
+        if (environment[GNEBenchmarkToleranceEnvironmentKey])
+        {
+            _tolerance = MAX([environment[GNEBenchmarkToleranceEnvironmentKey] doubleValue], 0.0);
+        }
+        _baseline = [self p_resultsInFileAtPath:environment[GNEBenchmarkBaselineEnvironmentKey]];
+    }
+
+    return self;
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Measuring
+// ------------------------------------------------------------------------------------------
+- (GNEBenchmarkResult *)measureOperationNamed:(NSString *)name
+                                   parameters:(NSDictionary *)parameters
+                                   usingBlock:(void (^)(void))block
+{
+    NSParameterAssert(name.length > 0);
+    NSParameterAssert(block);
+
+    GNEBenchmarkResult *result = [[GNEBenchmarkResult alloc] init];
+    result.name = name;
+    result.parameters = parameters ?: @{};
+    result.identifier = [self p_identifierWithName:name parameters:result.parameters];
+
+    // Sample the heap on a background queue, so that allocations freed before the end of the
+    // operation still count towards its peak memory.
+    malloc_statistics_t startStatistics = GNEBenchmarkHeapStatistics();
+    __block size_t peakSizeInUse = startStatistics.size_in_use;
+    dispatch_queue_t samplingQueue = dispatch_queue_create("com.goneeast.GNEBenchmarkRecorder.sampling",
+                                                           DISPATCH_QUEUE_SERIAL);
+    dispatch_source_t timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, samplingQueue);
+    dispatch_source_set_timer(timer, DISPATCH_TIME_NOW, kPeakMemorySamplingInterval, kPeakMemorySamplingInterval / 10);
+    dispatch_source_set_event_handler(timer, ^()
+    {
+        peakSizeInUse = MAX(peakSizeInUse, GNEBenchmarkHeapStatistics().size_in_use);
+    });
+    dispatch_resume(timer);
+
+    uint64_t startTime = mach_absolute_time();
+    @autoreleasepool
+    {
+        block();
+    }
+    uint64_t endTime = mach_absolute_time();
+
+    dispatch_source_cancel(timer);
+    malloc_statistics_t endStatistics = GNEBenchmarkHeapStatistics();
+    dispatch_sync(samplingQueue, ^()
+    {
+        peakSizeInUse = MAX(peakSizeInUse, endStatistics.size_in_use);
+    });
+
+    result.wallTime = GNEBenchmarkSecondsFromAbsoluteTime(endTime - startTime);
+    result.allocations = (int64_t)endStatistics.blocks_in_use - (int64_t)startStatistics.blocks_in_use;
+    result.allocatedBytes = (int64_t)endStatistics.size_in_use - (int64_t)startStatistics.size_in_use;
+    result.peakMemory = peakSizeInUse - startStatistics.size_in_use;
+
+    self.results[result.identifier] = [result dictionaryRepresentation];
+
+    return result;
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Baseline
+// ------------------------------------------------------------------------------------------
+- (NSArray *)regressionsOfResult:(GNEBenchmarkResult *)result
+{
+    NSDictionary *baseline = self.baseline[result.identifier];
+
+    if (self.isRecordingBaseline || baseline == nil)
+    {
+        return @[];
+    }
+
+    NSMutableArray *regressions = [NSMutableArray array];
+
+    double baselineWallTime = [baseline[kWallTimeKey] doubleValue];
+    if (result.wallTime - baselineWallTime > MAX(baselineWallTime * self.tolerance, kMinimumWallTimeRegression))
+    {
+        [regressions addObject:[NSString stringWithFormat:@"%@: wall time %.4fs exceeds baseline %.4fs",
+                                result.identifier, result.wallTime, baselineWallTime]];
+    }
+
+    NSDictionary *counts = @{kAllocationsKey : @[@(result.allocations), @(kMinimumAllocationsRegression)],
+                             kAllocatedBytesKey : @[@(result.allocatedBytes), @(kMinimumMemoryRegression)],
+                             kPeakMemoryKey : @[@(result.peakMemory), @(kMinimumMemoryRegression)]};
+    for (NSString *key in counts)
+    {
+        int64_t value = [counts[key][0] longLongValue];
+        int64_t minimumRegression = [counts[key][1] longLongValue];
+        int64_t baselineValue = [baseline[key] longLongValue];
+        int64_t allowedRegression = MAX((int64_t)(llabs(baselineValue) * self.tolerance), minimumRegression);
+
+        if (value - baselineValue > allowedRegression)
+        {
+            [regressions addObject:[NSString stringWithFormat:@"%@: %@ %lld exceeds baseline %lld",
+                                    result.identifier, key, value, baselineValue]];
+        }
+    }
+
+    return regressions;
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Writing Results
+// ------------------------------------------------------------------------------------------
+- (BOOL)writeResults
+{
+    if (self.results.count == 0)
+    {
+        return YES;
+    }
+
+    NSDictionary *environment = [NSProcessInfo processInfo].environment;
+    BOOL didWrite = YES;
+
+    NSString *outputPath = environment[GNEBenchmarkOutputEnvironmentKey];
+    if (outputPath.length > 0)
+    {
+        didWrite = [self p_writeResults:self.results toFileAtPath:outputPath];
+    }
+    else
+    {
+        NSData *data = [self p_JSONDataWithResults:self.results];
+        NSLog(@"%@", [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding]);
+    }
+
+    NSString *baselinePath = environment[GNEBenchmarkBaselineEnvironmentKey];
+    if (self.isRecordingBaseline && baselinePath.length > 0)
+    {
+        // Keep the baselines of the benchmarks that weren't run this time.
+        NSMutableDictionary *baseline = [[self p_resultsInFileAtPath:baselinePath] mutableCopy] ?:
+                                        [NSMutableDictionary dictionary];
+        [baseline addEntriesFromDictionary:self.results];
+        didWrite = [self p_writeResults:baseline toFileAtPath:baselinePath] && didWrite;
+    }
+
+    return didWrite;
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Private
+// ------------------------------------------------------------------------------------------
+- (NSString *)p_identifierWithName:(NSString *)name parameters:(NSDictionary *)parameters
+{
+    NSMutableArray *components = [NSMutableArray array];
+    for (NSString *key in [parameters.allKeys sortedArrayUsingSelector:@selector(compare:)])
+    {
+        [components addObject:[NSString stringWithFormat:@"%@=%@", key, parameters[key]]];
+    }
+
+    return [NSString stringWithFormat:@"%@[%@]", name, [components componentsJoinedByString:@","]];
+}
+
+
+- (NSData *)p_JSONDataWithResults:(NSDictionary *)results
+{
+    return [NSJSONSerialization dataWithJSONObject:@{kResultsKey : results}
+                                           options:NSJSONWritingPrettyPrinted
+                                             error:NULL];
+}
+
+
+- (BOOL)p_writeResults:(NSDictionary *)results toFileAtPath:(NSString *)path
+{
+    NSData *data = [self p_JSONDataWithResults:results];
+
+    return (data && [data writeToFile:path atomically:YES]);
+}
+
+
+- (NSDictionary *)p_resultsInFileAtPath:(NSString *)path
+{
+    NSData *data = (path.length > 0) ? [NSData dataWithContentsOfFile:path] : nil;
+    if (data == nil)
+    {
+        return nil;
+    }
+
+    NSDictionary *contents = [NSJSONSerialization JSONObjectWithData:data options:0 error:NULL];
+    if ([contents isKindOfClass:[NSDictionary class]] == NO ||
+        [contents[kResultsKey] isKindOfClass:[NSDictionary class]] == NO)
+    {
+        return nil;
+    }
+
+    return contents[kResultsKey];
+}
+
+
+@end
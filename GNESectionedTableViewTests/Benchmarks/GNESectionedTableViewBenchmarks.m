@@ -0,0 +1,414 @@
+//
+//  GNESectionedTableViewBenchmarks.m
+//  GNESectionedTableView
+//
+//  Copyright (c) 2016 Gone East LLC. All rights reserved.
+//
+
+#import "GNESectionedTableViewTests.h"
+#import "GNEBenchmarkRecorder.h"
+#import "GNESectionedTableViewModel.h"
+#import "NSIndexPath+GNESectionedTableView.h"
+
+
+// ------------------------------------------------------------------------------------------
+
+
+/// Numbers of rows and sections a benchmark is run with. The rows are split evenly among the sections.
+typedef struct GNEBenchmarkSize GNEBenchmarkSize;
+
+struct GNEBenchmarkSize
+{
+    NSUInteger rows;
+    NSUInteger sections;
+};
+
+
+static const GNEBenchmarkSize kBenchmarkSizes[] = { {1000, 10}, {100000, 1000}, {1000000, 50000} };
+static const NSUInteger kNumberOfBenchmarkSizes = sizeof(kBenchmarkSizes) / sizeof(GNEBenchmarkSize);
+
+/// Number of rows inserted, deleted, selected, or looked up by a single benchmark.
+static const NSUInteger kNumberOfBenchmarkRows = 1000;
+
+static const CGFloat kBenchmarkRowHeight = 20.0;
+
+
+// ------------------------------------------------------------------------------------------
+
+
+/**
+ Benchmarks of the table view's mutations and lookups, which drive an offscreen table view (and its
+ model directly) at realistic sizes.
+
+ @discussion The benchmarks are skipped unless GNE_BENCHMARKS is set. See GNEBenchmarkRecorder for
+ writing the results as JSON and for comparing them with a baseline, which fails the benchmarks that
+ regressed.
+ */
+@interface GNESectionedTableViewBenchmarks : GNESectionedTableViewTests
+
+/// Number of rows in each section returned by the mock data source.
+@property (nonatomic, strong) NSMutableArray *numbersOfRows;
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@implementation GNESectionedTableViewBenchmarks
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Set Up & Tear Down
+// ------------------------------------------------------------------------------------------
+- (void)setUp
+{
+    [super setUp];
+
+    self.numbersOfRows = [NSMutableArray array];
+
+    __weak typeof(self) weakSelf = self;
+    MockNumberOfSectionsBlock sectionsBlock = ^NSUInteger()
+    {
+        return weakSelf.numbersOfRows.count;
+    };
+    [self.dataSource setBlock:(__bridge void *)[sectionsBlock copy]
+                  forSelector:@selector(numberOfSectionsInTableView:)];
+
+    MockNumberOfRowsBlock rowsBlock = ^NSUInteger(NSUInteger section)
+    {
+        return [weakSelf.numbersOfRows[section] unsignedIntegerValue];
+    };
+    [self.dataSource setBlock:(__bridge void *)[rowsBlock copy]
+                  forSelector:@selector(tableView:numberOfRowsInSection:)];
+
+    MockHeightForSectionBlock heightBlock = ^CGFloat(NSUInteger section __unused)
+    {
+        return kBenchmarkRowHeight;
+    };
+    [self.delegate setBlock:(__bridge void *)[heightBlock copy]
+                forSelector:@selector(tableView:uniformHeightForRowsInSection:)];
+
+    MockShouldSelectRowBlock selectBlock = ^BOOL(NSIndexPath *indexPath __unused)
+    {
+        return YES;
+    };
+    [self.delegate setBlock:(__bridge void *)[selectBlock copy]
+                forSelector:@selector(tableView:shouldSelectRowAtIndexPath:)];
+}
+
+
+- (void)tearDown
+{
+    self.numbersOfRows = nil;
+
+    [super tearDown];
+}
+
+
++ (void)tearDown
+{
+    [[GNEBenchmarkRecorder sharedRecorder] writeResults];
+
+    [super tearDown];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Table View
+// ------------------------------------------------------------------------------------------
+- (void)testBenchmark_ReloadData
+{
+    [self p_runBenchmarkWithBlock:^(GNEBenchmarkSize size)
+    {
+        [self p_setNumberOfRows:size.rows inSections:size.sections];
+
+        [self p_measureOperationNamed:@"reloadData" size:size usingBlock:^()
+        {
+            [self.tableView reloadData];
+        }];
+
+        XCTAssertNumberOfSections(size.sections);
+    }];
+}
+
+
+- (void)testBenchmark_InsertRows
+{
+    [self p_runBenchmarkWithBlock:^(GNEBenchmarkSize size)
+    {
+        [self p_setNumberOfRows:size.rows inSections:size.sections];
+        [self.tableView reloadData];
+
+        NSArray *indexPaths = [self p_indexPathsSpreadAcrossSections:size.sections];
+        [self p_changeNumbersOfRowsAtIndexPaths:indexPaths by:1];
+
+        [self p_measureOperationNamed:@"insertRowsAtIndexPaths" size:size usingBlock:^()
+        {
+            [self.tableView insertRowsAtIndexPaths:indexPaths withAnimation:NSTableViewAnimationEffectNone];
+        }];
+
+        XCTAssertNumberOfRowsInSection([self.numbersOfRows[0] unsignedIntegerValue], 0);
+    }];
+}
+
+
+- (void)testBenchmark_DeleteRows
+{
+    [self p_runBenchmarkWithBlock:^(GNEBenchmarkSize size)
+    {
+        [self p_setNumberOfRows:size.rows inSections:size.sections];
+        [self.tableView reloadData];
+
+        NSArray *indexPaths = [self p_indexPathsSpreadAcrossSections:size.sections];
+        [self p_changeNumbersOfRowsAtIndexPaths:indexPaths by:-1];
+
+        [self p_measureOperationNamed:@"deleteRowsAtIndexPaths" size:size usingBlock:^()
+        {
+            [self.tableView deleteRowsAtIndexPaths:indexPaths withAnimation:NSTableViewAnimationEffectNone];
+        }];
+
+        XCTAssertNumberOfRowsInSection([self.numbersOfRows[0] unsignedIntegerValue], 0);
+    }];
+}
+
+
+- (void)testBenchmark_MoveSections
+{
+    [self p_runBenchmarkWithBlock:^(GNEBenchmarkSize size)
+    {
+        [self p_setNumberOfRows:size.rows inSections:size.sections];
+        [self.tableView reloadData];
+
+        // Every section has the same number of rows, so the data source doesn't change.
+        GNEOrderedIndexSet *fromSections = [GNEOrderedIndexSet indexSet];
+        [fromSections addIndexesInRange:NSMakeRange(0, MAX(size.sections / 10, (NSUInteger)1))];
+
+        [self p_measureOperationNamed:@"moveSections:toSection:" size:size usingBlock:^()
+        {
+            [self.tableView moveSections:fromSections toSection:size.sections];
+        }];
+
+        XCTAssertNumberOfSections(size.sections);
+    }];
+}
+
+
+- (void)testBenchmark_SelectedIndexPaths
+{
+    [self p_runBenchmarkWithBlock:^(GNEBenchmarkSize size)
+    {
+        [self p_setNumberOfRows:size.rows inSections:size.sections];
+        [self.tableView reloadData];
+
+        NSArray *indexPaths = [self p_indexPathsSpreadAcrossSections:size.sections];
+        [self.tableView selectRowsAtIndexPaths:indexPaths byExtendingSelection:NO];
+
+        __block NSArray *selectedIndexPaths = nil;
+        [self p_measureOperationNamed:@"selectedIndexPaths" size:size usingBlock:^()
+        {
+            selectedIndexPaths = self.tableView.selectedIndexPaths;
+        }];
+
+        XCTAssertEqual(selectedIndexPaths.count, indexPaths.count);
+    }];
+}
+
+
+- (void)testBenchmark_IndexPathForTableViewRow
+{
+    [self p_runBenchmarkWithBlock:^(GNEBenchmarkSize size)
+    {
+        [self p_setNumberOfRows:size.rows inSections:size.sections];
+        [self.tableView reloadData];
+
+        NSInteger numberOfRows = ((NSOutlineView *)self.tableView).numberOfRows;
+        NSInteger stride = MAX(numberOfRows / (NSInteger)kNumberOfBenchmarkRows, 1);
+
+        __block NSUInteger numberOfIndexPaths = 0;
+        [self p_measureOperationNamed:@"indexPathForTableViewRow" size:size usingBlock:^()
+        {
+            for (NSInteger row = 0; row < numberOfRows; row += stride)
+            {
+                numberOfIndexPaths += ([self.tableView indexPathForTableViewRow:row] != nil) ? 1 : 0;
+            }
+        }];
+
+        XCTAssertGreaterThan(numberOfIndexPaths, 0);
+    }];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Model
+// ------------------------------------------------------------------------------------------
+- (void)testBenchmark_Model_InsertSections
+{
+    [self p_runBenchmarkWithBlock:^(GNEBenchmarkSize size)
+    {
+        GNESectionedTableViewModel *model = [GNESectionedTableViewModel model];
+        NSUInteger rowsPerSection = size.rows / size.sections;
+
+        [self p_measureOperationNamed:@"model.insertSections" size:size usingBlock:^()
+        {
+            [model insertSections:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, size.sections)]
+                       usingBlock:^NSUInteger(GNEOutlineViewParentItem *parentItem __unused,
+                                              NSUInteger section __unused)
+            {
+                return rowsPerSection;
+            }];
+        }];
+
+        XCTAssertEqual(model.numberOfSections, size.sections);
+    }];
+}
+
+
+- (void)testBenchmark_Model_InsertAndDeleteRows
+{
+    [self p_runBenchmarkWithBlock:^(GNEBenchmarkSize size)
+    {
+        GNESectionedTableViewModel *model = [self p_modelWithSize:size];
+        NSUInteger rowsPerSection = size.rows / size.sections;
+
+        // Insert the rows in the middle of the first section, which is the worst case for the item array.
+        NSMutableArray *indexPaths = [NSMutableArray array];
+        for (NSUInteger i = 0; i < kNumberOfBenchmarkRows; i++)
+        {
+            [indexPaths addObject:[NSIndexPath gne_indexPathForRow:(rowsPerSection / 2 + i) inSection:0]];
+        }
+        NSArray *reversedIndexPaths = indexPaths.reverseObjectEnumerator.allObjects;
+
+        [self p_measureOperationNamed:@"model.insertRowsAtIndexPaths" size:size usingBlock:^()
+        {
+            [model insertRowsAtIndexPaths:indexPaths inSection:0];
+        }];
+
+        [self p_measureOperationNamed:@"model.deleteRowsAtIndexPaths" size:size usingBlock:^()
+        {
+            [model deleteRowsAtIndexPaths:reversedIndexPaths inSection:0];
+        }];
+
+        XCTAssertEqual([model numberOfItemsInSection:0], rowsPerSection);
+    }];
+}
+
+
+- (void)testBenchmark_Model_ItemAtIndexPath
+{
+    [self p_runBenchmarkWithBlock:^(GNEBenchmarkSize size)
+    {
+        GNESectionedTableViewModel *model = [self p_modelWithSize:size];
+        NSArray *indexPaths = [self p_indexPathsSpreadAcrossSections:size.sections];
+
+        __block NSUInteger numberOfItems = 0;
+        [self p_measureOperationNamed:@"model.itemAtIndexPath" size:size usingBlock:^()
+        {
+            for (NSIndexPath *indexPath in indexPaths)
+            {
+                GNEOutlineViewItem *item = [model itemAtIndexPath:indexPath];
+                numberOfItems += ([model indexPathOfItem:item] != nil) ? 1 : 0;
+            }
+        }];
+
+        XCTAssertEqual(numberOfItems, indexPaths.count);
+    }];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Helpers
+// ------------------------------------------------------------------------------------------
+/// Runs the specified block once for every benchmark size, unless the benchmarks are disabled.
+- (void)p_runBenchmarkWithBlock:(void (^)(GNEBenchmarkSize size))block
+{
+    if ([GNEBenchmarkRecorder isEnabled] == NO)
+    {
+        return;
+    }
+
+    for (NSUInteger i = 0; i < kNumberOfBenchmarkSizes; i++)
+    {
+        @autoreleasepool
+        {
+            block(kBenchmarkSizes[i]);
+        }
+    }
+}
+
+
+/// Measures the specified block and fails the test if the result regressed past the baseline.
+- (void)p_measureOperationNamed:(NSString *)name size:(GNEBenchmarkSize)size usingBlock:(void (^)(void))block
+{
+    GNEBenchmarkRecorder *recorder = [GNEBenchmarkRecorder sharedRecorder];
+    GNEBenchmarkResult *result = [recorder measureOperationNamed:name
+                                                      parameters:@{@"rows" : @(size.rows),
+                                                                   @"sections" : @(size.sections)}
+                                                      usingBlock:block];
+
+    for (NSString *regression in [recorder regressionsOfResult:result])
+    {
+        XCTFail(@"%@", regression);
+    }
+}
+
+
+- (void)p_setNumberOfRows:(NSUInteger)numberOfRows inSections:(NSUInteger)numberOfSections
+{
+    NSNumber *rowsPerSection = @(numberOfRows / numberOfSections);
+
+    [self.numbersOfRows removeAllObjects];
+    for (NSUInteger section = 0; section < numberOfSections; section++)
+    {
+        [self.numbersOfRows addObject:rowsPerSection];
+    }
+}
+
+
+/// Adds the specified delta to the number of rows of each section for each index path in it.
+- (void)p_changeNumbersOfRowsAtIndexPaths:(NSArray *)indexPaths by:(NSInteger)delta
+{
+    for (NSIndexPath *indexPath in indexPaths)
+    {
+        NSUInteger section = indexPath.gne_section;
+        NSInteger numberOfRows = [self.numbersOfRows[section] integerValue] + delta;
+        self.numbersOfRows[section] = @(numberOfRows);
+    }
+}
+
+
+/// Returns kNumberOfBenchmarkRows index paths in ascending order, spread across the specified number
+/// of sections and starting at the first row of each section.
+- (NSArray *)p_indexPathsSpreadAcrossSections:(NSUInteger)numberOfSections
+{
+    NSMutableArray *indexPaths = [NSMutableArray array];
+    NSUInteger rowsPerSection = (kNumberOfBenchmarkRows + numberOfSections - 1) / numberOfSections;
+
+    for (NSUInteger section = 0; section < numberOfSections && indexPaths.count < kNumberOfBenchmarkRows; section++)
+    {
+        for (NSUInteger row = 0; row < rowsPerSection && indexPaths.count < kNumberOfBenchmarkRows; row++)
+        {
+            [indexPaths addObject:[NSIndexPath gne_indexPathForRow:row inSection:section]];
+        }
+    }
+
+    return indexPaths;
+}
+
+
+- (GNESectionedTableViewModel *)p_modelWithSize:(GNEBenchmarkSize)size
+{
+    GNESectionedTableViewModel *model = [GNESectionedTableViewModel model];
+    NSUInteger rowsPerSection = size.rows / size.sections;
+
+    [model insertSections:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, size.sections)]
+               usingBlock:^NSUInteger(GNEOutlineViewParentItem *parentItem __unused, NSUInteger section __unused)
+    {
+        return rowsPerSection;
+    }];
+
+    return model;
+}
+
+
+@end
@@ -0,0 +1,221 @@
+//
+//  GNESectionedIndexPathTests.m
+//  GNESectionedTableView
+//
+//  Copyright (c) 2016 Gone East LLC. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "GNESectionedIndexPath.h"
+#import "GNESectionedTableViewModel.h"
+#import "NSIndexPath+GNESectionedTableView.h"
+
+
+// ------------------------------------------------------------------------------------------
+
+
+static int GNESectionedIndexPathTestsCompare(const void *indexPath1, const void *indexPath2)
+{
+    return (int)GNESectionedIndexPathCompare(*(const GNESectionedIndexPath *)indexPath1,
+                                             *(const GNESectionedIndexPath *)indexPath2);
+}
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@interface GNESectionedIndexPathTests : XCTestCase
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@implementation GNESectionedIndexPathTests
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Creating
+// ------------------------------------------------------------------------------------------
+- (void)testMake_Kinds
+{
+    GNESectionedIndexPath row = GNESectionedIndexPathMake(3, 1);
+    GNESectionedIndexPath header = GNESectionedIndexPathMakeHeader(1);
+    GNESectionedIndexPath footer = GNESectionedIndexPathMakeFooter(1);
+    
+    XCTAssertTrue(GNESectionedIndexPathIsRow(row));
+    XCTAssertEqual(row.row, 3u);
+    XCTAssertEqual(row.section, 1u);
+    XCTAssertTrue(GNESectionedIndexPathIsHeader(header));
+    XCTAssertFalse(GNESectionedIndexPathIsRow(header));
+    XCTAssertTrue(GNESectionedIndexPathIsFooter(footer));
+    XCTAssertFalse(GNESectionedIndexPathIsHeader(footer));
+    
+    XCTAssertFalse(GNESectionedIndexPathIsValid(GNESectionedIndexPathNotFound()));
+    XCTAssertFalse(GNESectionedIndexPathIsRow(GNESectionedIndexPathNotFound()));
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Comparing
+// ------------------------------------------------------------------------------------------
+- (void)testCompare_MatchesNSIndexPathCompare
+{
+    GNESectionedIndexPath indexPaths[] =
+    {
+        GNESectionedIndexPathMake(0, 0),
+        GNESectionedIndexPathMake(7, 0),
+        GNESectionedIndexPathMakeFooter(0),
+        GNESectionedIndexPathMakeHeader(0),
+        GNESectionedIndexPathMake(2, 1),
+        GNESectionedIndexPathMakeHeader(1),
+        GNESectionedIndexPathMake(0, 4),
+    };
+    NSUInteger count = sizeof(indexPaths) / sizeof(indexPaths[0]);
+    
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        for (NSUInteger j = 0; j < count; j++)
+        {
+            NSIndexPath *first = GNESectionedIndexPathToNSIndexPath(indexPaths[i]);
+            NSIndexPath *second = GNESectionedIndexPathToNSIndexPath(indexPaths[j]);
+            
+            XCTAssertEqual(GNESectionedIndexPathCompare(indexPaths[i], indexPaths[j]), [first gne_compare:second]);
+            XCTAssertEqual(GNESectionedIndexPathReverseCompare(indexPaths[i], indexPaths[j]),
+                           [first gne_reverseCompare:second]);
+            XCTAssertEqual(GNESectionedIndexPathEqualToIndexPath(indexPaths[i], indexPaths[j]), (BOOL)(i == j));
+        }
+    }
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Converting
+// ------------------------------------------------------------------------------------------
+- (void)testConvert_RoundTrips
+{
+    NSArray *indexPaths = @[[NSIndexPath gne_indexPathForRow:5 inSection:2],
+                            [NSIndexPath gne_indexPathForRow:GNESectionedTableViewModelHeaderRow inSection:0],
+                            [NSIndexPath gne_indexPathForRow:GNESectionedTableViewModelFooterRow inSection:3]];
+    
+    for (NSIndexPath *indexPath in indexPaths)
+    {
+        XCTAssertEqualObjects(GNESectionedIndexPathToNSIndexPath(GNESectionedIndexPathFromNSIndexPath(indexPath)),
+                              indexPath);
+    }
+    
+    XCTAssertTrue(GNESectionedIndexPathIsHeader(GNESectionedIndexPathFromNSIndexPath(indexPaths[1])));
+    XCTAssertTrue(GNESectionedIndexPathIsFooter(GNESectionedIndexPathFromNSIndexPath(indexPaths[2])));
+    XCTAssertFalse(GNESectionedIndexPathIsValid(GNESectionedIndexPathFromNSIndexPath(nil)));
+    XCTAssertFalse(GNESectionedIndexPathIsValid(GNESectionedIndexPathFromNSIndexPath([NSIndexPath indexPathWithIndex:1])));
+    XCTAssertNil(GNESectionedIndexPathToNSIndexPath(GNESectionedIndexPathNotFound()));
+    XCTAssertEqualObjects(NSStringFromGNESectionedIndexPath(GNESectionedIndexPathMake(2, 1)), @"{row 2, section 1}");
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Collection Helpers
+// ------------------------------------------------------------------------------------------
+- (void)testGetRows
+{
+    NSMutableIndexSet *indexSet = [NSMutableIndexSet indexSetWithIndexesInRange:NSMakeRange(1, 2)];
+    [indexSet addIndex:9];
+    
+    GNESectionedIndexPath indexPaths[4];
+    NSUInteger count = GNESectionedIndexPathGetRows(indexSet, 6, indexPaths, 4);
+    
+    XCTAssertEqual(count, 3u);
+    XCTAssertTrue(GNESectionedIndexPathEqualToIndexPath(indexPaths[0], GNESectionedIndexPathMake(1, 6)));
+    XCTAssertTrue(GNESectionedIndexPathEqualToIndexPath(indexPaths[2], GNESectionedIndexPathMake(9, 6)));
+    
+    XCTAssertEqual(GNESectionedIndexPathGetRows(indexSet, 6, indexPaths, 2), 2u);
+}
+
+
+- (void)testSortAndEnumerateSections
+{
+    GNESectionedIndexPath indexPaths[] =
+    {
+        GNESectionedIndexPathMake(4, 2),
+        GNESectionedIndexPathMakeHeader(0),
+        GNESectionedIndexPathMake(1, 2),
+        GNESectionedIndexPathMake(3, 0),
+        GNESectionedIndexPathMake(0, 5),
+    };
+    NSUInteger count = sizeof(indexPaths) / sizeof(indexPaths[0]);
+    
+    GNESectionedIndexPathSort(indexPaths, count);
+    
+    for (NSUInteger i = 1; i < count; i++)
+    {
+        XCTAssertEqual(GNESectionedIndexPathCompare(indexPaths[i - 1], indexPaths[i]), NSOrderedAscending);
+    }
+    
+    NSMutableArray *sections = [NSMutableArray array];
+    NSMutableArray *ranges = [NSMutableArray array];
+    GNESectionedIndexPathEnumerateSections(indexPaths, count, ^(NSUInteger section, NSRange range, BOOL *stop __unused)
+    {
+        [sections addObject:@(section)];
+        [ranges addObject:[NSValue valueWithRange:range]];
+    });
+    
+    XCTAssertEqualObjects(sections, (@[@0, @2, @5]));
+    XCTAssertEqualObjects(ranges, (@[[NSValue valueWithRange:NSMakeRange(0, 2)],
+                                     [NSValue valueWithRange:NSMakeRange(2, 2)],
+                                     [NSValue valueWithRange:NSMakeRange(4, 1)]]));
+    
+    GNESectionedIndexPathReverseSort(indexPaths, count);
+    
+    XCTAssertTrue(GNESectionedIndexPathEqualToIndexPath(indexPaths[0], GNESectionedIndexPathMake(0, 5)));
+    XCTAssertTrue(GNESectionedIndexPathEqualToIndexPath(indexPaths[count - 1], GNESectionedIndexPathMake(3, 0)));
+}
+
+
+- (void)testSort_LargeBufferMatchesComparisonSort
+{
+    NSUInteger count = 5000;
+    GNESectionedIndexPath *indexPaths = calloc(count, sizeof(GNESectionedIndexPath));
+    GNESectionedIndexPath *expected = calloc(count, sizeof(GNESectionedIndexPath));
+    
+    uint32_t seed = 2463534242;
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        NSUInteger section = seed % 300;
+        switch (seed % 7)
+        {
+            case 0:
+                indexPaths[i] = GNESectionedIndexPathMakeHeader(section);
+                break;
+            case 1:
+                indexPaths[i] = GNESectionedIndexPathMakeFooter(section);
+                break;
+            default:
+                indexPaths[i] = GNESectionedIndexPathMake((seed >> 8) % 100000, section);
+                break;
+        }
+    }
+    memcpy(expected, indexPaths, count * sizeof(GNESectionedIndexPath));
+    qsort(expected, count, sizeof(GNESectionedIndexPath), GNESectionedIndexPathTestsCompare);
+    
+    GNESectionedIndexPathSort(indexPaths, count);
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        XCTAssertTrue(GNESectionedIndexPathEqualToIndexPath(indexPaths[i], expected[i]));
+    }
+    
+    GNESectionedIndexPathReverseSort(indexPaths, count);
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        XCTAssertTrue(GNESectionedIndexPathEqualToIndexPath(indexPaths[i], expected[count - i - 1]));
+    }
+    
+    free(indexPaths);
+    free(expected);
+}
+
+
+@end
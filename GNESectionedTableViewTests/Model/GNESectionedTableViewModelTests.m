@@ -0,0 +1,412 @@
+//
+//  GNESectionedTableViewModelTests.m
+//  GNESectionedTableView
+//
+//  Copyright (c) 2016 Gone East LLC. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "GNESectionedTableViewModel.h"
+#import "GNEOutlineViewItem.h"
+#import "GNEOutlineViewParentItem.h"
+#import "GNEOutlineViewItemArray.h"
+#import "NSIndexPath+GNESectionedTableView.h"
+
+
+// ------------------------------------------------------------------------------------------
+
+
+#define GNEIndexPath(r, s) [NSIndexPath gne_indexPathForRow:r inSection:s]
+
+#define XCTAssertNumberOfItemsInSection(model, s, c) \
+    XCTAssertEqual([model numberOfItemsInSection:s], (NSUInteger)c)
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@interface GNESectionedTableViewModelTests : XCTestCase
+
+@property (nonatomic, strong) GNESectionedTableViewModel *model;
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@implementation GNESectionedTableViewModelTests
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Set Up
+// ------------------------------------------------------------------------------------------
+- (void)setUp
+{
+    [super setUp];
+    
+    self.model = [GNESectionedTableViewModel model];
+}
+
+
+- (void)tearDown
+{
+    self.model = nil;
+    
+    [super tearDown];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Sections
+// ------------------------------------------------------------------------------------------
+- (void)testInitialization_Empty
+{
+    XCTAssertEqual(self.model.numberOfSections, 0);
+    XCTAssertEqual(self.model.numberOfItems, 0);
+    XCTAssertEqual([self.model numberOfItemsInSection:0], NSNotFound);
+    XCTAssertNil([self.model parentItemForSection:0]);
+    XCTAssertNil([self.model indexPathForHeaderInSection:0]);
+}
+
+
+- (void)testInsertSections_RowsAndFooters
+{
+    [self p_insertSectionsWithRowCounts:@[@2, @0, @3] footers:@[@YES, @NO, @YES]];
+    
+    XCTAssertEqual(self.model.numberOfSections, 3);
+    XCTAssertNumberOfItemsInSection(self.model, 0, 3);
+    XCTAssertNumberOfItemsInSection(self.model, 1, 0);
+    XCTAssertNumberOfItemsInSection(self.model, 2, 4);
+    XCTAssertEqual(self.model.numberOfItems, 10); // 3 headers, 5 rows, and 2 footers
+    
+    for (NSUInteger section = 0; section < 3; section++)
+    {
+        GNEOutlineViewParentItem *parentItem = [self.model parentItemForSection:section];
+        XCTAssertEqual(parentItem.section, section);
+        XCTAssertEqual([self.model sectionForParentItem:parentItem], section);
+    }
+}
+
+
+- (void)testInsertSections_ClampsToEnd
+{
+    [self p_insertSectionsWithRowCounts:@[@1] footers:@[@NO]];
+    
+    NSIndexSet *inserted = [self.model insertSections:[NSIndexSet indexSetWithIndex:5]
+                                           usingBlock:^NSUInteger(GNEOutlineViewParentItem *parentItem __unused,
+                                                                  NSUInteger section)
+    {
+        XCTAssertEqual(section, 1);
+        
+        return 4;
+    }];
+    
+    XCTAssertEqualObjects(inserted, [NSIndexSet indexSetWithIndex:1]);
+    XCTAssertNumberOfItemsInSection(self.model, 1, 4);
+}
+
+
+- (void)testDeleteSections_UpdatesSectionsOfRemainingParentItems
+{
+    [self p_insertSectionsWithRowCounts:@[@1, @2, @3, @4] footers:@[@NO, @NO, @NO, @NO]];
+    GNEOutlineViewParentItem *deletedParentItem = [self.model parentItemForSection:1];
+    GNEOutlineViewParentItem *lastParentItem = [self.model parentItemForSection:3];
+    
+    NSMutableIndexSet *sections = [NSMutableIndexSet indexSetWithIndex:1];
+    [sections addIndex:10];
+    NSIndexSet *deleted = [self.model deleteSections:sections];
+    
+    XCTAssertEqualObjects(deleted, [NSIndexSet indexSetWithIndex:1]);
+    XCTAssertEqual(self.model.numberOfSections, 3);
+    XCTAssertEqual(deletedParentItem.section, NSNotFound);
+    XCTAssertEqual([self.model sectionForParentItem:deletedParentItem], NSNotFound);
+    XCTAssertEqual([self.model sectionForParentItem:lastParentItem], 2);
+    XCTAssertNumberOfItemsInSection(self.model, 1, 3);
+}
+
+
+- (void)testRemoveAllSections
+{
+    [self p_insertSectionsWithRowCounts:@[@1, @2] footers:@[@YES, @NO]];
+    GNEOutlineViewParentItem *parentItem = [self.model parentItemForSection:0];
+    
+    [self.model removeAllSections];
+    
+    XCTAssertEqual(self.model.numberOfSections, 0);
+    XCTAssertEqual(self.model.numberOfItems, 0);
+    XCTAssertEqual(parentItem.section, NSNotFound);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Rows
+// ------------------------------------------------------------------------------------------
+- (void)testInsertRows_KeepsFooterLast
+{
+    [self p_insertSectionsWithRowCounts:@[@2] footers:@[@YES]];
+    GNEOutlineViewItem *footer = [self.model footerItemInSection:0];
+    
+    NSArray *indexPaths = @[GNEIndexPath(0, 0), GNEIndexPath(2, 0)];
+    NSIndexSet *inserted = [self.model insertRowsAtIndexPaths:indexPaths inSection:0];
+    
+    NSMutableIndexSet *expected = [NSMutableIndexSet indexSetWithIndex:0];
+    [expected addIndex:2];
+    XCTAssertEqualObjects(inserted, expected);
+    XCTAssertNumberOfItemsInSection(self.model, 0, 5);
+    XCTAssertEqual([self.model footerItemInSection:0], footer);
+    XCTAssertTrue([self.model isItemFooter:footer]);
+    XCTAssertEqualObjects([self.model indexPathOfItem:footer], [self.model indexPathForFooterInSection:0]);
+}
+
+
+- (void)testDeleteRows_IgnoresInvalidIndexPaths
+{
+    [self p_insertSectionsWithRowCounts:@[@4] footers:@[@NO]];
+    GNEOutlineViewItem *lastItem = [self.model itemAtIndexPath:GNEIndexPath(3, 0)];
+    
+    NSArray *indexPaths = @[GNEIndexPath(10, 0),
+                            [self.model indexPathForHeaderInSection:0],
+                            GNEIndexPath(2, 0),
+                            GNEIndexPath(0, 0)];
+    NSIndexSet *deleted = [self.model deleteRowsAtIndexPaths:indexPaths inSection:0];
+    
+    NSMutableIndexSet *expected = [NSMutableIndexSet indexSetWithIndex:0];
+    [expected addIndex:2];
+    XCTAssertEqualObjects(deleted, expected);
+    XCTAssertNumberOfItemsInSection(self.model, 0, 2);
+    XCTAssertEqualObjects([self.model indexPathOfItem:lastItem], GNEIndexPath(1, 0));
+}
+
+
+- (void)testInsertRows_RepeatedAndTrailingRowsMatchInsertingOneAtATime
+{
+    [self p_insertSectionsWithRowCounts:@[@3] footers:@[@NO]];
+    
+    NSArray *indexPaths = @[GNEIndexPath(1, 0), GNEIndexPath(1, 0), GNEIndexPath(9, 0), GNEIndexPath(12, 0)];
+    NSIndexSet *inserted = [self.model insertRowsAtIndexPaths:indexPaths inSection:0];
+    
+    NSMutableIndexSet *expected = [NSMutableIndexSet indexSetWithIndexesInRange:NSMakeRange(1, 2)];
+    [expected addIndexesInRange:NSMakeRange(5, 2)];
+    XCTAssertEqualObjects(inserted, expected);
+    XCTAssertNumberOfItemsInSection(self.model, 0, 7);
+}
+
+
+- (void)testDeleteRows_ManyRows
+{
+    [self p_insertSectionsWithRowCounts:@[@10000] footers:@[@YES]];
+    GNEOutlineViewItem *footer = [self.model footerItemInSection:0];
+    GNEOutlineViewItem *lastItem = [self.model itemAtIndexPath:GNEIndexPath(9999, 0)];
+    
+    NSMutableArray *indexPaths = [NSMutableArray array];
+    for (NSInteger row = 9998; row >= 0; row -= 2)
+    {
+        [indexPaths addObject:GNEIndexPath(row, 0)];
+    }
+    NSIndexSet *deleted = [self.model deleteRowsAtIndexPaths:indexPaths inSection:0];
+    
+    XCTAssertEqual(deleted.count, 5000u);
+    XCTAssertNumberOfItemsInSection(self.model, 0, 5001);
+    XCTAssertEqual([self.model footerItemInSection:0], footer);
+    XCTAssertEqualObjects([self.model indexPathOfItem:lastItem], GNEIndexPath(4999, 0));
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Index Paths
+// ------------------------------------------------------------------------------------------
+- (void)testHeaderAndFooterIndexPaths
+{
+    [self p_insertSectionsWithRowCounts:@[@1, @1] footers:@[@YES, @NO]];
+    
+    NSIndexPath *header = [self.model indexPathForHeaderInSection:1];
+    NSIndexPath *footer = [self.model indexPathForFooterInSection:1];
+    
+    XCTAssertEqual(header.gne_row, GNESectionedTableViewModelHeaderRow);
+    XCTAssertEqual(footer.gne_row, GNESectionedTableViewModelFooterRow);
+    XCTAssertTrue([self.model isIndexPathHeader:header]);
+    XCTAssertFalse([self.model isIndexPathFooter:header]);
+    XCTAssertTrue([self.model isIndexPathFooter:footer]);
+    XCTAssertTrue([self.model isIndexPathValid:header]);
+    XCTAssertTrue([self.model isIndexPathValid:GNEIndexPath(0, 1)]);
+    XCTAssertFalse([self.model isIndexPathValid:GNEIndexPath(1, 1)]);
+    XCTAssertFalse([self.model isIndexPathValid:GNEIndexPath(0, 2)]);
+    XCTAssertNil([self.model indexPathForHeaderInSection:2]);
+    
+    XCTAssertEqual([self.model itemAtIndexPath:header], [self.model parentItemForSection:1]);
+    XCTAssertNil([self.model itemAtIndexPath:footer]);
+    XCTAssertNotNil([self.model itemAtIndexPath:[self.model indexPathForFooterInSection:0]]);
+}
+
+
+- (void)testIndexPathOfItem
+{
+    [self p_insertSectionsWithRowCounts:@[@3, @5] footers:@[@NO, @YES]];
+    
+    for (NSUInteger section = 0; section < 2; section++)
+    {
+        GNEOutlineViewParentItem *parentItem = [self.model parentItemForSection:section];
+        XCTAssertEqualObjects([self.model indexPathOfItem:parentItem],
+                              [self.model indexPathForHeaderInSection:section]);
+        
+        NSUInteger rowCount = [self.model numberOfItemsInSection:section] - (parentItem.hasFooter ? 1 : 0);
+        for (NSUInteger row = 0; row < rowCount; row++)
+        {
+            NSIndexPath *indexPath = GNEIndexPath(row, section);
+            GNEOutlineViewItem *item = [self.model itemAtIndexPath:indexPath];
+            XCTAssertEqual(item.parentItem, parentItem);
+            XCTAssertEqualObjects([self.model indexPathOfItem:item], indexPath);
+            XCTAssertEqual([self.model indexOfItem:item], row);
+        }
+    }
+    
+    GNEOutlineViewItem *orphan = [[GNEOutlineViewItem alloc] initWithParentItem:nil];
+    XCTAssertNil([self.model indexPathOfItem:orphan]);
+}
+
+
+- (void)testSectionedIndexPathOfItem_MatchesIndexPathOfItem
+{
+    [self p_insertSectionsWithRowCounts:@[@3, @5] footers:@[@NO, @YES]];
+    
+    for (NSUInteger section = 0; section < 2; section++)
+    {
+        GNEOutlineViewParentItem *parentItem = [self.model parentItemForSection:section];
+        GNESectionedIndexPath header = [self.model sectionedIndexPathOfItem:parentItem];
+        XCTAssertTrue(GNESectionedIndexPathEqualToIndexPath(header, GNESectionedIndexPathMakeHeader(section)));
+        
+        GNEOutlineViewItemArray *items = [self.model itemsInSection:section];
+        for (NSUInteger index = 0; index < items.count; index++)
+        {
+            GNEOutlineViewItem *item = items[index];
+            GNESectionedIndexPath indexPath = [self.model sectionedIndexPathOfItem:item];
+            XCTAssertTrue(GNESectionedIndexPathEqualToIndexPath(indexPath,
+                                                                GNESectionedIndexPathFromNSIndexPath([self.model indexPathOfItem:item])));
+        }
+    }
+    
+    XCTAssertTrue(GNESectionedIndexPathIsFooter([self.model sectionedIndexPathOfItem:[self.model footerItemInSection:1]]));
+    
+    GNEOutlineViewItem *orphan = [[GNEOutlineViewItem alloc] initWithParentItem:nil];
+    XCTAssertFalse(GNESectionedIndexPathIsValid([self.model sectionedIndexPathOfItem:orphan]));
+    XCTAssertFalse(GNESectionedIndexPathIsValid([self.model sectionedIndexPathOfItem:nil]));
+}
+
+
+- (void)testItemAtIndexOfParentItem
+{
+    [self p_insertSectionsWithRowCounts:@[@2, @2] footers:@[@NO, @NO]];
+    GNEOutlineViewParentItem *parentItem = [self.model parentItemForSection:1];
+    
+    XCTAssertEqual([self.model itemAtIndex:1 ofParentItem:nil], parentItem);
+    XCTAssertNil([self.model itemAtIndex:2 ofParentItem:nil]);
+    XCTAssertEqual([self.model itemAtIndex:1 ofParentItem:parentItem],
+                   [self.model itemAtIndexPath:GNEIndexPath(1, 1)]);
+    XCTAssertNil([self.model itemAtIndex:2 ofParentItem:parentItem]);
+    XCTAssertEqual([self.model numberOfItemsInParentItem:parentItem], 2);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Selection
+// ------------------------------------------------------------------------------------------
+- (void)testSelectedIndexPaths_SortedWithoutSorting
+{
+    [self p_insertSectionsWithRowCounts:@[@3, @2] footers:@[@YES, @NO]];
+    
+    [self.model selectItem:[self.model parentItemForSection:1]];
+    [self.model selectItem:[self.model footerItemInSection:0]];
+    [self.model selectItem:[self.model itemAtIndexPath:GNEIndexPath(2, 0)]];
+    [self.model selectItem:[self.model parentItemForSection:0]];
+    [self.model selectItem:[self.model itemAtIndexPath:GNEIndexPath(0, 0)]];
+    [self.model selectItem:[self.model itemAtIndexPath:GNEIndexPath(1, 1)]];
+    
+    NSArray *expected = @[GNEIndexPath(0, 0),
+                          GNEIndexPath(2, 0),
+                          [self.model indexPathForFooterInSection:0],
+                          [self.model indexPathForHeaderInSection:0],
+                          GNEIndexPath(1, 1),
+                          [self.model indexPathForHeaderInSection:1]];
+    XCTAssertEqualObjects(self.model.selectedIndexPaths, expected);
+    XCTAssertEqualObjects(self.model.selectedIndexPaths,
+                          [expected sortedArrayUsingSelector:@selector(gne_compare:)]);
+    XCTAssertEqualObjects([self.model selectedIndexPathsInSection:1], [expected subarrayWithRange:NSMakeRange(4, 2)]);
+    
+    XCTAssertTrue([self.model isIndexPathSelected:[self.model indexPathForFooterInSection:0]]);
+    XCTAssertFalse([self.model isIndexPathSelected:GNEIndexPath(3, 0)]); // The footer's item index
+    XCTAssertFalse([self.model isIndexPathSelected:GNEIndexPath(1, 0)]);
+    XCTAssertFalse([self.model isIndexPathSelected:[self.model indexPathForFooterInSection:1]]);
+    
+    [self.model deselectAllItems];
+    
+    XCTAssertEqual(self.model.selectedIndexPaths.count, 0);
+}
+
+
+- (void)testSelection_FollowsInsertionsAndDeletions
+{
+    [self p_insertSectionsWithRowCounts:@[@4, @1] footers:@[@NO, @NO]];
+    [self.model selectItem:[self.model itemAtIndexPath:GNEIndexPath(1, 0)]];
+    [self.model selectItem:[self.model itemAtIndexPath:GNEIndexPath(3, 0)]];
+    [self.model selectItem:[self.model parentItemForSection:1]];
+    
+    [self.model insertRowsAtIndexPaths:@[GNEIndexPath(0, 0)] inSection:0];
+    [self.model deleteRowsAtIndexPaths:@[GNEIndexPath(2, 0)] inSection:0];
+    [self.model insertSections:[NSIndexSet indexSetWithIndex:0]
+                    usingBlock:^NSUInteger(GNEOutlineViewParentItem *parentItem __unused, NSUInteger section __unused)
+    {
+        return 1;
+    }];
+    
+    NSArray *expected = @[GNEIndexPath(3, 1), [self.model indexPathForHeaderInSection:2]];
+    XCTAssertEqualObjects(self.model.selectedIndexPaths, expected);
+    
+    [self.model deleteSections:[NSIndexSet indexSetWithIndex:1]];
+    
+    XCTAssertEqualObjects(self.model.selectedIndexPaths, @[[self.model indexPathForHeaderInSection:1]]);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Performance
+// ------------------------------------------------------------------------------------------
+- (void)testPerformance_InsertAndDeleteSections_1000
+{
+    NSIndexSet *sections = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 1000)];
+    
+    [self measureBlock:^()
+    {
+        [self.model insertSections:sections
+                        usingBlock:^NSUInteger(GNEOutlineViewParentItem *parentItem, NSUInteger section __unused)
+        {
+            parentItem.hasFooter = YES;
+            
+            return 1000;
+        }];
+        [self.model deleteSections:sections];
+    }];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Internal
+// ------------------------------------------------------------------------------------------
+- (void)p_insertSectionsWithRowCounts:(NSArray *)rowCounts footers:(NSArray *)footers
+{
+    NSParameterAssert(rowCounts.count == footers.count);
+    
+    NSUInteger start = self.model.numberOfSections;
+    NSIndexSet *sections = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(start, rowCounts.count)];
+    
+    [self.model insertSections:sections
+                    usingBlock:^NSUInteger(GNEOutlineViewParentItem *parentItem, NSUInteger section)
+    {
+        parentItem.hasFooter = [footers[section - start] boolValue];
+        
+        return [rowCounts[section - start] unsignedIntegerValue];
+    }];
+}
+
+
+@end
@@ -0,0 +1,209 @@
+//
+//  GNESectionedTableViewSelectionTests.m
+//  GNESectionedTableView
+//
+//  Copyright (c) 2016 Gone East LLC. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "GNESectionedTableViewSelection.h"
+
+
+// ------------------------------------------------------------------------------------------
+
+
+#define GNEIndexSet(...) p_indexSetWithIndexes((NSUInteger[]){__VA_ARGS__}, \
+    sizeof((NSUInteger[]){__VA_ARGS__}) / sizeof(NSUInteger))
+
+
+static NSIndexSet *p_indexSetWithIndexes(NSUInteger *indexes, NSUInteger count)
+{
+    NSMutableIndexSet *indexSet = [NSMutableIndexSet indexSet];
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        [indexSet addIndex:indexes[i]];
+    }
+    
+    return [indexSet copy];
+}
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@interface GNESectionedTableViewSelectionTests : XCTestCase
+
+@property (nonatomic, strong) GNESectionedTableViewSelection *selection;
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@implementation GNESectionedTableViewSelectionTests
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Set Up
+// ------------------------------------------------------------------------------------------
+- (void)setUp
+{
+    [super setUp];
+    
+    self.selection = [GNESectionedTableViewSelection selection];
+    [self.selection insertSectionsAtIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 3)]];
+}
+
+
+- (void)tearDown
+{
+    self.selection = nil;
+    
+    [super tearDown];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Selecting
+// ------------------------------------------------------------------------------------------
+- (void)testInitialization_Empty
+{
+    GNESectionedTableViewSelection *selection = [GNESectionedTableViewSelection selection];
+    
+    XCTAssertEqual(selection.count, 0);
+    XCTAssertEqual(selection.sections.count, 0);
+    XCTAssertFalse([selection isHeaderSelectedInSection:0]);
+    XCTAssertFalse([selection isItemSelectedAtIndex:0 inSection:0]);
+}
+
+
+- (void)testSelectHeadersAndItems
+{
+    [self.selection selectHeaderInSection:2];
+    [self.selection selectItemsAtIndexes:GNEIndexSet(1, 4) inSection:0];
+    
+    XCTAssertEqual(self.selection.count, 3);
+    XCTAssertEqualObjects(self.selection.sections, GNEIndexSet(0, 2));
+    XCTAssertTrue([self.selection isHeaderSelectedInSection:2]);
+    XCTAssertFalse([self.selection isHeaderSelectedInSection:0]);
+    XCTAssertTrue([self.selection isItemSelectedAtIndex:4 inSection:0]);
+    XCTAssertFalse([self.selection isItemSelectedAtIndex:2 inSection:0]);
+    XCTAssertEqualObjects([self.selection selectedItemIndexesInSection:0], GNEIndexSet(1, 4));
+    XCTAssertEqual([self.selection selectedItemIndexesInSection:1].count, 0);
+}
+
+
+- (void)testSelect_IgnoresInvalidSections
+{
+    [self.selection selectHeaderInSection:3];
+    [self.selection selectItemsAtIndexes:GNEIndexSet(0) inSection:5];
+    
+    XCTAssertEqual(self.selection.count, 0);
+    XCTAssertFalse([self.selection isHeaderSelectedInSection:3]);
+}
+
+
+- (void)testDeselectHeadersAndItems
+{
+    [self.selection selectHeaderInSection:0];
+    [self.selection selectItemsAtIndexes:GNEIndexSet(0, 1, 2) inSection:1];
+    [self.selection selectItemsAtIndexes:GNEIndexSet(4) inSection:2];
+    
+    [self.selection deselectHeaderInSection:0];
+    [self.selection deselectItemsAtIndexes:GNEIndexSet(0, 2) inSection:1];
+    [self.selection deselectItemsAtIndexes:GNEIndexSet(4, 5) inSection:2];
+    
+    XCTAssertEqual(self.selection.count, 1);
+    XCTAssertEqualObjects(self.selection.sections, GNEIndexSet(1));
+    XCTAssertFalse([self.selection isHeaderSelectedInSection:0]);
+    XCTAssertEqualObjects([self.selection selectedItemIndexesInSection:1], GNEIndexSet(1));
+}
+
+
+- (void)testDeselectAll
+{
+    [self.selection selectHeaderInSection:0];
+    [self.selection selectItemsAtIndexes:GNEIndexSet(0, 1, 2) inSection:1];
+    
+    [self.selection deselectAll];
+    
+    XCTAssertEqual(self.selection.count, 0);
+    XCTAssertEqual(self.selection.sections.count, 0);
+    XCTAssertFalse([self.selection isItemSelectedAtIndex:1 inSection:1]);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Inserting and Removing Sections
+// ------------------------------------------------------------------------------------------
+- (void)testInsertSections_ShiftsSelection
+{
+    [self.selection selectHeaderInSection:1];
+    [self.selection selectItemsAtIndexes:GNEIndexSet(3) inSection:2];
+    
+    [self.selection insertSectionsAtIndexes:GNEIndexSet(0, 2)];
+    
+    XCTAssertEqualObjects(self.selection.sections, GNEIndexSet(3, 4));
+    XCTAssertTrue([self.selection isHeaderSelectedInSection:3]);
+    XCTAssertTrue([self.selection isItemSelectedAtIndex:3 inSection:4]);
+    XCTAssertEqual([self.selection selectedItemIndexesInSection:2].count, 0);
+}
+
+
+- (void)testRemoveSections_RemovesAndShiftsSelection
+{
+    [self.selection selectHeaderInSection:0];
+    [self.selection selectItemsAtIndexes:GNEIndexSet(0) inSection:1];
+    [self.selection selectItemsAtIndexes:GNEIndexSet(2) inSection:2];
+    
+    [self.selection removeSectionsAtIndexes:GNEIndexSet(0, 1)];
+    
+    XCTAssertEqual(self.selection.count, 1);
+    XCTAssertEqualObjects(self.selection.sections, GNEIndexSet(0));
+    XCTAssertTrue([self.selection isItemSelectedAtIndex:2 inSection:0]);
+}
+
+
+- (void)testRemoveAllSections
+{
+    [self.selection selectHeaderInSection:0];
+    
+    [self.selection removeAllSections];
+    
+    XCTAssertEqual(self.selection.count, 0);
+    [self.selection selectHeaderInSection:0];
+    XCTAssertFalse([self.selection isHeaderSelectedInSection:0]);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Inserting and Removing Items
+// ------------------------------------------------------------------------------------------
+- (void)testInsertItems_ShiftsSelection
+{
+    [self.selection selectItemsAtIndexes:GNEIndexSet(0, 2, 5) inSection:1];
+    
+    // Final indexes of the new items, in ascending order.
+    [self.selection insertItemsAtIndexes:GNEIndexSet(1, 2, 6) inSection:1];
+    
+    XCTAssertEqualObjects([self.selection selectedItemIndexesInSection:1], GNEIndexSet(0, 4, 8));
+}
+
+
+- (void)testRemoveItems_RemovesAndShiftsSelection
+{
+    [self.selection selectItemsAtIndexes:GNEIndexSet(0, 2, 5) inSection:1];
+    
+    [self.selection removeItemsAtIndexes:GNEIndexSet(1, 2, 4) inSection:1];
+    
+    XCTAssertEqualObjects([self.selection selectedItemIndexesInSection:1], GNEIndexSet(0, 2));
+    
+    [self.selection removeItemsAtIndexes:GNEIndexSet(0, 2) inSection:1];
+    
+    XCTAssertEqual([self.selection selectedItemIndexesInSection:1].count, 0);
+    XCTAssertEqual(self.selection.sections.count, 0);
+}
+
+
+@end
@@ -400,6 +400,127 @@ static const NSUInteger kPerformanceTestIterations = 10000;
 }
 
 
+- (void)testInitialization_WithNSIndexSet_Large
+{
+    NSUInteger count = 5000000;
+    
+    NSMutableIndexSet *nsIndexSet = [NSMutableIndexSet indexSetWithIndexesInRange:NSMakeRange(10, count)];
+    [nsIndexSet addIndex:(count + 20)];
+    
+    GNEOrderedIndexSet *indexSet = nil;
+    
+    XCTAssertNoThrow(indexSet = [[GNEOrderedIndexSet alloc] initWithNSIndexSet:nsIndexSet]);
+    
+    XCTAssertTrue(indexSet.isRangeCompressed);
+    XCTAssertEqual(indexSet.numberOfRanges, 2);
+    XCTAssertCount(indexSet, count + 1);
+    XCTAssertIndexPosition(indexSet, 10, 0);
+    XCTAssertIndexPosition(indexSet, count + 20, count);
+    XCTAssertEqualObjects(indexSet.ns_indexSet, nsIndexSet);
+}
+
+
+- (void)testInitialization_WithNSIndexSet_Sparse
+{
+    NSUInteger count = 1000;
+    
+    NSMutableIndexSet *nsIndexSet = [NSMutableIndexSet indexSet];
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        [nsIndexSet addIndex:(i * 3)];
+    }
+    [nsIndexSet addIndex:1];
+    
+    GNEOrderedIndexSet *indexSet = [[GNEOrderedIndexSet alloc] initWithNSIndexSet:nsIndexSet];
+    
+    XCTAssertFalse(indexSet.isRangeCompressed);
+    XCTAssertEqual(indexSet.numberOfRanges, count);
+    XCTAssertCount(indexSet, count + 1);
+    XCTAssertIndexPosition(indexSet, 1, 1);
+    XCTAssertIndexPosition(indexSet, 3, 2);
+    XCTAssertEqualObjects(indexSet.ns_indexSet, nsIndexSet);
+    
+    [indexSet addIndex:2];
+    XCTAssertEqual(indexSet.numberOfRanges, count + 1);
+    XCTAssertIndexPosition(indexSet, 2, count + 1);
+}
+
+
+- (void)testInitialization_WithSortedIndexes
+{
+    NSUInteger indexes[] = { 3, 4, 5, 9, 1021 };
+    NSUInteger count = 5;
+    
+    GNEOrderedIndexSet *indexSet = [GNEOrderedIndexSet indexSetWithSortedIndexes:indexes count:count];
+    
+    XCTAssertCount(indexSet, count);
+    XCTAssertEqual(indexSet.numberOfRanges, 3);
+    XCTAssertEqual(indexSet.smallestIndex, 3);
+    XCTAssertEqual(indexSet.largestIndex, 1021);
+    XCTAssertNotContainsIndex(indexSet, 6);
+    XCTAssertEqualObjects(indexSet, [GNEOrderedIndexSet indexSetWithIndexes:indexes count:count]);
+    
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        XCTAssertIndexPosition(indexSet, indexes[i], i);
+    }
+}
+
+
+- (void)testInitialization_WithSortedIndexesNoCopy
+{
+    NSUInteger count = 1000;
+    
+    NSUInteger *indexes = malloc(count * sizeof(NSUInteger));
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        indexes[i] = i * 2;
+    }
+    
+    GNEOrderedIndexSet *indexSet = [[GNEOrderedIndexSet alloc] initWithSortedIndexesNoCopy:indexes
+                                                                                     count:count
+                                                                              freeWhenDone:YES];
+    
+    XCTAssertFalse(indexSet.isRangeCompressed);
+    XCTAssertCount(indexSet, count);
+    XCTAssertIndexPosition(indexSet, 0, 0);
+    XCTAssertIndexPosition(indexSet, 2 * (count - 1), count - 1);
+    XCTAssertNotContainsIndex(indexSet, 1);
+    
+    // The adopted buffer grows like any other backing store.
+    [indexSet addIndex:1 atPosition:0];
+    [indexSet addIndex:(2 * count)];
+    XCTAssertCount(indexSet, count + 2);
+    XCTAssertIndexPosition(indexSet, 1, 0);
+    XCTAssertIndexPosition(indexSet, 0, 1);
+    XCTAssertIndexPosition(indexSet, 2 * count, count + 1);
+}
+
+
+- (void)testInitialization_WithSortedIndexesNoCopy_RangeCompressed
+{
+    NSUInteger count = 1000;
+    
+    NSUInteger *indexes = malloc(count * sizeof(NSUInteger));
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        indexes[i] = i + 100;
+    }
+    
+    GNEOrderedIndexSet *indexSet = [[GNEOrderedIndexSet alloc] initWithSortedIndexesNoCopy:indexes
+                                                                                     count:count
+                                                                              freeWhenDone:NO];
+    indexes[0] = 0;
+    
+    XCTAssertTrue(indexSet.isRangeCompressed);
+    XCTAssertEqual(indexSet.numberOfRanges, 1);
+    XCTAssertIndexPosition(indexSet, 100, 0);
+    XCTAssertNotContainsIndex(indexSet, 0);
+    
+    free(indexes);
+}
+
+
 // ------------------------------------------------------------------------------------------
 #pragma mark - Count
 // ------------------------------------------------------------------------------------------
@@ -1747,6 +1868,415 @@ static const NSUInteger kPerformanceTestIterations = 10000;
 }
 
 
+- (void)testRemoveIndexAtPosition_UpdatesPositions
+{
+    NSUInteger indexes[] = {40, 10, 30, 0, 20};
+    
+    GNEOrderedIndexSet *indexSet = [GNEOrderedIndexSet indexSetWithIndexes:indexes count:5];
+    [indexSet addIndex:25 atPosition:2];
+    [indexSet removeIndexAtPosition:0];
+    [indexSet removeIndex:0];
+    [indexSet addIndex:5 atPosition:0];
+    
+    XCTAssertCount(indexSet, 5);
+    XCTAssertIndexPosition(indexSet, 5, 0);
+    XCTAssertIndexPosition(indexSet, 10, 1);
+    XCTAssertIndexPosition(indexSet, 25, 2);
+    XCTAssertIndexPosition(indexSet, 30, 3);
+    XCTAssertIndexPosition(indexSet, 20, 4);
+    XCTAssertNotContainsIndex(indexSet, 0);
+    XCTAssertNotContainsIndex(indexSet, 40);
+    XCTAssertEqual([indexSet positionOfIndex:40], NSNotFound);
+    XCTAssertEqual(indexSet.smallestIndex, 5);
+    XCTAssertEqual(indexSet.largestIndex, 30);
+}
+
+
+- (void)testAddIndexes_GrowsPastInitialCapacity
+{
+    NSUInteger count = 1000;
+    
+    GNEOrderedIndexSet *indexSet = [GNEOrderedIndexSet indexSet];
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        [indexSet addIndex:(count - 1 - i) atPosition:0];
+    }
+    
+    XCTAssertCount(indexSet, count);
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        XCTAssertIndexPosition(indexSet, i, i);
+    }
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Range Compression
+// ------------------------------------------------------------------------------------------
+- (void)testRangeCompression_Small
+{
+    GNEOrderedIndexSet *indexSet = [GNEOrderedIndexSet indexSet];
+    [self p_addIndexesToIndexSet:indexSet count:10 isPerformanceTest:NO];
+    
+    XCTAssertFalse(indexSet.isRangeCompressed);
+    XCTAssertEqual(indexSet.numberOfRanges, 1);
+}
+
+
+- (void)testRangeCompression_ContiguousIndexes
+{
+    NSUInteger count = kTestIndexSetMaxIndex;
+    
+    GNEOrderedIndexSet *indexSet = [GNEOrderedIndexSet indexSet];
+    [self p_addIndexesToIndexSet:indexSet count:count isPerformanceTest:NO];
+    
+    XCTAssertTrue(indexSet.isRangeCompressed);
+    XCTAssertEqual(indexSet.numberOfRanges, 1);
+    XCTAssertCount(indexSet, count);
+    XCTAssertEqual(indexSet.smallestIndex, 0);
+    XCTAssertEqual(indexSet.largestIndex, count - 1);
+    XCTAssertNotContainsIndex(indexSet, count);
+    XCTAssertEqual([indexSet indexAtPosition:count], NSNotFound);
+    XCTAssertEqualObjects(indexSet.ns_indexSet, [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, count)]);
+}
+
+
+- (void)testRangeCompression_BlockMove
+{
+    NSUInteger blockLength = 5000;
+    
+    GNEOrderedIndexSet *indexSet = [GNEOrderedIndexSet indexSet];
+    for (NSUInteger i = 0; i < blockLength; i++)
+    {
+        [indexSet addIndex:(blockLength + i)];
+    }
+    for (NSUInteger i = 0; i < blockLength; i++)
+    {
+        [indexSet addIndex:i];
+    }
+    
+    XCTAssertTrue(indexSet.isRangeCompressed);
+    XCTAssertEqual(indexSet.numberOfRanges, 2);
+    XCTAssertCount(indexSet, 2 * blockLength);
+    XCTAssertIndexPosition(indexSet, blockLength, 0);
+    XCTAssertIndexPosition(indexSet, 2 * blockLength - 1, blockLength - 1);
+    XCTAssertIndexPosition(indexSet, 0, blockLength);
+    XCTAssertIndexPosition(indexSet, blockLength - 1, 2 * blockLength - 1);
+    XCTAssertEqual(indexSet.smallestIndex, 0);
+    XCTAssertEqual(indexSet.largestIndex, 2 * blockLength - 1);
+}
+
+
+- (void)testRangeCompression_SplitAndMergeRuns
+{
+    NSUInteger count = 1000;
+    
+    GNEOrderedIndexSet *indexSet = [GNEOrderedIndexSet indexSet];
+    [self p_addIndexesToIndexSet:indexSet count:count isPerformanceTest:YES];
+    XCTAssertTrue(indexSet.isRangeCompressed);
+    
+    [indexSet removeIndex:500];
+    XCTAssertEqual(indexSet.numberOfRanges, 2);
+    XCTAssertNotContainsIndex(indexSet, 500);
+    XCTAssertIndexPosition(indexSet, 501, 500);
+    
+    [indexSet addIndex:2000 atPosition:500];
+    XCTAssertEqual(indexSet.numberOfRanges, 3);
+    XCTAssertIndexPosition(indexSet, 2000, 500);
+    XCTAssertIndexPosition(indexSet, 501, 501);
+    
+    [indexSet removeIndexAtPosition:500];
+    XCTAssertEqual(indexSet.numberOfRanges, 2);
+    
+    [indexSet addIndex:500 atPosition:500];
+    XCTAssertEqual(indexSet.numberOfRanges, 1);
+    XCTAssertCount(indexSet, count);
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        XCTAssertIndexPosition(indexSet, i, i);
+    }
+}
+
+
+- (void)testRangeCompression_Decompression
+{
+    NSUInteger count = 1000;
+    
+    GNEOrderedIndexSet *indexSet = [GNEOrderedIndexSet indexSet];
+    [self p_addIndexesToIndexSet:indexSet count:count isPerformanceTest:YES];
+    XCTAssertTrue(indexSet.isRangeCompressed);
+    
+    for (NSUInteger i = 1; i < count; i += 2)
+    {
+        [indexSet removeIndex:i];
+    }
+    
+    XCTAssertFalse(indexSet.isRangeCompressed);
+    XCTAssertEqual(indexSet.numberOfRanges, count / 2);
+    XCTAssertCount(indexSet, count / 2);
+    for (NSUInteger i = 0; i < count / 2; i++)
+    {
+        XCTAssertIndexPosition(indexSet, (i * 2), i);
+        XCTAssertNotContainsIndex(indexSet, (i * 2 + 1));
+    }
+}
+
+
+- (void)testRangeCompression_CopyingAndEquality
+{
+    NSUInteger count = 1000;
+    
+    GNEOrderedIndexSet *indexSet = [GNEOrderedIndexSet indexSet];
+    [self p_addIndexesToIndexSet:indexSet count:count isPerformanceTest:YES];
+    [indexSet addIndex:5000 atPosition:10];
+    
+    GNEOrderedIndexSet *copy = [indexSet copy];
+    
+    XCTAssertTrue(copy.isRangeCompressed);
+    XCTAssertEqualObjects(copy, indexSet);
+    XCTAssertEqual(copy.hash, indexSet.hash);
+    XCTAssertEqual(indexSet.hash, (count * (count - 1) / 2) + 5000);
+    
+    [copy removeIndex:5000];
+    XCTAssertNotEqualObjects(copy, indexSet);
+    XCTAssertEqual(copy.numberOfRanges, 1);
+    XCTAssertEqual(indexSet.numberOfRanges, 3);
+}
+
+
+- (void)testRangeCompression_Enumeration_Reverse
+{
+    NSUInteger count = 1000;
+    
+    GNEOrderedIndexSet *indexSet = [GNEOrderedIndexSet indexSet];
+    [self p_addIndexesToIndexSet:indexSet count:count isPerformanceTest:YES];
+    XCTAssertTrue(indexSet.isRangeCompressed);
+    
+    __block NSUInteger iterations = 0;
+    [indexSet enumerateIndexesWithOptions:NSEnumerationReverse
+                               usingBlock:^(NSUInteger idx, NSUInteger position __unused, BOOL *stop)
+    {
+        XCTAssertEqual(idx, count - 1 - iterations);
+        
+        iterations++;
+        *stop = (iterations == 10);
+    }];
+    
+    XCTAssertEqual(iterations, 10);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Set Algebra
+// ------------------------------------------------------------------------------------------
+- (void)testAddIndexesInRange
+{
+    NSUInteger indexes[] = {9, 3, 4};
+    GNEOrderedIndexSet *indexSet = [GNEOrderedIndexSet indexSetWithIndexes:indexes count:3];
+    
+    [indexSet addIndexesInRange:NSMakeRange(2, 4)];
+    [indexSet addIndexesInRange:NSMakeRange(20, 0)];
+    
+    NSUInteger expected[] = {9, 3, 4, 2, 5};
+    XCTAssertEqualObjects(indexSet, [GNEOrderedIndexSet indexSetWithIndexes:expected count:5]);
+    XCTAssertIndexPosition(indexSet, 2, 3);
+}
+
+
+- (void)testUnionIndexSet
+{
+    NSUInteger indexes[] = {7, 1, 2};
+    NSUInteger otherIndexes[] = {3, 2, 0, 8};
+    GNEOrderedIndexSet *indexSet = [GNEOrderedIndexSet indexSetWithIndexes:indexes count:3];
+    GNEOrderedIndexSet *otherIndexSet = [GNEOrderedIndexSet indexSetWithIndexes:otherIndexes count:4];
+    
+    [indexSet unionIndexSet:otherIndexSet];
+    
+    NSUInteger expected[] = {7, 1, 2, 3, 0, 8};
+    XCTAssertEqualObjects(indexSet, [GNEOrderedIndexSet indexSetWithIndexes:expected count:6]);
+    XCTAssertEqual(indexSet.smallestIndex, 0);
+    XCTAssertEqual(indexSet.largestIndex, 8);
+    
+    [indexSet unionIndexSet:indexSet];
+    XCTAssertCount(indexSet, 6);
+}
+
+
+- (void)testIntersectIndexSet
+{
+    NSUInteger indexes[] = {7, 1, 2, 3, 0, 8};
+    NSUInteger otherIndexes[] = {8, 2, 0, 5};
+    GNEOrderedIndexSet *indexSet = [GNEOrderedIndexSet indexSetWithIndexes:indexes count:6];
+    GNEOrderedIndexSet *otherIndexSet = [GNEOrderedIndexSet indexSetWithIndexes:otherIndexes count:4];
+    
+    [indexSet intersectIndexSet:otherIndexSet];
+    
+    NSUInteger expected[] = {2, 0, 8};
+    XCTAssertEqualObjects(indexSet, [GNEOrderedIndexSet indexSetWithIndexes:expected count:3]);
+    XCTAssertNotContainsIndex(indexSet, 5);
+    
+    [indexSet intersectIndexSet:[GNEOrderedIndexSet indexSet]];
+    XCTAssertCount(indexSet, 0);
+    XCTAssertEqual(indexSet.smallestIndex, NSNotFound);
+}
+
+
+- (void)testMinusIndexSet
+{
+    NSUInteger indexes[] = {7, 1, 2, 3, 0, 8};
+    NSUInteger otherIndexes[] = {8, 2, 5};
+    GNEOrderedIndexSet *indexSet = [GNEOrderedIndexSet indexSetWithIndexes:indexes count:6];
+    GNEOrderedIndexSet *otherIndexSet = [GNEOrderedIndexSet indexSetWithIndexes:otherIndexes count:3];
+    
+    [indexSet minusIndexSet:otherIndexSet];
+    
+    NSUInteger expected[] = {7, 1, 3, 0};
+    XCTAssertEqualObjects(indexSet, [GNEOrderedIndexSet indexSetWithIndexes:expected count:4]);
+    XCTAssertIndexPosition(indexSet, 3, 2);
+    XCTAssertEqual(indexSet.numberOfRanges, 4);
+}
+
+
+- (void)testShiftIndexes
+{
+    NSUInteger indexes[] = {7, 1, 2, 3, 0, 8};
+    GNEOrderedIndexSet *indexSet = [GNEOrderedIndexSet indexSetWithIndexes:indexes count:6];
+    
+    [indexSet shiftIndexesStartingAtIndex:3 by:10];
+    
+    NSUInteger shiftedUp[] = {17, 1, 2, 13, 0, 18};
+    XCTAssertEqualObjects(indexSet, [GNEOrderedIndexSet indexSetWithIndexes:shiftedUp count:6]);
+    
+    // Like NSMutableIndexSet, shifting down removes the indexes that would be overwritten.
+    [indexSet shiftIndexesStartingAtIndex:13 by:-12];
+    
+    NSUInteger shiftedDown[] = {5, 1, 0, 6};
+    XCTAssertEqualObjects(indexSet, [GNEOrderedIndexSet indexSetWithIndexes:shiftedDown count:4]);
+    XCTAssertEqual(indexSet.largestIndex, 6);
+}
+
+
+- (void)testSetAlgebra_RangeCompressed
+{
+    NSUInteger count = 1000;
+    
+    GNEOrderedIndexSet *indexSet = [GNEOrderedIndexSet indexSet];
+    [indexSet addIndexesInRange:NSMakeRange(count, count)];
+    [indexSet addIndexesInRange:NSMakeRange(0, count)];
+    XCTAssertTrue(indexSet.isRangeCompressed);
+    XCTAssertEqual(indexSet.numberOfRanges, 2);
+    XCTAssertIndexPosition(indexSet, 0, count);
+    
+    GNEOrderedIndexSet *otherIndexSet = [GNEOrderedIndexSet indexSet];
+    [otherIndexSet addIndexesInRange:NSMakeRange(500, count)];
+    
+    GNEOrderedIndexSet *intersection = [indexSet copy];
+    [intersection intersectIndexSet:otherIndexSet];
+    XCTAssertTrue(intersection.isRangeCompressed);
+    XCTAssertEqual(intersection.numberOfRanges, 2);
+    XCTAssertIndexPosition(intersection, count, 0);
+    XCTAssertIndexPosition(intersection, 500, 500);
+    XCTAssertCount(intersection, count);
+    
+    GNEOrderedIndexSet *difference = [indexSet copy];
+    [difference minusIndexSet:otherIndexSet];
+    XCTAssertEqual(difference.numberOfRanges, 2);
+    XCTAssertIndexPosition(difference, 1500, 0);
+    XCTAssertIndexPosition(difference, 0, 500);
+    XCTAssertCount(difference, count);
+    
+    [indexSet shiftIndexesStartingAtIndex:count by:count];
+    XCTAssertEqual(indexSet.numberOfRanges, 2);
+    XCTAssertIndexPosition(indexSet, 2 * count, 0);
+    XCTAssertNotContainsIndex(indexSet, count);
+    XCTAssertEqual(indexSet.largestIndex, 3 * count - 1);
+}
+
+
+- (void)testSetAlgebra_Decompression
+{
+    NSUInteger count = 1000;
+    
+    GNEOrderedIndexSet *indexSet = [GNEOrderedIndexSet indexSet];
+    [indexSet addIndexesInRange:NSMakeRange(0, count)];
+    XCTAssertTrue(indexSet.isRangeCompressed);
+    
+    GNEOrderedIndexSet *evenIndexes = [GNEOrderedIndexSet indexSet];
+    for (NSUInteger i = 0; i < count; i += 2)
+    {
+        [evenIndexes addIndex:i];
+    }
+    
+    [indexSet minusIndexSet:evenIndexes];
+    XCTAssertFalse(indexSet.isRangeCompressed);
+    XCTAssertCount(indexSet, count / 2);
+    XCTAssertEqual(indexSet.numberOfRanges, count / 2);
+    XCTAssertIndexPosition(indexSet, 1, 0);
+    XCTAssertIndexPosition(indexSet, count - 1, count / 2 - 1);
+    
+    [indexSet addIndex:count];
+    XCTAssertIndexPosition(indexSet, count, count / 2);
+}
+
+
+- (void)testEnumerateRanges
+{
+    NSUInteger indexes[] = {7, 8, 1, 2, 3, 0};
+    GNEOrderedIndexSet *indexSet = [GNEOrderedIndexSet indexSetWithIndexes:indexes count:6];
+    
+    NSMutableArray *ranges = [NSMutableArray array];
+    NSMutableArray *positions = [NSMutableArray array];
+    [indexSet enumerateRangesUsingBlock:^(NSRange range, NSUInteger position, BOOL *stop __unused)
+    {
+        [ranges addObject:[NSValue valueWithRange:range]];
+        [positions addObject:@(position)];
+    }];
+    
+    NSArray *expectedRanges = @[[NSValue valueWithRange:NSMakeRange(7, 2)],
+                                [NSValue valueWithRange:NSMakeRange(1, 3)],
+                                [NSValue valueWithRange:NSMakeRange(0, 1)]];
+    XCTAssertEqualObjects(ranges, expectedRanges);
+    XCTAssertEqualObjects(positions, (@[@0, @2, @5]));
+    
+    [ranges removeAllObjects];
+    [positions removeAllObjects];
+    [indexSet enumerateRangesWithOptions:NSEnumerationReverse
+                              usingBlock:^(NSRange range, NSUInteger position, BOOL *stop)
+    {
+        [ranges addObject:[NSValue valueWithRange:range]];
+        [positions addObject:@(position)];
+        *stop = (ranges.count == 2);
+    }];
+    
+    XCTAssertEqualObjects(ranges, (@[expectedRanges[2], expectedRanges[1]]));
+    XCTAssertEqualObjects(positions, (@[@5, @2]));
+}
+
+
+- (void)testEnumerateRanges_RangeCompressed
+{
+    NSUInteger count = 1000;
+    
+    GNEOrderedIndexSet *indexSet = [GNEOrderedIndexSet indexSet];
+    [indexSet addIndexesInRange:NSMakeRange(count, count)];
+    [indexSet addIndexesInRange:NSMakeRange(0, count)];
+    XCTAssertTrue(indexSet.isRangeCompressed);
+    
+    __block NSUInteger iterations = 0;
+    [indexSet enumerateRangesWithOptions:NSEnumerationReverse
+                              usingBlock:^(NSRange range, NSUInteger position, BOOL *stop __unused)
+    {
+        XCTAssertEqual(range.location, (iterations == 0) ? 0 : count);
+        XCTAssertEqual(range.length, count);
+        XCTAssertEqual(position, (iterations == 0) ? count : 0);
+        
+        iterations++;
+    }];
+    
+    XCTAssertEqual(iterations, 2);
+}
+
+
 // ------------------------------------------------------------------------------------------
 #pragma mark - Performance - GNEOrderedIndexSet
 // ------------------------------------------------------------------------------------------
@@ -1792,15 +2322,124 @@ static const NSUInteger kPerformanceTestIterations = 10000;
 }
 
 
-- (void)testPerformance_AddIndexes
+- (void)testPerformance_AddIndexes_10000
 {
-    NSUInteger count = kPerformanceTestIterations;
+    [self p_measureAddingIndexesWithCount:kPerformanceTestIterations];
+}
+
+
+- (void)testPerformance_AddIndexes_100000
+{
+    [self p_measureAddingIndexesWithCount:100000];
+}
+
+
+- (void)testPerformance_AddIndexes_1000000
+{
+    [self p_measureAddingIndexesWithCount:1000000];
+}
+
+
+- (void)testPerformance_PositionOfIndex_100000
+{
+    NSUInteger count = 100000;
     
     GNEOrderedIndexSet *indexSet = [GNEOrderedIndexSet indexSet];
+    [self p_addIndexesToIndexSet:indexSet count:count isPerformanceTest:YES];
+    
+    XCTAssertCount(indexSet, count);
+    
+    [self measureBlock:^()
+    {
+        for (NSUInteger i = 0; i < count; i++)
+        {
+            XCTAssertEqual([indexSet positionOfIndex:i], i);
+        }
+    }];
+}
+
+
+- (void)testPerformance_MoveBlocks_1000000
+{
+    NSUInteger blockLength = 5000;
+    NSUInteger blockCount = 200;
+    
+    [self measureBlock:^()
+    {
+        // Adds the blocks in reverse order, like a move of many adjacent sections to the front.
+        GNEOrderedIndexSet *indexSet = [GNEOrderedIndexSet indexSet];
+        for (NSUInteger block = 0; block < blockCount; block++)
+        {
+            NSUInteger location = (blockCount - 1 - block) * blockLength;
+            for (NSUInteger i = 0; i < blockLength; i++)
+            {
+                [indexSet addIndex:(location + i)];
+            }
+        }
+        
+        XCTAssertEqual(indexSet.numberOfRanges, blockCount);
+        XCTAssertEqual([indexSet positionOfIndex:0], (blockCount - 1) * blockLength);
+        XCTAssertEqual(indexSet.ns_indexSet.count, blockCount * blockLength);
+    }];
+}
+
+
+- (void)testPerformance_RemoveIndexAtPosition_100000
+{
+    NSUInteger count = 100000;
     
     [self measureBlock:^()
     {
+        GNEOrderedIndexSet *indexSet = [GNEOrderedIndexSet indexSet];
         [self p_addIndexesToIndexSet:indexSet count:count isPerformanceTest:YES];
+        
+        while (indexSet.count > 0)
+        {
+            [indexSet removeIndexAtPosition:(indexSet.count - 1)];
+        }
+    }];
+}
+
+
+- (void)testPerformance_InitWithNSIndexSet_1000000
+{
+    NSUInteger count = 1000000;
+    
+    NSMutableIndexSet *nsIndexSet = [NSMutableIndexSet indexSet];
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        [nsIndexSet addIndex:(i * 2)];
+    }
+    
+    [self measureBlock:^()
+    {
+        GNEOrderedIndexSet *indexSet = [GNEOrderedIndexSet indexSetWithNSIndexSet:nsIndexSet];
+        
+        XCTAssertCount(indexSet, count);
+    }];
+}
+
+
+- (void)testPerformance_SetAlgebra_1000000
+{
+    NSUInteger blockLength = 5000;
+    NSUInteger blockCount = 200;
+    
+    [self measureBlock:^()
+    {
+        GNEOrderedIndexSet *indexSet = [GNEOrderedIndexSet indexSet];
+        GNEOrderedIndexSet *otherIndexSet = [GNEOrderedIndexSet indexSet];
+        for (NSUInteger block = 0; block < blockCount; block++)
+        {
+            [indexSet addIndexesInRange:NSMakeRange((blockCount - 1 - block) * blockLength, blockLength)];
+            [otherIndexSet addIndexesInRange:NSMakeRange(block * blockLength + (blockLength / 2), blockLength)];
+        }
+        
+        [indexSet minusIndexSet:otherIndexSet];
+        [indexSet unionIndexSet:otherIndexSet];
+        [indexSet shiftIndexesStartingAtIndex:blockLength by:blockLength];
+        
+        XCTAssertCount(indexSet, blockCount * blockLength + (blockLength / 2));
     }];
 }
 
@@ -1963,6 +2602,18 @@ static const NSUInteger kPerformanceTestIterations = 10000;
 }
 
 
+- (void)p_measureAddingIndexesWithCount:(NSUInteger)count
+{
+    [self measureBlock:^()
+    {
+        GNEOrderedIndexSet *indexSet = [GNEOrderedIndexSet indexSet];
+        [self p_addIndexesToIndexSet:indexSet count:count isPerformanceTest:YES];
+        
+        XCTAssertCount(indexSet, count);
+    }];
+}
+
+
 - (void)p_addIndexesToNSMutableIndexSet:(NSMutableIndexSet *)mutableIndexSet count:(NSUInteger)count
 {
     for (NSUInteger i = 0; i < count; i++)
@@ -0,0 +1,825 @@
+//
+//  GNEOutlineViewItemArrayTests.m
+//  GNESectionedTableView
+//
+//  Copyright (c) 2016 Gone East LLC. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "GNEOutlineViewItem.h"
+#import "GNEOutlineViewParentItem.h"
+#import "GNEOutlineViewItemArray.h"
+
+
+// ------------------------------------------------------------------------------------------
+
+
+static const NSUInteger kPerformanceTestIterations = 10000;
+
+#ifndef GNEOutlineViewItemArray_FoundationPerformanceTestsEnabled
+    #define GNEOutlineViewItemArray_FoundationPerformanceTestsEnabled 0
+#endif
+
+#define XCTAssertCount(array, c) \
+    XCTAssertEqual(array.count, c)
+
+#define XCTAssertItemIndex(array, item, i) \
+    XCTAssertEqual([array objectAtIndex:i], item); \
+    XCTAssertEqual([array indexOfObject:item], i)
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@interface GNEOutlineViewItemArrayTests : XCTestCase <GNEOutlineViewItemPasteboardWritingDelegate>
+
+@property (nonatomic, strong) GNEOutlineViewParentItem *parentItem;
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@implementation GNEOutlineViewItemArrayTests
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Set up/Tear Down
+// ------------------------------------------------------------------------------------------
+- (void)setUp
+{
+    [super setUp];
+    self.parentItem = [[GNEOutlineViewParentItem alloc] init];
+}
+
+
+- (void)tearDown
+{
+    self.parentItem = nil;
+    [super tearDown];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Initialization
+// ------------------------------------------------------------------------------------------
+- (void)testInitialization_Default
+{
+    GNEOutlineViewItemArray *array = [[GNEOutlineViewItemArray alloc] init];
+    
+    XCTAssertNotNil(array);
+    XCTAssertCount(array, 0);
+    XCTAssertNil(array.firstObject);
+    XCTAssertNil(array.lastObject);
+}
+
+
+- (void)testInitialization_Items
+{
+    NSArray *items = [self p_itemsWithCount:1000];
+    GNEOutlineViewItemArray *array = [[GNEOutlineViewItemArray alloc] initWithItems:items];
+    
+    XCTAssertCount(array, items.count);
+    XCTAssertEqual(array.firstObject, items.firstObject);
+    XCTAssertEqual(array.lastObject, items.lastObject);
+    for (NSUInteger i = 0; i < items.count; i++)
+    {
+        XCTAssertItemIndex(array, items[i], i);
+    }
+    XCTAssertEqualObjects([array allObjects], items);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Add/Insert
+// ------------------------------------------------------------------------------------------
+- (void)testAdd_One
+{
+    GNEOutlineViewItemArray *array = [GNEOutlineViewItemArray array];
+    GNEOutlineViewItem *item = [self p_item];
+    [array addObject:item];
+    
+    XCTAssertCount(array, 1);
+    XCTAssertItemIndex(array, item, 0);
+    XCTAssertTrue([array containsObject:item]);
+}
+
+
+- (void)testInsert_Middle
+{
+    NSMutableArray *items = [[self p_itemsWithCount:100] mutableCopy];
+    GNEOutlineViewItemArray *array = [[GNEOutlineViewItemArray alloc] initWithItems:items];
+    
+    for (NSUInteger i = 0; i < 100; i++)
+    {
+        GNEOutlineViewItem *item = [self p_item];
+        NSUInteger index = (i * 7) % (items.count + 1);
+        [items insertObject:item atIndex:index];
+        [array insertObject:item atIndex:index];
+    }
+    
+    XCTAssertCount(array, items.count);
+    for (NSUInteger i = 0; i < items.count; i++)
+    {
+        XCTAssertItemIndex(array, items[i], i);
+    }
+}
+
+
+- (void)testInsert_BeyondBounds
+{
+    GNEOutlineViewItemArray *array = [GNEOutlineViewItemArray array];
+    
+    XCTAssertThrows([array insertObject:[self p_item] atIndex:1]);
+}
+
+
+- (void)testInsert_ObjectsAtIndexes
+{
+    // A few runs are inserted one at a time and many are interleaved with a single rebuild.
+    for (NSUInteger step = 1; step <= 50; step += 49)
+    {
+        NSMutableArray *items = [[self p_itemsWithCount:1000] mutableCopy];
+        GNEOutlineViewItemArray *array = [[GNEOutlineViewItemArray alloc] initWithItems:items];
+        
+        NSMutableIndexSet *indexes = [NSMutableIndexSet indexSet];
+        for (NSUInteger index = 0; index < 1000; index += step)
+        {
+            [indexes addIndexesInRange:NSMakeRange(index * 2, 3)];
+        }
+        NSArray *insertedItems = [self p_itemsWithCount:indexes.count];
+        [items insertObjects:insertedItems atIndexes:indexes];
+        [array insertObjects:insertedItems atIndexes:indexes];
+        
+        XCTAssertCount(array, items.count);
+        for (NSUInteger i = 0; i < items.count; i++)
+        {
+            XCTAssertItemIndex(array, items[i], i);
+        }
+    }
+}
+
+
+- (void)testInsert_EntriesAtIndexes
+{
+    GNEOutlineViewItemArray *array = [self p_lazyArrayWithCount:100];
+    [array setHeightsUsingBlock:^CGFloat(GNEOutlineViewItem * __unused item, NSUInteger __unused index)
+    {
+        return 10.0;
+    }];
+    
+    NSMutableIndexSet *indexes = [NSMutableIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 50)];
+    [indexes addIndex:149];
+    [array insertEntriesAtIndexes:indexes];
+    
+    XCTAssertCount(array, 151);
+    XCTAssertEqual(array.materializedCount, 0);
+    XCTAssertEqual(array.totalHeight, 1000.0);
+    XCTAssertEqual([array heightOfObjectAtIndex:49], 0.0);
+    XCTAssertEqual([array heightOfObjectAtIndex:50], 10.0);
+    XCTAssertEqual([array heightOfObjectAtIndex:150], 10.0);
+    XCTAssertEqual(array[149].parentItem, self.parentItem);
+    
+    XCTAssertThrows([array insertEntriesAtIndexes:[NSIndexSet indexSetWithIndex:153]]);
+    XCTAssertCount(array, 151);
+}
+
+
+- (void)testInsert_ItemInAnotherArray
+{
+    GNEOutlineViewItem *item = [self p_item];
+    GNEOutlineViewItemArray *array = [GNEOutlineViewItemArray array];
+    GNEOutlineViewItemArray *otherArray = [GNEOutlineViewItemArray array];
+    [array addObject:item];
+    
+    XCTAssertThrows([otherArray addObject:item]);
+    XCTAssertFalse([otherArray containsObject:item]);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Remove
+// ------------------------------------------------------------------------------------------
+- (void)testRemove_Middle
+{
+    NSMutableArray *items = [[self p_itemsWithCount:200] mutableCopy];
+    GNEOutlineViewItemArray *array = [[GNEOutlineViewItemArray alloc] initWithItems:items];
+    
+    for (NSUInteger i = 0; i < 100; i++)
+    {
+        NSUInteger index = (i * 13) % items.count;
+        GNEOutlineViewItem *item = items[index];
+        [items removeObjectAtIndex:index];
+        [array removeObjectAtIndex:index];
+        
+        XCTAssertFalse([array containsObject:item]);
+        XCTAssertEqual([array indexOfObject:item], NSNotFound);
+    }
+    
+    XCTAssertCount(array, items.count);
+    XCTAssertEqualObjects([array allObjects], items);
+}
+
+
+- (void)testRemove_ObjectsAtIndexes
+{
+    // A few runs are split off one at a time and many are compacted with a single rebuild.
+    for (NSUInteger step = 2; step <= 200; step += 198)
+    {
+        NSMutableArray *items = [[self p_itemsWithCount:2000] mutableCopy];
+        GNEOutlineViewItemArray *array = [[GNEOutlineViewItemArray alloc] initWithItems:items];
+        [array setHeightsUsingBlock:^CGFloat(GNEOutlineViewItem * __unused item, NSUInteger index)
+        {
+            return (CGFloat)index;
+        }];
+        
+        NSMutableIndexSet *indexes = [NSMutableIndexSet indexSet];
+        for (NSUInteger index = 0; index < 2000; index += step)
+        {
+            [indexes addIndex:index];
+        }
+        [indexes addIndexesInRange:NSMakeRange(1990, 10)];
+        
+        CGFloat totalHeight = array.totalHeight;
+        for (NSUInteger index = indexes.firstIndex; index != NSNotFound; index = [indexes indexGreaterThanIndex:index])
+        {
+            totalHeight -= (CGFloat)index;
+        }
+        
+        NSArray *removedItems = [items objectsAtIndexes:indexes];
+        [items removeObjectsAtIndexes:indexes];
+        [array removeObjectsAtIndexes:indexes];
+        
+        XCTAssertCount(array, items.count);
+        XCTAssertEqual(array.totalHeight, totalHeight);
+        XCTAssertEqualObjects([array allObjects], items);
+        for (GNEOutlineViewItem *item in removedItems)
+        {
+            XCTAssertFalse([array containsObject:item]);
+        }
+        
+        [array addObject:[self p_item]];
+        XCTAssertCount(array, items.count + 1);
+    }
+}
+
+
+- (void)testRemove_ObjectsAtIndexesBeyondBounds
+{
+    GNEOutlineViewItemArray *array = [[GNEOutlineViewItemArray alloc] initWithItems:[self p_itemsWithCount:10]];
+    
+    XCTAssertThrows([array removeObjectsAtIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(5, 6)]]);
+    XCTAssertCount(array, 10);
+}
+
+
+- (void)testRemove_BeyondBounds
+{
+    GNEOutlineViewItemArray *array = [[GNEOutlineViewItemArray alloc] initWithItems:[self p_itemsWithCount:1]];
+    
+    XCTAssertThrows([array removeObjectAtIndex:1]);
+    XCTAssertCount(array, 1);
+}
+
+
+- (void)testRemove_All
+{
+    NSArray *items = [self p_itemsWithCount:100];
+    GNEOutlineViewItemArray *array = [[GNEOutlineViewItemArray alloc] initWithItems:items];
+    [array removeAllObjects];
+    
+    XCTAssertCount(array, 0);
+    for (GNEOutlineViewItem *item in items)
+    {
+        XCTAssertFalse([array containsObject:item]);
+    }
+    
+    [array addObject:items.firstObject];
+    XCTAssertItemIndex(array, items.firstObject, 0);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Heights
+// ------------------------------------------------------------------------------------------
+- (void)testHeights_Offsets
+{
+    GNEOutlineViewItemArray *array = [[GNEOutlineViewItemArray alloc] initWithItems:[self p_itemsWithCount:100]];
+    [array setHeightsUsingBlock:^CGFloat(GNEOutlineViewItem * __unused item, NSUInteger index)
+    {
+        return (CGFloat)(index + 1);
+    }];
+    
+    XCTAssertEqual(array.totalHeight, 5050.0);
+    XCTAssertEqual([array heightOfObjectAtIndex:9], 10.0);
+    XCTAssertEqual([array offsetOfObjectAtIndex:0], 0.0);
+    XCTAssertEqual([array offsetOfObjectAtIndex:10], 55.0);
+    XCTAssertEqual([array offsetOfObjectAtIndex:100], 5050.0);
+    
+    [array setHeight:20.0 forObjectAtIndex:9];
+    XCTAssertEqual(array.totalHeight, 5060.0);
+    XCTAssertEqual([array offsetOfObjectAtIndex:10], 65.0);
+    
+    [array insertObject:[self p_item] height:5.0 atIndex:0];
+    XCTAssertEqual(array.totalHeight, 5065.0);
+    XCTAssertEqual([array offsetOfObjectAtIndex:11], 70.0);
+    
+    [array removeObjectAtIndex:10];
+    XCTAssertEqual(array.totalHeight, 5045.0);
+    XCTAssertEqual([array offsetOfObjectAtIndex:10], 50.0);
+}
+
+
+- (void)testHeights_ObjectAtOffset
+{
+    NSArray *items = [self p_itemsWithCount:3];
+    GNEOutlineViewItemArray *array = [[GNEOutlineViewItemArray alloc] initWithItems:items];
+    [array setHeightsUsingBlock:^CGFloat(GNEOutlineViewItem * __unused item, NSUInteger index __unused)
+    {
+        return 10.0;
+    }];
+    
+    NSUInteger index = NSNotFound;
+    XCTAssertEqual([array objectAtOffset:0.0 spacing:2.0 index:&index], items[0]);
+    XCTAssertEqual(index, 0);
+    XCTAssertEqual([array objectAtOffset:11.0 spacing:2.0 index:&index], items[0]);
+    XCTAssertEqual(index, 0);
+    XCTAssertEqual([array objectAtOffset:12.0 spacing:2.0 index:&index], items[1]);
+    XCTAssertEqual(index, 1);
+    XCTAssertEqual([array objectAtOffset:35.0 spacing:2.0 index:&index], items[2]);
+    XCTAssertEqual(index, 2);
+    XCTAssertNil([array objectAtOffset:36.0 spacing:2.0 index:&index]);
+    XCTAssertEqual(index, NSNotFound);
+    XCTAssertNil([array objectAtOffset:-1.0 spacing:2.0 index:&index]);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Enumeration
+// ------------------------------------------------------------------------------------------
+- (void)testEnumeration_FastEnumeration
+{
+    NSArray *items = [self p_itemsWithCount:1000];
+    GNEOutlineViewItemArray *array = [[GNEOutlineViewItemArray alloc] initWithItems:items];
+    
+    NSUInteger index = 0;
+    for (GNEOutlineViewItem *item in array)
+    {
+        XCTAssertEqual(item, items[index]);
+        index++;
+    }
+    XCTAssertEqual(index, items.count);
+}
+
+
+- (void)testEnumeration_Block
+{
+    NSArray *items = [self p_itemsWithCount:100];
+    GNEOutlineViewItemArray *array = [[GNEOutlineViewItemArray alloc] initWithItems:items];
+    
+    __block NSUInteger count = 0;
+    [array enumerateObjectsUsingBlock:^(GNEOutlineViewItem *item, NSUInteger index, BOOL *stop)
+    {
+        XCTAssertEqual(item, items[index]);
+        count++;
+        *stop = (index == 49);
+    }];
+    XCTAssertEqual(count, 50);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Lazy Items
+// ------------------------------------------------------------------------------------------
+- (void)testLazyItems_CreatedOnAccess
+{
+    GNEOutlineViewItemArray *array = [self p_lazyArrayWithCount:1000];
+    
+    XCTAssertCount(array, 1000);
+    XCTAssertEqual(array.materializedCount, 0);
+    XCTAssertFalse([array isObjectMaterializedAtIndex:500]);
+    
+    GNEOutlineViewItem *item = array[500];
+    XCTAssertNotNil(item);
+    XCTAssertEqual(item.parentItem, self.parentItem);
+    XCTAssertEqual(array.materializedCount, 1);
+    XCTAssertTrue([array isObjectMaterializedAtIndex:500]);
+    XCTAssertItemIndex(array, item, 500);
+    XCTAssertEqual(array[500], item);
+}
+
+
+- (void)testLazyItems_HeightsDoNotCreateItems
+{
+    GNEOutlineViewItemArray *array = [self p_lazyArrayWithCount:100];
+    [array setHeightsUsingBlock:^CGFloat(GNEOutlineViewItem *item, NSUInteger index __unused)
+    {
+        XCTAssertNil(item);
+        return 2.0;
+    }];
+    
+    XCTAssertEqual(array.totalHeight, 200.0);
+    XCTAssertEqual([array offsetOfObjectAtIndex:10], 20.0);
+    XCTAssertEqual(array.materializedCount, 0);
+    
+    NSUInteger index = NSNotFound;
+    XCTAssertNotNil([array objectAtOffset:41.0 spacing:0.0 index:&index]);
+    XCTAssertEqual(index, 20);
+    XCTAssertEqual(array.materializedCount, 1);
+}
+
+
+- (void)testLazyItems_Recycle
+{
+    GNEOutlineViewItemArray *array = [self p_lazyArrayWithCount:10];
+    [array setHeight:5.0 forObjectAtIndex:3];
+    GNEOutlineViewItem *item = array[3];
+    XCTAssertEqual([array allObjects].count, 10);
+    XCTAssertEqual(array.materializedCount, 10);
+    
+    [array recycleObjectsInRange:NSMakeRange(2, 5)];
+    XCTAssertEqual(array.materializedCount, 5);
+    XCTAssertEqual([array indexOfObject:item], NSNotFound);
+    XCTAssertTrue(item.arrayNode == NULL);
+    XCTAssertEqual([array heightOfObjectAtIndex:3], 5.0);
+    
+    GNEOutlineViewItem *newItem = array[3];
+    XCTAssertNotEqual(newItem, item);
+    XCTAssertItemIndex(array, newItem, 3);
+    XCTAssertThrows([array recycleObjectsInRange:NSMakeRange(8, 3)]);
+}
+
+
+- (void)testLazyItems_RecycleWithoutItemProviderDoesNothing
+{
+    NSArray *items = [self p_itemsWithCount:10];
+    GNEOutlineViewItemArray *array = [[GNEOutlineViewItemArray alloc] initWithItems:items];
+    [array recycleObjectsInRange:NSMakeRange(0, 10)];
+    XCTAssertEqual(array.materializedCount, 10);
+    XCTAssertEqualObjects([array allObjects], items);
+}
+
+
+- (void)testLazyItems_MaterializedCountInRange
+{
+    GNEOutlineViewItemArray *array = [self p_lazyArrayWithCount:100];
+    for (NSUInteger index = 20; index < 40; index++)
+    {
+        (void)array[index];
+    }
+    (void)array[90];
+    XCTAssertEqual([array materializedCountInRange:NSMakeRange(0, 100)], 21);
+    XCTAssertEqual([array materializedCountInRange:NSMakeRange(30, 70)], 11);
+    XCTAssertEqual([array materializedCountInRange:NSMakeRange(40, 50)], 0);
+    
+    // The counts follow the entries when entries are inserted and removed.
+    [array insertEntriesAtIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 10)]];
+    [array removeObjectsAtIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(25, 10)]];
+    XCTAssertEqual([array materializedCountInRange:NSMakeRange(0, 30)], 5);
+    XCTAssertEqual([array materializedCountInRange:NSMakeRange(30, 70)], 11);
+    
+    [array recycleObjectsInRange:NSMakeRange(0, 35)];
+    XCTAssertEqual(array.materializedCount, 6);
+    XCTAssertEqual([array materializedCountInRange:NSMakeRange(0, 100)], 6);
+    XCTAssertThrows([array materializedCountInRange:NSMakeRange(90, 11)]);
+}
+
+
+- (void)testLazyItems_EnumerateMaterializedObjects
+{
+    GNEOutlineViewItemArray *array = [self p_lazyArrayWithCount:100];
+    GNEOutlineViewItem *first = array[10];
+    GNEOutlineViewItem *second = array[90];
+    
+    NSMutableArray *enumeratedItems = [NSMutableArray array];
+    NSMutableIndexSet *enumeratedIndexes = [NSMutableIndexSet indexSet];
+    [array enumerateMaterializedObjectsUsingBlock:^(GNEOutlineViewItem *item,
+                                                    NSUInteger index,
+                                                    BOOL *stop __unused)
+    {
+        [enumeratedItems addObject:item];
+        [enumeratedIndexes addIndex:index];
+    }];
+    
+    XCTAssertEqualObjects(enumeratedItems, (@[first, second]));
+    NSMutableIndexSet *expectedIndexes = [NSMutableIndexSet indexSetWithIndex:10];
+    [expectedIndexes addIndex:90];
+    XCTAssertEqualObjects(enumeratedIndexes, expectedIndexes);
+    XCTAssertEqual(array.materializedCount, 2);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Memory
+// ------------------------------------------------------------------------------------------
+- (void)testMemory_ItemsRetainParentItem
+{
+    GNEOutlineViewItem *item = nil;
+    __weak GNEOutlineViewParentItem *weakParentItem = nil;
+    @autoreleasepool
+    {
+        item = [self p_item];
+        weakParentItem = self.parentItem;
+        self.parentItem = nil;
+    }
+    
+    XCTAssertNotNil(weakParentItem);
+    XCTAssertEqual(item.parentItem, weakParentItem);
+}
+
+
+- (void)testMemory_PasteboardWritingDelegateComesFromParentItem
+{
+    GNEOutlineViewItem *item = [self p_item];
+    XCTAssertNil(item.pasteboardWritingDelegate);
+    
+    self.parentItem.pasteboardWritingDelegate = self;
+    XCTAssertEqual(item.pasteboardWritingDelegate, (id)self);
+    XCTAssertEqual(self.parentItem.pasteboardWritingDelegate, (id)self);
+}
+
+
+- (void)testMemory_RemovedNodesAreReused
+{
+    GNEOutlineViewItemArray *array = [self p_lazyArrayWithCount:100];
+    for (NSUInteger i = 0; i < 1000; i++)
+    {
+        [array insertObject:[self p_item] atIndex:((i * 7) % array.count)];
+        [array removeObjectAtIndex:((i * 13) % array.count)];
+    }
+    
+    XCTAssertCount(array, 100);
+    for (NSUInteger i = 0; i < array.count; i++)
+    {
+        XCTAssertItemIndex(array, array[i], i);
+    }
+    
+    [array removeAllObjects];
+    XCTAssertCount(array, 0);
+    XCTAssertEqual(array.materializedCount, 0);
+    
+    GNEOutlineViewItem *item = [self p_item];
+    [array addObject:item];
+    XCTAssertCount(array, 1);
+    XCTAssertItemIndex(array, item, 0);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Performance
+// ------------------------------------------------------------------------------------------
+/// The outline view item array used to create every outline view item up front. These measure that
+/// representation against the lazy, slab allocated one below.
+- (void)testPerformance_EagerInitialization_100000
+{
+    [self p_measureEagerInitializationWithCount:100000];
+}
+
+
+- (void)testPerformance_EagerInitialization_1000000
+{
+    [self p_measureEagerInitializationWithCount:1000000];
+}
+
+
+- (void)testPerformance_LazyInitialization_100000
+{
+    [self p_measureLazyInitializationWithCount:100000];
+}
+
+
+- (void)testPerformance_LazyInitialization_1000000
+{
+    [self p_measureLazyInitializationWithCount:1000000];
+}
+
+
+- (void)testPerformance_MaterializeAll_100000
+{
+    [self p_measureMaterializingAllObjectsWithCount:100000];
+}
+
+
+- (void)testPerformance_MaterializeAll_1000000
+{
+    [self p_measureMaterializingAllObjectsWithCount:1000000];
+}
+
+
+- (void)testPerformance_ParentItem_100000
+{
+    GNEOutlineViewItemArray *array = [self p_lazyArrayWithCount:100000];
+    NSArray *items = [array allObjects];
+    GNEOutlineViewParentItem *parentItem = self.parentItem;
+    
+    [self measureBlock:^
+    {
+        for (NSUInteger i = 0; i < 10; i++)
+        {
+            for (GNEOutlineViewItem *item in items)
+            {
+                XCTAssertEqual(item.parentItem, parentItem);
+            }
+        }
+    }];
+}
+
+
+- (void)testPerformance_IndexOfObject_1000
+{
+    [self p_measureIndexOfObjectInArrayWithCount:1000];
+}
+
+
+- (void)testPerformance_IndexOfObject_10000
+{
+    [self p_measureIndexOfObjectInArrayWithCount:10000];
+}
+
+
+- (void)testPerformance_IndexOfObject_100000
+{
+    [self p_measureIndexOfObjectInArrayWithCount:100000];
+}
+
+
+- (void)testPerformance_InsertAndRemoveInMiddle_100000
+{
+    GNEOutlineViewItemArray *array = [[GNEOutlineViewItemArray alloc] initWithItems:[self p_itemsWithCount:100000]];
+    NSArray *items = [self p_itemsWithCount:kPerformanceTestIterations];
+    
+    [self measureBlock:^
+    {
+        for (GNEOutlineViewItem *item in items)
+        {
+            NSUInteger middle = array.count / 2;
+            [array insertObject:item atIndex:middle];
+            [array removeObjectAtIndex:middle];
+        }
+    }];
+}
+
+
+- (void)testPerformance_RemoveEveryOtherObject_100000
+{
+    NSArray *items = [self p_itemsWithCount:100000];
+    NSMutableIndexSet *indexes = [NSMutableIndexSet indexSet];
+    for (NSUInteger index = 0; index < items.count; index += 2)
+    {
+        [indexes addIndex:index];
+    }
+    
+    [self measureBlock:^
+    {
+        GNEOutlineViewItemArray *array = [[GNEOutlineViewItemArray alloc] initWithItems:items];
+        [array removeObjectsAtIndexes:indexes];
+        [array insertObjects:[items objectsAtIndexes:indexes] atIndexes:indexes];
+    }];
+}
+
+
+#if GNEOutlineViewItemArray_FoundationPerformanceTestsEnabled
+- (void)testPerformance_Foundation_IndexOfObject_1000
+{
+    [self p_measureFoundationIndexOfObjectInArrayWithCount:1000];
+}
+
+
+- (void)testPerformance_Foundation_IndexOfObject_10000
+{
+    [self p_measureFoundationIndexOfObjectInArrayWithCount:10000];
+}
+
+
+- (void)testPerformance_Foundation_IndexOfObject_100000
+{
+    [self p_measureFoundationIndexOfObjectInArrayWithCount:100000];
+}
+#endif
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Helpers
+// ------------------------------------------------------------------------------------------
+- (GNEOutlineViewItem *)p_item
+{
+    return [[GNEOutlineViewItem alloc] initWithParentItem:self.parentItem];
+}
+
+
+- (GNEOutlineViewItemArray *)p_lazyArrayWithCount:(NSUInteger)count
+{
+    GNEOutlineViewParentItem *parentItem = self.parentItem;
+    
+    return [[GNEOutlineViewItemArray alloc] initWithCount:count itemProvider:^GNEOutlineViewItem *()
+    {
+        return [[GNEOutlineViewItem alloc] initWithParentItem:parentItem];
+    }];
+}
+
+
+- (NSArray *)p_itemsWithCount:(NSUInteger)count
+{
+    NSMutableArray *items = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        [items addObject:[self p_item]];
+    }
+    
+    return [items copy];
+}
+
+
+/// Measures finding the index of items spread evenly throughout an array with the specified count.
+- (void)p_measureIndexOfObjectInArrayWithCount:(NSUInteger)count
+{
+    NSArray *items = [self p_itemsWithCount:count];
+    GNEOutlineViewItemArray *array = [[GNEOutlineViewItemArray alloc] initWithItems:items];
+    
+    [self measureBlock:^
+    {
+        for (NSUInteger i = 0; i < kPerformanceTestIterations; i++)
+        {
+            NSUInteger index = (i * 7919) % count;
+            XCTAssertEqual([array indexOfObject:items[index]], index);
+        }
+    }];
+}
+
+
+/// Measures creating and destroying an outline view item array containing the specified number of
+/// outline view items, all of which are created up front.
+- (void)p_measureEagerInitializationWithCount:(NSUInteger)count
+{
+    [self measureBlock:^
+    {
+        @autoreleasepool
+        {
+            NSArray *items = [self p_itemsWithCount:count];
+            GNEOutlineViewItemArray *array = [[GNEOutlineViewItemArray alloc] initWithItems:items];
+            XCTAssertEqual(array.materializedCount, count);
+        }
+    }];
+}
+
+
+/// Measures creating and destroying an outline view item array containing the specified number of
+/// entries whose outline view items are never accessed.
+- (void)p_measureLazyInitializationWithCount:(NSUInteger)count
+{
+    [self measureBlock:^
+    {
+        @autoreleasepool
+        {
+            GNEOutlineViewItemArray *array = [self p_lazyArrayWithCount:count];
+            XCTAssertEqual(array.materializedCount, 0);
+        }
+    }];
+}
+
+
+/// Measures creating an outline view item array containing the specified number of entries and then
+/// accessing all of their outline view items.
+- (void)p_measureMaterializingAllObjectsWithCount:(NSUInteger)count
+{
+    [self measureBlock:^
+    {
+        @autoreleasepool
+        {
+            GNEOutlineViewItemArray *array = [self p_lazyArrayWithCount:count];
+            XCTAssertEqual([array allObjects].count, count);
+            XCTAssertEqual(array.materializedCount, count);
+        }
+    }];
+}
+
+
+#if GNEOutlineViewItemArray_FoundationPerformanceTestsEnabled
+- (void)p_measureFoundationIndexOfObjectInArrayWithCount:(NSUInteger)count
+{
+    NSArray *items = [self p_itemsWithCount:count];
+    NSMutableArray *array = [items mutableCopy];
+    
+    [self measureBlock:^
+    {
+        for (NSUInteger i = 0; i < kPerformanceTestIterations; i++)
+        {
+            NSUInteger index = (i * 7919) % count;
+            XCTAssertEqual([array indexOfObject:items[index]], index);
+        }
+    }];
+}
+#endif
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - GNEOutlineViewItemPasteboardWritingDelegate
+// ------------------------------------------------------------------------------------------
+- (NSIndexPath *)draggedIndexPathForOutlineViewItem:(GNEOutlineViewItem * __unused)item
+{
+    return nil;
+}
+
+
+@end
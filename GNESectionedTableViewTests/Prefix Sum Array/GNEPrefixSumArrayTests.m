@@ -0,0 +1,264 @@
+//
+//  GNEPrefixSumArrayTests.m
+//  GNESectionedTableView
+//
+//  Copyright (c) 2016 Gone East LLC. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "GNEPrefixSumArray.h"
+
+
+// ------------------------------------------------------------------------------------------
+
+
+#define XCTAssertCount(array, c) \
+    XCTAssertEqual(array.count, c)
+
+#define XCTAssertSumBeforeIndex(array, i, s) \
+    XCTAssertEqual([array sumOfValuesBeforeIndex:i], s)
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@interface GNEPrefixSumArrayTests : XCTestCase
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@implementation GNEPrefixSumArrayTests
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Initialization
+// ------------------------------------------------------------------------------------------
+- (void)testInitialization_Default
+{
+    GNEPrefixSumArray *array = [[GNEPrefixSumArray alloc] init];
+    
+    XCTAssertNotNil(array);
+    XCTAssertCount(array, 0);
+    XCTAssertEqual(array.totalSum, 0.0);
+    XCTAssertEqual([array indexOfValueContainingSum:0.0], NSNotFound);
+}
+
+
+- (void)testInitialization_Values
+{
+    CGFloat values[] = {1.0, 2.0, 3.0, 4.0, 5.0};
+    GNEPrefixSumArray *array = [GNEPrefixSumArray arrayWithValues:values count:5];
+    
+    XCTAssertCount(array, 5);
+    XCTAssertEqual(array.totalSum, 15.0);
+    for (NSUInteger i = 0; i < 5; i++)
+    {
+        XCTAssertEqual([array valueAtIndex:i], values[i]);
+    }
+    XCTAssertSumBeforeIndex(array, 0, 0.0);
+    XCTAssertSumBeforeIndex(array, 3, 6.0);
+    XCTAssertSumBeforeIndex(array, 5, 15.0);
+}
+
+
+- (void)testCopy
+{
+    CGFloat values[] = {1.0, 2.0, 3.0};
+    GNEPrefixSumArray *array = [GNEPrefixSumArray arrayWithValues:values count:3];
+    GNEPrefixSumArray *copy = [array copy];
+    [array setValue:10.0 atIndex:0];
+    
+    XCTAssertEqual(copy.totalSum, 6.0);
+    XCTAssertEqual(array.totalSum, 15.0);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Values
+// ------------------------------------------------------------------------------------------
+- (void)testSetValue
+{
+    NSUInteger count = 100;
+    CGFloat values[100];
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        values[i] = 1.0;
+    }
+    GNEPrefixSumArray *array = [GNEPrefixSumArray arrayWithValues:values count:count];
+    
+    [array setValue:11.0 atIndex:50];
+    XCTAssertEqual([array valueAtIndex:50], 11.0);
+    XCTAssertSumBeforeIndex(array, 50, 50.0);
+    XCTAssertSumBeforeIndex(array, 51, 61.0);
+    XCTAssertEqual(array.totalSum, 110.0);
+    
+    [array setValue:0.0 atIndex:0];
+    XCTAssertSumBeforeIndex(array, 1, 0.0);
+    XCTAssertSumBeforeIndex(array, 51, 60.0);
+}
+
+
+- (void)testValues_BeyondBounds
+{
+    CGFloat values[] = {1.0, 2.0};
+    GNEPrefixSumArray *array = [GNEPrefixSumArray arrayWithValues:values count:2];
+    
+    XCTAssertThrows([array valueAtIndex:2]);
+    XCTAssertThrows([array setValue:1.0 atIndex:2]);
+    XCTAssertThrows([array sumOfValuesBeforeIndex:3]);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Adding/Removing Values
+// ------------------------------------------------------------------------------------------
+- (void)testInsertValues
+{
+    CGFloat values[] = {1.0, 2.0, 3.0, 4.0};
+    GNEPrefixSumArray *array = [GNEPrefixSumArray arrayWithValues:values count:4];
+    NSMutableIndexSet *indexes = [NSMutableIndexSet indexSetWithIndex:0];
+    [indexes addIndex:3];
+    [indexes addIndex:6];
+    CGFloat insertedValues[] = {10.0, 20.0, 30.0};
+    
+    [array insertValues:insertedValues atIndexes:indexes];
+    
+    CGFloat expectedValues[] = {10.0, 1.0, 2.0, 20.0, 3.0, 4.0, 30.0};
+    [self p_assertArray:array containsValues:expectedValues count:7];
+}
+
+
+- (void)testRemoveValues
+{
+    CGFloat values[] = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0};
+    GNEPrefixSumArray *array = [GNEPrefixSumArray arrayWithValues:values count:7];
+    NSMutableIndexSet *indexes = [NSMutableIndexSet indexSetWithIndexesInRange:NSMakeRange(1, 2)];
+    [indexes addIndex:6];
+    
+    [array removeValuesAtIndexes:indexes];
+    
+    CGFloat expectedValues[] = {1.0, 4.0, 5.0, 6.0};
+    [self p_assertArray:array containsValues:expectedValues count:4];
+}
+
+
+- (void)testInsertAndRemoveValues_MatchArrayBuiltFromValues
+{
+    NSUInteger count = 1000;
+    NSMutableArray *expectedValues = [NSMutableArray arrayWithCapacity:count];
+    CGFloat *values = calloc(count, sizeof(CGFloat));
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        values[i] = (CGFloat)(i % 7);
+        [expectedValues addObject:@(values[i])];
+    }
+    GNEPrefixSumArray *array = [GNEPrefixSumArray arrayWithValues:values count:count];
+    free(values);
+    
+    for (NSUInteger i = 0; i < 50; i++)
+    {
+        NSUInteger index = (i * 37) % expectedValues.count;
+        CGFloat value = (CGFloat)(i % 3);
+        [array insertValues:&value atIndexes:[NSIndexSet indexSetWithIndex:index]];
+        [expectedValues insertObject:@(value) atIndex:index];
+        
+        NSIndexSet *removedIndexes = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange((i * 53) % 900, 2)];
+        [array removeValuesAtIndexes:removedIndexes];
+        [expectedValues removeObjectsAtIndexes:removedIndexes];
+    }
+    
+    CGFloat *finalValues = calloc(expectedValues.count, sizeof(CGFloat));
+    for (NSUInteger i = 0; i < expectedValues.count; i++)
+    {
+        finalValues[i] = [expectedValues[i] doubleValue];
+    }
+    [self p_assertArray:array containsValues:finalValues count:expectedValues.count];
+    free(finalValues);
+}
+
+
+- (void)testInsertAndRemoveValues_BeyondBounds
+{
+    CGFloat values[] = {1.0, 2.0};
+    GNEPrefixSumArray *array = [GNEPrefixSumArray arrayWithValues:values count:2];
+    CGFloat insertedValue = 3.0;
+    
+    XCTAssertThrows([array insertValues:&insertedValue atIndexes:[NSIndexSet indexSetWithIndex:3]]);
+    XCTAssertThrows([array removeValuesAtIndexes:[NSIndexSet indexSetWithIndex:2]]);
+    XCTAssertCount(array, 2);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Sums
+// ------------------------------------------------------------------------------------------
+- (void)testIndexOfValueContainingSum
+{
+    CGFloat values[] = {10.0, 0.0, 5.0, 20.0};
+    GNEPrefixSumArray *array = [GNEPrefixSumArray arrayWithValues:values count:4];
+    
+    XCTAssertEqual([array indexOfValueContainingSum:-1.0], NSNotFound);
+    XCTAssertEqual([array indexOfValueContainingSum:0.0], 0);
+    XCTAssertEqual([array indexOfValueContainingSum:9.5], 0);
+    XCTAssertEqual([array indexOfValueContainingSum:10.0], 2);
+    XCTAssertEqual([array indexOfValueContainingSum:14.0], 2);
+    XCTAssertEqual([array indexOfValueContainingSum:15.0], 3);
+    XCTAssertEqual([array indexOfValueContainingSum:34.0], 3);
+    XCTAssertEqual([array indexOfValueContainingSum:35.0], NSNotFound);
+}
+
+
+- (void)testIndexOfValueContainingSum_AfterSettingValues
+{
+    NSUInteger count = 1000;
+    CGFloat *values = calloc(count, sizeof(CGFloat));
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        values[i] = (CGFloat)(i % 7);
+    }
+    GNEPrefixSumArray *array = [GNEPrefixSumArray arrayWithValues:values count:count];
+    for (NSUInteger i = 0; i < count; i += 3)
+    {
+        values[i] = (CGFloat)(i % 5);
+        [array setValue:values[i] atIndex:i];
+    }
+    
+    CGFloat sum = 0.0;
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        XCTAssertSumBeforeIndex(array, i, sum);
+        if (values[i] > 0.0)
+        {
+            XCTAssertEqual([array indexOfValueContainingSum:sum], i);
+            XCTAssertEqual([array indexOfValueContainingSum:(sum + values[i] - 0.5)], i);
+        }
+        sum += values[i];
+    }
+    XCTAssertEqual(array.totalSum, sum);
+    
+    free(values);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Helpers
+// ------------------------------------------------------------------------------------------
+- (void)p_assertArray:(GNEPrefixSumArray *)array containsValues:(const CGFloat *)values count:(NSUInteger)count
+{
+    XCTAssertCount(array, count);
+    
+    CGFloat sum = 0.0;
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        XCTAssertEqual([array valueAtIndex:i], values[i]);
+        XCTAssertSumBeforeIndex(array, i, sum);
+        sum += values[i];
+    }
+    XCTAssertEqual(array.totalSum, sum);
+}
+
+
+@end
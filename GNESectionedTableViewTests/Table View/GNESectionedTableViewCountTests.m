@@ -65,6 +65,28 @@
 }
 
 
+- (void)testSectionCount_InsertAndDelete
+{
+    XCTSetNumberOfSections(3);
+    [self setRowCount:1 forNumberOfSections:4];
+    [self.tableView reloadData];
+    XCTAssertNumberOfSections(3);
+    [self assertHeadersMatchSectionsInTableView];
+
+    XCTSetNumberOfSections(4);
+    [self.tableView insertSections:[NSIndexSet indexSetWithIndex:1] withAnimation:NSTableViewAnimationEffectNone];
+    XCTAssertNumberOfSections(4);
+    [self assertHeadersMatchSectionsInTableView];
+
+    XCTSetNumberOfSections(2);
+    NSMutableIndexSet *deletedSections = [NSMutableIndexSet indexSetWithIndex:0];
+    [deletedSections addIndex:2];
+    [self.tableView deleteSections:deletedSections withAnimation:NSTableViewAnimationEffectNone];
+    XCTAssertNumberOfSections(2);
+    [self assertHeadersMatchSectionsInTableView];
+}
+
+
 // ------------------------------------------------------------------------------------------
 #pragma mark - Rows
 // ------------------------------------------------------------------------------------------
@@ -107,6 +129,19 @@
 // ------------------------------------------------------------------------------------------
 #pragma mark - Helpers
 // ------------------------------------------------------------------------------------------
+- (void)assertHeadersMatchSectionsInTableView
+{
+    NSUInteger sectionCount = self.tableView.numberOfSections;
+    for (NSUInteger section = 0; section < sectionCount; section++)
+    {
+        NSIndexPath *headerIndexPath = [self.tableView indexPathForHeaderInSection:section];
+        NSInteger tableViewRow = [self.tableView tableViewRowForIndexPath:headerIndexPath];
+        XCTAssertGreaterThanOrEqual(tableViewRow, 0);
+        XCTAssertEqualObjects([self.tableView indexPathForTableViewRow:tableViewRow], headerIndexPath);
+    }
+}
+
+
 - (void)setRowCount:(NSUInteger)rowCount forNumberOfSections:(NSUInteger)numberOfSections
 {
     NSMutableArray *rows = [NSMutableArray array];
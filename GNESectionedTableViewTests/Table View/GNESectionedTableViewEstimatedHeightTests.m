@@ -0,0 +1,159 @@
+//
+//  GNESectionedTableViewEstimatedHeightTests.m
+//  GNESectionedTableView
+//
+//  Copyright (c) 2016 Gone East LLC. All rights reserved.
+//
+
+#import "GNESectionedTableViewTests.h"
+
+
+// ------------------------------------------------------------------------------------------
+
+
+static const CGFloat kEstimatedRowHeight = 20.0;
+static const CGFloat kRowHeight = 10.0;
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@interface GNESectionedTableViewEstimatedHeightTests : GNESectionedTableViewTests
+
+/// Rows the delegate was asked for the actual heights of.
+@property (nonatomic, strong) NSMutableIndexSet *measuredRows;
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@implementation GNESectionedTableViewEstimatedHeightTests
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Set Up & Tear Down
+// ------------------------------------------------------------------------------------------
+- (void)setUp
+{
+    [super setUp];
+
+    self.measuredRows = [NSMutableIndexSet indexSet];
+
+    __weak typeof(self) weakSelf = self;
+    MockHeightForRowBlock heightBlock = ^CGFloat(NSIndexPath *indexPath)
+    {
+        [weakSelf.measuredRows addIndex:indexPath.gne_row];
+
+        return kRowHeight;
+    };
+    [self.delegate setBlock:(__bridge void *)[heightBlock copy]
+                forSelector:@selector(tableView:heightForRowAtIndexPath:)];
+
+    MockHeightForSectionBlock estimateBlock = ^CGFloat(NSUInteger __unused section)
+    {
+        return kEstimatedRowHeight;
+    };
+    [self.delegate setBlock:(__bridge void *)[estimateBlock copy]
+                forSelector:@selector(tableView:estimatedHeightForRowsInSection:)];
+
+    [self setUpScrollView];
+    [self runRunLoop];
+}
+
+
+- (void)tearDown
+{
+    self.measuredRows = nil;
+
+    [super tearDown];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Tests
+// ------------------------------------------------------------------------------------------
+- (void)testEstimatedHeights_OnlyRowsNearVisibleRowsAreMeasured
+{
+    XCTAssertTrue([self.measuredRows containsIndex:0]);
+    XCTAssertTrue([self.measuredRows containsIndex:[self lastVisibleIndexPath].gne_row]);
+    XCTAssertLessThan(self.measuredRows.count, 100u);
+
+    XCTAssertHeightOfRow([NSIndexPath gne_indexPathForRow:0 inSection:0], kRowHeight);
+    XCTAssertHeightOfRow([NSIndexPath gne_indexPathForRow:999 inSection:0], kEstimatedRowHeight);
+}
+
+
+- (void)testEstimatedHeights_ScrollingMeasuresRowsWithoutMovingTopmostVisibleRow
+{
+    [self.tableView scrollPoint:CGPointMake(0.0, 5005.0)];
+    NSIndexPath *anchorIndexPath = [self firstVisibleIndexPath];
+    CGFloat anchorOffset = [self anchorOffsetOfIndexPath:anchorIndexPath];
+    XCTAssertFalse([self.measuredRows containsIndex:anchorIndexPath.gne_row]);
+
+    [self runRunLoop];
+
+    XCTAssertTrue([self.measuredRows containsIndex:anchorIndexPath.gne_row]);
+    XCTAssertHeightOfRow(anchorIndexPath, kRowHeight);
+    XCTAssertEqualObjects([self firstVisibleIndexPath], anchorIndexPath);
+    XCTAssertEqual([self anchorOffsetOfIndexPath:anchorIndexPath], anchorOffset);
+}
+
+
+- (void)testEstimatedHeights_ClickingRowDoesNotStopMeasuringRowsScrolledIntoView
+{
+    [self.tableView scrollPoint:CGPointMake(0.0, 5005.0)];
+    [self performClickActionForRow:(NSInteger)[self.tableView rowsInRect:self.tableView.visibleRect].location];
+    [self runRunLoop];
+
+    XCTAssertTrue([self.measuredRows containsIndex:[self firstVisibleIndexPath].gne_row]);
+
+    [self.tableView scrollPoint:CGPointMake(0.0, 10005.0)];
+    [self runRunLoop];
+
+    XCTAssertTrue([self.measuredRows containsIndex:[self firstVisibleIndexPath].gne_row]);
+    XCTAssertTrue([self.measuredRows containsIndex:[self lastVisibleIndexPath].gne_row]);
+}
+
+
+- (void)testEstimatedHeights_ScrollingToRowMeasuresIt
+{
+    NSIndexPath *indexPath = [NSIndexPath gne_indexPathForRow:900 inSection:0];
+
+    [self.tableView scrollRowAtIndexPathToVisible:indexPath];
+
+    XCTAssertTrue([self.measuredRows containsIndex:900]);
+    XCTAssertHeightOfRow(indexPath, kRowHeight);
+    CGRect frame = [self.tableView frameOfViewAtIndexPath:indexPath];
+    XCTAssertTrue(CGRectContainsRect(self.tableView.visibleRect, frame));
+}
+
+
+- (void)testEstimatedHeights_InsertedRowsAreEstimatedUntilTheyAreNearVisibleRows
+{
+    XCTSetNumberOfRowsInSections(@[@1001]);
+    [self.tableView insertRowsAtIndexPaths:@[[NSIndexPath gne_indexPathForRow:1000 inSection:0]]
+                             withAnimation:NSTableViewAnimationEffectNone];
+    [self runRunLoop];
+
+    XCTAssertFalse([self.measuredRows containsIndex:1000]);
+    XCTAssertHeightOfRow([NSIndexPath gne_indexPathForRow:1000 inSection:0], kEstimatedRowHeight);
+
+    [self.tableView scrollRowAtIndexPathToVisible:[NSIndexPath gne_indexPathForRow:1000 inSection:0]];
+
+    XCTAssertHeightOfRow([NSIndexPath gne_indexPathForRow:1000 inSection:0], kRowHeight);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Helpers
+// ------------------------------------------------------------------------------------------
+/// Returns the distance from the top of the visible rect to the top of the row at the specified index path.
+- (CGFloat)anchorOffsetOfIndexPath:(NSIndexPath *)indexPath
+{
+    return self.tableView.visibleRect.origin.y - [self.tableView frameOfViewAtIndexPath:indexPath].origin.y;
+}
+
+
+@end
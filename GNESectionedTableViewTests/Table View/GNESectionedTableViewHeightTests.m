@@ -158,4 +158,440 @@
 }
 
 
+- (void)testFrameOfViewAtIndexPath_Offsets
+{
+    [self p_setUpTwoSectionsWithTwoRowsEach];
+
+    XCTAssertEqual([self.tableView frameOfViewAtIndexPath:[self.tableView indexPathForHeaderInSection:0]].origin.y, 0.0);
+    XCTAssertEqual([self.tableView frameOfViewAtIndexPath:[NSIndexPath gne_indexPathForRow:0 inSection:0]].origin.y, 10.0);
+    XCTAssertEqual([self.tableView frameOfViewAtIndexPath:[NSIndexPath gne_indexPathForRow:1 inSection:0]].origin.y, 40.0);
+    XCTAssertEqual([self.tableView frameOfViewAtIndexPath:[self.tableView indexPathForHeaderInSection:1]].origin.y, 70.0);
+    XCTAssertEqual([self.tableView frameOfViewAtIndexPath:[NSIndexPath gne_indexPathForRow:0 inSection:1]].origin.y, 90.0);
+    XCTAssertEqual([self.tableView frameOfViewAtIndexPath:[NSIndexPath gne_indexPathForRow:1 inSection:1]].origin.y, 130.0);
+
+    CGRect sectionFrame = [self.tableView frameOfSection:1];
+    XCTAssertEqual(sectionFrame.origin.y, 70.0);
+    XCTAssertEqual(sectionFrame.size.height, 100.0);
+}
+
+
+- (void)testFrameOfViewAtIndexPath_CollapsedSection
+{
+    [self p_setUpTwoSectionsWithTwoRowsEach];
+    [self.tableView collapseSection:0 animated:NO];
+
+    XCTAssertTrue(CGRectEqualToRect([self.tableView frameOfViewAtIndexPath:[NSIndexPath gne_indexPathForRow:0
+                                                                                                  inSection:0]],
+                                    CGRectZero));
+    XCTAssertEqual([self.tableView frameOfSection:0].size.height, 10.0);
+    XCTAssertEqual([self.tableView frameOfViewAtIndexPath:[self.tableView indexPathForHeaderInSection:1]].origin.y, 10.0);
+
+    [self.tableView expandSection:0 animated:NO];
+    XCTAssertEqual([self.tableView frameOfViewAtIndexPath:[self.tableView indexPathForHeaderInSection:1]].origin.y, 70.0);
+}
+
+
+- (void)testFrameOfViewAtIndexPath_InsertAndDeleteRows
+{
+    [self p_setUpTwoSectionsWithTwoRowsEach];
+
+    XCTSetNumberOfRowsInSections((@[@3, @2]));
+    [self.tableView insertRowsAtIndexPaths:@[[NSIndexPath gne_indexPathForRow:0 inSection:0]]
+                             withAnimation:NSTableViewAnimationEffectNone];
+    XCTAssertEqual([self.tableView frameOfViewAtIndexPath:[self.tableView indexPathForHeaderInSection:1]].origin.y, 100.0);
+
+    XCTSetNumberOfRowsInSections((@[@3, @1]));
+    [self.tableView deleteRowsAtIndexPaths:@[[NSIndexPath gne_indexPathForRow:0 inSection:1]]
+                             withAnimation:NSTableViewAnimationEffectNone];
+    XCTAssertEqual([self.tableView frameOfSection:1].size.height, 60.0);
+}
+
+
+- (void)testIndexPathForViewAtPoint
+{
+    [self p_setUpTwoSectionsWithTwoRowsEach];
+
+    XCTAssertEqualObjects([self.tableView indexPathForViewAtPoint:CGPointMake(1.0, 5.0)],
+                          [self.tableView indexPathForHeaderInSection:0]);
+    XCTAssertEqualObjects([self.tableView indexPathForViewAtPoint:CGPointMake(1.0, 45.0)],
+                          [NSIndexPath gne_indexPathForRow:1 inSection:0]);
+    XCTAssertEqualObjects([self.tableView indexPathForViewAtPoint:CGPointMake(1.0, 70.0)],
+                          [self.tableView indexPathForHeaderInSection:1]);
+    XCTAssertEqualObjects([self.tableView indexPathForViewAtPoint:CGPointMake(1.0, 169.0)],
+                          [NSIndexPath gne_indexPathForRow:1 inSection:1]);
+    XCTAssertNil([self.tableView indexPathForViewAtPoint:CGPointMake(1.0, 170.0)]);
+}
+
+
+- (void)testNoteHeightOfRowsAtIndexPathsChanged
+{
+    [self p_setUpTwoSectionsWithTwoRowsEach];
+
+    NSIndexPath *indexPath = [NSIndexPath gne_indexPathForRow:0 inSection:0];
+    XCTSetHeightOfRow(indexPath, 50.0);
+    [self.tableView noteHeightOfRowsAtIndexPathsChanged:@[indexPath]];
+
+    XCTAssertHeightOfRow(indexPath, 50.0);
+    XCTAssertEqual([self.tableView frameOfViewAtIndexPath:[self.tableView indexPathForHeaderInSection:1]].origin.y, 90.0);
+}
+
+
+- (void)testHeightOfRows_UniformHeight
+{
+    XCTSetNumberOfSections(2);
+    XCTSetNumberOfRowsInSections((@[@3, @2]));
+
+    MockHeightForSectionBlock uniformBlock = ^CGFloat(NSUInteger section)
+    {
+        return (section == 0) ? 25.0 : GNESectionedTableViewNonUniformRowHeight;
+    };
+    [self.delegate setBlock:(__bridge void *)[uniformBlock copy]
+                forSelector:@selector(tableView:uniformHeightForRowsInSection:)];
+
+    MockHeightForRowBlock rowBlock = ^CGFloat(NSIndexPath *indexPath)
+    {
+        return (indexPath.gne_section == 1) ? 40.0 : 0.0;
+    };
+    [self.delegate setBlock:(__bridge void *)[rowBlock copy]
+                forSelector:@selector(tableView:heightForRowAtIndexPath:)];
+
+    [self.tableView reloadData];
+
+    XCTAssertHeightOfRow([NSIndexPath gne_indexPathForRow:2 inSection:0], 25.0);
+    XCTAssertHeightOfRow([NSIndexPath gne_indexPathForRow:1 inSection:1], 40.0);
+}
+
+
+- (void)testHeightOfRows_UniformHeightIsRequestedOncePerSection
+{
+    XCTSetNumberOfSections(3);
+    XCTSetNumberOfRowsInSections((@[@3, @2, @4]));
+    [self p_setUpRowHeightMeasuringBlock];
+    
+    __block NSUInteger callCount = 0;
+    MockHeightForSectionBlock uniformBlock = ^CGFloat(NSUInteger __unused section)
+    {
+        callCount++;
+        return 25.0;
+    };
+    [self.delegate setBlock:(__bridge void *)[uniformBlock copy]
+                forSelector:@selector(tableView:uniformHeightForRowsInSection:)];
+    
+    [self.tableView reloadData];
+    
+    XCTAssertEqual(callCount, 3u);
+    XCTAssertHeightOfRow([NSIndexPath gne_indexPathForRow:3 inSection:2], 25.0);
+}
+
+
+- (void)testHeightOfRows_BulkHeights
+{
+    XCTSetNumberOfSections(1);
+    XCTSetNumberOfRowsInSections(@[@100]);
+
+    __block NSUInteger callCount = 0;
+    __block NSRange lastRange = NSMakeRange(NSNotFound, 0);
+    MockGetHeightsForRowsBlock heightsBlock = ^(CGFloat *heights, NSRange range, NSUInteger section __unused)
+    {
+        callCount++;
+        lastRange = range;
+        for (NSUInteger i = 0; i < range.length; i++)
+        {
+            heights[i] = (CGFloat)(range.location + i + 1);
+        }
+    };
+    [self.delegate setBlock:(__bridge void *)[heightsBlock copy]
+                forSelector:@selector(tableView:getHeights:forRowsInRange:inSection:)];
+
+    [self.tableView reloadData];
+
+    XCTAssertEqual(callCount, 1);
+    XCTAssertTrue(NSEqualRanges(lastRange, NSMakeRange(0, 100)));
+    XCTAssertHeightOfRow([NSIndexPath gne_indexPathForRow:49 inSection:0], 50.0);
+
+    callCount = 0;
+    XCTSetNumberOfRowsInSections(@[@102]);
+    NSArray *indexPaths = @[[NSIndexPath gne_indexPathForRow:10 inSection:0],
+                            [NSIndexPath gne_indexPathForRow:11 inSection:0]];
+    [self.tableView insertRowsAtIndexPaths:indexPaths withAnimation:NSTableViewAnimationEffectNone];
+
+    XCTAssertEqual(callCount, 1);
+    XCTAssertTrue(NSEqualRanges(lastRange, NSMakeRange(10, 2)));
+    XCTAssertHeightOfRow([NSIndexPath gne_indexPathForRow:11 inSection:0], 12.0);
+}
+
+
+- (void)testHeightOfRows_BulkHeightsAreUsedInsteadOfHeightOfEachRow
+{
+    XCTSetNumberOfSections(1);
+    XCTSetNumberOfRowsInSections(@[@10]);
+
+    __block NSUInteger rowCallCount = 0;
+    MockHeightForRowBlock rowBlock = ^CGFloat(NSIndexPath * __unused indexPath)
+    {
+        rowCallCount++;
+        return 0.0;
+    };
+    [self.delegate setBlock:(__bridge void *)[rowBlock copy]
+                forSelector:@selector(tableView:heightForRowAtIndexPath:)];
+
+    MockGetHeightsForRowsBlock heightsBlock = ^(CGFloat *heights, NSRange range, NSUInteger section __unused)
+    {
+        for (NSUInteger i = 0; i < range.length; i++)
+        {
+            heights[i] = 30.0;
+        }
+    };
+    [self.delegate setBlock:(__bridge void *)[heightsBlock copy]
+                forSelector:@selector(tableView:getHeights:forRowsInRange:inSection:)];
+
+    [self.tableView reloadData];
+
+    XCTAssertEqual(rowCallCount, 0u);
+    XCTAssertHeightOfRow([NSIndexPath gne_indexPathForRow:9 inSection:0], 30.0);
+}
+
+
+- (void)testHeightOfRows_HeightOfEachRowIsRequestedWithoutBulkHeights
+{
+    XCTSetNumberOfSections(2);
+    XCTSetNumberOfRowsInSections((@[@3, @2]));
+    XCTAssertFalse([self.delegate respondsToSelector:@selector(tableView:uniformHeightForRowsInSection:)]);
+    XCTAssertFalse([self.delegate respondsToSelector:@selector(tableView:getHeights:forRowsInRange:inSection:)]);
+
+    NSMutableSet *requestedIndexPaths = [NSMutableSet set];
+    MockHeightForRowBlock rowBlock = ^CGFloat(NSIndexPath *indexPath)
+    {
+        [requestedIndexPaths addObject:indexPath];
+        return (CGFloat)(10 * (indexPath.gne_section + 1) + indexPath.gne_row);
+    };
+    [self.delegate setBlock:(__bridge void *)[rowBlock copy]
+                forSelector:@selector(tableView:heightForRowAtIndexPath:)];
+
+    [self.tableView reloadData];
+
+    XCTAssertEqual(requestedIndexPaths.count, 5u);
+    XCTAssertHeightOfRow([NSIndexPath gne_indexPathForRow:2 inSection:0], 12.0);
+    XCTAssertHeightOfRow([NSIndexPath gne_indexPathForRow:1 inSection:1], 21.0);
+}
+
+
+- (void)testHeightOfRows_AsynchronousHeightsUseEstimatesUntilMeasured
+{
+    XCTSetNumberOfSections(1);
+    XCTSetNumberOfRowsInSections(@[@3]);
+    [self p_setUpRowHeightMeasuringBlock];
+    self.tableView.estimatedRowHeight = 20.0;
+    [self.tableView reloadData];
+    
+    for (NSUInteger row = 0; row < 3; row++)
+    {
+        XCTAssertHeightOfRow([NSIndexPath gne_indexPathForRow:row inSection:0], 20.0);
+    }
+    
+    [self p_waitForHeight:12.0 ofRowAtIndexPath:[NSIndexPath gne_indexPathForRow:2 inSection:0]];
+    for (NSUInteger row = 0; row < 3; row++)
+    {
+        XCTAssertHeightOfRow([NSIndexPath gne_indexPathForRow:row inSection:0], 10.0 + row);
+    }
+}
+
+
+- (void)testHeightOfRows_SectionedEstimatedHeightsArePreferred
+{
+    XCTSetNumberOfSections(1);
+    XCTSetNumberOfRowsInSections(@[@3]);
+    XCTSetHeightOfRow([NSIndexPath gne_indexPathForRow:0 inSection:0], 10.0);
+    
+    MockHeightForSectionedRowBlock sectionedEstimateBlock = ^CGFloat(GNESectionedIndexPath indexPath)
+    {
+        return 20.0 + (CGFloat)indexPath.row;
+    };
+    [self.delegate setBlock:(__bridge void *)[sectionedEstimateBlock copy]
+                forSelector:@selector(tableView:estimatedHeightForRowAtSectionedIndexPath:)];
+    
+    __block NSUInteger callCount = 0;
+    MockHeightForRowBlock estimateBlock = ^CGFloat(NSIndexPath * __unused indexPath)
+    {
+        callCount++;
+        return 30.0;
+    };
+    [self.delegate setBlock:(__bridge void *)[estimateBlock copy]
+                forSelector:@selector(tableView:estimatedHeightForRowAtIndexPath:)];
+    
+    [self.tableView reloadData];
+    
+    XCTAssertEqual(callCount, 0u);
+    for (NSUInteger row = 0; row < 3; row++)
+    {
+        XCTAssertHeightOfRow([NSIndexPath gne_indexPathForRow:row inSection:0], 20.0 + row);
+    }
+}
+
+
+- (void)testHeightOfRows_AsynchronousHeightsOfShiftedRowsAreMeasuredAgain
+{
+    __block NSUInteger rowCount = 3;
+    MockNumberOfRowsBlock rowsBlock = ^NSUInteger(NSUInteger __unused section)
+    {
+        return rowCount;
+    };
+    [self.dataSource setBlock:(__bridge void *)[rowsBlock copy]
+                  forSelector:@selector(tableView:numberOfRowsInSection:)];
+    XCTSetNumberOfSections(1);
+    [self p_setUpRowHeightMeasuringBlock];
+    self.tableView.estimatedRowHeight = 20.0;
+    [self.tableView reloadData];
+    
+    // Inserting a row before the measurement is committed shifts the rows that are being measured.
+    rowCount = 4;
+    [self.tableView insertRowsAtIndexPaths:@[[NSIndexPath gne_indexPathForRow:0 inSection:0]]
+                             withAnimation:NSTableViewAnimationEffectNone];
+    
+    [self p_waitForHeight:13.0 ofRowAtIndexPath:[NSIndexPath gne_indexPathForRow:3 inSection:0]];
+    for (NSUInteger row = 0; row < 4; row++)
+    {
+        XCTAssertHeightOfRow([NSIndexPath gne_indexPathForRow:row inSection:0], 10.0 + row);
+    }
+}
+
+
+- (void)testHeightOfRows_AsynchronousHeightsOfRowsShiftedByRangesAreMeasuredAgain
+{
+    __block NSUInteger rowCount = 8;
+    MockNumberOfRowsBlock rowsBlock = ^NSUInteger(NSUInteger __unused section)
+    {
+        return rowCount;
+    };
+    [self.dataSource setBlock:(__bridge void *)[rowsBlock copy]
+                  forSelector:@selector(tableView:numberOfRowsInSection:)];
+    XCTSetNumberOfSections(1);
+    [self p_setUpRowHeightMeasuringBlock];
+    self.tableView.estimatedRowHeight = 20.0;
+    [self.tableView reloadData];
+    
+    // Deletes rows 1-2 and 5, then inserts rows 0-1 and 4-5, before the measurement is committed.
+    rowCount = 5;
+    [self.tableView deleteRowsAtIndexPaths:@[[NSIndexPath gne_indexPathForRow:1 inSection:0],
+                                             [NSIndexPath gne_indexPathForRow:2 inSection:0],
+                                             [NSIndexPath gne_indexPathForRow:5 inSection:0]]
+                             withAnimation:NSTableViewAnimationEffectNone];
+    rowCount = 9;
+    [self.tableView insertRowsAtIndexPaths:@[[NSIndexPath gne_indexPathForRow:0 inSection:0],
+                                             [NSIndexPath gne_indexPathForRow:1 inSection:0],
+                                             [NSIndexPath gne_indexPathForRow:4 inSection:0],
+                                             [NSIndexPath gne_indexPathForRow:5 inSection:0]]
+                             withAnimation:NSTableViewAnimationEffectNone];
+    
+    [self p_waitForHeight:18.0 ofRowAtIndexPath:[NSIndexPath gne_indexPathForRow:8 inSection:0]];
+    for (NSUInteger row = 0; row < 9; row++)
+    {
+        XCTAssertHeightOfRow([NSIndexPath gne_indexPathForRow:row inSection:0], 10.0 + row);
+    }
+}
+
+
+- (void)testHeightOfRows_AsynchronousHeightsAreCommittedAtRowsShiftedDuringTheMeasurement
+{
+    __block NSUInteger rowCount = 3;
+    MockNumberOfRowsBlock rowsBlock = ^NSUInteger(NSUInteger __unused section)
+    {
+        return rowCount;
+    };
+    [self.dataSource setBlock:(__bridge void *)[rowsBlock copy]
+                  forSelector:@selector(tableView:numberOfRowsInSection:)];
+    XCTSetNumberOfSections(1);
+    
+    // The measurement waits until the rows have been changed.
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    NSMutableArray *measuredRows = [NSMutableArray array];
+    GNESectionedTableViewRowHeightMeasuringBlock measuringBlock = ^CGFloat(GNESectionedIndexPath indexPath,
+                                                                           CGFloat __unused width)
+    {
+        dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+        dispatch_semaphore_signal(semaphore);
+        @synchronized(measuredRows)
+        {
+            [measuredRows addObject:@(indexPath.row)];
+        }
+        
+        return 10.0 + (CGFloat)indexPath.row;
+    };
+    [self.delegate setBlock:(__bridge void *)[measuringBlock copy]
+                forSelector:@selector(rowHeightMeasuringBlockForTableView:)];
+    self.tableView.estimatedRowHeight = 20.0;
+    [self.tableView reloadData];
+    [self runRunLoop];
+    
+    // Deletes row 1 and inserts row 0 while rows 0-2 are being measured.
+    rowCount = 2;
+    [self.tableView deleteRowsAtIndexPaths:@[[NSIndexPath gne_indexPathForRow:1 inSection:0]]
+                             withAnimation:NSTableViewAnimationEffectNone];
+    rowCount = 3;
+    [self.tableView insertRowsAtIndexPaths:@[[NSIndexPath gne_indexPathForRow:0 inSection:0]]
+                             withAnimation:NSTableViewAnimationEffectNone];
+    dispatch_semaphore_signal(semaphore);
+    
+    [self p_waitForHeight:12.0 ofRowAtIndexPath:[NSIndexPath gne_indexPathForRow:2 inSection:0]];
+    [self p_waitForHeight:10.0 ofRowAtIndexPath:[NSIndexPath gne_indexPathForRow:0 inSection:0]];
+    
+    // Former rows 0 and 2 keep the heights measured before they were shifted; only the new row is measured.
+    XCTAssertHeightOfRow([NSIndexPath gne_indexPathForRow:0 inSection:0], 10.0);
+    XCTAssertHeightOfRow([NSIndexPath gne_indexPathForRow:1 inSection:0], 10.0);
+    XCTAssertHeightOfRow([NSIndexPath gne_indexPathForRow:2 inSection:0], 12.0);
+    @synchronized(measuredRows)
+    {
+        XCTAssertEqual(measuredRows.count, 4u);
+    }
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Helpers
+// ------------------------------------------------------------------------------------------
+/// Makes the delegate measure rows on background queues. The height of each row is 10.0 + its row.
+- (void)p_setUpRowHeightMeasuringBlock
+{
+    GNESectionedTableViewRowHeightMeasuringBlock measuringBlock = ^CGFloat(GNESectionedIndexPath indexPath,
+                                                                           CGFloat __unused width)
+    {
+        return 10.0 + (CGFloat)indexPath.row;
+    };
+    [self.delegate setBlock:(__bridge void *)[measuringBlock copy]
+                forSelector:@selector(rowHeightMeasuringBlockForTableView:)];
+}
+
+
+/// Runs the main run loop until the row at the specified index path has the specified height or a
+/// couple of seconds have passed.
+- (void)p_waitForHeight:(CGFloat)height ofRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    NSDate *timeout = [NSDate dateWithTimeIntervalSinceNow:2.0];
+    while ([self.tableView frameOfViewAtIndexPath:indexPath].size.height != height &&
+           [timeout timeIntervalSinceNow] > 0.0)
+    {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+    }
+}
+
+
+/// Sets up two sections with header heights of 10.0 and 20.0 and row heights of 30.0 and 40.0.
+- (void)p_setUpTwoSectionsWithTwoRowsEach
+{
+    XCTSetNumberOfSections(2);
+    XCTSetNumberOfRowsInSections((@[@2, @2]));
+    XCTSetHeightsOfHeaders(([GNEOrderedIndexSet indexSetWithNSIndexSet:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 2)]]),
+                           (@[@10.0, @20.0]));
+
+    MockHeightForRowBlock rowBlock = ^CGFloat(NSIndexPath *indexPath)
+    {
+        return (indexPath.gne_section == 0) ? 30.0 : 40.0;
+    };
+    [self.delegate setBlock:(__bridge void *)[rowBlock copy]
+                forSelector:@selector(tableView:heightForRowAtIndexPath:)];
+
+    [self.tableView reloadData];
+}
+
+
 @end
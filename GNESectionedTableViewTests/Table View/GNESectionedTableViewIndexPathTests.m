@@ -0,0 +1,174 @@
+//
+//  GNESectionedTableViewIndexPathTests.m
+//  GNESectionedTableView
+//
+//  Copyright (c) 2016 Gone East LLC. All rights reserved.
+//
+
+#import "GNESectionedTableViewTests.h"
+
+
+// ------------------------------------------------------------------------------------------
+
+
+static const NSUInteger kPerformanceTestIterations = 10000;
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@interface GNESectionedTableViewIndexPathTests : GNESectionedTableViewTests
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@implementation GNESectionedTableViewIndexPathTests
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Set Up & Tear Down
+// ------------------------------------------------------------------------------------------
+- (void)setUp
+{
+    [super setUp];
+
+    MockHeightForSectionBlock headerBlock = ^CGFloat(NSUInteger section __unused)
+    {
+        return GNESectionedTableViewInvisibleRowHeight;
+    };
+    [self.delegate setBlock:(__bridge void *)[headerBlock copy]
+                forSelector:@selector(tableView:heightForHeaderInSection:)];
+    [self.delegate setBlock:(__bridge void *)[headerBlock copy]
+                forSelector:@selector(tableView:heightForFooterInSection:)];
+
+    MockHeightForRowBlock rowBlock = ^CGFloat(NSIndexPath *indexPath __unused)
+    {
+        return 20.0;
+    };
+    [self.delegate setBlock:(__bridge void *)[rowBlock copy]
+                forSelector:@selector(tableView:heightForRowAtIndexPath:)];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Tests
+// ------------------------------------------------------------------------------------------
+- (void)testIndexPaths_RoundTrip
+{
+    XCTSetNumberOfSections(3);
+    XCTSetNumberOfRowsInSections((@[@0, @5, @3]));
+    [self.tableView reloadData];
+
+    NSInteger tableViewRowCount = self.tableView.numberOfRows;
+    for (NSInteger tableViewRow = 0; tableViewRow < tableViewRowCount; tableViewRow++)
+    {
+        NSIndexPath *indexPath = [self.tableView indexPathForTableViewRow:tableViewRow];
+        XCTAssertNotNil(indexPath);
+        XCTAssertEqual([self.tableView tableViewRowForIndexPath:indexPath], tableViewRow);
+    }
+}
+
+
+- (void)testIndexPaths_AfterInsertingAndDeletingRows
+{
+    XCTSetNumberOfSections(1);
+    XCTSetNumberOfRowsInSections(@[@10]);
+    [self.tableView reloadData];
+
+    NSIndexPath *lastIndexPath = [NSIndexPath gne_indexPathForRow:9 inSection:0];
+    NSInteger lastTableViewRow = [self.tableView tableViewRowForIndexPath:lastIndexPath];
+
+    XCTSetNumberOfRowsInSections(@[@12]);
+    NSArray *insertedIndexPaths = @[[NSIndexPath gne_indexPathForRow:2 inSection:0],
+                                    [NSIndexPath gne_indexPathForRow:5 inSection:0]];
+    [self.tableView insertRowsAtIndexPaths:insertedIndexPaths withAnimation:NSTableViewAnimationEffectNone];
+    XCTAssertNumberOfRowsInSection(12, 0);
+    XCTAssertEqualObjects([self.tableView indexPathForTableViewRow:(lastTableViewRow + 2)],
+                          [NSIndexPath gne_indexPathForRow:11 inSection:0]);
+
+    XCTSetNumberOfRowsInSections(@[@11]);
+    [self.tableView deleteRowsAtIndexPaths:@[[NSIndexPath gne_indexPathForRow:0 inSection:0]]
+                             withAnimation:NSTableViewAnimationEffectNone];
+    XCTAssertNumberOfRowsInSection(11, 0);
+    XCTAssertEqualObjects([self.tableView indexPathForTableViewRow:(lastTableViewRow + 1)],
+                          [NSIndexPath gne_indexPathForRow:10 inSection:0]);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Performance
+// ------------------------------------------------------------------------------------------
+- (void)testPerformance_IndexPathForTableViewRow_1000
+{
+    [self p_measureIndexPathResolutionInSectionWithRowCount:1000];
+}
+
+
+- (void)testPerformance_IndexPathForTableViewRow_10000
+{
+    [self p_measureIndexPathResolutionInSectionWithRowCount:10000];
+}
+
+
+- (void)testPerformance_IndexPathForTableViewRow_100000
+{
+    [self p_measureIndexPathResolutionInSectionWithRowCount:100000];
+}
+
+
+- (void)testPerformance_ReloadData_100000
+{
+    [self p_measureReloadDataInSectionWithRowCount:100000];
+}
+
+
+- (void)testPerformance_ReloadData_1000000
+{
+    [self p_measureReloadDataInSectionWithRowCount:1000000];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Helpers
+// ------------------------------------------------------------------------------------------
+/// Measures resolving the index paths of table view rows spread evenly throughout a single
+/// section with the specified number of rows.
+- (void)p_measureIndexPathResolutionInSectionWithRowCount:(NSUInteger)rowCount
+{
+    XCTSetNumberOfSections(1);
+    XCTSetNumberOfRowsInSections(@[@(rowCount)]);
+    [self.tableView reloadData];
+
+    NSUInteger tableViewRowCount = (NSUInteger)self.tableView.numberOfRows;
+    XCTAssertEqual(tableViewRowCount, rowCount + 1);
+
+    [self measureBlock:^
+    {
+        for (NSUInteger i = 0; i < kPerformanceTestIterations; i++)
+        {
+            NSInteger tableViewRow = (NSInteger)((i * 7919) % tableViewRowCount);
+            XCTAssertNotNil([self.tableView indexPathForTableViewRow:tableViewRow]);
+        }
+    }];
+}
+
+
+
+/// Measures reloading a table view containing a single section with the specified number of rows.
+- (void)p_measureReloadDataInSectionWithRowCount:(NSUInteger)rowCount
+{
+    XCTSetNumberOfSections(1);
+    XCTSetNumberOfRowsInSections(@[@(rowCount)]);
+
+    [self measureBlock:^
+    {
+        [self.tableView reloadData];
+        XCTAssertEqual((NSUInteger)self.tableView.numberOfRows, rowCount + 1);
+    }];
+}
+
+
+@end
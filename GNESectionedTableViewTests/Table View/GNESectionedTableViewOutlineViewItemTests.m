@@ -0,0 +1,146 @@
+//
+//  GNESectionedTableViewOutlineViewItemTests.m
+//  GNESectionedTableView
+//
+//  Copyright (c) 2016 Gone East LLC. All rights reserved.
+//
+
+#import "GNESectionedTableViewTests.h"
+#import "GNEOutlineViewItemArray.h"
+#import "GNESectionedTableViewModel.h"
+
+
+// ------------------------------------------------------------------------------------------
+
+
+static const CGFloat kRowHeight = 10.0;
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@interface GNESectionedTableView (GNESectionedTableViewOutlineViewItemTests)
+
+- (GNESectionedTableViewModel *)model;
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@interface GNESectionedTableViewOutlineViewItemTests : GNESectionedTableViewTests
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@implementation GNESectionedTableViewOutlineViewItemTests
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Set Up & Tear Down
+// ------------------------------------------------------------------------------------------
+- (void)setUp
+{
+    [super setUp];
+
+    XCTSetNumberOfSections(2);
+    XCTSetNumberOfRowsInSections((@[@100, @50]));
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Tests
+// ------------------------------------------------------------------------------------------
+- (void)testOutlineViewItems_ReloadDataOnlyKeepsItemsNearVisibleRows
+{
+    [self setUpScrollViewWithRowHeight];
+    [self runRunLoop];
+    
+    // The visible rows and the rows within four visible heights of them.
+    XCTAssertGreaterThan([self materializedCountInSection:0], 0u);
+    XCTAssertLessThanOrEqual([self materializedCountInSection:0], 50u);
+}
+
+
+- (void)testOutlineViewItems_ScrollingRecyclesItemsFarFromVisibleRows
+{
+    [self setUpScrollViewWithRowHeight];
+    [self runRunLoop];
+    
+    // Scrolls through all 1000 rows, two visible heights at a time.
+    CGFloat visibleHeight = self.tableView.visibleRect.size.height;
+    for (CGFloat originY = 2.0 * visibleHeight; originY < 1000.0 * kRowHeight; originY += 2.0 * visibleHeight)
+    {
+        [self.tableView scrollPoint:CGPointMake(0.0, originY)];
+        [self runRunLoop];
+    }
+    
+    // The rows within four visible heights of the visible rows keep their items, and the other items are
+    // recycled once there are 256 of them and at least as many as are kept.
+    XCTAssertLessThan([self materializedCountInSection:0], 90u + 256u);
+    NSUInteger lastVisibleRow = [self lastVisibleIndexPath].gne_row;
+    XCTAssertTrue([[self.tableView.model itemsInSection:0] isObjectMaterializedAtIndex:lastVisibleRow]);
+}
+
+
+- (void)testOutlineViewItems_ReloadDataDoesNotCreateItemsOfCollapsedSections
+{
+    self.tableView.autoExpandSections = NO;
+    [self.tableView reloadData];
+
+    XCTAssertEqual([self materializedCountInSection:0], 0u);
+    XCTAssertEqual([self materializedCountInSection:1], 0u);
+}
+
+
+- (void)testOutlineViewItems_CollapsingSectionRecyclesItsItems
+{
+    [self.tableView reloadData];
+    NSUInteger materializedCount = [self materializedCountInSection:1];
+    [self.tableView collapseSection:0 animated:NO];
+
+    XCTAssertEqual([self materializedCountInSection:0], 0u);
+    XCTAssertEqual([self materializedCountInSection:1], materializedCount);
+    XCTAssertNumberOfRowsInSection(100u, 0);
+}
+
+
+- (void)testOutlineViewItems_ExpandingRecycledSectionCreatesItsItems
+{
+    [self.tableView reloadData];
+    [self.tableView collapseSection:0 animated:NO];
+    [self.tableView expandSection:0 animated:NO];
+    
+    XCTAssertNotNil([self.tableView itemAtRow:1]);
+    XCTAssertGreaterThan([self materializedCountInSection:0], 0u);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Helpers
+// ------------------------------------------------------------------------------------------
+/// Puts a single section of 1000 rows, each kRowHeight tall, into a scroll view showing ten of them.
+- (void)setUpScrollViewWithRowHeight
+{
+    MockHeightForRowBlock heightBlock = ^CGFloat(NSIndexPath * __unused indexPath)
+    {
+        return kRowHeight;
+    };
+    [self.delegate setBlock:(__bridge void *)[heightBlock copy]
+                forSelector:@selector(tableView:heightForRowAtIndexPath:)];
+    
+    [self setUpScrollView];
+}
+
+
+- (NSUInteger)materializedCountInSection:(NSUInteger)section
+{
+    return [self.tableView.model itemsInSection:section].materializedCount;
+}
+
+
+@end
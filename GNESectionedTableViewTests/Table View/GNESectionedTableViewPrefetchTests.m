@@ -0,0 +1,178 @@
+//
+//  GNESectionedTableViewPrefetchTests.m
+//  GNESectionedTableView
+//
+//  Copyright (c) 2016 Gone East LLC. All rights reserved.
+//
+
+#import "GNESectionedTableViewTests.h"
+
+
+// ------------------------------------------------------------------------------------------
+
+
+static const CGFloat kRowHeight = 10.0;
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@interface GNESectionedTableViewPrefetchTests : GNESectionedTableViewTests
+
+/// Arrays of the index paths passed to each call of the prefetching data source methods.
+@property (nonatomic, strong) NSMutableArray *prefetchedIndexPaths;
+@property (nonatomic, strong) NSMutableArray *cancelledIndexPaths;
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@implementation GNESectionedTableViewPrefetchTests
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Set Up & Tear Down
+// ------------------------------------------------------------------------------------------
+- (void)setUp
+{
+    [super setUp];
+    
+    self.prefetchedIndexPaths = [NSMutableArray array];
+    self.cancelledIndexPaths = [NSMutableArray array];
+    
+    __weak typeof(self) weakSelf = self;
+    MockObjectBlock prefetchBlock = ^(NSArray *indexPaths)
+    {
+        [weakSelf.prefetchedIndexPaths addObject:indexPaths];
+    };
+    [self.dataSource setBlock:(__bridge void *)[prefetchBlock copy]
+                  forSelector:@selector(tableView:prefetchRowsAtIndexPaths:)];
+    
+    MockObjectBlock cancelBlock = ^(NSArray *indexPaths)
+    {
+        [weakSelf.cancelledIndexPaths addObject:indexPaths];
+    };
+    [self.dataSource setBlock:(__bridge void *)[cancelBlock copy]
+                  forSelector:@selector(tableView:cancelPrefetchingForRowsAtIndexPaths:)];
+    
+    MockHeightForRowBlock heightBlock = ^CGFloat(NSIndexPath * __unused indexPath)
+    {
+        return kRowHeight;
+    };
+    [self.delegate setBlock:(__bridge void *)[heightBlock copy]
+                forSelector:@selector(tableView:heightForRowAtIndexPath:)];
+    
+    [self setUpScrollView];
+}
+
+
+- (void)tearDown
+{
+    self.prefetchedIndexPaths = nil;
+    self.cancelledIndexPaths = nil;
+    
+    [super tearDown];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Tests
+// ------------------------------------------------------------------------------------------
+- (void)testPrefetch_ScrollingDownPrefetchesRowsBelowVisibleRowsInOrder
+{
+    [self scrollToOriginY:200.0];
+    
+    XCTAssertEqual(self.prefetchedIndexPaths.count, 1u);
+    NSArray *indexPaths = self.prefetchedIndexPaths.firstObject;
+    XCTAssertGreaterThan(indexPaths.count, 0u);
+    
+    NSIndexPath *lastVisibleIndexPath = [self lastVisibleIndexPath];
+    XCTAssertEqual([indexPaths.firstObject gne_row], lastVisibleIndexPath.gne_row + 1);
+    for (NSUInteger i = 1; i < indexPaths.count; i++)
+    {
+        XCTAssertEqual([indexPaths[i] gne_row], [indexPaths[i - 1] gne_row] + 1);
+    }
+    XCTAssertEqual(self.cancelledIndexPaths.count, 0u);
+}
+
+
+- (void)testPrefetch_DoesNotPrefetchRowsTwice
+{
+    [self scrollToOriginY:200.0];
+    [self scrollToOriginY:230.0];
+    
+    NSMutableSet *indexPaths = [NSMutableSet set];
+    NSUInteger count = 0;
+    for (NSArray *batch in self.prefetchedIndexPaths)
+    {
+        [indexPaths addObjectsFromArray:batch];
+        count += batch.count;
+    }
+    XCTAssertEqual(indexPaths.count, count);
+}
+
+
+- (void)testPrefetch_ReversingDirectionCancelsRowsThatWereNotScrolledIntoView
+{
+    [self scrollToOriginY:200.0];
+    NSSet *prefetchedBelow = [NSSet setWithArray:self.prefetchedIndexPaths.firstObject];
+    
+    [self scrollToOriginY:150.0];
+    
+    XCTAssertEqual(self.cancelledIndexPaths.count, 1u);
+    NSIndexPath *lastVisibleIndexPath = [self lastVisibleIndexPath];
+    for (NSIndexPath *indexPath in self.cancelledIndexPaths.firstObject)
+    {
+        XCTAssertTrue([prefetchedBelow containsObject:indexPath]);
+        XCTAssertGreaterThan(indexPath.gne_row, lastVisibleIndexPath.gne_row);
+    }
+    
+    XCTAssertEqual(self.prefetchedIndexPaths.count, 2u);
+    NSArray *prefetchedAbove = self.prefetchedIndexPaths.lastObject;
+    XCTAssertGreaterThan(prefetchedAbove.count, 0u);
+    NSIndexPath *firstVisibleIndexPath = [self firstVisibleIndexPath];
+    XCTAssertEqual([prefetchedAbove.firstObject gne_row] + 1, firstVisibleIndexPath.gne_row);
+    for (NSUInteger i = 1; i < prefetchedAbove.count; i++)
+    {
+        XCTAssertEqual([prefetchedAbove[i] gne_row] + 1, [prefetchedAbove[i - 1] gne_row]);
+    }
+}
+
+
+- (void)testPrefetch_ReloadDataForgetsPrefetchedRows
+{
+    [self scrollToOriginY:200.0];
+    [self.tableView reloadData];
+    [self scrollToOriginY:150.0];
+    
+    XCTAssertEqual(self.cancelledIndexPaths.count, 0u);
+}
+
+
+- (void)testPrefetch_ClickingRowBeforePrefetchedRowsAreUpdatedDoesNotStopPrefetching
+{
+    [self.tableView scrollPoint:CGPointMake(0.0, 200.0)];
+    [self performClickActionForRow:(NSInteger)[self.tableView rowsInRect:self.tableView.visibleRect].location];
+    [self runRunLoop];
+    
+    XCTAssertEqual(self.prefetchedIndexPaths.count, 1u);
+    
+    [self scrollToOriginY:150.0];
+    
+    XCTAssertEqual(self.prefetchedIndexPaths.count, 2u);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Helpers
+// ------------------------------------------------------------------------------------------
+- (void)scrollToOriginY:(CGFloat)originY
+{
+    [self.tableView scrollPoint:CGPointMake(0.0, originY)];
+    [self runRunLoop];
+}
+
+
+@end
@@ -0,0 +1,287 @@
+//
+//  GNESectionedTableViewRangeSelectionTests.m
+//  GNESectionedTableView
+//
+//  Copyright (c) 2016 Gone East LLC. All rights reserved.
+//
+
+#import "GNESectionedTableViewTests.h"
+
+
+// ------------------------------------------------------------------------------------------
+
+
+#define GNEIndexPath(r, s) [NSIndexPath gne_indexPathForRow:r inSection:s]
+
+#define XCTSetShouldSelectHeaders(shouldSelect) \
+{ \
+    MockShouldSelectSectionBlock block = ^BOOL(NSUInteger section __unused) \
+    { \
+        return shouldSelect; \
+    }; \
+    SEL selector = @selector(tableView:shouldSelectHeaderInSection:); \
+    [self.delegate setBlock:(__bridge void *)[block copy] forSelector:selector]; \
+}
+
+#define XCTSetShouldSelectRowsBlock(block) \
+{ \
+    SEL selector = @selector(tableView:shouldSelectRowAtIndexPath:); \
+    [self.delegate setBlock:(__bridge void *)[block copy] forSelector:selector]; \
+}
+
+#define XCTSetSelectableRowsBlock(block) \
+{ \
+    SEL selector = @selector(tableView:selectableRowsForProposedRows:inSection:); \
+    [self.delegate setBlock:(__bridge void *)[block copy] forSelector:selector]; \
+}
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@interface GNESectionedTableViewRangeSelectionTests : GNESectionedTableViewTests
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@implementation GNESectionedTableViewRangeSelectionTests
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Set Up
+// ------------------------------------------------------------------------------------------
+- (void)setUp
+{
+    [super setUp];
+    
+    XCTSetNumberOfSections(3);
+    XCTSetNumberOfRowsInSections((@[@5, @0, @4]));
+    [self.tableView reloadData];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Selecting Ranges
+// ------------------------------------------------------------------------------------------
+- (void)testSelectRowsInRange_SelectsRowsOfEverySection
+{
+    [self.tableView selectRowsInRange:NSMakeRange(1, 3) ofSectionsInRange:NSMakeRange(0, 3) byExtendingSelection:NO];
+    
+    NSArray *expected = @[GNEIndexPath(1, 0), GNEIndexPath(2, 0), GNEIndexPath(3, 0),
+                          GNEIndexPath(1, 2), GNEIndexPath(2, 2), GNEIndexPath(3, 2)];
+    XCTAssertEqualObjects(self.tableView.selectedIndexPaths, expected);
+}
+
+
+- (void)testSelectRowsInRange_IgnoresRowsAndSectionsBeyondEnd
+{
+    [self.tableView selectRowsInRange:NSMakeRange(3, 100) ofSectionsInRange:NSMakeRange(2, 10) byExtendingSelection:NO];
+    
+    XCTAssertEqualObjects(self.tableView.selectedIndexPaths, (@[GNEIndexPath(3, 2)]));
+}
+
+
+- (void)testSelectRowsInRange_ExtendsSelection
+{
+    [self.tableView selectRowAtIndexPath:GNEIndexPath(4, 0) byExtendingSelection:NO];
+    [self.tableView selectRowsInRange:NSMakeRange(0, 1) ofSectionsInRange:NSMakeRange(2, 1) byExtendingSelection:YES];
+    
+    XCTAssertEqualObjects(self.tableView.selectedIndexPaths, (@[GNEIndexPath(4, 0), GNEIndexPath(0, 2)]));
+    
+    [self.tableView selectRowsInRange:NSMakeRange(0, 1) ofSectionsInRange:NSMakeRange(0, 1) byExtendingSelection:NO];
+    
+    XCTAssertEqualObjects(self.tableView.selectedIndexPaths, (@[GNEIndexPath(0, 0)]));
+}
+
+
+- (void)testSelectRowsInRange_SkipsCollapsedSections
+{
+    [self.tableView collapseSection:0 animated:NO];
+    
+    [self.tableView selectRowsInRange:NSMakeRange(0, 2) ofSectionsInRange:NSMakeRange(0, 3) byExtendingSelection:NO];
+    
+    XCTAssertEqualObjects(self.tableView.selectedIndexPaths, (@[GNEIndexPath(0, 2), GNEIndexPath(1, 2)]));
+}
+
+
+- (void)testSelectHeadersInSections
+{
+    NSMutableIndexSet *sections = [NSMutableIndexSet indexSetWithIndex:0];
+    [sections addIndex:2];
+    
+    [self.tableView selectHeadersInSections:sections byExtendingSelection:NO];
+    
+    NSArray *expected = @[[self.tableView indexPathForHeaderInSection:0],
+                          [self.tableView indexPathForHeaderInSection:2]];
+    XCTAssertEqualObjects(self.tableView.selectedIndexPaths, expected);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Changing the Selection
+// ------------------------------------------------------------------------------------------
+- (void)testSelectionChanges_OnlyChangedRowsAreApplied
+{
+    [self.tableView selectRowsInRange:NSMakeRange(0, 5) ofSectionsInRange:NSMakeRange(0, 3) byExtendingSelection:NO];
+    XCTAssertEqual(self.tableView.selectedIndexPaths.count, 9u);
+    
+    [self.tableView deselectRow:[self.tableView tableViewRowForIndexPath:GNEIndexPath(2, 0)]];
+    [self.tableView selectHeadersInSections:[NSIndexSet indexSetWithIndex:1] byExtendingSelection:YES];
+    
+    NSArray *expected = @[GNEIndexPath(0, 0), GNEIndexPath(1, 0), GNEIndexPath(3, 0), GNEIndexPath(4, 0),
+                          [self.tableView indexPathForHeaderInSection:1],
+                          GNEIndexPath(0, 2), GNEIndexPath(1, 2), GNEIndexPath(2, 2), GNEIndexPath(3, 2)];
+    XCTAssertEqualObjects(self.tableView.selectedIndexPaths, expected);
+    XCTAssertFalse([self.tableView isIndexPathSelected:GNEIndexPath(2, 0)]);
+    
+    [self.tableView selectRowsInRange:NSMakeRange(3, 1) ofSectionsInRange:NSMakeRange(2, 1) byExtendingSelection:NO];
+    
+    XCTAssertEqualObjects(self.tableView.selectedIndexPaths, (@[GNEIndexPath(3, 2)]));
+    
+    [self.tableView deselectAll:nil];
+    
+    XCTAssertEqual(self.tableView.selectedIndexPaths.count, 0u);
+}
+
+
+- (void)testSelectionChanges_CollapsingSectionDeselectsItsRows
+{
+    [self.tableView selectRowsInRange:NSMakeRange(0, 2) ofSectionsInRange:NSMakeRange(0, 3) byExtendingSelection:NO];
+    
+    [self.tableView collapseSection:0 animated:NO];
+    
+    XCTAssertEqualObjects(self.tableView.selectedIndexPaths, (@[GNEIndexPath(0, 2), GNEIndexPath(1, 2)]));
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Filtering Proposed Selections
+// ------------------------------------------------------------------------------------------
+- (void)testProposedSelection_AllTableViewRowsApprovedByRanges
+{
+    __block NSUInteger numberOfCalls = 0;
+    MockSelectableRowsBlock block = ^NSIndexSet *(NSIndexSet *rows, NSUInteger section __unused)
+    {
+        numberOfCalls++;
+        return rows;
+    };
+    XCTSetShouldSelectHeaders(YES);
+    XCTSetSelectableRowsBlock(block);
+    
+    id <NSOutlineViewDelegate> outlineViewDelegate = (id <NSOutlineViewDelegate>)self.tableView;
+    NSRange allRows = NSMakeRange(0, (NSUInteger)self.tableView.numberOfRows);
+    NSIndexSet *proposed = [NSIndexSet indexSetWithIndexesInRange:allRows];
+    
+    NSIndexSet *approved = [outlineViewDelegate outlineView:self.tableView
+                       selectionIndexesForProposedSelection:proposed];
+    [self.tableView selectRowIndexes:approved byExtendingSelection:NO];
+    
+    NSMutableArray *expected = [NSMutableArray array];
+    NSArray *rowCounts = @[@5, @0, @4];
+    for (NSUInteger section = 0; section < rowCounts.count; section++)
+    {
+        for (NSUInteger row = 0; row < [rowCounts[section] unsignedIntegerValue]; row++)
+        {
+            [expected addObject:GNEIndexPath(row, section)];
+        }
+        [expected addObject:[self.tableView indexPathForHeaderInSection:section]];
+    }
+    XCTAssertEqualObjects(self.tableView.selectedIndexPaths, expected);
+    XCTAssertEqual(numberOfCalls, 2u); // Once per section containing rows
+}
+
+
+- (void)testProposedSelection_PartialRangesSpanningSections
+{
+    MockSelectableRowsBlock block = ^NSIndexSet *(NSIndexSet *rows, NSUInteger section)
+    {
+        NSMutableIndexSet *selectableRows = [rows mutableCopy];
+        if (section == 0)
+        {
+            [selectableRows removeIndex:4];
+        }
+        return selectableRows;
+    };
+    XCTSetShouldSelectHeaders(NO);
+    XCTSetSelectableRowsBlock(block);
+    
+    id <NSOutlineViewDelegate> outlineViewDelegate = (id <NSOutlineViewDelegate>)self.tableView;
+    NSInteger firstRow = [self.tableView tableViewRowForIndexPath:GNEIndexPath(3, 0)];
+    NSInteger lastRow = [self.tableView tableViewRowForIndexPath:GNEIndexPath(1, 2)];
+    XCTAssertGreaterThan(lastRow, firstRow);
+    
+    NSRange range = NSMakeRange((NSUInteger)firstRow, (NSUInteger)(lastRow - firstRow + 1));
+    NSIndexSet *approved = [outlineViewDelegate outlineView:self.tableView
+                       selectionIndexesForProposedSelection:[NSIndexSet indexSetWithIndexesInRange:range]];
+    [self.tableView selectRowIndexes:approved byExtendingSelection:NO];
+    
+    NSArray *expected = @[GNEIndexPath(3, 0), GNEIndexPath(0, 2), GNEIndexPath(1, 2)];
+    XCTAssertEqualObjects(self.tableView.selectedIndexPaths, expected);
+}
+
+
+- (void)testProposedSelection_RangesAreFilteredInsteadOfEachRow
+{
+    __block NSUInteger numberOfRowCalls = 0;
+    MockShouldSelectRowBlock shouldSelectBlock = ^BOOL(NSIndexPath *indexPath __unused)
+    {
+        numberOfRowCalls++;
+        return NO;
+    };
+    XCTSetShouldSelectRowsBlock(shouldSelectBlock);
+    
+    NSMutableArray *proposedRanges = [NSMutableArray array];
+    MockSelectableRowsBlock block = ^NSIndexSet *(NSIndexSet *rows, NSUInteger section)
+    {
+        [proposedRanges addObject:@[@(section), rows]];
+        return rows;
+    };
+    XCTSetShouldSelectHeaders(NO);
+    XCTSetSelectableRowsBlock(block);
+    
+    id <NSOutlineViewDelegate> outlineViewDelegate = (id <NSOutlineViewDelegate>)self.tableView;
+    NSRange allRows = NSMakeRange(0, (NSUInteger)self.tableView.numberOfRows);
+    NSIndexSet *approved = [outlineViewDelegate outlineView:self.tableView
+                       selectionIndexesForProposedSelection:[NSIndexSet indexSetWithIndexesInRange:allRows]];
+    [self.tableView selectRowIndexes:approved byExtendingSelection:NO];
+    
+    XCTAssertEqual(numberOfRowCalls, 0u);
+    NSArray *expectedRanges = @[@[@0, [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 5)]],
+                                @[@2, [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 4)]]];
+    XCTAssertEqualObjects(proposedRanges, expectedRanges);
+    XCTAssertEqual(self.tableView.selectedIndexPaths.count, 9u);
+}
+
+
+- (void)testProposedSelection_EachRowIsFilteredWithoutRangeFiltering
+{
+    XCTAssertFalse([self.delegate respondsToSelector:@selector(tableView:selectableRowsForProposedRows:inSection:)]);
+    
+    __block NSUInteger numberOfRowCalls = 0;
+    MockShouldSelectRowBlock shouldSelectBlock = ^BOOL(NSIndexPath *indexPath)
+    {
+        numberOfRowCalls++;
+        return (indexPath.gne_row % 2 == 0);
+    };
+    XCTSetShouldSelectRowsBlock(shouldSelectBlock);
+    XCTSetShouldSelectHeaders(NO);
+    
+    id <NSOutlineViewDelegate> outlineViewDelegate = (id <NSOutlineViewDelegate>)self.tableView;
+    NSInteger firstRow = [self.tableView tableViewRowForIndexPath:GNEIndexPath(2, 0)];
+    NSInteger lastRow = [self.tableView tableViewRowForIndexPath:GNEIndexPath(2, 2)];
+    
+    NSRange range = NSMakeRange((NSUInteger)firstRow, (NSUInteger)(lastRow - firstRow + 1));
+    NSIndexSet *approved = [outlineViewDelegate outlineView:self.tableView
+                       selectionIndexesForProposedSelection:[NSIndexSet indexSetWithIndexesInRange:range]];
+    [self.tableView selectRowIndexes:approved byExtendingSelection:NO];
+    
+    XCTAssertEqual(numberOfRowCalls, 6u); // Rows 2-4 of section 0 and rows 0-2 of section 2
+    NSArray *expected = @[GNEIndexPath(2, 0), GNEIndexPath(4, 0), GNEIndexPath(0, 2), GNEIndexPath(2, 2)];
+    XCTAssertEqualObjects(self.tableView.selectedIndexPaths, expected);
+}
+
+
+@end
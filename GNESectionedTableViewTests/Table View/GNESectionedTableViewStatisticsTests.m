@@ -0,0 +1,112 @@
+//
+//  GNESectionedTableViewStatisticsTests.m
+//  GNESectionedTableView
+//
+//  Copyright (c) 2016 Gone East LLC. All rights reserved.
+//
+
+#import "GNESectionedTableViewTests.h"
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@interface GNESectionedTableViewStatisticsTests : GNESectionedTableViewTests
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@implementation GNESectionedTableViewStatisticsTests
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Snapshots
+// ------------------------------------------------------------------------------------------
+- (void)testStatistics_EmptySnapshot
+{
+    GNESectionedTableViewStatistics *statistics = [[GNESectionedTableViewStatistics alloc] init];
+    
+    XCTAssertEqual(statistics.numberOfCallouts, 0u);
+    XCTAssertEqual([statistics numberOfCalloutsForSelector:@selector(numberOfSectionsInTableView:)], 0u);
+    XCTAssertEqual(statistics.averageIndexPathScanLength, 0.0);
+    XCTAssertEqualObjects([statistics dictionaryRepresentation][@"callouts"], @{});
+    XCTAssertTrue([NSJSONSerialization isValidJSONObject:[statistics dictionaryRepresentation]]);
+}
+
+
+#if GNE_STATISTICS_ENABLED
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Counters
+// ------------------------------------------------------------------------------------------
+- (void)testStatistics_CountsCalloutsBySelector
+{
+    XCTSetNumberOfSections(3);
+    XCTSetNumberOfRowsInSections((@[@1, @2, @3]));
+    [self.tableView resetStatistics];
+    [self.tableView reloadData];
+    
+    GNESectionedTableViewStatistics *statistics = self.tableView.statistics;
+    XCTAssertGreaterThanOrEqual([statistics numberOfCalloutsForSelector:@selector(numberOfSectionsInTableView:)], 1u);
+    XCTAssertGreaterThanOrEqual([statistics numberOfCalloutsForSelector:@selector(tableView:numberOfRowsInSection:)], 3u);
+    XCTAssertGreaterThanOrEqual(statistics.numberOfCallouts,
+                                [statistics numberOfCalloutsForSelector:@selector(numberOfSectionsInTableView:)]);
+}
+
+
+- (void)testStatistics_TimesOutermostUpdateTransactions
+{
+    XCTSetNumberOfSections(1);
+    XCTSetNumberOfRowsInSections((@[@1]));
+    [self.tableView reloadData];
+    [self.tableView resetStatistics];
+    
+    [self.tableView beginUpdates];
+    [self.tableView beginUpdates];
+    [self.tableView endUpdates];
+    [self.tableView endUpdates];
+    [self.tableView beginUpdates];
+    [self.tableView endUpdates];
+    
+    GNESectionedTableViewStatistics *statistics = self.tableView.statistics;
+    XCTAssertEqual(statistics.numberOfUpdateTransactions, 2u);
+    XCTAssertGreaterThanOrEqual(statistics.totalUpdateTime, statistics.longestUpdateTime);
+}
+
+
+- (void)testStatistics_ResetClearsCounters
+{
+    XCTSetNumberOfSections(2);
+    XCTSetNumberOfRowsInSections((@[@2, @2]));
+    [self.tableView reloadData];
+    XCTAssertGreaterThan(self.tableView.statistics.numberOfCallouts, 0u);
+    
+    [self.tableView resetStatistics];
+    
+    GNESectionedTableViewStatistics *statistics = self.tableView.statistics;
+    XCTAssertEqual(statistics.numberOfCallouts, 0u);
+    XCTAssertEqual(statistics.numberOfIndexPathResolutions, 0u);
+    XCTAssertEqual(statistics.numberOfIndexPathAllocations, 0u);
+    XCTAssertEqual(statistics.numberOfUpdateTransactions, 0u);
+}
+
+#else
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Compiled Out
+// ------------------------------------------------------------------------------------------
+- (void)testStatistics_NilWhenCompiledOut
+{
+    [self.tableView reloadData];
+    [self.tableView resetStatistics];
+    
+    XCTAssertNil(self.tableView.statistics);
+}
+
+#endif
+
+
+@end
@@ -125,4 +125,21 @@
 @property (nonatomic, strong, readonly) GNEMockDataSource *dataSource;
 @property (nonatomic, strong, readonly) GNEMockDelegate *delegate;
 
+/// Scroll view containing the table view after -setUpScrollView, otherwise nil.
+@property (nonatomic, strong, readonly) NSScrollView *scrollView;
+
+/// Puts the table view into a scroll view whose visible rect is 100.0 points tall and reloads it with a
+/// single section of 1000 rows. Used by tests that scroll.
+- (void)setUpScrollView;
+
+/// Runs the main run loop briefly, so that the work the table view scheduled for the end of the current
+/// run loop iteration is done.
+- (void)runRunLoop;
+
+- (NSIndexPath *)firstVisibleIndexPath;
+- (NSIndexPath *)lastVisibleIndexPath;
+
+/// Performs the click action of the specified row, like a click that isn't followed by a double click.
+- (void)performClickActionForRow:(NSInteger)row;
+
 @end
@@ -13,11 +13,29 @@
 // ------------------------------------------------------------------------------------------
 
 
+static const CGFloat kScrollViewVisibleHeight = 100.0;
+static const NSUInteger kScrollViewNumberOfRows = 1000;
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@interface GNESectionedTableView (GNESectionedTableViewTests)
+
+- (void)p_performClickActionForRowNumber:(NSNumber *)rowNumber;
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
 @interface GNESectionedTableViewTests ()
 
 @property (nonatomic, strong, readwrite) GNESectionedTableView *tableView;
 @property (nonatomic, strong, readwrite) GNEMockDataSource *dataSource;
 @property (nonatomic, strong, readwrite) GNEMockDelegate *delegate;
+@property (nonatomic, strong, readwrite) NSScrollView *scrollView;
 
 @end
 
@@ -48,6 +66,8 @@
 
 - (void)tearDown
 {
+    self.scrollView.documentView = nil;
+    self.scrollView = nil;
     self.tableView.tableViewDataSource = nil;
     self.tableView.tableViewDelegate = nil;
     self.dataSource = nil;
@@ -92,4 +112,46 @@
 }
 
 
+// ------------------------------------------------------------------------------------------
+#pragma mark - Scrolling
+// ------------------------------------------------------------------------------------------
+- (void)setUpScrollView
+{
+    XCTSetNumberOfSections(1);
+    XCTSetNumberOfRowsInSections(@[@(kScrollViewNumberOfRows)]);
+
+    self.scrollView = [[NSScrollView alloc] initWithFrame:CGRectMake(0.0, 0.0, 100.0, kScrollViewVisibleHeight)];
+    self.scrollView.documentView = self.tableView;
+    [self.tableView reloadData];
+}
+
+
+- (void)runRunLoop
+{
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.05]];
+}
+
+
+- (NSIndexPath *)firstVisibleIndexPath
+{
+    NSRange visibleRows = [self.tableView rowsInRect:self.tableView.visibleRect];
+
+    return [self.tableView indexPathForTableViewRow:(NSInteger)visibleRows.location];
+}
+
+
+- (NSIndexPath *)lastVisibleIndexPath
+{
+    NSRange visibleRows = [self.tableView rowsInRect:self.tableView.visibleRect];
+
+    return [self.tableView indexPathForTableViewRow:(NSInteger)NSMaxRange(visibleRows) - 1];
+}
+
+
+- (void)performClickActionForRow:(NSInteger)row
+{
+    [self.tableView p_performClickActionForRowNumber:@(row)];
+}
+
+
 @end
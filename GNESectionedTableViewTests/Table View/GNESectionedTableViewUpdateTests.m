@@ -0,0 +1,441 @@
+//
+//  GNESectionedTableViewUpdateTests.m
+//  GNESectionedTableView
+//
+//  Copyright (c) 2016 Gone East LLC. All rights reserved.
+//
+
+#import "GNESectionedTableViewTests.h"
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@interface GNESectionedTableViewUpdateTests : GNESectionedTableViewTests
+
+/// Snapshot whose section and row counts are returned by the mock data source.
+@property (nonatomic, strong) GNESectionedTableViewSnapshot *snapshot;
+
+/// Identifier of the next row appended to the snapshot by the mock data source.
+@property (nonatomic, assign) NSUInteger nextRowIdentifier;
+
+/// Number of times the mock data source was told that rows will be appended.
+@property (nonatomic, assign) NSUInteger numberOfAppends;
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@implementation GNESectionedTableViewUpdateTests
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Set Up
+// ------------------------------------------------------------------------------------------
+- (void)setUp
+{
+    [super setUp];
+    
+    __weak typeof(self) weakSelf = self;
+    MockNumberOfSectionsBlock sectionsBlock = ^NSUInteger()
+    {
+        return weakSelf.snapshot.numberOfSections;
+    };
+    [self.dataSource setBlock:(__bridge void *)[sectionsBlock copy]
+                  forSelector:@selector(numberOfSectionsInTableView:)];
+    
+    MockNumberOfRowsBlock rowsBlock = ^NSUInteger(NSUInteger section)
+    {
+        return [weakSelf.snapshot numberOfRowsInSection:section];
+    };
+    [self.dataSource setBlock:(__bridge void *)[rowsBlock copy]
+                  forSelector:@selector(tableView:numberOfRowsInSection:)];
+    
+    MockShouldSelectRowBlock selectBlock = ^BOOL(NSIndexPath *indexPath __unused)
+    {
+        return YES;
+    };
+    [self.delegate setBlock:(__bridge void *)[selectBlock copy]
+                forSelector:@selector(tableView:shouldSelectRowAtIndexPath:)];
+    
+    self.nextRowIdentifier = 1000;
+    MockWillAppendRowsBlock appendBlock = ^(NSUInteger count, NSUInteger section, NSUInteger evictedCount)
+    {
+        [weakSelf appendRows:count toSnapshotSection:section evictingRows:evictedCount];
+    };
+    [self.dataSource setBlock:(__bridge void *)[appendBlock copy]
+                  forSelector:@selector(tableView:willAppendRows:toSection:evictingRows:)];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Change Sets
+// ------------------------------------------------------------------------------------------
+- (void)testApplyChangeSet_CountsMatchNewSnapshot
+{
+    self.snapshot = [GNESectionedTableViewSnapshot snapshotWithSectionIdentifiers:@[@"A", @"B", @"C"]
+                                                                   rowIdentifiers:@[@[@1, @2],
+                                                                                    @[@3],
+                                                                                    @[@4, @5, @6]]];
+    [self.tableView reloadData];
+    
+    GNESectionedTableViewSnapshot *to = [GNESectionedTableViewSnapshot
+                                         snapshotWithSectionIdentifiers:@[@"C", @"D", @"A"]
+                                         rowIdentifiers:@[@[@6, @4], @[@7, @8, @9, @10], @[@2, @3, @1]]];
+    [self applyChangesToSnapshot:to];
+    
+    XCTAssertNumberOfSections(3);
+    XCTAssertNumberOfRowsInSection(2, 0);
+    XCTAssertNumberOfRowsInSection(4, 1);
+    XCTAssertNumberOfRowsInSection(3, 2);
+}
+
+
+- (void)testApplyChangeSet_KeepsSelection
+{
+    self.snapshot = [GNESectionedTableViewSnapshot snapshotWithSectionIdentifiers:@[@"A", @"B"]
+                                                                   rowIdentifiers:@[@[@1, @2], @[@3, @4]]];
+    [self.tableView reloadData];
+    
+    NSIndexPath *selectedIndexPath = [NSIndexPath gne_indexPathForRow:1 inSection:1];
+    [self.tableView selectRowAtIndexPath:selectedIndexPath byExtendingSelection:NO];
+    XCTAssertEqualObjects(self.tableView.selectedIndexPaths, @[selectedIndexPath]);
+    
+    GNESectionedTableViewSnapshot *to = [GNESectionedTableViewSnapshot
+                                         snapshotWithSectionIdentifiers:@[@"B", @"A"]
+                                         rowIdentifiers:@[@[@4, @3], @[@1, @2]]];
+    [self applyChangesToSnapshot:to];
+    
+    XCTAssertEqualObjects(self.tableView.selectedIndexPaths, @[[NSIndexPath gne_indexPathForRow:0 inSection:0]]);
+}
+
+
+- (void)testApplyChangeSet_KeepsCollapsedStateOfMovedSections
+{
+    self.snapshot = [GNESectionedTableViewSnapshot snapshotWithSectionIdentifiers:@[@"A", @"B", @"C"]
+                                                                   rowIdentifiers:@[@[@1], @[@2], @[@3]]];
+    [self.tableView reloadData];
+    [self.tableView collapseSection:2 animated:NO];
+    
+    GNESectionedTableViewSnapshot *to = [GNESectionedTableViewSnapshot
+                                         snapshotWithSectionIdentifiers:@[@"C", @"A", @"B"]
+                                         rowIdentifiers:@[@[@3], @[@1], @[@2]]];
+    [self applyChangesToSnapshot:to];
+    
+    XCTAssertFalse([self.tableView isSectionExpanded:0]);
+    XCTAssertTrue([self.tableView isSectionExpanded:1]);
+    XCTAssertTrue([self.tableView isSectionExpanded:2]);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Batch Updates
+// ------------------------------------------------------------------------------------------
+- (void)testPerformBatchUpdates_MixedRowUpdatesUseOldAndNewIndexPaths
+{
+    self.snapshot = [GNESectionedTableViewSnapshot snapshotWithSectionIdentifiers:@[@"A", @"B"]
+                                                                   rowIdentifiers:@[@[@1, @2, @3], @[@4]]];
+    [self.tableView reloadData];
+    
+    NSIndexPath *selectedIndexPath = [NSIndexPath gne_indexPathForRow:0 inSection:1];
+    [self.tableView selectRowAtIndexPath:selectedIndexPath byExtendingSelection:NO];
+    
+    __block BOOL didComplete = NO;
+    [self.tableView performBatchUpdates:^()
+    {
+        self.snapshot = [GNESectionedTableViewSnapshot snapshotWithSectionIdentifiers:@[@"A", @"B"]
+                                                                       rowIdentifiers:@[@[@2, @5, @6],
+                                                                                        @[@4, @7]]];
+        XCTAssertTrue(self.tableView.isUpdating);
+        
+        // Deletions use the old index paths and insertions the new ones, in any order.
+        [self.tableView insertRowsAtIndexPaths:@[[NSIndexPath gne_indexPathForRow:2 inSection:0],
+                                                 [NSIndexPath gne_indexPathForRow:1 inSection:1],
+                                                 [NSIndexPath gne_indexPathForRow:1 inSection:0]]
+                                 withAnimation:NSTableViewAnimationEffectNone];
+        [self.tableView deleteRowsAtIndexPaths:@[[NSIndexPath gne_indexPathForRow:0 inSection:0],
+                                                 [NSIndexPath gne_indexPathForRow:2 inSection:0],
+                                                 [NSIndexPath gne_indexPathForRow:0 inSection:0]]
+                                 withAnimation:NSTableViewAnimationEffectNone];
+    }
+    completion:^()
+    {
+        didComplete = YES;
+    }];
+    
+    XCTAssertTrue(didComplete);
+    XCTAssertFalse(self.tableView.isUpdating);
+    XCTAssertNumberOfRowsInSection(3, 0);
+    XCTAssertNumberOfRowsInSection(2, 1);
+    XCTAssertEqualObjects(self.tableView.selectedIndexPaths, @[selectedIndexPath]);
+}
+
+
+- (void)testPerformBatchUpdates_SectionUpdatesLoadTheirOwnRows
+{
+    self.snapshot = [GNESectionedTableViewSnapshot snapshotWithSectionIdentifiers:@[@"A", @"B", @"C"]
+                                                                   rowIdentifiers:@[@[@1], @[@2, @3], @[@4]]];
+    [self.tableView reloadData];
+    [self.tableView collapseSection:2 animated:NO];
+    
+    [self.tableView performBatchUpdates:^()
+    {
+        self.snapshot = [GNESectionedTableViewSnapshot snapshotWithSectionIdentifiers:@[@"C", @"D", @"B"]
+                                                                       rowIdentifiers:@[@[@4],
+                                                                                        @[@5, @6, @7],
+                                                                                        @[@2, @3]]];
+        [self.tableView deleteSections:[NSIndexSet indexSetWithIndex:0]
+                         withAnimation:NSTableViewAnimationEffectNone];
+        // Rows of deleted and inserted sections are ignored.
+        [self.tableView deleteRowsAtIndexPaths:@[[NSIndexPath gne_indexPathForRow:0 inSection:0]]
+                                 withAnimation:NSTableViewAnimationEffectNone];
+        [self.tableView insertSections:[NSIndexSet indexSetWithIndex:1]
+                         withAnimation:NSTableViewAnimationEffectNone];
+        [self.tableView insertRowsAtIndexPaths:@[[NSIndexPath gne_indexPathForRow:2 inSection:1]]
+                                 withAnimation:NSTableViewAnimationEffectNone];
+        [self.tableView moveSection:2 toSection:0];
+        [self.tableView reloadSections:[NSIndexSet indexSetWithIndex:1]];
+    }
+    completion:nil];
+    
+    XCTAssertNumberOfSections(3);
+    XCTAssertNumberOfRowsInSection(1, 0);
+    XCTAssertNumberOfRowsInSection(3, 1);
+    XCTAssertNumberOfRowsInSection(2, 2);
+    XCTAssertFalse([self.tableView isSectionExpanded:0]);
+    XCTAssertTrue([self.tableView isSectionExpanded:1]);
+    XCTAssertTrue([self.tableView isSectionExpanded:2]);
+}
+
+
+- (void)testPerformBatchUpdates_NestedCompletionsWaitForOutermostBatch
+{
+    self.snapshot = [GNESectionedTableViewSnapshot snapshotWithSectionIdentifiers:@[@"A"]
+                                                                   rowIdentifiers:@[@[@1]]];
+    [self.tableView reloadData];
+    
+    NSMutableArray *events = [NSMutableArray array];
+    [self.tableView performBatchUpdates:^()
+    {
+        [self.tableView performBatchUpdates:^()
+        {
+            self.snapshot = [GNESectionedTableViewSnapshot snapshotWithSectionIdentifiers:@[@"A"]
+                                                                           rowIdentifiers:@[@[@1, @2]]];
+            [self.tableView insertRowsAtIndexPaths:@[[NSIndexPath gne_indexPathForRow:1 inSection:0]]
+                                     withAnimation:NSTableViewAnimationEffectNone];
+        }
+        completion:^()
+        {
+            [events addObject:@"inner"];
+        }];
+        [events addObject:@"updates"];
+    }
+    completion:^()
+    {
+        [events addObject:@"outer"];
+    }];
+    
+    XCTAssertEqualObjects(events, (@[@"updates", @"inner", @"outer"]));
+    XCTAssertNumberOfRowsInSection(2, 0);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Reloads
+// ------------------------------------------------------------------------------------------
+- (void)testReloadRows_SkipsInvalidAndCollapsedIndexPaths
+{
+    NSMutableArray *rows = [NSMutableArray array];
+    for (NSUInteger row = 0; row < 1000; row++)
+    {
+        [rows addObject:@(row)];
+    }
+    self.snapshot = [GNESectionedTableViewSnapshot snapshotWithSectionIdentifiers:@[@"A", @"B"]
+                                                                   rowIdentifiers:@[rows, @[@1000, @1001]]];
+    [self.tableView reloadData];
+    [self.tableView collapseSection:1 animated:NO];
+    
+    NSMutableArray *indexPaths = [NSMutableArray array];
+    for (NSUInteger row = 1000; row > 0; row--)
+    {
+        [indexPaths addObject:[NSIndexPath gne_indexPathForRow:row - 1 inSection:0]];
+    }
+    [indexPaths addObject:[self.tableView indexPathForHeaderInSection:0]];
+    [indexPaths addObject:[NSIndexPath gne_indexPathForRow:1000 inSection:0]];
+    [indexPaths addObject:[NSIndexPath gne_indexPathForRow:0 inSection:1]];
+    [indexPaths addObject:[NSIndexPath gne_indexPathForRow:0 inSection:2]];
+    
+    XCTAssertNoThrow([self.tableView reloadRowsAtIndexPaths:indexPaths]);
+    XCTAssertNoThrow([self.tableView reloadSections:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 2)]]);
+    
+    XCTAssertNumberOfSections(2);
+    XCTAssertNumberOfRowsInSection(1000, 0);
+    XCTAssertNumberOfRowsInSection(2, 1);
+    XCTAssertTrue([self.tableView isSectionExpanded:0]);
+    XCTAssertFalse([self.tableView isSectionExpanded:1]);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Streaming
+// ------------------------------------------------------------------------------------------
+- (void)testAppendRows_CoalescesAppendsIntoSingleUpdate
+{
+    self.snapshot = [GNESectionedTableViewSnapshot snapshotWithSectionIdentifiers:@[@"A", @"B"]
+                                                                   rowIdentifiers:@[@[@1, @2], @[@3]]];
+    [self.tableView reloadData];
+    
+    [self.tableView appendRows:2 toSection:1];
+    [self.tableView appendRows:3 toSection:0];
+    [self.tableView appendRows:1 toSection:1];
+    [self.tableView flushAppendedRows];
+    
+    XCTAssertEqual(self.numberOfAppends, 2u);
+    XCTAssertNumberOfRowsInSection(5, 0);
+    XCTAssertNumberOfRowsInSection(4, 1);
+    
+    [self.tableView flushAppendedRows];
+    XCTAssertEqual(self.numberOfAppends, 2u);
+}
+
+
+- (void)testAppendRows_EvictsRowsFromFrontOfFullSections
+{
+    self.snapshot = [GNESectionedTableViewSnapshot snapshotWithSectionIdentifiers:@[@"A"]
+                                                                   rowIdentifiers:@[@[@1, @2, @3, @4]]];
+    [self.tableView reloadData];
+    self.tableView.maximumNumberOfRowsPerSection = 5;
+    
+    NSIndexPath *selectedIndexPath = [NSIndexPath gne_indexPathForRow:3 inSection:0];
+    [self.tableView selectRowAtIndexPath:selectedIndexPath byExtendingSelection:NO];
+    
+    [self.tableView appendRows:3 toSection:0];
+    [self.tableView flushAppendedRows];
+    
+    XCTAssertNumberOfRowsInSection(5, 0);
+    NSArray *expected = @[@3, @4, @1000, @1001, @1002];
+    XCTAssertEqualObjects([self.snapshot rowIdentifiersInSection:0], expected);
+    XCTAssertEqualObjects(self.tableView.selectedIndexPaths, @[[NSIndexPath gne_indexPathForRow:1 inSection:0]]);
+    
+    // Rows appended beyond the maximum in a single flush are never inserted.
+    [self.tableView appendRows:7 toSection:0];
+    [self.tableView flushAppendedRows];
+    
+    XCTAssertNumberOfRowsInSection(5, 0);
+    expected = @[@1005, @1006, @1007, @1008, @1009];
+    XCTAssertEqualObjects([self.snapshot rowIdentifiersInSection:0], expected);
+    XCTAssertEqualObjects(self.tableView.selectedIndexPaths, @[]);
+}
+
+
+- (void)testAppendRows_ReloadDataDiscardsQueuedRows
+{
+    self.snapshot = [GNESectionedTableViewSnapshot snapshotWithSectionIdentifiers:@[@"A"]
+                                                                   rowIdentifiers:@[@[@1]]];
+    [self.tableView reloadData];
+    
+    [self.tableView appendRows:4 toSection:0];
+    [self.tableView reloadData];
+    [self.tableView flushAppendedRows];
+    
+    XCTAssertEqual(self.numberOfAppends, 0u);
+    XCTAssertNumberOfRowsInSection(1, 0);
+}
+
+
+- (void)testAppendRows_QueuedRowsFollowTheirSections
+{
+    self.snapshot = [GNESectionedTableViewSnapshot snapshotWithSectionIdentifiers:@[@"A", @"B"]
+                                                                   rowIdentifiers:@[@[@1, @2], @[@3]]];
+    [self.tableView reloadData];
+    
+    [self.tableView appendRows:2 toSection:1];
+    [self.tableView appendRows:1 toSection:0];
+    
+    GNESectionedTableViewSnapshot *to = [GNESectionedTableViewSnapshot
+                                         snapshotWithSectionIdentifiers:@[@"C", @"B", @"A"]
+                                         rowIdentifiers:@[@[@4], @[@3], @[@1, @2]]];
+    [self applyChangesToSnapshot:to];
+    [self.tableView flushAppendedRows];
+    
+    XCTAssertEqual(self.numberOfAppends, 2u);
+    XCTAssertNumberOfRowsInSection(1, 0);
+    XCTAssertNumberOfRowsInSection(3, 1);
+    XCTAssertNumberOfRowsInSection(3, 2);
+    
+    // Rows queued for deleted sections are discarded.
+    [self.tableView appendRows:5 toSection:0];
+    NSArray *rowsOfB = [self.snapshot rowIdentifiersInSection:1];
+    NSArray *rowsOfA = [self.snapshot rowIdentifiersInSection:2];
+    to = [GNESectionedTableViewSnapshot snapshotWithSectionIdentifiers:@[@"B", @"A"]
+                                                        rowIdentifiers:@[rowsOfB, rowsOfA]];
+    [self applyChangesToSnapshot:to];
+    [self.tableView flushAppendedRows];
+    
+    XCTAssertEqual(self.numberOfAppends, 2u);
+    XCTAssertNumberOfRowsInSection(3, 0);
+}
+
+
+- (void)testAppendRows_FromBackgroundThreadsAreInsertedOnMainThread
+{
+    self.snapshot = [GNESectionedTableViewSnapshot snapshotWithSectionIdentifiers:@[@"A"]
+                                                                   rowIdentifiers:@[@[]]];
+    [self.tableView reloadData];
+    
+    GNESectionedTableView *tableView = self.tableView;
+    dispatch_apply(100, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t __unused i)
+    {
+        [tableView appendRows:1 toSection:0];
+    });
+    
+    NSDate *timeout = [NSDate dateWithTimeIntervalSinceNow:2.0];
+    while ([self.tableView numberOfRowsInSection:0] < 100 && [timeout timeIntervalSinceNow] > 0.0)
+    {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+    }
+    
+    XCTAssertNumberOfRowsInSection(100, 0);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Helpers
+// ------------------------------------------------------------------------------------------
+- (void)appendRows:(NSUInteger)count toSnapshotSection:(NSUInteger)section evictingRows:(NSUInteger)evictedCount
+{
+    self.numberOfAppends += 1;
+    
+    NSMutableArray *rowIdentifiers = [NSMutableArray array];
+    for (NSUInteger i = 0; i < self.snapshot.numberOfSections; i++)
+    {
+        NSMutableArray *rows = [[self.snapshot rowIdentifiersInSection:i] mutableCopy];
+        if (i == section)
+        {
+            for (NSUInteger row = 0; row < count; row++)
+            {
+                [rows addObject:@(self.nextRowIdentifier++)];
+            }
+            [rows removeObjectsInRange:NSMakeRange(0, evictedCount)];
+        }
+        [rowIdentifiers addObject:rows];
+    }
+    
+    self.snapshot = [GNESectionedTableViewSnapshot snapshotWithSectionIdentifiers:self.snapshot.sectionIdentifiers
+                                                                   rowIdentifiers:rowIdentifiers];
+}
+
+
+- (void)applyChangesToSnapshot:(GNESectionedTableViewSnapshot *)snapshot
+{
+    GNESectionedTableViewChangeSet *changeSet = [GNESectionedTableViewChangeSet
+                                                 changeSetFromSnapshot:self.snapshot
+                                                 toSnapshot:snapshot];
+    self.snapshot = snapshot;
+    [self.tableView applyChangeSet:changeSet withAnimation:NSTableViewAnimationEffectNone];
+}
+
+
+@end
@@ -32,14 +32,19 @@ typedef BOOL(^MockCanDragRowToRowBlock)(NSIndexPath *fromIndexPath, NSIndexPath
 typedef BOOL(^MockCanDropRowOnSectionBlock)(NSIndexPath *fromIndexPath, NSUInteger toSection);
 typedef BOOL(^MockCanDropRowOnRowBlock)(NSIndexPath *fromIndexPath, NSIndexPath *toIndexPath);
 
+typedef void(^MockWillAppendRowsBlock)(NSUInteger count, NSUInteger section, NSUInteger evictedCount);
+
 #pragma mark - GNESectionedTableViewDelegate
 
 typedef CGFloat(^MockHeightForSectionBlock)(NSUInteger section);
 typedef CGFloat(^MockHeightForRowBlock)(NSIndexPath *indexPath);
+typedef CGFloat(^MockHeightForSectionedRowBlock)(GNESectionedIndexPath indexPath);
+typedef void(^MockGetHeightsForRowsBlock)(CGFloat *heights, NSRange range, NSUInteger section);
 typedef NSView *(^MockViewForSectionBlock)(NSUInteger section);
 typedef NSView *(^MockViewForRowBlock)(NSIndexPath *indexPath);
 typedef BOOL(^MockShouldExpandCollapseSectionBlock)(NSUInteger section);
 typedef BOOL(^MockShouldSelectSectionBlock)(NSUInteger section);
 typedef BOOL(^MockShouldSelectRowBlock)(NSIndexPath *indexPath);
+typedef NSIndexSet *(^MockSelectableRowsBlock)(NSIndexSet *rows, NSUInteger section);
 
 #endif
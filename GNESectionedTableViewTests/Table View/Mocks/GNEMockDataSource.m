@@ -12,6 +12,23 @@
 @implementation GNEMockDataSource
 
 
+// ------------------------------------------------------------------------------------------
+#pragma mark - NSObject
+// ------------------------------------------------------------------------------------------
+- (BOOL)respondsToSelector:(SEL)selector
+{
+    // The table view only prefetches rows while scrolling if its data source implements prefetching, so
+    // prefetching is only offered once a test sets a block for it.
+    if (selector == @selector(tableView:prefetchRowsAtIndexPaths:) ||
+        selector == @selector(tableView:cancelPrefetchingForRowsAtIndexPaths:))
+    {
+        return [self hasBlockForSelector:selector];
+    }
+
+    return [super respondsToSelector:selector];
+}
+
+
 // ------------------------------------------------------------------------------------------
 #pragma mark - Counts
 // ------------------------------------------------------------------------------------------
@@ -174,4 +191,28 @@ didDragRowsAtIndexPaths:(NSArray *)fromIndexPaths
 }
 
 
+- (void)tableView:(GNESectionedTableView *)tableView prefetchRowsAtIndexPaths:(NSArray *)indexPaths
+{
+    MockObjectBlock block = [self blockForSelector:_cmd];
+    block(indexPaths);
+}
+
+
+- (void)tableView:(GNESectionedTableView *)tableView cancelPrefetchingForRowsAtIndexPaths:(NSArray *)indexPaths
+{
+    MockObjectBlock block = [self blockForSelector:_cmd];
+    block(indexPaths);
+}
+
+
+- (void)tableView:(GNESectionedTableView *)tableView
+   willAppendRows:(NSUInteger)count
+        toSection:(NSUInteger)section
+     evictingRows:(NSUInteger)evictedCount
+{
+    MockWillAppendRowsBlock block = [self blockForSelector:_cmd];
+    block(count, section, evictedCount);
+}
+
+
 @end
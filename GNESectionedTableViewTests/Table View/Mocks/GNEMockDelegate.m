@@ -12,6 +12,39 @@
 @implementation GNEMockDelegate
 
 
+// ------------------------------------------------------------------------------------------
+#pragma mark - NSObject
+// ------------------------------------------------------------------------------------------
+- (BOOL)respondsToSelector:(SEL)selector
+{
+    // The table view measures rows lazily if its delegate estimates their heights, so the estimates
+    // are only offered once a test sets a block for them.
+    if (selector == @selector(tableView:estimatedHeightForRowAtIndexPath:) ||
+        selector == @selector(tableView:estimatedHeightForRowAtSectionedIndexPath:) ||
+        selector == @selector(tableView:estimatedHeightForRowsInSection:))
+    {
+        return [self hasBlockForSelector:selector];
+    }
+
+    // The table view falls back to asking for each row's height if its delegate does not offer uniform
+    // or bulk heights, so those are also only offered once a test sets a block for them.
+    if (selector == @selector(tableView:uniformHeightForRowsInSection:) ||
+        selector == @selector(tableView:getHeights:forRowsInRange:inSection:))
+    {
+        return [self hasBlockForSelector:selector];
+    }
+
+    // Proposed selections are only filtered by ranges once a test sets a block for it, so the other
+    // selection filtering methods are asked by default.
+    if (selector == @selector(tableView:selectableRowsForProposedRows:inSection:))
+    {
+        return [self hasBlockForSelector:selector];
+    }
+
+    return [super respondsToSelector:selector];
+}
+
+
 // ------------------------------------------------------------------------------------------
 #pragma mark - Sizing
 // ------------------------------------------------------------------------------------------
@@ -39,6 +72,57 @@
 }
 
 
+- (CGFloat)tableView:(GNESectionedTableView *)tableView uniformHeightForRowsInSection:(NSUInteger)section
+{
+    MockHeightForSectionBlock block = [self blockForSelector:_cmd];
+
+    return block(section);
+}
+
+
+- (void)tableView:(GNESectionedTableView *)tableView
+       getHeights:(CGFloat *)heights
+   forRowsInRange:(NSRange)range
+        inSection:(NSUInteger)section
+{
+    MockGetHeightsForRowsBlock block = [self blockForSelector:_cmd];
+
+    block(heights, range, section);
+}
+
+
+- (CGFloat)tableView:(GNESectionedTableView *)tableView estimatedHeightForRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    MockHeightForRowBlock block = [self blockForSelector:_cmd];
+
+    return block(indexPath);
+}
+
+
+-                         (CGFloat)tableView:(GNESectionedTableView *)tableView
+   estimatedHeightForRowAtSectionedIndexPath:(GNESectionedIndexPath)indexPath
+{
+    MockHeightForSectionedRowBlock block = [self blockForSelector:_cmd];
+
+    return block(indexPath);
+}
+
+
+- (CGFloat)tableView:(GNESectionedTableView *)tableView estimatedHeightForRowsInSection:(NSUInteger)section
+{
+    MockHeightForSectionBlock block = [self blockForSelector:_cmd];
+
+    return block(section);
+}
+
+
+- (GNESectionedTableViewRowHeightMeasuringBlock)rowHeightMeasuringBlockForTableView:(GNESectionedTableView *)tableView
+{
+    // The block set for this selector is the measuring block itself.
+    return (__bridge GNESectionedTableViewRowHeightMeasuringBlock)[self blockForSelector:_cmd];
+}
+
+
 // ------------------------------------------------------------------------------------------
 #pragma mark - Views
 // ------------------------------------------------------------------------------------------
@@ -248,6 +332,16 @@ didEndDisplayingRowView:(NSTableRowView *)rowView
 }
 
 
+-      (NSIndexSet *)tableView:(GNESectionedTableView *)tableView
+ selectableRowsForProposedRows:(NSIndexSet *)rows
+                     inSection:(NSUInteger)section
+{
+    MockSelectableRowsBlock block = [self blockForSelector:_cmd];
+
+    return block(rows, section);
+}
+
+
 - (void)tableView:(GNESectionedTableView *)tableView didClickHeaderInSection:(NSUInteger)section
 {
     MockUnsignedIntegerBlock block = [self blockForSelector:_cmd];
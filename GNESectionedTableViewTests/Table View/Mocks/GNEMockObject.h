@@ -21,6 +21,7 @@
 
 - (void)setBlock:(void *)block forSelector:(SEL)selector;
 - (void *)blockForSelector:(SEL)selector;
+- (BOOL)hasBlockForSelector:(SEL)selector;
 
 
 @end
@@ -73,6 +73,14 @@
 }
 
 
+- (BOOL)hasBlockForSelector:(SEL)selector
+{
+    NSParameterAssert(selector);
+
+    return ([self.selectorToBlockMap objectForKey:NSStringFromSelector(selector)] != nil);
+}
+
+
 // ------------------------------------------------------------------------------------------
 #pragma mark - Helpers
 // ------------------------------------------------------------------------------------------
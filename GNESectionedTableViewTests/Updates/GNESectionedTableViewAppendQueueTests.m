@@ -0,0 +1,204 @@
+//
+//  GNESectionedTableViewAppendQueueTests.m
+//  GNESectionedTableView
+//
+//  Copyright (c) 2016 Gone East LLC. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "GNESectionedTableViewAppendQueue.h"
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@interface GNESectionedTableViewAppendQueueTests : XCTestCase
+
+@property (nonatomic, strong) GNESectionedTableViewAppendQueue *appendQueue;
+@property (nonatomic, strong) NSMutableArray *flushedRowCounts;
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@implementation GNESectionedTableViewAppendQueueTests
+
+
+- (void)setUp
+{
+    [super setUp];
+    
+    self.flushedRowCounts = [NSMutableArray array];
+    
+    __weak typeof(self) weakSelf = self;
+    self.appendQueue = [[GNESectionedTableViewAppendQueue alloc] initWithFlushHandler:^(NSDictionary *rowCounts)
+    {
+        [weakSelf.flushedRowCounts addObject:rowCounts];
+    }];
+}
+
+
+- (void)tearDown
+{
+    self.appendQueue = nil;
+    self.flushedRowCounts = nil;
+    [super tearDown];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Appending
+// ------------------------------------------------------------------------------------------
+- (void)testAppendQueue_EmptyByDefault
+{
+    XCTAssertTrue(self.appendQueue.isEmpty);
+    XCTAssertEqualObjects([self.appendQueue dequeueRowCountsBySection], @{});
+}
+
+
+- (void)testAppendQueue_CoalescesRowsBySection
+{
+    [self.appendQueue appendRows:2 toSection:0];
+    [self.appendQueue appendRows:0 toSection:3];
+    [self.appendQueue appendRows:5 toSection:1];
+    [self.appendQueue appendRows:1 toSection:0];
+    
+    XCTAssertFalse(self.appendQueue.isEmpty);
+    NSDictionary *expected = @{@0 : @3, @1 : @5};
+    XCTAssertEqualObjects([self.appendQueue dequeueRowCountsBySection], expected);
+    XCTAssertTrue(self.appendQueue.isEmpty);
+}
+
+
+- (void)testAppendQueue_ConcurrentAppendsAreAllCounted
+{
+    GNESectionedTableViewAppendQueue *appendQueue = self.appendQueue;
+    dispatch_apply(1000, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t i)
+    {
+        [appendQueue appendRows:1 toSection:(i % 4)];
+    });
+    
+    NSDictionary *expected = @{@0 : @250, @1 : @250, @2 : @250, @3 : @250};
+    XCTAssertEqualObjects([self.appendQueue dequeueRowCountsBySection], expected);
+}
+
+
+- (void)testAppendQueue_RemoveAllRows
+{
+    [self.appendQueue appendRows:4 toSection:2];
+    [self.appendQueue removeAllRows];
+    
+    XCTAssertTrue(self.appendQueue.isEmpty);
+    [self.appendQueue flush];
+    XCTAssertEqual(self.flushedRowCounts.count, 0u);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Inserting and Removing Sections
+// ------------------------------------------------------------------------------------------
+- (void)testAppendQueue_InsertSectionsShiftsRows
+{
+    [self.appendQueue appendRows:1 toSection:0];
+    [self.appendQueue appendRows:2 toSection:1];
+    [self.appendQueue appendRows:3 toSection:3];
+    
+    // Final indexes of the new sections, in ascending order.
+    NSMutableIndexSet *sections = [NSMutableIndexSet indexSetWithIndex:1];
+    [sections addIndex:3];
+    [self.appendQueue insertSections:sections];
+    
+    NSDictionary *expected = @{@0 : @1, @2 : @2, @5 : @3};
+    XCTAssertEqualObjects([self.appendQueue dequeueRowCountsBySection], expected);
+}
+
+
+- (void)testAppendQueue_RemoveSectionsDiscardsAndShiftsRows
+{
+    [self.appendQueue appendRows:1 toSection:0];
+    [self.appendQueue appendRows:2 toSection:1];
+    [self.appendQueue appendRows:3 toSection:4];
+    
+    NSMutableIndexSet *sections = [NSMutableIndexSet indexSetWithIndex:1];
+    [sections addIndex:2];
+    [self.appendQueue removeSections:sections];
+    
+    NSDictionary *expected = @{@0 : @1, @2 : @3};
+    XCTAssertEqualObjects([self.appendQueue dequeueRowCountsBySection], expected);
+}
+
+
+- (void)testAppendQueue_RemoveRowsInSectionsKeepsOtherSections
+{
+    [self.appendQueue appendRows:1 toSection:0];
+    [self.appendQueue appendRows:2 toSection:1];
+    [self.appendQueue appendRows:3 toSection:2];
+    
+    NSMutableIndexSet *sections = [NSMutableIndexSet indexSetWithIndex:1];
+    [sections addIndex:5];
+    
+    XCTAssertEqualObjects([self.appendQueue removeRowsInSections:sections], @{@1 : @2});
+    NSDictionary *expected = @{@0 : @1, @2 : @3};
+    XCTAssertEqualObjects([self.appendQueue dequeueRowCountsBySection], expected);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Flushing
+// ------------------------------------------------------------------------------------------
+- (void)testAppendQueue_FlushCallsHandlerOnceWithAllRows
+{
+    [self.appendQueue appendRows:1 toSection:0];
+    [self.appendQueue appendRows:2 toSection:0];
+    [self.appendQueue flush];
+    [self.appendQueue flush];
+    
+    XCTAssertEqualObjects(self.flushedRowCounts, @[@{@0 : @3}]);
+}
+
+
+- (void)testAppendQueue_FlushesAutomaticallyOnMainThread
+{
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Flushed"];
+    GNESectionedTableViewAppendQueue *appendQueue = [[GNESectionedTableViewAppendQueue alloc]
+                                                     initWithFlushHandler:^(NSDictionary *rowCounts)
+    {
+        XCTAssertTrue([NSThread isMainThread]);
+        XCTAssertEqualObjects(rowCounts, @{@1 : @10});
+        [expectation fulfill];
+    }];
+    
+    dispatch_apply(10, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t __unused i)
+    {
+        [appendQueue appendRows:1 toSection:1];
+    });
+    
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+}
+
+
+- (void)testAppendQueue_DeallocatingWhileDisplayLinkRunsDoesNotFlush
+{
+    __block NSUInteger numberOfFlushes = 0;
+    GNESectionedTableViewAppendQueue *appendQueue = [[GNESectionedTableViewAppendQueue alloc]
+                                                     initWithFlushHandler:^(NSDictionary * __unused rowCounts)
+    {
+        numberOfFlushes++;
+    }];
+    __weak GNESectionedTableViewAppendQueue *weakAppendQueue = appendQueue;
+    
+    // Starts the display link, then releases the queue while its display link is still running.
+    [appendQueue appendRows:1 toSection:0];
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    [appendQueue appendRows:1 toSection:0];
+    appendQueue = nil;
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    
+    XCTAssertNil(weakAppendQueue);
+    XCTAssertLessThanOrEqual(numberOfFlushes, 1u);
+}
+
+
+@end
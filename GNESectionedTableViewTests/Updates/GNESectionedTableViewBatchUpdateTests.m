@@ -0,0 +1,133 @@
+//
+//  GNESectionedTableViewBatchUpdateTests.m
+//  GNESectionedTableView
+//
+//  Copyright (c) 2016 Gone East LLC. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "GNESectionedTableViewBatchUpdate.h"
+#import "NSIndexPath+GNESectionedTableView.h"
+
+
+// ------------------------------------------------------------------------------------------
+
+
+#define XCTIndexPath(r, s) [NSIndexPath gne_indexPathForRow:r inSection:s]
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@interface GNESectionedTableViewBatchUpdateTests : XCTestCase
+
+@property (nonatomic, strong) GNESectionedTableViewBatchUpdate *batchUpdate;
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@implementation GNESectionedTableViewBatchUpdateTests
+
+
+- (void)setUp
+{
+    [super setUp];
+    self.batchUpdate = [[GNESectionedTableViewBatchUpdate alloc] init];
+}
+
+
+- (void)tearDown
+{
+    self.batchUpdate = nil;
+    [super tearDown];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Rows
+// ------------------------------------------------------------------------------------------
+- (void)testBatchUpdate_EmptyByDefault
+{
+    XCTAssertTrue(self.batchUpdate.isEmpty);
+    XCTAssertEqualObjects(self.batchUpdate.deletedRowIndexPathsGroupedBySection, @[]);
+    XCTAssertEqualObjects(self.batchUpdate.insertedRowIndexPathsGroupedBySection, @[]);
+    XCTAssertEqualObjects(self.batchUpdate.reloadedRowIndexPaths, @[]);
+}
+
+
+- (void)testBatchUpdate_DeletedRowsAreUniqueAndSortedDescending
+{
+    [self.batchUpdate deleteRowsAtIndexPaths:@[XCTIndexPath(1, 0), XCTIndexPath(3, 2), XCTIndexPath(0, 0)]
+                               withAnimation:0];
+    [self.batchUpdate deleteRowsAtIndexPaths:@[XCTIndexPath(1, 0), XCTIndexPath(1, 2)] withAnimation:2];
+    
+    NSArray *expected = @[@[XCTIndexPath(3, 2), XCTIndexPath(1, 2)],
+                          @[XCTIndexPath(1, 0), XCTIndexPath(0, 0)]];
+    XCTAssertFalse(self.batchUpdate.isEmpty);
+    XCTAssertEqualObjects(self.batchUpdate.deletedRowIndexPathsGroupedBySection, expected);
+    XCTAssertEqual(self.batchUpdate.rowDeletionAnimationOptions, 2u);
+}
+
+
+- (void)testBatchUpdate_InsertedRowsAreUniqueAndSortedAscending
+{
+    [self.batchUpdate insertRowsAtIndexPaths:@[XCTIndexPath(4, 1), XCTIndexPath(2, 0), XCTIndexPath(4, 1)]
+                               withAnimation:0];
+    [self.batchUpdate insertRowsAtIndexPaths:@[XCTIndexPath(0, 1)] withAnimation:0];
+    
+    NSArray *expected = @[@[XCTIndexPath(2, 0)], @[XCTIndexPath(0, 1), XCTIndexPath(4, 1)]];
+    XCTAssertEqualObjects(self.batchUpdate.insertedRowIndexPathsGroupedBySection, expected);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Normalization
+// ------------------------------------------------------------------------------------------
+- (void)testBatchUpdate_RowsOfDeletedSectionsAreDropped
+{
+    [self.batchUpdate deleteSections:[NSIndexSet indexSetWithIndex:1] withAnimation:0];
+    [self.batchUpdate deleteRowsAtIndexPaths:@[XCTIndexPath(0, 1), XCTIndexPath(0, 2)] withAnimation:0];
+    [self.batchUpdate reloadRowsAtIndexPaths:@[XCTIndexPath(1, 1), XCTIndexPath(1, 2)]];
+    [self.batchUpdate reloadSections:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 2)]];
+    
+    XCTAssertEqualObjects(self.batchUpdate.deletedRowIndexPathsGroupedBySection, @[@[XCTIndexPath(0, 2)]]);
+    XCTAssertEqualObjects(self.batchUpdate.reloadedRowIndexPaths, @[XCTIndexPath(1, 2)]);
+    XCTAssertEqualObjects(self.batchUpdate.reloadedSections, [NSIndexSet indexSetWithIndex:0]);
+}
+
+
+- (void)testBatchUpdate_RowsOfInsertedSectionsAreDropped
+{
+    [self.batchUpdate insertSections:[NSIndexSet indexSetWithIndex:0] withAnimation:0 expanded:YES];
+    [self.batchUpdate insertRowsAtIndexPaths:@[XCTIndexPath(0, 0), XCTIndexPath(0, 1)] withAnimation:0];
+    
+    XCTAssertEqualObjects(self.batchUpdate.insertedRowIndexPathsGroupedBySection, @[@[XCTIndexPath(0, 1)]]);
+}
+
+
+- (void)testBatchUpdate_ReloadsOfDeletedRowsAreDropped
+{
+    [self.batchUpdate deleteRowsAtIndexPaths:@[XCTIndexPath(2, 0)] withAnimation:0];
+    [self.batchUpdate reloadRowsAtIndexPaths:@[XCTIndexPath(2, 0), XCTIndexPath(1, 0), XCTIndexPath(0, 0)]];
+    
+    XCTAssertEqualObjects(self.batchUpdate.reloadedRowIndexPaths, (@[XCTIndexPath(0, 0), XCTIndexPath(1, 0)]));
+}
+
+
+- (void)testBatchUpdate_LastExpandedStateOfInsertedSectionsWins
+{
+    NSIndexSet *sections = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 3)];
+    [self.batchUpdate insertSections:sections withAnimation:0 expanded:NO];
+    [self.batchUpdate insertSections:[NSIndexSet indexSetWithIndex:1] withAnimation:0 expanded:YES];
+    
+    NSMutableIndexSet *expected = [NSMutableIndexSet indexSetWithIndex:0];
+    [expected addIndex:2];
+    XCTAssertEqualObjects(self.batchUpdate.insertedSections, sections);
+    XCTAssertEqualObjects(self.batchUpdate.collapsedInsertedSections, expected);
+}
+
+
+@end
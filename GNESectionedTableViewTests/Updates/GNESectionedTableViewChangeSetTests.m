@@ -0,0 +1,299 @@
+//
+//  GNESectionedTableViewChangeSetTests.m
+//  GNESectionedTableView
+//
+//  Copyright (c) 2016 Gone East LLC. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "GNESectionedTableViewChangeSet.h"
+#import "GNESectionedTableViewSnapshot.h"
+#import "GNEOrderedIndexSet.h"
+#import "NSIndexPath+GNESectionedTableView.h"
+
+
+// ------------------------------------------------------------------------------------------
+
+
+#define XCTIndexPath(r, s) [NSIndexPath gne_indexPathForRow:r inSection:s]
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@interface GNESectionedTableViewChangeSetTests : XCTestCase
+
+@end
+
+
+// ------------------------------------------------------------------------------------------
+
+
+@implementation GNESectionedTableViewChangeSetTests
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Snapshots
+// ------------------------------------------------------------------------------------------
+- (void)testSnapshot_Lookups
+{
+    GNESectionedTableViewSnapshot *snapshot = [GNESectionedTableViewSnapshot
+                                               snapshotWithSectionIdentifiers:@[@"A", @"B"]
+                                               rowIdentifiers:@[@[@1, @2], @[@3]]];
+    
+    XCTAssertEqual(snapshot.numberOfSections, 2);
+    XCTAssertEqual([snapshot numberOfRowsInSection:0], 2);
+    XCTAssertEqual([snapshot numberOfRowsInSection:1], 1);
+    XCTAssertEqual([snapshot sectionForSectionIdentifier:@"B"], 1);
+    XCTAssertEqual([snapshot sectionForSectionIdentifier:@"C"], NSNotFound);
+    XCTAssertEqualObjects([snapshot indexPathForRowIdentifier:@3], XCTIndexPath(0, 1));
+    XCTAssertNil([snapshot indexPathForRowIdentifier:@4]);
+    XCTAssertEqualObjects([snapshot rowIdentifierAtIndexPath:XCTIndexPath(1, 0)], @2);
+    XCTAssertNil([snapshot rowIdentifierAtIndexPath:XCTIndexPath(1, 1)]);
+    XCTAssertThrows([snapshot numberOfRowsInSection:2]);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Sections
+// ------------------------------------------------------------------------------------------
+- (void)testChangeSet_Empty
+{
+    GNESectionedTableViewSnapshot *snapshot = [self snapshotWithSections:@[@"A", @"B"]
+                                                                    rows:@[@[@1, @2], @[@3]]];
+    GNESectionedTableViewChangeSet *changeSet = [GNESectionedTableViewChangeSet
+                                                 changeSetFromSnapshot:snapshot
+                                                 toSnapshot:[snapshot copy]];
+    XCTAssertTrue(changeSet.isEmpty);
+    XCTAssertTrue([[GNESectionedTableViewChangeSet alloc] init].isEmpty);
+}
+
+
+- (void)testChangeSet_InsertAndDeleteSections
+{
+    GNESectionedTableViewSnapshot *from = [self snapshotWithSections:@[@"A", @"B", @"C"]
+                                                                rows:@[@[], @[], @[]]];
+    GNESectionedTableViewSnapshot *to = [self snapshotWithSections:@[@"D", @"A", @"C", @"E"]
+                                                              rows:@[@[], @[], @[], @[]]];
+    GNESectionedTableViewChangeSet *changeSet = [GNESectionedTableViewChangeSet changeSetFromSnapshot:from
+                                                                                           toSnapshot:to];
+    
+    XCTAssertEqualObjects(changeSet.deletedSections, [NSIndexSet indexSetWithIndex:1]);
+    NSMutableIndexSet *insertedSections = [NSMutableIndexSet indexSetWithIndex:0];
+    [insertedSections addIndex:3];
+    XCTAssertEqualObjects(changeSet.insertedSections, insertedSections);
+    XCTAssertEqual(changeSet.movedFromSections.count, 0);
+    [self assertChangeSet:changeSet transformsSnapshot:from intoSnapshot:to];
+}
+
+
+- (void)testChangeSet_MoveSections_MinimalMoves
+{
+    GNESectionedTableViewSnapshot *from = [self snapshotWithSections:@[@"A", @"B", @"C", @"D"]
+                                                                rows:@[@[@1], @[@2], @[@3], @[@4]]];
+    GNESectionedTableViewSnapshot *to = [self snapshotWithSections:@[@"D", @"A", @"B", @"C"]
+                                                              rows:@[@[@4], @[@1], @[@2], @[@3]]];
+    GNESectionedTableViewChangeSet *changeSet = [GNESectionedTableViewChangeSet changeSetFromSnapshot:from
+                                                                                           toSnapshot:to];
+    
+    XCTAssertEqual(changeSet.movedFromSections.count, 1);
+    XCTAssertEqual([changeSet.movedFromSections indexAtPosition:0], 3);
+    XCTAssertEqual([changeSet.movedToSections indexAtPosition:0], 0);
+    XCTAssertEqual(changeSet.deletedRowIndexPaths.count, 0);
+    XCTAssertEqual(changeSet.insertedRowIndexPaths.count, 0);
+    XCTAssertEqual(changeSet.movedFromRowIndexPaths.count, 0);
+    [self assertChangeSet:changeSet transformsSnapshot:from intoSnapshot:to];
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Rows
+// ------------------------------------------------------------------------------------------
+- (void)testChangeSet_InsertDeleteAndMoveRows
+{
+    GNESectionedTableViewSnapshot *from = [self snapshotWithSections:@[@"A", @"B"]
+                                                                rows:@[@[@1, @2, @3, @4], @[@5, @6]]];
+    GNESectionedTableViewSnapshot *to = [self snapshotWithSections:@[@"A", @"B"]
+                                                              rows:@[@[@4, @1, @3, @7], @[@2, @5]]];
+    GNESectionedTableViewChangeSet *changeSet = [GNESectionedTableViewChangeSet changeSetFromSnapshot:from
+                                                                                           toSnapshot:to];
+    
+    XCTAssertEqualObjects(changeSet.deletedRowIndexPaths, @[XCTIndexPath(1, 1)]);
+    XCTAssertEqualObjects(changeSet.insertedRowIndexPaths, @[XCTIndexPath(3, 0)]);
+    NSArray *expectedFrom = @[XCTIndexPath(1, 0), XCTIndexPath(3, 0)];
+    NSArray *expectedTo = @[XCTIndexPath(0, 1), XCTIndexPath(0, 0)];
+    XCTAssertEqualObjects(changeSet.movedFromRowIndexPaths, expectedFrom);
+    XCTAssertEqualObjects(changeSet.movedToRowIndexPaths, expectedTo);
+    [self assertChangeSet:changeSet transformsSnapshot:from intoSnapshot:to];
+}
+
+
+- (void)testChangeSet_RowsMovedIntoMovedSectionsAreNotRowChanges
+{
+    GNESectionedTableViewSnapshot *from = [self snapshotWithSections:@[@"A", @"B"]
+                                                                rows:@[@[@1, @2], @[@3]]];
+    GNESectionedTableViewSnapshot *to = [self snapshotWithSections:@[@"B", @"A"]
+                                                              rows:@[@[@3, @2], @[@1]]];
+    GNESectionedTableViewChangeSet *changeSet = [GNESectionedTableViewChangeSet changeSetFromSnapshot:from
+                                                                                           toSnapshot:to];
+    
+    XCTAssertEqual(changeSet.movedFromSections.count, 1);
+    XCTAssertEqual(changeSet.movedFromRowIndexPaths.count, 0);
+    XCTAssertEqual(changeSet.deletedRowIndexPaths.count + changeSet.insertedRowIndexPaths.count, 1);
+    [self assertChangeSet:changeSet transformsSnapshot:from intoSnapshot:to];
+}
+
+
+- (void)testChangeSet_DuplicateIdentifiersAreDeletedAndInserted
+{
+    GNESectionedTableViewSnapshot *from = [self snapshotWithSections:@[@"A"] rows:@[@[@1, @1]]];
+    GNESectionedTableViewSnapshot *to = [self snapshotWithSections:@[@"A"] rows:@[@[@1, @1, @1]]];
+    GNESectionedTableViewChangeSet *changeSet = [GNESectionedTableViewChangeSet changeSetFromSnapshot:from
+                                                                                           toSnapshot:to];
+    
+    XCTAssertEqualObjects(changeSet.deletedRowIndexPaths, @[XCTIndexPath(1, 0)]);
+    NSArray *expectedInserted = @[XCTIndexPath(1, 0), XCTIndexPath(2, 0)];
+    XCTAssertEqualObjects(changeSet.insertedRowIndexPaths, expectedInserted);
+    [self assertChangeSet:changeSet transformsSnapshot:from intoSnapshot:to];
+}
+
+
+- (void)testChangeSet_RandomSnapshots
+{
+    srandom(7);
+    for (NSUInteger i = 0; i < 500; i++)
+    {
+        @autoreleasepool
+        {
+            GNESectionedTableViewSnapshot *from = [self randomSnapshot];
+            GNESectionedTableViewSnapshot *to = [self randomSnapshot];
+            GNESectionedTableViewChangeSet *changeSet = [GNESectionedTableViewChangeSet
+                                                         changeSetFromSnapshot:from toSnapshot:to];
+            [self assertChangeSet:changeSet transformsSnapshot:from intoSnapshot:to];
+        }
+    }
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Converting Index Paths
+// ------------------------------------------------------------------------------------------
+- (void)testIndexPathAfterChanges
+{
+    GNESectionedTableViewSnapshot *from = [self snapshotWithSections:@[@"A", @"B"]
+                                                                rows:@[@[@1, @2], @[@3]]];
+    GNESectionedTableViewSnapshot *to = [self snapshotWithSections:@[@"C", @"B"]
+                                                              rows:@[@[@2], @[@3]]];
+    GNESectionedTableViewChangeSet *changeSet = [GNESectionedTableViewChangeSet changeSetFromSnapshot:from
+                                                                                           toSnapshot:to];
+    
+    XCTAssertNil([changeSet indexPathAfterChangesForIndexPath:XCTIndexPath(0, 0)]);
+    XCTAssertEqualObjects([changeSet indexPathAfterChangesForIndexPath:XCTIndexPath(1, 0)], XCTIndexPath(0, 0));
+    XCTAssertEqualObjects([changeSet indexPathAfterChangesForIndexPath:XCTIndexPath(0, 1)], XCTIndexPath(0, 1));
+    XCTAssertEqualObjects([changeSet indexPathAfterChangesForIndexPath:XCTIndexPath(NSNotFound - 1, 1)],
+                          XCTIndexPath(NSNotFound - 1, 1));
+    XCTAssertNil([changeSet indexPathAfterChangesForIndexPath:XCTIndexPath(NSNotFound - 1, 0)]);
+    XCTAssertEqual([changeSet sectionAfterChangesForSection:1], 0);
+}
+
+
+// ------------------------------------------------------------------------------------------
+#pragma mark - Helpers
+// ------------------------------------------------------------------------------------------
+- (GNESectionedTableViewSnapshot *)snapshotWithSections:(NSArray *)sections rows:(NSArray *)rows
+{
+    return [GNESectionedTableViewSnapshot snapshotWithSectionIdentifiers:sections rowIdentifiers:rows];
+}
+
+
+- (GNESectionedTableViewSnapshot *)randomSnapshot
+{
+    NSMutableArray *sections = [NSMutableArray array];
+    for (NSUInteger section = 0; section < 8; section++)
+    {
+        if (random() % 3 != 0)
+        {
+            [sections addObject:@(section)];
+        }
+    }
+    for (NSUInteger i = sections.count; i > 1; i--)
+    {
+        [sections exchangeObjectAtIndex:(i - 1) withObjectAtIndex:(NSUInteger)random() % i];
+    }
+    
+    NSMutableArray *rows = [NSMutableArray array];
+    for (NSUInteger i = 0; i < sections.count; i++)
+    {
+        [rows addObject:[NSMutableArray array]];
+    }
+    
+    if (sections.count > 0)
+    {
+        for (NSUInteger row = 100; row < 130; row++)
+        {
+            if (random() % 4 != 0)
+            {
+                NSMutableArray *sectionRows = rows[(NSUInteger)random() % sections.count];
+                NSUInteger index = (NSUInteger)random() % (sectionRows.count + 1);
+                [sectionRows insertObject:@(row) atIndex:index];
+            }
+        }
+    }
+    
+    return [self snapshotWithSections:sections rows:rows];
+}
+
+
+/**
+ Applies the change set to the from snapshot the same way -[GNESectionedTableView applyChangeSet:withAnimation:]
+ does (delete using the old index paths, then insert in ascending order using the new ones) and asserts
+ that the result is equal to the to snapshot.
+ */
+- (void)assertChangeSet:(GNESectionedTableViewChangeSet *)changeSet
+     transformsSnapshot:(GNESectionedTableViewSnapshot *)from
+           intoSnapshot:(GNESectionedTableViewSnapshot *)to
+{
+    NSMutableArray *sections = [from.sectionIdentifiers mutableCopy];
+    NSMutableArray *rows = [NSMutableArray array];
+    for (NSUInteger section = 0; section < from.numberOfSections; section++)
+    {
+        [rows addObject:[[from rowIdentifiersInSection:section] mutableCopy]];
+    }
+    
+    NSArray *deletedRows = [changeSet.deletedRowIndexPaths
+                            arrayByAddingObjectsFromArray:changeSet.movedFromRowIndexPaths];
+    deletedRows = [deletedRows sortedArrayUsingSelector:@selector(gne_compare:)];
+    for (NSIndexPath *indexPath in deletedRows.reverseObjectEnumerator)
+    {
+        [rows[indexPath.gne_section] removeObjectAtIndex:indexPath.gne_row];
+    }
+    
+    NSMutableIndexSet *deletedSections = [changeSet.deletedSections mutableCopy];
+    [deletedSections addIndexes:changeSet.movedFromSections.ns_indexSet];
+    [sections removeObjectsAtIndexes:deletedSections];
+    [rows removeObjectsAtIndexes:deletedSections];
+    
+    NSMutableIndexSet *insertedSections = [changeSet.insertedSections mutableCopy];
+    [insertedSections addIndexes:changeSet.movedToSections.ns_indexSet];
+    [insertedSections enumerateIndexesUsingBlock:^(NSUInteger section, BOOL *stop __unused)
+    {
+        XCTAssertLessThanOrEqual(section, sections.count);
+        [sections insertObject:to.sectionIdentifiers[section] atIndex:section];
+        [rows insertObject:[[to rowIdentifiersInSection:section] mutableCopy] atIndex:section];
+    }];
+    
+    NSArray *insertedRows = [changeSet.insertedRowIndexPaths
+                             arrayByAddingObjectsFromArray:changeSet.movedToRowIndexPaths];
+    insertedRows = [insertedRows sortedArrayUsingSelector:@selector(gne_compare:)];
+    for (NSIndexPath *indexPath in insertedRows)
+    {
+        NSMutableArray *sectionRows = rows[indexPath.gne_section];
+        XCTAssertLessThanOrEqual(indexPath.gne_row, sectionRows.count);
+        [sectionRows insertObject:[to rowIdentifierAtIndexPath:indexPath] atIndex:indexPath.gne_row];
+    }
+    
+    XCTAssertEqualObjects([self snapshotWithSections:sections rows:rows], to);
+}
+
+
+@end